@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "daw/algorithms/daw_algorithm_simd.h"
 #include "daw/daw_compiler_fixups.h"
 #include "daw/traits/daw_traits_concepts.h"
 
@@ -39,6 +40,18 @@ namespace daw::algorithm {
 		(void)daw::traits::is_input_iterator_test<InputIterator>( );
 		(void)daw::traits::is_forward_access_iterator_test<ForwardIterator>( );
 
+#if defined( DAW_ALGORITHM_HAS_SIMD )
+		if constexpr( simd_details::is_range_pair_v<InputIterator, InputIterator,
+		                                            ForwardIterator,
+		                                            ForwardIterator> ) {
+			DAW_IF_NOT_CONSTEVAL {
+				auto const needles = slast - sfirst;
+				if( needles > 0 and needles <= simd_details::max_needles ) {
+					return simd_details::find_any_range( first, last, sfirst, slast );
+				}
+			}
+		}
+#endif
 		while( first != last ) {
 			for( auto it = sfirst; it != slast; ++it ) {
 				if( *first == *it ) {
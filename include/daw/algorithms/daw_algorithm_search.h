@@ -0,0 +1,332 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/daw_attributes.h"
+#include "daw/daw_cxmath.h"
+#include "daw/daw_is_constant_evaluated.h"
+#include "daw/daw_prefetch.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace daw::algorithm {
+	namespace search_details {
+		/// Below this many elements the whole range is likely cached and the
+		/// prefetches only cost instructions
+		inline constexpr std::ptrdiff_t prefetch_threshold = 16 * 1024;
+
+		/// Searches interleaved per group by the batched searches.  Enough to
+		/// keep the line fill buffers busy without spilling the state.
+		inline constexpr std::size_t batch_size = 16;
+
+		template<typename Iterator>
+		inline constexpr bool can_prefetch_v = std::is_lvalue_reference_v<
+		  typename std::iterator_traits<Iterator>::reference>;
+
+		template<typename Iterator>
+		DAW_ATTRIB_INLINE constexpr void prefetch_at( Iterator it ) noexcept {
+			if constexpr( can_prefetch_v<Iterator> ) {
+#if defined( DAW_HAS_IF_CONSTEVAL_COMPAT )
+				DAW_IF_NOT_CONSTEVAL {
+					daw::prefetch( std::addressof( *it ) );
+				}
+#else
+				(void)it;
+#endif
+			} else {
+				(void)it;
+			}
+		}
+
+		/// Run the halving steps of a branchless search.  Each step keeps the
+		/// lower half when pred( mid ) is false, the select compiles to a
+		/// conditional move so there is no branch to mispredict.  On large
+		/// ranges both candidate midpoints of the next step are prefetched.
+		template<typename RandomIterator, typename Predicate>
+		[[nodiscard]] constexpr RandomIterator
+		branchless_partition_point( RandomIterator first, RandomIterator last,
+		                            Predicate &pred ) {
+			auto n = last - first;
+			if( n == 0 ) {
+				return first;
+			}
+			auto base = first;
+			while( n >= prefetch_threshold ) {
+				auto const half = n / 2;
+				auto const next_half = ( n - half ) / 2;
+				prefetch_at( base + next_half );
+				prefetch_at( base + ( half + next_half ) );
+				base = pred( base[half] ) ? base + half : base;
+				n -= half;
+			}
+			while( n > 1 ) {
+				auto const half = n / 2;
+				base = pred( base[half] ) ? base + half : base;
+				n -= half;
+			}
+			return base + static_cast<std::ptrdiff_t>( pred( *base ) );
+		}
+
+		/// An in order walk of the implicit tree visits the nodes in sorted
+		/// order.  The recursion is as deep as the tree.
+		template<typename RandomIterator, typename OutputIterator>
+		constexpr void eytzinger_fill( RandomIterator first, std::size_t &next,
+		                               OutputIterator out, std::size_t k,
+		                               std::size_t n ) {
+			if( k > n ) {
+				return;
+			}
+			eytzinger_fill( first, next, out, 2U * k, n );
+			out[static_cast<std::ptrdiff_t>( k - 1U )] =
+			  first[static_cast<std::ptrdiff_t>( next++ )];
+			eytzinger_fill( first, next, out, 2U * k + 1U, n );
+		}
+	} // namespace search_details
+
+	/// @brief lower_bound as a branchless binary search.  The number of steps
+	/// only depends on the size of the range, and the next half is selected
+	/// with a conditional move, so random lookups do not stall on branch
+	/// mispredictions.  Ranges of 16K elements or more prefetch the next
+	/// midpoints.
+	/// @pre [first, last) is partitioned by comp( element, value )
+	template<typename RandomIterator, typename T, typename Compare = std::less<>>
+	[[nodiscard]] constexpr RandomIterator
+	branchless_lower_bound( RandomIterator first, RandomIterator last,
+	                        T const &value, Compare comp = Compare{ } ) {
+		auto pred = [&]( auto const &e ) {
+			return comp( e, value );
+		};
+		return search_details::branchless_partition_point( first, last, pred );
+	}
+
+	/// @brief upper_bound as a branchless binary search, see
+	/// branchless_lower_bound
+	/// @pre [first, last) is partitioned by not comp( value, element )
+	template<typename RandomIterator, typename T, typename Compare = std::less<>>
+	[[nodiscard]] constexpr RandomIterator
+	branchless_upper_bound( RandomIterator first, RandomIterator last,
+	                        T const &value, Compare comp = Compare{ } ) {
+		auto pred = [&]( auto const &e ) {
+			return not comp( value, e );
+		};
+		return search_details::branchless_partition_point( first, last, pred );
+	}
+
+	/// @brief Search for every key of [keys_first, keys_last) and write the
+	/// lower_bound of each, in order, to out.  Groups of searches run in
+	/// lockstep, so the cache misses of one group overlap instead of each
+	/// search waiting on its own chain of loads.
+	/// @return out after the last position written
+	template<typename RandomIterator, typename KeyIterator,
+	         typename OutputIterator, typename Compare = std::less<>>
+	constexpr OutputIterator
+	lower_bound_many( RandomIterator first, RandomIterator last,
+	                  KeyIterator keys_first, KeyIterator keys_last,
+	                  OutputIterator out, Compare comp = Compare{ } ) {
+		constexpr auto group = search_details::batch_size;
+		auto const size = last - first;
+		while( keys_first != keys_last ) {
+			KeyIterator keys[group]{ };
+			RandomIterator bases[group]{ };
+			std::size_t count = 0;
+			for( ; count < group and keys_first != keys_last;
+			     ++count, ++keys_first ) {
+				keys[count] = keys_first;
+				bases[count] = first;
+			}
+			if( size > 0 ) {
+				auto n = size;
+				while( n > 1 ) {
+					auto const half = n / 2;
+					if( n >= search_details::prefetch_threshold ) {
+						auto const next_half = ( n - half ) / 2;
+						for( std::size_t g = 0; g < count; ++g ) {
+							search_details::prefetch_at( bases[g] + next_half );
+							search_details::prefetch_at( bases[g] + ( half + next_half ) );
+						}
+					}
+					for( std::size_t g = 0; g < count; ++g ) {
+						bases[g] =
+						  comp( bases[g][half], *keys[g] ) ? bases[g] + half : bases[g];
+					}
+					n -= half;
+				}
+				for( std::size_t g = 0; g < count; ++g ) {
+					bases[g] += static_cast<std::ptrdiff_t>( comp( *bases[g], *keys[g] ) );
+				}
+			}
+			for( std::size_t g = 0; g < count; ++g ) {
+				*out = bases[g];
+				++out;
+			}
+		}
+		return out;
+	}
+
+	/// @brief Copy the sorted range [first, last) to out in Eytzinger order,
+	/// the breadth first order of the balanced search tree over the range.  The
+	/// root is at out[0] and the children of out[i] are at out[2i + 1] and
+	/// out[2i + 2].  A parallel array laid out with the same call lines up with
+	/// the positions returned by eytzinger_index.
+	/// @return out after the last element written
+	template<typename RandomIterator, typename OutputIterator>
+	constexpr OutputIterator eytzinger_layout( RandomIterator first,
+	                                           RandomIterator last,
+	                                           OutputIterator out ) {
+		auto const n = static_cast<std::size_t>( last - first );
+		std::size_t next = 0;
+		search_details::eytzinger_fill( first, next, out, 1, n );
+		return out + static_cast<std::ptrdiff_t>( n );
+	}
+} // namespace daw::algorithm
+
+namespace daw {
+	/// A static search index over a sorted range, stored in Eytzinger order.
+	/// The first levels of the tree share a few cache lines that stay hot, the
+	/// search walks down with a branchless step, and the descendants a few
+	/// levels below are prefetched as one aligned cache line.  Positions are
+	/// indices into the Eytzinger order, use algorithm::eytzinger_layout to
+	/// lay out any payload the same way.
+	template<typename T, typename Compare = std::less<>>
+	class eytzinger_index {
+		static_assert( std::is_default_constructible_v<T> );
+
+		/// Nodes that share a cache line
+		static constexpr std::size_t line_nodes =
+		  sizeof( T ) < 64U ? 64U / sizeof( T ) : 1U;
+
+		// Node k of the 1 based tree is m_nodes[m_offset + k].  The offset puts
+		// node 0 on a cache line boundary so the line_nodes descendants of a
+		// node log2( line_nodes ) levels down share a line.  A copy may lose
+		// the alignment, which only costs prefetch efficiency.
+		std::vector<T> m_nodes{ };
+		std::size_t m_offset = 0;
+		std::size_t m_size = 0;
+		std::size_t m_full_levels = 0;
+		DAW_NO_UNIQUE_ADDRESS Compare m_compare{ };
+
+		[[nodiscard]] T const *nodes( ) const noexcept {
+			return m_nodes.data( ) + m_offset;
+		}
+
+		/// The Eytzinger position of the lower bound from the final node of a
+		/// descent, size( ) when every element is less than the key
+		[[nodiscard]] std::size_t finish( std::size_t k ) const noexcept {
+			k >>= daw::cxmath::count_trailing_zeros(
+			        static_cast<std::uint64_t>( ~k ) ) +
+			      1U;
+			return k == 0 ? m_size : k - 1U;
+		}
+
+		template<typename K>
+		DAW_ATTRIB_INLINE std::size_t step( std::size_t k,
+		                                    K const &key ) const {
+			auto const *const n = nodes( );
+			daw::prefetch( n + ( k * line_nodes < m_size ? k * line_nodes : 0U ) );
+			return 2U * k + static_cast<std::size_t>( m_compare( n[k], key ) );
+		}
+
+	public:
+		using value_type = T;
+		using size_type = std::size_t;
+
+		eytzinger_index( ) = default;
+
+		/// @pre [first, last) is sorted by comp
+		template<typename RandomIterator>
+		eytzinger_index( RandomIterator first, RandomIterator last,
+		                 Compare comp = Compare{ } )
+		  : m_size( static_cast<std::size_t>( last - first ) )
+		  , m_compare( comp ) {
+			m_nodes.resize( m_size + 1U + line_nodes );
+			auto const addr = reinterpret_cast<std::uintptr_t>( m_nodes.data( ) );
+			if constexpr( 64U % sizeof( T ) == 0 ) {
+				m_offset = ( ( 64U - addr % 64U ) % 64U ) / sizeof( T );
+			}
+			(void)algorithm::eytzinger_layout(
+			  first, last, m_nodes.begin( ) +
+			                 static_cast<std::ptrdiff_t>( m_offset + 1U ) );
+			while( ( std::size_t{ 1 } << ( m_full_levels + 1U ) ) - 1U <= m_size ) {
+				++m_full_levels;
+			}
+		}
+
+		[[nodiscard]] size_type size( ) const noexcept {
+			return m_size;
+		}
+
+		[[nodiscard]] bool empty( ) const noexcept {
+			return m_size == 0;
+		}
+
+		/// The element at an Eytzinger position
+		[[nodiscard]] T const &operator[]( size_type pos ) const noexcept {
+			return nodes( )[pos + 1U];
+		}
+
+		/// The Eytzinger position of the first element not less than key, or
+		/// size( )
+		template<typename K>
+		[[nodiscard]] size_type lower_bound( K const &key ) const {
+			std::size_t k = 1;
+			for( std::size_t level = 0; level < m_full_levels; ++level ) {
+				k = step( k, key );
+			}
+			if( k <= m_size ) {
+				k = step( k, key );
+			}
+			return finish( k );
+		}
+
+		template<typename K>
+		[[nodiscard]] bool contains( K const &key ) const {
+			auto const pos = lower_bound( key );
+			return pos != m_size and not m_compare( key, ( *this )[pos] );
+		}
+
+		/// The lower_bound of every key of [keys_first, keys_last), in order.
+		/// Groups of searches descend in lockstep so their misses overlap.
+		/// @return out after the last position written
+		template<typename KeyIterator, typename OutputIterator>
+		OutputIterator lower_bound_many( KeyIterator keys_first,
+		                                 KeyIterator keys_last,
+		                                 OutputIterator out ) const {
+			constexpr auto group = algorithm::search_details::batch_size;
+			while( keys_first != keys_last ) {
+				KeyIterator keys[group]{ };
+				std::size_t ks[group];
+				std::size_t count = 0;
+				for( ; count < group and keys_first != keys_last;
+				     ++count, ++keys_first ) {
+					keys[count] = keys_first;
+					ks[count] = 1;
+				}
+				for( std::size_t level = 0; level < m_full_levels; ++level ) {
+					for( std::size_t g = 0; g < count; ++g ) {
+						ks[g] = step( ks[g], *keys[g] );
+					}
+				}
+				for( std::size_t g = 0; g < count; ++g ) {
+					if( ks[g] <= m_size ) {
+						ks[g] = step( ks[g], *keys[g] );
+					}
+					*out = finish( ks[g] );
+					++out;
+				}
+			}
+			return out;
+		}
+	};
+} // namespace daw
@@ -0,0 +1,599 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/daw_attributes.h"
+#include "daw/daw_cxmath.h"
+#include "daw/daw_is_constant_evaluated.h"
+#include "daw/daw_remove_cvref.h"
+#include "daw/impl/daw_simd_check.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+/// Vector kernels behind the contiguous specializations of find, count,
+/// mismatch, equal, lexicographical compare and min/max element in
+/// daw_algorithm.h.  Elements are integers or floating point numbers, which
+/// are compared as the scalar operators would, so NaN is not equal to itself.
+/// The algorithms keep their generic loops for constant evaluation and for
+/// every other iterator and element type.
+namespace daw::algorithm::simd_details {
+	template<typename T>
+	inline constexpr bool is_element_v =
+	  ( std::is_integral_v<T> and not std::is_same_v<T, bool> and
+	    ( sizeof( T ) == 1U or sizeof( T ) == 2U or sizeof( T ) == 4U or
+	      sizeof( T ) == 8U ) ) or
+	  std::is_same_v<T, float> or std::is_same_v<T, double>;
+
+	template<typename Iterator, typename = void>
+	inline constexpr bool is_contiguous_v = std::is_pointer_v<Iterator>;
+
+#if defined( __cpp_lib_concepts ) and defined( __cpp_lib_to_address )
+	// Only iterators that declare a concept are checked, as in the pipelines
+	template<typename Iterator>
+	inline constexpr bool is_contiguous_v<
+	  Iterator, std::void_t<typename Iterator::iterator_concept>> =
+	  std::contiguous_iterator<Iterator>;
+#endif
+
+	template<typename Iterator>
+	using element_t = daw::remove_cvref_t<decltype( *std::declval<Iterator>( ) )>;
+
+	/// [first, last) of these types can be read by the kernels
+	template<typename Iterator, typename Last, typename = void>
+	inline constexpr bool is_range_v = false;
+
+	template<typename Iterator>
+	inline constexpr bool is_range_v<
+	  Iterator, Iterator, std::enable_if_t<is_contiguous_v<Iterator>>> =
+	  is_element_v<element_t<Iterator>>;
+
+	/// Two ranges of the same element type
+	template<typename Iterator1, typename Last1, typename Iterator2,
+	         typename Last2, typename = void>
+	inline constexpr bool is_range_pair_v = false;
+
+	template<typename Iterator1, typename Last1, typename Iterator2,
+	         typename Last2>
+	inline constexpr bool is_range_pair_v<
+	  Iterator1, Last1, Iterator2, Last2,
+	  std::enable_if_t<is_range_v<Iterator1, Last1> and
+	                   is_range_v<Iterator2, Last2>>> =
+	  std::is_same_v<element_t<Iterator1>, element_t<Iterator2>>;
+
+	/// A range of exactly T
+	template<typename Iterator, typename Last, typename T, typename = void>
+	inline constexpr bool is_range_of_v = false;
+
+	template<typename Iterator, typename T>
+	inline constexpr bool is_range_of_v<
+	  Iterator, Iterator, T, std::enable_if_t<is_range_v<Iterator, Iterator>>> =
+	  std::is_same_v<element_t<Iterator>, T>;
+
+	template<typename Compare, typename T>
+	inline constexpr bool is_equal_to_v =
+	  std::is_same_v<daw::remove_cvref_t<Compare>, std::equal_to<>> or
+	  std::is_same_v<daw::remove_cvref_t<Compare>, std::equal_to<T>>;
+
+	template<typename Compare, typename T>
+	inline constexpr bool is_less_v =
+	  std::is_same_v<daw::remove_cvref_t<Compare>, std::less<>> or
+	  std::is_same_v<daw::remove_cvref_t<Compare>, std::less<T>>;
+
+	template<typename Iterator>
+	DAW_ATTRIB_INLINE auto *to_pointer( Iterator it ) {
+		if constexpr( std::is_pointer_v<Iterator> ) {
+			return it;
+		} else {
+#if defined( __cpp_lib_to_address )
+			return std::to_address( it );
+#else
+			return &*it;
+#endif
+		}
+	}
+
+	/// Map a kernel result in the range at p back to the iterator range at
+	/// first
+	template<typename Iterator, typename T>
+	DAW_ATTRIB_INLINE Iterator to_iterator( Iterator first, T const *p,
+	                                        T const *result ) {
+		return first + static_cast<std::ptrdiff_t>( result - p );
+	}
+
+#if defined( DAW_HAS_SSE2 ) and defined( DAW_HAS_IF_CONSTEVAL_COMPAT )
+#define DAW_ALGORITHM_HAS_SIMD
+#if defined( DAW_HAS_AVX2 )
+	using vec_t = __m256i;
+	inline constexpr std::ptrdiff_t vec_size = 32;
+	/// byte_mask of a vector whose lanes are all set
+	inline constexpr std::uint32_t all_bytes = 0xFFFF'FFFFU;
+
+	DAW_ATTRIB_INLINE vec_t load( void const *p ) {
+		return _mm256_loadu_si256( static_cast<__m256i const *>( p ) );
+	}
+
+	DAW_ATTRIB_INLINE vec_t bit_or( vec_t a, vec_t b ) {
+		return _mm256_or_si256( a, b );
+	}
+
+	DAW_ATTRIB_INLINE vec_t bit_and( vec_t a, vec_t b ) {
+		return _mm256_and_si256( a, b );
+	}
+
+	DAW_ATTRIB_INLINE vec_t bit_xor( vec_t a, vec_t b ) {
+		return _mm256_xor_si256( a, b );
+	}
+
+	/// a where mask is set, b elsewhere
+	DAW_ATTRIB_INLINE vec_t select( vec_t mask, vec_t a, vec_t b ) {
+		return _mm256_blendv_epi8( b, a, mask );
+	}
+
+	/// One bit per byte of v, from its high bit
+	DAW_ATTRIB_INLINE std::uint32_t byte_mask( vec_t v ) {
+		return static_cast<std::uint32_t>( _mm256_movemask_epi8( v ) );
+	}
+
+	/// Bytewise a - b, wrapping
+	DAW_ATTRIB_INLINE vec_t sub_bytes( vec_t a, vec_t b ) {
+		return _mm256_sub_epi8( a, b );
+	}
+
+	/// The sum of the unsigned bytes of v
+	DAW_ATTRIB_INLINE std::uint64_t sum_bytes( vec_t v ) {
+		auto const sums = _mm256_sad_epu8( v, _mm256_setzero_si256( ) );
+		std::uint64_t parts[4];
+		std::memcpy( parts, &sums, sizeof( sums ) );
+		return parts[0] + parts[1] + parts[2] + parts[3];
+	}
+#else
+	using vec_t = __m128i;
+	inline constexpr std::ptrdiff_t vec_size = 16;
+	/// byte_mask of a vector whose lanes are all set
+	inline constexpr std::uint32_t all_bytes = 0xFFFFU;
+
+	DAW_ATTRIB_INLINE vec_t load( void const *p ) {
+		return _mm_loadu_si128( static_cast<__m128i const *>( p ) );
+	}
+
+	DAW_ATTRIB_INLINE vec_t bit_or( vec_t a, vec_t b ) {
+		return _mm_or_si128( a, b );
+	}
+
+	DAW_ATTRIB_INLINE vec_t bit_and( vec_t a, vec_t b ) {
+		return _mm_and_si128( a, b );
+	}
+
+	DAW_ATTRIB_INLINE vec_t bit_xor( vec_t a, vec_t b ) {
+		return _mm_xor_si128( a, b );
+	}
+
+	/// a where mask is set, b elsewhere
+	DAW_ATTRIB_INLINE vec_t select( vec_t mask, vec_t a, vec_t b ) {
+		return _mm_or_si128( _mm_and_si128( mask, a ),
+		                     _mm_andnot_si128( mask, b ) );
+	}
+
+	/// One bit per byte of v, from its high bit
+	DAW_ATTRIB_INLINE std::uint32_t byte_mask( vec_t v ) {
+		return static_cast<std::uint32_t>( _mm_movemask_epi8( v ) );
+	}
+
+	/// Bytewise a - b, wrapping
+	DAW_ATTRIB_INLINE vec_t sub_bytes( vec_t a, vec_t b ) {
+		return _mm_sub_epi8( a, b );
+	}
+
+	/// The sum of the unsigned bytes of v
+	DAW_ATTRIB_INLINE std::uint64_t sum_bytes( vec_t v ) {
+		auto const sums = _mm_sad_epu8( v, _mm_setzero_si128( ) );
+		std::uint64_t parts[2];
+		std::memcpy( parts, &sums, sizeof( sums ) );
+		return parts[0] + parts[1];
+	}
+#endif
+
+	template<typename T>
+	inline constexpr std::ptrdiff_t lanes =
+	  vec_size / static_cast<std::ptrdiff_t>( sizeof( T ) );
+
+	/// Every lane set to value
+	template<typename T>
+	DAW_ATTRIB_INLINE vec_t splat( T value ) {
+		if constexpr( sizeof( T ) == 1U ) {
+			std::int8_t bits;
+			std::memcpy( &bits, &value, 1U );
+#if defined( DAW_HAS_AVX2 )
+			return _mm256_set1_epi8( bits );
+#else
+			return _mm_set1_epi8( bits );
+#endif
+		} else if constexpr( sizeof( T ) == 2U ) {
+			std::int16_t bits;
+			std::memcpy( &bits, &value, 2U );
+#if defined( DAW_HAS_AVX2 )
+			return _mm256_set1_epi16( bits );
+#else
+			return _mm_set1_epi16( bits );
+#endif
+		} else if constexpr( sizeof( T ) == 4U ) {
+			std::int32_t bits;
+			std::memcpy( &bits, &value, 4U );
+#if defined( DAW_HAS_AVX2 )
+			return _mm256_set1_epi32( bits );
+#else
+			return _mm_set1_epi32( bits );
+#endif
+		} else {
+			long long bits;
+			std::memcpy( &bits, &value, 8U );
+#if defined( DAW_HAS_AVX2 )
+			return _mm256_set1_epi64x( bits );
+#else
+			return _mm_set1_epi64x( bits );
+#endif
+		}
+	}
+
+	/// All bits set in the lanes where a == b
+	template<typename T>
+	DAW_ATTRIB_INLINE vec_t equal( vec_t a, vec_t b ) {
+#if defined( DAW_HAS_AVX2 )
+		if constexpr( std::is_same_v<T, float> ) {
+			return _mm256_castps_si256( _mm256_cmp_ps(
+			  _mm256_castsi256_ps( a ), _mm256_castsi256_ps( b ), _CMP_EQ_OQ ) );
+		} else if constexpr( std::is_same_v<T, double> ) {
+			return _mm256_castpd_si256( _mm256_cmp_pd(
+			  _mm256_castsi256_pd( a ), _mm256_castsi256_pd( b ), _CMP_EQ_OQ ) );
+		} else if constexpr( sizeof( T ) == 1U ) {
+			return _mm256_cmpeq_epi8( a, b );
+		} else if constexpr( sizeof( T ) == 2U ) {
+			return _mm256_cmpeq_epi16( a, b );
+		} else if constexpr( sizeof( T ) == 4U ) {
+			return _mm256_cmpeq_epi32( a, b );
+		} else {
+			return _mm256_cmpeq_epi64( a, b );
+		}
+#else
+		if constexpr( std::is_same_v<T, float> ) {
+			return _mm_castps_si128(
+			  _mm_cmpeq_ps( _mm_castsi128_ps( a ), _mm_castsi128_ps( b ) ) );
+		} else if constexpr( std::is_same_v<T, double> ) {
+			return _mm_castpd_si128(
+			  _mm_cmpeq_pd( _mm_castsi128_pd( a ), _mm_castsi128_pd( b ) ) );
+		} else if constexpr( sizeof( T ) == 1U ) {
+			return _mm_cmpeq_epi8( a, b );
+		} else if constexpr( sizeof( T ) == 2U ) {
+			return _mm_cmpeq_epi16( a, b );
+		} else if constexpr( sizeof( T ) == 4U ) {
+			return _mm_cmpeq_epi32( a, b );
+		} else {
+			// Both 32bit halves of a 64bit lane are equal
+			auto const eq = _mm_cmpeq_epi32( a, b );
+			return _mm_and_si128(
+			  eq, _mm_shuffle_epi32( eq, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+		}
+#endif
+	}
+
+	/// Lanes of T can be ordered in vector registers.  SSE2 and AVX2 have no
+	/// signed 64bit compare and AVX2 has no unsigned one, unsigned lanes are
+	/// biased into the signed range.
+	template<typename T>
+	inline constexpr bool has_less_v =
+	  std::is_floating_point_v<T> or sizeof( T ) <= 4U
+#if defined( DAW_HAS_AVX2 )
+	  or sizeof( T ) == 8U
+#endif
+	  ;
+
+	/// All bits set in the lanes where a < b
+	template<typename T>
+	DAW_ATTRIB_INLINE vec_t less( vec_t a, vec_t b ) {
+#if defined( DAW_HAS_AVX2 )
+		if constexpr( std::is_same_v<T, float> ) {
+			return _mm256_castps_si256( _mm256_cmp_ps(
+			  _mm256_castsi256_ps( a ), _mm256_castsi256_ps( b ), _CMP_LT_OQ ) );
+		} else if constexpr( std::is_same_v<T, double> ) {
+			return _mm256_castpd_si256( _mm256_cmp_pd(
+			  _mm256_castsi256_pd( a ), _mm256_castsi256_pd( b ), _CMP_LT_OQ ) );
+		} else {
+			if constexpr( std::is_unsigned_v<T> ) {
+				auto const bias = splat(
+				  static_cast<T>( T{ 1 } << ( sizeof( T ) * 8U - 1U ) ) );
+				a = bit_xor( a, bias );
+				b = bit_xor( b, bias );
+			}
+			if constexpr( sizeof( T ) == 1U ) {
+				return _mm256_cmpgt_epi8( b, a );
+			} else if constexpr( sizeof( T ) == 2U ) {
+				return _mm256_cmpgt_epi16( b, a );
+			} else if constexpr( sizeof( T ) == 4U ) {
+				return _mm256_cmpgt_epi32( b, a );
+			} else {
+				return _mm256_cmpgt_epi64( b, a );
+			}
+		}
+#else
+		if constexpr( std::is_same_v<T, float> ) {
+			return _mm_castps_si128(
+			  _mm_cmplt_ps( _mm_castsi128_ps( a ), _mm_castsi128_ps( b ) ) );
+		} else if constexpr( std::is_same_v<T, double> ) {
+			return _mm_castpd_si128(
+			  _mm_cmplt_pd( _mm_castsi128_pd( a ), _mm_castsi128_pd( b ) ) );
+		} else {
+			static_assert( sizeof( T ) <= 4U );
+			if constexpr( std::is_unsigned_v<T> ) {
+				auto const bias = splat(
+				  static_cast<T>( T{ 1 } << ( sizeof( T ) * 8U - 1U ) ) );
+				a = bit_xor( a, bias );
+				b = bit_xor( b, bias );
+			}
+			if constexpr( sizeof( T ) == 1U ) {
+				return _mm_cmpgt_epi8( b, a );
+			} else if constexpr( sizeof( T ) == 2U ) {
+				return _mm_cmpgt_epi16( b, a );
+			} else {
+				return _mm_cmpgt_epi32( b, a );
+			}
+		}
+#endif
+	}
+
+	/// The index of the first lane set in a byte_mask
+	template<typename T>
+	DAW_ATTRIB_INLINE std::ptrdiff_t first_lane( std::uint32_t mask ) {
+		return static_cast<std::ptrdiff_t>(
+		  daw::cxmath::count_trailing_zeros( mask ) / sizeof( T ) );
+	}
+
+	/// The first element of [first, last) equal to value, or last.  Four
+	/// vectors are tested per branch, like memchr.
+	template<typename T>
+	T const *find( T const *first, T const *last, T value ) {
+		auto const v = splat( value );
+		constexpr auto w = lanes<T>;
+		while( last - first >= 4 * w ) {
+			auto const e0 = equal<T>( load( first ), v );
+			auto const e1 = equal<T>( load( first + w ), v );
+			auto const e2 = equal<T>( load( first + 2 * w ), v );
+			auto const e3 = equal<T>( load( first + 3 * w ), v );
+			if( byte_mask( bit_or( bit_or( e0, e1 ), bit_or( e2, e3 ) ) ) != 0 ) {
+				std::ptrdiff_t offset = 0;
+				for( auto const e : { e0, e1, e2, e3 } ) {
+					if( auto const m = byte_mask( e ); m != 0 ) {
+						return first + offset + first_lane<T>( m );
+					}
+					offset += w;
+				}
+			}
+			first += 4 * w;
+		}
+		for( ; last - first >= w; first += w ) {
+			if( auto const m = byte_mask( equal<T>( load( first ), v ) ); m != 0 ) {
+				return first + first_lane<T>( m );
+			}
+		}
+		for( ; first != last; ++first ) {
+			if( *first == value ) {
+				return first;
+			}
+		}
+		return last;
+	}
+
+	/// The first element of [first, last) not equal to value, or last
+	template<typename T>
+	T const *find_not( T const *first, T const *last, T value ) {
+		auto const v = splat( value );
+		constexpr auto w = lanes<T>;
+		for( ; last - first >= w; first += w ) {
+			if( auto const m = byte_mask( equal<T>( load( first ), v ) );
+			    m != all_bytes ) {
+				return first + first_lane<T>( ~m );
+			}
+		}
+		for( ; first != last; ++first ) {
+			if( not( *first == value ) ) {
+				return first;
+			}
+		}
+		return last;
+	}
+
+	/// Needles find_any compares in registers
+	inline constexpr std::ptrdiff_t max_needles = 16;
+
+	/// The first element of [first, last) equal to one of the needles, or
+	/// last
+	/// @pre needles_last - needles <= max_needles
+	template<typename T>
+	T const *find_any( T const *first, T const *last, T const *needles,
+	                   T const *needles_last ) {
+		auto const count = needles_last - needles;
+		vec_t vs[max_needles];
+		for( std::ptrdiff_t n = 0; n < count; ++n ) {
+			vs[n] = splat( needles[n] );
+		}
+		constexpr auto w = lanes<T>;
+		for( ; last - first >= w; first += w ) {
+			auto const block = load( first );
+			auto e = equal<T>( block, vs[0] );
+			for( std::ptrdiff_t n = 1; n < count; ++n ) {
+				e = bit_or( e, equal<T>( block, vs[n] ) );
+			}
+			if( auto const m = byte_mask( e ); m != 0 ) {
+				return first + first_lane<T>( m );
+			}
+		}
+		for( ; first != last; ++first ) {
+			for( auto it = needles; it != needles_last; ++it ) {
+				if( *first == *it ) {
+					return first;
+				}
+			}
+		}
+		return last;
+	}
+
+	/// The number of elements of [first, last) equal to value
+	template<typename T>
+	std::size_t count( T const *first, T const *last, T value ) {
+		auto const v = splat( value );
+		constexpr auto w = lanes<T>;
+		// Each equal lane adds one to sizeof( T ) byte counters, which are
+		// summed before they can wrap
+		std::uint64_t bytes = 0;
+		while( last - first >= w ) {
+			auto const blocks =
+			  std::min( ( last - first ) / w, std::ptrdiff_t{ 255 } );
+			auto counters = bit_xor( v, v );
+			for( std::ptrdiff_t n = 0; n < blocks; ++n ) {
+				counters = sub_bytes( counters, equal<T>( load( first ), v ) );
+				first += w;
+			}
+			bytes += sum_bytes( counters );
+		}
+		auto result = static_cast<std::size_t>( bytes / sizeof( T ) );
+		for( ; first != last; ++first ) {
+			result += static_cast<std::size_t>( *first == value );
+		}
+		return result;
+	}
+
+	/// The first position where [first1, last1) and the range at first2
+	/// differ, as a position in the first range
+	template<typename T>
+	T const *mismatch( T const *first1, T const *last1, T const *first2 ) {
+		constexpr auto w = lanes<T>;
+		while( last1 - first1 >= 4 * w ) {
+			auto const e0 = equal<T>( load( first1 ), load( first2 ) );
+			auto const e1 = equal<T>( load( first1 + w ), load( first2 + w ) );
+			auto const e2 =
+			  equal<T>( load( first1 + 2 * w ), load( first2 + 2 * w ) );
+			auto const e3 =
+			  equal<T>( load( first1 + 3 * w ), load( first2 + 3 * w ) );
+			if( byte_mask( bit_and( bit_and( e0, e1 ), bit_and( e2, e3 ) ) ) !=
+			    all_bytes ) {
+				break;
+			}
+			first1 += 4 * w;
+			first2 += 4 * w;
+		}
+		while( last1 - first1 >= w ) {
+			if( auto const m =
+			      byte_mask( equal<T>( load( first1 ), load( first2 ) ) );
+			    m != all_bytes ) {
+				return first1 + first_lane<T>( ~m );
+			}
+			first1 += w;
+			first2 += w;
+		}
+		for( ; first1 != last1; ++first1, ++first2 ) {
+			if( not( *first1 == *first2 ) ) {
+				break;
+			}
+		}
+		return first1;
+	}
+
+	/// The first smallest, or with Max the first largest, element of
+	/// [first, last) as std::min_element/std::max_element with operator<.
+	/// The extreme value is reduced in registers and then found.  NaNs are
+	/// skipped unless the first element is one, which is then the result.
+	template<bool Max, typename T>
+	T const *extreme( T const *first, T const *last ) {
+		if( first == last ) {
+			return last;
+		}
+		if constexpr( std::is_floating_point_v<T> ) {
+			if( not( *first == *first ) ) {
+				return first;
+			}
+		}
+		constexpr auto w = lanes<T>;
+		auto acc = splat( *first );
+		auto p = first;
+		for( ; last - p >= w; p += w ) {
+			auto const v = load( p );
+			acc = Max ? select( less<T>( acc, v ), v, acc )
+			          : select( less<T>( v, acc ), v, acc );
+		}
+		T values[w];
+		std::memcpy( values, &acc, sizeof( acc ) );
+		T best = *first;
+		auto const better = [&]( T const &x ) {
+			return Max ? best < x : x < best;
+		};
+		for( auto const &x : values ) {
+			best = better( x ) ? x : best;
+		}
+		for( ; p != last; ++p ) {
+			best = better( *p ) ? *p : best;
+		}
+		return find( first, last, best );
+	}
+
+	// The kernels on iterator ranges, checked by is_range_v and friends
+
+	template<typename Iterator, typename T>
+	Iterator find_range( Iterator first, Iterator last, T const &value ) {
+		auto const p = to_pointer( first );
+		return to_iterator( first, p, find( p, p + ( last - first ), value ) );
+	}
+
+	template<typename Iterator, typename T>
+	Iterator find_not_range( Iterator first, Iterator last, T const &value ) {
+		auto const p = to_pointer( first );
+		return to_iterator( first, p, find_not( p, p + ( last - first ), value ) );
+	}
+
+	template<typename Iterator1, typename Iterator2>
+	Iterator1 find_any_range( Iterator1 first, Iterator1 last,
+	                          Iterator2 needles_first, Iterator2 needles_last ) {
+		auto const p = to_pointer( first );
+		auto const n = to_pointer( needles_first );
+		return to_iterator(
+		  first, p,
+		  find_any( p, p + ( last - first ), n,
+		            n + ( needles_last - needles_first ) ) );
+	}
+
+	template<typename Iterator, typename T>
+	std::size_t count_range( Iterator first, Iterator last, T const &value ) {
+		auto const p = to_pointer( first );
+		return count( p, p + ( last - first ), value );
+	}
+
+	/// @return The first position that differs in each range
+	template<typename Iterator1, typename Iterator2>
+	std::pair<Iterator1, Iterator2>
+	mismatch_range( Iterator1 first1, Iterator1 last1, Iterator2 first2 ) {
+		auto const p = to_pointer( first1 );
+		auto const pos =
+		  mismatch( p, p + ( last1 - first1 ), to_pointer( first2 ) );
+		return { to_iterator( first1, p, pos ), first2 + ( pos - p ) };
+	}
+
+	template<bool Max, typename Iterator>
+	Iterator extreme_range( Iterator first, Iterator last ) {
+		auto const p = to_pointer( first );
+		return to_iterator( first, p,
+		                    extreme<Max>( p, p + ( last - first ) ) );
+	}
+#endif
+} // namespace daw::algorithm::simd_details
@@ -0,0 +1,576 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/algorithms/daw_algorithm_search.h"
+#include "daw/daw_attributes.h"
+#include "daw/daw_cxmath.h"
+#include "daw/daw_ensure.h"
+#include "daw/daw_is_constant_evaluated.h"
+#include "daw/impl/daw_simd_check.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/// Set operations on sorted ranges of unique elements, e.g. the posting lists
+/// of an inverted index.  Inputs of similar length are merged, 32bit elements
+/// and 64bit elements with AVX2 compare a block of each input against the
+/// other in a few vector instructions.  When one input is more than
+/// gallop_ratio times longer than the other, the short one drives exponential
+/// searches into the long one.
+namespace daw::algorithm {
+	namespace sorted_set_details {
+		/// Above this length ratio the short input gallops through the long one
+		inline constexpr std::ptrdiff_t gallop_ratio = 32;
+
+		template<typename T>
+		inline constexpr bool has_simd_v =
+		  std::is_integral_v<T> and not std::is_same_v<T, bool> and
+#if defined( DAW_HAS_AVX2 )
+		  ( sizeof( T ) == 4U or sizeof( T ) == 8U );
+#else
+		  sizeof( T ) == 4U;
+#endif
+
+		/// Copy [first, last) to out, where out may overlap the source as long as
+		/// it does not start after it
+		template<typename T>
+		DAW_ATTRIB_INLINE constexpr T *copy_down( T const *first, T const *last,
+		                                          T *out ) {
+#if defined( DAW_HAS_IF_CONSTEVAL_COMPAT )
+			if constexpr( std::is_trivially_copyable_v<T> ) {
+				DAW_IF_NOT_CONSTEVAL {
+					auto const n = last - first;
+					if( n > 0 and out != first ) {
+						std::memmove( out, first,
+						              static_cast<std::size_t>( n ) * sizeof( T ) );
+					}
+					return out + n;
+				}
+			}
+#endif
+			for( ; first != last; ++first, ++out ) {
+				*out = *first;
+			}
+			return out;
+		}
+
+		/// lower_bound in [first, last) by doubling steps from first, then a
+		/// binary search of the last step.  O(log d) where d is the distance to
+		/// the result.
+		template<typename T>
+		[[nodiscard]] constexpr T const *gallop( T const *first, T const *last,
+		                                         T const &value ) {
+			auto const n = last - first;
+			std::ptrdiff_t lo = 0;
+			std::ptrdiff_t hi = 1;
+			while( hi < n and first[hi] < value ) {
+				lo = hi;
+				hi *= 2;
+			}
+			return branchless_lower_bound( first + lo,
+			                               first + ( hi < n ? hi + 1 : n ), value );
+		}
+
+		/// Write the elements of block whose bit in mask is set
+		template<typename T>
+		DAW_ATTRIB_INLINE T *emit( T const *block, std::uint32_t mask, T *out ) {
+			while( mask != 0 ) {
+				*out = block[daw::cxmath::count_trailing_zeros( mask )];
+				++out;
+				mask &= mask - 1U;
+			}
+			return out;
+		}
+
+#if defined( DAW_HAS_SSE2 ) and defined( DAW_HAS_IF_CONSTEVAL_COMPAT )
+#define DAW_SORTED_SET_HAS_SIMD
+		/// The elements of one input in a vector register and the number of them
+		template<typename T>
+		inline constexpr std::ptrdiff_t block_size =
+#if defined( DAW_HAS_AVX2 )
+		  static_cast<std::ptrdiff_t>( 32U / sizeof( T ) );
+#else
+		  static_cast<std::ptrdiff_t>( 16U / sizeof( T ) );
+#endif
+
+		/// A bit per element of the block at a that is equal to any element of
+		/// the block at b.  Every pairing is compared by rotating b through the
+		/// lanes.
+		template<typename T>
+		DAW_ATTRIB_INLINE std::uint32_t match_mask( T const *a, T const *b ) {
+#if defined( DAW_HAS_AVX2 )
+			auto const va =
+			  _mm256_loadu_si256( reinterpret_cast<__m256i const *>( a ) );
+			auto vb = _mm256_loadu_si256( reinterpret_cast<__m256i const *>( b ) );
+			if constexpr( sizeof( T ) == 4U ) {
+				auto const rotate = _mm256_setr_epi32( 1, 2, 3, 4, 5, 6, 7, 0 );
+				auto eq = _mm256_cmpeq_epi32( va, vb );
+				for( int r = 1; r < 8; ++r ) {
+					vb = _mm256_permutevar8x32_epi32( vb, rotate );
+					eq = _mm256_or_si256( eq, _mm256_cmpeq_epi32( va, vb ) );
+				}
+				return static_cast<std::uint32_t>(
+				  _mm256_movemask_ps( _mm256_castsi256_ps( eq ) ) );
+			} else {
+				auto eq = _mm256_cmpeq_epi64( va, vb );
+				for( int r = 1; r < 4; ++r ) {
+					vb = _mm256_permute4x64_epi64( vb, _MM_SHUFFLE( 0, 3, 2, 1 ) );
+					eq = _mm256_or_si256( eq, _mm256_cmpeq_epi64( va, vb ) );
+				}
+				return static_cast<std::uint32_t>(
+				  _mm256_movemask_pd( _mm256_castsi256_pd( eq ) ) );
+			}
+#else
+			static_assert( sizeof( T ) == 4U );
+			auto const va = _mm_loadu_si128( reinterpret_cast<__m128i const *>( a ) );
+			auto vb = _mm_loadu_si128( reinterpret_cast<__m128i const *>( b ) );
+			auto eq = _mm_cmpeq_epi32( va, vb );
+			for( int r = 1; r < 4; ++r ) {
+				vb = _mm_shuffle_epi32( vb, _MM_SHUFFLE( 0, 3, 2, 1 ) );
+				eq = _mm_or_si128( eq, _mm_cmpeq_epi32( va, vb ) );
+			}
+			return static_cast<std::uint32_t>(
+			  _mm_movemask_ps( _mm_castsi128_ps( eq ) ) );
+#endif
+		}
+
+		/// The block loop shared by intersection and difference.  Each step
+		/// compares a block of a with a block of b and advances the block with
+		/// the smaller last element.  The matches of an a block accumulate
+		/// until it is retired, then the matched elements are written for an
+		/// intersection or the unmatched ones for a difference.  out is only
+		/// written after the block it may overlap has been read, so out may be
+		/// the start of a.  a and b are left where the scalar merge resumes.
+		/// @return One past the last element written
+		template<bool Intersect, typename T>
+		T *simd_blocks( T const *&a, T const *last_a, T const *&b,
+		                T const *last_b, T *out ) {
+			constexpr auto w = block_size<T>;
+			constexpr auto all = ( std::uint32_t{ 1 } << w ) - 1U;
+			std::uint32_t mask = 0;
+			while( last_a - a >= w and last_b - b >= w ) {
+				mask |= match_mask( a, b );
+				auto const a_max = a[w - 1];
+				auto const b_max = b[w - 1];
+				if( not( b_max < a_max ) ) {
+					auto const keep = Intersect ? mask : ~mask & all;
+					if( keep == all ) {
+						// Common for a difference with a much shorter b
+						std::memmove( out, a, sizeof( T ) * static_cast<std::size_t>( w ) );
+						out += w;
+					} else {
+						out = emit( a, keep, out );
+					}
+					mask = 0;
+					a += w;
+				}
+				if( not( a_max < b_max ) ) {
+					b += w;
+				}
+			}
+			if( mask != 0 ) {
+				// The a block is partially retired, the elements before *b were
+				// only compared against earlier b blocks
+				for( std::uint32_t k = 0; k < static_cast<std::uint32_t>( w ) and
+				                          ( b == last_b or *a < *b );
+				     ++k, ++a ) {
+					auto const matched = ( ( mask >> k ) & 1U ) != 0;
+					if( matched == Intersect ) {
+						*out = *a;
+						++out;
+					}
+				}
+			}
+			return out;
+		}
+#endif
+
+		template<typename T>
+		constexpr T *intersect_merge( T const *a, T const *last_a, T const *b,
+		                              T const *last_b, T *out ) {
+			while( a != last_a and b != last_b ) {
+				auto const x = *a;
+				auto const y = *b;
+				if( not( x < y ) and not( y < x ) ) {
+					*out = x;
+					++out;
+				}
+				a += static_cast<std::ptrdiff_t>( not( y < x ) );
+				b += static_cast<std::ptrdiff_t>( not( x < y ) );
+			}
+			return out;
+		}
+
+		template<typename T>
+		constexpr T *intersect_gallop( T const *small, T const *last_small,
+		                               T const *large, T const *last_large,
+		                               T *out ) {
+			for( ; small != last_small; ++small ) {
+				large = gallop( large, last_large, *small );
+				if( large == last_large ) {
+					break;
+				}
+				if( not( *small < *large ) ) {
+					*out = *small;
+					++out;
+					++large;
+				}
+			}
+			return out;
+		}
+
+		template<typename T>
+		constexpr T *difference_merge( T const *a, T const *last_a, T const *b,
+		                               T const *last_b, T *out ) {
+			while( a != last_a and b != last_b ) {
+				auto const x = *a;
+				auto const y = *b;
+				if( x < y ) {
+					*out = x;
+					++out;
+				}
+				a += static_cast<std::ptrdiff_t>( not( y < x ) );
+				b += static_cast<std::ptrdiff_t>( not( x < y ) );
+			}
+			return copy_down( a, last_a, out );
+		}
+
+		template<typename T>
+		constexpr T *union_merge( T const *a, T const *last_a, T const *b,
+		                          T const *last_b, T *out ) {
+			// Branches are cheaper than selects here, the output store depends on
+			// both and the inputs of a union are often runs
+			while( a != last_a and b != last_b ) {
+				if( *b < *a ) {
+					*out = *b;
+					++b;
+				} else {
+					if( not( *a < *b ) ) {
+						++b;
+					}
+					*out = *a;
+					++a;
+				}
+				++out;
+			}
+			out = copy_down( a, last_a, out );
+			return copy_down( b, last_b, out );
+		}
+
+		/// Union where small is much shorter than large.  The runs of large
+		/// between the elements of small are copied in bulk.
+		template<typename T>
+		constexpr T *union_gallop( T const *small, T const *last_small,
+		                           T const *large, T const *last_large, T *out ) {
+			for( ; small != last_small; ++small ) {
+				auto const pos = gallop( large, last_large, *small );
+				out = copy_down( large, pos, out );
+				*out = *small;
+				++out;
+				large = pos;
+				if( large != last_large and not( *small < *large ) ) {
+					++large;
+				}
+			}
+			return copy_down( large, last_large, out );
+		}
+
+		template<typename Range>
+		using element_t = std::remove_cv_t<
+		  std::remove_pointer_t<decltype( std::data( std::declval<Range &>( ) ) )>>;
+
+		template<typename Container, typename = void>
+		inline constexpr bool has_append_and_overwrite_v = false;
+
+		template<typename Container>
+		inline constexpr bool has_append_and_overwrite_v<
+		  Container,
+		  std::void_t<decltype( std::declval<Container &>( ).append_and_overwrite(
+		    std::declval<std::size_t>( ),
+		    std::declval<std::size_t ( & )( typename Container::pointer,
+		                                     std::size_t )>( ) ) )>> = true;
+
+		/// Grow out by at most bound elements, written by writer from the old
+		/// end.  Storage is reserved once and the unused part trimmed after.
+		template<typename Container, typename Writer>
+		void append_bounded( Container &out, std::size_t bound, Writer &&writer ) {
+			if constexpr( has_append_and_overwrite_v<Container> ) {
+				(void)out.append_and_overwrite(
+				  bound, [&]( typename Container::pointer p, std::size_t ) {
+					  return static_cast<std::size_t>( writer( p ) - p );
+				  } );
+			} else {
+				auto const old_size = static_cast<std::size_t>( out.size( ) );
+				out.resize( old_size + bound );
+				auto *const p = std::data( out ) + old_size;
+				out.resize( old_size + static_cast<std::size_t>( writer( p ) - p ) );
+			}
+		}
+	} // namespace sorted_set_details
+
+	/// @brief Write the elements that are in both sorted sets [first1, last1)
+	/// and [first2, last2) to out.  out may be first1.
+	/// @pre Both inputs are sorted and free of duplicates, out has room for
+	/// the shorter input
+	/// @return One past the last element written
+	template<typename T>
+	constexpr T *sorted_set_intersection( T const *first1, T const *last1,
+	                                      T const *first2, T const *last2,
+	                                      T *out ) {
+		using namespace sorted_set_details;
+		auto const n1 = last1 - first1;
+		auto const n2 = last2 - first2;
+		if( n1 == 0 or n2 == 0 ) {
+			return out;
+		}
+		if( n2 / gallop_ratio > n1 ) {
+			return intersect_gallop( first1, last1, first2, last2, out );
+		}
+		if( n1 / gallop_ratio > n2 ) {
+			return intersect_gallop( first2, last2, first1, last1, out );
+		}
+#if defined( DAW_SORTED_SET_HAS_SIMD )
+		if constexpr( has_simd_v<T> ) {
+			DAW_IF_NOT_CONSTEVAL {
+				out = simd_blocks<true>( first1, last1, first2, last2, out );
+			}
+		}
+#endif
+		return intersect_merge( first1, last1, first2, last2, out );
+	}
+
+	/// @brief Write the elements of the sorted set [first1, last1) that are not
+	/// in the sorted set [first2, last2) to out.  out may be first1.
+	/// @pre Both inputs are sorted and free of duplicates, out has room for
+	/// the first input
+	/// @return One past the last element written
+	template<typename T>
+	constexpr T *sorted_set_difference( T const *first1, T const *last1,
+	                                    T const *first2, T const *last2,
+	                                    T *out ) {
+		using namespace sorted_set_details;
+		auto const n1 = last1 - first1;
+		auto const n2 = last2 - first2;
+		if( n1 == 0 ) {
+			return out;
+		}
+		if( n2 / gallop_ratio > n1 ) {
+			for( ; first1 != last1; ++first1 ) {
+				first2 = gallop( first2, last2, *first1 );
+				if( first2 == last2 ) {
+					break;
+				}
+				if( *first1 < *first2 ) {
+					*out = *first1;
+					++out;
+				}
+			}
+			return copy_down( first1, last1, out );
+		}
+		if( n1 / gallop_ratio > n2 ) {
+			// Copy the runs of the first input between the elements of the second
+			for( ; first2 != last2; ++first2 ) {
+				auto const pos = gallop( first1, last1, *first2 );
+				out = copy_down( first1, pos, out );
+				first1 = pos;
+				if( first1 == last1 ) {
+					return out;
+				}
+				if( not( *first2 < *first1 ) ) {
+					++first1;
+				}
+			}
+			return copy_down( first1, last1, out );
+		}
+#if defined( DAW_SORTED_SET_HAS_SIMD )
+		if constexpr( has_simd_v<T> ) {
+			DAW_IF_NOT_CONSTEVAL {
+				out = simd_blocks<false>( first1, last1, first2, last2, out );
+			}
+		}
+#endif
+		return difference_merge( first1, last1, first2, last2, out );
+	}
+
+	/// @brief Write the elements that are in either sorted set [first1, last1)
+	/// or [first2, last2) to out, once each
+	/// @pre Both inputs are sorted and free of duplicates, out has room for
+	/// both inputs and does not overlap them
+	/// @return One past the last element written
+	template<typename T>
+	constexpr T *sorted_set_union( T const *first1, T const *last1,
+	                               T const *first2, T const *last2, T *out ) {
+		using namespace sorted_set_details;
+		auto const n1 = last1 - first1;
+		auto const n2 = last2 - first2;
+		if( n2 / gallop_ratio > n1 ) {
+			return union_gallop( first1, last1, first2, last2, out );
+		}
+		if( n1 / gallop_ratio > n2 ) {
+			return union_gallop( first2, last2, first1, last1, out );
+		}
+		return union_merge( first1, last1, first2, last2, out );
+	}
+
+	/// @brief Write the elements that are in every sorted set of the ranges
+	/// [first, last) to out.  The shortest two are intersected first and the
+	/// result is narrowed in place by the rest, shortest first.
+	/// @pre Every range is contiguous, sorted and free of duplicates, out has
+	/// room for the shortest one and does not overlap them
+	/// @return One past the last element written
+	template<typename RangeIterator, typename T>
+	T *sorted_set_intersection_many( RangeIterator first, RangeIterator last,
+	                                 T *out ) {
+		auto sets = std::vector<std::pair<T const *, T const *>>( );
+		for( ; first != last; ++first ) {
+			T const *const p = std::data( *first );
+			sets.emplace_back( p, p + std::size( *first ) );
+		}
+		if( sets.empty( ) ) {
+			return out;
+		}
+		std::sort( sets.begin( ), sets.end( ), []( auto const &l, auto const &r ) {
+			return l.second - l.first < r.second - r.first;
+		} );
+		if( sets.size( ) == 1 ) {
+			return sorted_set_details::copy_down( sets[0].first, sets[0].second,
+			                                      out );
+		}
+		auto *result_last = sorted_set_intersection(
+		  sets[0].first, sets[0].second, sets[1].first, sets[1].second, out );
+		for( std::size_t n = 2; n < sets.size( ) and result_last != out; ++n ) {
+			result_last = sorted_set_intersection(
+			  static_cast<T const *>( out ), static_cast<T const *>( result_last ),
+			  sets[n].first, sets[n].second, out );
+		}
+		return result_last;
+	}
+
+	/// @brief sorted_set_intersection into a span_writer like Writer, one
+	/// that has data( ), size( ), and remove_prefix( n ), advanced past the
+	/// output
+	/// @pre writer.size( ) is at least the size of the shorter input
+	template<typename Writer, typename Range1, typename Range2>
+	Writer &sorted_set_intersection_to( Writer &writer, Range1 const &r1,
+	                                    Range2 const &r2 ) {
+		daw_ensure( std::min( std::size( r1 ), std::size( r2 ) ) <=
+		            static_cast<std::size_t>( writer.size( ) ) );
+		auto *const p = writer.data( );
+		auto *const p_last = sorted_set_intersection(
+		  std::data( r1 ), std::data( r1 ) + std::size( r1 ), std::data( r2 ),
+		  std::data( r2 ) + std::size( r2 ), p );
+		writer.remove_prefix( static_cast<std::size_t>( p_last - p ) );
+		return writer;
+	}
+
+	/// @brief sorted_set_difference into a span_writer like Writer, see
+	/// sorted_set_intersection_to
+	/// @pre writer.size( ) is at least the size of the first input
+	template<typename Writer, typename Range1, typename Range2>
+	Writer &sorted_set_difference_to( Writer &writer, Range1 const &r1,
+	                                  Range2 const &r2 ) {
+		daw_ensure( std::size( r1 ) <= static_cast<std::size_t>( writer.size( ) ) );
+		auto *const p = writer.data( );
+		auto *const p_last = sorted_set_difference(
+		  std::data( r1 ), std::data( r1 ) + std::size( r1 ), std::data( r2 ),
+		  std::data( r2 ) + std::size( r2 ), p );
+		writer.remove_prefix( static_cast<std::size_t>( p_last - p ) );
+		return writer;
+	}
+
+	/// @brief sorted_set_union into a span_writer like Writer, see
+	/// sorted_set_intersection_to
+	/// @pre writer.size( ) is at least the size of both inputs
+	template<typename Writer, typename Range1, typename Range2>
+	Writer &sorted_set_union_to( Writer &writer, Range1 const &r1,
+	                             Range2 const &r2 ) {
+		daw_ensure( std::size( r1 ) + std::size( r2 ) <=
+		            static_cast<std::size_t>( writer.size( ) ) );
+		auto *const p = writer.data( );
+		auto *const p_last = sorted_set_union(
+		  std::data( r1 ), std::data( r1 ) + std::size( r1 ), std::data( r2 ),
+		  std::data( r2 ) + std::size( r2 ), p );
+		writer.remove_prefix( static_cast<std::size_t>( p_last - p ) );
+		return writer;
+	}
+
+	/// @brief Append the intersection of the sorted sets r1 and r2 to out.  out
+	/// grows at most once, uninitialized when it has append_and_overwrite
+	/// like daw::vector.
+	template<typename Container, typename Range1, typename Range2>
+	Container &sorted_set_intersection_append( Container &out, Range1 const &r1,
+	                                           Range2 const &r2 ) {
+		sorted_set_details::append_bounded(
+		  out, std::min( std::size( r1 ), std::size( r2 ) ), [&]( auto *p ) {
+			  return sorted_set_intersection( std::data( r1 ),
+			                                  std::data( r1 ) + std::size( r1 ),
+			                                  std::data( r2 ),
+			                                  std::data( r2 ) + std::size( r2 ), p );
+		  } );
+		return out;
+	}
+
+	/// @brief Append the difference of the sorted sets r1 and r2 to out, see
+	/// sorted_set_intersection_append
+	template<typename Container, typename Range1, typename Range2>
+	Container &sorted_set_difference_append( Container &out, Range1 const &r1,
+	                                         Range2 const &r2 ) {
+		sorted_set_details::append_bounded( out, std::size( r1 ), [&]( auto *p ) {
+			return sorted_set_difference( std::data( r1 ),
+			                              std::data( r1 ) + std::size( r1 ),
+			                              std::data( r2 ),
+			                              std::data( r2 ) + std::size( r2 ), p );
+		} );
+		return out;
+	}
+
+	/// @brief Append the union of the sorted sets r1 and r2 to out, see
+	/// sorted_set_intersection_append
+	template<typename Container, typename Range1, typename Range2>
+	Container &sorted_set_union_append( Container &out, Range1 const &r1,
+	                                    Range2 const &r2 ) {
+		sorted_set_details::append_bounded(
+		  out, std::size( r1 ) + std::size( r2 ), [&]( auto *p ) {
+			  return sorted_set_union( std::data( r1 ),
+			                           std::data( r1 ) + std::size( r1 ),
+			                           std::data( r2 ),
+			                           std::data( r2 ) + std::size( r2 ), p );
+		  } );
+		return out;
+	}
+
+	/// @brief Append the intersection of every sorted set of [first, last) to
+	/// out, see sorted_set_intersection_many
+	template<typename Container, typename RangeIterator>
+	Container &sorted_set_intersection_many_append( Container &out,
+	                                                RangeIterator first,
+	                                                RangeIterator last ) {
+		if( first == last ) {
+			return out;
+		}
+		auto bound = std::size( *first );
+		for( auto it = std::next( first ); it != last; ++it ) {
+			bound = std::min( bound, std::size( *it ) );
+		}
+		sorted_set_details::append_bounded(
+		  out, static_cast<std::size_t>( bound ), [&]( auto *p ) {
+			  return sorted_set_intersection_many( first, last, p );
+		  } );
+		return out;
+	}
+} // namespace daw::algorithm
+
+#undef DAW_SORTED_SET_HAS_SIMD
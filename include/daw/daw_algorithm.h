@@ -13,6 +13,8 @@
 #include "daw/algorithms/daw_algorithm_copy.h"
 #include "daw/algorithms/daw_algorithm_copy_n.h"
 #include "daw/algorithms/daw_algorithm_find.h"
+#include "daw/algorithms/daw_algorithm_search.h"
+#include "daw/algorithms/daw_algorithm_simd.h"
 #include "daw/ciso646.h"
 #include "daw/cpp_17.h"
 #include "daw/cpp_17_iterator.h"
@@ -37,6 +39,7 @@
 #include <daw/stdinc/range_access.h>
 #include <iterator>
 #include <optional>
+#include <tuple>
 #include <type_traits>
 #include <vector>
 
@@ -295,6 +298,12 @@ namespace daw::algorithm {
 		traits::is_input_iterator_test<ForwardIterator>( );
 		traits::is_predicate_test<Compare, decltype( *first ), Value>( );
 
+		if constexpr( std::is_base_of_v<
+		                std::random_access_iterator_tag,
+		                typename std::iterator_traits<
+		                  ForwardIterator>::iterator_category> ) {
+			return branchless_lower_bound( first, last, value, cmp );
+		}
 		while( first != last ) {
 			auto mid = std::next( first, std::distance( first, last ) / 2 );
 			if( cmp( *mid, value ) ) {
@@ -309,6 +318,14 @@ namespace daw::algorithm {
 	template<class InputIterator, class T>
 	constexpr InputIterator find( InputIterator first, InputIterator last,
 	                              T const &value ) {
+#if defined( DAW_ALGORITHM_HAS_SIMD )
+		if constexpr( simd_details::is_range_of_v<InputIterator, InputIterator,
+		                                          T> ) {
+			DAW_IF_NOT_CONSTEVAL {
+				return simd_details::find_range( first, last, value );
+			}
+		}
+#endif
 		DAW_UNSAFE_BUFFER_FUNC_START
 		for( ; first != last; ++first ) {
 			if( *first == value ) {
@@ -908,6 +925,36 @@ namespace daw::algorithm {
 		traits::is_compare_test<Compare, decltype( *first2 ),
 		                        decltype( *first1 )>( );
 
+#if defined( DAW_ALGORITHM_HAS_SIMD )
+		if constexpr( simd_details::is_range_pair_v<InputIterator1, LastType1,
+		                                            InputIterator2, LastType2> ) {
+			if constexpr( simd_details::is_less_v<
+			                Compare, simd_details::element_t<InputIterator1>> ) {
+				DAW_IF_NOT_CONSTEVAL {
+					auto const size1 = last1 - first1;
+					auto const size2 = last2 - first2;
+					auto const common = size1 < size2 ? size1 : size2;
+					auto const end1 = std::next( first1, common );
+					while( true ) {
+						std::tie( first1, first2 ) =
+						  simd_details::mismatch_range( first1, end1, first2 );
+						if( first1 == end1 ) {
+							return size1 < size2;
+						}
+						if( *first1 < *first2 ) {
+							return true;
+						}
+						if( *first2 < *first1 ) {
+							return false;
+						}
+						// Unordered, a NaN
+						++first1;
+						++first2;
+					}
+				}
+			}
+		}
+#endif
 		while( ( first1 != last1 ) and ( first2 != last2 ) ) {
 			if( daw::invoke( comp, *first1, *first2 ) ) {
 				return true;
@@ -936,6 +983,27 @@ namespace daw::algorithm {
 		static_assert(
 		  std::is_invocable_v<Equality, decltype( *first1 ), decltype( *first2 )> );
 
+#if defined( DAW_ALGORITHM_HAS_SIMD )
+		if constexpr( simd_details::is_range_pair_v<InputIterator1, LastType1,
+		                                            InputIterator2, LastType2> ) {
+			using value_t = simd_details::element_t<InputIterator1>;
+			if constexpr( simd_details::is_less_v<LessCompare, value_t> and
+			              simd_details::is_equal_to_v<Equality, value_t> ) {
+				DAW_IF_NOT_CONSTEVAL {
+					auto const size1 = last1 - first1;
+					auto const size2 = last2 - first2;
+					auto const common = size1 < size2 ? size1 : size2;
+					auto const end1 = std::next( first1, common );
+					std::tie( first1, first2 ) =
+					  simd_details::mismatch_range( first1, end1, first2 );
+					if( first1 == end1 ) {
+						return size1 == size2 ? 0 : ( size1 < size2 ? -1 : 1 );
+					}
+					return *first1 < *first2 ? -1 : 1;
+				}
+			}
+		}
+#endif
 		while( first1 != last1 and first2 != last2 ) {
 			if( not daw::invoke( eq, *first1, *first2 ) ) {
 				if( daw::invoke( less_comp, *first1, *first2 ) ) {
@@ -1237,6 +1305,19 @@ namespace daw::algorithm {
 		traits::is_compare_test<Compare, decltype( *first1 ),
 		                        decltype( *first2 )>( );
 
+#if defined( DAW_ALGORITHM_HAS_SIMD )
+		if constexpr( simd_details::is_range_pair_v<InputIterator1, LastType1,
+		                                            InputIterator2, LastType2> ) {
+			if constexpr( simd_details::is_equal_to_v<
+			                Compare, simd_details::element_t<InputIterator1>> ) {
+				DAW_IF_NOT_CONSTEVAL {
+					return last1 - first1 == last2 - first2 and
+					       simd_details::mismatch_range( first1, last1, first2 ).first ==
+					         last1;
+				}
+			}
+		}
+#endif
 		while( ( first1 != last1 ) and ( first2 != last2 ) and
 		       daw::invoke( comp, *first1, *first2 ) ) {
 			++first1;
@@ -1293,6 +1374,16 @@ namespace daw::algorithm {
 		traits::is_input_iterator_test<InputIterator1>( );
 		traits::is_input_iterator_test<InputIterator2>( );
 
+#if defined( DAW_ALGORITHM_HAS_SIMD )
+		if constexpr( simd_details::is_range_pair_v<InputIterator1, LastType,
+		                                            InputIterator2,
+		                                            InputIterator2> ) {
+			DAW_IF_NOT_CONSTEVAL {
+				return simd_details::mismatch_range( first1, last1, first2 ).first ==
+				       last1;
+			}
+		}
+#endif
 		while( first1 != last1 and std::equal_to<>{ }( *first1, *first2 ) ) {
 			++first1;
 			++first2;
@@ -1343,6 +1434,12 @@ namespace daw::algorithm {
 		traits::is_forward_access_iterator_test<ForwardIterator>( );
 		traits::is_input_iterator_test<ForwardIterator>( );
 
+		if constexpr( std::is_base_of_v<
+		                std::random_access_iterator_tag,
+		                typename std::iterator_traits<
+		                  ForwardIterator>::iterator_category> ) {
+			return branchless_upper_bound( first, last, value, comp );
+		}
 		auto count = daw::distance( first, last );
 		while( count > 0 ) {
 			auto it = first;
@@ -1604,10 +1701,61 @@ namespace daw::algorithm {
 		}
 	}
 
+	namespace algorithm_details {
+		/// min/max_element of [first, last) can use the vector kernels
+		template<typename ForwardIterator, typename Compare, typename = void>
+		inline constexpr bool has_simd_extreme_v = false;
+
+#if defined( DAW_ALGORITHM_HAS_SIMD )
+		template<typename ForwardIterator, typename Compare>
+		inline constexpr bool has_simd_extreme_v<
+		  ForwardIterator, Compare,
+		  std::enable_if_t<
+		    simd_details::is_range_v<ForwardIterator, ForwardIterator>>> =
+		  simd_details::is_less_v<Compare,
+		                          simd_details::element_t<ForwardIterator>> and
+		  simd_details::has_less_v<simd_details::element_t<ForwardIterator>>;
+#endif
+	} // namespace algorithm_details
+
+	template<class ForwardIterator, typename Compare = std::less<>>
+	constexpr ForwardIterator min_element( ForwardIterator first,
+	                                       ForwardIterator last,
+	                                       Compare &&comp = Compare{ } ) {
+#if defined( DAW_ALGORITHM_HAS_SIMD )
+		if constexpr( algorithm_details::has_simd_extreme_v<ForwardIterator,
+		                                                    Compare> ) {
+			DAW_IF_NOT_CONSTEVAL {
+				return simd_details::extreme_range<false>( first, last );
+			}
+		}
+#endif
+		if( first == last ) {
+			return last;
+		}
+		auto smallest = first;
+		++first;
+		while( first != last ) {
+			if( daw::invoke( comp, *first, *smallest ) ) {
+				smallest = first;
+			}
+			++first;
+		}
+		return smallest;
+	}
+
 	template<class ForwardIterator, typename Compare = std::less<>>
 	constexpr ForwardIterator max_element( ForwardIterator first,
 	                                       ForwardIterator last,
 	                                       Compare &&comp = Compare{ } ) {
+#if defined( DAW_ALGORITHM_HAS_SIMD )
+		if constexpr( algorithm_details::has_simd_extreme_v<ForwardIterator,
+		                                                    Compare> ) {
+			DAW_IF_NOT_CONSTEVAL {
+				return simd_details::extreme_range<true>( first, last );
+			}
+		}
+#endif
 		if( first == last ) {
 			return last;
 		}
@@ -1805,6 +1953,17 @@ namespace daw::algorithm {
 			if( first == last ) {
 				return true;
 			}
+#if defined( DAW_ALGORITHM_HAS_SIMD )
+			if constexpr( simd_details::is_range_v<ForwardIterator, LastType> ) {
+				if constexpr( simd_details::is_equal_to_v<
+				                Compare, simd_details::element_t<ForwardIterator>> ) {
+					DAW_IF_NOT_CONSTEVAL {
+						return simd_details::find_not_range( std::next( first ), last,
+						                                     *first ) == last;
+					}
+				}
+			}
+#endif
 			for( auto it = std::next( first ); it != last; ++it ) {
 				if( not comp( *first, *it ) ) {
 					return false;
@@ -2024,6 +2183,82 @@ namespace daw::algorithm {
 		return result;
 	}
 
+	/// @brief Count the elements of [first, last) equal to value
+	template<typename ResultType = size_t, typename Iterator, typename Last,
+	         typename T>
+	constexpr ResultType count( Iterator first, Last last, T const &value ) {
+		static_assert( std::is_integral_v<ResultType> );
+#if defined( DAW_ALGORITHM_HAS_SIMD )
+		if constexpr( simd_details::is_range_of_v<Iterator, Last, T> ) {
+			DAW_IF_NOT_CONSTEVAL {
+				return static_cast<ResultType>(
+				  simd_details::count_range( first, last, value ) );
+			}
+		}
+#endif
+		ResultType result = 0;
+		while( first != last ) {
+			if( *first == value ) {
+				++result;
+			}
+			++first;
+		}
+		return result;
+	}
+
+	/// @brief The first position where [first1, last1) and the range at
+	/// first2 differ
+	/// @pre The range at first2 is at least as long as [first1, last1)
+	/// @return The positions in each range, last1 when they do not differ
+	template<typename InputIterator1, typename LastType1,
+	         typename InputIterator2>
+	constexpr iterator_pair<InputIterator1, InputIterator2>
+	mismatch( InputIterator1 first1, LastType1 last1, InputIterator2 first2 ) {
+#if defined( DAW_ALGORITHM_HAS_SIMD )
+		if constexpr( simd_details::is_range_pair_v<InputIterator1, LastType1,
+		                                            InputIterator2,
+		                                            InputIterator2> ) {
+			DAW_IF_NOT_CONSTEVAL {
+				auto const result =
+				  simd_details::mismatch_range( first1, last1, first2 );
+				return { result.first, result.second };
+			}
+		}
+#endif
+		while( first1 != last1 and *first1 == *first2 ) {
+			++first1;
+			++first2;
+		}
+		return { first1, first2 };
+	}
+
+	/// @brief The first position where [first1, last1) and [first2, last2)
+	/// differ, or where the shorter one ends
+	template<typename InputIterator1, typename LastType1,
+	         typename InputIterator2, typename LastType2>
+	constexpr iterator_pair<InputIterator1, InputIterator2>
+	mismatch( InputIterator1 first1, LastType1 last1, InputIterator2 first2,
+	          LastType2 last2 ) {
+#if defined( DAW_ALGORITHM_HAS_SIMD )
+		if constexpr( simd_details::is_range_pair_v<InputIterator1, LastType1,
+		                                            InputIterator2, LastType2> ) {
+			DAW_IF_NOT_CONSTEVAL {
+				auto const size1 = last1 - first1;
+				auto const size2 = last2 - first2;
+				auto const result = simd_details::mismatch_range(
+				  first1, std::next( first1, size1 < size2 ? size1 : size2 ),
+				  first2 );
+				return { result.first, result.second };
+			}
+		}
+#endif
+		while( first1 != last1 and first2 != last2 and *first1 == *first2 ) {
+			++first1;
+			++first2;
+		}
+		return { first1, first2 };
+	}
+
 	template<typename Iterator, typename IteratorLast, typename Value>
 	constexpr size_t find_index_of( Iterator first, IteratorLast last,
 	                                Value const &v ) {
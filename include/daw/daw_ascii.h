@@ -8,10 +8,19 @@
 
 #pragma once
 
+#include "daw/ciso646.h"
 #include "daw/daw_attributes.h"
 #include "daw/daw_cpp_feature_check.h"
+#include "daw/daw_cxmath.h"
+#include "daw/daw_ensure.h"
+#include "daw/daw_is_constant_evaluated.h"
+#include "daw/daw_string_view.h"
 #include "daw/impl/daw_make_trait.h"
+#include "daw/impl/daw_simd_check.h"
+#include "daw/traits/daw_traits_is_span_writer.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <type_traits>
 
 namespace daw {
@@ -95,4 +104,755 @@ namespace daw {
 		}
 	};
 	inline constexpr auto to_lower_ascii = to_lower_ascii_t{ };
+
+	struct is_ascii_upper_t {
+		explicit is_ascii_upper_t( ) = default;
+
+		template<typename Integer, std::enable_if_t<std::is_integral_v<Integer>,
+		                                            std::nullptr_t> = nullptr>
+		DAW_ATTRIB_INLINE DAW_CPP23_STATIC_CALL_OP constexpr bool
+		operator( )( Integer c ) DAW_CPP23_STATIC_CALL_OP_CONST {
+			return Integer{ 65 } <= c and c <= Integer{ 90 };
+		}
+	};
+	inline constexpr auto is_ascii_upper = is_ascii_upper_t{ };
+
+	struct is_ascii_lower_t {
+		explicit is_ascii_lower_t( ) = default;
+
+		template<typename Integer, std::enable_if_t<std::is_integral_v<Integer>,
+		                                            std::nullptr_t> = nullptr>
+		DAW_ATTRIB_INLINE DAW_CPP23_STATIC_CALL_OP constexpr bool
+		operator( )( Integer c ) DAW_CPP23_STATIC_CALL_OP_CONST {
+			return Integer{ 97 } <= c and c <= Integer{ 122 };
+		}
+	};
+	inline constexpr auto is_ascii_lower = is_ascii_lower_t{ };
+
+	struct is_ascii_whitespace_t {
+		explicit is_ascii_whitespace_t( ) = default;
+
+		template<typename Integer, std::enable_if_t<std::is_integral_v<Integer>,
+		                                            std::nullptr_t> = nullptr>
+		DAW_ATTRIB_INLINE DAW_CPP23_STATIC_CALL_OP constexpr bool
+		operator( )( Integer c ) DAW_CPP23_STATIC_CALL_OP_CONST {
+			// ' ', '\t', '\n', '\v', '\f', '\r'
+			return c == Integer{ 32 } or ( Integer{ 9 } <= c and c <= Integer{ 13 } );
+		}
+	};
+	inline constexpr auto is_ascii_whitespace = is_ascii_whitespace_t{ };
+
+	/// @brief Character classes understood by the bulk ASCII operations
+	enum class ascii_class {
+		digit,
+		alpha,
+		alphanum,
+		upper,
+		lower,
+		whitespace,
+		printable,
+		non_ascii
+	};
+
+	namespace ascii_impl {
+		[[nodiscard]] DAW_ATTRIB_INLINE constexpr bool
+		is_class( ascii_class cls, char c ) {
+			switch( cls ) {
+			case ascii_class::digit:
+				return is_ascii_digit( c );
+			case ascii_class::alpha:
+				return is_ascii_alpha( c );
+			case ascii_class::alphanum:
+				return is_ascii_alphanum( c );
+			case ascii_class::upper:
+				return is_ascii_upper( c );
+			case ascii_class::lower:
+				return is_ascii_lower( c );
+			case ascii_class::whitespace:
+				return is_ascii_whitespace( c );
+			case ascii_class::printable:
+				return is_ascii_printable( c );
+			case ascii_class::non_ascii:
+				return static_cast<unsigned char>( c ) >= 0x80U;
+			}
+			return false;
+		}
+
+		/// Little endian load so the result is the same in constant evaluation
+		/// and on any platform
+		[[nodiscard]] DAW_ATTRIB_INLINE constexpr std::uint64_t
+		load_word( char const *p, std::size_t count ) {
+			auto result = std::uint64_t{ 0 };
+			for( std::size_t n = 0; n < count; ++n ) {
+				result |= static_cast<std::uint64_t>( static_cast<unsigned char>( p[n] ) )
+				          << ( 8U * n );
+			}
+			return result;
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE constexpr std::uint64_t
+		load_word8( char const *p ) {
+			return static_cast<std::uint64_t>( static_cast<unsigned char>( p[0] ) ) |
+			       static_cast<std::uint64_t>( static_cast<unsigned char>( p[1] ) )
+			         << 8U |
+			       static_cast<std::uint64_t>( static_cast<unsigned char>( p[2] ) )
+			         << 16U |
+			       static_cast<std::uint64_t>( static_cast<unsigned char>( p[3] ) )
+			         << 24U |
+			       static_cast<std::uint64_t>( static_cast<unsigned char>( p[4] ) )
+			         << 32U |
+			       static_cast<std::uint64_t>( static_cast<unsigned char>( p[5] ) )
+			         << 40U |
+			       static_cast<std::uint64_t>( static_cast<unsigned char>( p[6] ) )
+			         << 48U |
+			       static_cast<std::uint64_t>( static_cast<unsigned char>( p[7] ) )
+			         << 56U;
+		}
+
+		/// Lower case the ASCII letters in all 8 bytes of w, bytes >= 0x80 are
+		/// left alone
+		[[nodiscard]] DAW_ATTRIB_INLINE constexpr std::uint64_t
+		to_lower_word( std::uint64_t w ) {
+			constexpr auto ones = std::uint64_t{ 0x0101'0101'0101'0101ULL };
+			constexpr auto high_bits = ones * 0x80U;
+			auto const heptets = w & ( ones * 0x7FU );
+			auto const above_z = heptets + ones * ( 0x7FU - 90U );
+			auto const from_a = heptets + ones * ( 0x80U - 65U );
+			auto const is_upper = ( from_a ^ above_z ) & ~w & high_bits;
+			return w | ( is_upper >> 2U );
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE constexpr std::uint64_t
+		hash_mix( std::uint64_t h ) {
+			h ^= h >> 31U;
+			h *= 0x7fb5'd329'728e'a185ULL;
+			h ^= h >> 27U;
+			h *= 0x81da'def4'bc2d'd44dULL;
+			h ^= h >> 33U;
+			return h;
+		}
+
+#if defined( DAW_HAS_SSE2 ) and defined( DAW_HAS_IF_CONSTEVAL_COMPAT )
+#define DAW_ASCII_HAS_SIMD
+#if defined( DAW_HAS_AVX2 )
+		using simd_t = __m256i;
+		inline constexpr std::size_t simd_width = 32;
+		inline constexpr std::uint32_t simd_full_mask = 0xFFFF'FFFFU;
+
+		DAW_ATTRIB_INLINE simd_t simd_load( char const *p ) {
+			return _mm256_loadu_si256( reinterpret_cast<simd_t const *>( p ) );
+		}
+
+		DAW_ATTRIB_INLINE void simd_store( char *p, simd_t v ) {
+			_mm256_storeu_si256( reinterpret_cast<simd_t *>( p ), v );
+		}
+
+		DAW_ATTRIB_INLINE simd_t simd_splat( char c ) {
+			return _mm256_set1_epi8( c );
+		}
+
+		DAW_ATTRIB_INLINE simd_t simd_zero( ) {
+			return _mm256_setzero_si256( );
+		}
+
+		/// Signed byte wise a > b
+		DAW_ATTRIB_INLINE simd_t simd_gt( simd_t a, simd_t b ) {
+			return _mm256_cmpgt_epi8( a, b );
+		}
+
+		DAW_ATTRIB_INLINE simd_t simd_eq( simd_t a, simd_t b ) {
+			return _mm256_cmpeq_epi8( a, b );
+		}
+
+		DAW_ATTRIB_INLINE simd_t simd_and( simd_t a, simd_t b ) {
+			return _mm256_and_si256( a, b );
+		}
+
+		DAW_ATTRIB_INLINE simd_t simd_or( simd_t a, simd_t b ) {
+			return _mm256_or_si256( a, b );
+		}
+
+		/// a & ~b
+		DAW_ATTRIB_INLINE simd_t simd_and_not( simd_t a, simd_t b ) {
+			return _mm256_andnot_si256( b, a );
+		}
+
+		DAW_ATTRIB_INLINE simd_t simd_sub8( simd_t a, simd_t b ) {
+			return _mm256_sub_epi8( a, b );
+		}
+
+		DAW_ATTRIB_INLINE std::uint32_t simd_movemask( simd_t v ) {
+			return static_cast<std::uint32_t>( _mm256_movemask_epi8( v ) );
+		}
+
+		/// Sum of the unsigned bytes in v
+		DAW_ATTRIB_INLINE std::size_t simd_sum_bytes( simd_t v ) {
+			auto const sums = _mm256_sad_epu8( v, _mm256_setzero_si256( ) );
+			alignas( 32 ) std::uint64_t parts[4];
+			_mm256_store_si256( reinterpret_cast<simd_t *>( parts ), sums );
+			return static_cast<std::size_t>( parts[0] + parts[1] + parts[2] +
+			                                 parts[3] );
+		}
+#else
+		using simd_t = __m128i;
+		inline constexpr std::size_t simd_width = 16;
+		inline constexpr std::uint32_t simd_full_mask = 0xFFFFU;
+
+		DAW_ATTRIB_INLINE simd_t simd_load( char const *p ) {
+			return _mm_loadu_si128( reinterpret_cast<simd_t const *>( p ) );
+		}
+
+		DAW_ATTRIB_INLINE void simd_store( char *p, simd_t v ) {
+			_mm_storeu_si128( reinterpret_cast<simd_t *>( p ), v );
+		}
+
+		DAW_ATTRIB_INLINE simd_t simd_splat( char c ) {
+			return _mm_set1_epi8( c );
+		}
+
+		DAW_ATTRIB_INLINE simd_t simd_zero( ) {
+			return _mm_setzero_si128( );
+		}
+
+		/// Signed byte wise a > b
+		DAW_ATTRIB_INLINE simd_t simd_gt( simd_t a, simd_t b ) {
+			return _mm_cmpgt_epi8( a, b );
+		}
+
+		DAW_ATTRIB_INLINE simd_t simd_eq( simd_t a, simd_t b ) {
+			return _mm_cmpeq_epi8( a, b );
+		}
+
+		DAW_ATTRIB_INLINE simd_t simd_and( simd_t a, simd_t b ) {
+			return _mm_and_si128( a, b );
+		}
+
+		DAW_ATTRIB_INLINE simd_t simd_or( simd_t a, simd_t b ) {
+			return _mm_or_si128( a, b );
+		}
+
+		/// a & ~b
+		DAW_ATTRIB_INLINE simd_t simd_and_not( simd_t a, simd_t b ) {
+			return _mm_andnot_si128( b, a );
+		}
+
+		DAW_ATTRIB_INLINE simd_t simd_sub8( simd_t a, simd_t b ) {
+			return _mm_sub_epi8( a, b );
+		}
+
+		DAW_ATTRIB_INLINE std::uint32_t simd_movemask( simd_t v ) {
+			return static_cast<std::uint32_t>( _mm_movemask_epi8( v ) );
+		}
+
+		/// Sum of the unsigned bytes in v
+		DAW_ATTRIB_INLINE std::size_t simd_sum_bytes( simd_t v ) {
+			auto const sums = _mm_sad_epu8( v, _mm_setzero_si128( ) );
+			return static_cast<std::size_t>( _mm_cvtsi128_si32( sums ) ) +
+			       static_cast<std::size_t>(
+			         _mm_cvtsi128_si32( _mm_srli_si128( sums, 8 ) ) );
+		}
+#endif
+
+		/// 0xFF in the bytes of v that are in [lo, hi].  Both bounds must be ASCII
+		/// so that the signed compare rejects bytes >= 0x80
+		template<char Lo, char Hi>
+		DAW_ATTRIB_INLINE simd_t simd_in_range( simd_t v ) {
+			static_assert( 0 < Lo and Lo <= Hi and Hi < 127 );
+			return simd_and( simd_gt( v, simd_splat( static_cast<char>( Lo - 1 ) ) ),
+			                 simd_gt( simd_splat( static_cast<char>( Hi + 1 ) ), v ) );
+		}
+
+		DAW_ATTRIB_INLINE simd_t simd_to_lower( simd_t v ) {
+			return simd_or( v, simd_and( simd_in_range<'A', 'Z'>( v ),
+			                             simd_splat( 0x20 ) ) );
+		}
+
+		DAW_ATTRIB_INLINE simd_t simd_to_upper( simd_t v ) {
+			return simd_and_not( v, simd_and( simd_in_range<'a', 'z'>( v ),
+			                                  simd_splat( 0x20 ) ) );
+		}
+
+		template<ascii_class Class>
+		DAW_ATTRIB_INLINE simd_t simd_class_mask( simd_t v ) {
+			if constexpr( Class == ascii_class::digit ) {
+				return simd_in_range<'0', '9'>( v );
+			} else if constexpr( Class == ascii_class::alpha ) {
+				// Setting 0x20 folds 'A'-'Z' onto 'a'-'z' and nothing else onto it
+				return simd_in_range<'a', 'z'>( simd_or( v, simd_splat( 0x20 ) ) );
+			} else if constexpr( Class == ascii_class::alphanum ) {
+				return simd_or( simd_class_mask<ascii_class::alpha>( v ),
+				                simd_in_range<'0', '9'>( v ) );
+			} else if constexpr( Class == ascii_class::upper ) {
+				return simd_in_range<'A', 'Z'>( v );
+			} else if constexpr( Class == ascii_class::lower ) {
+				return simd_in_range<'a', 'z'>( v );
+			} else if constexpr( Class == ascii_class::whitespace ) {
+				return simd_or( simd_eq( v, simd_splat( ' ' ) ),
+				                simd_in_range<'\t', '\r'>( v ) );
+			} else if constexpr( Class == ascii_class::printable ) {
+				return simd_in_range<' ', '~'>( v );
+			} else {
+				return simd_gt( simd_zero( ), v );
+			}
+		}
+
+		struct lower_op {
+			DAW_ATTRIB_INLINE simd_t operator( )( simd_t v ) const {
+				return simd_to_lower( v );
+			}
+
+			DAW_ATTRIB_INLINE char operator( )( char c ) const {
+				return to_lower_ascii( c );
+			}
+		};
+
+		struct upper_op {
+			DAW_ATTRIB_INLINE simd_t operator( )( simd_t v ) const {
+				return simd_to_upper( v );
+			}
+
+			DAW_ATTRIB_INLINE char operator( )( char c ) const {
+				return to_upper_ascii( c );
+			}
+		};
+
+		/// out[i] = op( in[i] ), in and out are either the same or do not overlap
+		template<typename Op>
+		DAW_ATTRIB_FLATTEN inline void simd_transform( char const *in,
+		                                               std::size_t size, char *out,
+		                                               Op op ) {
+			if( size < simd_width ) {
+				for( std::size_t n = 0; n < size; ++n ) {
+					out[n] = op( in[n] );
+				}
+				return;
+			}
+			std::size_t n = 0;
+			for( ; n + simd_width <= size; n += simd_width ) {
+				simd_store( out + n, op( simd_load( in + n ) ) );
+			}
+			if( n != size ) {
+				// The transforms are idempotent, so overlapping the last full vector
+				// with already written output is fine
+				auto const last = size - simd_width;
+				simd_store( out + last, op( simd_load( in + last ) ) );
+			}
+		}
+
+		[[nodiscard]] DAW_ATTRIB_FLATTEN inline bool
+		simd_all_ascii( char const *p, std::size_t size ) {
+			std::size_t n = 0;
+			for( ; n + 4U * simd_width <= size; n += 4U * simd_width ) {
+				auto const v =
+				  simd_or( simd_or( simd_load( p + n ), simd_load( p + n + simd_width ) ),
+				           simd_or( simd_load( p + n + 2U * simd_width ),
+				                    simd_load( p + n + 3U * simd_width ) ) );
+				if( simd_movemask( v ) != 0 ) {
+					return false;
+				}
+			}
+			for( ; n + simd_width <= size; n += simd_width ) {
+				if( simd_movemask( simd_load( p + n ) ) != 0 ) {
+					return false;
+				}
+			}
+			for( ; n < size; ++n ) {
+				if( static_cast<unsigned char>( p[n] ) >= 0x80U ) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		[[nodiscard]] DAW_ATTRIB_FLATTEN inline bool
+		simd_all_digits( char const *p, std::size_t size ) {
+			std::size_t n = 0;
+			for( ; n + 2U * simd_width <= size; n += 2U * simd_width ) {
+				auto const v = simd_and( simd_in_range<'0', '9'>( simd_load( p + n ) ),
+				                         simd_in_range<'0', '9'>(
+				                           simd_load( p + n + simd_width ) ) );
+				if( simd_movemask( v ) != simd_full_mask ) {
+					return false;
+				}
+			}
+			for( ; n < size; ++n ) {
+				if( not is_ascii_digit( p[n] ) ) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		template<ascii_class Class>
+		[[nodiscard]] DAW_ATTRIB_FLATTEN inline std::size_t
+		simd_count_class( char const *p, std::size_t size ) {
+			std::size_t result = 0;
+			std::size_t n = 0;
+			while( n + simd_width <= size ) {
+				// Each byte of acc counts matches in its column, flush before it can
+				// overflow
+				auto acc = simd_zero( );
+				auto const blocks = ( size - n ) / simd_width;
+				auto const batch = blocks < 255U ? blocks : std::size_t{ 255 };
+				for( std::size_t b = 0; b < batch; ++b, n += simd_width ) {
+					acc = simd_sub8( acc, simd_class_mask<Class>( simd_load( p + n ) ) );
+				}
+				result += simd_sum_bytes( acc );
+			}
+			for( ; n < size; ++n ) {
+				result += static_cast<std::size_t>( is_class( Class, p[n] ) );
+			}
+			return result;
+		}
+
+		/// @return the first position where the lower case forms of l and r
+		/// differ, or size
+		[[nodiscard]] DAW_ATTRIB_FLATTEN inline std::size_t
+		simd_mismatch_icase( char const *l, char const *r, std::size_t size ) {
+			std::size_t n = 0;
+			for( ; n + simd_width <= size; n += simd_width ) {
+				auto const eq = simd_movemask( simd_eq( simd_to_lower( simd_load( l + n ) ),
+				                                        simd_to_lower( simd_load( r + n ) ) ) );
+				if( eq != simd_full_mask ) {
+					return n + static_cast<std::size_t>(
+					             daw::cxmath::count_trailing_zeros( ~eq & simd_full_mask ) );
+				}
+			}
+			for( ; n < size; ++n ) {
+				if( to_lower_ascii( l[n] ) != to_lower_ascii( r[n] ) ) {
+					return n;
+				}
+			}
+			return size;
+		}
+
+		/// Candidates are positions where both the first and last characters of
+		/// the needle match, only those are compared in full
+		[[nodiscard]] DAW_ATTRIB_FLATTEN inline std::size_t
+		simd_find_icase( char const *hay, std::size_t hay_size, char const *needle,
+		                 std::size_t needle_size ) {
+			auto const first = simd_splat( to_lower_ascii( needle[0] ) );
+			auto const last = simd_splat( to_lower_ascii( needle[needle_size - 1] ) );
+			auto const middle = needle_size > 2U ? needle_size - 2U : std::size_t{ 0 };
+			std::size_t n = 0;
+			for( ; n + needle_size - 1U + simd_width <= hay_size; n += simd_width ) {
+				auto const f = simd_eq( first, simd_to_lower( simd_load( hay + n ) ) );
+				auto const l = simd_eq(
+				  last, simd_to_lower( simd_load( hay + n + needle_size - 1U ) ) );
+				auto mask = simd_movemask( simd_and( f, l ) );
+				while( mask != 0 ) {
+					auto const pos =
+					  n + static_cast<std::size_t>( daw::cxmath::count_trailing_zeros( mask ) );
+					if( simd_mismatch_icase( hay + pos + 1U, needle + 1U, middle ) ==
+					    middle ) {
+						return pos;
+					}
+					mask &= mask - 1U;
+				}
+			}
+			for( ; n + needle_size <= hay_size; ++n ) {
+				if( simd_mismatch_icase( hay + n, needle, needle_size ) == needle_size ) {
+					return n;
+				}
+			}
+			return daw::string_view::npos;
+		}
+#endif
+
+		template<ascii_class Class>
+		[[nodiscard]] std::size_t count_class( char const *p, std::size_t size ) {
+#if defined( DAW_ASCII_HAS_SIMD )
+			return simd_count_class<Class>( p, size );
+#else
+			std::size_t result = 0;
+			for( std::size_t n = 0; n < size; ++n ) {
+				result += static_cast<std::size_t>( is_class( Class, p[n] ) );
+			}
+			return result;
+#endif
+		}
+
+		[[nodiscard]] constexpr std::size_t mismatch_icase( char const *l,
+		                                                    char const *r,
+		                                                    std::size_t size ) {
+#if defined( DAW_ASCII_HAS_SIMD )
+			DAW_IF_NOT_CONSTEVAL {
+				return simd_mismatch_icase( l, r, size );
+			}
+#endif
+			for( std::size_t n = 0; n < size; ++n ) {
+				if( to_lower_ascii( l[n] ) != to_lower_ascii( r[n] ) ) {
+					return n;
+				}
+			}
+			return size;
+		}
+	} // namespace ascii_impl
+
+	/// @brief Lower case the ASCII letters of [ptr, ptr + size) in place
+	constexpr void to_lower_ascii_in_place( char *ptr, std::size_t size ) {
+#if defined( DAW_ASCII_HAS_SIMD )
+		DAW_IF_NOT_CONSTEVAL {
+			ascii_impl::simd_transform( ptr, size, ptr, ascii_impl::lower_op{ } );
+			return;
+		}
+#endif
+		for( std::size_t n = 0; n < size; ++n ) {
+			ptr[n] = to_lower_ascii( ptr[n] );
+		}
+	}
+
+	/// @brief Upper case the ASCII letters of [ptr, ptr + size) in place
+	constexpr void to_upper_ascii_in_place( char *ptr, std::size_t size ) {
+#if defined( DAW_ASCII_HAS_SIMD )
+		DAW_IF_NOT_CONSTEVAL {
+			ascii_impl::simd_transform( ptr, size, ptr, ascii_impl::upper_op{ } );
+			return;
+		}
+#endif
+		for( std::size_t n = 0; n < size; ++n ) {
+			ptr[n] = to_upper_ascii( ptr[n] );
+		}
+	}
+
+	/// @brief Write the lower case form of in to out, which must not overlap in
+	/// and have room for in.size( ) characters
+	/// @return one past the last character written
+	constexpr char *to_lower_ascii_copy( daw::string_view in, char *out ) {
+#if defined( DAW_ASCII_HAS_SIMD )
+		DAW_IF_NOT_CONSTEVAL {
+			ascii_impl::simd_transform( in.data( ), in.size( ), out,
+			                            ascii_impl::lower_op{ } );
+			return out + in.size( );
+		}
+#endif
+		for( char c : in ) {
+			*out++ = to_lower_ascii( c );
+		}
+		return out;
+	}
+
+	/// @brief Write the upper case form of in to out, which must not overlap in
+	/// and have room for in.size( ) characters
+	/// @return one past the last character written
+	constexpr char *to_upper_ascii_copy( daw::string_view in, char *out ) {
+#if defined( DAW_ASCII_HAS_SIMD )
+		DAW_IF_NOT_CONSTEVAL {
+			ascii_impl::simd_transform( in.data( ), in.size( ), out,
+			                            ascii_impl::upper_op{ } );
+			return out + in.size( );
+		}
+#endif
+		for( char c : in ) {
+			*out++ = to_upper_ascii( c );
+		}
+		return out;
+	}
+
+	/// @brief Append the lower case form of in to a writer such as
+	/// daw::span_writer<char>
+	template<typename Writer,
+	         std::enable_if_t<traits::is_span_writer_v<Writer>, std::nullptr_t> =
+	           nullptr>
+	constexpr Writer &to_lower_ascii_copy( daw::string_view in, Writer &out ) {
+		daw_ensure( in.size( ) <= out.size( ) );
+		(void)to_lower_ascii_copy( in, out.data( ) );
+		out.remove_prefix( in.size( ) );
+		return out;
+	}
+
+	/// @brief Append the upper case form of in to a writer such as
+	/// daw::span_writer<char>
+	template<typename Writer,
+	         std::enable_if_t<traits::is_span_writer_v<Writer>, std::nullptr_t> =
+	           nullptr>
+	constexpr Writer &to_upper_ascii_copy( daw::string_view in, Writer &out ) {
+		daw_ensure( in.size( ) <= out.size( ) );
+		(void)to_upper_ascii_copy( in, out.data( ) );
+		out.remove_prefix( in.size( ) );
+		return out;
+	}
+
+	/// @brief Are all characters of sv in the range [0, 128)
+	[[nodiscard]] constexpr bool all_ascii( daw::string_view sv ) {
+#if defined( DAW_ASCII_HAS_SIMD )
+		DAW_IF_NOT_CONSTEVAL {
+			return ascii_impl::simd_all_ascii( sv.data( ), sv.size( ) );
+		}
+#endif
+		for( char c : sv ) {
+			if( static_cast<unsigned char>( c ) >= 0x80U ) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/// @brief Is sv non-empty and made only of '0'-'9'
+	[[nodiscard]] constexpr bool is_all_digits( daw::string_view sv ) {
+		if( sv.empty( ) ) {
+			return false;
+		}
+#if defined( DAW_ASCII_HAS_SIMD )
+		DAW_IF_NOT_CONSTEVAL {
+			return ascii_impl::simd_all_digits( sv.data( ), sv.size( ) );
+		}
+#endif
+		for( char c : sv ) {
+			if( not is_ascii_digit( c ) ) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/// @brief Count the characters of sv that are in cls
+	[[nodiscard]] constexpr std::size_t count_if_class( daw::string_view sv,
+	                                                    ascii_class cls ) {
+#if defined( DAW_ASCII_HAS_SIMD )
+		DAW_IF_NOT_CONSTEVAL {
+			auto const *const p = sv.data( );
+			auto const sz = sv.size( );
+			switch( cls ) {
+			case ascii_class::digit:
+				return ascii_impl::count_class<ascii_class::digit>( p, sz );
+			case ascii_class::alpha:
+				return ascii_impl::count_class<ascii_class::alpha>( p, sz );
+			case ascii_class::alphanum:
+				return ascii_impl::count_class<ascii_class::alphanum>( p, sz );
+			case ascii_class::upper:
+				return ascii_impl::count_class<ascii_class::upper>( p, sz );
+			case ascii_class::lower:
+				return ascii_impl::count_class<ascii_class::lower>( p, sz );
+			case ascii_class::whitespace:
+				return ascii_impl::count_class<ascii_class::whitespace>( p, sz );
+			case ascii_class::printable:
+				return ascii_impl::count_class<ascii_class::printable>( p, sz );
+			case ascii_class::non_ascii:
+				return ascii_impl::count_class<ascii_class::non_ascii>( p, sz );
+			}
+		}
+#endif
+		std::size_t result = 0;
+		for( char c : sv ) {
+			result += static_cast<std::size_t>( ascii_impl::is_class( cls, c ) );
+		}
+		return result;
+	}
+
+	/// @brief Compare l and r ignoring ASCII case
+	[[nodiscard]] constexpr bool equal_ascii_icase( daw::string_view l,
+	                                                daw::string_view r ) {
+		return l.size( ) == r.size( ) and
+		       ascii_impl::mismatch_icase( l.data( ), r.data( ), l.size( ) ) ==
+		         l.size( );
+	}
+
+	/// @brief Three way compare of l and r ignoring ASCII case, characters are
+	/// ordered by the unsigned value of their lower case form
+	/// @return a negative number, zero or a positive number as l is less than,
+	/// equal to or greater than r
+	[[nodiscard]] constexpr int compare_ascii_icase( daw::string_view l,
+	                                                 daw::string_view r ) {
+		auto const sz = l.size( ) < r.size( ) ? l.size( ) : r.size( );
+		auto const pos = ascii_impl::mismatch_icase( l.data( ), r.data( ), sz );
+		if( pos != sz ) {
+			return static_cast<int>( static_cast<unsigned char>(
+			         to_lower_ascii( l[pos] ) ) ) -
+			       static_cast<int>(
+			         static_cast<unsigned char>( to_lower_ascii( r[pos] ) ) );
+		}
+		if( l.size( ) == r.size( ) ) {
+			return 0;
+		}
+		return l.size( ) < r.size( ) ? -1 : 1;
+	}
+
+	/// @brief A hash of sv that is the same for strings equal under
+	/// equal_ascii_icase.  Four independent lanes fold eight characters each per
+	/// step, and the result is the same in constant evaluation and at runtime
+	[[nodiscard]] constexpr std::size_t hash_ascii_icase( daw::string_view sv ) {
+		constexpr auto mul = 0xbf58'476d'1ce4'e5b9ULL;
+		auto const *p = sv.data( );
+		auto sz = sv.size( );
+		auto h = 0x9e37'79b9'7f4a'7c15ULL ^ static_cast<std::uint64_t>( sz );
+		if( sz >= 32U ) {
+			std::uint64_t lanes[4] = { h, h + 1U, h + 2U, h + 3U };
+			for( ; sz >= 32U; sz -= 32U, p += 32 ) {
+				for( std::size_t n = 0; n < 4U; ++n ) {
+					auto const w = ascii_impl::to_lower_word(
+					  ascii_impl::load_word8( p + 8U * n ) );
+					lanes[n] = ( lanes[n] ^ w ) * mul;
+					lanes[n] ^= lanes[n] >> 29U;
+				}
+			}
+			h = 0;
+			for( auto lane : lanes ) {
+				h = ascii_impl::hash_mix( h ^ lane );
+			}
+		}
+		for( ; sz >= 8U; sz -= 8U, p += 8 ) {
+			h = ( h ^ ascii_impl::to_lower_word( ascii_impl::load_word8( p ) ) ) * mul;
+			h ^= h >> 29U;
+		}
+		if( sz > 0 ) {
+			h ^= ascii_impl::to_lower_word( ascii_impl::load_word( p, sz ) );
+		}
+		return static_cast<std::size_t>( ascii_impl::hash_mix( h ) );
+	}
+
+	/// @brief Find the first occurrence of needle in haystack ignoring ASCII case
+	/// @return the position found or daw::string_view::npos
+	[[nodiscard]] constexpr std::size_t find_ascii_icase( daw::string_view haystack,
+	                                                      daw::string_view needle ) {
+		if( needle.empty( ) ) {
+			return 0;
+		}
+		if( needle.size( ) > haystack.size( ) ) {
+			return daw::string_view::npos;
+		}
+#if defined( DAW_ASCII_HAS_SIMD )
+		DAW_IF_NOT_CONSTEVAL {
+			return ascii_impl::simd_find_icase( haystack.data( ), haystack.size( ),
+			                                    needle.data( ), needle.size( ) );
+		}
+#endif
+		auto const last = haystack.size( ) - needle.size( );
+		for( std::size_t n = 0; n <= last; ++n ) {
+			if( ascii_impl::mismatch_icase( haystack.data( ) + n, needle.data( ),
+			                                needle.size( ) ) == needle.size( ) ) {
+				return n;
+			}
+		}
+		return daw::string_view::npos;
+	}
+
+	/// @brief Transparent hasher for case insensitive unordered containers
+	struct ascii_icase_hash {
+		using is_transparent = void;
+
+		[[nodiscard]] constexpr std::size_t operator( )( daw::string_view sv ) const {
+			return hash_ascii_icase( sv );
+		}
+	};
+
+	/// @brief Transparent equality for case insensitive unordered containers
+	struct ascii_icase_equal {
+		using is_transparent = void;
+
+		[[nodiscard]] constexpr bool operator( )( daw::string_view l,
+		                                          daw::string_view r ) const {
+			return equal_ascii_icase( l, r );
+		}
+	};
+
+	/// @brief Transparent ordering for case insensitive ordered containers
+	struct ascii_icase_less {
+		using is_transparent = void;
+
+		[[nodiscard]] constexpr bool operator( )( daw::string_view l,
+		                                          daw::string_view r ) const {
+			return compare_ascii_icase( l, r ) < 0;
+		}
+	};
 } // namespace daw
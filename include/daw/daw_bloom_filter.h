@@ -0,0 +1,458 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/ciso646.h"
+#include "daw/daw_attributes.h"
+#include "daw/daw_ensure.h"
+#include "daw/daw_prefetch.h"
+#include "daw/impl/daw_filter_common.h"
+#include "daw/impl/daw_simd_check.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#if defined( DAW_HAS_MSVC )
+#include <intrin.h>
+#endif
+
+namespace daw {
+	/// @brief A 256bit block of a blocked bloom filter.  Each key sets one bit
+	/// in each of the 8 words so a lookup touches a single cache line
+	struct alignas( 32 ) bloom_block {
+		std::uint32_t words[8];
+	};
+	static_assert( sizeof( bloom_block ) == 32 );
+
+	namespace bloom_impl {
+		inline constexpr std::uint32_t salts[8] = {
+		  0x47b6'137bU, 0x4497'4d91U, 0x8824'ad5bU, 0xa2b7'289dU,
+		  0x7054'95c7U, 0x2df1'424bU, 0x9efc'4947U, 0x5c6b'fb31U };
+
+		/// Number of keys between the hashing and the lookup when processing a
+		/// batch.  Gives the prefetches time to land
+		inline constexpr std::size_t batch_size = 16;
+
+		[[nodiscard]] DAW_ATTRIB_INLINE constexpr std::uint32_t
+		mask_bit( std::uint32_t key, std::size_t n ) noexcept {
+			return std::uint32_t{ 1 } << ( ( key * salts[n] ) >> 27U );
+		}
+
+		[[nodiscard]] constexpr std::size_t
+		block_index( std::uint64_t hash, std::size_t block_count ) noexcept {
+			return filter_impl::fast_range32( hash, block_count );
+		}
+
+		[[nodiscard]] constexpr std::uint32_t block_key( std::uint64_t hash ) {
+			return static_cast<std::uint32_t>( hash );
+		}
+
+#if defined( DAW_HAS_AVX2 )
+		DAW_ATTRIB_INLINE __m256i make_mask( std::uint32_t key ) noexcept {
+			auto const salt_v = _mm256_setr_epi32(
+			  static_cast<int>( salts[0] ), static_cast<int>( salts[1] ),
+			  static_cast<int>( salts[2] ), static_cast<int>( salts[3] ),
+			  static_cast<int>( salts[4] ), static_cast<int>( salts[5] ),
+			  static_cast<int>( salts[6] ), static_cast<int>( salts[7] ) );
+			auto k = _mm256_mullo_epi32( _mm256_set1_epi32( static_cast<int>( key ) ),
+			                             salt_v );
+			k = _mm256_srli_epi32( k, 27 );
+			return _mm256_sllv_epi32( _mm256_set1_epi32( 1 ), k );
+		}
+#endif
+
+		[[nodiscard]] DAW_ATTRIB_INLINE bool
+		block_contains( bloom_block const &block, std::uint32_t key ) noexcept {
+#if defined( DAW_HAS_AVX2 )
+			auto const b =
+			  _mm256_loadu_si256( reinterpret_cast<__m256i const *>( block.words ) );
+			return _mm256_testc_si256( b, make_mask( key ) ) != 0;
+#else
+			bool result = true;
+			for( std::size_t n = 0; n < 8; ++n ) {
+				result &= ( block.words[n] & mask_bit( key, n ) ) != 0;
+			}
+			return result;
+#endif
+		}
+
+		DAW_ATTRIB_INLINE void block_insert( bloom_block &block,
+		                                     std::uint32_t key ) noexcept {
+#if defined( DAW_HAS_AVX2 )
+			auto *ptr = reinterpret_cast<__m256i *>( block.words );
+			_mm256_storeu_si256(
+			  ptr, _mm256_or_si256( _mm256_loadu_si256( ptr ), make_mask( key ) ) );
+#else
+			for( std::size_t n = 0; n < 8; ++n ) {
+				block.words[n] |= mask_bit( key, n );
+			}
+#endif
+		}
+
+		DAW_ATTRIB_INLINE void atomic_or( std::uint32_t &word,
+		                                  std::uint32_t bits ) noexcept {
+#if defined( __cpp_lib_atomic_ref )
+			std::atomic_ref<std::uint32_t>( word ).fetch_or(
+			  bits, std::memory_order_relaxed );
+#elif defined( DAW_HAS_GCC_LIKE )
+			__atomic_fetch_or( &word, bits, __ATOMIC_RELAXED );
+#elif defined( DAW_HAS_MSVC )
+			_InterlockedOr( reinterpret_cast<long volatile *>( &word ),
+			                static_cast<long>( bits ) );
+#else
+#error Unsupported compiler for atomic bloom filter inserts
+#endif
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE std::uint32_t
+		atomic_load( std::uint32_t &word ) noexcept {
+#if defined( __cpp_lib_atomic_ref )
+			return std::atomic_ref<std::uint32_t>( word ).load(
+			  std::memory_order_relaxed );
+#elif defined( DAW_HAS_GCC_LIKE )
+			return __atomic_load_n( &word, __ATOMIC_RELAXED );
+#elif defined( DAW_HAS_MSVC )
+			// Aligned 32bit volatile loads are atomic on MSVC targets
+			return *static_cast<std::uint32_t volatile *>( &word );
+#else
+#error Unsupported compiler for atomic bloom filter inserts
+#endif
+		}
+
+		DAW_ATTRIB_INLINE void block_insert_atomic( bloom_block &block,
+		                                            std::uint32_t key ) noexcept {
+			for( std::size_t n = 0; n < 8; ++n ) {
+				auto const bit = mask_bit( key, n );
+				// Most bits are already set once the filter fills, skip the RMW then
+				if( ( atomic_load( block.words[n] ) & bit ) == 0 ) {
+					atomic_or( block.words[n], bit );
+				}
+			}
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE bool
+		table_contains( bloom_block const *blocks, std::size_t block_count,
+		                std::uint64_t hash ) noexcept {
+			return block_contains( blocks[block_index( hash, block_count )],
+			                       block_key( hash ) );
+		}
+
+		template<typename Hash, typename Iterator, typename Last,
+		         typename OutputIterator>
+		OutputIterator table_contains_batch( bloom_block const *blocks,
+		                                     std::size_t block_count,
+		                                     Hash const &hasher, Iterator first,
+		                                     Last last, OutputIterator out ) {
+			std::uint64_t hashes[batch_size];
+			while( first != last ) {
+				std::size_t count = 0;
+				while( count < batch_size and first != last ) {
+					auto const h = hasher( *first );
+					hashes[count++] = h;
+					daw::prefetch( blocks + block_index( h, block_count ) );
+					++first;
+				}
+				for( std::size_t n = 0; n < count; ++n ) {
+					*out = table_contains( blocks, block_count, hashes[n] );
+					++out;
+				}
+			}
+			return out;
+		}
+
+		/// @brief Expected false positive rate when keys_per_block keys land in
+		/// each block on average.  The number of keys in a block is Poisson
+		/// distributed, and the fuller blocks dominate the result
+		[[nodiscard]] inline double
+		false_positive_rate( double keys_per_block ) noexcept {
+			auto const k_max = static_cast<std::size_t>(
+			  keys_per_block + 10.0 * std::sqrt( keys_per_block ) + 20.0 );
+			double result = 0.0;
+			double p_k = std::exp( -keys_per_block );
+			for( std::size_t k = 0; k <= k_max; ++k ) {
+				// Probability that a given bit of a word is set after k keys
+				auto const bit_set =
+				  1.0 - std::pow( 31.0 / 32.0, static_cast<double>( k ) );
+				result += p_k * std::pow( bit_set, 8.0 );
+				p_k *= keys_per_block / static_cast<double>( k + 1U );
+			}
+			return result;
+		}
+
+		/// @brief Number of 256bit blocks needed to hold expected_items with the
+		/// requested false positive rate
+		[[nodiscard]] inline std::size_t
+		blocks_needed( std::size_t expected_items, double false_positive_rate ) {
+			daw_ensure( false_positive_rate > 0.0 and false_positive_rate < 1.0 );
+			if( expected_items == 0 ) {
+				return 1U;
+			}
+			auto const items = static_cast<double>( expected_items );
+			// Start from the closed form estimate for split block bloom filters,
+			// it ignores the variance in block load and is low
+			auto blocks = std::ceil(
+			  -8.0 * items /
+			  std::log( 1.0 - std::pow( false_positive_rate, 1.0 / 8.0 ) ) / 256.0 );
+			while( bloom_impl::false_positive_rate( items / blocks ) >
+			       false_positive_rate ) {
+				blocks = std::ceil( blocks * 1.02 );
+			}
+			return static_cast<std::size_t>( blocks );
+		}
+	} // namespace bloom_impl
+
+	/// @brief A read only blocked bloom filter over a table it does not own,
+	/// such as one mapped from a file with memory_mapped_file_t
+	template<typename Hash = filter_hash>
+	class blocked_bloom_filter_view {
+		bloom_block const *m_blocks = nullptr;
+		std::size_t m_block_count = 0;
+		Hash m_hash{ };
+
+	public:
+		blocked_bloom_filter_view( ) = default;
+
+		blocked_bloom_filter_view( bloom_block const *blocks,
+		                           std::size_t block_count, Hash hasher = Hash{ } )
+		  : m_blocks( blocks )
+		  , m_block_count( block_count )
+		  , m_hash( std::move( hasher ) ) {}
+
+		/// @brief Create a view over a buffer written by
+		/// blocked_bloom_filter::serialize_to
+		/// @return nullopt if the buffer does not hold a valid filter or is not
+		/// aligned to alignof( bloom_block )
+		[[nodiscard]] static std::optional<blocked_bloom_filter_view>
+		from_buffer( char const *buffer, std::size_t buffer_size,
+		             Hash hasher = Hash{ } ) {
+			auto header = filter_impl::filter_header{ };
+			if( not filter_impl::read_header(
+			      buffer, buffer_size, filter_impl::filter_kind::blocked_bloom,
+			      sizeof( bloom_block ), header ) ) {
+				return std::nullopt;
+			}
+			auto const *table = buffer + sizeof( filter_impl::filter_header );
+			if( reinterpret_cast<std::uintptr_t>( table ) % alignof( bloom_block ) !=
+			    0 ) {
+				return std::nullopt;
+			}
+			return blocked_bloom_filter_view(
+			  reinterpret_cast<bloom_block const *>( table ),
+			  static_cast<std::size_t>( header.table_size ), std::move( hasher ) );
+		}
+
+		[[nodiscard]] std::size_t block_count( ) const noexcept {
+			return m_block_count;
+		}
+
+		[[nodiscard]] bloom_block const *data( ) const noexcept {
+			return m_blocks;
+		}
+
+		[[nodiscard]] Hash const &hash_function( ) const noexcept {
+			return m_hash;
+		}
+
+		[[nodiscard]] bool contains_hash( std::uint64_t hash ) const noexcept {
+			return bloom_impl::table_contains( m_blocks, m_block_count, hash );
+		}
+
+		/// @return false if key was never inserted, true if it probably was
+		template<typename Key>
+		[[nodiscard]] bool contains( Key const &key ) const {
+			return contains_hash( m_hash( key ) );
+		}
+
+		/// @brief Query each key in [first, last), writing a bool per key to out.
+		/// The hashes for a batch are computed and their blocks prefetched before
+		/// any are tested
+		template<typename Iterator, typename Last, typename OutputIterator>
+		OutputIterator contains_batch( Iterator first, Last last,
+		                               OutputIterator out ) const {
+			return bloom_impl::table_contains_batch( m_blocks, m_block_count, m_hash,
+			                                         first, last, out );
+		}
+	};
+
+	/// @brief A cache line blocked(split block) bloom filter.  Keys are hashed
+	/// once, the high half selects a 256bit block and the low half is multiplied
+	/// by 8 salts to select one bit in each word of the block.
+	template<typename Hash = filter_hash>
+	class blocked_bloom_filter {
+		// Never empty so that hashing always lands on a block
+		std::vector<bloom_block> m_blocks = std::vector<bloom_block>( 1U );
+		Hash m_hash{ };
+
+	public:
+		using view_type = blocked_bloom_filter_view<Hash>;
+
+		/// A filter with a single block
+		blocked_bloom_filter( ) = default;
+
+		/// @param expected_items Number of distinct keys expected to be inserted
+		/// @param false_positive_rate Target probability that contains reports a
+		/// key that was not inserted
+		explicit blocked_bloom_filter( std::size_t expected_items,
+		                               double false_positive_rate = 0.01,
+		                               Hash hasher = Hash{ } )
+		  : m_blocks(
+		      bloom_impl::blocks_needed( expected_items, false_positive_rate ),
+		      bloom_block{ } )
+		  , m_hash( std::move( hasher ) ) {
+			daw_ensure( m_blocks.size( ) <= 0xFFFF'FFFFULL );
+		}
+
+		[[nodiscard]] static blocked_bloom_filter
+		with_block_count( std::size_t block_count, Hash hasher = Hash{ } ) {
+			daw_ensure( block_count > 0 and block_count <= 0xFFFF'FFFFULL );
+			auto result = blocked_bloom_filter( );
+			result.m_blocks.resize( block_count, bloom_block{ } );
+			result.m_hash = std::move( hasher );
+			return result;
+		}
+
+		/// @brief Copy a filter out of a buffer written by serialize_to
+		[[nodiscard]] static std::optional<blocked_bloom_filter>
+		from_buffer( char const *buffer, std::size_t buffer_size,
+		             Hash hasher = Hash{ } ) {
+			auto header = filter_impl::filter_header{ };
+			if( not filter_impl::read_header(
+			      buffer, buffer_size, filter_impl::filter_kind::blocked_bloom,
+			      sizeof( bloom_block ), header ) ) {
+				return std::nullopt;
+			}
+			auto result = with_block_count(
+			  static_cast<std::size_t>( header.table_size ), std::move( hasher ) );
+			std::memcpy( result.m_blocks.data( ),
+			             buffer + sizeof( filter_impl::filter_header ),
+			             result.m_blocks.size( ) * sizeof( bloom_block ) );
+			return result;
+		}
+
+		[[nodiscard]] std::size_t block_count( ) const noexcept {
+			return m_blocks.size( );
+		}
+
+		[[nodiscard]] std::size_t size_in_bytes( ) const noexcept {
+			return m_blocks.size( ) * sizeof( bloom_block );
+		}
+
+		[[nodiscard]] Hash const &hash_function( ) const noexcept {
+			return m_hash;
+		}
+
+		[[nodiscard]] view_type view( ) const noexcept {
+			return view_type( m_blocks.data( ), m_blocks.size( ), m_hash );
+		}
+
+		void clear( ) noexcept {
+			for( auto &b : m_blocks ) {
+				b = bloom_block{ };
+			}
+		}
+
+		void insert_hash( std::uint64_t hash ) noexcept {
+			bloom_impl::block_insert(
+			  m_blocks[bloom_impl::block_index( hash, m_blocks.size( ) )],
+			  bloom_impl::block_key( hash ) );
+		}
+
+		template<typename Key>
+		void insert( Key const &key ) {
+			insert_hash( m_hash( key ) );
+		}
+
+		/// @brief Insert that may be called from multiple threads at once.  Each
+		/// word is updated with an atomic or, so no insert is lost.  Lookups must
+		/// not run concurrently with inserts
+		void insert_hash_concurrent( std::uint64_t hash ) noexcept {
+			bloom_impl::block_insert_atomic(
+			  m_blocks[bloom_impl::block_index( hash, m_blocks.size( ) )],
+			  bloom_impl::block_key( hash ) );
+		}
+
+		template<typename Key>
+		void insert_concurrent( Key const &key ) {
+			insert_hash_concurrent( m_hash( key ) );
+		}
+
+		template<typename Iterator, typename Last>
+		void insert_batch( Iterator first, Last last ) {
+			std::uint64_t hashes[bloom_impl::batch_size];
+			while( first != last ) {
+				std::size_t count = 0;
+				while( count < bloom_impl::batch_size and first != last ) {
+					auto const h = m_hash( *first );
+					hashes[count++] = h;
+					daw::prefetch_write( m_blocks.data( ) + bloom_impl::block_index(
+					                                          h, m_blocks.size( ) ) );
+					++first;
+				}
+				for( std::size_t n = 0; n < count; ++n ) {
+					insert_hash( hashes[n] );
+				}
+			}
+		}
+
+		[[nodiscard]] bool contains_hash( std::uint64_t hash ) const noexcept {
+			return bloom_impl::table_contains( m_blocks.data( ), m_blocks.size( ),
+			                                   hash );
+		}
+
+		/// @return false if key was never inserted, true if it probably was
+		template<typename Key>
+		[[nodiscard]] bool contains( Key const &key ) const {
+			return contains_hash( m_hash( key ) );
+		}
+
+		/// @brief Query each key in [first, last), writing a bool per key to out
+		template<typename Iterator, typename Last, typename OutputIterator>
+		OutputIterator contains_batch( Iterator first, Last last,
+		                               OutputIterator out ) const {
+			return bloom_impl::table_contains_batch(
+			  m_blocks.data( ), m_blocks.size( ), m_hash, first, last, out );
+		}
+
+		/// @brief Merge the keys of another filter with the same block count
+		blocked_bloom_filter &operator|=( blocked_bloom_filter const &rhs ) {
+			daw_ensure( m_blocks.size( ) == rhs.m_blocks.size( ) );
+			for( std::size_t n = 0; n < m_blocks.size( ); ++n ) {
+				for( std::size_t w = 0; w < 8; ++w ) {
+					m_blocks[n].words[w] |= rhs.m_blocks[n].words[w];
+				}
+			}
+			return *this;
+		}
+
+		/// @brief Bytes needed by serialize_to
+		[[nodiscard]] std::size_t serialized_size( ) const noexcept {
+			return sizeof( filter_impl::filter_header ) + size_in_bytes( );
+		}
+
+		/// @brief Write the filter to out in a format that can be used in place by
+		/// blocked_bloom_filter_view::from_buffer
+		/// @pre out has room for serialized_size( ) bytes
+		/// @return one past the last byte written
+		char *serialize_to( char *out ) const noexcept {
+			auto header = filter_impl::filter_header{ };
+			header.kind = filter_impl::filter_kind::blocked_bloom;
+			header.table_size = m_blocks.size( );
+			std::memcpy( out, &header, sizeof( header ) );
+			out += sizeof( header );
+			std::memcpy( out, m_blocks.data( ), size_in_bytes( ) );
+			return out + size_in_bytes( );
+		}
+	};
+} // namespace daw
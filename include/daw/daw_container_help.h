@@ -12,3 +12,49 @@
 #include "impl/daw_container_help_ins_ext.h"
 #include "impl/daw_container_help_string.h"
 #include "impl/daw_container_help_vector.h"
+
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace daw {
+	/// Take the allocation of a std::vector or std::basic_string without
+	/// copying the elements.  The container is left empty.
+	template<typename Container,
+	         std::enable_if_t<not std::is_lvalue_reference_v<Container>,
+	                          std::nullptr_t> = nullptr>
+	[[nodiscard]] auto release_buffer( Container &&c ) {
+		return extract_from_container( c );
+	}
+
+	/// A std::vector that owns the buffer, no elements are copied
+	template<typename T, typename Allocator>
+	[[nodiscard]] std::vector<T, Allocator>
+	to_std_vector( container_data<T, Allocator> &&buff ) {
+		auto result = std::vector<T, Allocator>( buff.get_allocator( ) );
+		auto const sz = buff.size( );
+		auto const cap = buff.capacity( );
+		auto alloc = buff.get_allocator( );
+		insert_into_container( result, buff.release( ), std::move( alloc ), cap,
+		                       sz );
+		return result;
+	}
+
+	/// A std::basic_string that owns the buffer when its layout allows it,
+	/// otherwise the characters are copied
+	template<typename CharT, typename Traits = std::char_traits<CharT>,
+	         typename Allocator>
+	[[nodiscard]] std::basic_string<CharT, Traits, Allocator>
+	to_std_string( container_data<CharT, Allocator> &&buff ) {
+		auto result = std::basic_string<CharT, Traits, Allocator>(
+		  buff.get_allocator( ) );
+		auto const sz = buff.size( );
+		auto const cap = buff.capacity( );
+		auto alloc = buff.get_allocator( );
+		insert_into_container( result, buff.release( ), std::move( alloc ), cap,
+		                       sz );
+		return result;
+	}
+} // namespace daw
@@ -193,6 +193,22 @@ inline constexpr bool daw_has_cx_cmath = false;
 #endif
 #endif
 
+#if defined( __cpp_nontype_template_args )
+#if __cpp_nontype_template_args >= 201911L
+#define DAW_HAS_CPP20_CLASS_NTTP 1
+#endif
+#endif
+#if not defined( DAW_HAS_CPP20_CLASS_NTTP ) and \
+  defined( __cpp_nontype_template_parameter_class )
+#define DAW_HAS_CPP20_CLASS_NTTP 1
+#endif
+
+#if defined( __cpp_impl_coroutine ) and defined( __has_include )
+#if __cpp_impl_coroutine >= 201902L and __has_include( <coroutine> )
+#define DAW_HAS_CPP20_COROUTINES 1
+#endif
+#endif
+
 #if defined( _MSC_VER )
 #if _MSC_VER < 1930 and not defined( DAW_NO_CONCEPTS )
 #define DAW_NO_CONCEPTS
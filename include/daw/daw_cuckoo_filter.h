@@ -0,0 +1,443 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/ciso646.h"
+#include "daw/daw_attributes.h"
+#include "daw/daw_ensure.h"
+#include "daw/daw_prefetch.h"
+#include "daw/impl/daw_filter_common.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace daw {
+	namespace cuckoo_impl {
+		/// A bucket holds 4 16bit fingerprints packed in a word, 0 marks an empty
+		/// slot.  Matching is done on the whole bucket at once(SWAR)
+		using bucket_t = std::uint64_t;
+		using fingerprint_t = std::uint16_t;
+		inline constexpr std::size_t slots_per_bucket = 4;
+		inline constexpr bucket_t lane_lsb = 0x0001'0001'0001'0001ULL;
+		inline constexpr bucket_t lane_msb = 0x8000'8000'8000'8000ULL;
+		inline constexpr std::size_t max_kicks = 500;
+		inline constexpr std::size_t batch_size = 16;
+
+		[[nodiscard]] DAW_ATTRIB_INLINE constexpr bool
+		has_zero_lane( bucket_t b ) noexcept {
+			return ( ( b - lane_lsb ) & ~b & lane_msb ) != 0;
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE constexpr bool
+		bucket_has( bucket_t b, fingerprint_t fp ) noexcept {
+			return has_zero_lane( b ^ ( lane_lsb * fp ) );
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE constexpr fingerprint_t
+		get_slot( bucket_t b, std::size_t slot ) noexcept {
+			return static_cast<fingerprint_t>( b >> ( slot * 16U ) );
+		}
+
+		DAW_ATTRIB_INLINE constexpr void
+		set_slot( bucket_t &b, std::size_t slot, fingerprint_t fp ) noexcept {
+			auto const shift = slot * 16U;
+			b = ( b & ~( bucket_t{ 0xFFFF } << shift ) ) |
+			    ( static_cast<bucket_t>( fp ) << shift );
+		}
+
+		/// The fingerprint comes from the low bits, index uses the high bits
+		[[nodiscard]] constexpr fingerprint_t
+		fingerprint( std::uint64_t hash ) noexcept {
+			auto const fp = static_cast<fingerprint_t>( hash );
+			return fp == 0 ? fingerprint_t{ 1 } : fp;
+		}
+
+		[[nodiscard]] constexpr std::size_t
+		index( std::uint64_t hash, std::size_t bucket_count ) noexcept {
+			return filter_impl::fast_range32( hash, bucket_count );
+		}
+
+		/// @brief The other candidate bucket, ( h( fp ) - idx ) mod bucket_count.
+		/// This is an involution for any bucket count so the table does not need
+		/// to be a power of two
+		[[nodiscard]] constexpr std::size_t
+		alt_index( std::size_t idx, fingerprint_t fp,
+		           std::size_t bucket_count ) noexcept {
+			auto const h = filter_impl::fast_range32(
+			  filter_impl::mix64( static_cast<std::uint64_t>( fp ) ), bucket_count );
+			return h >= idx ? h - idx : h + bucket_count - idx;
+		}
+
+		struct victim_t {
+			std::size_t index = 0;
+			fingerprint_t fp = 0;
+			bool used = false;
+		};
+
+		/// The victim of a serialized filter must name one of its buckets
+		[[nodiscard]] constexpr bool
+		valid_victim( filter_impl::filter_header const &header ) noexcept {
+			return header.victim_used == 0 or
+			       header.victim_index < header.table_size;
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE bool
+		table_contains( bucket_t const *buckets, std::size_t bucket_count,
+		                victim_t const &victim, std::uint64_t hash ) noexcept {
+			auto const fp = fingerprint( hash );
+			auto const i1 = index( hash, bucket_count );
+			auto const i2 = alt_index( i1, fp, bucket_count );
+			return bucket_has( buckets[i1], fp ) or bucket_has( buckets[i2], fp ) or
+			       ( victim.used and victim.fp == fp and
+			         ( victim.index == i1 or victim.index == i2 ) );
+		}
+
+		template<typename Hash, typename Iterator, typename Last,
+		         typename OutputIterator>
+		OutputIterator
+		table_contains_batch( bucket_t const *buckets, std::size_t bucket_count,
+		                      victim_t const &victim, Hash const &hasher,
+		                      Iterator first, Last last, OutputIterator out ) {
+			std::uint64_t hashes[batch_size];
+			while( first != last ) {
+				std::size_t count = 0;
+				while( count < batch_size and first != last ) {
+					auto const h = hasher( *first );
+					hashes[count++] = h;
+					auto const i1 = index( h, bucket_count );
+					daw::prefetch( buckets + i1 );
+					daw::prefetch(
+					  buckets + alt_index( i1, fingerprint( h ), bucket_count ) );
+					++first;
+				}
+				for( std::size_t n = 0; n < count; ++n ) {
+					*out = table_contains( buckets, bucket_count, victim, hashes[n] );
+					++out;
+				}
+			}
+			return out;
+		}
+
+		[[nodiscard]] constexpr std::size_t
+		buckets_needed( std::size_t capacity ) noexcept {
+			// Aim for a ~95% maximum load factor
+			return ( capacity * 100U ) / 95U / slots_per_bucket + 1U;
+		}
+	} // namespace cuckoo_impl
+
+	/// @brief A read only cuckoo filter over a table it does not own, such as
+	/// one mapped from a file with memory_mapped_file_t
+	template<typename Hash = filter_hash>
+	class cuckoo_filter_view {
+		cuckoo_impl::bucket_t const *m_buckets = nullptr;
+		std::size_t m_bucket_count = 0;
+		cuckoo_impl::victim_t m_victim{ };
+		Hash m_hash{ };
+
+	public:
+		cuckoo_filter_view( ) = default;
+
+		cuckoo_filter_view( cuckoo_impl::bucket_t const *buckets,
+		                    std::size_t bucket_count,
+		                    cuckoo_impl::victim_t const &victim,
+		                    Hash hasher = Hash{ } )
+		  : m_buckets( buckets )
+		  , m_bucket_count( bucket_count )
+		  , m_victim( victim )
+		  , m_hash( std::move( hasher ) ) {}
+
+		/// @brief Create a view over a buffer written by
+		/// cuckoo_filter::serialize_to
+		/// @return nullopt if the buffer does not hold a valid filter or is not
+		/// aligned for the buckets
+		[[nodiscard]] static std::optional<cuckoo_filter_view>
+		from_buffer( char const *buffer, std::size_t buffer_size,
+		             Hash hasher = Hash{ } ) {
+			auto header = filter_impl::filter_header{ };
+			if( not filter_impl::read_header(
+			      buffer, buffer_size, filter_impl::filter_kind::cuckoo,
+			      sizeof( cuckoo_impl::bucket_t ), header ) or
+			    not cuckoo_impl::valid_victim( header ) ) {
+				return std::nullopt;
+			}
+			auto const *table = buffer + sizeof( filter_impl::filter_header );
+			if( reinterpret_cast<std::uintptr_t>( table ) %
+			      alignof( cuckoo_impl::bucket_t ) !=
+			    0 ) {
+				return std::nullopt;
+			}
+			auto const victim = cuckoo_impl::victim_t{
+			  static_cast<std::size_t>( header.victim_index ),
+			  static_cast<cuckoo_impl::fingerprint_t>( header.victim_fingerprint ),
+			  header.victim_used != 0 };
+			return cuckoo_filter_view(
+			  reinterpret_cast<cuckoo_impl::bucket_t const *>( table ),
+			  static_cast<std::size_t>( header.table_size ), victim,
+			  std::move( hasher ) );
+		}
+
+		[[nodiscard]] std::size_t bucket_count( ) const noexcept {
+			return m_bucket_count;
+		}
+
+		[[nodiscard]] bool contains_hash( std::uint64_t hash ) const noexcept {
+			return cuckoo_impl::table_contains( m_buckets, m_bucket_count, m_victim,
+			                                    hash );
+		}
+
+		/// @return false if key is not in the filter, true if it probably is
+		template<typename Key>
+		[[nodiscard]] bool contains( Key const &key ) const {
+			return contains_hash( m_hash( key ) );
+		}
+
+		/// @brief Query each key in [first, last), writing a bool per key to out
+		template<typename Iterator, typename Last, typename OutputIterator>
+		OutputIterator contains_batch( Iterator first, Last last,
+		                               OutputIterator out ) const {
+			return cuckoo_impl::table_contains_batch(
+			  m_buckets, m_bucket_count, m_victim, m_hash, first, last, out );
+		}
+	};
+
+	/// @brief A cuckoo filter with 16bit fingerprints in buckets of 4.  Unlike
+	/// a bloom filter it supports erase, and has a lower false positive rate
+	/// (~0.012%) at high loads.  An insert can fail once the table is close to
+	/// full.
+	template<typename Hash = filter_hash>
+	class cuckoo_filter {
+		// Never empty so that hashing always lands on a bucket
+		std::vector<cuckoo_impl::bucket_t> m_buckets =
+		  std::vector<cuckoo_impl::bucket_t>( 1U, 0 );
+		std::size_t m_size = 0;
+		cuckoo_impl::victim_t m_victim{ };
+		std::uint64_t m_rng = 0x2545'f491'4f6c'dd1dULL;
+		Hash m_hash{ };
+
+		std::size_t next_random( ) noexcept {
+			m_rng ^= m_rng << 13U;
+			m_rng ^= m_rng >> 7U;
+			m_rng ^= m_rng << 17U;
+			return static_cast<std::size_t>( m_rng );
+		}
+
+		bool try_place( std::size_t idx, cuckoo_impl::fingerprint_t fp ) noexcept {
+			auto &b = m_buckets[idx];
+			if( not cuckoo_impl::has_zero_lane( b ) ) {
+				return false;
+			}
+			for( std::size_t slot = 0; slot < cuckoo_impl::slots_per_bucket;
+			     ++slot ) {
+				if( cuckoo_impl::get_slot( b, slot ) == 0 ) {
+					cuckoo_impl::set_slot( b, slot, fp );
+					return true;
+				}
+			}
+			return false;
+		}
+
+		bool try_remove( std::size_t idx, cuckoo_impl::fingerprint_t fp ) noexcept {
+			auto &b = m_buckets[idx];
+			for( std::size_t slot = 0; slot < cuckoo_impl::slots_per_bucket;
+			     ++slot ) {
+				if( cuckoo_impl::get_slot( b, slot ) == fp ) {
+					cuckoo_impl::set_slot( b, slot, 0 );
+					return true;
+				}
+			}
+			return false;
+		}
+
+	public:
+		using view_type = cuckoo_filter_view<Hash>;
+
+		/// A filter with a single bucket
+		cuckoo_filter( ) = default;
+
+		/// @param capacity Number of keys the filter should be able to hold
+		explicit cuckoo_filter( std::size_t capacity, Hash hasher = Hash{ } )
+		  : m_buckets( cuckoo_impl::buckets_needed( capacity ), 0 )
+		  , m_hash( std::move( hasher ) ) {
+			daw_ensure( m_buckets.size( ) <= 0xFFFF'FFFFULL );
+		}
+
+		/// @brief Copy a filter out of a buffer written by serialize_to
+		[[nodiscard]] static std::optional<cuckoo_filter>
+		from_buffer( char const *buffer, std::size_t buffer_size,
+		             Hash hasher = Hash{ } ) {
+			auto header = filter_impl::filter_header{ };
+			if( not filter_impl::read_header(
+			      buffer, buffer_size, filter_impl::filter_kind::cuckoo,
+			      sizeof( cuckoo_impl::bucket_t ), header ) or
+			    not cuckoo_impl::valid_victim( header ) ) {
+				return std::nullopt;
+			}
+			auto result = cuckoo_filter( );
+			result.m_buckets.resize( static_cast<std::size_t>( header.table_size ) );
+			result.m_size = static_cast<std::size_t>( header.item_count );
+			result.m_victim = cuckoo_impl::victim_t{
+			  static_cast<std::size_t>( header.victim_index ),
+			  static_cast<cuckoo_impl::fingerprint_t>( header.victim_fingerprint ),
+			  header.victim_used != 0 };
+			result.m_hash = std::move( hasher );
+			std::memcpy( result.m_buckets.data( ),
+			             buffer + sizeof( filter_impl::filter_header ),
+			             result.m_buckets.size( ) * sizeof( cuckoo_impl::bucket_t ) );
+			return result;
+		}
+
+		[[nodiscard]] std::size_t size( ) const noexcept {
+			return m_size;
+		}
+
+		[[nodiscard]] bool empty( ) const noexcept {
+			return m_size == 0;
+		}
+
+		[[nodiscard]] std::size_t bucket_count( ) const noexcept {
+			return m_buckets.size( );
+		}
+
+		[[nodiscard]] std::size_t capacity( ) const noexcept {
+			return m_buckets.size( ) * cuckoo_impl::slots_per_bucket;
+		}
+
+		[[nodiscard]] double load_factor( ) const noexcept {
+			return static_cast<double>( m_size ) / static_cast<double>( capacity( ) );
+		}
+
+		[[nodiscard]] view_type view( ) const noexcept {
+			return view_type( m_buckets.data( ), m_buckets.size( ), m_victim,
+			                  m_hash );
+		}
+
+		/// @return false if the filter is too full to take the key.  The filter
+		/// is unchanged in that case
+		[[nodiscard]] bool insert_hash( std::uint64_t hash ) noexcept {
+			if( m_victim.used ) {
+				return false;
+			}
+			auto fp = cuckoo_impl::fingerprint( hash );
+			auto idx = cuckoo_impl::index( hash, m_buckets.size( ) );
+			if( try_place( idx, fp ) or
+			    try_place(
+			      idx = cuckoo_impl::alt_index( idx, fp, m_buckets.size( ) ), fp ) ) {
+				++m_size;
+				return true;
+			}
+			for( std::size_t kick = 0; kick < cuckoo_impl::max_kicks; ++kick ) {
+				auto const slot = next_random( ) % cuckoo_impl::slots_per_bucket;
+				auto &b = m_buckets[idx];
+				auto const evicted = cuckoo_impl::get_slot( b, slot );
+				cuckoo_impl::set_slot( b, slot, fp );
+				fp = evicted;
+				idx = cuckoo_impl::alt_index( idx, fp, m_buckets.size( ) );
+				if( try_place( idx, fp ) ) {
+					++m_size;
+					return true;
+				}
+			}
+			// Keep the last evicted fingerprint so that nothing is lost, the next
+			// insert will fail
+			m_victim = cuckoo_impl::victim_t{ idx, fp, true };
+			++m_size;
+			return true;
+		}
+
+		template<typename Key>
+		[[nodiscard]] bool insert( Key const &key ) {
+			return insert_hash( m_hash( key ) );
+		}
+
+		/// @brief Remove one copy of a key that was previously inserted.  Erasing
+		/// a key that was never inserted can remove another key's fingerprint
+		bool erase_hash( std::uint64_t hash ) noexcept {
+			auto const fp = cuckoo_impl::fingerprint( hash );
+			auto const i1 = cuckoo_impl::index( hash, m_buckets.size( ) );
+			auto const i2 = cuckoo_impl::alt_index( i1, fp, m_buckets.size( ) );
+			if( try_remove( i1, fp ) or try_remove( i2, fp ) ) {
+				--m_size;
+				if( m_victim.used ) {
+					// A slot was freed, try to move the victim back into the table
+					auto const idx = m_victim.index;
+					auto const vfp = m_victim.fp;
+					if( try_place( idx, vfp ) or
+					    try_place( cuckoo_impl::alt_index( idx, vfp, m_buckets.size( ) ),
+					               vfp ) ) {
+						m_victim.used = false;
+					}
+				}
+				return true;
+			}
+			if( m_victim.used and m_victim.fp == fp and
+			    ( m_victim.index == i1 or m_victim.index == i2 ) ) {
+				m_victim.used = false;
+				--m_size;
+				return true;
+			}
+			return false;
+		}
+
+		template<typename Key>
+		bool erase( Key const &key ) {
+			return erase_hash( m_hash( key ) );
+		}
+
+		[[nodiscard]] bool contains_hash( std::uint64_t hash ) const noexcept {
+			return cuckoo_impl::table_contains( m_buckets.data( ), m_buckets.size( ), m_victim,
+			                                    hash );
+		}
+
+		/// @return false if key is not in the filter, true if it probably is
+		template<typename Key>
+		[[nodiscard]] bool contains( Key const &key ) const {
+			return contains_hash( m_hash( key ) );
+		}
+
+		/// @brief Query each key in [first, last), writing a bool per key to out.
+		/// The hashes for a batch are computed and both candidate buckets
+		/// prefetched before any are tested
+		template<typename Iterator, typename Last, typename OutputIterator>
+		OutputIterator contains_batch( Iterator first, Last last,
+		                               OutputIterator out ) const {
+			return cuckoo_impl::table_contains_batch(
+			  m_buckets.data( ), m_buckets.size( ), m_victim, m_hash, first, last, out );
+		}
+
+		/// @brief Bytes needed by serialize_to
+		[[nodiscard]] std::size_t serialized_size( ) const noexcept {
+			return sizeof( filter_impl::filter_header ) +
+			       m_buckets.size( ) * sizeof( cuckoo_impl::bucket_t );
+		}
+
+		/// @brief Write the filter to out in a format that can be used in place by
+		/// cuckoo_filter_view::from_buffer
+		/// @pre out has room for serialized_size( ) bytes
+		/// @return one past the last byte written
+		char *serialize_to( char *out ) const noexcept {
+			auto header = filter_impl::filter_header{ };
+			header.kind = filter_impl::filter_kind::cuckoo;
+			header.table_size = m_buckets.size( );
+			header.item_count = m_size;
+			header.victim_index = m_victim.index;
+			header.victim_fingerprint = m_victim.fp;
+			header.victim_used = m_victim.used ? 1U : 0U;
+			std::memcpy( out, &header, sizeof( header ) );
+			out += sizeof( header );
+			auto const table_bytes =
+			  m_buckets.size( ) * sizeof( cuckoo_impl::bucket_t );
+			std::memcpy( out, m_buckets.data( ), table_bytes );
+			return out + table_bytes;
+		}
+	};
+} // namespace daw
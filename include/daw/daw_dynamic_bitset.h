@@ -0,0 +1,737 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/ciso646.h"
+#include "daw/daw_attributes.h"
+#include "daw/daw_cxmath.h"
+#include "daw/daw_ensure.h"
+#include "daw/impl/daw_simd_check.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace daw {
+	namespace dyn_bitset_impl {
+		using word_t = std::uint64_t;
+		inline constexpr std::size_t word_bits = 64U;
+
+		[[nodiscard]] constexpr std::size_t
+		words_needed( std::size_t bit_count ) noexcept {
+			return ( bit_count + ( word_bits - 1U ) ) / word_bits;
+		}
+
+		/// @brief Mask of the valid bits in the last word of a bitset with
+		/// bit_count bits
+		[[nodiscard]] constexpr word_t
+		tail_mask( std::size_t bit_count ) noexcept {
+			auto const rem = bit_count % word_bits;
+			if( rem == 0 ) {
+				return ~word_t{ 0 };
+			}
+			return ( word_t{ 1 } << rem ) - 1U;
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE constexpr std::size_t
+		popcount( word_t w ) noexcept {
+			return static_cast<std::size_t>( daw::cxmath::popcount( w ) );
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE constexpr std::size_t
+		ctz( word_t w ) noexcept {
+			return static_cast<std::size_t>(
+			  daw::cxmath::count_trailing_zeros( w ) );
+		}
+
+		/// @brief Position of the nth(0 based) set bit in w.  w must have more
+		/// than n bits set
+		[[nodiscard]] DAW_ATTRIB_INLINE std::size_t select_in_word( word_t w,
+		                                                            std::size_t n ) {
+#if defined( DAW_HAS_BMI2 )
+			return ctz( _pdep_u64( word_t{ 1 } << n, w ) );
+#else
+			while( n-- > 0 ) {
+				w &= w - 1U;
+			}
+			return ctz( w );
+#endif
+		}
+
+		struct op_and {
+			DAW_ATTRIB_INLINE constexpr word_t operator( )( word_t a,
+			                                                word_t b ) const {
+				return a & b;
+			}
+#if defined( DAW_HAS_AVX2 )
+			DAW_ATTRIB_INLINE __m256i operator( )( __m256i a, __m256i b ) const {
+				return _mm256_and_si256( a, b );
+			}
+#elif defined( DAW_HAS_SSE2 )
+			DAW_ATTRIB_INLINE __m128i operator( )( __m128i a, __m128i b ) const {
+				return _mm_and_si128( a, b );
+			}
+#endif
+		};
+
+		struct op_or {
+			DAW_ATTRIB_INLINE constexpr word_t operator( )( word_t a,
+			                                                word_t b ) const {
+				return a | b;
+			}
+#if defined( DAW_HAS_AVX2 )
+			DAW_ATTRIB_INLINE __m256i operator( )( __m256i a, __m256i b ) const {
+				return _mm256_or_si256( a, b );
+			}
+#elif defined( DAW_HAS_SSE2 )
+			DAW_ATTRIB_INLINE __m128i operator( )( __m128i a, __m128i b ) const {
+				return _mm_or_si128( a, b );
+			}
+#endif
+		};
+
+		struct op_xor {
+			DAW_ATTRIB_INLINE constexpr word_t operator( )( word_t a,
+			                                                word_t b ) const {
+				return a ^ b;
+			}
+#if defined( DAW_HAS_AVX2 )
+			DAW_ATTRIB_INLINE __m256i operator( )( __m256i a, __m256i b ) const {
+				return _mm256_xor_si256( a, b );
+			}
+#elif defined( DAW_HAS_SSE2 )
+			DAW_ATTRIB_INLINE __m128i operator( )( __m128i a, __m128i b ) const {
+				return _mm_xor_si128( a, b );
+			}
+#endif
+		};
+
+		/// a & ~b
+		struct op_and_not {
+			DAW_ATTRIB_INLINE constexpr word_t operator( )( word_t a,
+			                                                word_t b ) const {
+				return a & ~b;
+			}
+#if defined( DAW_HAS_AVX2 )
+			DAW_ATTRIB_INLINE __m256i operator( )( __m256i a, __m256i b ) const {
+				return _mm256_andnot_si256( b, a );
+			}
+#elif defined( DAW_HAS_SSE2 )
+			DAW_ATTRIB_INLINE __m128i operator( )( __m128i a, __m128i b ) const {
+				return _mm_andnot_si128( b, a );
+			}
+#endif
+		};
+
+		/// @brief lhs[i] = op( lhs[i], rhs[i] ) for i in [0, count)
+		template<typename Op>
+		DAW_ATTRIB_FLATTEN inline void
+		transform_words( word_t *lhs, word_t const *rhs, std::size_t count,
+		                 Op op ) noexcept {
+			std::size_t n = 0;
+#if defined( DAW_HAS_AVX2 )
+			for( ; n + 4U <= count; n += 4U ) {
+				auto const a =
+				  _mm256_loadu_si256( reinterpret_cast<__m256i const *>( lhs + n ) );
+				auto const b =
+				  _mm256_loadu_si256( reinterpret_cast<__m256i const *>( rhs + n ) );
+				_mm256_storeu_si256( reinterpret_cast<__m256i *>( lhs + n ),
+				                     op( a, b ) );
+			}
+#elif defined( DAW_HAS_SSE2 )
+			for( ; n + 2U <= count; n += 2U ) {
+				auto const a =
+				  _mm_loadu_si128( reinterpret_cast<__m128i const *>( lhs + n ) );
+				auto const b =
+				  _mm_loadu_si128( reinterpret_cast<__m128i const *>( rhs + n ) );
+				_mm_storeu_si128( reinterpret_cast<__m128i *>( lhs + n ), op( a, b ) );
+			}
+#endif
+			for( ; n < count; ++n ) {
+				lhs[n] = op( lhs[n], rhs[n] );
+			}
+		}
+
+#if defined( DAW_HAS_AVX2 )
+		/// Per 64bit lane popcount of v using the nibble lookup method
+		DAW_ATTRIB_INLINE __m256i popcount256( __m256i v ) noexcept {
+			auto const lookup =
+			  _mm256_setr_epi8( 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1,
+			                    1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 );
+			auto const low_mask = _mm256_set1_epi8( 0x0F );
+			auto const lo = _mm256_and_si256( v, low_mask );
+			auto const hi = _mm256_and_si256( _mm256_srli_epi32( v, 4 ), low_mask );
+			auto const cnt = _mm256_add_epi8( _mm256_shuffle_epi8( lookup, lo ),
+			                                  _mm256_shuffle_epi8( lookup, hi ) );
+			return _mm256_sad_epu8( cnt, _mm256_setzero_si256( ) );
+		}
+
+		/// Carry save adder
+		DAW_ATTRIB_INLINE void csa( __m256i &h, __m256i &l, __m256i a, __m256i b,
+		                            __m256i c ) noexcept {
+			auto const u = _mm256_xor_si256( a, b );
+			h = _mm256_or_si256( _mm256_and_si256( a, b ), _mm256_and_si256( u, c ) );
+			l = _mm256_xor_si256( u, c );
+		}
+
+		DAW_ATTRIB_INLINE __m256i load256( word_t const *p ) noexcept {
+			return _mm256_loadu_si256( reinterpret_cast<__m256i const *>( p ) );
+		}
+
+		/// @brief Harley-Seal popcount over blocks of 16 256bit vectors
+		/// @return count of bits in the first block_count * 64 words
+		inline std::size_t popcount_harley_seal( word_t const *data,
+		                                         std::size_t block_count ) noexcept {
+			auto total = _mm256_setzero_si256( );
+			auto ones = _mm256_setzero_si256( );
+			auto twos = _mm256_setzero_si256( );
+			auto fours = _mm256_setzero_si256( );
+			auto eights = _mm256_setzero_si256( );
+			auto sixteens = _mm256_setzero_si256( );
+			__m256i twos_a, twos_b, fours_a, fours_b, eights_a, eights_b;
+			for( std::size_t b = 0; b < block_count; ++b ) {
+				word_t const *p = data + b * 64U;
+				csa( twos_a, ones, ones, load256( p + 0 ), load256( p + 4 ) );
+				csa( twos_b, ones, ones, load256( p + 8 ), load256( p + 12 ) );
+				csa( fours_a, twos, twos, twos_a, twos_b );
+				csa( twos_a, ones, ones, load256( p + 16 ), load256( p + 20 ) );
+				csa( twos_b, ones, ones, load256( p + 24 ), load256( p + 28 ) );
+				csa( fours_b, twos, twos, twos_a, twos_b );
+				csa( eights_a, fours, fours, fours_a, fours_b );
+				csa( twos_a, ones, ones, load256( p + 32 ), load256( p + 36 ) );
+				csa( twos_b, ones, ones, load256( p + 40 ), load256( p + 44 ) );
+				csa( fours_a, twos, twos, twos_a, twos_b );
+				csa( twos_a, ones, ones, load256( p + 48 ), load256( p + 52 ) );
+				csa( twos_b, ones, ones, load256( p + 56 ), load256( p + 60 ) );
+				csa( fours_b, twos, twos, twos_a, twos_b );
+				csa( eights_b, fours, fours, fours_a, fours_b );
+				csa( sixteens, eights, eights, eights_a, eights_b );
+				total = _mm256_add_epi64( total, popcount256( sixteens ) );
+			}
+			total = _mm256_slli_epi64( total, 4 );
+			total = _mm256_add_epi64(
+			  total, _mm256_slli_epi64( popcount256( eights ), 3 ) );
+			total =
+			  _mm256_add_epi64( total, _mm256_slli_epi64( popcount256( fours ), 2 ) );
+			total =
+			  _mm256_add_epi64( total, _mm256_slli_epi64( popcount256( twos ), 1 ) );
+			total = _mm256_add_epi64( total, popcount256( ones ) );
+			return static_cast<std::size_t>(
+			  static_cast<word_t>( _mm256_extract_epi64( total, 0 ) ) +
+			  static_cast<word_t>( _mm256_extract_epi64( total, 1 ) ) +
+			  static_cast<word_t>( _mm256_extract_epi64( total, 2 ) ) +
+			  static_cast<word_t>( _mm256_extract_epi64( total, 3 ) ) );
+		}
+#endif
+
+		/// @brief Count the set bits in [data, data + count)
+		[[nodiscard]] inline std::size_t popcount_words( word_t const *data,
+		                                                 std::size_t count ) noexcept {
+			std::size_t result = 0;
+			std::size_t n = 0;
+#if defined( DAW_HAS_AVX2 )
+			// Below a few blocks the setup cost outweighs the wider adds
+			if( count >= 256U ) {
+				auto const blocks = count / 64U;
+				result += popcount_harley_seal( data, blocks );
+				n = blocks * 64U;
+			}
+#endif
+			// Independent accumulators keep the popcnt units busy
+			std::size_t r0 = 0;
+			std::size_t r1 = 0;
+			std::size_t r2 = 0;
+			std::size_t r3 = 0;
+			for( ; n + 4U <= count; n += 4U ) {
+				r0 += popcount( data[n] );
+				r1 += popcount( data[n + 1U] );
+				r2 += popcount( data[n + 2U] );
+				r3 += popcount( data[n + 3U] );
+			}
+			for( ; n < count; ++n ) {
+				r0 += popcount( data[n] );
+			}
+			return result + r0 + r1 + r2 + r3;
+		}
+	} // namespace dyn_bitset_impl
+
+	/// @brief Forward iterator over the positions of the set bits in a word
+	/// array
+	struct set_bit_iterator {
+		using value_type = std::size_t;
+		using reference = std::size_t;
+		using pointer = void;
+		using difference_type = std::ptrdiff_t;
+		using iterator_category = std::forward_iterator_tag;
+
+	private:
+		dyn_bitset_impl::word_t const *m_words = nullptr;
+		std::size_t m_word_count = 0;
+		std::size_t m_index = 0;
+		dyn_bitset_impl::word_t m_current = 0;
+
+		constexpr void skip_empty( ) noexcept {
+			while( m_current == 0 and ++m_index < m_word_count ) {
+				m_current = m_words[m_index];
+			}
+		}
+
+	public:
+		set_bit_iterator( ) = default;
+
+		constexpr set_bit_iterator( dyn_bitset_impl::word_t const *words,
+		                            std::size_t word_count ) noexcept
+		  : m_words( words )
+		  , m_word_count( word_count )
+		  , m_current( word_count == 0 ? 0 : words[0] ) {
+			if( word_count == 0 ) {
+				return;
+			}
+			skip_empty( );
+		}
+
+		[[nodiscard]] constexpr std::size_t operator*( ) const noexcept {
+			return m_index * dyn_bitset_impl::word_bits +
+			       dyn_bitset_impl::ctz( m_current );
+		}
+
+		constexpr set_bit_iterator &operator++( ) noexcept {
+			m_current &= m_current - 1U;
+			skip_empty( );
+			return *this;
+		}
+
+		constexpr set_bit_iterator operator++( int ) noexcept {
+			auto result = *this;
+			operator++( );
+			return result;
+		}
+
+		[[nodiscard]] constexpr bool is_end( ) const noexcept {
+			return m_index >= m_word_count;
+		}
+
+		[[nodiscard]] friend constexpr bool
+		operator==( set_bit_iterator const &lhs,
+		            set_bit_iterator const &rhs ) noexcept {
+			if( lhs.is_end( ) or rhs.is_end( ) ) {
+				return lhs.is_end( ) == rhs.is_end( );
+			}
+			return lhs.m_index == rhs.m_index and lhs.m_current == rhs.m_current;
+		}
+
+		[[nodiscard]] friend constexpr bool
+		operator!=( set_bit_iterator const &lhs,
+		            set_bit_iterator const &rhs ) noexcept {
+			return not( lhs == rhs );
+		}
+	};
+
+	struct set_bit_range {
+		dyn_bitset_impl::word_t const *words = nullptr;
+		std::size_t word_count = 0;
+
+		[[nodiscard]] constexpr set_bit_iterator begin( ) const noexcept {
+			return set_bit_iterator( words, word_count );
+		}
+
+		[[nodiscard]] constexpr set_bit_iterator end( ) const noexcept {
+			return set_bit_iterator( );
+		}
+	};
+
+	/// @brief A runtime sized bitset stored in 64bit words.  The bulk
+	/// operations(and/or/xor/and_not/count) use AVX2/SSE2 when enabled for the
+	/// translation unit.  Bits past size( ) in the last word are always zero.
+	template<typename Allocator = std::allocator<std::uint64_t>>
+	class dynamic_bitset {
+	public:
+		using word_type = dyn_bitset_impl::word_t;
+		using allocator_type = Allocator;
+		using size_type = std::size_t;
+		static constexpr size_type word_bits = dyn_bitset_impl::word_bits;
+		static constexpr size_type npos = static_cast<size_type>( -1 );
+
+	private:
+		std::vector<word_type, Allocator> m_words{ };
+		size_type m_size = 0;
+
+		void clear_tail( ) noexcept {
+			if( not m_words.empty( ) ) {
+				m_words.back( ) &= dyn_bitset_impl::tail_mask( m_size );
+			}
+		}
+
+	public:
+		dynamic_bitset( ) = default;
+
+		explicit dynamic_bitset( Allocator const &alloc )
+		  : m_words( alloc ) {}
+
+		explicit dynamic_bitset( size_type bit_count, bool value = false,
+		                         Allocator const &alloc = Allocator( ) )
+		  : m_words( dyn_bitset_impl::words_needed( bit_count ),
+		             value ? ~word_type{ 0 } : word_type{ 0 }, alloc )
+		  , m_size( bit_count ) {
+			clear_tail( );
+		}
+
+		[[nodiscard]] size_type size( ) const noexcept {
+			return m_size;
+		}
+
+		[[nodiscard]] bool empty( ) const noexcept {
+			return m_size == 0;
+		}
+
+		[[nodiscard]] size_type word_count( ) const noexcept {
+			return m_words.size( );
+		}
+
+		[[nodiscard]] word_type const *data( ) const noexcept {
+			return m_words.data( );
+		}
+
+		/// @brief Mutable access to the underlying words.  Callers must keep the
+		/// bits past size( ) zero
+		[[nodiscard]] word_type *data( ) noexcept {
+			return m_words.data( );
+		}
+
+		void resize( size_type bit_count, bool value = false ) {
+			auto const old_size = m_size;
+			m_words.resize( dyn_bitset_impl::words_needed( bit_count ),
+			                value ? ~word_type{ 0 } : word_type{ 0 } );
+			m_size = bit_count;
+			if( value and bit_count > old_size and
+			    old_size % word_bits != 0 ) {
+				m_words[old_size / word_bits] |=
+				  ~dyn_bitset_impl::tail_mask( old_size );
+			}
+			clear_tail( );
+		}
+
+		void clear( ) noexcept {
+			m_words.clear( );
+			m_size = 0;
+		}
+
+		[[nodiscard]] bool test( size_type pos ) const noexcept {
+			daw_dbg_ensure( pos < m_size );
+			return ( ( m_words[pos / word_bits] >> ( pos % word_bits ) ) & 1U ) != 0;
+		}
+
+		[[nodiscard]] bool operator[]( size_type pos ) const noexcept {
+			return test( pos );
+		}
+
+		dynamic_bitset &set( size_type pos ) noexcept {
+			daw_dbg_ensure( pos < m_size );
+			m_words[pos / word_bits] |= word_type{ 1 } << ( pos % word_bits );
+			return *this;
+		}
+
+		dynamic_bitset &set( size_type pos, bool value ) noexcept {
+			if( value ) {
+				return set( pos );
+			}
+			return reset( pos );
+		}
+
+		dynamic_bitset &reset( size_type pos ) noexcept {
+			daw_dbg_ensure( pos < m_size );
+			m_words[pos / word_bits] &= ~( word_type{ 1 } << ( pos % word_bits ) );
+			return *this;
+		}
+
+		dynamic_bitset &flip( size_type pos ) noexcept {
+			daw_dbg_ensure( pos < m_size );
+			m_words[pos / word_bits] ^= word_type{ 1 } << ( pos % word_bits );
+			return *this;
+		}
+
+		dynamic_bitset &set( ) noexcept {
+			for( auto &w : m_words ) {
+				w = ~word_type{ 0 };
+			}
+			clear_tail( );
+			return *this;
+		}
+
+		dynamic_bitset &reset( ) noexcept {
+			for( auto &w : m_words ) {
+				w = 0;
+			}
+			return *this;
+		}
+
+		dynamic_bitset &flip( ) noexcept {
+			for( auto &w : m_words ) {
+				w = ~w;
+			}
+			clear_tail( );
+			return *this;
+		}
+
+		/// @brief Number of set bits
+		[[nodiscard]] size_type count( ) const noexcept {
+			return dyn_bitset_impl::popcount_words( m_words.data( ),
+			                                        m_words.size( ) );
+		}
+
+		[[nodiscard]] bool any( ) const noexcept {
+			for( auto w : m_words ) {
+				if( w != 0 ) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		[[nodiscard]] bool none( ) const noexcept {
+			return not any( );
+		}
+
+		[[nodiscard]] bool all( ) const noexcept {
+			if( m_words.empty( ) ) {
+				return true;
+			}
+			auto const last = m_words.size( ) - 1U;
+			for( size_type n = 0; n < last; ++n ) {
+				if( m_words[n] != ~word_type{ 0 } ) {
+					return false;
+				}
+			}
+			return m_words[last] == dyn_bitset_impl::tail_mask( m_size );
+		}
+
+		dynamic_bitset &operator&=( dynamic_bitset const &rhs ) noexcept {
+			daw_ensure( m_size == rhs.m_size );
+			dyn_bitset_impl::transform_words( m_words.data( ), rhs.m_words.data( ),
+			                                  m_words.size( ),
+			                                  dyn_bitset_impl::op_and{ } );
+			return *this;
+		}
+
+		dynamic_bitset &operator|=( dynamic_bitset const &rhs ) noexcept {
+			daw_ensure( m_size == rhs.m_size );
+			dyn_bitset_impl::transform_words( m_words.data( ), rhs.m_words.data( ),
+			                                  m_words.size( ),
+			                                  dyn_bitset_impl::op_or{ } );
+			return *this;
+		}
+
+		dynamic_bitset &operator^=( dynamic_bitset const &rhs ) noexcept {
+			daw_ensure( m_size == rhs.m_size );
+			dyn_bitset_impl::transform_words( m_words.data( ), rhs.m_words.data( ),
+			                                  m_words.size( ),
+			                                  dyn_bitset_impl::op_xor{ } );
+			return *this;
+		}
+
+		/// @brief *this = *this & ~rhs
+		dynamic_bitset &and_not( dynamic_bitset const &rhs ) noexcept {
+			daw_ensure( m_size == rhs.m_size );
+			dyn_bitset_impl::transform_words( m_words.data( ), rhs.m_words.data( ),
+			                                  m_words.size( ),
+			                                  dyn_bitset_impl::op_and_not{ } );
+			return *this;
+		}
+
+		[[nodiscard]] friend dynamic_bitset operator&( dynamic_bitset lhs,
+		                                               dynamic_bitset const &rhs ) {
+			lhs &= rhs;
+			return lhs;
+		}
+
+		[[nodiscard]] friend dynamic_bitset operator|( dynamic_bitset lhs,
+		                                               dynamic_bitset const &rhs ) {
+			lhs |= rhs;
+			return lhs;
+		}
+
+		[[nodiscard]] friend dynamic_bitset operator^( dynamic_bitset lhs,
+		                                               dynamic_bitset const &rhs ) {
+			lhs ^= rhs;
+			return lhs;
+		}
+
+		[[nodiscard]] dynamic_bitset operator~( ) const {
+			auto result = *this;
+			result.flip( );
+			return result;
+		}
+
+		[[nodiscard]] friend bool operator==( dynamic_bitset const &lhs,
+		                                      dynamic_bitset const &rhs ) noexcept {
+			return lhs.m_size == rhs.m_size and lhs.m_words == rhs.m_words;
+		}
+
+		[[nodiscard]] friend bool operator!=( dynamic_bitset const &lhs,
+		                                      dynamic_bitset const &rhs ) noexcept {
+			return not( lhs == rhs );
+		}
+
+		/// @brief Position of the first set bit at or after pos, or npos
+		[[nodiscard]] size_type find_next( size_type pos ) const noexcept {
+			if( pos >= m_size ) {
+				return npos;
+			}
+			auto idx = pos / word_bits;
+			auto w = m_words[idx] & ( ~word_type{ 0 } << ( pos % word_bits ) );
+			while( w == 0 ) {
+				if( ++idx >= m_words.size( ) ) {
+					return npos;
+				}
+				w = m_words[idx];
+			}
+			return idx * word_bits + dyn_bitset_impl::ctz( w );
+		}
+
+		[[nodiscard]] size_type find_first( ) const noexcept {
+			return find_next( 0 );
+		}
+
+		/// @brief Call f( pos ) for each set bit in ascending order
+		template<typename Function>
+		DAW_ATTRIB_FLATTEN void for_each_set_bit( Function &&f ) const {
+			auto const sz = m_words.size( );
+			for( size_type idx = 0; idx < sz; ++idx ) {
+				auto w = m_words[idx];
+				while( w != 0 ) {
+					(void)f( idx * word_bits + dyn_bitset_impl::ctz( w ) );
+					w &= w - 1U;
+				}
+			}
+		}
+
+		/// @brief A forward range of the positions of the set bits
+		[[nodiscard]] set_bit_range set_bits( ) const noexcept {
+			return set_bit_range{ m_words.data( ), m_words.size( ) };
+		}
+	};
+
+	/// @brief Succinct rank/select index over a dynamic_bitset.  Rank is O(1),
+	/// select uses sampled positions followed by a short search.  The index
+	/// refers to the bitset's storage and must be rebuilt after it is modified
+	/// or reallocated.
+	class bitset_rank_select {
+	public:
+		using word_type = dyn_bitset_impl::word_t;
+		using size_type = std::size_t;
+		/// Number of words covered by each cumulative rank entry
+		static constexpr size_type block_words = 8U;
+		static constexpr size_type block_bits =
+		  block_words * dyn_bitset_impl::word_bits;
+		/// Every select_sample_rate'th set bit has its block recorded
+		static constexpr size_type select_sample_rate = 4096U;
+
+	private:
+		word_type const *m_words = nullptr;
+		size_type m_word_count = 0;
+		size_type m_size = 0;
+		std::vector<std::uint64_t> m_block_ranks{ };
+		std::vector<std::uint32_t> m_select_samples{ };
+
+		[[nodiscard]] size_type block_count( ) const noexcept {
+			return m_block_ranks.size( ) - 1U;
+		}
+
+	public:
+		bitset_rank_select( ) = default;
+
+		template<typename Allocator>
+		explicit bitset_rank_select( dynamic_bitset<Allocator> const &bs )
+		  : m_words( bs.data( ) )
+		  , m_word_count( bs.word_count( ) )
+		  , m_size( bs.size( ) ) {
+			auto const blocks = ( m_word_count + block_words - 1U ) / block_words;
+			m_block_ranks.reserve( blocks + 1U );
+			std::uint64_t total = 0;
+			size_type next_sample = 0;
+			for( size_type b = 0; b < blocks; ++b ) {
+				m_block_ranks.push_back( total );
+				auto const first = b * block_words;
+				auto const last = first + block_words < m_word_count
+				                    ? first + block_words
+				                    : m_word_count;
+				total += dyn_bitset_impl::popcount_words( m_words + first,
+				                                          last - first );
+				while( next_sample < total ) {
+					m_select_samples.push_back( static_cast<std::uint32_t>( b ) );
+					next_sample += select_sample_rate;
+				}
+			}
+			m_block_ranks.push_back( total );
+		}
+
+		/// @brief Total number of set bits
+		[[nodiscard]] size_type count( ) const noexcept {
+			return static_cast<size_type>( m_block_ranks.back( ) );
+		}
+
+		[[nodiscard]] size_type size( ) const noexcept {
+			return m_size;
+		}
+
+		/// @brief Number of set bits in [0, pos)
+		[[nodiscard]] size_type rank( size_type pos ) const noexcept {
+			daw_dbg_ensure( pos <= m_size );
+			auto const block = pos / block_bits;
+			auto result = static_cast<size_type>( m_block_ranks[block] );
+			auto const word = pos / dyn_bitset_impl::word_bits;
+			for( size_type w = block * block_words; w < word; ++w ) {
+				result += dyn_bitset_impl::popcount( m_words[w] );
+			}
+			auto const bit = pos % dyn_bitset_impl::word_bits;
+			if( bit != 0 ) {
+				result += dyn_bitset_impl::popcount(
+				  m_words[word] & ( ( word_type{ 1 } << bit ) - 1U ) );
+			}
+			return result;
+		}
+
+		/// @brief Number of unset bits in [0, pos)
+		[[nodiscard]] size_type rank0( size_type pos ) const noexcept {
+			return pos - rank( pos );
+		}
+
+		/// @brief Position of the nth(0 based) set bit.  n must be < count( )
+		[[nodiscard]] size_type select( size_type n ) const noexcept {
+			daw_dbg_ensure( n < count( ) );
+			auto const sample = n / select_sample_rate;
+			size_type lo = m_select_samples[sample];
+			size_type hi = sample + 1U < m_select_samples.size( )
+			                 ? m_select_samples[sample + 1U] + 1U
+			                 : block_count( );
+			// Find the last block whose starting rank is <= n
+			while( hi - lo > 1U ) {
+				auto const mid = lo + ( hi - lo ) / 2U;
+				if( m_block_ranks[mid] <= n ) {
+					lo = mid;
+				} else {
+					hi = mid;
+				}
+			}
+			auto remaining = n - static_cast<size_type>( m_block_ranks[lo] );
+			auto w = lo * block_words;
+			while( true ) {
+				auto const cnt = dyn_bitset_impl::popcount( m_words[w] );
+				if( remaining < cnt ) {
+					return w * dyn_bitset_impl::word_bits +
+					       dyn_bitset_impl::select_in_word( m_words[w], remaining );
+				}
+				remaining -= cnt;
+				++w;
+			}
+		}
+	};
+} // namespace daw
@@ -10,12 +10,21 @@
 
 #include "ciso646.h"
 #include "daw_arith_traits.h"
+#include "daw_attributes.h"
+#include "daw_bit_cast.h"
 #include "daw_constant.h"
 #include "daw_cpp_feature_check.h"
+#include "daw_ensure.h"
+#include "daw_is_constant_evaluated.h"
+#include "daw_span.h"
+#include "impl/daw_simd_check.h"
 
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <daw/stdinc/enable_if.h>
+#include <type_traits>
+#include <utility>
 
 namespace daw {
 	enum class endian {
@@ -107,8 +116,358 @@ namespace daw {
 			      << static_cast<std::uint64_t>( 56U ) ) &
 			    static_cast<std::uint64_t>( 0xFF00'0000'0000'0000U ) ) );
 		}
+
+		template<std::size_t Size>
+		struct uint_of_size;
+
+		template<>
+		struct uint_of_size<2> {
+			using type = std::uint16_t;
+		};
+
+		template<>
+		struct uint_of_size<4> {
+			using type = std::uint32_t;
+		};
+
+		template<>
+		struct uint_of_size<8> {
+			using type = std::uint64_t;
+		};
+
+		template<std::size_t Size>
+		using uint_of_size_t = typename uint_of_size<Size>::type;
+
+		/// Arithmetic types with an unsigned integer of the same size.  This
+		/// excludes long double, which is wider than 8 bytes on most targets
+		template<typename T>
+		inline constexpr bool is_byte_swappable_v =
+		  std::is_arithmetic_v<T> and
+		  ( sizeof( T ) == 1 or sizeof( T ) == 2 or sizeof( T ) == 4 or
+		    sizeof( T ) == 8 );
+
+		template<typename T>
+		DAW_ATTRIB_INLINE constexpr T swap_integral( T value ) noexcept {
+#if defined( __GNUC__ ) or defined( __clang__ )
+			if constexpr( sizeof( T ) == 2 ) {
+				return static_cast<T>(
+				  __builtin_bswap16( static_cast<std::uint16_t>( value ) ) );
+			} else if constexpr( sizeof( T ) == 4 ) {
+				return static_cast<T>(
+				  __builtin_bswap32( static_cast<std::uint32_t>( value ) ) );
+			} else if constexpr( sizeof( T ) == 8 ) {
+				return static_cast<T>(
+				  __builtin_bswap64( static_cast<std::uint64_t>( value ) ) );
+			} else {
+				return swap_bytes( value, daw::constant<sizeof( T )>{ } );
+			}
+#else
+			return swap_bytes( value, daw::constant<sizeof( T )>{ } );
+#endif
+		}
+
+		/// Reverse the bytes of a Size byte value at in and write it to out
+		template<std::size_t Size>
+		DAW_ATTRIB_INLINE void swap_one( unsigned char const *in,
+		                                 unsigned char *out ) noexcept {
+			uint_of_size_t<Size> value;
+			std::memcpy( &value, in, Size );
+			value = swap_integral( value );
+			std::memcpy( out, &value, Size );
+		}
+
+#if defined( DAW_HAS_SSE2 ) and defined( DAW_HAS_IF_CONSTEVAL_COMPAT )
+#define DAW_ENDIAN_HAS_SIMD
+#if defined( DAW_HAS_SSSE3 )
+		/// pshufb control that reverses each Size byte lane of 16 bytes
+		template<std::size_t Size, std::size_t... Is>
+		DAW_ATTRIB_INLINE __m128i swap_mask128( std::index_sequence<Is...> ) {
+			return _mm_setr_epi8(
+			  static_cast<char>( ( Is / Size ) * Size + ( Size - 1U - Is % Size ) )... );
+		}
+#endif
+
+		template<std::size_t Size>
+		DAW_ATTRIB_INLINE __m128i swap_lanes( __m128i v ) {
+#if defined( DAW_HAS_SSSE3 )
+			return _mm_shuffle_epi8(
+			  v, swap_mask128<Size>( std::make_index_sequence<16>{ } ) );
+#else
+			// Reverse the 16 bit words of each lane, then the bytes of each word
+			if constexpr( Size == 4 ) {
+				v = _mm_shufflehi_epi16( _mm_shufflelo_epi16( v, 0xB1 ), 0xB1 );
+			} else if constexpr( Size == 8 ) {
+				v = _mm_shufflehi_epi16( _mm_shufflelo_epi16( v, 0x1B ), 0x1B );
+			}
+			return _mm_or_si128( _mm_slli_epi16( v, 8 ), _mm_srli_epi16( v, 8 ) );
+#endif
+		}
+
+#if defined( DAW_HAS_AVX2 )
+		template<std::size_t Size, std::size_t... Is>
+		DAW_ATTRIB_INLINE __m256i swap_mask256( std::index_sequence<Is...> ) {
+			return _mm256_setr_epi8(
+			  static_cast<char>( ( Is % 16U / Size ) * Size +
+			                     ( Size - 1U - Is % Size ) )... );
+		}
+
+		template<std::size_t Size>
+		DAW_ATTRIB_INLINE __m256i swap_lanes( __m256i v ) {
+			return _mm256_shuffle_epi8(
+			  v, swap_mask256<Size>( std::make_index_sequence<32>{ } ) );
+		}
+
+		using swap_vec_t = __m256i;
+
+		DAW_ATTRIB_INLINE __m256i swap_load( unsigned char const *p ) {
+			return _mm256_loadu_si256( reinterpret_cast<__m256i const *>( p ) );
+		}
+
+		DAW_ATTRIB_INLINE void swap_store( unsigned char *p, __m256i v ) {
+			_mm256_storeu_si256( reinterpret_cast<__m256i *>( p ), v );
+		}
+#else
+		using swap_vec_t = __m128i;
+
+		DAW_ATTRIB_INLINE __m128i swap_load( unsigned char const *p ) {
+			return _mm_loadu_si128( reinterpret_cast<__m128i const *>( p ) );
+		}
+
+		DAW_ATTRIB_INLINE void swap_store( unsigned char *p, __m128i v ) {
+			_mm_storeu_si128( reinterpret_cast<__m128i *>( p ), v );
+		}
+#endif
+
+		/// Reverse the bytes of each Size byte value of in[0, bytes) into out.  in
+		/// and out are either the same or do not overlap
+		template<std::size_t Size>
+		DAW_ATTRIB_FLATTEN inline void swap_block( unsigned char const *in,
+		                                           unsigned char *out,
+		                                           std::size_t bytes ) noexcept {
+			constexpr std::size_t width = sizeof( swap_vec_t );
+			std::size_t n = 0;
+			for( ; n + 4U * width <= bytes; n += 4U * width ) {
+				auto const v0 = swap_lanes<Size>( swap_load( in + n ) );
+				auto const v1 = swap_lanes<Size>( swap_load( in + n + width ) );
+				auto const v2 = swap_lanes<Size>( swap_load( in + n + 2U * width ) );
+				auto const v3 = swap_lanes<Size>( swap_load( in + n + 3U * width ) );
+				swap_store( out + n, v0 );
+				swap_store( out + n + width, v1 );
+				swap_store( out + n + 2U * width, v2 );
+				swap_store( out + n + 3U * width, v3 );
+			}
+			for( ; n + width <= bytes; n += width ) {
+				swap_store( out + n, swap_lanes<Size>( swap_load( in + n ) ) );
+			}
+			for( ; n < bytes; n += Size ) {
+				swap_one<Size>( in + n, out + n );
+			}
+		}
+#else
+		template<std::size_t Size>
+		inline void swap_block( unsigned char const *in, unsigned char *out,
+		                        std::size_t bytes ) noexcept {
+			for( std::size_t n = 0; n < bytes; n += Size ) {
+				swap_one<Size>( in + n, out + n );
+			}
+		}
+#endif
 	} // namespace endian_details
 
+	/// @brief Reverse the bytes of value.  Floating point values have their
+	/// object representation reversed, use this only on values being moved to or
+	/// from storage
+	template<typename T,
+	         std::enable_if_t<endian_details::is_byte_swappable_v<T>,
+	                          std::nullptr_t> = nullptr>
+	[[nodiscard]] constexpr T byte_swap( T value ) noexcept {
+		if constexpr( sizeof( T ) == 1 ) {
+			return value;
+		} else if constexpr( std::is_floating_point_v<T> ) {
+			using uint_t = endian_details::uint_of_size_t<sizeof( T )>;
+			return DAW_BIT_CAST(
+			  T, endian_details::swap_integral( DAW_BIT_CAST( uint_t, value ) ) );
+		} else {
+			return endian_details::swap_integral( value );
+		}
+	}
+
+	/// @brief Reverse the bytes of every value in place.  This uses pshufb, or
+	/// SSE2 shuffles, on blocks of values when available
+	template<typename T,
+	         std::enable_if_t<endian_details::is_byte_swappable_v<T>,
+	                          std::nullptr_t> = nullptr>
+	constexpr void byte_swap_in_place( daw::span<T> values ) noexcept {
+		if constexpr( sizeof( T ) > 1 ) {
+#if defined( DAW_ENDIAN_HAS_SIMD )
+			DAW_IF_NOT_CONSTEVAL {
+				auto *const p = reinterpret_cast<unsigned char *>( values.data( ) );
+				endian_details::swap_block<sizeof( T )>( p, p,
+				                                         values.size( ) * sizeof( T ) );
+				return;
+			}
+#endif
+			for( auto &v : values ) {
+				v = byte_swap( v );
+			}
+		}
+	}
+
+	/// @brief Write the byte reversed values of in to out, which must not overlap
+	/// in and must be at least as large
+	template<typename T,
+	         std::enable_if_t<endian_details::is_byte_swappable_v<T>,
+	                          std::nullptr_t> = nullptr>
+	constexpr void byte_swap_copy( daw::span<T const> in, daw::span<T> out ) {
+		daw_ensure( in.size( ) <= out.size( ) );
+		if constexpr( sizeof( T ) == 1 ) {
+			for( std::size_t n = 0; n < in.size( ); ++n ) {
+				out[n] = in[n];
+			}
+		} else {
+#if defined( DAW_ENDIAN_HAS_SIMD )
+			DAW_IF_NOT_CONSTEVAL {
+				endian_details::swap_block<sizeof( T )>(
+				  reinterpret_cast<unsigned char const *>( in.data( ) ),
+				  reinterpret_cast<unsigned char *>( out.data( ) ),
+				  in.size( ) * sizeof( T ) );
+				return;
+			}
+#endif
+			for( std::size_t n = 0; n < in.size( ); ++n ) {
+				out[n] = byte_swap( in[n] );
+			}
+		}
+	}
+
+	/// @brief Convert values stored in SourceEndian order to native order in
+	/// place
+	template<endian SourceEndian, typename T,
+	         std::enable_if_t<endian_details::is_byte_swappable_v<T>,
+	                          std::nullptr_t> = nullptr>
+	constexpr void to_native_endian_in_place( daw::span<T> values ) noexcept {
+		if constexpr( SourceEndian != endian::native ) {
+			byte_swap_in_place( std::move( values ) );
+		}
+	}
+
+	/// @brief Convert native values to TargetEndian order in place
+	template<endian TargetEndian, typename T,
+	         std::enable_if_t<endian_details::is_byte_swappable_v<T>,
+	                          std::nullptr_t> = nullptr>
+	constexpr void from_native_endian_in_place( daw::span<T> values ) noexcept {
+		to_native_endian_in_place<TargetEndian>( std::move( values ) );
+	}
+
+	/// @brief Copy values stored in SourceEndian order to out in native order
+	template<endian SourceEndian, typename T,
+	         std::enable_if_t<endian_details::is_byte_swappable_v<T>,
+	                          std::nullptr_t> = nullptr>
+	constexpr void to_native_endian_copy( daw::span<T const> in,
+	                                      daw::span<T> out ) {
+		if constexpr( SourceEndian != endian::native ) {
+			byte_swap_copy( in, std::move( out ) );
+		} else {
+			daw_ensure( in.size( ) <= out.size( ) );
+			for( std::size_t n = 0; n < in.size( ); ++n ) {
+				out[n] = in[n];
+			}
+		}
+	}
+
+	/// @brief Copy native values to out in TargetEndian order
+	template<endian TargetEndian, typename T,
+	         std::enable_if_t<endian_details::is_byte_swappable_v<T>,
+	                          std::nullptr_t> = nullptr>
+	constexpr void from_native_endian_copy( daw::span<T const> in,
+	                                        daw::span<T> out ) {
+		to_native_endian_copy<TargetEndian>( in, std::move( out ) );
+	}
+
+	/// @brief Read a T stored in SourceEndian order from possibly unaligned
+	/// memory
+	template<endian SourceEndian, typename T,
+	         std::enable_if_t<endian_details::is_byte_swappable_v<T>,
+	                          std::nullptr_t> = nullptr>
+	[[nodiscard]] inline T load_endian( void const *src ) noexcept {
+		T value;
+		std::memcpy( &value, src, sizeof( T ) );
+		if constexpr( SourceEndian != endian::native ) {
+			value = byte_swap( value );
+		}
+		return value;
+	}
+
+	/// @brief Read out.size( ) values stored in SourceEndian order from possibly
+	/// unaligned memory
+	template<endian SourceEndian, typename T,
+	         std::enable_if_t<endian_details::is_byte_swappable_v<T>,
+	                          std::nullptr_t> = nullptr>
+	inline void load_endian( void const *src, daw::span<T> out ) noexcept {
+		auto const bytes = out.size( ) * sizeof( T );
+		if constexpr( SourceEndian == endian::native or sizeof( T ) == 1 ) {
+			std::memcpy( out.data( ), src, bytes );
+		} else {
+			endian_details::swap_block<sizeof( T )>(
+			  static_cast<unsigned char const *>( src ),
+			  reinterpret_cast<unsigned char *>( out.data( ) ), bytes );
+		}
+	}
+
+	/// @brief Write value in TargetEndian order to possibly unaligned memory
+	template<endian TargetEndian, typename T,
+	         std::enable_if_t<endian_details::is_byte_swappable_v<T>,
+	                          std::nullptr_t> = nullptr>
+	inline void store_endian( void *dst, T value ) noexcept {
+		if constexpr( TargetEndian != endian::native ) {
+			value = byte_swap( value );
+		}
+		std::memcpy( dst, &value, sizeof( T ) );
+	}
+
+	/// @brief Write the values of in in TargetEndian order to possibly unaligned
+	/// memory
+	template<endian TargetEndian, typename T,
+	         std::enable_if_t<endian_details::is_byte_swappable_v<T>,
+	                          std::nullptr_t> = nullptr>
+	inline void store_endian( void *dst, daw::span<T const> in ) noexcept {
+		auto const bytes = in.size( ) * sizeof( T );
+		if constexpr( TargetEndian == endian::native or sizeof( T ) == 1 ) {
+			std::memcpy( dst, in.data( ), bytes );
+		} else {
+			endian_details::swap_block<sizeof( T )>(
+			  reinterpret_cast<unsigned char const *>( in.data( ) ),
+			  static_cast<unsigned char *>( dst ), bytes );
+		}
+	}
+
+	/// @brief Append value in TargetEndian order to a byte writer such as
+	/// daw::span_writer<char>
+	template<endian TargetEndian, typename Writer, typename T,
+	         std::enable_if_t<endian_details::is_byte_swappable_v<T>,
+	                          std::nullptr_t> = nullptr>
+	Writer &write_endian( Writer &out, T value ) {
+		static_assert( sizeof( *out.data( ) ) == 1, "Writer must write bytes" );
+		daw_ensure( sizeof( T ) <= out.size( ) );
+		store_endian<TargetEndian>( out.data( ), value );
+		out.remove_prefix( sizeof( T ) );
+		return out;
+	}
+
+	/// @brief Append the values in TargetEndian order to a byte writer such as
+	/// daw::span_writer<char>
+	template<endian TargetEndian, typename Writer, typename T,
+	         std::enable_if_t<endian_details::is_byte_swappable_v<T>,
+	                          std::nullptr_t> = nullptr>
+	Writer &write_endian( Writer &out, daw::span<T const> values ) {
+		static_assert( sizeof( *out.data( ) ) == 1, "Writer must write bytes" );
+		auto const bytes = values.size( ) * sizeof( T );
+		daw_ensure( bytes <= out.size( ) );
+		store_endian<TargetEndian>( out.data( ), values );
+		out.remove_prefix( bytes );
+		return out;
+	}
+
 	template<typename T,
 	         std::enable_if_t<daw::is_integral_v<T>, std::nullptr_t> = nullptr>
 	constexpr T to_little_endian( T value ) noexcept {
@@ -0,0 +1,684 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/ciso646.h"
+#include "daw/daw_attributes.h"
+#include "daw/daw_check_exceptions.h"
+#include "daw/daw_memory_mapped_file.h"
+#include "daw/daw_sort_n.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace daw {
+	/// How sorted runs are written and read back
+	enum class external_sort_io {
+		/// stdio writes, reads are double buffered and prefetched on a
+		/// background thread
+		buffered,
+		/// Runs are written and read through memory_mapped_file_t
+		memory_mapped
+	};
+
+	struct external_sort_options {
+		/// Bytes of records sorted in memory for each run
+		std::size_t run_bytes = std::size_t{ 256U } * 1024U * 1024U;
+		/// Bytes for each read buffer while merging, every run has two
+		std::size_t block_bytes = std::size_t{ 1024U } * 1024U;
+		/// Where runs are written, the system temporary directory when empty
+		std::filesystem::path temp_directory{ };
+		external_sort_io io = external_sort_io::buffered;
+	};
+
+	namespace external_sort_details {
+		struct file_closer {
+			void operator( )( std::FILE *f ) const noexcept {
+				std::fclose( f );
+			}
+		};
+		using file_ptr = std::unique_ptr<std::FILE, file_closer>;
+
+		[[nodiscard]] inline file_ptr open_file( std::filesystem::path const &p,
+		                                         char const *mode ) {
+			auto result = file_ptr( std::fopen( p.string( ).c_str( ), mode ) );
+			if( not result ) {
+				DAW_THROW_OR_TERMINATE( std::system_error,
+				                        std::error_code( errno, std::generic_category( ) ),
+				                        "Unable to open " + p.string( ) );
+			}
+			return result;
+		}
+
+		template<typename T>
+		void write_records( std::FILE *f, T const *data, std::size_t count ) {
+			if( count > 0 and std::fwrite( data, sizeof( T ), count, f ) != count ) {
+				DAW_THROW_OR_TERMINATE( std::runtime_error,
+				                        "Error writing sorted records" );
+			}
+		}
+
+		/// A file in the temporary directory that is removed on destruction
+		class temp_file {
+			std::filesystem::path m_path{ };
+
+		public:
+			temp_file( ) = default;
+
+			explicit temp_file( std::filesystem::path p )
+			  : m_path( std::move( p ) ) {}
+
+			temp_file( temp_file &&other ) noexcept
+			  : m_path( std::exchange( other.m_path, { } ) ) {}
+
+			temp_file &operator=( temp_file &&rhs ) noexcept {
+				if( this != &rhs ) {
+					remove( );
+					m_path = std::exchange( rhs.m_path, { } );
+				}
+				return *this;
+			}
+
+			~temp_file( ) {
+				remove( );
+			}
+
+			[[nodiscard]] std::filesystem::path const &path( ) const noexcept {
+				return m_path;
+			}
+
+		private:
+			void remove( ) noexcept {
+				if( not m_path.empty( ) ) {
+					auto ec = std::error_code( );
+					std::filesystem::remove( m_path, ec );
+					m_path.clear( );
+				}
+			}
+		};
+
+		[[nodiscard]] inline std::filesystem::path
+		make_run_prefix( external_sort_options const &opts ) {
+			static std::atomic<std::uint64_t> counter{ 0 };
+			auto dir = opts.temp_directory.empty( )
+			             ? std::filesystem::temp_directory_path( )
+			             : opts.temp_directory;
+			auto rd = std::random_device{ };
+			auto const id = ( static_cast<std::uint64_t>( rd( ) ) << 32U ) ^
+			                counter.fetch_add( 1, std::memory_order_relaxed );
+			return dir / ( "daw_external_sort_" + std::to_string( id ) + "_" );
+		}
+
+		/// A single background thread that performs reads for run_sources so
+		/// that the next block of each run is loaded while the current one is
+		/// merged
+		class prefetcher {
+			std::mutex m_mutex{ };
+			std::condition_variable m_cv{ };
+			std::deque<std::function<void( )>> m_jobs{ };
+			bool m_stop = false;
+			std::thread m_thread{ };
+
+			void run( ) {
+				auto lck = std::unique_lock( m_mutex );
+				while( true ) {
+					m_cv.wait( lck, [&] {
+						return m_stop or not m_jobs.empty( );
+					} );
+					if( m_jobs.empty( ) ) {
+						return;
+					}
+					auto job = std::move( m_jobs.front( ) );
+					m_jobs.pop_front( );
+					lck.unlock( );
+					job( );
+					lck.lock( );
+					m_cv.notify_all( );
+				}
+			}
+
+		public:
+			prefetcher( )
+			  : m_thread( [this] {
+				  run( );
+			  } ) {}
+
+			prefetcher( prefetcher const & ) = delete;
+			prefetcher &operator=( prefetcher const & ) = delete;
+
+			~prefetcher( ) {
+				{
+					auto const lck = std::lock_guard( m_mutex );
+					m_stop = true;
+				}
+				m_cv.notify_all( );
+				m_thread.join( );
+			}
+
+			/// job runs on the background thread without the lock held
+			void submit( std::function<void( )> job ) {
+				{
+					auto const lck = std::lock_guard( m_mutex );
+					m_jobs.push_back( std::move( job ) );
+				}
+				m_cv.notify_all( );
+			}
+
+			/// Block until pred( ) is true.  pred is evaluated with the lock held
+			/// and is rechecked after each job completes
+			template<typename Predicate>
+			void wait( Predicate pred ) {
+				auto lck = std::unique_lock( m_mutex );
+				m_cv.wait( lck, pred );
+			}
+
+			[[nodiscard]] std::mutex &mutex( ) noexcept {
+				return m_mutex;
+			}
+		};
+
+		/// One sorted run being merged.  head( ) is the current record, or
+		/// nullptr once the run is exhausted
+		template<typename T>
+		class run_source {
+			T const *m_cur = nullptr;
+			T const *m_end = nullptr;
+
+			// In memory and memory mapped runs
+			std::vector<T> m_memory{ };
+			filesystem::memory_mapped_file_t<char> m_mapped{ };
+
+			// Buffered runs
+			prefetcher *m_prefetch = nullptr;
+			file_ptr m_file{ };
+			std::vector<T> m_buffers[2]{ };
+			std::size_t m_lengths[2]{ };
+			std::size_t m_active = 0;
+			std::size_t m_unread = 0;
+			std::size_t m_block = 0;
+			bool m_back_ready = false;
+			bool m_back_pending = false;
+			bool m_error = false;
+
+			void fill( std::size_t b ) {
+				auto const count = std::min( m_block, m_unread );
+				auto const read =
+				  std::fread( m_buffers[b].data( ), sizeof( T ), count, m_file.get( ) );
+				m_error = read != count;
+				m_lengths[b] = read;
+				m_unread -= read;
+			}
+
+			void prefetch( std::size_t b ) {
+				if( m_unread == 0 ) {
+					m_lengths[b] = 0;
+					m_back_ready = true;
+					return;
+				}
+				m_back_ready = false;
+				m_back_pending = true;
+				m_prefetch->submit( [this, b] {
+					fill( b );
+					// Published under the prefetcher lock, wait( ) checks it there
+					auto const lck = std::lock_guard( m_prefetch->mutex( ) );
+					m_back_ready = true;
+				} );
+			}
+
+			DAW_ATTRIB_NOINLINE void next_block( ) {
+				m_cur = m_end = nullptr;
+				if( not m_prefetch ) {
+					return;
+				}
+				if( m_back_pending ) {
+					m_prefetch->wait( [&] {
+						return m_back_ready;
+					} );
+					m_back_pending = false;
+				}
+				if( m_error ) {
+					DAW_THROW_OR_TERMINATE( std::runtime_error,
+					                        "Error reading sorted run" );
+				}
+				auto const next = 1U - m_active;
+				if( m_lengths[next] == 0 ) {
+					return;
+				}
+				m_active = next;
+				m_cur = m_buffers[m_active].data( );
+				m_end = m_cur + m_lengths[m_active];
+				prefetch( 1U - m_active );
+			}
+
+		public:
+			/// A run that stays in memory
+			explicit run_source( std::vector<T> records )
+			  : m_memory( std::move( records ) ) {
+				m_cur = m_memory.data( );
+				m_end = m_cur + m_memory.size( );
+			}
+
+			/// A run of count records in the file at path
+			run_source( std::filesystem::path const &path, std::size_t count,
+			            external_sort_io io, std::size_t block,
+			            prefetcher &pf ) {
+				if( count == 0 ) {
+					return;
+				}
+				if( io == external_sort_io::memory_mapped ) {
+					if( not m_mapped.open( path.string( ) ) ) {
+						DAW_THROW_OR_TERMINATE( std::runtime_error,
+						                        "Unable to map " + path.string( ) );
+					}
+					m_cur = reinterpret_cast<T const *>( m_mapped.data( ) );
+					m_end = m_cur + count;
+					return;
+				}
+				m_prefetch = &pf;
+				m_file = open_file( path, "rb" );
+				m_block = std::max<std::size_t>( block, 1 );
+				m_unread = count;
+				m_buffers[0].resize( std::min( m_block, count ) );
+				m_buffers[1].resize( std::min( m_block, count ) );
+				// The first block is read directly, the second in the background
+				m_active = 1;
+				fill( 0 );
+				m_back_pending = false;
+				next_block( );
+			}
+
+			run_source( run_source const & ) = delete;
+			run_source &operator=( run_source const & ) = delete;
+
+			~run_source( ) {
+				if( m_back_pending ) {
+					m_prefetch->wait( [&] {
+						return m_back_ready;
+					} );
+				}
+			}
+
+			[[nodiscard]] DAW_ATTRIB_INLINE T const *head( ) const noexcept {
+				return m_cur;
+			}
+
+			DAW_ATTRIB_INLINE void advance( ) {
+				if( ++m_cur == m_end ) {
+					next_block( );
+				}
+			}
+		};
+
+		/// Tournament tree of losers over k sources.  The overall winner is kept
+		/// in m_tree[0], replacing it costs one comparison per level.  Ties go to
+		/// the lower source index so that equal records keep run order
+		template<typename T, typename Compare>
+		class loser_tree {
+			std::vector<std::unique_ptr<run_source<T>>> *m_sources = nullptr;
+			std::vector<std::size_t> m_tree{ };
+			Compare m_comp;
+
+			[[nodiscard]] DAW_ATTRIB_INLINE bool beats( std::size_t a,
+			                                            std::size_t b ) const {
+				auto const *ha = ( *m_sources )[a]->head( );
+				auto const *hb = ( *m_sources )[b]->head( );
+				if( not ha ) {
+					return false;
+				}
+				if( not hb ) {
+					return true;
+				}
+				if( m_comp( *ha, *hb ) ) {
+					return true;
+				}
+				return a < b and not m_comp( *hb, *ha );
+			}
+
+			[[nodiscard]] std::size_t build( std::size_t node ) {
+				auto const k = m_tree.size( );
+				if( node >= k ) {
+					return node - k;
+				}
+				auto const l = build( 2U * node );
+				auto const r = build( 2U * node + 1U );
+				if( beats( r, l ) ) {
+					m_tree[node] = l;
+					return r;
+				}
+				m_tree[node] = r;
+				return l;
+			}
+
+		public:
+			loser_tree( std::vector<std::unique_ptr<run_source<T>>> &sources,
+			            Compare const &comp )
+			  : m_sources( &sources )
+			  , m_tree( std::max<std::size_t>( sources.size( ), 1 ) )
+			  , m_comp( comp ) {
+				m_tree[0] = sources.size( ) <= 1 ? 0 : build( 1 );
+			}
+
+			[[nodiscard]] DAW_ATTRIB_INLINE T const *top( ) const noexcept {
+				if( m_sources->empty( ) ) {
+					return nullptr;
+				}
+				return ( *m_sources )[m_tree[0]]->head( );
+			}
+
+			/// Advance the winning source and replay its path to the root
+			DAW_ATTRIB_INLINE void pop( ) {
+				auto s = m_tree[0];
+				( *m_sources )[s]->advance( );
+				auto const k = m_tree.size( );
+				for( auto t = ( s + k ) / 2U; t > 0; t /= 2U ) {
+					if( beats( m_tree[t], s ) ) {
+						std::swap( m_tree[t], s );
+					}
+				}
+				m_tree[0] = s;
+			}
+		};
+	} // namespace external_sort_details
+
+	/// The merged output of an external_sorter.  It is a single pass range that
+	/// owns the run files, they are removed when it is destroyed
+	template<typename T, typename Compare = std::less<>>
+	class external_merge_view {
+		struct state_t {
+			external_sort_details::prefetcher prefetch{ };
+			std::vector<external_sort_details::temp_file> files{ };
+			std::vector<std::unique_ptr<external_sort_details::run_source<T>>>
+			  sources{ };
+			std::unique_ptr<external_sort_details::loser_tree<T, Compare>> tree{ };
+			std::size_t size = 0;
+		};
+		std::unique_ptr<state_t> m_state{ };
+
+		template<typename, typename>
+		friend class external_sorter;
+
+		external_merge_view( std::vector<external_sort_details::temp_file> files,
+		                     std::vector<std::size_t> const &counts,
+		                     std::vector<T> memory_run,
+		                     external_sort_options const &opts,
+		                     Compare const &comp )
+		  : m_state( std::make_unique<state_t>( ) ) {
+			auto &st = *m_state;
+			st.files = std::move( files );
+			auto const block = std::max<std::size_t>( opts.block_bytes / sizeof( T ), 1 );
+			for( std::size_t n = 0; n < st.files.size( ); ++n ) {
+				st.size += counts[n];
+				st.sources.push_back(
+				  std::make_unique<external_sort_details::run_source<T>>(
+				    st.files[n].path( ), counts[n], opts.io, block, st.prefetch ) );
+			}
+			if( not memory_run.empty( ) ) {
+				st.size += memory_run.size( );
+				st.sources.push_back(
+				  std::make_unique<external_sort_details::run_source<T>>(
+				    std::move( memory_run ) ) );
+			}
+			st.tree =
+			  std::make_unique<external_sort_details::loser_tree<T, Compare>>(
+			    st.sources, comp );
+		}
+
+	public:
+		using value_type = T;
+		using reference = T const &;
+		using const_reference = T const &;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+
+		class iterator {
+			state_t *m_st = nullptr;
+
+		public:
+			using iterator_category = std::input_iterator_tag;
+			using value_type = T;
+			using reference = T const &;
+			using pointer = T const *;
+			using difference_type = std::ptrdiff_t;
+
+			iterator( ) = default;
+
+			explicit iterator( state_t *st ) noexcept
+			  : m_st( st and st->tree->top( ) ? st : nullptr ) {}
+
+			[[nodiscard]] reference operator*( ) const noexcept {
+				return *m_st->tree->top( );
+			}
+
+			[[nodiscard]] pointer operator->( ) const noexcept {
+				return m_st->tree->top( );
+			}
+
+			iterator &operator++( ) {
+				m_st->tree->pop( );
+				if( not m_st->tree->top( ) ) {
+					m_st = nullptr;
+				}
+				return *this;
+			}
+
+			iterator operator++( int ) {
+				auto result = *this;
+				operator++( );
+				return result;
+			}
+
+			[[nodiscard]] friend bool operator==( iterator const &lhs,
+			                                      iterator const &rhs ) noexcept {
+				return lhs.m_st == rhs.m_st;
+			}
+
+			[[nodiscard]] friend bool operator!=( iterator const &lhs,
+			                                      iterator const &rhs ) noexcept {
+				return lhs.m_st != rhs.m_st;
+			}
+		};
+		using const_iterator = iterator;
+
+		external_merge_view( ) = default;
+
+		/// Iteration consumes the runs, begin( ) continues from the current
+		/// position
+		[[nodiscard]] iterator begin( ) const noexcept {
+			return iterator( m_state.get( ) );
+		}
+
+		[[nodiscard]] iterator end( ) const noexcept {
+			return iterator( );
+		}
+
+		/// The total number of records in all runs
+		[[nodiscard]] size_type size( ) const noexcept {
+			return m_state ? m_state->size : 0;
+		}
+
+		/// The number of runs being merged
+		[[nodiscard]] size_type run_count( ) const noexcept {
+			return m_state ? m_state->sources.size( ) : 0;
+		}
+	};
+
+	/// Sorts more records than fit in memory.  Records are collected into runs
+	/// of options.run_bytes that are sorted with daw::sort and written to
+	/// temporary files.  finish( ) k-way merges them with a loser tree.  The
+	/// last run is merged from memory instead of being written
+	template<typename T, typename Compare = std::less<>>
+	class external_sorter {
+		static_assert( std::is_trivially_copyable_v<T>,
+		               "External sorting requires fixed width, trivially "
+		               "copyable records" );
+
+		external_sort_options m_opts;
+		Compare m_comp;
+		std::size_t m_run_capacity;
+		std::vector<T> m_buffer{ };
+		std::filesystem::path m_prefix{ };
+		std::vector<external_sort_details::temp_file> m_files{ };
+		std::vector<std::size_t> m_counts{ };
+
+		void write_run( ) {
+			daw::sort( m_buffer.begin( ), m_buffer.end( ), m_comp );
+			if( m_prefix.empty( ) ) {
+				m_prefix = external_sort_details::make_run_prefix( m_opts );
+			}
+			auto file = external_sort_details::temp_file(
+			  m_prefix.string( ) + std::to_string( m_files.size( ) ) );
+			if( m_opts.io == external_sort_io::memory_mapped ) {
+				// Size the file, then copy the run into the mapping
+				external_sort_details::open_file( file.path( ), "wb" ).reset( );
+				std::filesystem::resize_file( file.path( ),
+				                              m_buffer.size( ) * sizeof( T ) );
+				auto out = filesystem::memory_mapped_file_t<char>(
+				  file.path( ).string( ), filesystem::open_mode::read_write );
+				if( not out ) {
+					DAW_THROW_OR_TERMINATE( std::runtime_error,
+					                        "Unable to map " + file.path( ).string( ) );
+				}
+				std::memcpy( out.data( ), m_buffer.data( ),
+				             m_buffer.size( ) * sizeof( T ) );
+			} else {
+				auto f = external_sort_details::open_file( file.path( ), "wb" );
+				external_sort_details::write_records( f.get( ), m_buffer.data( ),
+				                                      m_buffer.size( ) );
+				if( std::fflush( f.get( ) ) != 0 ) {
+					DAW_THROW_OR_TERMINATE( std::runtime_error,
+					                        "Error writing sorted records" );
+				}
+			}
+			m_files.push_back( std::move( file ) );
+			m_counts.push_back( m_buffer.size( ) );
+			m_buffer.clear( );
+		}
+
+	public:
+		explicit external_sorter( external_sort_options opts = { },
+		                          Compare comp = Compare{ } )
+		  : m_opts( std::move( opts ) )
+		  , m_comp( std::move( comp ) )
+		  , m_run_capacity(
+		      std::max<std::size_t>( m_opts.run_bytes / sizeof( T ), 1 ) ) {
+			m_buffer.reserve( m_run_capacity );
+		}
+
+		void push_back( T const &value ) {
+			m_buffer.push_back( value );
+			if( m_buffer.size( ) == m_run_capacity ) {
+				write_run( );
+			}
+		}
+
+		template<typename Iterator>
+		void append( Iterator first, Iterator last ) {
+			while( first != last ) {
+				if constexpr( std::is_base_of_v<
+				                std::random_access_iterator_tag,
+				                typename std::iterator_traits<
+				                  Iterator>::iterator_category> ) {
+					auto const room =
+					  static_cast<std::ptrdiff_t>( m_run_capacity - m_buffer.size( ) );
+					auto const mid = std::distance( first, last ) > room
+					                   ? std::next( first, room )
+					                   : last;
+					m_buffer.insert( m_buffer.end( ), first, mid );
+					first = mid;
+					if( m_buffer.size( ) == m_run_capacity ) {
+						write_run( );
+					}
+				} else {
+					push_back( *first );
+					++first;
+				}
+			}
+		}
+
+		/// The number of runs written to disk so far
+		[[nodiscard]] std::size_t runs_written( ) const noexcept {
+			return m_files.size( );
+		}
+
+		/// Sort the final run and start merging.  The sorter is left empty
+		[[nodiscard]] external_merge_view<T, Compare> finish( ) {
+			daw::sort( m_buffer.begin( ), m_buffer.end( ), m_comp );
+			auto memory_run = std::exchange( m_buffer, { } );
+			memory_run.shrink_to_fit( );
+			return external_merge_view<T, Compare>(
+			  std::exchange( m_files, { } ), std::exchange( m_counts, { } ),
+			  std::move( memory_run ), m_opts, m_comp );
+		}
+	};
+
+	/// Sort the fixed width records of type T in the file input into the file
+	/// output.  Returns the number of records sorted
+	template<typename T, typename Compare = std::less<>>
+	std::size_t external_sort_file( std::filesystem::path const &input,
+	                                std::filesystem::path const &output,
+	                                external_sort_options const &opts = { },
+	                                Compare const &comp = Compare{ } ) {
+		auto sorter = external_sorter<T, Compare>( opts, comp );
+		auto const block =
+		  std::max<std::size_t>( opts.block_bytes / sizeof( T ), 1 );
+		auto buffer = std::vector<T>( block );
+		{
+			auto in = external_sort_details::open_file( input, "rb" );
+			while( true ) {
+				auto const count =
+				  std::fread( buffer.data( ), sizeof( T ), buffer.size( ), in.get( ) );
+				sorter.append( buffer.data( ), buffer.data( ) + count );
+				if( count < buffer.size( ) ) {
+					if( std::ferror( in.get( ) ) ) {
+						DAW_THROW_OR_TERMINATE( std::runtime_error,
+						                        "Error reading " + input.string( ) );
+					}
+					break;
+				}
+			}
+		}
+		auto merged = sorter.finish( );
+		auto out = external_sort_details::open_file( output, "wb" );
+		buffer.clear( );
+		for( auto const &v : merged ) {
+			buffer.push_back( v );
+			if( buffer.size( ) == block ) {
+				external_sort_details::write_records( out.get( ), buffer.data( ),
+				                                      buffer.size( ) );
+				buffer.clear( );
+			}
+		}
+		external_sort_details::write_records( out.get( ), buffer.data( ),
+		                                      buffer.size( ) );
+		if( std::fflush( out.get( ) ) != 0 ) {
+			DAW_THROW_OR_TERMINATE( std::runtime_error,
+			                        "Error writing " + output.string( ) );
+		}
+		return merged.size( );
+	}
+} // namespace daw
@@ -0,0 +1,658 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/daw_attributes.h"
+#include "daw/daw_exception.h"
+#include "daw/daw_move.h"
+#include "daw/daw_scope_guard.h"
+#include "daw/daw_sort_n.h"
+#include "daw/impl/daw_flat_search.h"
+#include "daw/vector.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace daw {
+	namespace flat_impl {
+		template<typename Reference>
+		struct arrow_proxy {
+			Reference ref;
+
+			[[nodiscard]] constexpr Reference *operator->( ) noexcept {
+				return &ref;
+			}
+		};
+
+		/// Iterates the parallel key and mapped containers of a flat_map.  The
+		/// reference is a pair of references into the two containers.
+		template<typename Key, typename Mapped>
+		class flat_map_iterator {
+			Key const *m_key = nullptr;
+			Mapped *m_value = nullptr;
+
+			template<typename, typename>
+			friend class flat_map_iterator;
+
+		public:
+			using iterator_category = std::random_access_iterator_tag;
+			using value_type = std::pair<Key, std::remove_const_t<Mapped>>;
+			using reference = std::pair<Key const &, Mapped &>;
+			using pointer = arrow_proxy<reference>;
+			using difference_type = std::ptrdiff_t;
+
+			flat_map_iterator( ) = default;
+
+			explicit constexpr flat_map_iterator( Key const *k, Mapped *v ) noexcept
+			  : m_key( k )
+			  , m_value( v ) {}
+
+			template<typename M,
+			         std::enable_if_t<std::is_convertible_v<M *, Mapped *> and
+			                            not std::is_same_v<M, Mapped>,
+			                          std::nullptr_t> = nullptr>
+			constexpr flat_map_iterator(
+			  flat_map_iterator<Key, M> const &other ) noexcept
+			  : m_key( other.m_key )
+			  , m_value( other.m_value ) {}
+
+			[[nodiscard]] constexpr reference operator*( ) const noexcept {
+				return reference( *m_key, *m_value );
+			}
+
+			[[nodiscard]] constexpr pointer operator->( ) const noexcept {
+				return pointer{ **this };
+			}
+
+			[[nodiscard]] constexpr reference
+			operator[]( difference_type n ) const noexcept {
+				return *( *this + n );
+			}
+
+			[[nodiscard]] constexpr Key const &key( ) const noexcept {
+				return *m_key;
+			}
+
+			[[nodiscard]] constexpr Mapped &value( ) const noexcept {
+				return *m_value;
+			}
+
+			constexpr flat_map_iterator &operator++( ) noexcept {
+				++m_key;
+				++m_value;
+				return *this;
+			}
+
+			constexpr flat_map_iterator operator++( int ) noexcept {
+				auto result = *this;
+				++*this;
+				return result;
+			}
+
+			constexpr flat_map_iterator &operator--( ) noexcept {
+				--m_key;
+				--m_value;
+				return *this;
+			}
+
+			constexpr flat_map_iterator operator--( int ) noexcept {
+				auto result = *this;
+				--*this;
+				return result;
+			}
+
+			constexpr flat_map_iterator &operator+=( difference_type n ) noexcept {
+				m_key += n;
+				m_value += n;
+				return *this;
+			}
+
+			constexpr flat_map_iterator &operator-=( difference_type n ) noexcept {
+				m_key -= n;
+				m_value -= n;
+				return *this;
+			}
+
+			[[nodiscard]] friend constexpr flat_map_iterator
+			operator+( flat_map_iterator it, difference_type n ) noexcept {
+				return it += n;
+			}
+
+			[[nodiscard]] friend constexpr flat_map_iterator
+			operator+( difference_type n, flat_map_iterator it ) noexcept {
+				return it += n;
+			}
+
+			[[nodiscard]] friend constexpr flat_map_iterator
+			operator-( flat_map_iterator it, difference_type n ) noexcept {
+				return it -= n;
+			}
+
+			[[nodiscard]] friend constexpr difference_type
+			operator-( flat_map_iterator const &l,
+			           flat_map_iterator const &r ) noexcept {
+				return l.m_key - r.m_key;
+			}
+
+			[[nodiscard]] friend constexpr bool
+			operator==( flat_map_iterator const &l,
+			            flat_map_iterator const &r ) noexcept {
+				return l.m_key == r.m_key;
+			}
+
+			[[nodiscard]] friend constexpr bool
+			operator!=( flat_map_iterator const &l,
+			            flat_map_iterator const &r ) noexcept {
+				return l.m_key != r.m_key;
+			}
+
+			[[nodiscard]] friend constexpr bool
+			operator<( flat_map_iterator const &l,
+			           flat_map_iterator const &r ) noexcept {
+				return l.m_key < r.m_key;
+			}
+
+			[[nodiscard]] friend constexpr bool
+			operator>( flat_map_iterator const &l,
+			           flat_map_iterator const &r ) noexcept {
+				return r < l;
+			}
+
+			[[nodiscard]] friend constexpr bool
+			operator<=( flat_map_iterator const &l,
+			            flat_map_iterator const &r ) noexcept {
+				return not( r < l );
+			}
+
+			[[nodiscard]] friend constexpr bool
+			operator>=( flat_map_iterator const &l,
+			            flat_map_iterator const &r ) noexcept {
+				return not( l < r );
+			}
+		};
+	} // namespace flat_impl
+
+	/// A map stored as a sorted container of unique keys and a parallel
+	/// container of mapped values.  Keeping the keys apart lets lookups run
+	/// branchless or SIMD searches over densely packed keys.  Ranges are
+	/// inserted in bulk: they are sorted on their own and merged with the
+	/// existing elements in one backward pass, instead of one O(n) insert per
+	/// element.
+	template<typename Key, typename T, typename Compare = std::less<Key>,
+	         typename KeyContainer = daw::vector<Key>,
+	         typename MappedContainer = daw::vector<T>,
+	         flat_search Search = flat_search::automatic>
+	class flat_map {
+	public:
+		using key_type = Key;
+		using mapped_type = T;
+		using value_type = std::pair<Key, T>;
+		using key_compare = Compare;
+		using reference = std::pair<Key const &, T &>;
+		using const_reference = std::pair<Key const &, T const &>;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using iterator = flat_impl::flat_map_iterator<Key, T>;
+		using const_iterator = flat_impl::flat_map_iterator<Key, T const>;
+		using reverse_iterator = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+		using key_container_type = KeyContainer;
+		using mapped_container_type = MappedContainer;
+
+		struct containers {
+			KeyContainer keys;
+			MappedContainer values;
+		};
+
+	private:
+		KeyContainer m_keys{ };
+		MappedContainer m_values{ };
+		DAW_NO_UNIQUE_ADDRESS Compare m_compare{ };
+
+		template<typename K>
+		[[nodiscard]] constexpr size_type lower_bound_index( K const &key ) const {
+			return flat_impl::lower_bound_index<Search>(
+			  m_keys.data( ), m_keys.size( ), key, m_compare );
+		}
+
+		template<typename K>
+		[[nodiscard]] constexpr size_type upper_bound_index( K const &key ) const {
+			auto not_after = [&]( Key const &e, K const &k ) {
+				return not m_compare( k, e );
+			};
+			return flat_impl::branchless_lower_bound( m_keys.data( ), m_keys.size( ),
+			                                          key, not_after );
+		}
+
+		template<typename K>
+		[[nodiscard]] constexpr bool found( size_type idx, K const &key ) const {
+			return idx < m_keys.size( ) and not m_compare( key, m_keys[idx] );
+		}
+
+		[[nodiscard]] constexpr iterator make_iter( size_type idx ) noexcept {
+			return iterator( m_keys.data( ) + idx, m_values.data( ) + idx );
+		}
+
+		[[nodiscard]] constexpr const_iterator
+		make_iter( size_type idx ) const noexcept {
+			return const_iterator( m_keys.data( ) + idx, m_values.data( ) + idx );
+		}
+
+		[[nodiscard]] constexpr size_type index_of( const_iterator it ) const {
+			return static_cast<size_type>( &it.key( ) - m_keys.data( ) );
+		}
+
+		template<typename... Args>
+		constexpr iterator emplace_at( size_type idx, Key const &key,
+		                               Args &&...args ) {
+			auto const pos = static_cast<difference_type>( idx );
+			// Copy the key before touching either container, a throwing copy in
+			// the middle of the insert would leave m_keys one element longer
+			auto k = Key( key );
+			(void)m_keys.insert( m_keys.begin( ) + pos, std::move( k ) );
+			// Keep the containers the same size when building the value throws
+			auto undo_key = daw::on_scope_exit( [&] {
+				(void)m_keys.erase( m_keys.begin( ) + pos );
+			} );
+			(void)m_values.emplace( m_values.begin( ) + pos, DAW_FWD( args )... );
+			undo_key.cancel( );
+			return make_iter( idx );
+		}
+
+		/// Merge the sorted, unique new elements in tail into the map.  Keys that
+		/// are already present keep their value.  The tail is filtered, the
+		/// containers grow by what is left, and a backward merge fills the
+		/// containers from the end so nothing is moved twice.
+		constexpr void merge_sorted( daw::vector<value_type> &tail ) {
+			auto const old_size = size( );
+			// Drop the keys that are already present
+			auto out = tail.begin( );
+			size_type start = 0;
+			for( auto it = tail.begin( ); it != tail.end( ); ++it ) {
+				start += flat_impl::lower_bound_index<Search>(
+				  m_keys.data( ) + start, old_size - start, it->first, m_compare );
+				if( not found( start, it->first ) ) {
+					if( out != it ) {
+						*out = std::move( *it );
+					}
+					++out;
+				}
+			}
+			tail.erase( out, tail.end( ) );
+			if( tail.empty( ) ) {
+				return;
+			}
+			// Grow by the new elements, then swap them back out so that the tail
+			// holds them and the new slots at the end can be overwritten
+			m_keys.reserve( old_size + tail.size( ) );
+			m_values.reserve( old_size + tail.size( ) );
+			for( auto &v : tail ) {
+				m_keys.push_back( std::move( v.first ) );
+				m_values.push_back( std::move( v.second ) );
+			}
+			using std::swap;
+			for( size_type n = 0; n < tail.size( ); ++n ) {
+				swap( m_keys[old_size + n], tail[n].first );
+				swap( m_values[old_size + n], tail[n].second );
+			}
+			auto i = old_size;
+			auto j = tail.size( );
+			auto w = old_size + j;
+			while( j > 0 ) {
+				--w;
+				if( i > 0 and m_compare( tail[j - 1U].first, m_keys[i - 1U] ) ) {
+					--i;
+					m_keys[w] = std::move( m_keys[i] );
+					m_values[w] = std::move( m_values[i] );
+				} else {
+					--j;
+					m_keys[w] = std::move( tail[j].first );
+					m_values[w] = std::move( tail[j].second );
+				}
+			}
+		}
+
+		constexpr void sort_unique( daw::vector<value_type> &tail ) {
+			auto const key_less = [&]( value_type const &l, value_type const &r ) {
+				return m_compare( l.first, r.first );
+			};
+			daw::sort( tail.begin( ), tail.end( ), key_less );
+			tail.erase( std::unique( tail.begin( ), tail.end( ),
+			                         [&]( value_type const &l, value_type const &r ) {
+				                         return not key_less( l, r ) and
+				                                not key_less( r, l );
+			                         } ),
+			            tail.end( ) );
+		}
+
+	public:
+		flat_map( ) = default;
+
+		explicit constexpr flat_map( Compare const &comp )
+		  : m_compare( comp ) {}
+
+		/// Sorts by key and removes duplicate keys
+		/// @pre keys.size( ) == values.size( )
+		constexpr flat_map( KeyContainer keys, MappedContainer values,
+		                    Compare const &comp = Compare( ) )
+		  : m_compare( comp ) {
+			auto tail = daw::vector<value_type>( );
+			tail.reserve( keys.size( ) );
+			for( size_type n = 0; n < keys.size( ); ++n ) {
+				tail.emplace_back( std::move( keys[n] ), std::move( values[n] ) );
+			}
+			sort_unique( tail );
+			merge_sorted( tail );
+		}
+
+		/// @pre keys is sorted by comp, has no duplicates and
+		/// keys.size( ) == values.size( )
+		constexpr flat_map( sorted_unique_t, KeyContainer keys,
+		                    MappedContainer values, Compare const &comp = Compare( ) )
+		  : m_keys( std::move( keys ) )
+		  , m_values( std::move( values ) )
+		  , m_compare( comp ) {}
+
+		template<typename InputIterator>
+		constexpr flat_map( InputIterator first, InputIterator last,
+		                    Compare const &comp = Compare( ) )
+		  : m_compare( comp ) {
+			insert( first, last );
+		}
+
+		constexpr flat_map( std::initializer_list<value_type> il,
+		                    Compare const &comp = Compare( ) )
+		  : flat_map( il.begin( ), il.end( ), comp ) {}
+
+		[[nodiscard]] constexpr iterator begin( ) noexcept {
+			return make_iter( 0 );
+		}
+
+		[[nodiscard]] constexpr const_iterator begin( ) const noexcept {
+			return make_iter( 0 );
+		}
+
+		[[nodiscard]] constexpr iterator end( ) noexcept {
+			return make_iter( size( ) );
+		}
+
+		[[nodiscard]] constexpr const_iterator end( ) const noexcept {
+			return make_iter( size( ) );
+		}
+
+		[[nodiscard]] constexpr const_iterator cbegin( ) const noexcept {
+			return begin( );
+		}
+
+		[[nodiscard]] constexpr const_iterator cend( ) const noexcept {
+			return end( );
+		}
+
+		[[nodiscard]] constexpr reverse_iterator rbegin( ) noexcept {
+			return reverse_iterator( end( ) );
+		}
+
+		[[nodiscard]] constexpr const_reverse_iterator rbegin( ) const noexcept {
+			return const_reverse_iterator( end( ) );
+		}
+
+		[[nodiscard]] constexpr reverse_iterator rend( ) noexcept {
+			return reverse_iterator( begin( ) );
+		}
+
+		[[nodiscard]] constexpr const_reverse_iterator rend( ) const noexcept {
+			return const_reverse_iterator( begin( ) );
+		}
+
+		[[nodiscard]] constexpr size_type size( ) const noexcept {
+			return m_keys.size( );
+		}
+
+		[[nodiscard]] constexpr bool empty( ) const noexcept {
+			return m_keys.empty( );
+		}
+
+		[[nodiscard]] constexpr key_compare key_comp( ) const {
+			return m_compare;
+		}
+
+		[[nodiscard]] constexpr KeyContainer const &keys( ) const noexcept {
+			return m_keys;
+		}
+
+		[[nodiscard]] constexpr MappedContainer const &values( ) const noexcept {
+			return m_values;
+		}
+
+		/// Move the containers out, leaving the map empty
+		[[nodiscard]] constexpr containers extract( ) && {
+			return containers{ std::move( m_keys ), std::move( m_values ) };
+		}
+
+		constexpr void reserve( size_type n ) {
+			m_keys.reserve( n );
+			m_values.reserve( n );
+		}
+
+		constexpr void clear( ) noexcept {
+			m_keys.clear( );
+			m_values.clear( );
+		}
+
+		/// Insert a value constructed from args when key is not present
+		template<typename... Args>
+		constexpr std::pair<iterator, bool> try_emplace( Key const &key,
+		                                                 Args &&...args ) {
+			auto const idx = lower_bound_index( key );
+			if( found( idx, key ) ) {
+				return { make_iter( idx ), false };
+			}
+			return { emplace_at( idx, key, DAW_FWD( args )... ), true };
+		}
+
+		constexpr std::pair<iterator, bool> insert( value_type const &v ) {
+			return try_emplace( v.first, v.second );
+		}
+
+		constexpr std::pair<iterator, bool> insert( value_type &&v ) {
+			return try_emplace( v.first, std::move( v.second ) );
+		}
+
+		template<typename M>
+		constexpr std::pair<iterator, bool> insert_or_assign( Key const &key,
+		                                                      M &&obj ) {
+			auto const idx = lower_bound_index( key );
+			if( found( idx, key ) ) {
+				m_values[idx] = DAW_FWD( obj );
+				return { make_iter( idx ), false };
+			}
+			return { emplace_at( idx, key, DAW_FWD( obj ) ), true };
+		}
+
+		/// Sort [first, last) on its own and merge it into the map.  Of the
+		/// elements with equivalent keys only one is inserted, and keys that are
+		/// present keep their value.
+		template<typename InputIterator>
+		constexpr void insert( InputIterator first, InputIterator last ) {
+			auto tail = daw::vector<value_type>( first, last );
+			sort_unique( tail );
+			merge_sorted( tail );
+		}
+
+		/// @pre [first, last) is sorted and has no duplicate keys
+		template<typename InputIterator>
+		constexpr void insert( sorted_unique_t, InputIterator first,
+		                       InputIterator last ) {
+			auto tail = daw::vector<value_type>( first, last );
+			merge_sorted( tail );
+		}
+
+		constexpr void insert( std::initializer_list<value_type> il ) {
+			insert( il.begin( ), il.end( ) );
+		}
+
+		[[nodiscard]] constexpr T &operator[]( Key const &key ) {
+			return try_emplace( key ).first.value( );
+		}
+
+		[[nodiscard]] constexpr T &at( Key const &key ) {
+			auto const idx = lower_bound_index( key );
+			if( not found( idx, key ) ) {
+				daw::exception::throw_out_of_range( "flat_map" );
+			}
+			return m_values[idx];
+		}
+
+		[[nodiscard]] constexpr T const &at( Key const &key ) const {
+			auto const idx = lower_bound_index( key );
+			if( not found( idx, key ) ) {
+				daw::exception::throw_out_of_range( "flat_map" );
+			}
+			return m_values[idx];
+		}
+
+		constexpr iterator erase( const_iterator pos ) {
+			auto const idx = index_of( pos );
+			auto const offset = static_cast<difference_type>( idx );
+			(void)m_keys.erase( m_keys.begin( ) + offset );
+			(void)m_values.erase( m_values.begin( ) + offset );
+			return make_iter( idx );
+		}
+
+		constexpr size_type erase( Key const &key ) {
+			auto const idx = lower_bound_index( key );
+			if( not found( idx, key ) ) {
+				return 0;
+			}
+			(void)erase( make_iter( idx ) );
+			return 1;
+		}
+
+		[[nodiscard]] constexpr iterator lower_bound( Key const &key ) {
+			return make_iter( lower_bound_index( key ) );
+		}
+
+		template<typename K, typename C = Compare,
+		         std::enable_if_t<flat_impl::is_transparent_v<C>, std::nullptr_t> =
+		           nullptr>
+		[[nodiscard]] constexpr iterator lower_bound( K const &key ) {
+			return make_iter( lower_bound_index( key ) );
+		}
+
+		[[nodiscard]] constexpr const_iterator lower_bound( Key const &key ) const {
+			return make_iter( lower_bound_index( key ) );
+		}
+
+		template<typename K, typename C = Compare,
+		         std::enable_if_t<flat_impl::is_transparent_v<C>, std::nullptr_t> =
+		           nullptr>
+		[[nodiscard]] constexpr const_iterator lower_bound( K const &key ) const {
+			return make_iter( lower_bound_index( key ) );
+		}
+
+		[[nodiscard]] constexpr iterator upper_bound( Key const &key ) {
+			return make_iter( upper_bound_index( key ) );
+		}
+
+		template<typename K, typename C = Compare,
+		         std::enable_if_t<flat_impl::is_transparent_v<C>, std::nullptr_t> =
+		           nullptr>
+		[[nodiscard]] constexpr iterator upper_bound( K const &key ) {
+			return make_iter( upper_bound_index( key ) );
+		}
+
+		[[nodiscard]] constexpr const_iterator upper_bound( Key const &key ) const {
+			return make_iter( upper_bound_index( key ) );
+		}
+
+		template<typename K, typename C = Compare,
+		         std::enable_if_t<flat_impl::is_transparent_v<C>, std::nullptr_t> =
+		           nullptr>
+		[[nodiscard]] constexpr const_iterator upper_bound( K const &key ) const {
+			return make_iter( upper_bound_index( key ) );
+		}
+
+		[[nodiscard]] constexpr std::pair<const_iterator, const_iterator>
+		equal_range( Key const &key ) const {
+			return { lower_bound( key ), upper_bound( key ) };
+		}
+
+		template<typename K, typename C = Compare,
+		         std::enable_if_t<flat_impl::is_transparent_v<C>, std::nullptr_t> =
+		           nullptr>
+		[[nodiscard]] constexpr std::pair<const_iterator, const_iterator>
+		equal_range( K const &key ) const {
+			return { lower_bound( key ), upper_bound( key ) };
+		}
+
+		[[nodiscard]] constexpr iterator find( Key const &key ) {
+			auto const idx = lower_bound_index( key );
+			return found( idx, key ) ? make_iter( idx ) : end( );
+		}
+
+		template<typename K, typename C = Compare,
+		         std::enable_if_t<flat_impl::is_transparent_v<C>, std::nullptr_t> =
+		           nullptr>
+		[[nodiscard]] constexpr iterator find( K const &key ) {
+			auto const idx = lower_bound_index( key );
+			return found( idx, key ) ? make_iter( idx ) : end( );
+		}
+
+		[[nodiscard]] constexpr const_iterator find( Key const &key ) const {
+			auto const idx = lower_bound_index( key );
+			return found( idx, key ) ? make_iter( idx ) : end( );
+		}
+
+		template<typename K, typename C = Compare,
+		         std::enable_if_t<flat_impl::is_transparent_v<C>, std::nullptr_t> =
+		           nullptr>
+		[[nodiscard]] constexpr const_iterator find( K const &key ) const {
+			auto const idx = lower_bound_index( key );
+			return found( idx, key ) ? make_iter( idx ) : end( );
+		}
+
+		[[nodiscard]] constexpr bool contains( Key const &key ) const {
+			return found( lower_bound_index( key ), key );
+		}
+
+		template<typename K, typename C = Compare,
+		         std::enable_if_t<flat_impl::is_transparent_v<C>, std::nullptr_t> =
+		           nullptr>
+		[[nodiscard]] constexpr bool contains( K const &key ) const {
+			return found( lower_bound_index( key ), key );
+		}
+
+		[[nodiscard]] constexpr size_type count( Key const &key ) const {
+			return static_cast<size_type>( contains( key ) );
+		}
+
+		template<typename K, typename C = Compare,
+		         std::enable_if_t<flat_impl::is_transparent_v<C>, std::nullptr_t> =
+		           nullptr>
+		[[nodiscard]] constexpr size_type count( K const &key ) const {
+			return static_cast<size_type>( contains( key ) );
+		}
+
+		[[nodiscard]] friend constexpr bool operator==( flat_map const &lhs,
+		                                                flat_map const &rhs ) {
+			return lhs.m_keys == rhs.m_keys and lhs.m_values == rhs.m_values;
+		}
+
+		[[nodiscard]] friend constexpr bool operator!=( flat_map const &lhs,
+		                                                flat_map const &rhs ) {
+			return not( lhs == rhs );
+		}
+	};
+} // namespace daw
@@ -0,0 +1,308 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/daw_attributes.h"
+#include "daw/daw_move.h"
+#include "daw/daw_sort_n.h"
+#include "daw/impl/daw_flat_search.h"
+#include "daw/vector.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace daw {
+	/// A set stored as a sorted contiguous container of unique keys.  Lookups
+	/// are branchless or SIMD searches over contiguous keys, and ranges are
+	/// inserted in bulk by appending, sorting the new tail and merging it in
+	/// place, instead of one O(n) insert per key.
+	template<typename Key, typename Compare = std::less<Key>,
+	         typename KeyContainer = daw::vector<Key>,
+	         flat_search Search = flat_search::automatic>
+	class flat_set {
+	public:
+		using key_type = Key;
+		using value_type = Key;
+		using key_compare = Compare;
+		using value_compare = Compare;
+		using container_type = KeyContainer;
+		using size_type = typename KeyContainer::size_type;
+		using difference_type = typename KeyContainer::difference_type;
+		using reference = value_type const &;
+		using const_reference = value_type const &;
+		using iterator = typename KeyContainer::const_iterator;
+		using const_iterator = typename KeyContainer::const_iterator;
+		using reverse_iterator = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+	private:
+		KeyContainer m_keys{ };
+		DAW_NO_UNIQUE_ADDRESS Compare m_compare{ };
+
+		[[nodiscard]] constexpr bool equivalent( Key const &l,
+		                                         Key const &r ) const {
+			return not m_compare( l, r ) and not m_compare( r, l );
+		}
+
+		template<typename K>
+		[[nodiscard]] constexpr size_type lower_bound_index( K const &key ) const {
+			return flat_impl::lower_bound_index<Search>(
+			  m_keys.data( ), m_keys.size( ), key, m_compare );
+		}
+
+		template<typename K>
+		[[nodiscard]] constexpr size_type upper_bound_index( K const &key ) const {
+			auto not_after = [&]( Key const &e, K const &k ) {
+				return not m_compare( k, e );
+			};
+			return flat_impl::branchless_lower_bound( m_keys.data( ), m_keys.size( ),
+			                                          key, not_after );
+		}
+
+		template<typename K>
+		[[nodiscard]] constexpr bool found( size_type idx, K const &key ) const {
+			return idx < m_keys.size( ) and not m_compare( key, m_keys[idx] );
+		}
+
+		/// Merge the keys appended after old_size into the sorted keys before it
+		constexpr void merge_tail( size_type old_size, bool tail_sorted ) {
+			auto const first = m_keys.begin( );
+			auto const mid = first + static_cast<difference_type>( old_size );
+			if( not tail_sorted ) {
+				daw::sort( mid, m_keys.end( ), m_compare );
+			}
+			if( old_size != 0 and mid != m_keys.end( ) and
+			    m_compare( *mid, *std::prev( mid ) ) ) {
+				std::inplace_merge( first, mid, m_keys.end( ), m_compare );
+			}
+			// inplace_merge is stable, of equivalent keys the oldest is kept
+			m_keys.erase(
+			  std::unique( m_keys.begin( ), m_keys.end( ),
+			               [&]( Key const &l, Key const &r ) {
+				               return equivalent( l, r );
+			               } ),
+			  m_keys.end( ) );
+		}
+
+	public:
+		flat_set( ) = default;
+
+		explicit constexpr flat_set( Compare const &comp )
+		  : m_compare( comp ) {}
+
+		/// Sorts keys and removes duplicates
+		explicit constexpr flat_set( KeyContainer keys,
+		                             Compare const &comp = Compare( ) )
+		  : m_keys( std::move( keys ) )
+		  , m_compare( comp ) {
+			merge_tail( 0, false );
+		}
+
+		/// @pre keys is sorted by comp and has no duplicates
+		constexpr flat_set( sorted_unique_t, KeyContainer keys,
+		                    Compare const &comp = Compare( ) )
+		  : m_keys( std::move( keys ) )
+		  , m_compare( comp ) {}
+
+		template<typename InputIterator>
+		constexpr flat_set( InputIterator first, InputIterator last,
+		                    Compare const &comp = Compare( ) )
+		  : m_compare( comp ) {
+			insert( first, last );
+		}
+
+		constexpr flat_set( std::initializer_list<Key> il,
+		                    Compare const &comp = Compare( ) )
+		  : flat_set( il.begin( ), il.end( ), comp ) {}
+
+		[[nodiscard]] constexpr const_iterator begin( ) const noexcept {
+			return m_keys.begin( );
+		}
+
+		[[nodiscard]] constexpr const_iterator end( ) const noexcept {
+			return m_keys.end( );
+		}
+
+		[[nodiscard]] constexpr const_iterator cbegin( ) const noexcept {
+			return m_keys.begin( );
+		}
+
+		[[nodiscard]] constexpr const_iterator cend( ) const noexcept {
+			return m_keys.end( );
+		}
+
+		[[nodiscard]] constexpr const_reverse_iterator rbegin( ) const noexcept {
+			return const_reverse_iterator( end( ) );
+		}
+
+		[[nodiscard]] constexpr const_reverse_iterator rend( ) const noexcept {
+			return const_reverse_iterator( begin( ) );
+		}
+
+		[[nodiscard]] constexpr size_type size( ) const noexcept {
+			return m_keys.size( );
+		}
+
+		[[nodiscard]] constexpr bool empty( ) const noexcept {
+			return m_keys.empty( );
+		}
+
+		[[nodiscard]] constexpr key_compare key_comp( ) const {
+			return m_compare;
+		}
+
+		[[nodiscard]] constexpr KeyContainer const &keys( ) const noexcept {
+			return m_keys;
+		}
+
+		/// Move the keys out, leaving the set empty
+		[[nodiscard]] constexpr KeyContainer extract( ) && {
+			return std::move( m_keys );
+		}
+
+		constexpr void reserve( size_type n ) {
+			m_keys.reserve( n );
+		}
+
+		constexpr void clear( ) noexcept {
+			m_keys.clear( );
+		}
+
+		template<typename K = Key>
+		constexpr std::pair<iterator, bool> insert( K &&key ) {
+			auto const idx = lower_bound_index( key );
+			auto pos = begin( ) + static_cast<difference_type>( idx );
+			if( found( idx, key ) ) {
+				return { pos, false };
+			}
+			return { m_keys.insert( pos, DAW_FWD( key ) ), true };
+		}
+
+		/// Append [first, last), sort it and merge it into the set
+		template<typename InputIterator>
+		constexpr void insert( InputIterator first, InputIterator last ) {
+			auto const old_size = size( );
+			m_keys.insert( m_keys.end( ), first, last );
+			merge_tail( old_size, false );
+		}
+
+		/// @pre [first, last) is sorted and has no duplicates
+		template<typename InputIterator>
+		constexpr void insert( sorted_unique_t, InputIterator first,
+		                       InputIterator last ) {
+			auto const old_size = size( );
+			m_keys.insert( m_keys.end( ), first, last );
+			merge_tail( old_size, true );
+		}
+
+		constexpr void insert( std::initializer_list<Key> il ) {
+			insert( il.begin( ), il.end( ) );
+		}
+
+		constexpr iterator erase( const_iterator pos ) {
+			return m_keys.erase( pos );
+		}
+
+		constexpr size_type erase( Key const &key ) {
+			auto const idx = lower_bound_index( key );
+			if( not found( idx, key ) ) {
+				return 0;
+			}
+			(void)m_keys.erase( begin( ) + static_cast<difference_type>( idx ) );
+			return 1;
+		}
+
+		[[nodiscard]] constexpr const_iterator lower_bound( Key const &key ) const {
+			return begin( ) + static_cast<difference_type>( lower_bound_index( key ) );
+		}
+
+		template<typename K, typename C = Compare,
+		         std::enable_if_t<flat_impl::is_transparent_v<C>, std::nullptr_t> =
+		           nullptr>
+		[[nodiscard]] constexpr const_iterator lower_bound( K const &key ) const {
+			return begin( ) + static_cast<difference_type>( lower_bound_index( key ) );
+		}
+
+		[[nodiscard]] constexpr const_iterator upper_bound( Key const &key ) const {
+			return begin( ) + static_cast<difference_type>( upper_bound_index( key ) );
+		}
+
+		template<typename K, typename C = Compare,
+		         std::enable_if_t<flat_impl::is_transparent_v<C>, std::nullptr_t> =
+		           nullptr>
+		[[nodiscard]] constexpr const_iterator upper_bound( K const &key ) const {
+			return begin( ) + static_cast<difference_type>( upper_bound_index( key ) );
+		}
+
+		[[nodiscard]] constexpr std::pair<const_iterator, const_iterator>
+		equal_range( Key const &key ) const {
+			return { lower_bound( key ), upper_bound( key ) };
+		}
+
+		template<typename K, typename C = Compare,
+		         std::enable_if_t<flat_impl::is_transparent_v<C>, std::nullptr_t> =
+		           nullptr>
+		[[nodiscard]] constexpr std::pair<const_iterator, const_iterator>
+		equal_range( K const &key ) const {
+			return { lower_bound( key ), upper_bound( key ) };
+		}
+
+		[[nodiscard]] constexpr const_iterator find( Key const &key ) const {
+			auto const idx = lower_bound_index( key );
+			return found( idx, key ) ? begin( ) + static_cast<difference_type>( idx )
+			                         : end( );
+		}
+
+		template<typename K, typename C = Compare,
+		         std::enable_if_t<flat_impl::is_transparent_v<C>, std::nullptr_t> =
+		           nullptr>
+		[[nodiscard]] constexpr const_iterator find( K const &key ) const {
+			auto const idx = lower_bound_index( key );
+			return found( idx, key ) ? begin( ) + static_cast<difference_type>( idx )
+			                         : end( );
+		}
+
+		[[nodiscard]] constexpr bool contains( Key const &key ) const {
+			return found( lower_bound_index( key ), key );
+		}
+
+		template<typename K, typename C = Compare,
+		         std::enable_if_t<flat_impl::is_transparent_v<C>, std::nullptr_t> =
+		           nullptr>
+		[[nodiscard]] constexpr bool contains( K const &key ) const {
+			return found( lower_bound_index( key ), key );
+		}
+
+		[[nodiscard]] constexpr size_type count( Key const &key ) const {
+			return static_cast<size_type>( contains( key ) );
+		}
+
+		template<typename K, typename C = Compare,
+		         std::enable_if_t<flat_impl::is_transparent_v<C>, std::nullptr_t> =
+		           nullptr>
+		[[nodiscard]] constexpr size_type count( K const &key ) const {
+			return static_cast<size_type>( contains( key ) );
+		}
+
+		[[nodiscard]] friend constexpr bool operator==( flat_set const &lhs,
+		                                                flat_set const &rhs ) {
+			return std::equal( lhs.begin( ), lhs.end( ), rhs.begin( ), rhs.end( ) );
+		}
+
+		[[nodiscard]] friend constexpr bool operator!=( flat_set const &lhs,
+		                                                flat_set const &rhs ) {
+			return not( lhs == rhs );
+		}
+	};
+} // namespace daw
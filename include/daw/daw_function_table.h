@@ -10,6 +10,8 @@
 
 #include "ciso646.h"
 #include "cpp_17.h"
+#include "daw_attributes.h"
+#include "daw_ensure.h"
 #include "daw_is_detected.h"
 #include "daw_move.h"
 #include "daw_traits.h"
@@ -19,8 +21,10 @@
 #include <cstddef>
 #include <cstdio>
 #include <cstdlib>
+#include <iterator>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 #include <variant>
 
 namespace daw {
@@ -100,6 +104,51 @@ namespace daw {
 			}
 			std::abort( );
 		} // namespace
+
+		/// Call a single table entry, the batch counterpart of apply_at_impl
+		template<typename R, bool allow_empty, typename Fn, typename... Args>
+		DAW_ATTRIB_INLINE constexpr R invoke_entry( Fn const &fn,
+		                                            Args &&...args ) {
+			if constexpr( std::is_invocable_v<Fn const &, Args...> ) {
+				return fn( DAW_FWD( args )... );
+			} else if constexpr( allow_empty and std::is_invocable_v<Fn const &> ) {
+				return fn( );
+			} else {
+				std::abort( );
+			}
+		}
+
+		/// Calls body( idx, first, last ) for each run [first, last) of equal
+		/// indices
+		template<typename Index, typename Body>
+		constexpr void for_each_run( Index const *indices, std::size_t count,
+		                             Body &&body ) {
+			std::size_t first = 0;
+			while( first < count ) {
+				Index const idx = indices[first];
+				std::size_t last = first + 1;
+				while( last < count and indices[last] == idx ) {
+					++last;
+				}
+				body( static_cast<std::size_t>( idx ), first, last );
+				first = last;
+			}
+		}
+
+		template<typename Tuple, typename Visitor, std::size_t... Is>
+		constexpr void visit_entry( std::size_t idx, Tuple const &tp,
+		                            Visitor &vis, std::index_sequence<Is...> ) {
+			bool const found =
+			  ( ( idx == Is ? ( vis( std::get<Is>( tp ) ), true ) : false ) or
+			    ... );
+			if( not found ) {
+				std::abort( );
+			}
+		}
+
+		/// Programs are split into chunks so that the depth of the handler call
+		/// chain stays bounded when tail calls are not optimized
+		inline constexpr std::size_t threaded_chunk_size = 256;
 	} // namespace function_table_impl
 
 	template<typename R, typename Function, typename... Functions>
@@ -132,6 +181,32 @@ namespace daw {
 			return call( idx, DAW_FWD( args )... );
 		}
 
+		/// @brief Calls fns[indices[n]]( arg_ranges[n]... ) for each n.  Runs of
+		/// equal indices are dispatched once and the target is then invoked over
+		/// the contiguous sub-batch, so long runs avoid a per call dispatch.
+		/// Each argument range must be random access and at least as long as
+		/// indices
+		template<bool allow_empty = false, typename Indices,
+		         typename... ArgRanges>
+		constexpr void call_batch( Indices const &indices,
+		                           ArgRanges &&...arg_ranges ) const {
+			(void)batch_impl<allow_empty, false>( indices, nullptr, arg_ranges... );
+		}
+
+		/// @brief As call_batch, but the result of each call is written to out
+		/// @return The output iterator past the last result
+		template<bool allow_empty = false, typename Indices,
+		         typename OutputIterator, typename... ArgRanges>
+		constexpr OutputIterator transform_batch( Indices const &indices,
+		                                          OutputIterator out,
+		                                          ArgRanges &&...arg_ranges ) const {
+			static_assert( not std::is_void_v<R>,
+			               "transform_batch requires a non-void result, use "
+			               "call_batch" );
+			return batch_impl<allow_empty, true>( indices, std::move( out ),
+			                                      arg_ranges... );
+		}
+
 		template<typename Value>
 		constexpr void set( size_t idx, Value &&v ) {
 			if constexpr( using_array_v ) {
@@ -144,6 +219,45 @@ namespace daw {
 		static constexpr size_t size( ) noexcept {
 			return sizeof...( Functions ) + 1U;
 		}
+
+	private:
+		template<bool allow_empty, bool has_output, typename Indices,
+		         typename OutputIterator, typename... ArgRanges>
+		constexpr OutputIterator batch_impl( Indices const &indices,
+		                                     OutputIterator out,
+		                                     ArgRanges &...arg_ranges ) const {
+			std::size_t const count = std::size( indices );
+			daw_dbg_ensure( ( ( std::size( arg_ranges ) >= count ) and ... ) );
+			function_table_impl::for_each_run(
+			  std::data( indices ), count,
+			  [&]( std::size_t idx, std::size_t first, std::size_t last ) {
+				  auto const run = [&]( auto const &fn ) {
+					  auto const sub_batch = [&]( auto... args ) {
+						  for( std::size_t n = first; n < last; ++n ) {
+							  if constexpr( has_output ) {
+								  *out = function_table_impl::invoke_entry<R, allow_empty>(
+								    fn, args[n]... );
+								  ++out;
+							  } else {
+								  (void)function_table_impl::invoke_entry<R, allow_empty>(
+								    fn, args[n]... );
+							  }
+						  }
+					  };
+					  sub_batch( std::begin( arg_ranges )... );
+				  };
+				  if constexpr( using_array_v ) {
+					  if( idx >= size( ) ) {
+						  std::abort( );
+					  }
+					  run( fns[idx] );
+				  } else {
+					  function_table_impl::visit_entry(
+					    idx, fns, run, std::make_index_sequence<size( )>{ } );
+				  }
+			  } );
+			return out;
+		}
 	};
 
 	template<typename R = void, typename Function, typename... Functions>
@@ -151,4 +265,75 @@ namespace daw {
 	make_function_table( Function fn, Functions... fns ) {
 		return function_table_t<R, Function, Functions...>{ fn, fns... };
 	}
+
+	/// @brief A dispatch table whose entries are known at compile time.
+	/// run( program, ctx... ) calls Fns[idx]( ctx... ) for each idx in program.
+	/// Each handler dispatches the next op itself through a tail call, so
+	/// every op gets its own indirect branch as in a threaded interpreter,
+	/// instead of all ops sharing the single branch of a switch loop.
+	template<auto... Fns>
+	struct threaded_function_table {
+		static_assert( sizeof...( Fns ) > 0 );
+
+	private:
+		static constexpr std::tuple<decltype( Fns )...> fns{ Fns... };
+
+		template<typename Index, typename... Ctx>
+		struct handlers {
+			using handler_t = void ( * )( Index const *, Index const *, Ctx &... );
+
+			template<std::size_t I>
+			static void step( Index const *ip, Index const *last, Ctx &...ctx ) {
+				(void)std::get<I>( fns )( ctx... );
+				if( ip == last ) {
+					return;
+				}
+				auto const idx = static_cast<std::size_t>( *ip );
+				daw_dbg_ensure( idx < sizeof...( Fns ) );
+				return table[idx]( ip + 1, last, ctx... );
+			}
+
+			template<std::size_t... Is>
+			static constexpr std::array<handler_t, sizeof...( Is )>
+			make_table( std::index_sequence<Is...> ) {
+				return { &step<Is>... };
+			}
+
+			static constexpr std::array<handler_t, sizeof...( Fns )> table =
+			  make_table( std::make_index_sequence<sizeof...( Fns )>{ } );
+		};
+
+	public:
+		static constexpr std::size_t size( ) noexcept {
+			return sizeof...( Fns );
+		}
+
+		/// @param program A contiguous range of indices into the table
+		/// @param ctx State passed by reference to every op
+		template<typename Indices, typename... Ctx>
+		static void run( Indices const &program, Ctx &...ctx ) {
+			using index_t =
+			  std::remove_cv_t<std::remove_pointer_t<decltype( std::data(
+			    program ) )>>;
+			using handlers_t = handlers<index_t, Ctx...>;
+			index_t const *first = std::data( program );
+			std::size_t count = std::size( program );
+			while( count > 0 ) {
+				std::size_t const chunk =
+				  count < function_table_impl::threaded_chunk_size
+				    ? count
+				    : function_table_impl::threaded_chunk_size;
+				auto const idx = static_cast<std::size_t>( *first );
+				daw_dbg_ensure( idx < sizeof...( Fns ) );
+				handlers_t::table[idx]( first + 1, first + chunk, ctx... );
+				first += chunk;
+				count -= chunk;
+			}
+		}
+
+		template<typename Indices, typename... Ctx>
+		void operator( )( Indices const &program, Ctx &...ctx ) const {
+			run( program, ctx... );
+		}
+	};
 } // namespace daw
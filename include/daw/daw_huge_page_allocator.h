@@ -0,0 +1,295 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/daw_check_exceptions.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+#if defined( __linux__ )
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace daw::memory {
+	/// How the pages backing a large allocation are sized
+	enum class page_policy : std::uint8_t {
+		/// Regular pages, transparent huge pages are disabled for the range
+		standard,
+		/// Transparent huge pages via madvise( MADV_HUGEPAGE ) on a huge page
+		/// aligned range
+		transparent_huge,
+		/// MAP_HUGETLB pages from the reserved pool, falls back to
+		/// transparent_huge when the pool cannot satisfy the request
+		explicit_huge
+	};
+
+	/// Where the pages of a large allocation are placed on NUMA machines
+	enum class numa_policy : std::uint8_t {
+		/// The node of the thread that first touches a page, the kernel default
+		first_touch,
+		/// Pages are spread round robin over the nodes in the mask
+		interleave,
+		/// Pages only come from the nodes in the mask
+		bind,
+		/// Pages come from the first node in the mask while it has memory
+		preferred
+	};
+
+	struct numa_placement {
+		numa_policy policy = numa_policy::first_touch;
+		/// Bit n selects node n, zero selects every node the process may use
+		std::uint64_t node_mask = 0;
+
+		[[nodiscard]] friend constexpr bool
+		operator==( numa_placement const &lhs, numa_placement const &rhs ) noexcept {
+			return lhs.policy == rhs.policy and lhs.node_mask == rhs.node_mask;
+		}
+
+		[[nodiscard]] friend constexpr bool
+		operator!=( numa_placement const &lhs, numa_placement const &rhs ) noexcept {
+			return not( lhs == rhs );
+		}
+	};
+
+	namespace huge_page_impl {
+		inline constexpr std::size_t huge_page_size = 2U * 1024U * 1024U;
+
+		/// Smaller requests use operator new.  Mapping every small growth step of
+		/// a container costs more than the TLB misses it would save.
+		inline constexpr std::size_t mapping_threshold = huge_page_size / 2U;
+
+		[[nodiscard]] constexpr std::size_t round_up( std::size_t n,
+		                                              std::size_t align ) noexcept {
+			return ( n + align - 1U ) & ~( align - 1U );
+		}
+
+		[[nodiscard]] constexpr std::size_t
+		mapping_size( std::size_t bytes ) noexcept {
+			return round_up( bytes, huge_page_size );
+		}
+
+#if defined( __linux__ ) and defined( SYS_mbind )
+		// From linux/mempolicy.h, which is not always installed
+		inline constexpr int mpol_preferred = 1;
+		inline constexpr int mpol_bind = 2;
+		inline constexpr int mpol_interleave = 3;
+		inline constexpr unsigned long mpol_f_mems_allowed = 1U << 2U;
+		// The kernel reads maxnode - 1 bits
+		inline constexpr unsigned long mask_bits = 64U + 1U;
+
+		[[nodiscard]] inline std::uint64_t allowed_nodes( ) noexcept {
+			unsigned long mask = 0;
+			if( syscall( SYS_get_mempolicy, nullptr, &mask, mask_bits, nullptr,
+			             mpol_f_mems_allowed ) != 0 ) {
+				return 0;
+			}
+			return mask;
+		}
+
+		/// Placement is a hint, a kernel without NUMA support leaves the
+		/// default policy in place
+		inline bool apply_placement( void *p, std::size_t bytes,
+		                             numa_placement placement ) noexcept {
+			int mode = 0;
+			switch( placement.policy ) {
+			case numa_policy::first_touch:
+				return true;
+			case numa_policy::interleave:
+				mode = mpol_interleave;
+				break;
+			case numa_policy::bind:
+				mode = mpol_bind;
+				break;
+			case numa_policy::preferred:
+				mode = mpol_preferred;
+				break;
+			}
+			unsigned long mask = placement.node_mask != 0
+			                       ? static_cast<unsigned long>( placement.node_mask )
+			                       : allowed_nodes( );
+			if( mask == 0 ) {
+				return false;
+			}
+			if( placement.policy == numa_policy::preferred ) {
+				mask &= ~( mask - 1U );
+			}
+			return syscall( SYS_mbind, p, bytes, mode, &mask, mask_bits, 0U ) == 0;
+		}
+#else
+		[[nodiscard]] inline std::uint64_t allowed_nodes( ) noexcept {
+			return 0;
+		}
+
+		inline bool apply_placement( void *, std::size_t, numa_placement ) noexcept {
+			return false;
+		}
+#endif
+
+#if defined( __linux__ )
+		/// An anonymous mapping of bytes aligned to a huge page.  The unaligned
+		/// head and tail of an oversized mapping are returned to the kernel.
+		[[nodiscard]] inline void *map_aligned( std::size_t bytes ) noexcept {
+			auto const padded = bytes + huge_page_size;
+			void *const raw = mmap( nullptr, padded, PROT_READ | PROT_WRITE,
+			                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+			if( raw == MAP_FAILED ) {
+				return nullptr;
+			}
+			auto const first = reinterpret_cast<std::uintptr_t>( raw );
+			auto const aligned = round_up( first, huge_page_size );
+			auto const head = aligned - first;
+			if( head != 0 ) {
+				munmap( raw, head );
+			}
+			auto const tail = padded - head - bytes;
+			if( tail != 0 ) {
+				munmap( reinterpret_cast<void *>( aligned + bytes ), tail );
+			}
+			return reinterpret_cast<void *>( aligned );
+		}
+
+		[[nodiscard]] inline void *map_pages( std::size_t bytes, page_policy pages,
+		                                      numa_placement placement ) noexcept {
+			auto const len = mapping_size( bytes );
+			void *result = nullptr;
+#if defined( MAP_HUGETLB )
+			if( pages == page_policy::explicit_huge ) {
+				result = mmap( nullptr, len, PROT_READ | PROT_WRITE,
+				               MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0 );
+				if( result == MAP_FAILED ) {
+					result = nullptr;
+				}
+			}
+#endif
+			if( result == nullptr ) {
+				result = map_aligned( len );
+				if( result == nullptr ) {
+					return nullptr;
+				}
+#if defined( MADV_HUGEPAGE )
+				(void)madvise( result, len,
+				               pages == page_policy::standard ? MADV_NOHUGEPAGE
+				                                              : MADV_HUGEPAGE );
+#endif
+			}
+			(void)apply_placement( result, len, placement );
+			return result;
+		}
+
+		inline void unmap_pages( void *p, std::size_t bytes ) noexcept {
+			munmap( p, mapping_size( bytes ) );
+		}
+#else
+		[[nodiscard]] inline void *map_pages( std::size_t bytes, page_policy,
+		                                      numa_placement ) noexcept {
+			return ::operator new( mapping_size( bytes ),
+			                       std::align_val_t{ huge_page_size },
+			                       std::nothrow );
+		}
+
+		inline void unmap_pages( void *p, std::size_t bytes ) noexcept {
+			::operator delete( p, mapping_size( bytes ),
+			                   std::align_val_t{ huge_page_size } );
+		}
+#endif
+	} // namespace huge_page_impl
+
+	/// The NUMA nodes this process may allocate from, bit n is node n.  Zero
+	/// when the kernel does not support NUMA
+	[[nodiscard]] inline std::uint64_t numa_nodes_allowed( ) noexcept {
+		return huge_page_impl::allowed_nodes( );
+	}
+
+	/// An allocator for large tables.  Requests of at least half a huge page are
+	/// mapped directly with the page policy and NUMA placement requested, smaller
+	/// ones use operator new.  Any instance can release memory from another, the
+	/// placement only affects new allocations.
+	template<typename T, page_policy Pages = page_policy::transparent_huge>
+	struct huge_page_allocator {
+		using value_type = T;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using propagate_on_container_copy_assignment = std::true_type;
+		using propagate_on_container_move_assignment = std::true_type;
+		using propagate_on_container_swap = std::true_type;
+		using is_always_equal = std::true_type;
+
+		template<typename U>
+		struct rebind {
+			using other = huge_page_allocator<U, Pages>;
+		};
+
+		static constexpr page_policy pages = Pages;
+
+		numa_placement placement = numa_placement{ };
+
+		huge_page_allocator( ) = default;
+
+		explicit constexpr huge_page_allocator( numa_placement p ) noexcept
+		  : placement( p ) {}
+
+		template<typename U>
+		constexpr huge_page_allocator(
+		  huge_page_allocator<U, Pages> const &other ) noexcept
+		  : placement( other.placement ) {}
+
+		[[nodiscard]] T *allocate( size_type n ) {
+			if( n > std::numeric_limits<size_type>::max( ) / sizeof( T ) ) {
+				DAW_THROW_OR_TERMINATE_NA( std::bad_alloc );
+			}
+			auto const bytes = n * sizeof( T );
+			if( bytes < huge_page_impl::mapping_threshold ) {
+				return static_cast<T *>(
+				  ::operator new( bytes, std::align_val_t{ alignof( T ) } ) );
+			}
+			void *const result =
+			  huge_page_impl::map_pages( bytes, Pages, placement );
+			if( result == nullptr ) {
+				DAW_THROW_OR_TERMINATE_NA( std::bad_alloc );
+			}
+			return static_cast<T *>( result );
+		}
+
+		void deallocate( T *p, size_type n ) noexcept {
+			auto const bytes = n * sizeof( T );
+			if( bytes < huge_page_impl::mapping_threshold ) {
+				::operator delete( p, bytes, std::align_val_t{ alignof( T ) } );
+				return;
+			}
+			huge_page_impl::unmap_pages( p, bytes );
+		}
+
+		template<typename U>
+		[[nodiscard]] friend constexpr bool
+		operator==( huge_page_allocator const &,
+		            huge_page_allocator<U, Pages> const & ) noexcept {
+			return true;
+		}
+
+		template<typename U>
+		[[nodiscard]] friend constexpr bool
+		operator!=( huge_page_allocator const &,
+		            huge_page_allocator<U, Pages> const & ) noexcept {
+			return false;
+		}
+	};
+
+	/// Regular pages with transparent huge pages disabled, the baseline
+	template<typename T>
+	using small_page_allocator = huge_page_allocator<T, page_policy::standard>;
+
+	template<typename T>
+	using hugetlb_allocator = huge_page_allocator<T, page_policy::explicit_huge>;
+} // namespace daw::memory
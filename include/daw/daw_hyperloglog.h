@@ -0,0 +1,175 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/ciso646.h"
+#include "daw/daw_attributes.h"
+#include "daw/daw_cxmath.h"
+#include "daw/daw_ensure.h"
+#include "daw/impl/daw_filter_common.h"
+#include "daw/impl/daw_sketch_common.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace daw {
+	namespace hyperloglog_impl {
+		inline constexpr std::uint32_t min_precision = 4;
+		inline constexpr std::uint32_t max_precision = 18;
+
+		[[nodiscard]] inline double alpha( std::size_t m ) noexcept {
+			switch( m ) {
+			case 16:
+				return 0.673;
+			case 32:
+				return 0.697;
+			case 64:
+				return 0.709;
+			default:
+				return 0.7213 / ( 1.0 + 1.079 / static_cast<double>( m ) );
+			}
+		}
+	} // namespace hyperloglog_impl
+
+	/// @brief Estimates the number of distinct keys inserted using 2^precision
+	/// one byte registers.  The standard error is about
+	/// 1.04 / sqrt( 2^precision ), 0.81% at the default precision of 14 in
+	/// 16KB.  Small cardinalities use linear counting.  Sketches with the same
+	/// precision and hasher are merged by taking the maximum of each register
+	template<typename Hash = filter_hash>
+	class hyperloglog {
+		std::vector<std::uint8_t> m_registers{ };
+		std::uint32_t m_precision;
+		DAW_NO_UNIQUE_ADDRESS Hash m_hash;
+
+	public:
+		explicit hyperloglog( std::uint32_t precision = 14, Hash hasher = Hash{ } )
+		  : m_precision( precision )
+		  , m_hash( std::move( hasher ) ) {
+			daw_ensure( precision >= hyperloglog_impl::min_precision and
+			            precision <= hyperloglog_impl::max_precision );
+			m_registers.resize( std::size_t{ 1 } << precision );
+		}
+
+		[[nodiscard]] std::uint32_t precision( ) const noexcept {
+			return m_precision;
+		}
+
+		[[nodiscard]] std::size_t register_count( ) const noexcept {
+			return m_registers.size( );
+		}
+
+		[[nodiscard]] Hash const &hash_function( ) const noexcept {
+			return m_hash;
+		}
+
+		DAW_ATTRIB_INLINE void insert_hash( std::uint64_t hash ) noexcept {
+			auto const index = static_cast<std::size_t>( hash >> ( 64U - m_precision ) );
+			// A marker bit bounds the rank when the remaining bits are all zero
+			auto const rest = ( hash << m_precision ) |
+			                  ( std::uint64_t{ 1 } << ( m_precision - 1U ) );
+			auto const rank = static_cast<std::uint8_t>(
+			  daw::cxmath::count_leading_zeroes( rest ) + 1U );
+			auto &reg = m_registers[index];
+			reg = std::max( reg, rank );
+		}
+
+		template<typename Key>
+		void insert( Key const &key ) {
+			insert_hash( m_hash( key ) );
+		}
+
+		template<typename Iterator, typename Last>
+		void insert( Iterator first, Last last ) {
+			for( ; first != last; ++first ) {
+				insert_hash( m_hash( *first ) );
+			}
+		}
+
+		/// @brief Combine with another sketch of the same precision, such as one
+		/// filled on another thread
+		hyperloglog &merge( hyperloglog const &rhs ) {
+			daw_ensure( m_precision == rhs.m_precision );
+			for( std::size_t n = 0; n < m_registers.size( ); ++n ) {
+				m_registers[n] = std::max( m_registers[n], rhs.m_registers[n] );
+			}
+			return *this;
+		}
+
+		/// @brief The estimated number of distinct keys inserted
+		[[nodiscard]] double estimate( ) const noexcept {
+			auto const m = static_cast<double>( m_registers.size( ) );
+			auto sum = 0.0;
+			std::size_t zeros = 0;
+			for( auto r : m_registers ) {
+				sum += std::ldexp( 1.0, -static_cast<int>( r ) );
+				zeros += static_cast<std::size_t>( r == 0 );
+			}
+			auto const raw = hyperloglog_impl::alpha( m_registers.size( ) ) * m * m / sum;
+			if( raw <= 2.5 * m and zeros > 0 ) {
+				return m * std::log( m / static_cast<double>( zeros ) );
+			}
+			return raw;
+		}
+
+		[[nodiscard]] std::uint64_t count( ) const noexcept {
+			return static_cast<std::uint64_t>( std::llround( estimate( ) ) );
+		}
+
+		void clear( ) noexcept {
+			std::fill( m_registers.begin( ), m_registers.end( ), std::uint8_t{ 0 } );
+		}
+
+		/// @brief Bytes needed by serialize_to
+		[[nodiscard]] std::size_t serialized_size( ) const noexcept {
+			return sizeof( sketch_impl::sketch_header ) + m_registers.size( );
+		}
+
+		/// @pre out has room for serialized_size( ) bytes
+		/// @return one past the last byte written
+		char *serialize_to( char *out ) const noexcept {
+			auto header = sketch_impl::sketch_header{ };
+			header.kind = sketch_impl::sketch_kind::hyperloglog;
+			header.parameter = static_cast<double>( m_precision );
+			header.item_count = m_registers.size( );
+			header.value_size = 1;
+			return sketch_impl::write_sketch( out, header, m_registers.data( ) );
+		}
+
+		/// @brief Copy a sketch out of a buffer written by serialize_to
+		[[nodiscard]] static std::optional<hyperloglog>
+		from_buffer( char const *buffer, std::size_t buffer_size,
+		             Hash hasher = Hash{ } ) {
+			auto header = sketch_impl::sketch_header{ };
+			if( not sketch_impl::read_header( buffer, buffer_size,
+			                                  sketch_impl::sketch_kind::hyperloglog, 1,
+			                                  header ) ) {
+				return std::nullopt;
+			}
+			if( not( header.parameter >= hyperloglog_impl::min_precision and
+			         header.parameter <= hyperloglog_impl::max_precision ) ) {
+				return std::nullopt;
+			}
+			auto const precision = static_cast<std::uint32_t>( header.parameter );
+			if( header.item_count != ( std::uint64_t{ 1 } << precision ) ) {
+				return std::nullopt;
+			}
+			auto result = hyperloglog( precision, std::move( hasher ) );
+			std::memcpy( result.m_registers.data( ), buffer + sizeof( header ),
+			             result.m_registers.size( ) );
+			return result;
+		}
+	};
+} // namespace daw
@@ -0,0 +1,386 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/ciso646.h"
+#include "daw/daw_attributes.h"
+#include "daw/daw_check_exceptions.h"
+#include "daw/daw_move.h"
+#include "daw/impl/daw_make_trait.h"
+#include "daw/traits/daw_traits_remove_cvref.h"
+
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace daw {
+	namespace inplace_func_impl {
+		DAW_MAKE_REQ_TRAIT( is_boolable_v,
+		                    static_cast<bool>( std::declval<T>( ) ) );
+
+		/// @brief The operations for a stored callable.  relocate is nullptr
+		/// when moving is a memcpy of the buffer, and destroy is nullptr when
+		/// destruction is a no-op.
+		template<typename Invoke>
+		struct ops_t {
+			Invoke invoke;
+			/// Move construct into dst from src and destroy src
+			void ( *relocate )( void *dst, void *src ) noexcept;
+			void ( *destroy )( void *p ) noexcept;
+		};
+
+		template<typename F>
+		inline constexpr bool is_trivial_callable_v =
+		  std::is_trivially_copyable_v<F> and
+		  std::is_trivially_destructible_v<F>;
+
+		/// The callable lives in the buffer
+		template<typename F>
+		struct local_storage {
+			template<typename Qualified>
+			DAW_ATTRIB_INLINE static Qualified get( void const *p ) noexcept {
+				using ptr_t = std::remove_reference_t<Qualified> *;
+				return static_cast<Qualified>(
+				  *static_cast<ptr_t>( const_cast<void *>( p ) ) );
+			}
+
+			template<typename... Args>
+			static void create( void *p, Args &&...args ) {
+				::new( p ) F( DAW_FWD( args )... );
+			}
+
+			static void relocate( void *dst, void *src ) noexcept {
+				auto *s = static_cast<F *>( src );
+				::new( dst ) F( std::move( *s ) );
+				s->~F( );
+			}
+
+			static void destroy( void *p ) noexcept {
+				static_cast<F *>( p )->~F( );
+			}
+
+			static constexpr bool is_trivially_relocatable =
+			  is_trivial_callable_v<F>;
+			static constexpr bool is_trivially_destructible =
+			  is_trivial_callable_v<F>;
+		};
+
+		/// The buffer holds a pointer to the heap allocated callable
+		template<typename F>
+		struct remote_storage {
+			template<typename Qualified>
+			DAW_ATTRIB_INLINE static Qualified get( void const *p ) noexcept {
+				F *f = nullptr;
+				std::memcpy( &f, p, sizeof( F * ) );
+				return static_cast<Qualified>( *f );
+			}
+
+			template<typename... Args>
+			static void create( void *p, Args &&...args ) {
+				F *f = new F( DAW_FWD( args )... );
+				std::memcpy( p, &f, sizeof( F * ) );
+			}
+
+			static void relocate( void *, void * ) noexcept {}
+
+			static void destroy( void *p ) noexcept {
+				F *f = nullptr;
+				std::memcpy( &f, p, sizeof( F * ) );
+				delete f;
+			}
+
+			/// Only the pointer moves, but the callable must still be deleted
+			static constexpr bool is_trivially_relocatable = true;
+			static constexpr bool is_trivially_destructible = false;
+		};
+
+		template<typename R, typename Qualified, typename Storage, bool NoExcept,
+		         typename... Args>
+		R invoke_thunk( void const *p, Args &&...args ) noexcept( NoExcept ) {
+			if constexpr( std::is_void_v<R> ) {
+				(void)std::invoke( Storage::template get<Qualified>( p ),
+				                   DAW_FWD( args )... );
+			} else {
+				return std::invoke( Storage::template get<Qualified>( p ),
+				                    DAW_FWD( args )... );
+			}
+		}
+
+		template<typename R, bool NoExcept, typename... Args>
+		[[noreturn]] R empty_thunk( void const *, Args &&... ) noexcept( NoExcept ) {
+			if constexpr( NoExcept ) {
+				std::terminate( );
+			} else {
+				DAW_THROW_OR_TERMINATE_NA( std::bad_function_call );
+			}
+		}
+
+		template<typename Sig>
+		struct sig_traits;
+
+		/// Defines the traits and call operator for one cv/ref/noexcept
+		/// qualification of a signature.  INV is how the stored callable is
+		/// invoked, e.g. F const & for a const signature
+#define DAW_INPLACE_FUNC_QUALS( CV, REF, INV_REF, NOEXCEPT )                    \
+	template<typename R, typename... Args>                                       \
+	struct sig_traits<R( Args... ) CV REF noexcept( NOEXCEPT )> {                \
+		using result_type = R;                                                     \
+		static constexpr bool is_noexcept = NOEXCEPT;                              \
+		template<typename F>                                                       \
+		using invoke_as = F CV INV_REF;                                            \
+		template<typename F>                                                       \
+		static constexpr bool is_invocable_v =                                     \
+		  NOEXCEPT ? std::is_nothrow_invocable_r_v<R, F CV INV_REF, Args...>       \
+		           : std::is_invocable_r_v<R, F CV INV_REF, Args...>;              \
+		using invoke_t = R ( * )( void const *, Args &&... ) noexcept( NOEXCEPT ); \
+		template<typename Qualified, typename Storage>                             \
+		static constexpr invoke_t invoke =                                         \
+		  &invoke_thunk<R, Qualified, Storage, NOEXCEPT, Args...>;                 \
+		static constexpr invoke_t empty_invoke =                                   \
+		  &empty_thunk<R, NOEXCEPT, Args...>;                                      \
+		template<typename Derived>                                                 \
+		struct call_operator {                                                     \
+			R operator( )( Args... args ) CV REF noexcept( NOEXCEPT ) {              \
+				auto const &self = static_cast<Derived const &>( *this );              \
+				return self.m_ops->invoke( self.m_buffer, DAW_FWD( args )... );        \
+			}                                                                        \
+		};                                                                         \
+	}
+
+		DAW_INPLACE_FUNC_QUALS(, , &, false );
+		DAW_INPLACE_FUNC_QUALS(, &, &, false );
+		DAW_INPLACE_FUNC_QUALS(, &&, &&, false );
+		DAW_INPLACE_FUNC_QUALS( const, , &, false );
+		DAW_INPLACE_FUNC_QUALS( const, &, &, false );
+		DAW_INPLACE_FUNC_QUALS( const, &&, &&, false );
+		DAW_INPLACE_FUNC_QUALS(, , &, true );
+		DAW_INPLACE_FUNC_QUALS(, &, &, true );
+		DAW_INPLACE_FUNC_QUALS(, &&, &&, true );
+		DAW_INPLACE_FUNC_QUALS( const, , &, true );
+		DAW_INPLACE_FUNC_QUALS( const, &, &, true );
+		DAW_INPLACE_FUNC_QUALS( const, &&, &&, true );
+#undef DAW_INPLACE_FUNC_QUALS
+
+		template<typename Sig, typename F, typename Storage>
+		inline constexpr ops_t<typename sig_traits<Sig>::invoke_t> ops_for = {
+		  sig_traits<Sig>::template invoke<
+		    typename sig_traits<Sig>::template invoke_as<F>, Storage>,
+		  Storage::is_trivially_relocatable ? nullptr : &Storage::relocate,
+		  Storage::is_trivially_destructible ? nullptr : &Storage::destroy };
+
+		template<typename Sig>
+		inline constexpr ops_t<typename sig_traits<Sig>::invoke_t> empty_ops = {
+		  sig_traits<Sig>::empty_invoke, nullptr, nullptr };
+
+		template<typename>
+		inline constexpr bool is_in_place_type_v = false;
+
+		template<typename T>
+		inline constexpr bool is_in_place_type_v<std::in_place_type_t<T>> = true;
+
+		/// @brief The shared implementation of inplace_function and
+		/// move_only_function.  Callables that fit in Capacity bytes with an
+		/// alignment of at most Align, and are nothrow movable, are stored in
+		/// the object.  Others are heap allocated when AllowHeap is true, and
+		/// rejected at compile time when it is false.
+		template<typename Sig, std::size_t Capacity, std::size_t Align,
+		         bool AllowHeap>
+		class basic_function
+		  : public sig_traits<Sig>::template call_operator<
+		      basic_function<Sig, Capacity, Align, AllowHeap>> {
+			static_assert( Capacity >= sizeof( void * ) );
+			static_assert( Align >= alignof( void * ) );
+
+			using traits = sig_traits<Sig>;
+			using ops_type = ops_t<typename traits::invoke_t>;
+
+			friend typename traits::template call_operator<basic_function>;
+
+			alignas( Align ) unsigned char m_buffer[Capacity];
+			ops_type const *m_ops = &empty_ops<Sig>;
+
+			template<typename F>
+			static constexpr bool fits_locally_v =
+			  sizeof( F ) <= Capacity and alignof( F ) <= Align and
+			  std::is_nothrow_move_constructible_v<F>;
+
+			template<typename F>
+			using storage_for = std::conditional_t<fits_locally_v<F>,
+			                                       local_storage<F>,
+			                                       remote_storage<F>>;
+
+			template<typename F, typename... Args>
+			void create( Args &&...args ) {
+				static_assert( AllowHeap or fits_locally_v<F>,
+				               "Callable does not fit in the inline buffer, it must "
+				               "be no larger than Capacity, no more aligned than "
+				               "Align, and nothrow move constructible" );
+				storage_for<F>::create( m_buffer, DAW_FWD( args )... );
+				m_ops = &ops_for<Sig, F, storage_for<F>>;
+			}
+
+			template<typename F>
+			[[nodiscard]] static bool is_null( F const &f ) {
+				if constexpr( std::is_pointer_v<F> or
+				              std::is_member_pointer_v<F> ) {
+					return f == nullptr;
+				} else if constexpr( is_boolable_v<F const &> and
+				                     not std::is_empty_v<F> ) {
+					return not static_cast<bool>( f );
+				} else {
+					return false;
+				}
+			}
+
+			void reset( ) noexcept {
+				if( m_ops->destroy ) {
+					m_ops->destroy( m_buffer );
+				}
+				m_ops = &empty_ops<Sig>;
+			}
+
+			void take( basic_function &other ) noexcept {
+				if( other.m_ops->relocate ) {
+					other.m_ops->relocate( m_buffer, other.m_buffer );
+				} else {
+					std::memcpy( m_buffer, other.m_buffer, Capacity );
+				}
+				m_ops = std::exchange( other.m_ops, &empty_ops<Sig> );
+			}
+
+		public:
+			using result_type = typename traits::result_type;
+			static constexpr std::size_t capacity = Capacity;
+			static constexpr std::size_t alignment = Align;
+
+			basic_function( ) noexcept = default;
+			basic_function( std::nullptr_t ) noexcept {}
+
+			template<
+			  typename Func, typename F = std::decay_t<Func>,
+			  std::enable_if_t<not std::is_same_v<F, basic_function> and
+			                     not is_in_place_type_v<F> and
+			                     traits::template is_invocable_v<F> and
+			                     std::is_constructible_v<F, Func>,
+			                   std::nullptr_t> = nullptr>
+			basic_function( Func &&f ) {
+				if( is_null<F>( f ) ) {
+					return;
+				}
+				create<F>( DAW_FWD( f ) );
+			}
+
+			template<typename F, typename... Args,
+			         std::enable_if_t<traits::template is_invocable_v<F> and
+			                            std::is_constructible_v<F, Args...>,
+			                          std::nullptr_t> = nullptr>
+			explicit basic_function( std::in_place_type_t<F>, Args &&...args ) {
+				static_assert( std::is_same_v<F, std::decay_t<F>> );
+				create<F>( DAW_FWD( args )... );
+			}
+
+			basic_function( basic_function &&other ) noexcept {
+				take( other );
+			}
+
+			basic_function &operator=( basic_function &&rhs ) noexcept {
+				if( this != &rhs ) {
+					reset( );
+					take( rhs );
+				}
+				return *this;
+			}
+
+			basic_function &operator=( std::nullptr_t ) noexcept {
+				reset( );
+				return *this;
+			}
+
+			template<typename Func,
+			         std::enable_if_t<
+			           std::is_constructible_v<basic_function, Func> and
+			             not std::is_same_v<std::decay_t<Func>, basic_function>,
+			           std::nullptr_t> = nullptr>
+			basic_function &operator=( Func &&f ) {
+				basic_function tmp( DAW_FWD( f ) );
+				reset( );
+				take( tmp );
+				return *this;
+			}
+
+			basic_function( basic_function const & ) = delete;
+			basic_function &operator=( basic_function const & ) = delete;
+
+			~basic_function( ) {
+				reset( );
+			}
+
+			void swap( basic_function &other ) noexcept {
+				basic_function tmp( std::move( other ) );
+				other = std::move( *this );
+				*this = std::move( tmp );
+			}
+
+			friend void swap( basic_function &lhs, basic_function &rhs ) noexcept {
+				lhs.swap( rhs );
+			}
+
+			[[nodiscard]] bool empty( ) const noexcept {
+				return m_ops == &empty_ops<Sig>;
+			}
+
+			explicit operator bool( ) const noexcept {
+				return not empty( );
+			}
+
+			[[nodiscard]] friend bool operator==( basic_function const &f,
+			                                      std::nullptr_t ) noexcept {
+				return f.empty( );
+			}
+
+			[[nodiscard]] friend bool operator!=( basic_function const &f,
+			                                      std::nullptr_t ) noexcept {
+				return not f.empty( );
+			}
+
+			/// @brief true if the stored callable is trivially copyable and moves
+			/// of this object are a memcpy
+			[[nodiscard]] bool is_trivially_relocatable( ) const noexcept {
+				return m_ops->relocate == nullptr and m_ops->destroy == nullptr;
+			}
+		};
+	} // namespace inplace_func_impl
+
+	/// @brief A move only type erased callable that never allocates.  Sig may
+	/// have const, &, && and noexcept qualifiers, e.g. int( int ) const noexcept.
+	/// Callables must fit in Capacity bytes and be nothrow move constructible;
+	/// this is checked at compile time.  Dispatch goes through a per callable
+	/// type table of invoke/relocate/destroy function pointers rather than
+	/// virtual functions, and trivially copyable callables move with a memcpy.
+	/// Calling an empty inplace_function throws std::bad_function_call, or
+	/// terminates for noexcept signatures.  The defaults make it the size of
+	/// four pointers.
+	template<typename Sig, std::size_t Capacity = 3 * sizeof( void * ),
+	         std::size_t Align = alignof( void * )>
+	using inplace_function =
+	  inplace_func_impl::basic_function<Sig, Capacity, Align, false>;
+
+	/// @brief Like inplace_function, but callables that do not fit in the
+	/// inline buffer are heap allocated.  Comparable to std::move_only_function
+	/// with a configurable small buffer.
+	template<typename Sig, std::size_t Capacity = 3 * sizeof( void * ),
+	         std::size_t Align = alignof( void * )>
+	using move_only_function =
+	  inplace_func_impl::basic_function<Sig, Capacity, Align, true>;
+} // namespace daw
@@ -0,0 +1,509 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/daw_attributes.h"
+#include "daw/daw_check_exceptions.h"
+#include "daw/daw_exchange.h"
+#include "daw/daw_string_view.h"
+#include "daw/impl/daw_mapped_file_region.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if not defined( _MSC_VER ) and not defined( __MINGW32__ )
+namespace daw::filesystem {
+	namespace mapped_impl {
+		[[nodiscard]] constexpr std::uint64_t fmix64( std::uint64_t k ) noexcept {
+			k ^= k >> 33U;
+			k *= 0xff51'afd7'ed55'8ccdULL;
+			k ^= k >> 33U;
+			k *= 0xc4ce'b9fe'1a85'ec53ULL;
+			k ^= k >> 33U;
+			return k;
+		}
+	} // namespace mapped_impl
+
+	/// A hash that gives the same result in every process, the buckets of a
+	/// mapped_hash_map outlive the process that filled them.  Keys that are not
+	/// integers or enums are hashed by their bytes.
+	template<typename Key>
+	struct mapped_hash {
+		[[nodiscard]] constexpr std::uint64_t
+		operator( )( Key const &key ) const noexcept {
+			if constexpr( std::is_enum_v<Key> ) {
+				return mapped_impl::fmix64( static_cast<std::uint64_t>( key ) );
+			} else if constexpr( std::is_integral_v<Key> ) {
+				return mapped_impl::fmix64( static_cast<std::uint64_t>( key ) );
+			} else {
+				static_assert( std::has_unique_object_representations_v<Key>,
+				               "Keys with padding or floating point members need a "
+				               "custom hash" );
+				unsigned char bytes[sizeof( Key )];
+				std::memcpy( bytes, &key, sizeof( Key ) );
+				std::uint64_t h = sizeof( Key );
+				std::size_t pos = 0;
+				for( ; pos + 8U <= sizeof( Key ); pos += 8U ) {
+					std::uint64_t word = 0;
+					std::memcpy( &word, bytes + pos, 8U );
+					h = mapped_impl::fmix64( h ^ word );
+				}
+				if( pos < sizeof( Key ) ) {
+					std::uint64_t word = 0;
+					std::memcpy( &word, bytes + pos, sizeof( Key ) - pos );
+					h = mapped_impl::fmix64( h ^ word );
+				}
+				return h;
+			}
+		}
+	};
+
+	/// An open addressing hash map of trivially copyable keys and values that
+	/// lives in a file.  Opening an existing file maps the table as is, nothing
+	/// is rehashed or rebuilt.
+	///
+	/// Each bucket is a tag followed by the key and value.  The key and value
+	/// are written before the tag that marks the bucket full, and an erase is a
+	/// single store of the tag, so a process that is killed leaves every
+	/// completed insert and erase in the file.  Growth builds the new table past
+	/// the end of the file and switches to it with one store.  The counts are
+	/// rebuilt when a file was not closed.
+	///
+	/// Overwriting the value of an existing key with insert_or_assign is a plain
+	/// copy, a value wider than a word can be torn by a kill part way through.
+	///
+	/// checkpoint( ) and close( ) flush the table and then the header, the
+	/// contents at that point survive a power loss.
+	template<typename Key, typename Value, typename Hash = mapped_hash<Key>,
+	         typename KeyEqual = std::equal_to<>>
+	class mapped_hash_map {
+		static_assert( std::is_trivially_copyable_v<Key> and
+		                 std::is_trivially_copyable_v<Value>,
+		               "Only trivially copyable types can be stored in a file" );
+
+		struct slot_t {
+			std::uint64_t tag;
+			Key key;
+			Value value;
+		};
+
+		struct table_t {
+			std::uint64_t offset;
+			std::uint64_t bucket_count;
+		};
+
+		struct header_t {
+			std::uint64_t magic;
+			std::uint32_t version;
+			std::uint32_t slot_size;
+			std::uint32_t key_size;
+			std::uint32_t value_size;
+			std::uint64_t clean;
+			std::uint64_t checkpoints;
+			std::uint64_t size;
+			std::uint64_t tombstones;
+			std::uint64_t active;
+			table_t tables[2];
+		};
+		static_assert( sizeof( header_t ) <= mapped_impl::header_block );
+		static_assert( alignof( slot_t ) <= mapped_impl::header_block );
+
+		// "DAWMMAP1"
+		static constexpr std::uint64_t magic = 0x3150'414D'4D57'4144ULL;
+		static constexpr std::uint64_t empty_tag = 0;
+		static constexpr std::uint64_t tombstone_tag = 1;
+		static constexpr std::uint64_t full_bit = 1ULL << 63U;
+		static constexpr std::size_t min_buckets = 1024;
+
+		mapped_impl::file_region m_region;
+		std::size_t m_size = 0;
+		std::size_t m_tombstones = 0;
+		DAW_NO_UNIQUE_ADDRESS Hash m_hash{ };
+		DAW_NO_UNIQUE_ADDRESS KeyEqual m_equal{ };
+
+		[[nodiscard]] header_t *header( ) const noexcept {
+			return reinterpret_cast<header_t *>( m_region.data( ) );
+		}
+
+		[[nodiscard]] table_t const &table( ) const noexcept {
+			auto const &h = *header( );
+			return h.tables[h.active];
+		}
+
+		[[nodiscard]] slot_t *slots( ) const noexcept {
+			return reinterpret_cast<slot_t *>( m_region.data( ) + table( ).offset );
+		}
+
+		[[nodiscard]] std::size_t mask( ) const noexcept {
+			return static_cast<std::size_t>( table( ).bucket_count ) - 1U;
+		}
+
+		[[nodiscard]] std::uint64_t tag_of( Key const &key ) const noexcept {
+			return static_cast<std::uint64_t>( m_hash( key ) ) | full_bit;
+		}
+
+		[[nodiscard]] static constexpr std::size_t
+		buckets_for( std::size_t count ) noexcept {
+			std::size_t result = min_buckets;
+			while( count * 4U > result * 3U ) {
+				result *= 2U;
+			}
+			return result;
+		}
+
+		[[nodiscard]] slot_t *find_slot( Key const &key,
+		                                 std::uint64_t tag ) const noexcept {
+			auto *const s = slots( );
+			auto const m = mask( );
+			for( auto idx = static_cast<std::size_t>( tag ) & m;;
+			     idx = ( idx + 1U ) & m ) {
+				auto &slot = s[idx];
+				if( slot.tag == empty_tag ) {
+					return nullptr;
+				}
+				if( slot.tag == tag and m_equal( slot.key, key ) ) {
+					return &slot;
+				}
+			}
+		}
+
+		/// A crash between growing a new file and storing the magic leaves a
+		/// header of zeros, which is treated the same as an empty file
+		[[nodiscard]] bool unformatted( ) const noexcept {
+			return m_region.size( ) == 0 or
+			       ( m_region.size( ) >= sizeof( header_t ) and
+			         header( )->magic == 0 );
+		}
+
+		[[nodiscard]] bool valid_header( ) const noexcept {
+			if( m_region.size( ) < mapped_impl::header_block ) {
+				return false;
+			}
+			auto const &h = *header( );
+			if( h.magic != magic or h.version != mapped_impl::format_version or
+			    h.slot_size != sizeof( slot_t ) or h.key_size != sizeof( Key ) or
+			    h.value_size != sizeof( Value ) or h.active > 1U ) {
+				return false;
+			}
+			auto const &t = h.tables[h.active];
+			return t.bucket_count >= min_buckets and
+			       ( t.bucket_count & ( t.bucket_count - 1U ) ) == 0 and
+			       t.offset >= mapped_impl::header_block and
+			       t.offset % mapped_impl::header_block == 0 and
+			       t.offset <= m_region.size( ) and
+			       t.bucket_count <=
+			         ( m_region.size( ) - t.offset ) / sizeof( slot_t );
+		}
+
+		/// After a kill the counts in the header are stale, and the file may
+		/// still hold a table that was being built or one that was replaced
+		void recover( ) noexcept {
+			m_size = 0;
+			m_tombstones = 0;
+			auto const *const s = slots( );
+			auto const count = static_cast<std::size_t>( table( ).bucket_count );
+			for( std::size_t n = 0; n < count; ++n ) {
+				if( s[n].tag == tombstone_tag ) {
+					++m_tombstones;
+				} else if( s[n].tag != empty_tag ) {
+					++m_size;
+				}
+			}
+			if( not m_region.writable( ) ) {
+				return;
+			}
+			auto const t = table( );
+			auto const end = static_cast<std::size_t>(
+			  t.offset + t.bucket_count * sizeof( slot_t ) );
+			if( end < m_region.size( ) ) {
+				(void)m_region.resize( end );
+			}
+			if( t.offset > mapped_impl::header_block ) {
+				m_region.release( mapped_impl::header_block,
+				                  static_cast<std::size_t>( t.offset ) -
+				                    mapped_impl::header_block );
+			}
+		}
+
+		/// Build a table of bucket_count buckets after the end of the file, flush
+		/// it, then make it the active table.  The old table is punched out.
+		void rehash( std::size_t bucket_count ) {
+			auto const old = table( );
+			auto const offset =
+			  mapped_impl::round_up( m_region.size( ), mapped_impl::header_block );
+			auto const bytes = bucket_count * sizeof( slot_t );
+			if( not m_region.resize( offset + bytes ) ) {
+				DAW_THROW_OR_TERMINATE_NA( std::bad_alloc );
+			}
+			auto const *const from = slots( );
+			auto *const to = reinterpret_cast<slot_t *>( m_region.data( ) + offset );
+			auto const m = bucket_count - 1U;
+			for( std::size_t n = 0; n < old.bucket_count; ++n ) {
+				if( ( from[n].tag & full_bit ) == 0 ) {
+					continue;
+				}
+				auto idx = static_cast<std::size_t>( from[n].tag ) & m;
+				while( to[idx].tag != empty_tag ) {
+					idx = ( idx + 1U ) & m;
+				}
+				to[idx] = from[n];
+			}
+			(void)m_region.sync( offset, bytes, true );
+			auto &h = *header( );
+			auto const next = h.active ^ 1U;
+			h.tables[next] = table_t{ offset, bucket_count };
+			mapped_impl::commit_fence( );
+			h.active = next;
+			(void)m_region.sync( 0, sizeof( header_t ), true );
+			m_tombstones = 0;
+			m_region.release( static_cast<std::size_t>( old.offset ),
+			                  static_cast<std::size_t>( old.bucket_count *
+			                                            sizeof( slot_t ) ) );
+		}
+
+		template<bool Assign>
+		bool insert_impl( Key const &key, Value const &value ) {
+			assert( m_region.writable( ) );
+			auto const tag = tag_of( key );
+			if( auto *slot = find_slot( key, tag ); slot ) {
+				if constexpr( Assign ) {
+					slot->value = value;
+				}
+				return false;
+			}
+			// key and value may refer into the table, which moves as it grows
+			Key const k = key;
+			Value const v = value;
+			if( ( m_size + m_tombstones + 1U ) * 4U > bucket_count( ) * 3U ) {
+				rehash( buckets_for( ( m_size + 1U ) * 2U ) );
+			}
+			auto *const s = slots( );
+			auto const m = mask( );
+			auto idx = static_cast<std::size_t>( tag ) & m;
+			while( ( s[idx].tag & full_bit ) != 0 ) {
+				idx = ( idx + 1U ) & m;
+			}
+			auto &slot = s[idx];
+			if( slot.tag == tombstone_tag ) {
+				--m_tombstones;
+			}
+			slot.key = k;
+			slot.value = v;
+			mapped_impl::commit_fence( );
+			slot.tag = tag;
+			++m_size;
+			return true;
+		}
+
+		void flush( bool wait ) noexcept {
+			auto const &t = table( );
+			(void)m_region.sync( static_cast<std::size_t>( t.offset ),
+			                     static_cast<std::size_t>( t.bucket_count *
+			                                               sizeof( slot_t ) ),
+			                     wait );
+			auto &h = *header( );
+			h.size = m_size;
+			h.tombstones = m_tombstones;
+		}
+
+	public:
+		using key_type = Key;
+		using mapped_type = Value;
+		using hasher = Hash;
+		using key_equal = KeyEqual;
+		using size_type = std::size_t;
+
+		mapped_hash_map( ) = default;
+
+		/// @pre *path.end( ) == '\0'
+		explicit mapped_hash_map( daw::string_view path,
+		                          open_mode mode = open_mode::read_write ) noexcept {
+			(void)open( path, mode );
+		}
+
+		mapped_hash_map( mapped_hash_map && ) noexcept = default;
+
+		mapped_hash_map &operator=( mapped_hash_map &&rhs ) noexcept {
+			if( this != &rhs ) {
+				close( );
+				m_region = std::move( rhs.m_region );
+				m_size = daw::exchange( rhs.m_size, 0U );
+				m_tombstones = daw::exchange( rhs.m_tombstones, 0U );
+			}
+			return *this;
+		}
+
+		~mapped_hash_map( ) {
+			close( );
+		}
+
+		/// Open or, when writable, create the file at path.  A writable file that
+		/// was never fully created is initialized again.  Fails when the file
+		/// holds something other than a mapped_hash_map<Key, Value>
+		/// @pre *path.end( ) == '\0'
+		[[nodiscard]] bool open( daw::string_view path,
+		                         open_mode mode = open_mode::read_write ) noexcept {
+			close( );
+			if( not m_region.open( path, mode ) ) {
+				return false;
+			}
+			if( m_region.writable( ) and unformatted( ) ) {
+				auto const bytes =
+				  mapped_impl::header_block + min_buckets * sizeof( slot_t );
+				if( not m_region.resize( bytes ) ) {
+					m_region.close( );
+					return false;
+				}
+				// The partial file may hold a header or slots from the failed create
+				std::memset( m_region.data( ), 0, bytes );
+				auto &h = *header( );
+				h.version = mapped_impl::format_version;
+				h.slot_size = sizeof( slot_t );
+				h.key_size = sizeof( Key );
+				h.value_size = sizeof( Value );
+				h.clean = 1;
+				h.tables[0] = table_t{ mapped_impl::header_block, min_buckets };
+				mapped_impl::commit_fence( );
+				h.magic = magic;
+			}
+			if( not valid_header( ) ) {
+				m_region.close( );
+				return false;
+			}
+			auto &h = *header( );
+			if( h.clean != 0 ) {
+				m_size = static_cast<std::size_t>( h.size );
+				m_tombstones = static_cast<std::size_t>( h.tombstones );
+			} else {
+				recover( );
+			}
+			if( m_region.writable( ) ) {
+				header( )->clean = 0;
+				(void)m_region.sync( 0, sizeof( header_t ), true );
+			}
+			return true;
+		}
+
+		/// Flush the table and mark the file as closed cleanly
+		void close( ) noexcept {
+			if( m_region.data( ) and m_region.writable( ) ) {
+				flush( true );
+				mapped_impl::commit_fence( );
+				header( )->clean = 1;
+				(void)m_region.sync( 0, sizeof( header_t ), true );
+			}
+			m_region.close( );
+			m_size = 0;
+			m_tombstones = 0;
+		}
+
+		explicit operator bool( ) const noexcept {
+			return static_cast<bool>( m_region );
+		}
+
+		/// Flush the table and then the header to storage
+		void checkpoint( bool wait = true ) noexcept {
+			assert( m_region.writable( ) );
+			flush( wait );
+			++header( )->checkpoints;
+			(void)m_region.sync( 0, sizeof( header_t ), wait );
+		}
+
+		/// The number of completed checkpoints over the life of the file
+		[[nodiscard]] std::uint64_t checkpoints( ) const noexcept {
+			return header( )->checkpoints;
+		}
+
+		[[nodiscard]] size_type size( ) const noexcept {
+			return m_size;
+		}
+
+		[[nodiscard]] bool empty( ) const noexcept {
+			return m_size == 0;
+		}
+
+		[[nodiscard]] size_type bucket_count( ) const noexcept {
+			return m_region.data( ) ? static_cast<size_type>( table( ).bucket_count )
+			                        : 0U;
+		}
+
+		/// Grow the table so that count entries fit without another rehash
+		void reserve( size_type count ) {
+			assert( m_region.writable( ) );
+			if( auto const needed = buckets_for( count );
+			    needed > bucket_count( ) ) {
+				rehash( needed );
+			}
+		}
+
+		/// Returns false and leaves the value alone when key is present
+		bool insert( Key const &key, Value const &value ) {
+			return insert_impl<false>( key, value );
+		}
+
+		/// Returns true when key was not present
+		bool insert_or_assign( Key const &key, Value const &value ) {
+			return insert_impl<true>( key, value );
+		}
+
+		/// A pointer into the file to the value of key, or nullptr.  It is
+		/// invalidated by the next insert.
+		[[nodiscard]] Value *find( Key const &key ) noexcept {
+			auto *slot = find_slot( key, tag_of( key ) );
+			return slot ? &slot->value : nullptr;
+		}
+
+		[[nodiscard]] Value const *find( Key const &key ) const noexcept {
+			auto const *slot = find_slot( key, tag_of( key ) );
+			return slot ? &slot->value : nullptr;
+		}
+
+		[[nodiscard]] bool contains( Key const &key ) const noexcept {
+			return find( key ) != nullptr;
+		}
+
+		bool erase( Key const &key ) noexcept {
+			assert( m_region.writable( ) );
+			auto *const slot = find_slot( key, tag_of( key ) );
+			if( not slot ) {
+				return false;
+			}
+			auto const idx = static_cast<std::size_t>( slot - slots( ) );
+			// No probe sequence passes through a bucket followed by an empty one
+			if( slots( )[( idx + 1U ) & mask( )].tag == empty_tag ) {
+				slot->tag = empty_tag;
+			} else {
+				slot->tag = tombstone_tag;
+				++m_tombstones;
+			}
+			--m_size;
+			return true;
+		}
+
+		/// Call f( key, value ) for every entry
+		template<typename Function>
+		void for_each( Function &&f ) const {
+			auto const *const s = slots( );
+			auto const count = static_cast<std::size_t>( table( ).bucket_count );
+			for( std::size_t n = 0; n < count; ++n ) {
+				if( ( s[n].tag & full_bit ) != 0 ) {
+					f( s[n].key, s[n].value );
+				}
+			}
+		}
+	};
+} // namespace daw::filesystem
+#endif
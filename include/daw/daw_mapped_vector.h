@@ -0,0 +1,265 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/daw_check_exceptions.h"
+#include "daw/daw_string_view.h"
+#include "daw/impl/daw_mapped_file_region.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+#if not defined( _MSC_VER ) and not defined( __MINGW32__ )
+namespace daw::filesystem {
+	/// A vector of trivially copyable values that lives in a file.  Opening an
+	/// existing file maps it without reading or rebuilding anything.
+	///
+	/// The file holds no pointers, the header locates the elements by offset, so
+	/// the mapping can move as it grows.  An element is written before the size
+	/// that includes it, so a process that is killed leaves a file with every
+	/// completed push_back and nothing partial.  checkpoint( ) flushes the data
+	/// and then the header to storage for durability past a power loss.
+	template<typename T>
+	class mapped_vector {
+		static_assert( std::is_trivially_copyable_v<T>,
+		               "Only trivially copyable types can be stored in a file" );
+
+		struct header_t {
+			std::uint64_t magic;
+			std::uint32_t version;
+			std::uint32_t element_size;
+			std::uint64_t element_align;
+			std::uint64_t data_offset;
+			std::uint64_t capacity;
+			std::uint64_t size;
+			std::uint64_t checkpoints;
+		};
+		static_assert( sizeof( header_t ) <= mapped_impl::header_block );
+
+		// "DAWMVEC1"
+		static constexpr std::uint64_t magic = 0x3143'4556'4D57'4144ULL;
+		static constexpr std::size_t data_offset = mapped_impl::round_up(
+		  mapped_impl::header_block, alignof( T ) );
+		static constexpr std::size_t growth_block = 64U * 1024U;
+
+		mapped_impl::file_region m_region;
+
+		[[nodiscard]] header_t *header( ) const noexcept {
+			return reinterpret_cast<header_t *>( m_region.data( ) );
+		}
+
+		[[nodiscard]] bool valid_header( ) const noexcept {
+			if( m_region.size( ) < data_offset ) {
+				return false;
+			}
+			auto const &h = *header( );
+			return h.magic == magic and h.version == mapped_impl::format_version and
+			       h.element_size == sizeof( T ) and
+			       h.element_align == alignof( T ) and
+			       h.data_offset == data_offset and h.size <= h.capacity and
+			       h.capacity <= ( m_region.size( ) - data_offset ) / sizeof( T );
+		}
+
+		/// A crash between growing a new file and storing the magic leaves a
+		/// header of zeros, which is treated the same as an empty file
+		[[nodiscard]] bool unformatted( ) const noexcept {
+			return m_region.size( ) == 0 or
+			       ( m_region.size( ) >= sizeof( header_t ) and
+			         header( )->magic == 0 );
+		}
+
+		[[nodiscard]] bool grow_to( std::size_t count ) noexcept {
+			auto const bytes =
+			  mapped_impl::round_up( data_offset + count * sizeof( T ), growth_block );
+			if( not m_region.resize( bytes ) ) {
+				return false;
+			}
+			mapped_impl::commit_fence( );
+			header( )->capacity = ( bytes - data_offset ) / sizeof( T );
+			return true;
+		}
+
+	public:
+		using value_type = T;
+		using reference = T &;
+		using const_reference = T const &;
+		using pointer = T *;
+		using const_pointer = T const *;
+		using iterator = T *;
+		using const_iterator = T const *;
+		using size_type = std::size_t;
+
+		mapped_vector( ) = default;
+
+		/// @pre *path.end( ) == '\0'
+		explicit mapped_vector( daw::string_view path,
+		                        open_mode mode = open_mode::read_write ) noexcept {
+			(void)open( path, mode );
+		}
+
+		/// Open or, when writable, create the file at path.  A writable file that
+		/// was never fully created is initialized again.  Fails when the file
+		/// holds something other than a mapped_vector<T>
+		/// @pre *path.end( ) == '\0'
+		[[nodiscard]] bool open( daw::string_view path,
+		                         open_mode mode = open_mode::read_write ) noexcept {
+			if( not m_region.open( path, mode ) ) {
+				return false;
+			}
+			if( m_region.writable( ) and unformatted( ) ) {
+				if( not m_region.resize( growth_block ) ) {
+					m_region.close( );
+					return false;
+				}
+				auto &h = *header( );
+				h.version = mapped_impl::format_version;
+				h.element_size = sizeof( T );
+				h.element_align = alignof( T );
+				h.data_offset = data_offset;
+				h.capacity = ( growth_block - data_offset ) / sizeof( T );
+				h.size = 0;
+				h.checkpoints = 0;
+				mapped_impl::commit_fence( );
+				h.magic = magic;
+				return true;
+			}
+			if( not valid_header( ) ) {
+				m_region.close( );
+				return false;
+			}
+			return true;
+		}
+
+		void close( ) noexcept {
+			m_region.close( );
+		}
+
+		explicit operator bool( ) const noexcept {
+			return static_cast<bool>( m_region );
+		}
+
+		/// Flush the elements and then the header to storage
+		bool checkpoint( bool wait = true ) noexcept {
+			assert( m_region.writable( ) );
+			if( not m_region.sync( data_offset, m_region.size( ) - data_offset,
+			                       wait ) ) {
+				return false;
+			}
+			++header( )->checkpoints;
+			return m_region.sync( 0, sizeof( header_t ), wait );
+		}
+
+		/// The number of completed checkpoints over the life of the file
+		[[nodiscard]] std::uint64_t checkpoints( ) const noexcept {
+			return header( )->checkpoints;
+		}
+
+		[[nodiscard]] size_type size( ) const noexcept {
+			return m_region.data( ) ? static_cast<size_type>( header( )->size ) : 0U;
+		}
+
+		[[nodiscard]] size_type capacity( ) const noexcept {
+			return m_region.data( ) ? static_cast<size_type>( header( )->capacity )
+			                        : 0U;
+		}
+
+		[[nodiscard]] bool empty( ) const noexcept {
+			return size( ) == 0;
+		}
+
+		[[nodiscard]] pointer data( ) noexcept {
+			return reinterpret_cast<pointer>( m_region.data( ) + data_offset );
+		}
+
+		[[nodiscard]] const_pointer data( ) const noexcept {
+			return reinterpret_cast<const_pointer>( m_region.data( ) + data_offset );
+		}
+
+		[[nodiscard]] iterator begin( ) noexcept {
+			return data( );
+		}
+
+		[[nodiscard]] const_iterator begin( ) const noexcept {
+			return data( );
+		}
+
+		[[nodiscard]] iterator end( ) noexcept {
+			return data( ) + size( );
+		}
+
+		[[nodiscard]] const_iterator end( ) const noexcept {
+			return data( ) + size( );
+		}
+
+		[[nodiscard]] reference operator[]( size_type idx ) noexcept {
+			return data( )[idx];
+		}
+
+		[[nodiscard]] const_reference operator[]( size_type idx ) const noexcept {
+			return data( )[idx];
+		}
+
+		[[nodiscard]] reference front( ) noexcept {
+			return *data( );
+		}
+
+		[[nodiscard]] reference back( ) noexcept {
+			return data( )[size( ) - 1U];
+		}
+
+		/// Grow the file so that count elements fit.  Pointers into the
+		/// container are invalidated when it grows.
+		void reserve( size_type count ) {
+			assert( m_region.writable( ) );
+			if( count > capacity( ) and not grow_to( count ) ) {
+				DAW_THROW_OR_TERMINATE_NA( std::bad_alloc );
+			}
+		}
+
+		void push_back( T const &value ) {
+			auto const sz = size( );
+			if( sz == capacity( ) ) {
+				// value may refer to an element, which moves with the mapping
+				T const tmp = value;
+				reserve( std::max<size_type>( sz * 2U, 1U ) );
+				data( )[sz] = tmp;
+			} else {
+				data( )[sz] = value;
+			}
+			mapped_impl::commit_fence( );
+			header( )->size = sz + 1U;
+		}
+
+		void pop_back( ) noexcept {
+			assert( not empty( ) );
+			header( )->size = size( ) - 1U;
+		}
+
+		/// New elements are copies of value
+		void resize( size_type count, T const &value = T{ } ) {
+			auto const sz = size( );
+			if( count > sz ) {
+				T const tmp = value;
+				reserve( count );
+				std::fill( data( ) + sz, data( ) + count, tmp );
+				mapped_impl::commit_fence( );
+			}
+			header( )->size = count;
+		}
+
+		void clear( ) noexcept {
+			header( )->size = 0;
+		}
+	};
+} // namespace daw::filesystem
+#endif
@@ -23,6 +23,8 @@
 #include "daw/pipelines/flatten.h"
 #include "daw/pipelines/foreach.h"
 #include "daw/pipelines/generate.h"
+#include "daw/pipelines/generator.h"
+#include "daw/pipelines/group_by.h"
 #include "daw/pipelines/iota.h"
 #include "daw/pipelines/map.h"
 #include "daw/pipelines/maybe.h"
@@ -33,6 +35,7 @@
 #include "daw/pipelines/range.h"
 #include "daw/pipelines/reverse.h"
 #include "daw/pipelines/sample.h"
+#include "daw/pipelines/sketch.h"
 #include "daw/pipelines/skip.h"
 #include "daw/pipelines/slide.h"
 #include "daw/pipelines/split.h"
@@ -40,4 +43,5 @@
 #include "daw/pipelines/take.h"
 #include "daw/pipelines/to.h"
 #include "daw/pipelines/unique.h"
+#include "daw/pipelines/utf8.h"
 #include "daw/pipelines/zip.h"
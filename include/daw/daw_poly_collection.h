@@ -0,0 +1,479 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "ciso646.h"
+#include "daw_attributes.h"
+#include "daw_ensure.h"
+#include "daw_move.h"
+#include "daw_scope_guard.h"
+#include "daw_traits.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace daw {
+	/// @brief A stable reference to an element of a poly_collection.  It stays
+	/// valid while the element exists, regardless of other insertions and
+	/// erasures.  Handles of erased elements are detected and rejected.
+	struct poly_handle {
+		std::uint32_t type_index = std::numeric_limits<std::uint32_t>::max( );
+		std::uint32_t slot = 0;
+		std::uint32_t generation = 0;
+
+		[[nodiscard]] constexpr bool operator==( poly_handle const &rhs ) const {
+			return type_index == rhs.type_index and slot == rhs.slot and
+			       generation == rhs.generation;
+		}
+
+		[[nodiscard]] constexpr bool operator!=( poly_handle const &rhs ) const {
+			return not operator==( rhs );
+		}
+	};
+
+	/// @brief A view of the contiguous elements of one type in a
+	/// poly_collection
+	template<typename T>
+	struct poly_segment_view {
+		using value_type = T;
+		using pointer = T *;
+		using iterator = T *;
+
+	private:
+		T *m_first = nullptr;
+		std::size_t m_size = 0;
+
+	public:
+		constexpr poly_segment_view( ) = default;
+		constexpr poly_segment_view( T *first, std::size_t size ) noexcept
+		  : m_first( first )
+		  , m_size( size ) {}
+
+		[[nodiscard]] constexpr T *data( ) const noexcept {
+			return m_first;
+		}
+
+		[[nodiscard]] constexpr std::size_t size( ) const noexcept {
+			return m_size;
+		}
+
+		[[nodiscard]] constexpr bool empty( ) const noexcept {
+			return m_size == 0;
+		}
+
+		[[nodiscard]] constexpr T *begin( ) const noexcept {
+			return m_first;
+		}
+
+		[[nodiscard]] constexpr T *end( ) const noexcept {
+			return m_first + m_size;
+		}
+
+		[[nodiscard]] constexpr T &operator[]( std::size_t n ) const noexcept {
+			return m_first[n];
+		}
+	};
+
+	namespace poly_collection_impl {
+		inline constexpr std::uint32_t no_slot =
+		  std::numeric_limits<std::uint32_t>::max( );
+
+		/// @brief Dense storage for one concrete type.  Elements are kept packed
+		/// for iteration, erasure moves the last element into the hole.  A slot
+		/// table maps stable handles to the current position.
+		template<typename T>
+		class segment {
+			struct slot_t {
+				/// Position in m_values when live, next free slot when not
+				std::uint32_t index;
+				std::uint32_t generation;
+			};
+
+			std::vector<T> m_values{ };
+			std::vector<std::uint32_t> m_value_slots{ };
+			std::vector<slot_t> m_slots{ };
+			std::uint32_t m_free_head = no_slot;
+
+			[[nodiscard]] bool is_live( std::uint32_t slot,
+			                            std::uint32_t generation ) const {
+				if( slot >= m_slots.size( ) or
+				    m_slots[slot].generation != generation ) {
+					return false;
+				}
+				auto const idx = m_slots[slot].index;
+				return idx < m_values.size( ) and m_value_slots[idx] == slot;
+			}
+
+		public:
+			[[nodiscard]] std::size_t size( ) const noexcept {
+				return m_values.size( );
+			}
+
+			[[nodiscard]] T *data( ) noexcept {
+				return m_values.data( );
+			}
+
+			[[nodiscard]] T const *data( ) const noexcept {
+				return m_values.data( );
+			}
+
+			void reserve( std::size_t n ) {
+				m_values.reserve( n );
+				m_value_slots.reserve( n );
+				m_slots.reserve( n );
+			}
+
+			template<typename... Args>
+			[[nodiscard]] std::pair<std::uint32_t, std::uint32_t>
+			emplace( Args &&...args ) {
+				daw_ensure( m_values.size( ) < no_slot );
+				m_values.emplace_back( DAW_FWD( args )... );
+				auto const idx = static_cast<std::uint32_t>( m_values.size( ) - 1U );
+				std::uint32_t slot = m_free_head;
+				if( slot != no_slot ) {
+					m_free_head = m_slots[slot].index;
+					m_slots[slot].index = idx;
+				} else {
+					slot = static_cast<std::uint32_t>( m_slots.size( ) );
+					m_slots.push_back( slot_t{ idx, 0 } );
+				}
+				m_value_slots.push_back( slot );
+				return { slot, m_slots[slot].generation };
+			}
+
+			[[nodiscard]] T *get( std::uint32_t slot, std::uint32_t generation ) {
+				if( not is_live( slot, generation ) ) {
+					return nullptr;
+				}
+				return m_values.data( ) + m_slots[slot].index;
+			}
+
+			bool erase( std::uint32_t slot, std::uint32_t generation ) {
+				if( not is_live( slot, generation ) ) {
+					return false;
+				}
+				auto const idx = m_slots[slot].index;
+				auto const last = static_cast<std::uint32_t>( m_values.size( ) - 1U );
+				if( idx != last ) {
+					m_values[idx] = std::move( m_values[last] );
+					auto const moved_slot = m_value_slots[last];
+					m_value_slots[idx] = moved_slot;
+					m_slots[moved_slot].index = idx;
+				}
+				m_values.pop_back( );
+				m_value_slots.pop_back( );
+				++m_slots[slot].generation;
+				m_slots[slot].index = m_free_head;
+				m_free_head = slot;
+				return true;
+			}
+
+			void clear( ) {
+				for( auto slot : m_value_slots ) {
+					++m_slots[slot].generation;
+					m_slots[slot].index = m_free_head;
+					m_free_head = slot;
+				}
+				m_values.clear( );
+				m_value_slots.clear( );
+			}
+		};
+	} // namespace poly_collection_impl
+
+	/// @brief A container of objects derived from Base whose concrete type is
+	/// one of Types.  Each type is stored contiguously in its own segment, so
+	/// iteration visits one type at a time.  The callable given to for_each
+	/// is called with a T & whose dynamic type is exactly T; virtual calls are
+	/// perfectly predicted and are resolved statically when T is final or the
+	/// call is qualified, e.g. value.T::area( ).
+	/// Elements are addressed through stable poly_handle's.  Iteration order
+	/// is by type and, within a type, unspecified after an erase.
+	template<typename Base, typename... Types>
+	class poly_collection {
+		static_assert( sizeof...( Types ) > 0 );
+		static_assert( ( std::is_base_of_v<Base, Types> and ... ),
+		               "Types must be derived from Base" );
+		static_assert( daw::traits::are_unique_v<Types...>,
+		               "Types must be unique" );
+
+		std::tuple<poly_collection_impl::segment<Types>...> m_segments{ };
+
+		template<typename T>
+		static constexpr std::size_t type_index_of( ) {
+			constexpr int idx = daw::traits::pack_index_of<T, Types...>::value;
+			static_assert( idx >= 0, "T is not one of the collection's types" );
+			return static_cast<std::size_t>( idx );
+		}
+
+		template<typename T>
+		[[nodiscard]] poly_collection_impl::segment<T> &seg( ) {
+			return std::get<poly_collection_impl::segment<T>>( m_segments );
+		}
+
+		template<typename T>
+		[[nodiscard]] poly_collection_impl::segment<T> const &seg( ) const {
+			return std::get<poly_collection_impl::segment<T>>( m_segments );
+		}
+
+		template<typename T>
+		[[nodiscard]] static Base *get_base( poly_collection &c,
+		                                     poly_handle h ) {
+			return c.seg<T>( ).get( h.slot, h.generation );
+		}
+
+		template<typename T>
+		static bool erase_impl( poly_collection &c, poly_handle h ) {
+			return c.seg<T>( ).erase( h.slot, h.generation );
+		}
+
+		template<typename T, typename Function>
+		static void run_block( poly_collection &c, Function &f, std::size_t first,
+		                       std::size_t last ) {
+			T *const values = c.seg<T>( ).data( );
+			for( std::size_t n = first; n < last; ++n ) {
+				f( values[n] );
+			}
+		}
+
+	public:
+		using base_type = Base;
+		using handle_type = poly_handle;
+		static constexpr std::size_t type_count = sizeof...( Types );
+
+		poly_collection( ) = default;
+
+		template<typename T>
+		static constexpr std::size_t type_index = type_index_of<T>( );
+
+		template<typename T, typename... Args>
+		poly_handle emplace( Args &&...args ) {
+			auto const [slot, generation] = seg<T>( ).emplace( DAW_FWD( args )... );
+			return poly_handle{ static_cast<std::uint32_t>( type_index<T> ), slot,
+			                    generation };
+		}
+
+		template<typename T>
+		poly_handle insert( T &&value ) {
+			return emplace<daw::remove_cvref_t<T>>( DAW_FWD( value ) );
+		}
+
+		/// @return The element for h, or nullptr when h does not refer to a live
+		/// element
+		[[nodiscard]] Base *get( poly_handle h ) {
+			using getter_t = Base *( * )( poly_collection &, poly_handle );
+			static constexpr getter_t getters[] = { &get_base<Types>... };
+			if( h.type_index >= type_count ) {
+				return nullptr;
+			}
+			return getters[h.type_index]( *this, h );
+		}
+
+		[[nodiscard]] Base const *get( poly_handle h ) const {
+			return const_cast<poly_collection *>( this )->get( h );
+		}
+
+		/// @return The element for h if it is a live T, otherwise nullptr
+		template<typename T>
+		[[nodiscard]] T *get_if( poly_handle h ) {
+			if( h.type_index != type_index<T> ) {
+				return nullptr;
+			}
+			return seg<T>( ).get( h.slot, h.generation );
+		}
+
+		template<typename T>
+		[[nodiscard]] T const *get_if( poly_handle h ) const {
+			return const_cast<poly_collection *>( this )->template get_if<T>( h );
+		}
+
+		/// @pre contains( h )
+		[[nodiscard]] Base &operator[]( poly_handle h ) {
+			auto *result = get( h );
+			daw_ensure( result != nullptr );
+			return *result;
+		}
+
+		/// @pre contains( h )
+		[[nodiscard]] Base const &operator[]( poly_handle h ) const {
+			auto const *result = get( h );
+			daw_ensure( result != nullptr );
+			return *result;
+		}
+
+		[[nodiscard]] bool contains( poly_handle h ) const {
+			return get( h ) != nullptr;
+		}
+
+		/// @return true if h referred to a live element that has been erased
+		bool erase( poly_handle h ) {
+			using eraser_t = bool ( * )( poly_collection &, poly_handle );
+			static constexpr eraser_t erasers[] = { &erase_impl<Types>... };
+			if( h.type_index >= type_count ) {
+				return false;
+			}
+			return erasers[h.type_index]( *this, h );
+		}
+
+		void clear( ) {
+			std::apply(
+			  []( auto &...segs ) {
+				  ( segs.clear( ), ... );
+			  },
+			  m_segments );
+		}
+
+		template<typename T>
+		void reserve( std::size_t n ) {
+			seg<T>( ).reserve( n );
+		}
+
+		[[nodiscard]] std::size_t size( ) const {
+			return ( seg<Types>( ).size( ) + ... );
+		}
+
+		template<typename T>
+		[[nodiscard]] std::size_t size( ) const {
+			return seg<T>( ).size( );
+		}
+
+		[[nodiscard]] bool empty( ) const {
+			return size( ) == 0;
+		}
+
+		template<typename T>
+		[[nodiscard]] poly_segment_view<T> segment( ) {
+			auto &s = seg<T>( );
+			return { s.data( ), s.size( ) };
+		}
+
+		template<typename T>
+		[[nodiscard]] poly_segment_view<T const> segment( ) const {
+			auto const &s = seg<T>( );
+			return { s.data( ), s.size( ) };
+		}
+
+		/// @brief Call f( T & ) for every element, one segment at a time
+		template<typename Function>
+		void for_each( Function &&f ) {
+			( for_each_in<Types>( f ), ... );
+		}
+
+		template<typename Function>
+		void for_each( Function &&f ) const {
+			( for_each_in<Types>( f ), ... );
+		}
+
+		/// @brief Call f( T & ) for every element of the segment for T
+		template<typename T, typename Function>
+		void for_each_in( Function &&f ) {
+			auto &s = seg<T>( );
+			T *const first = s.data( );
+			std::size_t const sz = s.size( );
+			for( std::size_t n = 0; n < sz; ++n ) {
+				f( first[n] );
+			}
+		}
+
+		template<typename T, typename Function>
+		void for_each_in( Function &&f ) const {
+			auto const &s = seg<T>( );
+			T const *const first = s.data( );
+			std::size_t const sz = s.size( );
+			for( std::size_t n = 0; n < sz; ++n ) {
+				f( first[n] );
+			}
+		}
+
+		/// @brief Call f( T & ) for every element using up to thread_count
+		/// threads.  The segments are split into blocks of at least min_block
+		/// elements that are handed out to the threads, so f must be safe to
+		/// call concurrently on different elements.  The first exception thrown
+		/// by f is rethrown after all threads are done.
+		template<typename Function>
+		void parallel_for_each(
+		  Function &&f,
+		  std::size_t thread_count = std::thread::hardware_concurrency( ),
+		  std::size_t min_block = 4096 ) {
+			struct task_t {
+				std::size_t type_index;
+				std::size_t first;
+				std::size_t last;
+			};
+			using runner_t = void ( * )( poly_collection &, Function &, std::size_t,
+			                             std::size_t );
+			static constexpr runner_t runners[] = {
+			  &run_block<Types, Function>... };
+
+			thread_count = std::max<std::size_t>( thread_count, 1 );
+			min_block = std::max<std::size_t>( min_block, 1 );
+			auto const sizes = std::array<std::size_t, type_count>{
+			  seg<Types>( ).size( )... };
+			auto const total = size( );
+			auto const block =
+			  std::max( min_block, ( total + thread_count - 1 ) / thread_count );
+			auto tasks = std::vector<task_t>( );
+			for( std::size_t t = 0; t < type_count; ++t ) {
+				for( std::size_t first = 0; first < sizes[t]; first += block ) {
+					tasks.push_back(
+					  task_t{ t, first, std::min( sizes[t], first + block ) } );
+				}
+			}
+			if( tasks.empty( ) ) {
+				return;
+			}
+			auto next = std::atomic<std::size_t>{ 0 };
+			auto error = std::exception_ptr{ };
+			auto has_error = std::atomic<bool>{ false };
+			auto const worker = [&] {
+				for( auto n = next.fetch_add( 1, std::memory_order_relaxed );
+				     n < tasks.size( );
+				     n = next.fetch_add( 1, std::memory_order_relaxed ) ) {
+					auto const &task = tasks[n];
+					try {
+						runners[task.type_index]( *this, f, task.first, task.last );
+					} catch( ... ) {
+						if( not has_error.exchange( true ) ) {
+							error = std::current_exception( );
+						}
+						next.store( tasks.size( ), std::memory_order_relaxed );
+					}
+				}
+			};
+			auto threads = std::vector<std::thread>( );
+			// When starting a thread throws, stop handing out tasks and join the
+			// threads already running before unwinding
+			auto join_all = on_scope_exit( [&] {
+				next.store( tasks.size( ), std::memory_order_relaxed );
+				for( auto &th : threads ) {
+					th.join( );
+				}
+			} );
+			auto const extra = std::min( thread_count, tasks.size( ) ) - 1U;
+			threads.reserve( extra );
+			for( std::size_t n = 0; n < extra; ++n ) {
+				threads.emplace_back( worker );
+			}
+			worker( );
+			join_all.run_now( );
+			if( error ) {
+				std::rethrow_exception( error );
+			}
+		}
+	};
+} // namespace daw
@@ -0,0 +1,39 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/daw_attributes.h"
+#include "daw/daw_cpp_feature_check.h"
+
+#if defined( DAW_HAS_MSVC ) and ( defined( _M_X64 ) or defined( _M_IX86 ) )
+#include <xmmintrin.h>
+#endif
+
+namespace daw {
+	/// @brief Hint that the cache line holding ptr will be read soon.  This is a
+	/// no-op on compilers without a prefetch intrinsic
+	DAW_ATTRIB_INLINE void prefetch( void const *ptr ) noexcept {
+#if defined( DAW_HAS_GCC_LIKE ) or DAW_HAS_BUILTIN( __builtin_prefetch )
+		__builtin_prefetch( ptr, 0, 3 );
+#elif defined( DAW_HAS_MSVC ) and ( defined( _M_X64 ) or defined( _M_IX86 ) )
+		_mm_prefetch( static_cast<char const *>( ptr ), _MM_HINT_T0 );
+#else
+		(void)ptr;
+#endif
+	}
+
+	/// @brief Hint that the cache line holding ptr will be written soon
+	DAW_ATTRIB_INLINE void prefetch_write( void const *ptr ) noexcept {
+#if defined( DAW_HAS_GCC_LIKE ) or DAW_HAS_BUILTIN( __builtin_prefetch )
+		__builtin_prefetch( ptr, 1, 3 );
+#else
+		prefetch( ptr );
+#endif
+	}
+} // namespace daw
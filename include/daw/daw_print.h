@@ -10,12 +10,19 @@
 
 #include "daw_formatters.h"
 #include "daw_move.h"
+#include "format.h"
 #include "traits/daw_formatter.h"
 
+#include <array>
 #include <cstdio>
 #include <format>
+#include <string>
 #include <utility>
 
+#if defined( DAW_PRINT_BUFFERED_STDOUT )
+#include "daw_print_buffered.h"
+#endif
+
 namespace daw {
 	template<typename... Args>
 	DAW_ATTRIB_NOINLINE void print( FILE *fout, std::format_string<Args...> fmt,
@@ -32,15 +39,26 @@ namespace daw {
 		(void)std::fwrite( std::data( r ), 1, r.size( ), fout );
 	}
 
+	/// When DAW_PRINT_BUFFERED_STDOUT is defined, the overloads that print to
+	/// stdout without a FILE * go through default_print_sink( ), so that their
+	/// output is not reordered with the sink's
 	template<typename... Args>
 	DAW_ATTRIB_NOINLINE void print( std::format_string<Args...> fmt,
 	                                Args &&...args ) {
+#if defined( DAW_PRINT_BUFFERED_STDOUT )
+		daw::print( default_print_sink( ), std::move( fmt ), DAW_FWD( args )... );
+#else
 		daw::print( stdout, std::move( fmt ), DAW_FWD( args )... );
+#endif
 	}
 
 	template<typename... Args>
 	DAW_ATTRIB_NOINLINE void vprint( std::string_view fmt, Args &&...args ) {
+#if defined( DAW_PRINT_BUFFERED_STDOUT )
+		daw::vprint( default_print_sink( ), fmt, DAW_FWD( args )... );
+#else
 		vprint( stdout, fmt, DAW_FWD( args )... );
+#endif
 	}
 
 	template<typename... Args>
@@ -60,19 +78,93 @@ namespace daw {
 	template<typename... Args>
 	DAW_ATTRIB_NOINLINE void println( std::format_string<Args...> fmt,
 	                                  Args &&...args ) {
+#if defined( DAW_PRINT_BUFFERED_STDOUT )
+		daw::println( default_print_sink( ), std::move( fmt ), DAW_FWD( args )... );
+#else
 		daw::print( stdout, "{}\n",
 		            std::format( std::move( fmt ), DAW_FWD( args )... ) );
+#endif
 	}
 
 	template<typename... Args>
 	DAW_ATTRIB_NOINLINE void vprintln( std::string fmt, Args &&...args ) {
+#if defined( DAW_PRINT_BUFFERED_STDOUT )
+		daw::vprintln( default_print_sink( ), fmt, DAW_FWD( args )... );
+#else
 		fmt += '\n';
 		daw::print( stdout, fmt, DAW_FWD( args )... );
+#endif
 	}
 
 	DAW_ATTRIB_INLINE void println( ) {
+#if defined( DAW_PRINT_BUFFERED_STDOUT )
+		daw::println( default_print_sink( ) );
+#else
 		std::putchar( '\n' );
+#endif
+	}
+
+#if defined( DAW_HAS_CPP20_CLASS_NTTP )
+	namespace print_impl {
+		/// Compiled formats with a static size bound up to this are formatted
+		/// on the stack
+		inline constexpr std::size_t max_stack_format_size = 1024;
+
+		template<bool AddNewline, format_literal Fmt, typename... Args>
+		void print_compiled( FILE *fout, compiled_format<Fmt> fmt,
+		                     Args const &...args ) {
+			constexpr auto max_size =
+			  compiled_format<Fmt>::template max_size<Args...>( );
+			if constexpr( max_size <= max_stack_format_size ) {
+				auto buff = std::array<char, max_size + 1>{ };
+				char *last = daw::format_to( buff.data( ), fmt, args... );
+				if constexpr( AddNewline ) {
+					*last++ = '\n';
+				}
+				(void)std::fwrite( buff.data( ), 1,
+				                   static_cast<std::size_t>( last - buff.data( ) ),
+				                   fout );
+			} else {
+				auto r = daw::format( fmt, args... );
+				if constexpr( AddNewline ) {
+					r.push_back( '\n' );
+				}
+				(void)std::fwrite( std::data( r ), 1, r.size( ), fout );
+			}
+		}
+	} // namespace print_impl
+
+	/// @brief Print using a format string parsed at compile time, e.g.
+	/// daw::print( daw::compiled_fmt<"{} = {}">, name, value ).  Text with a
+	/// static size bound is formatted on the stack without allocating
+	template<format_literal Fmt, typename... Args>
+	void print( FILE *fout, compiled_format<Fmt> fmt, Args const &...args ) {
+		print_impl::print_compiled<false>( fout, fmt, args... );
+	}
+
+	template<format_literal Fmt, typename... Args>
+	void println( FILE *fout, compiled_format<Fmt> fmt, Args const &...args ) {
+		print_impl::print_compiled<true>( fout, fmt, args... );
+	}
+
+	template<format_literal Fmt, typename... Args>
+	void print( compiled_format<Fmt> fmt, Args const &...args ) {
+#if defined( DAW_PRINT_BUFFERED_STDOUT )
+		daw::print( default_print_sink( ), fmt, args... );
+#else
+		daw::print( stdout, fmt, args... );
+#endif
+	}
+
+	template<format_literal Fmt, typename... Args>
+	void println( compiled_format<Fmt> fmt, Args const &...args ) {
+#if defined( DAW_PRINT_BUFFERED_STDOUT )
+		daw::println( default_print_sink( ), fmt, args... );
+#else
+		daw::println( stdout, fmt, args... );
+#endif
 	}
+#endif
 
 	template<typename... Args>
 	void dump( Args &&...args ) {
@@ -0,0 +1,86 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw_move.h"
+#include "daw_print_sink.h"
+#include "format.h"
+
+#include <format>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <utility>
+
+/// print/println overloads that format into a buffered_print_sink.  They are
+/// included by daw_print.h when DAW_PRINT_BUFFERED_STDOUT is defined
+namespace daw {
+	/// @brief Format directly into the calling thread's buffer in sink.  No
+	/// temporary string is created
+	template<typename... Args>
+	void print( buffered_print_sink &sink, std::format_string<Args...> fmt,
+	            Args &&...args ) {
+		sink.append_with( [&]( std::string &buf ) {
+			(void)std::format_to( std::back_inserter( buf ), std::move( fmt ),
+			                      DAW_FWD( args )... );
+		} );
+	}
+
+	template<typename... Args>
+	void vprint( buffered_print_sink &sink, std::string_view fmt,
+	             Args &&...args ) {
+		sink.append_with( [&]( std::string &buf ) {
+			(void)std::vformat_to( std::back_inserter( buf ), fmt,
+			                       std::make_format_args( args... ) );
+		} );
+	}
+
+	template<typename... Args>
+	void println( buffered_print_sink &sink, std::format_string<Args...> fmt,
+	              Args &&...args ) {
+		sink.append_with( [&]( std::string &buf ) {
+			(void)std::format_to( std::back_inserter( buf ), std::move( fmt ),
+			                      DAW_FWD( args )... );
+			buf.push_back( '\n' );
+		} );
+	}
+
+	template<typename... Args>
+	void vprintln( buffered_print_sink &sink, std::string_view fmt,
+	               Args &&...args ) {
+		sink.append_with( [&]( std::string &buf ) {
+			(void)std::vformat_to( std::back_inserter( buf ), fmt,
+			                       std::make_format_args( args... ) );
+			buf.push_back( '\n' );
+		} );
+	}
+
+	inline void println( buffered_print_sink &sink ) {
+		sink.write( "\n" );
+	}
+
+#if defined( DAW_HAS_CPP20_CLASS_NTTP )
+	template<format_literal Fmt, typename... Args>
+	void print( buffered_print_sink &sink, compiled_format<Fmt> fmt,
+	            Args const &...args ) {
+		sink.append_with( [&]( std::string &buf ) {
+			(void)daw::format_append( buf, fmt, args... );
+		} );
+	}
+
+	template<format_literal Fmt, typename... Args>
+	void println( buffered_print_sink &sink, compiled_format<Fmt> fmt,
+	              Args const &...args ) {
+		sink.append_with( [&]( std::string &buf ) {
+			(void)daw::format_append( buf, fmt, args... );
+			buf.push_back( '\n' );
+		} );
+	}
+#endif
+} // namespace daw
@@ -0,0 +1,419 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/ciso646.h"
+#include "daw/daw_attributes.h"
+#include "daw/daw_ensure.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if not defined( _MSC_VER ) and not defined( __MINGW32__ )
+#include <cerrno>
+#include <sys/uio.h>
+#include <unistd.h>
+#define DAW_PRINT_SINK_HAS_POSIX_IO
+#endif
+
+namespace daw {
+	struct print_sink_options {
+		/// A thread's buffer is written out once it holds at least this many
+		/// bytes
+		std::size_t flush_threshold = 64U * 1024U;
+		/// Buffered text is written out at least this often.  In synchronous
+		/// mode a thread checks it every 64th time it prints, so a thread that
+		/// prints rarely relies on the other flush triggers.  In async mode the
+		/// writer thread wakes up at this interval.  Zero disables the timer
+		std::chrono::milliseconds flush_interval{ 100 };
+		/// Gather the buffers of all threads into one writev call when flushing
+		bool use_writev = true;
+		/// Use a background writer thread for flushing.  Printing threads only
+		/// write themselves when their buffer exceeds 4 * flush_threshold
+		bool async = false;
+	};
+
+	namespace print_sink_impl {
+		/// Number of buffers handed to one writev call.  POSIX guarantees at
+		/// least 16, Linux and the BSDs allow 1024
+		inline constexpr std::size_t max_iov = 1024;
+
+		struct thread_buffer {
+			std::mutex mut{ };
+			/// Appended to by the owning thread while holding mut
+			std::string active{ };
+			/// Only touched by the thread holding the sink's write mutex
+			std::string standby{ };
+			std::chrono::steady_clock::time_point last_flush =
+			  std::chrono::steady_clock::now( );
+			/// Appends since the clock was last checked, only used by the owner
+			std::uint32_t appends_since_check = 0;
+		};
+
+		/// Reading the clock costs as much as a short append, so the flush
+		/// timer is only checked every clock_check_interval appends
+		inline constexpr std::uint32_t clock_check_interval = 64;
+
+		class sink_state {
+			std::FILE *m_file;
+			print_sink_options m_opts;
+			std::mutex m_registry_mut{ };
+			std::vector<std::shared_ptr<thread_buffer>> m_buffers{ };
+			/// Serializes writes to the output and access to standby buffers.
+			/// Lock order is m_write_mut, then a thread_buffer's mut
+			std::mutex m_write_mut{ };
+			std::condition_variable m_cv{ };
+			std::mutex m_cv_mut{ };
+			bool m_stop = false;
+			bool m_pending = false;
+			std::thread m_writer{ };
+
+			void write_bytes( char const *ptr, std::size_t size ) {
+#if defined( DAW_PRINT_SINK_HAS_POSIX_IO )
+				int const fd = ::fileno( m_file );
+				while( size > 0 ) {
+					auto const r = ::write( fd, ptr, size );
+					if( r < 0 ) {
+						if( errno == EINTR ) {
+							continue;
+						}
+						return;
+					}
+					ptr += r;
+					size -= static_cast<std::size_t>( r );
+				}
+#else
+				(void)std::fwrite( ptr, 1, size, m_file );
+#endif
+			}
+
+#if defined( DAW_PRINT_SINK_HAS_POSIX_IO )
+			/// writev handling partial writes.  iov is modified
+			void write_iov( ::iovec *iov, std::size_t count ) {
+				int const fd = ::fileno( m_file );
+				while( count > 0 ) {
+					auto r = ::writev( fd, iov, static_cast<int>( count ) );
+					if( r < 0 ) {
+						if( errno == EINTR ) {
+							continue;
+						}
+						return;
+					}
+					auto written = static_cast<std::size_t>( r );
+					while( count > 0 and written >= iov->iov_len ) {
+						written -= iov->iov_len;
+						++iov;
+						--count;
+					}
+					if( count > 0 ) {
+						iov->iov_base = static_cast<char *>( iov->iov_base ) + written;
+						iov->iov_len -= written;
+					}
+				}
+			}
+#endif
+
+			/// Move buf's text to its standby buffer
+			/// @pre m_write_mut is held
+			static bool take( thread_buffer &buf ) {
+				auto const lck = std::lock_guard( buf.mut );
+				buf.last_flush = std::chrono::steady_clock::now( );
+				if( buf.active.empty( ) ) {
+					return false;
+				}
+				std::swap( buf.active, buf.standby );
+				return true;
+			}
+
+			/// @pre m_write_mut is held
+			void flush_one_locked( thread_buffer &buf ) {
+				if( take( buf ) ) {
+					write_bytes( buf.standby.data( ), buf.standby.size( ) );
+					buf.standby.clear( );
+				}
+			}
+
+			void writer_loop( ) {
+				auto lck = std::unique_lock( m_cv_mut );
+				while( not m_stop ) {
+					auto const has_work = [&] {
+						return m_stop or m_pending;
+					};
+					if( m_opts.flush_interval.count( ) > 0 ) {
+						(void)m_cv.wait_for( lck, m_opts.flush_interval, has_work );
+					} else {
+						m_cv.wait( lck, has_work );
+					}
+					m_pending = false;
+					lck.unlock( );
+					flush_all( );
+					lck.lock( );
+				}
+			}
+
+		public:
+			sink_state( std::FILE *f, print_sink_options opts )
+			  : m_file( f )
+			  , m_opts( opts ) {
+				daw_ensure( f != nullptr );
+				(void)std::fflush( m_file );
+				if( m_opts.async ) {
+					m_writer = std::thread( [this] {
+						writer_loop( );
+					} );
+				}
+			}
+
+			sink_state( sink_state const & ) = delete;
+			sink_state &operator=( sink_state const & ) = delete;
+
+			~sink_state( ) {
+				stop( );
+				flush_all( );
+			}
+
+			void stop( ) {
+				if( not m_writer.joinable( ) ) {
+					return;
+				}
+				{
+					auto const lck = std::lock_guard( m_cv_mut );
+					m_stop = true;
+				}
+				m_cv.notify_one( );
+				m_writer.join( );
+			}
+
+			[[nodiscard]] print_sink_options const &options( ) const {
+				return m_opts;
+			}
+
+			[[nodiscard]] std::shared_ptr<thread_buffer> add_buffer( ) {
+				auto result = std::make_shared<thread_buffer>( );
+				result->active.reserve( m_opts.flush_threshold );
+				result->standby.reserve( m_opts.flush_threshold );
+				auto const lck = std::lock_guard( m_registry_mut );
+				m_buffers.push_back( result );
+				return result;
+			}
+
+			void remove_buffer( thread_buffer &buf ) {
+				flush_one( buf );
+				auto const lck = std::lock_guard( m_registry_mut );
+				auto pos = std::find_if( m_buffers.begin( ), m_buffers.end( ),
+				                         [&]( auto const &p ) {
+					                         return p.get( ) == &buf;
+				                         } );
+				if( pos != m_buffers.end( ) ) {
+					m_buffers.erase( pos );
+				}
+			}
+
+			void flush_one( thread_buffer &buf ) {
+				auto const lck = std::lock_guard( m_write_mut );
+				flush_one_locked( buf );
+			}
+
+			/// Write out the buffers of every thread.  With use_writev the
+			/// buffers are gathered into as few writev calls as possible
+			void flush_all( ) {
+				auto bufs = [&] {
+					auto const lck = std::lock_guard( m_registry_mut );
+					return m_buffers;
+				}( );
+				auto const lck = std::lock_guard( m_write_mut );
+#if defined( DAW_PRINT_SINK_HAS_POSIX_IO )
+				if( m_opts.use_writev ) {
+					auto iov = std::vector<::iovec>( );
+					iov.reserve( std::min( bufs.size( ), max_iov ) );
+					auto const write_out = [&] {
+						write_iov( iov.data( ), iov.size( ) );
+						iov.clear( );
+					};
+					for( auto const &b : bufs ) {
+						if( take( *b ) ) {
+							iov.push_back( ::iovec{ b->standby.data( ), b->standby.size( ) } );
+							if( iov.size( ) == max_iov ) {
+								write_out( );
+							}
+						}
+					}
+					write_out( );
+					for( auto const &b : bufs ) {
+						b->standby.clear( );
+					}
+					return;
+				}
+#endif
+				for( auto const &b : bufs ) {
+					flush_one_locked( *b );
+				}
+#if not defined( DAW_PRINT_SINK_HAS_POSIX_IO )
+				(void)std::fflush( m_file );
+#endif
+			}
+
+			/// Called by the printing thread after appending to buf
+			void after_append( thread_buffer &buf, std::size_t buffered ) {
+				if( m_opts.async ) {
+					if( buffered >= m_opts.flush_threshold * 4U ) {
+						// The writer thread is falling behind, apply back pressure
+						flush_one( buf );
+					} else if( buffered >= m_opts.flush_threshold ) {
+						{
+							auto const lck = std::lock_guard( m_cv_mut );
+							m_pending = true;
+						}
+						m_cv.notify_one( );
+					}
+					return;
+				}
+				if( buffered >= m_opts.flush_threshold ) {
+					flush_one( buf );
+				} else if( m_opts.flush_interval.count( ) > 0 and
+				           ++buf.appends_since_check >= clock_check_interval ) {
+					buf.appends_since_check = 0;
+					if( std::chrono::steady_clock::now( ) - buf.last_flush >=
+					    m_opts.flush_interval ) {
+						flush_one( buf );
+					}
+				}
+			}
+		};
+
+		/// The per thread view of the sinks the thread has printed to
+		class thread_handles {
+			struct entry {
+				sink_state const *owner;
+				std::weak_ptr<sink_state> state;
+				std::shared_ptr<thread_buffer> buffer;
+			};
+			std::vector<entry> m_entries{ };
+
+		public:
+			thread_handles( ) = default;
+			thread_handles( thread_handles const & ) = delete;
+			thread_handles &operator=( thread_handles const & ) = delete;
+
+			~thread_handles( ) {
+				for( auto &e : m_entries ) {
+					if( auto s = e.state.lock( ) ) {
+						s->remove_buffer( *e.buffer );
+					}
+				}
+			}
+
+			[[nodiscard]] thread_buffer &
+			get( std::shared_ptr<sink_state> const &state ) {
+				for( auto &e : m_entries ) {
+					if( e.owner == state.get( ) ) {
+						return *e.buffer;
+					}
+				}
+				// Forget sinks that no longer exist, their address may be reused
+				m_entries.erase( std::remove_if( m_entries.begin( ), m_entries.end( ),
+				                                 []( entry const &e ) {
+					                                 return e.state.expired( );
+				                                 } ),
+				                 m_entries.end( ) );
+				m_entries.push_back( entry{ state.get( ), state, state->add_buffer( ) } );
+				return *m_entries.back( ).buffer;
+			}
+		};
+
+		[[nodiscard]] inline thread_handles &get_thread_handles( ) {
+			thread_local thread_handles handles{ };
+			return handles;
+		}
+	} // namespace print_sink_impl
+
+	/// @brief A buffered output sink for high rate printing.  Each thread
+	/// appends to its own reusable buffer, so printing a line does not allocate
+	/// or take a shared lock.  Buffers are written when they pass
+	/// flush_threshold, when flush_interval has passed, on flush( ), when the
+	/// thread exits, and when the sink is destroyed.  Text from one print call
+	/// is never split, but the relative order of lines from different threads
+	/// is only preserved up to the flush granularity.
+	class buffered_print_sink {
+		std::shared_ptr<print_sink_impl::sink_state> m_state;
+
+		[[nodiscard]] print_sink_impl::thread_buffer &buffer( ) const {
+			return print_sink_impl::get_thread_handles( ).get( m_state );
+		}
+
+	public:
+		explicit buffered_print_sink( std::FILE *f = stdout,
+		                              print_sink_options opts = { } )
+		  : m_state(
+		      std::make_shared<print_sink_impl::sink_state>( f, std::move( opts ) ) ) {
+		}
+
+		buffered_print_sink( buffered_print_sink const & ) = delete;
+		buffered_print_sink &operator=( buffered_print_sink const & ) = delete;
+
+		~buffered_print_sink( ) {
+			m_state->stop( );
+			m_state->flush_all( );
+		}
+
+		[[nodiscard]] print_sink_options const &options( ) const {
+			return m_state->options( );
+		}
+
+		/// @brief Append to the calling thread's buffer.  f is called with the
+		/// std::string buffer and must only append to it, e.g. with
+		/// std::format_to( std::back_inserter( buf ), ... )
+		template<typename Appender>
+		DAW_ATTRIB_INLINE void append_with( Appender &&f ) {
+			auto &buf = buffer( );
+			std::size_t buffered = 0;
+			{
+				auto const lck = std::lock_guard( buf.mut );
+				f( buf.active );
+				buffered = buf.active.size( );
+			}
+			m_state->after_append( buf, buffered );
+		}
+
+		void write( std::string_view text ) {
+			append_with( [&]( std::string &buf ) {
+				buf.append( text );
+			} );
+		}
+
+		void write_line( std::string_view text ) {
+			append_with( [&]( std::string &buf ) {
+				buf.append( text );
+				buf.push_back( '\n' );
+			} );
+		}
+
+		/// @brief Write the buffered text of all threads
+		void flush( ) {
+			m_state->flush_all( );
+		}
+	};
+
+	/// @brief The sink used for stdout by the buffered print overloads
+	[[nodiscard]] inline buffered_print_sink &default_print_sink( ) {
+		static buffered_print_sink sink( stdout );
+		return sink;
+	}
+} // namespace daw
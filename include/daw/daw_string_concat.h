@@ -8,13 +8,26 @@
 
 #pragma once
 
+#include "daw/ciso646.h"
+#include "daw/daw_attributes.h"
+#include "daw/daw_cxmath.h"
+#include "daw/daw_ensure.h"
+#include "daw/traits/daw_traits_is_span_writer.h"
 #include "daw_move.h"
 
 #include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <exception>
 #include <iterator>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 
 namespace daw::string_concat_impl {
 	template<std::size_t StringCount>
@@ -156,3 +169,307 @@ namespace daw {
 		return arg;
 	}
 } // namespace daw
+
+namespace daw::string_concat_impl {
+	/// @brief A segment that is already contiguous text, copied with memcpy
+	struct text_piece {
+		char const *ptr = nullptr;
+		std::size_t len = 0;
+
+		[[nodiscard]] constexpr std::size_t size( ) const noexcept {
+			return len;
+		}
+
+		DAW_ATTRIB_INLINE char *write( char *out ) const noexcept {
+			if( len != 0 ) {
+				std::memcpy( out, ptr, len );
+			}
+			return out + len;
+		}
+	};
+
+	struct char_piece {
+		char value;
+
+		[[nodiscard]] constexpr std::size_t size( ) const noexcept {
+			return 1;
+		}
+
+		DAW_ATTRIB_INLINE char *write( char *out ) const noexcept {
+			*out = value;
+			return out + 1;
+		}
+	};
+
+	inline constexpr char digit_pairs[201] =
+	  "00010203040506070809101112131415161718192021222324252627282930313233343536"
+	  "37383940414243444546474849505152535455565758596061626364656667686970717273"
+	  "7475767778798081828384858687888990919293949596979899";
+
+	/// @brief An integer segment.  The digit count is known up front via
+	/// count_digits, so the digits are written backwards directly into the
+	/// destination two at a time
+	struct integer_piece {
+		std::uint64_t magnitude;
+		std::size_t digits;
+		bool is_negative;
+
+		template<typename Integer>
+		explicit constexpr integer_piece( Integer value ) noexcept
+		  : magnitude( to_magnitude( value ) )
+		  , digits( static_cast<std::size_t>(
+		      daw::cxmath::count_digits( magnitude ) ) )
+		  , is_negative( value < 0 ) {}
+
+		[[nodiscard]] constexpr std::size_t size( ) const noexcept {
+			return digits + ( is_negative ? 1U : 0U );
+		}
+
+		DAW_ATTRIB_INLINE char *write( char *out ) const noexcept {
+			if( is_negative ) {
+				*out++ = '-';
+			}
+			char *const last = out + digits;
+			char *ptr = last;
+			auto v = magnitude;
+			while( v >= 100U ) {
+				auto const idx = static_cast<std::size_t>( v % 100U ) * 2U;
+				v /= 100U;
+				ptr -= 2;
+				ptr[0] = digit_pairs[idx];
+				ptr[1] = digit_pairs[idx + 1];
+			}
+			if( v >= 10U ) {
+				auto const idx = static_cast<std::size_t>( v ) * 2U;
+				ptr -= 2;
+				ptr[0] = digit_pairs[idx];
+				ptr[1] = digit_pairs[idx + 1];
+			} else {
+				*--ptr = static_cast<char>( '0' + static_cast<char>( v ) );
+			}
+			return last;
+		}
+
+	private:
+		template<typename Integer>
+		[[nodiscard]] static constexpr std::uint64_t
+		to_magnitude( Integer value ) noexcept {
+			static_assert( sizeof( Integer ) <= sizeof( std::uint64_t ),
+			               "Integers wider than 64bits are not supported" );
+			if constexpr( std::is_signed_v<Integer> ) {
+				if( value < 0 ) {
+					return std::uint64_t{ 0 } - static_cast<std::uint64_t>( value );
+				}
+			}
+			return static_cast<std::uint64_t>( value );
+		}
+	};
+
+	/// @brief A floating point segment.  The shortest round trip
+	/// representation is formatted once into a local buffer to learn its size
+	struct float_piece {
+		std::array<char, 64> buff;
+		std::size_t len;
+
+		template<typename Float>
+		explicit float_piece( Float value ) noexcept {
+			auto const r =
+			  std::to_chars( buff.data( ), buff.data( ) + buff.size( ), value );
+			daw_dbg_ensure( r.ec == std::errc{ } );
+			len = static_cast<std::size_t>( r.ptr - buff.data( ) );
+		}
+
+		[[nodiscard]] constexpr std::size_t size( ) const noexcept {
+			return len;
+		}
+
+		DAW_ATTRIB_INLINE char *write( char *out ) const noexcept {
+			std::memcpy( out, buff.data( ), len );
+			return out + len;
+		}
+	};
+
+	template<typename T, typename = void>
+	inline constexpr bool is_char_range_v = false;
+
+	/// Contiguous ranges of char, e.g. daw::string_view or daw::vector<char>
+	template<typename T>
+	inline constexpr bool is_char_range_v<
+	  T, std::enable_if_t<
+	       std::is_convertible_v<decltype( std::data( std::declval<T const &>( ) ) ),
+	                             char const *>,
+	       std::void_t<decltype( std::size( std::declval<T const &>( ) ) )>>> =
+	  true;
+
+	template<typename T>
+	[[nodiscard]] DAW_ATTRIB_INLINE auto make_piece( T const &value ) {
+		if constexpr( std::is_same_v<T, char> ) {
+			return char_piece{ value };
+		} else if constexpr( std::is_same_v<T, bool> ) {
+			return value ? text_piece{ "true", 4 } : text_piece{ "false", 5 };
+		} else if constexpr( std::is_integral_v<T> ) {
+			return integer_piece( value );
+		} else if constexpr( std::is_floating_point_v<T> ) {
+			return float_piece( value );
+		} else if constexpr( std::is_convertible_v<T const &, std::string_view> ) {
+			auto const sv = std::string_view( value );
+			return text_piece{ sv.data( ), sv.size( ) };
+		} else {
+			static_assert( is_char_range_v<T>,
+			               "Unsupported argument type.  Expected a string like "
+			               "type, character, integer, or floating point number" );
+			return text_piece{ std::data( value ),
+			                   static_cast<std::size_t>( std::size( value ) ) };
+		}
+	}
+
+	struct overwrite_probe {
+		std::size_t operator( )( char *, std::size_t n ) const noexcept {
+			return n;
+		}
+	};
+
+	template<typename Container, typename = void>
+	inline constexpr bool has_resize_and_overwrite_v = false;
+
+	template<typename Container>
+	inline constexpr bool has_resize_and_overwrite_v<
+	  Container,
+	  std::void_t<decltype( std::declval<Container &>( ).resize_and_overwrite(
+	    std::declval<std::size_t>( ), overwrite_probe{ } ) )>> = true;
+
+	/// @brief Grow out by exactly count characters and let writer fill them
+	/// from the old end.  Containers with a resize_and_overwrite member, such
+	/// as daw::vector and std::string from C++23, skip zeroing memory that is
+	/// immediately overwritten.  Others, including std::string before C++23,
+	/// are zero filled by resize first
+	template<typename Container, typename Writer>
+	DAW_ATTRIB_INLINE void append_exact( Container &out, std::size_t count,
+	                                     Writer &&writer ) {
+		auto const old_size = static_cast<std::size_t>( out.size( ) );
+		auto const new_size = old_size + count;
+		if constexpr( has_resize_and_overwrite_v<Container> ) {
+			out.resize_and_overwrite( new_size, [&]( char *p, std::size_t n ) {
+				(void)writer( p + old_size );
+				return n;
+			} );
+		} else {
+			out.resize( new_size );
+			(void)writer( std::data( out ) + old_size );
+		}
+	}
+
+	template<typename... Pieces>
+	[[nodiscard]] DAW_ATTRIB_INLINE char *
+	write_pieces( char *out, Pieces const &...pieces ) noexcept {
+		( (void)( out = pieces.write( out ) ), ... );
+		return out;
+	}
+} // namespace daw::string_concat_impl
+
+namespace daw {
+	/// @brief The exact number of characters that concat will produce for args
+	template<typename... Args>
+	[[nodiscard]] std::size_t concat_size( Args const &...args ) {
+		return ( std::size_t{ 0 } + ... +
+		         string_concat_impl::make_piece( args ).size( ) );
+	}
+
+	/// @brief Append the text of args to out, growing it exactly once.
+	/// Container is a contiguous character container such as std::string or
+	/// daw::vector<char>
+	/// @return out
+	template<typename Container, typename... Args>
+	Container &concat_append( Container &out, Args const &...args ) {
+		return std::apply(
+		  [&]( auto const &...pieces ) -> Container & {
+			  string_concat_impl::append_exact(
+			    out, ( std::size_t{ 0 } + ... + pieces.size( ) ),
+			    [&]( char *p ) {
+				    return string_concat_impl::write_pieces( p, pieces... );
+			    } );
+			  return out;
+		  },
+		  std::tuple{ string_concat_impl::make_piece( args )... } );
+	}
+
+	/// @brief Concatenate the text of args into a new string with a single
+	/// allocation.  Arguments can be string like, characters, bool, integers or
+	/// floating point numbers.  Numbers are written as std::to_chars would
+	template<typename Result = std::string, typename... Args>
+	[[nodiscard]] Result concat( Args const &...args ) {
+		auto result = Result( );
+		(void)concat_append( result, args... );
+		return result;
+	}
+
+	/// @brief Write the text of args to the buffer starting at out.  The
+	/// buffer must have room for concat_size( args... ) characters
+	/// @return One past the last character written
+	template<typename... Args>
+	char *concat_to( char *out, Args const &...args ) {
+		return string_concat_impl::write_pieces(
+		  out, string_concat_impl::make_piece( args )... );
+	}
+
+	/// @brief Write the text of args to a span_writer like Writer, one that has
+	/// data( ), size( ), and remove_prefix( n ), and advance it past the
+	/// written text
+	/// @pre writer.size( ) >= concat_size( args... )
+	/// @return writer
+	template<
+	  typename Writer, typename... Args,
+	  std::enable_if_t<traits::is_span_writer_v<Writer>, std::nullptr_t> = nullptr>
+	Writer &concat_to( Writer &writer, Args const &...args ) {
+		return std::apply(
+		  [&]( auto const &...pieces ) -> Writer & {
+			  auto const sz = ( std::size_t{ 0 } + ... + pieces.size( ) );
+			  daw_ensure( sz <= static_cast<std::size_t>( writer.size( ) ) );
+			  (void)string_concat_impl::write_pieces( writer.data( ), pieces... );
+			  writer.remove_prefix( sz );
+			  return writer;
+		  },
+		  std::tuple{ string_concat_impl::make_piece( args )... } );
+	}
+
+	/// @brief Append the elements of [first, last) separated by separator to
+	/// out.  The total size is computed in a first pass so that out grows once.
+	/// Floating point elements are formatted in both passes
+	/// @return out
+	template<typename Container, typename ForwardIterator, typename Separator>
+	Container &join_append( Container &out, ForwardIterator first,
+	                        ForwardIterator last, Separator const &separator ) {
+		if( first == last ) {
+			return out;
+		}
+		auto const sep = string_concat_impl::make_piece( separator );
+		std::size_t count = 0;
+		std::size_t sz = 0;
+		for( auto it = first; it != last; ++it ) {
+			sz += string_concat_impl::make_piece( *it ).size( );
+			++count;
+		}
+		sz += ( count - 1U ) * sep.size( );
+		string_concat_impl::append_exact( out, sz, [&]( char *p ) {
+			p = string_concat_impl::make_piece( *first ).write( p );
+			while( ++first != last ) {
+				p = sep.write( p );
+				p = string_concat_impl::make_piece( *first ).write( p );
+			}
+			return p;
+		} );
+		return out;
+	}
+
+	/// @brief Join the elements of range, separated by separator, into a new
+	/// string with a single allocation
+	template<typename Result = std::string, typename Range,
+	         typename Separator = std::string_view>
+	[[nodiscard]] Result join( Range const &range,
+	                           Separator const &separator = Separator( ) ) {
+		auto result = Result( );
+		(void)join_append( result, std::begin( range ), std::end( range ),
+		                   separator );
+		return result;
+	}
+} // namespace daw
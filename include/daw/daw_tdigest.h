@@ -0,0 +1,370 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/ciso646.h"
+#include "daw/daw_attributes.h"
+#include "daw/daw_ensure.h"
+#include "daw/impl/daw_sketch_common.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace daw {
+	namespace tdigest_impl {
+		inline constexpr double pi = 3.14159265358979323846;
+
+		struct centroid {
+			double mean;
+			double weight;
+		};
+
+		struct mean_less {
+			[[nodiscard]] DAW_ATTRIB_INLINE constexpr bool
+			operator( )( centroid const &l, centroid const &r ) const noexcept {
+				return l.mean < r.mean;
+			}
+		};
+
+		/// The k1 scale function, clusters are small near the tails so that
+		/// extreme quantiles stay accurate
+		[[nodiscard]] inline double k_scale( double q, double compression ) {
+			return compression / ( 2.0 * pi ) * std::asin( 2.0 * q - 1.0 );
+		}
+
+		[[nodiscard]] inline double k_scale_inverse( double k,
+		                                             double compression ) {
+			return ( std::sin( k * 2.0 * pi / compression ) + 1.0 ) / 2.0;
+		}
+
+		/// Combine neighbours of the sorted centroids while their span of k stays
+		/// within 1
+		inline void compress_sorted( std::vector<centroid> &cs,
+		                             double compression ) {
+			if( cs.size( ) < 2 ) {
+				return;
+			}
+			auto total = 0.0;
+			for( auto const &c : cs ) {
+				total += c.weight;
+			}
+			std::size_t out = 0;
+			auto weight_so_far = 0.0;
+			auto q_limit =
+			  total * k_scale_inverse( k_scale( 0.0, compression ) + 1.0, compression );
+			for( std::size_t n = 1; n < cs.size( ); ++n ) {
+				auto const &next = cs[n];
+				auto &cur = cs[out];
+				if( weight_so_far + cur.weight + next.weight <= q_limit ) {
+					auto const w = cur.weight + next.weight;
+					cur.mean += ( next.mean - cur.mean ) * next.weight / w;
+					cur.weight = w;
+				} else {
+					weight_so_far += cur.weight;
+					q_limit = total * k_scale_inverse(
+					                    k_scale( weight_so_far / total, compression ) + 1.0,
+					                    compression );
+					cs[++out] = next;
+				}
+			}
+			cs.resize( out + 1U );
+		}
+
+		/// Fold the unsorted values into the sorted centroids.  Only the values
+		/// are sorted, they are then merged with the centroids into scratch
+		inline void merge_into( std::vector<centroid> &cs,
+		                        std::vector<double> &values,
+		                        std::vector<centroid> &scratch,
+		                        double compression ) {
+			std::sort( values.begin( ), values.end( ) );
+			scratch.resize( cs.size( ) + values.size( ) );
+			auto c = cs.begin( );
+			auto out = scratch.begin( );
+			for( double v : values ) {
+				while( c != cs.end( ) and c->mean < v ) {
+					*out++ = *c++;
+				}
+				*out++ = centroid{ v, 1.0 };
+			}
+			std::copy( c, cs.end( ), out );
+			values.clear( );
+			cs.swap( scratch );
+			compress_sorted( cs, compression );
+		}
+	} // namespace tdigest_impl
+
+	/// @brief A mergeable sketch of a distribution that estimates quantiles
+	/// using O(compression) memory.  This is the merging t-digest with the k1
+	/// scale function, the error is relative to q(1 - q) so tail quantiles such
+	/// as p99 and p999 are the most accurate.  Values are buffered and folded
+	/// into the centroids in batches
+	class tdigest {
+		using centroid = tdigest_impl::centroid;
+
+		double m_compression;
+		std::vector<centroid> m_centroids{ };
+		std::vector<double> m_buffer{ };
+		std::vector<centroid> m_scratch{ };
+		std::size_t m_buffer_limit;
+		std::uint64_t m_count = 0;
+		double m_min = std::numeric_limits<double>::infinity( );
+		double m_max = -std::numeric_limits<double>::infinity( );
+
+		DAW_ATTRIB_NOINLINE void flush( ) {
+			if( m_buffer.empty( ) ) {
+				return;
+			}
+			tdigest_impl::merge_into( m_centroids, m_buffer, m_scratch,
+			                          m_compression );
+		}
+
+		[[nodiscard]] std::vector<centroid> merged_centroids( ) const {
+			auto result = m_centroids;
+			if( not m_buffer.empty( ) ) {
+				auto buffer = m_buffer;
+				auto scratch = std::vector<centroid>( );
+				tdigest_impl::merge_into( result, buffer, scratch, m_compression );
+			}
+			return result;
+		}
+
+		template<typename Fn>
+		[[nodiscard]] double with_centroids( Fn &&fn ) const {
+			if( m_buffer.empty( ) ) {
+				return fn( m_centroids );
+			}
+			return fn( merged_centroids( ) );
+		}
+
+	public:
+		/// @param compression Bounds the number of centroids to about
+		/// compression, higher is more accurate and larger.  100 gives ~0.1%
+		/// error at p99
+		explicit tdigest( double compression = 100.0 )
+		  : m_compression( compression )
+		  , m_buffer_limit( static_cast<std::size_t>( compression * 32.0 ) ) {
+			daw_ensure( compression >= 10.0 and compression <= 100'000.0 );
+			m_buffer.reserve( m_buffer_limit );
+		}
+
+		DAW_ATTRIB_INLINE void insert( double value ) {
+			if( std::isnan( value ) ) {
+				return;
+			}
+			m_min = std::min( m_min, value );
+			m_max = std::max( m_max, value );
+			++m_count;
+			m_buffer.push_back( value );
+			if( m_buffer.size( ) >= m_buffer_limit ) {
+				flush( );
+			}
+		}
+
+		template<typename Iterator, typename Last>
+		void insert( Iterator first, Last last ) {
+			for( ; first != last; ++first ) {
+				insert( static_cast<double>( *first ) );
+			}
+		}
+
+		/// @brief Combine with the distribution of another digest, such as one
+		/// filled on another thread
+		/// @pre rhs.compression( ) == compression( ), compress_sorted only
+		/// combines centroids so coarser ones from rhs would never be split
+		tdigest &merge( tdigest const &rhs ) {
+			daw_ensure( rhs.m_compression == m_compression );
+			if( rhs.m_count == 0 ) {
+				return *this;
+			}
+			if( &rhs == this ) {
+				// The buffer cannot be appended to itself
+				return merge( tdigest( rhs ) );
+			}
+			m_scratch.resize( m_centroids.size( ) + rhs.m_centroids.size( ) );
+			std::merge( m_centroids.begin( ), m_centroids.end( ),
+			            rhs.m_centroids.begin( ), rhs.m_centroids.end( ),
+			            m_scratch.begin( ), tdigest_impl::mean_less{ } );
+			m_centroids.swap( m_scratch );
+			m_buffer.insert( m_buffer.end( ), rhs.m_buffer.begin( ),
+			                 rhs.m_buffer.end( ) );
+			m_count += rhs.m_count;
+			m_min = std::min( m_min, rhs.m_min );
+			m_max = std::max( m_max, rhs.m_max );
+			if( m_buffer.empty( ) ) {
+				tdigest_impl::compress_sorted( m_centroids, m_compression );
+			} else {
+				flush( );
+			}
+			return *this;
+		}
+
+		/// @brief Fold buffered values into the centroids
+		void compress( ) {
+			flush( );
+		}
+
+		[[nodiscard]] double compression( ) const noexcept {
+			return m_compression;
+		}
+
+		/// @brief The number of values inserted
+		[[nodiscard]] std::uint64_t count( ) const noexcept {
+			return m_count;
+		}
+
+		[[nodiscard]] bool empty( ) const noexcept {
+			return m_count == 0;
+		}
+
+		[[nodiscard]] double min( ) const noexcept {
+			return m_min;
+		}
+
+		[[nodiscard]] double max( ) const noexcept {
+			return m_max;
+		}
+
+		[[nodiscard]] std::size_t centroid_count( ) const noexcept {
+			return m_centroids.size( ) + m_buffer.size( );
+		}
+
+		/// @brief Estimate the value at quantile q in [0, 1].  NaN when empty
+		[[nodiscard]] double quantile( double q ) const {
+			if( m_count == 0 ) {
+				return std::numeric_limits<double>::quiet_NaN( );
+			}
+			q = std::clamp( q, 0.0, 1.0 );
+			return with_centroids( [&]( std::vector<centroid> const &cs ) {
+				auto total = 0.0;
+				for( auto const &c : cs ) {
+					total += c.weight;
+				}
+				auto const index = q * total;
+				// Interpolate between the centres of the centroids, the min and max
+				// anchor the ends
+				auto prev_pos = 0.0;
+				auto prev_mean = m_min;
+				auto pos = 0.0;
+				for( auto const &c : cs ) {
+					auto const centre = pos + c.weight / 2.0;
+					if( index < centre ) {
+						if( c.weight == 1.0 and index >= pos ) {
+							return c.mean;
+						}
+						auto const t = ( index - prev_pos ) / ( centre - prev_pos );
+						return prev_mean + t * ( c.mean - prev_mean );
+					}
+					pos += c.weight;
+					prev_pos = centre;
+					prev_mean = c.mean;
+				}
+				if( total <= prev_pos ) {
+					return m_max;
+				}
+				auto const t = ( index - prev_pos ) / ( total - prev_pos );
+				return prev_mean + t * ( m_max - prev_mean );
+			} );
+		}
+
+		/// @brief Estimate the fraction of values less than or equal to x
+		[[nodiscard]] double cdf( double x ) const {
+			if( m_count == 0 ) {
+				return std::numeric_limits<double>::quiet_NaN( );
+			}
+			if( x < m_min ) {
+				return 0.0;
+			}
+			if( x >= m_max ) {
+				return 1.0;
+			}
+			return with_centroids( [&]( std::vector<centroid> const &cs ) {
+				auto total = 0.0;
+				for( auto const &c : cs ) {
+					total += c.weight;
+				}
+				auto prev_pos = 0.0;
+				auto prev_mean = m_min;
+				auto pos = 0.0;
+				for( auto const &c : cs ) {
+					auto const centre = pos + c.weight / 2.0;
+					if( x < c.mean ) {
+						auto const span = c.mean - prev_mean;
+						auto const t = span > 0.0 ? ( x - prev_mean ) / span : 1.0;
+						return ( prev_pos + t * ( centre - prev_pos ) ) / total;
+					}
+					pos += c.weight;
+					prev_pos = centre;
+					prev_mean = c.mean;
+				}
+				auto const span = m_max - prev_mean;
+				auto const t = span > 0.0 ? ( x - prev_mean ) / span : 1.0;
+				return ( prev_pos + t * ( total - prev_pos ) ) / total;
+			} );
+		}
+
+		void clear( ) noexcept {
+			m_centroids.clear( );
+			m_buffer.clear( );
+			m_count = 0;
+			m_min = std::numeric_limits<double>::infinity( );
+			m_max = -std::numeric_limits<double>::infinity( );
+		}
+
+		/// @brief Bytes needed by serialize_to
+		[[nodiscard]] std::size_t serialized_size( ) const {
+			return sizeof( sketch_impl::sketch_header ) +
+			       ( merged_centroids( ).size( ) + 1U ) * sizeof( centroid );
+		}
+
+		/// @brief Write the compressed digest to out.  The first entry after the
+		/// header holds the min and max
+		/// @pre out has room for serialized_size( ) bytes
+		/// @return one past the last byte written
+		char *serialize_to( char *out ) const {
+			auto items = merged_centroids( );
+			items.insert( items.begin( ), centroid{ m_min, m_max } );
+			auto header = sketch_impl::sketch_header{ };
+			header.kind = sketch_impl::sketch_kind::tdigest;
+			header.parameter = m_compression;
+			header.total = m_count;
+			header.item_count = items.size( );
+			header.value_size = static_cast<std::uint32_t>( sizeof( centroid ) );
+			return sketch_impl::write_sketch( out, header, items.data( ) );
+		}
+
+		/// @brief Copy a digest out of a buffer written by serialize_to
+		[[nodiscard]] static std::optional<tdigest>
+		from_buffer( char const *buffer, std::size_t buffer_size ) {
+			auto header = sketch_impl::sketch_header{ };
+			if( not sketch_impl::read_header( buffer, buffer_size,
+			                                  sketch_impl::sketch_kind::tdigest,
+			                                  sizeof( centroid ), header ) or
+			    header.item_count == 0 or not( header.parameter >= 10.0 ) or
+			    header.parameter > 100'000.0 ) {
+				return std::nullopt;
+			}
+			auto result = tdigest( header.parameter );
+			auto items = std::vector<centroid>(
+			  static_cast<std::size_t>( header.item_count ) );
+			std::memcpy( items.data( ), buffer + sizeof( header ),
+			             items.size( ) * sizeof( centroid ) );
+			result.m_min = items.front( ).mean;
+			result.m_max = items.front( ).weight;
+			result.m_centroids.assign( items.begin( ) + 1, items.end( ) );
+			result.m_count = header.total;
+			return result;
+		}
+	};
+} // namespace daw
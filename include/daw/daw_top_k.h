@@ -0,0 +1,421 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/ciso646.h"
+#include "daw/daw_attributes.h"
+#include "daw/daw_ensure.h"
+#include "daw/impl/daw_sketch_common.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace daw {
+	namespace top_k_impl {
+		/// Orders the best value first
+		template<typename Compare>
+		struct best_first {
+			Compare const *comp;
+
+			template<typename T>
+			[[nodiscard]] DAW_ATTRIB_INLINE constexpr bool
+			operator( )( T const &l, T const &r ) const {
+				return ( *comp )( r, l );
+			}
+		};
+
+		template<typename T, typename Compare>
+		[[nodiscard]] std::vector<T> sorted_best( std::vector<T> values,
+		                                          std::size_t k,
+		                                          Compare const &comp ) {
+			auto const pred = best_first<Compare>{ &comp };
+			if( values.size( ) > k ) {
+				std::nth_element( values.begin( ),
+				                  values.begin( ) + static_cast<std::ptrdiff_t>( k ),
+				                  values.end( ), pred );
+				values.resize( k );
+			}
+			std::sort( values.begin( ), values.end( ), pred );
+			return values;
+		}
+
+		template<typename T>
+		[[nodiscard]] sketch_impl::sketch_header
+		make_header( std::size_t k, std::uint64_t total, std::size_t count ) {
+			auto header = sketch_impl::sketch_header{ };
+			header.kind = sketch_impl::sketch_kind::top_k;
+			header.parameter = static_cast<double>( k );
+			header.total = total;
+			header.item_count = count;
+			header.value_size = static_cast<std::uint32_t>( sizeof( T ) );
+			return header;
+		}
+
+		template<typename T>
+		struct serialized_values {
+			std::size_t k;
+			std::uint64_t total;
+			std::vector<T> values;
+		};
+
+		template<typename T>
+		[[nodiscard]] std::optional<serialized_values<T>>
+		read_values( char const *buffer, std::size_t buffer_size ) {
+			static_assert( std::is_trivially_copyable_v<T>,
+			               "Serialization requires a trivially copyable value_type" );
+			auto header = sketch_impl::sketch_header{ };
+			if( not sketch_impl::read_header( buffer, buffer_size,
+			                                  sketch_impl::sketch_kind::top_k,
+			                                  sizeof( T ), header ) or
+			    header.parameter < 1.0 or
+			    static_cast<double>( header.item_count ) > header.parameter ) {
+				return std::nullopt;
+			}
+			auto result = serialized_values<T>{
+			  static_cast<std::size_t>( header.parameter ), header.total,
+			  std::vector<T>( static_cast<std::size_t>( header.item_count ) ) };
+			if( not result.values.empty( ) ) {
+				std::memcpy( result.values.data( ), buffer + sizeof( header ),
+				             result.values.size( ) * sizeof( T ) );
+			}
+			return result;
+		}
+	} // namespace top_k_impl
+
+	/// @brief Keeps the k greatest values under Compare seen so far, use
+	/// std::greater<> for the k smallest.  Values are buffered and, when the
+	/// buffer reaches 2k, reduced back to k with a partial select.  Values that
+	/// cannot make the current k are rejected with one comparison, making
+	/// inserts amortized O(1) and suited to a large k
+	template<typename T, typename Compare = std::less<>>
+	class top_k {
+		std::vector<T> m_values{ };
+		std::optional<T> m_threshold{ };
+		std::size_t m_k;
+		std::uint64_t m_total = 0;
+		DAW_NO_UNIQUE_ADDRESS Compare m_comp;
+
+		DAW_ATTRIB_NOINLINE void reduce( ) {
+			auto const pred = top_k_impl::best_first<Compare>{ &m_comp };
+			auto const kth = m_values.begin( ) + static_cast<std::ptrdiff_t>( m_k - 1U );
+			std::nth_element( m_values.begin( ), kth, m_values.end( ), pred );
+			m_threshold = *kth;
+			m_values.resize( m_k );
+		}
+
+		template<typename U>
+		DAW_ATTRIB_INLINE void insert_impl( U &&value ) {
+			++m_total;
+			if( m_threshold and not m_comp( *m_threshold, value ) ) {
+				return;
+			}
+			m_values.push_back( std::forward<U>( value ) );
+			if( m_values.size( ) == 2U * m_k ) {
+				reduce( );
+			}
+		}
+
+	public:
+		using value_type = T;
+		using compare_type = Compare;
+		using size_type = std::size_t;
+
+		explicit top_k( std::size_t k, Compare comp = Compare{ } )
+		  : m_k( k )
+		  , m_comp( std::move( comp ) ) {
+			daw_ensure( k > 0 );
+			m_values.reserve( 2U * k );
+		}
+
+		void insert( T const &value ) {
+			insert_impl( value );
+		}
+
+		void insert( T &&value ) {
+			insert_impl( std::move( value ) );
+		}
+
+		template<typename Iterator, typename Last>
+		void insert( Iterator first, Last last ) {
+			for( ; first != last and not m_threshold; ++first ) {
+				insert_impl( *first );
+			}
+			if( first == last ) {
+				return;
+			}
+			// Keep the threshold and count local so the reject path is only a
+			// comparison
+			auto threshold = *m_threshold;
+			std::uint64_t count = 0;
+			for( ; first != last; ++first ) {
+				++count;
+				if( not m_comp( threshold, *first ) ) {
+					continue;
+				}
+				m_values.push_back( *first );
+				if( m_values.size( ) == 2U * m_k ) {
+					reduce( );
+					threshold = *m_threshold;
+				}
+			}
+			m_total += count;
+		}
+
+		/// @brief Combine with the values kept by another top_k, such as one
+		/// filled on another thread
+		top_k &merge( top_k const &rhs ) {
+			if( &rhs == this ) {
+				// Inserting would read the values as they are replaced
+				return merge( top_k( rhs ) );
+			}
+			auto const total = m_total + rhs.m_total;
+			insert( rhs.m_values.begin( ), rhs.m_values.end( ) );
+			m_total = total;
+			return *this;
+		}
+
+		[[nodiscard]] std::size_t k( ) const noexcept {
+			return m_k;
+		}
+
+		/// @brief The number of values kept, at most k( )
+		[[nodiscard]] std::size_t size( ) const noexcept {
+			return std::min( m_values.size( ), m_k );
+		}
+
+		[[nodiscard]] bool empty( ) const noexcept {
+			return m_values.empty( );
+		}
+
+		/// @brief The number of values inserted
+		[[nodiscard]] std::uint64_t total( ) const noexcept {
+			return m_total;
+		}
+
+		/// @brief The kept values, best first
+		[[nodiscard]] std::vector<T> values( ) const {
+			return top_k_impl::sorted_best( m_values, m_k, m_comp );
+		}
+
+		void clear( ) noexcept {
+			m_values.clear( );
+			m_threshold.reset( );
+			m_total = 0;
+		}
+
+		/// @brief Bytes needed by serialize_to
+		[[nodiscard]] std::size_t serialized_size( ) const noexcept {
+			return sizeof( sketch_impl::sketch_header ) + size( ) * sizeof( T );
+		}
+
+		/// @pre out has room for serialized_size( ) bytes
+		/// @return one past the last byte written
+		char *serialize_to( char *out ) const {
+			static_assert( std::is_trivially_copyable_v<T>,
+			               "Serialization requires a trivially copyable value_type" );
+			auto const v = values( );
+			return sketch_impl::write_sketch(
+			  out, top_k_impl::make_header<T>( m_k, m_total, v.size( ) ), v.data( ) );
+		}
+
+		/// @brief Copy a top_k out of a buffer written by serialize_to
+		[[nodiscard]] static std::optional<top_k>
+		from_buffer( char const *buffer, std::size_t buffer_size,
+		             Compare comp = Compare{ } ) {
+			auto values = top_k_impl::read_values<T>( buffer, buffer_size );
+			if( not values ) {
+				return std::nullopt;
+			}
+			auto result = top_k( values->k, std::move( comp ) );
+			result.insert( values->values.begin( ), values->values.end( ) );
+			result.m_total = values->total;
+			return result;
+		}
+	};
+
+	/// @brief Keeps the k greatest values under Compare seen so far in a binary
+	/// heap.  An insert that is not rejected costs O(log k), and the kept
+	/// values are always exactly the top k.  Prefer top_k when k is large
+	template<typename T, typename Compare = std::less<>>
+	class top_k_heap {
+		/// Heap ordered so that the worst kept value is at the root
+		std::vector<T> m_heap{ };
+		std::size_t m_k;
+		std::uint64_t m_total = 0;
+		DAW_NO_UNIQUE_ADDRESS Compare m_comp;
+
+		[[nodiscard]] DAW_ATTRIB_INLINE bool worse( T const &l, T const &r ) const {
+			return m_comp( l, r );
+		}
+
+		DAW_ATTRIB_INLINE void sift_up( std::size_t pos ) {
+			auto value = std::move( m_heap[pos] );
+			while( pos > 0 ) {
+				auto const parent = ( pos - 1U ) / 2U;
+				if( not worse( value, m_heap[parent] ) ) {
+					break;
+				}
+				m_heap[pos] = std::move( m_heap[parent] );
+				pos = parent;
+			}
+			m_heap[pos] = std::move( value );
+		}
+
+		/// Replace the root with value and restore the heap
+		template<typename U>
+		DAW_ATTRIB_INLINE void replace_top( U &&value ) {
+			auto const size = m_heap.size( );
+			std::size_t pos = 0;
+			while( true ) {
+				auto child = 2U * pos + 1U;
+				if( child >= size ) {
+					break;
+				}
+				if( child + 1U < size and worse( m_heap[child + 1U], m_heap[child] ) ) {
+					++child;
+				}
+				if( not worse( m_heap[child], value ) ) {
+					break;
+				}
+				m_heap[pos] = std::move( m_heap[child] );
+				pos = child;
+			}
+			m_heap[pos] = std::forward<U>( value );
+		}
+
+		template<typename U>
+		DAW_ATTRIB_INLINE void insert_impl( U &&value ) {
+			++m_total;
+			if( m_heap.size( ) < m_k ) {
+				m_heap.push_back( std::forward<U>( value ) );
+				sift_up( m_heap.size( ) - 1U );
+			} else if( m_comp( m_heap.front( ), value ) ) {
+				replace_top( std::forward<U>( value ) );
+			}
+		}
+
+	public:
+		using value_type = T;
+		using compare_type = Compare;
+		using size_type = std::size_t;
+
+		explicit top_k_heap( std::size_t k, Compare comp = Compare{ } )
+		  : m_k( k )
+		  , m_comp( std::move( comp ) ) {
+			daw_ensure( k > 0 );
+			m_heap.reserve( k );
+		}
+
+		void insert( T const &value ) {
+			insert_impl( value );
+		}
+
+		void insert( T &&value ) {
+			insert_impl( std::move( value ) );
+		}
+
+		template<typename Iterator, typename Last>
+		void insert( Iterator first, Last last ) {
+			for( ; first != last and m_heap.size( ) < m_k; ++first ) {
+				insert_impl( *first );
+			}
+			// The heap is full and no longer reallocates
+			T const *const worst_kept = m_heap.data( );
+			std::uint64_t count = 0;
+			for( ; first != last; ++first ) {
+				++count;
+				if( m_comp( *worst_kept, *first ) ) {
+					replace_top( *first );
+				}
+			}
+			m_total += count;
+		}
+
+		/// @brief Combine with the values kept by another top_k_heap, such as one
+		/// filled on another thread
+		top_k_heap &merge( top_k_heap const &rhs ) {
+			if( &rhs == this ) {
+				// Inserting would read the values as they are replaced
+				return merge( top_k_heap( rhs ) );
+			}
+			auto const total = m_total + rhs.m_total;
+			insert( rhs.m_heap.begin( ), rhs.m_heap.end( ) );
+			m_total = total;
+			return *this;
+		}
+
+		[[nodiscard]] std::size_t k( ) const noexcept {
+			return m_k;
+		}
+
+		[[nodiscard]] std::size_t size( ) const noexcept {
+			return m_heap.size( );
+		}
+
+		[[nodiscard]] bool empty( ) const noexcept {
+			return m_heap.empty( );
+		}
+
+		[[nodiscard]] std::uint64_t total( ) const noexcept {
+			return m_total;
+		}
+
+		/// @brief The k'th best value, the one a new value must beat once full
+		/// @pre not empty( )
+		[[nodiscard]] T const &worst( ) const noexcept {
+			return m_heap.front( );
+		}
+
+		/// @brief The kept values, best first
+		[[nodiscard]] std::vector<T> values( ) const {
+			return top_k_impl::sorted_best( m_heap, m_k, m_comp );
+		}
+
+		void clear( ) noexcept {
+			m_heap.clear( );
+			m_total = 0;
+		}
+
+		/// @brief Bytes needed by serialize_to
+		[[nodiscard]] std::size_t serialized_size( ) const noexcept {
+			return sizeof( sketch_impl::sketch_header ) + size( ) * sizeof( T );
+		}
+
+		/// @pre out has room for serialized_size( ) bytes
+		/// @return one past the last byte written
+		char *serialize_to( char *out ) const noexcept {
+			static_assert( std::is_trivially_copyable_v<T>,
+			               "Serialization requires a trivially copyable value_type" );
+			return sketch_impl::write_sketch(
+			  out, top_k_impl::make_header<T>( m_k, m_total, m_heap.size( ) ),
+			  m_heap.data( ) );
+		}
+
+		/// @brief Copy a top_k_heap out of a buffer written by serialize_to
+		[[nodiscard]] static std::optional<top_k_heap>
+		from_buffer( char const *buffer, std::size_t buffer_size,
+		             Compare comp = Compare{ } ) {
+			auto values = top_k_impl::read_values<T>( buffer, buffer_size );
+			if( not values ) {
+				return std::nullopt;
+			}
+			auto result = top_k_heap( values->k, std::move( comp ) );
+			result.insert( values->values.begin( ), values->values.end( ) );
+			result.m_total = values->total;
+			return result;
+		}
+	};
+} // namespace daw
@@ -12,17 +12,20 @@
 #include "cpp_17.h"
 #include "daw/daw_check_exceptions.h"
 #include "daw_exception.h"
+#include "daw_attributes.h"
 #include "daw_exchange.h"
 #include "daw_swap.h"
+#include "impl/daw_container_help_impl.h"
 
 #include <algorithm>
 #include <memory>
 #include <stdexcept>
 
 namespace daw {
-	template<typename T>
+	template<typename T, typename Allocator = std::allocator<T>>
 	struct unique_array_t {
 		using value_type = T;
+		using allocator_type = Allocator;
 		using pointer = value_type *;
 		using const_pointer = value_type const *;
 		using reference = value_type &;
@@ -32,14 +35,20 @@ namespace daw {
 		using const_iterator = value_type const *;
 
 	private:
+		using alloc_traits = std::allocator_traits<allocator_type>;
+
+		DAW_NO_UNIQUE_ADDRESS allocator_type m_alloc = allocator_type( );
 		pointer m_data = nullptr;
 		size_type m_size = 0;
+		size_type m_capacity = 0;
 
-		static pointer create_values( size_t n ) noexcept {
+		pointer create_values( size_t n ) noexcept {
 #if defined( DAW_USE_EXCEPTIONS )
 			try {
 #endif
-				return new value_type[n];
+				auto *result = alloc_traits::allocate( m_alloc, n );
+				std::uninitialized_default_construct_n( result, n );
+				return result;
 #if defined( DAW_USE_EXCEPTIONS )
 			} catch( std::bad_alloc const & ) { std::abort( ); }
 #endif
@@ -47,9 +56,11 @@ namespace daw {
 
 		constexpr void clear( ) {
 			auto tmp = daw::exchange( m_data, nullptr );
-			m_size = 0;
+			auto const sz = daw::exchange( m_size, 0U );
+			auto const cap = daw::exchange( m_capacity, 0U );
 			if( tmp ) {
-				delete[] tmp;
+				std::destroy_n( tmp, sz );
+				alloc_traits::deallocate( m_alloc, tmp, cap );
 			}
 		}
 
@@ -59,36 +70,69 @@ namespace daw {
 		unique_array_t &operator=( unique_array_t const & ) = delete;
 
 		constexpr unique_array_t( unique_array_t &&other ) noexcept
-		  : m_data( daw::exchange( other.m_data, nullptr ) )
-		  , m_size( daw::exchange( other.m_size, 0U ) ) {}
+		  : m_alloc( other.m_alloc )
+		  , m_data( daw::exchange( other.m_data, nullptr ) )
+		  , m_size( daw::exchange( other.m_size, 0U ) )
+		  , m_capacity( daw::exchange( other.m_capacity, 0U ) ) {}
 
 		constexpr unique_array_t &operator=( unique_array_t &&rhs ) noexcept {
 			if( this == &rhs ) {
 				return *this;
 			}
 			clear( );
+			m_alloc = rhs.m_alloc;
 			if( !rhs.m_data ) {
 				return *this;
 			}
 			m_data = daw::exchange( rhs.m_data, nullptr );
 			m_size = daw::exchange( rhs.m_size, 0U );
+			m_capacity = daw::exchange( rhs.m_capacity, 0U );
 			return *this;
 		}
 
 		unique_array_t( size_type sz ) noexcept
 		  : m_data( create_values( sz ) )
-		  , m_size( sz ) {}
+		  , m_size( sz )
+		  , m_capacity( sz ) {}
+
+		/// Allocate sz default initialized values with the allocator supplied
+		unique_array_t( std::allocator_arg_t, allocator_type const &alloc,
+		                size_type sz ) noexcept
+		  : m_alloc( alloc )
+		  , m_data( create_values( sz ) )
+		  , m_size( sz )
+		  , m_capacity( sz ) {}
 
 		template<typename... Args>
 		unique_array_t( size_type sz, Args &&...args ) noexcept(
 		  std::is_nothrow_constructible_v<value_type, Args...> )
 		  : m_data( create_values( sz ) )
-		  , m_size( sz ) {
+		  , m_size( sz )
+		  , m_capacity( sz ) {
+
+			std::fill_n( m_data, m_size, value_type{ args... } );
+		}
 
-			std::fill_n( m_data, m_size, { args... } );
+		/// Adopt a buffer released by another container, such as a std::vector,
+		/// no elements are copied
+		explicit unique_array_t(
+		  container_data<value_type, allocator_type> &&buff ) noexcept
+		  : m_alloc( buff.get_allocator( ) )
+		  , m_size( buff.size( ) )
+		  , m_capacity( buff.capacity( ) ) {
+			m_data = buff.release( );
 		}
 
-		~unique_array_t( ) noexcept( noexcept( delete[] m_data ) ) {
+		/// Give up the allocation without copying the elements, leaving the
+		/// array empty
+		[[nodiscard]] container_data<value_type, allocator_type> release_buffer( ) {
+			auto const sz = daw::exchange( m_size, 0U );
+			auto const cap = daw::exchange( m_capacity, 0U );
+			return container_data<value_type, allocator_type>(
+			  daw::exchange( m_data, nullptr ), m_alloc, sz, cap );
+		}
+
+		~unique_array_t( ) noexcept( std::is_nothrow_destructible_v<value_type> ) {
 			clear( );
 		}
 
@@ -101,7 +145,15 @@ namespace daw {
 		}
 
 		constexpr size_type capacity( ) const noexcept {
-			return m_size;
+			return m_capacity;
+		}
+
+		constexpr pointer data( ) noexcept {
+			return m_data;
+		}
+
+		constexpr const_pointer data( ) const noexcept {
+			return m_data;
 		}
 
 		reference operator[]( size_type pos ) noexcept {
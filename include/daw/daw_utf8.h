@@ -0,0 +1,757 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/ciso646.h"
+#include "daw/daw_ascii.h"
+#include "daw/daw_attributes.h"
+#include "daw/daw_cxmath.h"
+#include "daw/daw_is_constant_evaluated.h"
+#include "daw/daw_string_view.h"
+#include "daw/impl/daw_simd_check.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace daw {
+	/// @brief Result of a transcoding function
+	template<typename CharT>
+	struct utf_transcode_result {
+		/// One past the last code unit written
+		CharT *last;
+		/// false when the input was ill formed.  Nothing is written for ill
+		/// formed UTF-8, otherwise last is where the bad code unit was found
+		bool is_valid;
+
+		constexpr explicit operator bool( ) const {
+			return is_valid;
+		}
+	};
+
+	namespace utf8_impl {
+		[[nodiscard]] DAW_ATTRIB_INLINE constexpr std::uint32_t byte( char c ) {
+			return static_cast<unsigned char>( c );
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE constexpr bool
+		is_continuation( std::uint32_t b ) {
+			return ( b & 0xC0U ) == 0x80U;
+		}
+
+		/// @return the length of the well formed sequence starting at p[0] or 0
+		/// when it is ill formed.  See table 3-7 of the Unicode standard
+		[[nodiscard]] constexpr std::size_t sequence_length( char const *p,
+		                                                     std::size_t size ) {
+			auto const b0 = byte( p[0] );
+			if( b0 < 0x80U ) {
+				return 1;
+			}
+			if( b0 < 0xC2U ) {
+				return 0;
+			}
+			if( b0 < 0xE0U ) {
+				return size >= 2U and is_continuation( byte( p[1] ) ) ? 2U : 0U;
+			}
+			if( b0 < 0xF0U ) {
+				if( size < 3U ) {
+					return 0;
+				}
+				auto const b1 = byte( p[1] );
+				auto const lo = b0 == 0xE0U ? 0xA0U : 0x80U;
+				auto const hi = b0 == 0xEDU ? 0x9FU : 0xBFU;
+				return lo <= b1 and b1 <= hi and is_continuation( byte( p[2] ) ) ? 3U
+				                                                                : 0U;
+			}
+			if( b0 < 0xF5U ) {
+				if( size < 4U ) {
+					return 0;
+				}
+				auto const b1 = byte( p[1] );
+				auto const lo = b0 == 0xF0U ? 0x90U : 0x80U;
+				auto const hi = b0 == 0xF4U ? 0x8FU : 0xBFU;
+				return lo <= b1 and b1 <= hi and is_continuation( byte( p[2] ) ) and
+				           is_continuation( byte( p[3] ) )
+				         ? 4U
+				         : 0U;
+			}
+			return 0;
+		}
+
+		[[nodiscard]] constexpr std::size_t scalar_find_invalid( char const *p,
+		                                                         std::size_t size ) {
+			std::size_t n = 0;
+			while( n < size ) {
+				if( n + 8U <= size and ( ascii_impl::load_word8( p + n ) &
+				                         0x8080'8080'8080'8080ULL ) == 0 ) {
+					n += 8U;
+					continue;
+				}
+				auto const len = sequence_length( p + n, size - n );
+				if( len == 0 ) {
+					return n;
+				}
+				n += len;
+			}
+			return daw::string_view::npos;
+		}
+
+		/// Decode the well formed sequence at p and advance p past it
+		[[nodiscard]] DAW_ATTRIB_INLINE constexpr std::uint32_t
+		decode_valid( char const *&p ) {
+			auto const b0 = byte( p[0] );
+			if( b0 < 0x80U ) {
+				++p;
+				return b0;
+			}
+			if( b0 < 0xE0U ) {
+				auto const result = ( ( b0 & 0x1FU ) << 6U ) | ( byte( p[1] ) & 0x3FU );
+				p += 2;
+				return result;
+			}
+			if( b0 < 0xF0U ) {
+				auto const result = ( ( b0 & 0x0FU ) << 12U ) |
+				                    ( ( byte( p[1] ) & 0x3FU ) << 6U ) |
+				                    ( byte( p[2] ) & 0x3FU );
+				p += 3;
+				return result;
+			}
+			auto const result =
+			  ( ( b0 & 0x07U ) << 18U ) | ( ( byte( p[1] ) & 0x3FU ) << 12U ) |
+			  ( ( byte( p[2] ) & 0x3FU ) << 6U ) | ( byte( p[3] ) & 0x3FU );
+			p += 4;
+			return result;
+		}
+
+		/// Write the UTF-8 form of the scalar value cp and advance out
+		DAW_ATTRIB_INLINE constexpr void encode( std::uint32_t cp, char *&out ) {
+			if( cp < 0x80U ) {
+				*out++ = static_cast<char>( cp );
+			} else if( cp < 0x800U ) {
+				*out++ = static_cast<char>( 0xC0U | ( cp >> 6U ) );
+				*out++ = static_cast<char>( 0x80U | ( cp & 0x3FU ) );
+			} else if( cp < 0x1'0000U ) {
+				*out++ = static_cast<char>( 0xE0U | ( cp >> 12U ) );
+				*out++ = static_cast<char>( 0x80U | ( ( cp >> 6U ) & 0x3FU ) );
+				*out++ = static_cast<char>( 0x80U | ( cp & 0x3FU ) );
+			} else {
+				*out++ = static_cast<char>( 0xF0U | ( cp >> 18U ) );
+				*out++ = static_cast<char>( 0x80U | ( ( cp >> 12U ) & 0x3FU ) );
+				*out++ = static_cast<char>( 0x80U | ( ( cp >> 6U ) & 0x3FU ) );
+				*out++ = static_cast<char>( 0x80U | ( cp & 0x3FU ) );
+			}
+		}
+
+		template<typename CharT>
+		DAW_ATTRIB_INLINE constexpr void put_code_point( std::uint32_t cp,
+		                                                 CharT *&out ) {
+			if constexpr( sizeof( CharT ) == 2 ) {
+				if( cp >= 0x1'0000U ) {
+					cp -= 0x1'0000U;
+					*out++ = static_cast<CharT>( 0xD800U | ( cp >> 10U ) );
+					*out++ = static_cast<CharT>( 0xDC00U | ( cp & 0x3FFU ) );
+					return;
+				}
+			}
+			*out++ = static_cast<CharT>( cp );
+		}
+
+		/// Transcode one code point of UTF-16 from p to out
+		/// @return false when p does not start a well formed code point
+		DAW_ATTRIB_INLINE constexpr bool
+		utf16_step( char16_t const *&p, char16_t const *last, char *&out ) {
+			auto const u = static_cast<std::uint32_t>( *p );
+			if( ( u & 0xF800U ) != 0xD800U ) {
+				encode( u, out );
+				++p;
+				return true;
+			}
+			if( u >= 0xDC00U or last - p < 2 ) {
+				return false;
+			}
+			auto const u2 = static_cast<std::uint32_t>( p[1] );
+			if( ( u2 & 0xFC00U ) != 0xDC00U ) {
+				return false;
+			}
+			encode( 0x1'0000U + ( ( u - 0xD800U ) << 10U ) + ( u2 - 0xDC00U ), out );
+			p += 2;
+			return true;
+		}
+
+		/// Transcode one code point of UTF-32 from p to out
+		/// @return false when *p is a surrogate or out of range
+		DAW_ATTRIB_INLINE constexpr bool utf32_step( char32_t const *&p,
+		                                             char *&out ) {
+			auto const cp = static_cast<std::uint32_t>( *p );
+			if( cp > 0x10'FFFFU or ( cp & 0xFFFF'F800U ) == 0xD800U ) {
+				return false;
+			}
+			encode( cp, out );
+			++p;
+			return true;
+		}
+
+#if defined( DAW_ASCII_HAS_SIMD )
+#define DAW_UTF8_HAS_SIMD
+		using ascii_impl::simd_and;
+		using ascii_impl::simd_eq;
+		using ascii_impl::simd_full_mask;
+		using ascii_impl::simd_gt;
+		using ascii_impl::simd_load;
+		using ascii_impl::simd_movemask;
+		using ascii_impl::simd_or;
+		using ascii_impl::simd_splat;
+		using ascii_impl::simd_sub8;
+		using ascii_impl::simd_sum_bytes;
+		using ascii_impl::simd_t;
+		using ascii_impl::simd_width;
+		using ascii_impl::simd_zero;
+
+		/// Count the bytes of p where count_mask is 0xFF, and the scalar predicate
+		/// for the tail
+		template<typename Mask, typename Scalar>
+		[[nodiscard]] DAW_ATTRIB_FLATTEN inline std::size_t
+		simd_count( char const *p, std::size_t size, Mask count_mask,
+		            Scalar scalar ) {
+			std::size_t result = 0;
+			std::size_t n = 0;
+			while( n + simd_width <= size ) {
+				auto acc = simd_zero( );
+				auto const blocks = ( size - n ) / simd_width;
+				auto const batch = blocks < 255U ? blocks : std::size_t{ 255 };
+				for( std::size_t b = 0; b < batch; ++b, n += simd_width ) {
+					acc = simd_sub8( acc, count_mask( simd_load( p + n ) ) );
+				}
+				result += simd_sum_bytes( acc );
+			}
+			for( ; n < size; ++n ) {
+				result += static_cast<std::size_t>( scalar( byte( p[n] ) ) );
+			}
+			return result;
+		}
+
+		struct lead_byte_mask {
+			/// Every byte but 0x80-0xBF, which are -128 to -65 when signed
+			DAW_ATTRIB_INLINE simd_t operator( )( simd_t v ) const {
+				return simd_gt( v, simd_splat( static_cast<char>( 0xBF ) ) );
+			}
+		};
+
+		struct four_byte_lead_mask {
+			/// 0xF0-0xFF, which are -16 to -1 when signed
+			DAW_ATTRIB_INLINE simd_t operator( )( simd_t v ) const {
+				return simd_and( simd_gt( v, simd_splat( static_cast<char>( 0xEF ) ) ),
+				                 simd_gt( simd_zero( ), v ) );
+			}
+		};
+
+#if defined( DAW_HAS_SSSE3 )
+#define DAW_UTF8_HAS_LOOKUP_VALIDATOR
+		// The lookup validator of Keiser and Lemire, "Validating UTF-8 In Less
+		// Than One Instruction Per Byte".  Three 16 entry tables indexed by the
+		// nibbles of each byte and the byte before it flag every ill formed two
+		// byte pattern, the remaining errors are found from the bytes 2 and 3
+		// back.
+		inline constexpr unsigned char too_short = 1U << 0U;
+		inline constexpr unsigned char too_long = 1U << 1U;
+		inline constexpr unsigned char overlong_3 = 1U << 2U;
+		inline constexpr unsigned char too_large = 1U << 3U;
+		inline constexpr unsigned char surrogate = 1U << 4U;
+		inline constexpr unsigned char overlong_2 = 1U << 5U;
+		inline constexpr unsigned char too_large_1000 = 1U << 6U;
+		inline constexpr unsigned char overlong_4 = 1U << 6U;
+		inline constexpr unsigned char two_conts = 1U << 7U;
+		inline constexpr unsigned char carry = too_short | too_long | two_conts;
+
+#if defined( DAW_HAS_AVX2 )
+		template<unsigned char... Bytes>
+		DAW_ATTRIB_INLINE simd_t make_table( ) {
+			static_assert( sizeof...( Bytes ) == 16 );
+			return _mm256_setr_epi8( static_cast<char>( Bytes )...,
+			                         static_cast<char>( Bytes )... );
+		}
+
+		DAW_ATTRIB_INLINE simd_t lookup( simd_t table, simd_t index ) {
+			return _mm256_shuffle_epi8( table, index );
+		}
+
+		DAW_ATTRIB_INLINE simd_t high_nibbles( simd_t v ) {
+			return _mm256_and_si256( _mm256_srli_epi16( v, 4 ), simd_splat( 0x0F ) );
+		}
+
+		DAW_ATTRIB_INLINE simd_t simd_xor( simd_t a, simd_t b ) {
+			return _mm256_xor_si256( a, b );
+		}
+
+		DAW_ATTRIB_INLINE simd_t subs_u8( simd_t a, simd_t b ) {
+			return _mm256_subs_epu8( a, b );
+		}
+
+		/// The vector of bytes starting N before input
+		template<int N>
+		DAW_ATTRIB_INLINE simd_t prev( simd_t input, simd_t prev_input ) {
+			return _mm256_alignr_epi8(
+			  input, _mm256_permute2x128_si256( prev_input, input, 0x21 ), 16 - N );
+		}
+
+		/// Lead bytes in the last 3 positions that need more bytes than remain
+		DAW_ATTRIB_INLINE simd_t is_incomplete( simd_t input ) {
+			auto const max_value = _mm256_setr_epi8(
+			  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+			  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, static_cast<char>( 0xEF ),
+			  static_cast<char>( 0xDF ), static_cast<char>( 0xBF ) );
+			return _mm256_subs_epu8( input, max_value );
+		}
+#else
+		template<unsigned char... Bytes>
+		DAW_ATTRIB_INLINE simd_t make_table( ) {
+			static_assert( sizeof...( Bytes ) == 16 );
+			return _mm_setr_epi8( static_cast<char>( Bytes )... );
+		}
+
+		DAW_ATTRIB_INLINE simd_t lookup( simd_t table, simd_t index ) {
+			return _mm_shuffle_epi8( table, index );
+		}
+
+		DAW_ATTRIB_INLINE simd_t high_nibbles( simd_t v ) {
+			return _mm_and_si128( _mm_srli_epi16( v, 4 ), simd_splat( 0x0F ) );
+		}
+
+		DAW_ATTRIB_INLINE simd_t simd_xor( simd_t a, simd_t b ) {
+			return _mm_xor_si128( a, b );
+		}
+
+		DAW_ATTRIB_INLINE simd_t subs_u8( simd_t a, simd_t b ) {
+			return _mm_subs_epu8( a, b );
+		}
+
+		/// The vector of bytes starting N before input
+		template<int N>
+		DAW_ATTRIB_INLINE simd_t prev( simd_t input, simd_t prev_input ) {
+			return _mm_alignr_epi8( input, prev_input, 16 - N );
+		}
+
+		/// Lead bytes in the last 3 positions that need more bytes than remain
+		DAW_ATTRIB_INLINE simd_t is_incomplete( simd_t input ) {
+			auto const max_value =
+			  _mm_setr_epi8( -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+			                 static_cast<char>( 0xEF ), static_cast<char>( 0xDF ),
+			                 static_cast<char>( 0xBF ) );
+			return _mm_subs_epu8( input, max_value );
+		}
+#endif
+
+		DAW_ATTRIB_INLINE simd_t special_cases( simd_t input, simd_t prev1 ) {
+			auto const byte_1_high = lookup(
+			  make_table<too_long, too_long, too_long, too_long, too_long, too_long,
+			             too_long, too_long, two_conts, two_conts, two_conts,
+			             two_conts, too_short | overlong_2, too_short,
+			             too_short | overlong_3 | surrogate,
+			             too_short | too_large | too_large_1000 | overlong_4>( ),
+			  high_nibbles( prev1 ) );
+			auto const byte_1_low = lookup(
+			  make_table<carry | overlong_3 | overlong_2 | overlong_4,
+			             carry | overlong_2, carry, carry, carry | too_large,
+			             carry | too_large | too_large_1000,
+			             carry | too_large | too_large_1000,
+			             carry | too_large | too_large_1000,
+			             carry | too_large | too_large_1000,
+			             carry | too_large | too_large_1000,
+			             carry | too_large | too_large_1000,
+			             carry | too_large | too_large_1000,
+			             carry | too_large | too_large_1000,
+			             carry | too_large | too_large_1000 | surrogate,
+			             carry | too_large | too_large_1000,
+			             carry | too_large | too_large_1000>( ),
+			  simd_and( prev1, simd_splat( 0x0F ) ) );
+			auto const byte_2_high = lookup(
+			  make_table<too_short, too_short, too_short, too_short, too_short,
+			             too_short, too_short, too_short,
+			             too_long | overlong_2 | two_conts | overlong_3 |
+			               too_large_1000 | overlong_4,
+			             too_long | overlong_2 | two_conts | overlong_3 | too_large,
+			             too_long | overlong_2 | two_conts | surrogate | too_large,
+			             too_long | overlong_2 | two_conts | surrogate | too_large,
+			             too_short, too_short, too_short, too_short>( ),
+			  high_nibbles( input ) );
+			return simd_and( simd_and( byte_1_high, byte_1_low ), byte_2_high );
+		}
+
+		/// Bytes that must be the 2nd or 3rd continuation of a 3 or 4 byte
+		/// sequence, xor'd with what the two byte check found
+		DAW_ATTRIB_INLINE simd_t multibyte_lengths( simd_t input,
+		                                            simd_t prev_input,
+		                                            simd_t special ) {
+			auto const prev2 = prev<2>( input, prev_input );
+			auto const prev3 = prev<3>( input, prev_input );
+			auto const is_third = subs_u8( prev2, simd_splat( 0xE0 - 0x80 ) );
+			auto const is_fourth = subs_u8( prev3, simd_splat( 0xF0 - 0x80 ) );
+			auto const must_be_continuation =
+			  simd_and( simd_or( is_third, is_fourth ),
+			            simd_splat( static_cast<char>( 0x80 ) ) );
+			return simd_xor( must_be_continuation, special );
+		}
+
+		struct utf8_checker {
+			simd_t error = simd_zero( );
+			simd_t prev_input = simd_zero( );
+			simd_t prev_incomplete = simd_zero( );
+
+			DAW_ATTRIB_INLINE void check_ascii( ) {
+				error = simd_or( error, prev_incomplete );
+				prev_input = simd_zero( );
+				prev_incomplete = simd_zero( );
+			}
+
+			DAW_ATTRIB_INLINE void check( simd_t input ) {
+				if( simd_movemask( input ) == 0 ) {
+					check_ascii( );
+					return;
+				}
+				auto const prev1 = prev<1>( input, prev_input );
+				error = simd_or( error,
+				                 multibyte_lengths( input, prev_input,
+				                                    special_cases( input, prev1 ) ) );
+				prev_incomplete = is_incomplete( input );
+				prev_input = input;
+			}
+
+			[[nodiscard]] DAW_ATTRIB_INLINE bool finish( ) {
+				error = simd_or( error, prev_incomplete );
+				return simd_movemask( simd_eq( error, simd_zero( ) ) ) ==
+				       simd_full_mask;
+			}
+		};
+
+		[[nodiscard]] DAW_ATTRIB_FLATTEN inline bool simd_is_valid( char const *p,
+		                                                            std::size_t size ) {
+			auto checker = utf8_checker{ };
+			std::size_t n = 0;
+			for( ; n + 4U * simd_width <= size; n += 4U * simd_width ) {
+				auto const v0 = simd_load( p + n );
+				auto const v1 = simd_load( p + n + simd_width );
+				auto const v2 = simd_load( p + n + 2U * simd_width );
+				auto const v3 = simd_load( p + n + 3U * simd_width );
+				if( simd_movemask( simd_or( simd_or( v0, v1 ), simd_or( v2, v3 ) ) ) ==
+				    0 ) {
+					checker.check_ascii( );
+					continue;
+				}
+				checker.check( v0 );
+				checker.check( v1 );
+				checker.check( v2 );
+				checker.check( v3 );
+			}
+			for( ; n + simd_width <= size; n += simd_width ) {
+				checker.check( simd_load( p + n ) );
+			}
+			if( n < size ) {
+				// Zero padding is ASCII, so an unfinished sequence at the end is
+				// still an error
+				char buffer[simd_width]{ };
+				for( std::size_t m = 0; n + m < size; ++m ) {
+					buffer[m] = p[n + m];
+				}
+				checker.check( simd_load( buffer ) );
+			}
+			return checker.finish( );
+		}
+#endif
+
+		/// Widen the 16 ASCII bytes of v to 16 code units at out
+		template<typename CharT>
+		DAW_ATTRIB_INLINE void widen_ascii( __m128i v, CharT *out ) {
+			auto const zero = _mm_setzero_si128( );
+			auto const lo = _mm_unpacklo_epi8( v, zero );
+			auto const hi = _mm_unpackhi_epi8( v, zero );
+			if constexpr( sizeof( CharT ) == 2 ) {
+				_mm_storeu_si128( reinterpret_cast<__m128i *>( out ), lo );
+				_mm_storeu_si128( reinterpret_cast<__m128i *>( out + 8 ), hi );
+			} else {
+				_mm_storeu_si128( reinterpret_cast<__m128i *>( out ),
+				                  _mm_unpacklo_epi16( lo, zero ) );
+				_mm_storeu_si128( reinterpret_cast<__m128i *>( out + 4 ),
+				                  _mm_unpackhi_epi16( lo, zero ) );
+				_mm_storeu_si128( reinterpret_cast<__m128i *>( out + 8 ),
+				                  _mm_unpacklo_epi16( hi, zero ) );
+				_mm_storeu_si128( reinterpret_cast<__m128i *>( out + 12 ),
+				                  _mm_unpackhi_epi16( hi, zero ) );
+			}
+		}
+
+		/// Runs of 16 ASCII bytes are widened with SSE2, everything else is
+		/// decoded one code point at a time
+		template<typename CharT>
+		[[nodiscard]] DAW_ATTRIB_FLATTEN inline CharT *
+		simd_convert_valid( char const *p, char const *last, CharT *out ) {
+			while( last - p >= 16 ) {
+				auto const v = _mm_loadu_si128( reinterpret_cast<__m128i const *>( p ) );
+				if( _mm_movemask_epi8( v ) == 0 ) {
+					widen_ascii( v, out );
+					p += 16;
+					out += 16;
+					continue;
+				}
+				// Copy the ASCII prefix, then decode until the next ASCII byte
+				auto const ascii_prefix = static_cast<std::size_t>(
+				  daw::cxmath::count_trailing_zeros( static_cast<std::uint32_t>(
+				    _mm_movemask_epi8( v ) ) ) );
+				for( std::size_t n = 0; n < ascii_prefix; ++n ) {
+					*out++ = static_cast<CharT>( p[n] );
+				}
+				p += ascii_prefix;
+				do {
+					put_code_point( decode_valid( p ), out );
+				} while( p != last and byte( *p ) >= 0x80U );
+			}
+			while( p != last ) {
+				put_code_point( decode_valid( p ), out );
+			}
+			return out;
+		}
+
+		[[nodiscard]] DAW_ATTRIB_FLATTEN inline utf_transcode_result<char>
+		simd_from_utf16( char16_t const *p, char16_t const *last, char *out ) {
+			auto const high = _mm_set1_epi16( static_cast<short>( 0xFF80 ) );
+			while( last - p >= 16 ) {
+				auto const a = _mm_loadu_si128( reinterpret_cast<__m128i const *>( p ) );
+				auto const b =
+				  _mm_loadu_si128( reinterpret_cast<__m128i const *>( p + 8 ) );
+				auto const is_ascii =
+				  _mm_cmpeq_epi16( _mm_and_si128( _mm_or_si128( a, b ), high ),
+				                   _mm_setzero_si128( ) );
+				if( _mm_movemask_epi8( is_ascii ) == 0xFFFF ) {
+					_mm_storeu_si128( reinterpret_cast<__m128i *>( out ),
+					                  _mm_packus_epi16( a, b ) );
+					p += 16;
+					out += 16;
+					continue;
+				}
+				auto const *const stop = p + 16;
+				while( p < stop ) {
+					if( not utf16_step( p, last, out ) ) {
+						return { out, false };
+					}
+				}
+			}
+			while( p != last ) {
+				if( not utf16_step( p, last, out ) ) {
+					return { out, false };
+				}
+			}
+			return { out, true };
+		}
+
+		[[nodiscard]] DAW_ATTRIB_FLATTEN inline utf_transcode_result<char>
+		simd_from_utf32( char32_t const *p, char32_t const *last, char *out ) {
+			auto const high = _mm_set1_epi32( ~0x7F );
+			while( last - p >= 16 ) {
+				auto const a = _mm_loadu_si128( reinterpret_cast<__m128i const *>( p ) );
+				auto const b =
+				  _mm_loadu_si128( reinterpret_cast<__m128i const *>( p + 4 ) );
+				auto const c =
+				  _mm_loadu_si128( reinterpret_cast<__m128i const *>( p + 8 ) );
+				auto const d =
+				  _mm_loadu_si128( reinterpret_cast<__m128i const *>( p + 12 ) );
+				auto const is_ascii = _mm_cmpeq_epi32(
+				  _mm_and_si128( _mm_or_si128( _mm_or_si128( a, b ), _mm_or_si128( c, d ) ),
+				                 high ),
+				  _mm_setzero_si128( ) );
+				if( _mm_movemask_epi8( is_ascii ) == 0xFFFF ) {
+					_mm_storeu_si128( reinterpret_cast<__m128i *>( out ),
+					                  _mm_packus_epi16( _mm_packs_epi32( a, b ),
+					                                    _mm_packs_epi32( c, d ) ) );
+					p += 16;
+					out += 16;
+					continue;
+				}
+				for( int n = 0; n < 16; ++n ) {
+					if( not utf32_step( p, out ) ) {
+						return { out, false };
+					}
+				}
+			}
+			while( p != last ) {
+				if( not utf32_step( p, out ) ) {
+					return { out, false };
+				}
+			}
+			return { out, true };
+		}
+#endif
+
+		/// Transcode UTF-8 that is known to be well formed
+		template<typename CharT>
+		[[nodiscard]] constexpr CharT *convert_valid( daw::string_view in,
+		                                              CharT *out ) {
+#if defined( DAW_UTF8_HAS_SIMD )
+			DAW_IF_NOT_CONSTEVAL {
+				return simd_convert_valid( in.data( ), in.data( ) + in.size( ), out );
+			}
+#endif
+			auto const *p = in.data( );
+			auto const *const last = p + in.size( );
+			while( p != last ) {
+				put_code_point( decode_valid( p ), out );
+			}
+			return out;
+		}
+	} // namespace utf8_impl
+
+	/// @brief Find the first ill formed UTF-8 sequence in sv.  Overlong forms,
+	/// surrogates, values past U+10FFFF and truncated sequences are all errors
+	/// @return the position of the first byte of the ill formed sequence, or
+	/// daw::string_view::npos when sv is valid
+	[[nodiscard]] constexpr std::size_t find_invalid_utf8( daw::string_view sv ) {
+#if defined( DAW_UTF8_HAS_LOOKUP_VALIDATOR )
+		DAW_IF_NOT_CONSTEVAL {
+			if( utf8_impl::simd_is_valid( sv.data( ), sv.size( ) ) ) {
+				return daw::string_view::npos;
+			}
+		}
+#endif
+		return utf8_impl::scalar_find_invalid( sv.data( ), sv.size( ) );
+	}
+
+	/// @brief Is sv well formed UTF-8
+	[[nodiscard]] constexpr bool is_valid_utf8( daw::string_view sv ) {
+#if defined( DAW_UTF8_HAS_LOOKUP_VALIDATOR )
+		DAW_IF_NOT_CONSTEVAL {
+			return utf8_impl::simd_is_valid( sv.data( ), sv.size( ) );
+		}
+#endif
+		return utf8_impl::scalar_find_invalid( sv.data( ), sv.size( ) ) ==
+		       daw::string_view::npos;
+	}
+
+	/// @brief The number of code points in the well formed UTF-8 sv, this is also
+	/// the number of char32_t needed to transcode it
+	[[nodiscard]] constexpr std::size_t
+	count_utf8_code_points( daw::string_view sv ) {
+#if defined( DAW_UTF8_HAS_SIMD )
+		DAW_IF_NOT_CONSTEVAL {
+			return utf8_impl::simd_count( sv.data( ), sv.size( ),
+			                              utf8_impl::lead_byte_mask{ },
+			                              []( std::uint32_t b ) {
+				                              return not utf8_impl::is_continuation( b );
+			                              } );
+		}
+#endif
+		std::size_t result = 0;
+		for( char c : sv ) {
+			result += static_cast<std::size_t>(
+			  not utf8_impl::is_continuation( utf8_impl::byte( c ) ) );
+		}
+		return result;
+	}
+
+	/// @brief The number of char16_t needed to transcode the well formed UTF-8 sv
+	[[nodiscard]] constexpr std::size_t
+	utf16_length_from_utf8( daw::string_view sv ) {
+#if defined( DAW_UTF8_HAS_SIMD )
+		DAW_IF_NOT_CONSTEVAL {
+			return count_utf8_code_points( sv ) +
+			       utf8_impl::simd_count( sv.data( ), sv.size( ),
+			                              utf8_impl::four_byte_lead_mask{ },
+			                              []( std::uint32_t b ) {
+				                              return b >= 0xF0U;
+			                              } );
+		}
+#endif
+		std::size_t result = 0;
+		for( char c : sv ) {
+			auto const b = utf8_impl::byte( c );
+			result += static_cast<std::size_t>( not utf8_impl::is_continuation( b ) ) +
+			          static_cast<std::size_t>( b >= 0xF0U );
+		}
+		return result;
+	}
+
+	/// @brief The number of bytes needed to transcode in to UTF-8
+	[[nodiscard]] constexpr std::size_t
+	utf8_length_from_utf16( daw::u16string_view in ) {
+		std::size_t result = 0;
+		for( char16_t c : in ) {
+			auto const u = static_cast<std::uint32_t>( c );
+			// Each half of a surrogate pair counts for 2 of the 4 bytes
+			result += u < 0x80U ? 1U : ( u < 0x800U or ( u & 0xF800U ) == 0xD800U ) ? 2U : 3U;
+		}
+		return result;
+	}
+
+	/// @brief The number of bytes needed to transcode in to UTF-8
+	[[nodiscard]] constexpr std::size_t
+	utf8_length_from_utf32( daw::u32string_view in ) {
+		std::size_t result = 0;
+		for( char32_t c : in ) {
+			auto const u = static_cast<std::uint32_t>( c );
+			result += u < 0x80U ? 1U : u < 0x800U ? 2U : u < 0x1'0000U ? 3U : 4U;
+		}
+		return result;
+	}
+
+	/// @brief Transcode UTF-8 to UTF-16.  out must have room for
+	/// utf16_length_from_utf8( in ) code units, in.size( ) is always enough
+	[[nodiscard]] constexpr utf_transcode_result<char16_t>
+	utf8_to_utf16( daw::string_view in, char16_t *out ) {
+		if( not is_valid_utf8( in ) ) {
+			return { out, false };
+		}
+		return { utf8_impl::convert_valid( in, out ), true };
+	}
+
+	/// @brief Transcode UTF-8 to UTF-32.  out must have room for
+	/// count_utf8_code_points( in ) code units, in.size( ) is always enough
+	[[nodiscard]] constexpr utf_transcode_result<char32_t>
+	utf8_to_utf32( daw::string_view in, char32_t *out ) {
+		if( not is_valid_utf8( in ) ) {
+			return { out, false };
+		}
+		return { utf8_impl::convert_valid( in, out ), true };
+	}
+
+	/// @brief Transcode UTF-16 to UTF-8, unpaired surrogates are errors.  out
+	/// must have room for utf8_length_from_utf16( in ) bytes, 3 * in.size( ) is
+	/// always enough
+	[[nodiscard]] constexpr utf_transcode_result<char>
+	utf16_to_utf8( daw::u16string_view in, char *out ) {
+		auto const *p = in.data( );
+		auto const *const last = p + in.size( );
+#if defined( DAW_UTF8_HAS_SIMD )
+		DAW_IF_NOT_CONSTEVAL {
+			return utf8_impl::simd_from_utf16( p, last, out );
+		}
+#endif
+		while( p != last ) {
+			if( not utf8_impl::utf16_step( p, last, out ) ) {
+				return { out, false };
+			}
+		}
+		return { out, true };
+	}
+
+	/// @brief Transcode UTF-32 to UTF-8, surrogates and values past U+10FFFF are
+	/// errors.  out must have room for utf8_length_from_utf32( in ) bytes,
+	/// 4 * in.size( ) is always enough
+	[[nodiscard]] constexpr utf_transcode_result<char>
+	utf32_to_utf8( daw::u32string_view in, char *out ) {
+		auto const *p = in.data( );
+		auto const *const last = p + in.size( );
+#if defined( DAW_UTF8_HAS_SIMD )
+		DAW_IF_NOT_CONSTEVAL {
+			return utf8_impl::simd_from_utf32( p, last, out );
+		}
+#endif
+		while( p != last ) {
+			if( not utf8_impl::utf32_step( p, out ) ) {
+				return { out, false };
+			}
+		}
+		return { out, true };
+	}
+} // namespace daw
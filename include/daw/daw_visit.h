@@ -20,10 +20,12 @@
 #include "daw_unreachable.h"
 #include "impl/daw_make_trait.h"
 
+#include <array>
 #include <cstddef>
 #include <daw/stdinc/move_fwd_exch.h>
 #include <exception>
 #include <type_traits>
+#include <utility>
 #include <variant>
 
 namespace daw {
@@ -85,18 +87,22 @@ namespace daw {
 			return v.index( );
 		}
 
-	  DAW_MAKE_REQ_TRAIT( has_variant_npos, T::variant_npos );
-	  
-    template<typename Variant, std::enable_if_t<has_variant_npos<Variant>, std::nullptr_t> = nullptr> 
-	  DAW_ATTRIB_FLATINLINE constexpr bool is_empty( Variant const & v ) {
-		  return v.index( ) == Variant::variant_npos;
-		}
+		DAW_MAKE_REQ_TRAIT( has_variant_npos, T::variant_npos );
+
+		DAW_MAKE_REQ_TRAIT( has_valueless_by_exception,
+		                    std::declval<T const &>( ).valueless_by_exception( ) );
 
-    template<typename Variant, std::enable_if_t<not has_variant_npos<Variant>, std::nullptr_t> = nullptr> 
-	  DAW_ATTRIB_INLINE constexpr bool is_empty( Variant const & ) {
-      return false;
+		template<typename Variant>
+		DAW_ATTRIB_FLATINLINE constexpr bool is_empty( Variant const &v ) {
+			if constexpr( has_valueless_by_exception<Variant> ) {
+				return v.valueless_by_exception( );
+			} else if constexpr( has_variant_npos<Variant> ) {
+				return v.index( ) == Variant::variant_npos;
+			} else {
+				return false;
+			}
 		}
-	  
+
 		template<typename>
 		struct get_var_size;
 
@@ -417,6 +423,136 @@ namespace daw {
 		  DAW_FWD( var ), daw::visit_details::overload( DAW_FWD( visitors )... ) );
 	}
 
+	namespace visit_details {
+		/// @brief A flattened jump table for visiting several variants at once.
+		/// The alternative indices form a row major index into a single table
+		/// of function pointers, one per combination of alternatives.
+		template<typename R, typename Visitor, typename... Variants>
+		struct multi_visit_table {
+			static constexpr std::size_t variant_count = sizeof...( Variants );
+			static constexpr std::size_t sizes[] = {
+			  get_var_size_v<Variants>... };
+			static constexpr std::size_t total =
+			  ( std::size_t{ 1 } * ... * get_var_size_v<Variants> );
+
+			using function_t = R ( * )( Visitor &&, Variants &&... );
+
+			/// The alternative of the K'th variant for the flat index Flat
+			template<std::size_t Flat, std::size_t K>
+			static constexpr std::size_t alternative( ) {
+				std::size_t stride = 1;
+				for( std::size_t n = K + 1; n < variant_count; ++n ) {
+					stride *= sizes[n];
+				}
+				return ( Flat / stride ) % sizes[K];
+			}
+
+			template<std::size_t Flat, std::size_t... Ks>
+			DAW_ATTRIB_FLATINLINE static constexpr R
+			call_impl( std::index_sequence<Ks...>, Visitor &&vis,
+			           Variants &&...vars ) {
+				if constexpr( std::is_void_v<R> ) {
+					DAW_FWD( vis )( get_nt<alternative<Flat, Ks>( )>( DAW_FWD( vars ) )... );
+				} else {
+					return DAW_FWD( vis )(
+					  get_nt<alternative<Flat, Ks>( )>( DAW_FWD( vars ) )... );
+				}
+			}
+
+			template<std::size_t Flat>
+			static constexpr R call( Visitor &&vis, Variants &&...vars ) {
+				return call_impl<Flat>( std::index_sequence_for<Variants...>{ },
+				                        DAW_FWD( vis ), DAW_FWD( vars )... );
+			}
+
+			template<std::size_t... Flats>
+			static constexpr std::array<function_t, total>
+			make_table( std::index_sequence<Flats...> ) {
+				return { { &call<Flats>... } };
+			}
+
+			static constexpr std::array<function_t, total> table =
+			  make_table( std::make_index_sequence<total>{ } );
+
+			DAW_ATTRIB_FLATINLINE static constexpr R
+			visit( Visitor &&vis, Variants &&...vars ) {
+				std::size_t flat = 0;
+				std::size_t k = 0;
+				( (void)( flat = flat * sizes[k++] +
+				                 static_cast<std::size_t>( get_index( vars ) ) ),
+				  ... );
+				DAW_ASSUME( flat < total );
+				return table[flat]( DAW_FWD( vis ), DAW_FWD( vars )... );
+			}
+		};
+
+		template<typename R, typename Visitor, typename... Variants>
+		DAW_ATTRIB_FLATINLINE constexpr R multi_visit( Visitor &&vis,
+		                                               Variants &&...vars ) {
+			if constexpr( sizeof...( Variants ) == 1 ) {
+				return visit_details::visit_nt<0, R>( DAW_FWD( vars )...,
+				                                      DAW_FWD( vis ) );
+			} else {
+				return multi_visit_table<R, Visitor, Variants...>::visit(
+				  DAW_FWD( vis ), DAW_FWD( vars )... );
+			}
+		}
+
+		template<typename Visitor, typename... Variants>
+		using multi_visit_result_t = decltype( std::declval<Visitor>( )(
+		  get_nt<0>( std::declval<Variants>( ) )... ) );
+	} // namespace visit_details
+
+	/// @brief Visit any number of variants with a single jump through a
+	/// table holding every combination of alternatives.  The variants must not
+	/// be valueless.  The result type is that of
+	/// vis( get_nt<0>( vars )... ) and every other combination must be
+	/// convertible to it.
+	template<typename Visitor, typename Variant, typename... Variants>
+	[[nodiscard]] constexpr decltype( auto )
+	visit_unchecked( Visitor &&vis, Variant &&var, Variants &&...vars ) {
+		using result_t =
+		  visit_details::multi_visit_result_t<Visitor, Variant, Variants...>;
+		return visit_details::multi_visit<result_t>(
+		  DAW_FWD( vis ), DAW_FWD( var ), DAW_FWD( vars )... );
+	}
+
+	template<typename Result, typename Visitor, typename Variant,
+	         typename... Variants>
+	[[nodiscard]] constexpr Result
+	visit_unchecked( Visitor &&vis, Variant &&var, Variants &&...vars ) {
+		return visit_details::multi_visit<Result>( DAW_FWD( vis ), DAW_FWD( var ),
+		                                           DAW_FWD( vars )... );
+	}
+
+	/// @brief Visit any number of variants, like std::visit, dispatching
+	/// through a single flattened jump table.
+	/// @throws daw::bad_variant_access if any of the variants are valueless
+	template<typename Visitor, typename Variant, typename... Variants>
+	[[nodiscard]] constexpr decltype( auto )
+	visit_multi( Visitor &&vis, Variant &&var, Variants &&...vars ) {
+		if( DAW_UNLIKELY( ( visit_details::is_empty( var ) or ... or
+		                    visit_details::is_empty( vars ) ) ) ) {
+			DAW_UNLIKELY_BRANCH
+			visit_details::visit_error( );
+		}
+		return daw::visit_unchecked( DAW_FWD( vis ), DAW_FWD( var ),
+		                             DAW_FWD( vars )... );
+	}
+
+	template<typename Result, typename Visitor, typename Variant,
+	         typename... Variants>
+	[[nodiscard]] constexpr Result visit_multi( Visitor &&vis, Variant &&var,
+	                                            Variants &&...vars ) {
+		if( DAW_UNLIKELY( ( visit_details::is_empty( var ) or ... or
+		                    visit_details::is_empty( vars ) ) ) ) {
+			DAW_UNLIKELY_BRANCH
+			visit_details::visit_error( );
+		}
+		return daw::visit_unchecked<Result>( DAW_FWD( vis ), DAW_FWD( var ),
+		                                     DAW_FWD( vars )... );
+	}
+
 	template<typename Value, typename... Visitors>
 	inline constexpr bool is_visitable_v =
 	  ( std::is_invocable_v<Visitors, Value> or ... );
@@ -9,105 +9,355 @@
 #pragma once
 
 #include "ciso646.h"
-#include "daw_string_view.h"
-#include "daw_traits.h"
+#include "daw_attributes.h"
+#include "daw_cpp_feature_check.h"
+#include "daw_ensure.h"
+#include "daw_remove_cvref.h"
+#include "daw_string_concat.h"
+#include "traits/daw_traits_is_span_writer.h"
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
-/// formatter will directly substitute variables into a string
-/// Uses a format like "{0} {1} {0}" which is a zero index array
-/// of the arguments
-
-#include <cstddef>
-
+/// Compiled format strings.  The format string is parsed completely at
+/// compile time into literal segments and argument slots, so formatting is a
+/// straight line sequence of memcpy's and argument writes into a caller
+/// supplied buffer.
+/// Slots are "{}", numbered in order, or "{n}", a zero based index into the
+/// arguments, e.g. "{0} {1} {0}".  The two styles cannot be mixed.  "{{" and
+/// "}}" are a literal brace.  Arguments can be anything daw::concat accepts:
+/// string like types, characters, bool, integers and floating point numbers.
+/// e.g.
+///   auto buff = std::array<char, 64>{ };
+///   char *last = daw::format_to( buff.data( ),
+///                                daw::compiled_fmt<"{}: {}">, "x", 42 );
+#if defined( DAW_HAS_CPP20_CLASS_NTTP )
 namespace daw {
-	namespace impl {
-		class brace_splitter_t {
-			enum class states_t : uint8_t { in_escape = 1, in_brace = 2 };
-			std::size_t m_size;
-			uint8_t m_state;
-
-			constexpr bool get_state( states_t s ) noexcept {
-				return ( m_state & static_cast<uint8_t>( s ) ) != 0;
-			}
+	/// @brief A string literal usable as a template parameter
+	template<std::size_t N>
+	struct format_literal {
+		static_assert( N > 0 );
+		char value[N]{ };
 
-			constexpr void set_state( states_t s ) noexcept {
-				m_state |= static_cast<uint8_t>( s );
+		constexpr format_literal( char const ( &str )[N] ) noexcept {
+			for( std::size_t n = 0; n < N; ++n ) {
+				value[n] = str[n];
 			}
+		}
 
-			constexpr void unset_state( states_t s ) noexcept {
-				m_state &= ~static_cast<uint8_t>( s );
-			}
+		[[nodiscard]] static constexpr std::size_t size( ) noexcept {
+			return N - 1;
+		}
+	};
+
+	/// @brief Returned by max_size when the size of an argument type is only
+	/// known at runtime, e.g. strings
+	inline constexpr std::size_t dynamic_format_size =
+	  std::numeric_limits<std::size_t>::max( );
+
+	namespace format_impl {
+		enum class segment_kind : std::uint8_t { literal, argument };
+
+		struct segment {
+			segment_kind kind = segment_kind::literal;
+			/// literal: offset into the unescaped text
+			std::size_t first = 0;
+			/// literal: length of the text
+			std::size_t size = 0;
+			/// argument: index of the argument to write
+			std::size_t arg_index = 0;
+		};
+
+		/// Not constexpr, so reaching it while parsing at compile time makes
+		/// the format string a compile error pointing here
+		[[noreturn]] inline void invalid_format_string( char const * ) {
+			std::abort( );
+		}
+
+		template<std::size_t N>
+		struct parsed_format {
+			std::array<segment, N> segments{ };
+			std::size_t segment_count = 0;
+			std::array<char, N> text{ };
+			std::size_t text_size = 0;
+			std::size_t arg_count = 0;
+		};
 
-			constexpr void switch_state( states_t s ) noexcept {
-				if( get_state( s ) ) {
-					set_state( s );
+		template<std::size_t N>
+		[[nodiscard]] constexpr parsed_format<N>
+		parse_format( format_literal<N> const &fmt ) {
+			auto result = parsed_format<N>{ };
+			auto const *str = fmt.value;
+			std::size_t const sz = fmt.size( );
+			bool has_auto = false;
+			bool has_manual = false;
+			std::size_t next_auto = 0;
+
+			auto const add_char = [&]( char c ) {
+				if( result.segment_count == 0 or
+				    result.segments[result.segment_count - 1].kind !=
+				      segment_kind::literal ) {
+					result.segments[result.segment_count++] =
+					  segment{ segment_kind::literal, result.text_size, 0, 0 };
+				}
+				result.text[result.text_size++] = c;
+				++result.segments[result.segment_count - 1].size;
+			};
+
+			std::size_t pos = 0;
+			while( pos < sz ) {
+				char const c = str[pos];
+				if( c == '}' ) {
+					if( pos + 1 >= sz or str[pos + 1] != '}' ) {
+						invalid_format_string( "Unmatched '}' in format string" );
+					}
+					add_char( '}' );
+					pos += 2;
+					continue;
+				}
+				if( c != '{' ) {
+					add_char( c );
+					++pos;
+					continue;
+				}
+				if( pos + 1 < sz and str[pos + 1] == '{' ) {
+					add_char( '{' );
+					pos += 2;
+					continue;
+				}
+				++pos;
+				std::size_t index = 0;
+				if( pos < sz and str[pos] == '}' ) {
+					has_auto = true;
+					index = next_auto++;
 				} else {
-					unset_state( s );
+					has_manual = true;
+					if( pos >= sz or str[pos] < '0' or str[pos] > '9' ) {
+						invalid_format_string( "Expected '}' or an argument index" );
+					}
+					while( pos < sz and str[pos] >= '0' and str[pos] <= '9' ) {
+						index = index * 10U + static_cast<std::size_t>( str[pos] - '0' );
+						++pos;
+					}
+					if( pos >= sz or str[pos] != '}' ) {
+						invalid_format_string( "Expected '}' after argument index" );
+					}
+				}
+				if( has_auto and has_manual ) {
+					invalid_format_string(
+					  "Cannot mix automatic and manual argument indexing" );
+				}
+				++pos;
+				result.segments[result.segment_count++] =
+				  segment{ segment_kind::argument, 0, 0, index };
+				if( index + 1 > result.arg_count ) {
+					result.arg_count = index + 1;
 				}
 			}
+			return result;
+		}
 
-			constexpr void count_if( ) noexcept {
-				if( get_state( states_t::in_brace ) ) {
-					++m_size;
-				}
+		/// @brief The most characters an argument of type T can format to, or
+		/// dynamic_format_size
+		template<typename T>
+		[[nodiscard]] constexpr std::size_t max_formatted_size( ) noexcept {
+			if constexpr( std::is_same_v<T, char> ) {
+				return 1;
+			} else if constexpr( std::is_same_v<T, bool> ) {
+				return 5;
+			} else if constexpr( std::is_integral_v<T> ) {
+				return static_cast<std::size_t>( std::numeric_limits<T>::digits10 ) +
+				       1U + ( std::is_signed_v<T> ? 1U : 0U );
+			} else if constexpr( std::is_same_v<T, float> ) {
+				// -1.17549435e-38
+				return 15;
+			} else if constexpr( std::is_same_v<T, double> ) {
+				// -2.2250738585072014e-308
+				return 24;
+			} else if constexpr( std::is_floating_point_v<T> ) {
+				return std::tuple_size_v<
+				  decltype( string_concat_impl::float_piece::buff )>;
+			} else if constexpr( std::is_array_v<T> ) {
+				// string literals, the trailing zero is not written
+				return std::extent_v<T> - 1U;
+			} else {
+				return dynamic_format_size;
 			}
+		}
+	} // namespace format_impl
 
-		public:
-			constexpr brace_splitter_t( )
-			  : m_size{ 0 }
-			  , m_state{ 0 } {}
+	/// @brief A format string parsed at compile time.  Use the compiled_fmt
+	/// variable template to name one
+	template<format_literal Fmt>
+	struct compiled_format {
+		static constexpr auto parsed = format_impl::parse_format( Fmt );
+		/// Number of arguments the format string requires
+		static constexpr std::size_t arg_count = parsed.arg_count;
+		/// Number of characters of literal text
+		static constexpr std::size_t literal_size = parsed.text_size;
+		static constexpr std::size_t segment_count = parsed.segment_count;
 
-			constexpr bool operator( )( char c ) {
-				if( m_state == 0 ) {
-					m_size = 0;
-				}
-				switch( c ) {
-				case '{':
-					if( get_state( states_t::in_escape ) ) {
-						count_if( );
-						unset_state( states_t::in_escape );
-						return true;
+		/// @brief Upper bound of the output size for arguments of type Args, or
+		/// dynamic_format_size when an argument's size is only known at runtime
+		template<typename... Args>
+		[[nodiscard]] static constexpr std::size_t max_size( ) noexcept {
+			static_assert( sizeof...( Args ) == arg_count,
+			               "Argument count does not match the format string" );
+			constexpr auto arg_sizes = std::array<std::size_t, sizeof...( Args ) + 1>{
+			  format_impl::max_formatted_size<daw::remove_cvref_t<Args>>( )..., 0 };
+			std::size_t result = literal_size;
+			for( std::size_t n = 0; n < segment_count; ++n ) {
+				auto const &seg = parsed.segments[n];
+				if( seg.kind == format_impl::segment_kind::argument ) {
+					if( arg_sizes[seg.arg_index] == dynamic_format_size ) {
+						return dynamic_format_size;
 					}
-					daw::exception::daw_throw_on_true( get_state( states_t::in_brace ),
-					                                   "Invalid brace within brace" );
-					set_state( states_t::in_brace );
-					return true;
-				case '}':
-					if( get_state( states_t::in_escape ) ) {
-						count_if( );
-						unset_state( states_t::in_escape );
-						return true;
-					}
-					daw::exception::daw_throw_on_false(
-					  get_state( states_t::in_brace ),
-					  "Invalid close brace without opening brace" );
-					m_state = 0;
-					return false;
-				case '\\':
-					switch_state( states_t::in_escape );
-					count_if( );
-					return true;
+					result += arg_sizes[seg.arg_index];
 				}
 			}
+			return result;
+		}
 
-			constexpr std::size_t size( ) const noexcept {
-				return m_size;
+	private:
+		template<std::size_t I, typename Pieces>
+		DAW_ATTRIB_INLINE static char *write_segment( char *out,
+		                                              Pieces const &pieces ) {
+			constexpr auto seg = parsed.segments[I];
+			if constexpr( seg.kind == format_impl::segment_kind::literal ) {
+				std::memcpy( out, parsed.text.data( ) + seg.first, seg.size );
+				return out + seg.size;
+			} else {
+				return std::get<seg.arg_index>( pieces ).write( out );
 			}
-		};
+		}
 
-		/*
-		template<std::size_t N>
-		constexpr size_t find_variable_count( char const ( &str )[N] ) {
+		template<typename Pieces, std::size_t... Is>
+		DAW_ATTRIB_INLINE static char *
+		write_segments( char *out, Pieces const &pieces,
+		                std::index_sequence<Is...> ) {
+			( (void)( out = write_segment<Is>( out, pieces ) ), ... );
+			return out;
+		}
+
+		template<std::size_t I, typename Pieces>
+		[[nodiscard]] static constexpr std::size_t
+		segment_size( Pieces const &pieces ) {
+			constexpr auto seg = parsed.segments[I];
+			if constexpr( seg.kind == format_impl::segment_kind::literal ) {
+				return seg.size;
+			} else {
+				return std::get<seg.arg_index>( pieces ).size( );
+			}
+		}
+
+		template<typename Pieces, std::size_t... Is>
+		[[nodiscard]] static constexpr std::size_t
+		segments_size( Pieces const &pieces, std::index_sequence<Is...> ) {
+			return ( std::size_t{ 0 } + ... + segment_size<Is>( pieces ) );
+		}
+
+		template<typename... Args>
+		[[nodiscard]] DAW_ATTRIB_INLINE static auto
+		make_pieces( Args const &...args ) {
+			static_assert( sizeof...( Args ) == arg_count,
+			               "Argument count does not match the format string" );
+			return std::tuple{ string_concat_impl::make_piece( args )... };
+		}
 
-		  for( size_t n = 0; n < N - 1; ++n ) {}
+	public:
+		/// @brief The exact number of characters format_to will write
+		template<typename... Args>
+		[[nodiscard]] static std::size_t formatted_size( Args const &...args ) {
+			return segments_size( make_pieces( args... ),
+			                      std::make_index_sequence<segment_count>{ } );
 		}
-		 */
-	} // namespace impl
 
-	template<size_t N>
-	constexpr auto make_formatter( char const ( &str )[N] ) {
-		size_t num_vars = find_variable_count( str );
+		/// @pre out has room for formatted_size( args... ) characters
+		/// @return One past the last character written
+		template<typename... Args>
+		static char *format_to( char *out, Args const &...args ) {
+			return write_segments( out, make_pieces( args... ),
+			                       std::make_index_sequence<segment_count>{ } );
+		}
+
+		/// @brief Append the formatted text to out, growing it exactly once
+		template<typename Container, typename... Args>
+		static Container &format_append( Container &out, Args const &...args ) {
+			auto const pieces = make_pieces( args... );
+			auto const sz =
+			  segments_size( pieces, std::make_index_sequence<segment_count>{ } );
+			string_concat_impl::append_exact( out, sz, [&]( char *p ) {
+				return write_segments( p, pieces,
+				                       std::make_index_sequence<segment_count>{ } );
+			} );
+			return out;
+		}
+
+		/// @brief Write to a span_writer like Writer, one that has data( ),
+		/// size( ), and remove_prefix( n ), and advance it
+		/// @pre writer.size( ) >= formatted_size( args... )
+		template<typename Writer, typename... Args>
+		static Writer &format_to_writer( Writer &writer, Args const &...args ) {
+			auto const pieces = make_pieces( args... );
+			auto const sz =
+			  segments_size( pieces, std::make_index_sequence<segment_count>{ } );
+			daw_ensure( sz <= static_cast<std::size_t>( writer.size( ) ) );
+			(void)write_segments( writer.data( ), pieces,
+			                      std::make_index_sequence<segment_count>{ } );
+			writer.remove_prefix( sz );
+			return writer;
+		}
+	};
+
+	/// @brief Parse Fmt at compile time, e.g. daw::compiled_fmt<"{} = {}">
+	template<format_literal Fmt>
+	inline constexpr compiled_format<Fmt> compiled_fmt{ };
+
+	template<format_literal Fmt, typename... Args>
+	[[nodiscard]] std::size_t formatted_size( compiled_format<Fmt>,
+	                                          Args const &...args ) {
+		return compiled_format<Fmt>::formatted_size( args... );
+	}
+
+	/// @brief Write the formatted text to out
+	/// @pre out has room for formatted_size( fmt, args... ) characters
+	/// @return One past the last character written
+	template<format_literal Fmt, typename... Args>
+	char *format_to( char *out, compiled_format<Fmt>, Args const &...args ) {
+		return compiled_format<Fmt>::format_to( out, args... );
+	}
+
+	/// @brief Write the formatted text to a span_writer like type and advance
+	/// it past the text
+	template<
+	  typename Writer, format_literal Fmt, typename... Args,
+	  std::enable_if_t<traits::is_span_writer_v<Writer>, std::nullptr_t> = nullptr>
+	Writer &format_to( Writer &writer, compiled_format<Fmt>,
+	                   Args const &...args ) {
+		return compiled_format<Fmt>::format_to_writer( writer, args... );
+	}
+
+	/// @brief Append the formatted text to a contiguous character container
+	template<typename Container, format_literal Fmt, typename... Args>
+	Container &format_append( Container &out, compiled_format<Fmt>,
+	                          Args const &...args ) {
+		return compiled_format<Fmt>::format_append( out, args... );
+	}
+
+	template<typename Result = std::string, format_literal Fmt,
+	         typename... Args>
+	[[nodiscard]] Result format( compiled_format<Fmt>, Args const &...args ) {
+		auto result = Result( );
+		(void)compiled_format<Fmt>::format_append( result, args... );
+		return result;
 	}
 } // namespace daw
+#endif
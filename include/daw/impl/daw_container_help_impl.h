@@ -9,6 +9,7 @@
 #pragma once
 
 #include "daw/daw_exchange.h"
+#include "daw/daw_span.h"
 
 #include <cstddef>
 #include <daw/stdinc/data_access.h>
@@ -25,23 +26,27 @@ namespace daw {
 		using alloc_traits = std::allocator_traits<Allocator>;
 		using pointer = typename alloc_traits::pointer;
 		std::size_t capacity = 0;
+		/// The number of constructed elements at the front of the buffer
+		std::size_t size = 0;
 
 		explicit container_deleter( ) = default;
 		explicit constexpr container_deleter(
 		  Allocator alloc,
-		  std::size_t
-		    sz ) noexcept( std::is_nothrow_move_constructible_v<Allocator> )
+		  std::size_t cap,
+		  std::size_t sz ) noexcept( std::is_nothrow_move_constructible_v<Allocator> )
 		  : Allocator( std::move( alloc ) )
-		  , capacity( sz ) {}
+		  , capacity( cap )
+		  , size( sz ) {}
 
 		constexpr std::pair<Allocator, std::size_t> extract_allocator( ) {
+			size = 0;
 			return std::pair<Allocator, std::size_t>{
 			  std::move( *static_cast<Allocator *>( this ) ),
 			  daw::exchange( capacity, 0U ) };
 		}
 
 		constexpr void operator( )( pointer p ) {
-			auto count = capacity;
+			auto count = size;
 			if constexpr( not std::is_trivially_destructible_v<
 			                typename std::pointer_traits<pointer>::element_type> ) {
 				while( count-- > 0 ) {
@@ -50,9 +55,13 @@ namespace daw {
 			}
 			alloc_traits::deallocate( *this, p, capacity );
 			capacity = 0;
+			size = 0;
 		}
 	};
 
+	/// An owning buffer taken from a container.  The first size( ) elements are
+	/// constructed and the allocation of capacity( ) elements is released with
+	/// the allocator it came from
 	template<typename T, typename Allocator>
 	class container_data {
 		using deleter_type = container_deleter<T, Allocator>;
@@ -62,8 +71,6 @@ namespace daw {
 
 		data_type m_data = data_type( );
 
-		size_type m_size = 0;
-
 	public:
 		explicit container_data( ) = default;
 
@@ -71,24 +78,48 @@ namespace daw {
 		                                   Allocator alloc,
 		                                   size_type sz,
 		                                   size_type cap )
-		  : m_data( buff, deleter_type( std::move( alloc ), cap ) )
-		  , m_size( sz ) {}
+		  : m_data( buff, deleter_type( std::move( alloc ), cap, sz ) ) {}
 
 		[[nodiscard]] constexpr pointer data( ) const noexcept {
 			return m_data.get( );
 		}
 
 		[[nodiscard]] constexpr size_type size( ) const noexcept {
-			return m_size;
+			return m_data.get_deleter( ).size;
 		}
 
 		[[nodiscard]] constexpr size_type capacity( ) const noexcept {
 			return m_data.get_deleter( ).capacity;
 		}
 
+		[[nodiscard]] constexpr bool empty( ) const noexcept {
+			return size( ) == 0;
+		}
+
+		[[nodiscard]] constexpr Allocator get_allocator( ) const {
+			return static_cast<Allocator const &>( m_data.get_deleter( ) );
+		}
+
+		[[nodiscard]] constexpr daw::span<T> span( ) noexcept {
+			return daw::span<T>( data( ), size( ) );
+		}
+
+		[[nodiscard]] constexpr daw::span<T const> span( ) const noexcept {
+			return daw::span<T const>( data( ), size( ) );
+		}
+
+		/// Give up ownership of the buffer.  The caller must destroy the size( )
+		/// elements and deallocate capacity( ) with get_allocator( ), so read them
+		/// first
+		[[nodiscard]] constexpr pointer release( ) noexcept {
+			auto &d = m_data.get_deleter( );
+			d.size = 0;
+			d.capacity = 0;
+			return m_data.release( );
+		}
+
 		constexpr void reset( ) {
 			m_data.reset( );
-			m_size = 0;
 		}
 	};
 } // namespace daw
@@ -27,7 +27,7 @@ namespace daw::string_extract_impl {
 	struct basic_string {
 
 		using Char_alloc_type =
-		  typename ::std::allocator_traits<Alloc>::template rebind<CharT>::other;
+		  typename ::std::allocator_traits<Alloc>::template rebind_alloc<CharT>;
 
 		using Alloc_traits = std::allocator_traits<Char_alloc_type>;
 
@@ -36,8 +36,8 @@ namespace daw::string_extract_impl {
 		using allocator_type = Char_alloc_type;
 		using size_type = typename Alloc_traits::size_type;
 		using difference_type = typename Alloc_traits::difference_type;
-		using reference = typename Alloc_traits::reference;
-		using const_reference = typename Alloc_traits::const_reference;
+		using reference = value_type &;
+		using const_reference = value_type const &;
 		using pointer = typename Alloc_traits::pointer;
 		using const_pointer = typename Alloc_traits::const_pointer;
 		using iterator = __gnu_cxx::__normal_iterator<pointer, basic_string>;
@@ -959,3 +959,91 @@ namespace daw::string_extract_impl {
 	};
 #endif
 } // namespace daw::string_extract_impl
+
+namespace daw {
+	namespace container_help_impl {
+#if defined( __GLIBCXX__ ) and _GLIBCXX_USE_CXX11_ABI
+#define DAW_HAS_STD_STRING_BUFFER_TRANSFER
+
+		template<typename CharT, typename Traits, typename Allocator>
+		auto *string_layout( std::basic_string<CharT, Traits, Allocator> &str ) {
+			using str_t = std::basic_string<CharT, Traits, Allocator>;
+			using layout_t =
+			  daw::string_extract_impl::basic_string<CharT, Traits, Allocator>;
+			static_assert( sizeof( layout_t ) == sizeof( str_t ), "mismatch" );
+			static_assert( alignof( layout_t ) == alignof( str_t ), "mismatch" );
+			return reinterpret_cast<layout_t *>( std::addressof( str ) );
+		}
+#endif
+	} // namespace container_help_impl
+
+	/// Heap allocated strings give up their buffer, which holds capacity( ) + 1
+	/// characters.  Short strings live inside the string object and are copied.
+	template<typename CharT, typename Traits, typename Allocator>
+	struct extract_from_container_t<std::basic_string<CharT, Traits, Allocator>> {
+		explicit extract_from_container_t( ) = default;
+
+		container_data<CharT, Allocator>
+		operator( )( std::basic_string<CharT, Traits, Allocator> &str ) const {
+			using alloc_traits = std::allocator_traits<Allocator>;
+			auto const sz = str.size( );
+			auto alloc = str.get_allocator( );
+#if defined( DAW_HAS_STD_STRING_BUFFER_TRANSFER )
+			auto *layout = container_help_impl::string_layout( str );
+			if( not layout->m_is_local( ) ) {
+				auto const cap = str.capacity( ) + 1U;
+				auto buff = layout->m_data( );
+				layout->m_data( layout->m_local_data( ) );
+				layout->m_set_length( 0 );
+				return container_data<CharT, Allocator>( buff, std::move( alloc ), sz,
+				                                         cap );
+			}
+#endif
+			if( sz == 0 ) {
+				return container_data<CharT, Allocator>( );
+			}
+			auto buff = alloc_traits::allocate( alloc, sz );
+			Traits::copy( buff, str.data( ), sz );
+			str.clear( );
+			return container_data<CharT, Allocator>( buff, std::move( alloc ), sz, sz );
+		}
+	};
+
+	/// The buffer is adopted when it has room for the trailing zero, is larger
+	/// than the short string buffer and the allocators compare equal.  Otherwise
+	/// the characters are copied and the buffer released.
+	template<typename CharT, typename Traits, typename Allocator>
+	struct insert_into_container_t<std::basic_string<CharT, Traits, Allocator>> {
+		using alloc_type = Allocator;
+		using alloc_traits = std::allocator_traits<alloc_type>;
+		using pointer = typename alloc_traits::pointer;
+
+		explicit insert_into_container_t( ) = default;
+
+		void operator( )( std::basic_string<CharT, Traits, Allocator> &str,
+		                  pointer buff,
+		                  alloc_type alloc,
+		                  std::size_t capacity,
+		                  std::size_t size ) const {
+			auto data =
+			  container_data<CharT, Allocator>( buff, std::move( alloc ), size, capacity );
+#if defined( DAW_HAS_STD_STRING_BUFFER_TRANSFER )
+			using layout_t =
+			  daw::string_extract_impl::basic_string<CharT, Traits, Allocator>;
+			if( capacity > size and
+			    capacity - 1U > static_cast<std::size_t>( layout_t::s_local_capacity ) and
+			    data.get_allocator( ) == str.get_allocator( ) ) {
+				// Swapping with an empty string releases any allocation str has
+				std::basic_string<CharT, Traits, Allocator>( str.get_allocator( ) )
+				  .swap( str );
+				auto *layout = container_help_impl::string_layout( str );
+				layout->m_data( data.release( ) );
+				layout->m_capacity( capacity - 1U );
+				layout->m_set_length( size );
+				return;
+			}
+#endif
+			str.assign( data.data( ), size );
+		}
+	};
+} // namespace daw
@@ -12,9 +12,11 @@
 
 #include <cassert>
 #include <cstddef>
+#include <iterator>
 #include <memory>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "daw_container_help_impl.h"
 #include "daw_container_help_ins_ext.h"
@@ -23,6 +25,7 @@ namespace daw {
 	namespace container_help_impl {
 #if defined( _LIBCPP_VECTOR )
 		// libc++
+#define DAW_HAS_STD_VECTOR_BUFFER_TRANSFER
 
 		template<typename T, typename Alloc>
 		struct std_vector_layout {
@@ -51,8 +54,7 @@ namespace daw {
 				if constexpr( alloc_traits::is_always_equal::value ) {
 					return alloc_type( );
 				} else {
-					return std::move(
-					  *static_cast<alloc_type *>( m_capacity.second( ) ) );
+					return std::move( m_capacity.second( ) );
 				}
 			}
 
@@ -89,193 +91,107 @@ namespace daw {
 				m_first = p;
 			}
 		};
-#elif defined( _GLIBCXX_VECTOR )
-		// libstdc++
-	}
-}
-template<typename T, typename Allocator>
-struct StdVecStart : daw::pa::member_variable_wrapper<
-                       std::vector<T, Allocator>,
-                       typename std::vector<T, Allocator>::pointer> {};
-template<typename T, typename Allocator>
-struct daw::pa::make_proxy<StdVecStart<T, Allocator>,
-                                   &std::vector<T, Allocator>::_M_start>;
-
-template<typename T, typename Allocator>
-struct StdVecFinish : daw::pa::member_variable_wrapper<
-                        std::vector<T, Allocator>,
-                        typename std::vector<T, Allocator>::pointer> {};
-template<typename T, typename Allocator>
-struct daw::pa::make_proxy<StdVecFinish<T, Allocator>,
-                                   &std::vector<T, Allocator>::_M_finish>;
-
-template<typename T, typename Allocator>
-struct StdVecEndOfStorage : daw::pa::member_variable_wrapper<
-                              std::vector<T, Allocator>,
-                              typename std::vector<T, Allocator>::pointer> {};
-template<typename T, typename Allocator>
-struct daw::pa::make_proxy<
-  StdVecEndOfStorage<T, Allocator>,
-  &std::vector<T, Allocator>::_M_end_of_storage>;
-
-template<typename T, typename Allocator>
-struct StdVecImpl
-  : daw::pa::member_variable_wrapper<std::vector<T, Allocator>,
-                                           Allocator> {};
-template<typename T, typename Allocator>
-struct daw::pa::make_proxy<StdVecImpl<T, Allocator>,
-                                   &std::vector<T, Allocator>::_M_impl>;
-
-namespace daw {
-	namespace container_help_impl {
-		template<typename T, typename Alloc>
-		struct std_vector_layout_impl {
-			static_assert( not std::is_same_v<T, bool>, "bad instance" );
-
-			template<typename A>
-			using alloc_traits_t = typename __gnu_cxx::__alloc_traits<A>;
-
-			using allocator_type = Alloc;
-			using allocator_traits = alloc_traits_t<allocator_type>;
-			using rebound_allocator_type =
-			  typename allocator_traits::template rebind<T>::other;
-			using rebound_allocator_traits = alloc_traits_t<rebound_allocator_type>;
-			using pointer = typename rebound_allocator_traits::pointer;
-
-			static_assert( not std::is_same_v<T, bool>, "bad instance" );
-
-			struct impl_type : rebound_allocator_type {
-				pointer m_first;
-				pointer m_last;
-				pointer m_capacity;
-			};
-		};
 
 		template<typename T, typename Allocator>
-		using rebound_allocator_type =
-		  typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+		auto *vector_layout( std::vector<T, Allocator> &vec ) noexcept {
+			using vec_t = std::vector<T, Allocator>;
+			using layout_t = std_vector_layout<T, Allocator>;
+			static_assert( sizeof( layout_t ) == sizeof( vec_t ), "mismatch" );
+			static_assert( alignof( layout_t ) == alignof( vec_t ), "mismatch" );
+			return reinterpret_cast<layout_t *>( std::addressof( vec ) );
+		}
 
 		template<typename T, typename Allocator>
-		constexpr decltype( auto ) first_ptr( std::vector<T, Allocator> &vec ) {
-			return daw::pa::access_member<StdVecStart<T, Allocator>>( vec );
+		constexpr Allocator take_allocator( std::vector<T, Allocator> &vec ) {
+			return vector_layout( vec )->take_allocator( );
 		}
 
 		template<typename T, typename Allocator>
-		constexpr decltype( auto ) last_ptr( std::vector<T, Allocator> &vec ) {
-			return daw::pa::access_member<StdVecFinish<T, Allocator>>( vec );
+		constexpr auto take_buffer( std::vector<T, Allocator> &vec ) {
+			return vector_layout( vec )->take_buffer( );
 		}
 
+		/// @pre vec has no allocation
 		template<typename T, typename Allocator>
-		constexpr decltype( auto ) capacity_ptr( std::vector<T, Allocator> &vec ) {
-			return daw::pa::access_member<StdVecEndOfStorage<T, Allocator>>( vec );
+		constexpr void give_buffer( std::vector<T, Allocator> &vec,
+		                            typename std::vector<T, Allocator>::pointer p,
+		                            Allocator alloc,
+		                            std::size_t capacity,
+		                            std::size_t size ) {
+			auto *layout = vector_layout( vec );
+			layout->give_allocator( std::move( alloc ) );
+			layout->give_buffer( p );
+			layout->capacity( capacity );
+			layout->size( size );
 		}
+#elif defined( _GLIBCXX_VECTOR )
+		// libstdc++
+#define DAW_HAS_STD_VECTOR_BUFFER_TRANSFER
 
+		/// std::vector privately derives from _Vector_base whose public _M_impl
+		/// holds the allocator and the three pointers.  Only a C-style cast may
+		/// convert to an inaccessible base.
 		template<typename T, typename Allocator>
-		constexpr decltype( auto ) get_alloc( std::vector<T, Allocator> &vec ) {
-			return daw::pa::access_member<StdVecImpl<T, Allocator>>( vec );
+		constexpr auto &vector_impl( std::vector<T, Allocator> &vec ) noexcept {
+			using base_t = std::_Vector_base<T, Allocator>;
+#if defined( __GNUC__ )
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wold-style-cast"
+#endif
+			return ( (base_t &)vec )._M_impl;
+#if defined( __GNUC__ )
+#pragma GCC diagnostic pop
+#endif
 		}
 
 		template<typename T, typename Allocator>
-		constexpr auto take_allocator( std::vector<T, Allocator> &vec ) {
+		constexpr Allocator take_allocator( std::vector<T, Allocator> &vec ) {
 			using alloc_traits = std::allocator_traits<Allocator>;
-			using alloc = rebound_allocator_type<T, Allocator>;
 			static_assert(
 			  alloc_traits::is_always_equal::value or
 			    alloc_traits::propagate_on_container_move_assignment::value,
 			  "Unsupported allocator" );
 			if constexpr( alloc_traits::is_always_equal::value ) {
-				return alloc{ };
+				return Allocator{ };
 			} else {
-				return std::move( get_alloc( vec ).get( ) );
+				return std::move( static_cast<Allocator &>( vector_impl( vec ) ) );
 			}
 		}
 
 		template<typename T, typename Allocator>
 		constexpr auto take_buffer( std::vector<T, Allocator> &vec ) {
 			using pointer = typename std::vector<T, Allocator>::pointer;
-			auto ret = daw::exchange( first_ptr( vec ).get( ), pointer( ) );
-			last_ptr( vec ).get( ) = pointer( );
-			capacity_ptr( vec ).get( ) = pointer( );
+			auto &impl = vector_impl( vec );
+			auto ret = daw::exchange( impl._M_start, pointer( ) );
+			impl._M_finish = pointer( );
+			impl._M_end_of_storage = pointer( );
 			return ret;
 		}
 
+		/// @pre vec has no allocation
 		template<typename T, typename Allocator>
-		constexpr void give_allocator( std::vector<T, Allocator> &vec,
-		                               Allocator &&alloc ) {
-			using pointer = typename std::vector<T, Allocator>::pointer;
+		constexpr void give_buffer( std::vector<T, Allocator> &vec,
+		                            typename std::vector<T, Allocator>::pointer p,
+		                            Allocator alloc,
+		                            std::size_t capacity,
+		                            std::size_t size ) {
 			using alloc_traits = std::allocator_traits<Allocator>;
-			assert( first_ptr( vec ) == pointer( ) );
 			static_assert(
 			  alloc_traits::is_always_equal::value or
 			    alloc_traits::propagate_on_container_move_assignment::value,
 			  "Unsupported allocator" );
+			auto &impl = vector_impl( vec );
+			assert( not impl._M_start );
 			if constexpr( alloc_traits::propagate_on_container_move_assignment::
 			                value ) {
-				get_alloc( vec ).get( ) = std::move( alloc );
+				static_cast<Allocator &>( impl ) = std::move( alloc );
+			} else {
+				(void)alloc;
 			}
+			impl._M_start = p;
+			impl._M_finish = p + static_cast<std::ptrdiff_t>( size );
+			impl._M_end_of_storage = p + static_cast<std::ptrdiff_t>( capacity );
 		}
-
-		template<typename T, typename Allocator>
-		constexpr void
-		give_buffer( std::vector<T, Allocator> &vec,
-		             typename std::vector<T, Allocator>::pointer p ) {
-			// Assumes vector is empty
-			assert( ( first_ptr( vec ) ==
-			          typename std::vector<T, Allocator>::pointer( ) ) );
-			first_ptr( vec ).get( ) = p;
-		}
-
-		template<typename T, typename Alloc>
-		struct std_vector_layout : std_vector_layout_impl<T, Alloc>::impl_type {
-			using pointer = typename std_vector_layout_impl<T, Alloc>::pointer;
-			using base = typename std_vector_layout_impl<T, Alloc>::impl_type;
-			using alloc_traits = std::allocator_traits<Alloc>;
-
-			using alloc_type =
-			  typename std_vector_layout_impl<T, Alloc>::rebound_allocator_type;
-
-			constexpr std::size_t capacity( ) const {
-				return static_cast<std::size_t>( base::m_capacity - base::m_first );
-			}
-
-			constexpr std::size_t size( ) const {
-				return static_cast<std::size_t>( base::m_last - base::m_first );
-			}
-
-			constexpr alloc_type take_allocator( ) {
-				return ::daw::container_help_impl::take_allocator( *this );
-			}
-
-			constexpr pointer take_buffer( ) {
-				return ::daw::container_help_impl::take_buffer( *this );
-			}
-
-			constexpr void capacity( std::size_t sz ) {
-				base::m_capacity = base::m_first + static_cast<std::ptrdiff_t>( sz );
-			}
-
-			constexpr void size( std::size_t sz ) {
-				base::m_last = base::m_first + static_cast<std::ptrdiff_t>( sz );
-			}
-
-			constexpr void give_allocator( alloc_type alloc ) {
-				assert( base::m_first == pointer( ) );
-				static_assert(
-				  alloc_traits::is_always_equal::value or
-				    alloc_traits::propagate_on_container_move_assignment::value,
-				  "Unsupported allocator" );
-				if constexpr( alloc_traits::propagate_on_container_move_assignment::
-				                value ) {
-					*static_cast<alloc_type *>( this ) = std::move( alloc );
-				}
-			}
-
-			constexpr void give_buffer( pointer p ) {
-				// Assumes vector is empty
-				assert( base::m_first == pointer( ) );
-				base::m_first = p;
-			}
-		};
 #endif
 	} // namespace container_help_impl
 
@@ -285,16 +201,22 @@ namespace daw {
 
 		constexpr container_data<T, Allocator>
 		operator( )( std::vector<T, Allocator> &vec ) const {
-			using vec_t = std::vector<T>;
-			using layout_t = container_help_impl::std_vector_layout<T, Allocator>;
-			static_assert( sizeof( layout_t ) == sizeof( vec_t ), "mismatch" );
-			static_assert( alignof( layout_t ) == alignof( vec_t ), "mismatch" );
-
 			auto const sz = vec.size( );
+#if defined( DAW_HAS_STD_VECTOR_BUFFER_TRANSFER )
 			auto const cap = vec.capacity( );
 			auto alloc = daw::container_help_impl::take_allocator( vec );
 			auto buff = daw::container_help_impl::take_buffer( vec );
 			return container_data<T, Allocator>( buff, std::move( alloc ), sz, cap );
+#else
+			// Unknown layout, move the elements to a new allocation
+			using alloc_traits = std::allocator_traits<Allocator>;
+			auto alloc = vec.get_allocator( );
+			auto buff = alloc_traits::allocate( alloc, sz );
+			std::uninitialized_move( vec.begin( ), vec.end( ), buff );
+			vec.clear( );
+			vec.shrink_to_fit( );
+			return container_data<T, Allocator>( buff, std::move( alloc ), sz, sz );
+#endif
 		}
 	};
 
@@ -311,22 +233,20 @@ namespace daw {
 		                            alloc_type alloc,
 		                            std::size_t capacity,
 		                            std::size_t size ) const {
-			using vec_t = std::vector<T>;
-			using layout_t = container_help_impl::std_vector_layout<T, Allocator>;
-			static_assert( sizeof( layout_t ) == sizeof( vec_t ), "mismatch" );
-			static_assert( alignof( layout_t ) == alignof( vec_t ), "mismatch" );
-			if( not vec.empty( ) ) {
-				vec.clear( );
-			}
-			vec.shrink_to_fit( );
+#if defined( DAW_HAS_STD_VECTOR_BUFFER_TRANSFER )
 			if( vec.capacity( ) > 0 ) {
 				(void)extract_from_container( vec );
 			}
-			auto *vec_ptr = reinterpret_cast<layout_t *>( std::addressof( vec ) );
-			vec_ptr->give_allocator( std::move( alloc ) );
-			vec_ptr->give_buffer( buff );
-			vec_ptr->capacity( capacity );
-			vec_ptr->size( size );
+			daw::container_help_impl::give_buffer(
+			  vec, buff, std::move( alloc ), capacity, size );
+#else
+			// Unknown layout, move the elements out of the buffer and release it
+			auto data =
+			  container_data<T, Allocator>( buff, std::move( alloc ), size, capacity );
+			vec.clear( );
+			vec.reserve( size );
+			std::move( data.data( ), data.data( ) + size, std::back_inserter( vec ) );
+#endif
 		}
 	};
 } // namespace daw
@@ -0,0 +1,114 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/ciso646.h"
+#include "daw/daw_generic_hash.h"
+#include "daw/daw_metro_hash.h"
+#include "daw/daw_string_view.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace daw {
+	namespace filter_impl {
+		/// Finalizer from MurmurHash3.  Spreads the entropy of the weaker
+		/// hashes over all 64 bits so that both halves can be used
+		[[nodiscard]] constexpr std::uint64_t mix64( std::uint64_t h ) noexcept {
+			h ^= h >> 33U;
+			h *= 0xff51'afd7'ed55'8ccdULL;
+			h ^= h >> 33U;
+			h *= 0xc4ce'b9fe'1a85'ec53ULL;
+			h ^= h >> 33U;
+			return h;
+		}
+
+		/// @brief Map h uniformly onto [0, n) without a division.  n must fit in
+		/// 32bits
+		[[nodiscard]] constexpr std::size_t fast_range32( std::uint64_t h,
+		                                                 std::size_t n ) noexcept {
+			return static_cast<std::size_t>(
+			  ( ( h >> 32U ) * static_cast<std::uint64_t>( n ) ) >> 32U );
+		}
+
+		enum class filter_kind : std::uint32_t { blocked_bloom = 1, cuckoo = 2 };
+
+		inline constexpr std::uint64_t filter_magic = 0x5254'4c49'4657'4144ULL;
+		inline constexpr std::uint32_t filter_version = 1;
+
+		/// @brief The fixed size header in front of a serialized filter.  The
+		/// table follows immediately after and is stored in native byte order.
+		/// The size keeps the table cache line aligned within a mapping.
+		struct filter_header {
+			std::uint64_t magic = filter_magic;
+			std::uint32_t version = filter_version;
+			filter_kind kind = filter_kind::blocked_bloom;
+			/// Number of blocks/buckets in the table
+			std::uint64_t table_size = 0;
+			/// Number of items inserted, when tracked
+			std::uint64_t item_count = 0;
+			std::uint64_t victim_index = 0;
+			std::uint32_t victim_fingerprint = 0;
+			std::uint32_t victim_used = 0;
+			std::uint64_t reserved[2] = { };
+		};
+		static_assert( sizeof( filter_header ) == 64 );
+		static_assert( std::is_trivially_copyable_v<filter_header> );
+
+		/// @brief Read and validate the header at the start of buffer
+		/// @return true when the buffer holds a filter of kind with a table of
+		/// table_bytes_per_entry sized entries
+		[[nodiscard]] inline bool
+		read_header( char const *buffer, std::size_t buffer_size, filter_kind kind,
+		             std::size_t table_bytes_per_entry,
+		             filter_header &result ) noexcept {
+			if( buffer == nullptr or buffer_size < sizeof( filter_header ) ) {
+				return false;
+			}
+			std::memcpy( &result, buffer, sizeof( filter_header ) );
+			if( result.magic != filter_magic or result.version != filter_version or
+			    result.kind != kind ) {
+				return false;
+			}
+			auto const table_bytes = buffer_size - sizeof( filter_header );
+			return result.table_size != 0 and
+			       result.table_size <= table_bytes / table_bytes_per_entry;
+		}
+	} // namespace filter_impl
+
+	/// @brief The default hasher for the approximate membership filters.
+	/// Integral and enum keys use generic_hash, string like keys use
+	/// metro::hash64, and other trivially copyable keys hash their object
+	/// representation with metro::hash64.
+	struct filter_hash {
+		std::uint64_t seed = 0x9e37'79b9'7f4a'7c15ULL;
+
+		template<typename T>
+		[[nodiscard]] constexpr std::uint64_t operator( )( T const &value ) const {
+			if constexpr( std::is_enum_v<T> ) {
+				return operator( )( static_cast<std::underlying_type_t<T>>( value ) );
+			} else if constexpr( std::is_integral_v<T> ) {
+				return filter_impl::mix64(
+				  daw::generic_hash<8>( static_cast<std::uint64_t>( value ) ) ^ seed );
+			} else if constexpr( std::is_convertible_v<T const &,
+			                                           daw::string_view> ) {
+				return daw::metro::hash64( daw::string_view( value ), seed );
+			} else {
+				static_assert( std::is_trivially_copyable_v<T>,
+				               "Unsupported key type, supply a hasher" );
+				return daw::metro::hash64(
+				  daw::string_view( reinterpret_cast<char const *>( &value ),
+				                    sizeof( T ) ),
+				  seed );
+			}
+		}
+	};
+} // namespace daw
@@ -0,0 +1,240 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/algorithms/daw_algorithm_search.h"
+#include "daw/daw_attributes.h"
+#include "daw/daw_cxmath.h"
+#include "daw/daw_is_constant_evaluated.h"
+#include "daw/impl/daw_simd_check.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <type_traits>
+
+namespace daw {
+	/// Tag for the constructors and inserts of flat_map/flat_set whose input is
+	/// already sorted and free of duplicate keys
+	struct sorted_unique_t {
+		explicit sorted_unique_t( ) = default;
+	};
+	inline constexpr sorted_unique_t sorted_unique{ };
+
+	/// How flat_map/flat_set search their keys
+	enum class flat_search : std::uint8_t {
+		/// SIMD k-ary search for integral keys ordered by std::less when the
+		/// target supports it, branchless binary search otherwise
+		automatic,
+		/// Binary search whose steps are selected with a conditional move
+		branchless
+	};
+
+	namespace flat_impl {
+		/// The index of the first element of [first, first + n) that is not
+		/// less than key, see algorithm::branchless_lower_bound
+		template<typename T, typename U, typename Compare>
+		[[nodiscard]] constexpr std::size_t
+		branchless_lower_bound( T const *first, std::size_t n, U const &key,
+		                        Compare &comp ) {
+			return static_cast<std::size_t>(
+			  algorithm::branchless_lower_bound( first, first + n, key,
+			                                     std::ref( comp ) ) -
+			  first );
+		}
+
+		/// Compare can order keys against other types, so lookups need not
+		/// convert them to Key
+		template<typename Compare, typename = void>
+		inline constexpr bool is_transparent_v = false;
+
+		template<typename Compare>
+		inline constexpr bool is_transparent_v<
+		  Compare, std::void_t<typename Compare::is_transparent>> = true;
+
+		template<typename Key, typename Compare>
+		inline constexpr bool has_simd_search_v =
+		  std::is_integral_v<Key> and not std::is_same_v<Key, bool> and
+		  ( sizeof( Key ) == 4U or sizeof( Key ) == 8U ) and
+		  ( std::is_same_v<Compare, std::less<>> or
+		    std::is_same_v<Compare, std::less<Key>> );
+
+		/// Ranges at most this long are finished with a linear count
+		inline constexpr std::size_t linear_block = 64;
+
+#if defined( DAW_HAS_SSE2 ) and defined( DAW_HAS_IF_CONSTEVAL_COMPAT )
+#define DAW_FLAT_HAS_SIMD_SEARCH
+		/// The bias that makes a signed compare order unsigned values
+		template<typename Key>
+		inline constexpr std::uint64_t sign_bias =
+		  std::is_signed_v<Key> ? 0U : 1ULL << ( sizeof( Key ) * 8U - 1U );
+
+		/// The number of elements of the sorted range [p, p + n) that are less
+		/// than key, which is the lower_bound index
+		template<typename Key>
+		DAW_ATTRIB_INLINE std::size_t linear_count_less( Key const *p,
+		                                                 std::size_t n,
+		                                                 Key key ) noexcept {
+			std::size_t count = 0;
+			std::size_t idx = 0;
+			if constexpr( sizeof( Key ) == 4U ) {
+				auto const bias = static_cast<std::int32_t>(
+				  static_cast<std::uint32_t>( sign_bias<Key> ) );
+#if defined( DAW_HAS_AVX2 )
+				auto const vbias = _mm256_set1_epi32( bias );
+				auto const vkey = _mm256_set1_epi32(
+				  static_cast<std::int32_t>( static_cast<std::uint32_t>( key ) ^
+				                             static_cast<std::uint32_t>( bias ) ) );
+				for( ; idx + 8U <= n; idx += 8U ) {
+					auto const v = _mm256_xor_si256(
+					  _mm256_loadu_si256( reinterpret_cast<__m256i const *>( p + idx ) ),
+					  vbias );
+					count += static_cast<std::size_t>( daw::cxmath::popcount(
+					  static_cast<unsigned>( _mm256_movemask_ps(
+					    _mm256_castsi256_ps( _mm256_cmpgt_epi32( vkey, v ) ) ) ) ) );
+				}
+#else
+				auto const vbias = _mm_set1_epi32( bias );
+				auto const vkey = _mm_set1_epi32(
+				  static_cast<std::int32_t>( static_cast<std::uint32_t>( key ) ^
+				                             static_cast<std::uint32_t>( bias ) ) );
+				for( ; idx + 4U <= n; idx += 4U ) {
+					auto const v = _mm_xor_si128(
+					  _mm_loadu_si128( reinterpret_cast<__m128i const *>( p + idx ) ),
+					  vbias );
+					count += static_cast<std::size_t>(
+					  daw::cxmath::popcount( static_cast<unsigned>(
+					    _mm_movemask_ps( _mm_castsi128_ps( _mm_cmpgt_epi32( vkey, v ) ) ) ) ) );
+				}
+#endif
+			}
+#if defined( DAW_HAS_AVX2 )
+			if constexpr( sizeof( Key ) == 8U ) {
+				auto const bias = static_cast<long long>( sign_bias<Key> );
+				auto const vbias = _mm256_set1_epi64x( bias );
+				auto const vkey = _mm256_set1_epi64x( static_cast<long long>(
+				  static_cast<std::uint64_t>( key ) ^ sign_bias<Key> ) );
+				for( ; idx + 4U <= n; idx += 4U ) {
+					auto const v = _mm256_xor_si256(
+					  _mm256_loadu_si256( reinterpret_cast<__m256i const *>( p + idx ) ),
+					  vbias );
+					count += static_cast<std::size_t>( daw::cxmath::popcount(
+					  static_cast<unsigned>( _mm256_movemask_pd(
+					    _mm256_castsi256_pd( _mm256_cmpgt_epi64( vkey, v ) ) ) ) ) );
+				}
+			}
+#endif
+			for( ; idx < n; ++idx ) {
+				count += static_cast<std::size_t>( p[idx] < key );
+			}
+			return count;
+		}
+
+#if defined( DAW_HAS_AVX2 )
+		/// One step of a k-ary search.  The range is cut into lanes + 1 parts,
+		/// the last pivot of the first lanes parts is gathered and compared with
+		/// key in one instruction, and the number of smaller pivots selects the
+		/// part that holds the answer.  The loads are independent so their cache
+		/// misses overlap, unlike the chain of loads of a binary search.
+		template<typename Key>
+		DAW_ATTRIB_INLINE void kary_step( Key const *&base, std::size_t &n,
+		                                  Key key ) noexcept {
+			if constexpr( sizeof( Key ) == 4U ) {
+				auto const step = n / 9U;
+				auto const s = static_cast<std::int32_t>( step );
+				auto const idx = _mm256_setr_epi32( s - 1, 2 * s - 1, 3 * s - 1,
+				                                    4 * s - 1, 5 * s - 1, 6 * s - 1,
+				                                    7 * s - 1, 8 * s - 1 );
+				auto const bias = _mm256_set1_epi32( static_cast<std::int32_t>(
+				  static_cast<std::uint32_t>( sign_bias<Key> ) ) );
+				auto const pivots = _mm256_xor_si256(
+				  _mm256_i32gather_epi32( reinterpret_cast<int const *>( base ), idx,
+				                          4 ),
+				  bias );
+				auto const vkey = _mm256_xor_si256(
+				  _mm256_set1_epi32( static_cast<std::int32_t>( key ) ), bias );
+				auto const c = static_cast<std::size_t>(
+				  daw::cxmath::popcount( static_cast<unsigned>( _mm256_movemask_ps(
+				    _mm256_castsi256_ps( _mm256_cmpgt_epi32( vkey, pivots ) ) ) ) ) );
+				base += c * step;
+				n = c == 8U ? n - 8U * step : step;
+			} else {
+				auto const step = n / 5U;
+				auto const s = static_cast<long long>( step );
+				auto const idx = _mm256_setr_epi64x( s - 1, 2 * s - 1, 3 * s - 1,
+				                                     4 * s - 1 );
+				auto const bias =
+				  _mm256_set1_epi64x( static_cast<long long>( sign_bias<Key> ) );
+				auto const pivots = _mm256_xor_si256(
+				  _mm256_i64gather_epi64(
+				    reinterpret_cast<long long const *>( base ), idx, 8 ),
+				  bias );
+				auto const vkey = _mm256_xor_si256(
+				  _mm256_set1_epi64x( static_cast<long long>( key ) ), bias );
+				auto const c = static_cast<std::size_t>(
+				  daw::cxmath::popcount( static_cast<unsigned>( _mm256_movemask_pd(
+				    _mm256_castsi256_pd( _mm256_cmpgt_epi64( vkey, pivots ) ) ) ) ) );
+				base += c * step;
+				n = c == 4U ? n - 4U * step : step;
+			}
+		}
+#endif
+
+		/// lower_bound for integral keys ordered by std::less.  Large ranges
+		/// are narrowed by k-ary steps with AVX2 or branchless halving without
+		/// it, and the last linear_block elements are counted with SIMD compares
+		template<typename Key>
+		[[nodiscard]] std::size_t simd_lower_bound( Key const *first,
+		                                            std::size_t n,
+		                                            Key key ) noexcept {
+			Key const *base = first;
+#if defined( DAW_HAS_AVX2 )
+			// Gather indices are 32bit
+			constexpr auto max_gather =
+			  static_cast<std::size_t>( std::numeric_limits<std::int32_t>::max( ) );
+			while( n > max_gather ) {
+				auto const half = n / 2U;
+				base = base[half] < key ? base + half : base;
+				n -= half;
+			}
+			while( n > linear_block ) {
+				kary_step( base, n, key );
+			}
+#else
+			while( n > linear_block ) {
+				auto const half = n / 2U;
+				base = base[half] < key ? base + half : base;
+				n -= half;
+			}
+#endif
+			return static_cast<std::size_t>( base - first ) +
+			       linear_count_less( base, n, key );
+		}
+#endif
+
+		/// The lower_bound index of key in the sorted keys [first, first + n)
+		template<flat_search Search, typename T, typename U, typename Compare>
+		[[nodiscard]] constexpr std::size_t
+		lower_bound_index( T const *first, std::size_t n, U const &key,
+		                   Compare &comp ) {
+#if defined( DAW_FLAT_HAS_SIMD_SEARCH )
+			if constexpr( Search == flat_search::automatic and
+			              has_simd_search_v<T, Compare> and std::is_same_v<U, T> ) {
+				DAW_IF_NOT_CONSTEVAL {
+					return simd_lower_bound<T>( first, n, key );
+				}
+			}
+#endif
+			return branchless_lower_bound( first, n, key, comp );
+		}
+	} // namespace flat_impl
+} // namespace daw
+
+#undef DAW_FLAT_HAS_SIMD_SEARCH
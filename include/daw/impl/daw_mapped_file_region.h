@@ -0,0 +1,186 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/daw_exchange.h"
+#include "daw/daw_memory_mapped_file.h"
+#include "daw/daw_string_view.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#if not defined( _MSC_VER ) and not defined( __MINGW32__ )
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace daw::filesystem::mapped_impl {
+	inline constexpr std::uint32_t format_version = 1;
+
+	/// The header of a mapped container has a page to itself so that a
+	/// checkpoint can flush the data before the header that describes it
+	inline constexpr std::size_t header_block = 4096;
+
+	[[nodiscard]] constexpr std::size_t round_up( std::size_t n,
+	                                              std::size_t align ) noexcept {
+		return ( n + align - 1U ) / align * align;
+	}
+
+	/// Orders the stores that fill in an element before the store that makes
+	/// it visible.  A killed process leaves every completed store in the page
+	/// cache, so this is all that is needed for it to see a consistent file.
+	inline void commit_fence( ) noexcept {
+		std::atomic_thread_fence( std::memory_order_release );
+	}
+
+	/// An open file and a shared mapping of all of it
+	class file_region {
+		int m_file = -1;
+		std::byte *m_data = nullptr;
+		std::size_t m_size = 0;
+		bool m_writable = false;
+
+		[[nodiscard]] bool map( ) noexcept {
+			void *const p =
+			  mmap( nullptr, m_size,
+			        m_writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED,
+			        m_file, 0 );
+			if( p == MAP_FAILED ) {
+				return false;
+			}
+			m_data = static_cast<std::byte *>( p );
+			return true;
+		}
+
+	public:
+		file_region( ) = default;
+		file_region( file_region const & ) = delete;
+		file_region &operator=( file_region const & ) = delete;
+
+		file_region( file_region &&other ) noexcept
+		  : m_file( daw::exchange( other.m_file, -1 ) )
+		  , m_data( daw::exchange( other.m_data, nullptr ) )
+		  , m_size( daw::exchange( other.m_size, 0U ) )
+		  , m_writable( daw::exchange( other.m_writable, false ) ) {}
+
+		file_region &operator=( file_region &&rhs ) noexcept {
+			if( this != &rhs ) {
+				close( );
+				m_file = daw::exchange( rhs.m_file, -1 );
+				m_data = daw::exchange( rhs.m_data, nullptr );
+				m_size = daw::exchange( rhs.m_size, 0U );
+				m_writable = daw::exchange( rhs.m_writable, false );
+			}
+			return *this;
+		}
+
+		~file_region( ) {
+			close( );
+		}
+
+		/// @pre *path.end( ) == '\0'
+		[[nodiscard]] bool open( daw::string_view path, open_mode mode ) noexcept {
+			close( );
+			m_writable = mode == open_mode::read_write;
+			m_file = ::open( path.data( ),
+			                 m_writable ? O_RDWR | O_CREAT | O_CLOEXEC
+			                            : O_RDONLY | O_CLOEXEC,
+			                 0644 );
+			if( m_file < 0 ) {
+				return false;
+			}
+			struct stat st { };
+			if( fstat( m_file, &st ) != 0 ) {
+				close( );
+				return false;
+			}
+			m_size = static_cast<std::size_t>( st.st_size );
+			if( m_size > 0 and not map( ) ) {
+				close( );
+				return false;
+			}
+			return true;
+		}
+
+		/// Grow or shrink the file and its mapping.  The mapping may move.
+		[[nodiscard]] bool resize( std::size_t new_size ) noexcept {
+			if( ftruncate( m_file, static_cast<off_t>( new_size ) ) != 0 ) {
+				return false;
+			}
+			if( m_data == nullptr ) {
+				m_size = new_size;
+				return map( );
+			}
+#if defined( MREMAP_MAYMOVE )
+			void *const p = mremap( m_data, m_size, new_size, MREMAP_MAYMOVE );
+			if( p == MAP_FAILED ) {
+				return false;
+			}
+			m_data = static_cast<std::byte *>( p );
+			m_size = new_size;
+			return true;
+#else
+			munmap( m_data, m_size );
+			m_data = nullptr;
+			m_size = new_size;
+			return map( );
+#endif
+		}
+
+		/// Flush [offset, offset + len) to the file
+		bool sync( std::size_t offset, std::size_t len, bool wait ) noexcept {
+			auto const page = static_cast<std::size_t>( sysconf( _SC_PAGESIZE ) );
+			auto const first = offset / page * page;
+			return msync( m_data + first, len + ( offset - first ),
+			              wait ? MS_SYNC : MS_ASYNC ) == 0;
+		}
+
+		/// Return the storage of a range that is no longer used to the file
+		/// system, it reads back as zeros
+		void release( std::size_t offset, std::size_t len ) noexcept {
+#if defined( FALLOC_FL_PUNCH_HOLE )
+			(void)fallocate( m_file, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+			                 static_cast<off_t>( offset ),
+			                 static_cast<off_t>( len ) );
+#else
+			(void)offset;
+			(void)len;
+#endif
+		}
+
+		void close( ) noexcept {
+			if( auto *p = daw::exchange( m_data, nullptr ); p ) {
+				munmap( p, m_size );
+			}
+			m_size = 0;
+			if( auto fid = daw::exchange( m_file, -1 ); fid >= 0 ) {
+				::close( fid );
+			}
+		}
+
+		[[nodiscard]] std::byte *data( ) const noexcept {
+			return m_data;
+		}
+
+		[[nodiscard]] std::size_t size( ) const noexcept {
+			return m_size;
+		}
+
+		[[nodiscard]] bool writable( ) const noexcept {
+			return m_writable;
+		}
+
+		explicit operator bool( ) const noexcept {
+			return m_file >= 0;
+		}
+	};
+} // namespace daw::filesystem::mapped_impl
+#endif
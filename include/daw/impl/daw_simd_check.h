@@ -0,0 +1,43 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/daw_cpp_feature_check.h"
+
+// Detect the x86 vector extensions enabled for this translation unit.  The
+// kernels built on these are selected at compile time, so building with
+// -mavx2/-march=native or /arch:AVX2 is needed to get the wider paths.  Define
+// DAW_NO_SIMD to force the scalar code paths.
+#if not defined( DAW_NO_SIMD )
+#if defined( __AVX2__ )
+#define DAW_HAS_AVX2
+#endif
+
+#if defined( __SSE2__ ) or defined( _M_X64 ) or defined( _M_AMD64 ) or \
+  ( defined( _M_IX86_FP ) and _M_IX86_FP >= 2 )
+#define DAW_HAS_SSE2
+#endif
+
+#if defined( __SSSE3__ ) or defined( DAW_HAS_AVX2 )
+#define DAW_HAS_SSSE3
+#endif
+
+#if defined( __SSE4_1__ ) or defined( DAW_HAS_AVX2 )
+#define DAW_HAS_SSE41
+#endif
+
+#if defined( __BMI2__ )
+#define DAW_HAS_BMI2
+#endif
+#endif
+
+#if defined( DAW_HAS_SSE2 ) or defined( DAW_HAS_AVX2 ) or \
+  defined( DAW_HAS_BMI2 )
+#include <immintrin.h>
+#endif
@@ -0,0 +1,76 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/ciso646.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace daw::sketch_impl {
+	enum class sketch_kind : std::uint32_t { top_k = 1, tdigest = 2, hyperloglog = 3 };
+
+	inline constexpr std::uint64_t sketch_magic = 0x4843'5445'4b53'5744ULL;
+	inline constexpr std::uint32_t sketch_version = 1;
+
+	/// @brief The fixed size header in front of a serialized sketch.  item_count
+	/// entries of value_size bytes follow immediately after in native byte
+	/// order
+	struct sketch_header {
+		std::uint64_t magic = sketch_magic;
+		std::uint32_t version = sketch_version;
+		sketch_kind kind = sketch_kind::top_k;
+		/// k, compression or precision depending on the kind
+		double parameter = 0.0;
+		/// Number of values observed
+		std::uint64_t total = 0;
+		/// Number of entries following the header
+		std::uint64_t item_count = 0;
+		std::uint32_t value_size = 0;
+		std::uint32_t reserved = 0;
+	};
+	static_assert( sizeof( sketch_header ) == 48 );
+	static_assert( std::is_trivially_copyable_v<sketch_header> );
+
+	/// @brief Write header followed by item_count entries from items
+	/// @return one past the last byte written
+	inline char *write_sketch( char *out, sketch_header const &header,
+	                           void const *items ) noexcept {
+		std::memcpy( out, &header, sizeof( header ) );
+		out += sizeof( header );
+		auto const bytes =
+		  static_cast<std::size_t>( header.item_count * header.value_size );
+		if( bytes > 0 ) {
+			std::memcpy( out, items, bytes );
+		}
+		return out + bytes;
+	}
+
+	/// @brief Read and validate the header at the start of buffer
+	/// @return true when the buffer holds a sketch of kind with all of its
+	/// value_size sized entries
+	[[nodiscard]] inline bool read_header( char const *buffer,
+	                                       std::size_t buffer_size,
+	                                       sketch_kind kind,
+	                                       std::size_t value_size,
+	                                       sketch_header &result ) noexcept {
+		if( buffer == nullptr or buffer_size < sizeof( sketch_header ) ) {
+			return false;
+		}
+		std::memcpy( &result, buffer, sizeof( sketch_header ) );
+		if( result.magic != sketch_magic or result.version != sketch_version or
+		    result.kind != kind or result.value_size != value_size ) {
+			return false;
+		}
+		return result.item_count <=
+		       ( buffer_size - sizeof( sketch_header ) ) / value_size;
+	}
+} // namespace daw::sketch_impl
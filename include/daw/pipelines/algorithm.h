@@ -11,7 +11,9 @@
 #include "daw/daw_attributes.h"
 #include "daw/daw_forward_lvalue.h"
 #include "daw/daw_iterator_traits.h"
+#include "daw/daw_is_constant_evaluated.h"
 #include "daw/daw_move.h"
+#include "daw/pipelines/chunked.h"
 #include "daw/pipelines/range.h"
 
 #include <algorithm>
@@ -139,6 +141,15 @@ namespace daw::pipelines {
 			}
 
 			[[nodiscard]] constexpr auto operator( )( Range auto &&r ) const {
+				using R = decltype( r );
+				if constexpr( ChunkedRange<R> ) {
+					if constexpr( std::is_trivially_copyable_v<
+					                typename chunk_source_t<R>::value_type> ) {
+						DAW_IF_NOT_CONSTEVAL {
+							return minmax_chunked( r );
+						}
+					}
+				}
 				auto result = std::minmax_element(
 				  std::begin( r ),
 				  std::end( r ),
@@ -149,6 +160,47 @@ namespace daw::pipelines {
 				  } );
 				return std::tuple{ result.first, result.second };
 			}
+
+		private:
+			/// Same result as std::minmax_element, the first smallest and the last
+			/// largest element
+			template<ChunkedRange R>
+			[[nodiscard]] constexpr auto minmax_chunked( R &&r ) const {
+				using value_type = typename chunk_source_t<R>::value_type;
+				value_type min_value{ };
+				value_type max_value{ };
+				std::size_t min_pos = 0;
+				std::size_t max_pos = 0;
+				bool is_empty = true;
+				for_each_chunk( r, [&]( auto const &c ) {
+					c.for_each( [&]( value_type const &v, std::size_t row ) {
+						if( is_empty ) {
+							min_value = v;
+							max_value = v;
+							min_pos = c.offset + row;
+							max_pos = min_pos;
+							is_empty = false;
+							return;
+						}
+						auto const &pv = std::invoke( m_projection, v );
+						if( std::invoke( m_compare, pv,
+						                 std::invoke( m_projection, min_value ) ) ) {
+							min_value = v;
+							min_pos = c.offset + row;
+						}
+						if( not std::invoke( m_compare, pv,
+						                     std::invoke( m_projection, max_value ) ) ) {
+							max_value = v;
+							max_pos = c.offset + row;
+						}
+					} );
+				} );
+				if( is_empty ) {
+					return std::tuple{ std::begin( r ), std::begin( r ) };
+				}
+				return std::tuple{ chunk_iterator_at( r, min_pos ),
+				                   chunk_iterator_at( r, max_pos ) };
+			}
 		};
 		MinMax_t( ) -> MinMax_t<>;
 
@@ -16,6 +16,8 @@
 #include "daw/pipelines/range.h"
 
 #include <cstddef>
+#include <iterator>
+#include <vector>
 
 namespace daw::pipelines::pimpl {
 	template<ForwardRange R>
@@ -126,12 +128,122 @@ namespace daw::pipelines::pimpl {
 	template<Range R>
 	chunk_view( R &&r, std::size_t ) -> chunk_view<daw::remove_rvalue_ref_t<R>>;
 
+	/// Chunks of a single pass range, like a generator.  Each chunk is
+	/// buffered in the view and is only valid until the iterator is
+	/// incremented
+	template<InputRange R>
+	struct input_chunk_view {
+		using value_type = std::vector<daw::range_value_t<R>>;
+		using reference = value_type const &;
+		using const_reference = value_type const &;
+		using difference_type = std::ptrdiff_t;
+
+	private:
+		using m_range_t = daw::remove_cvrvref_t<R>;
+		using m_iter_t = daw::iterator_t<m_range_t const>;
+		using m_last_t = daw::iterator_end_t<m_range_t const>;
+
+		m_range_t m_range;
+		std::size_t m_chunk_size = 1;
+		mutable m_iter_t m_first{ };
+		mutable m_last_t m_last{ };
+		mutable value_type m_buffer{ };
+		mutable bool m_started = false;
+
+		void fill( ) const {
+			m_buffer.clear( );
+			while( m_buffer.size( ) < m_chunk_size and m_first != m_last ) {
+				m_buffer.push_back( *m_first );
+				++m_first;
+			}
+		}
+
+	public:
+		class iterator {
+			input_chunk_view const *m_view = nullptr;
+
+		public:
+			using iterator_concept = std::input_iterator_tag;
+			using iterator_category = std::input_iterator_tag;
+			using value_type = typename input_chunk_view::value_type;
+			using reference = value_type const &;
+			using pointer = value_type const *;
+			using difference_type = std::ptrdiff_t;
+
+			iterator( ) = default;
+
+			explicit iterator( input_chunk_view const *view ) noexcept
+			  : m_view( view ) {
+				if( m_view->m_buffer.empty( ) ) {
+					m_view = nullptr;
+				}
+			}
+
+			[[nodiscard]] reference operator*( ) const noexcept {
+				return m_view->m_buffer;
+			}
+
+			[[nodiscard]] pointer operator->( ) const noexcept {
+				return &m_view->m_buffer;
+			}
+
+			iterator &operator++( ) {
+				m_view->fill( );
+				if( m_view->m_buffer.empty( ) ) {
+					m_view = nullptr;
+				}
+				return *this;
+			}
+
+			iterator operator++( int ) {
+				auto result = *this;
+				operator++( );
+				return result;
+			}
+
+			[[nodiscard]] friend bool operator==( iterator const &lhs,
+			                                      iterator const &rhs ) noexcept {
+				return lhs.m_view == rhs.m_view;
+			}
+		};
+
+		explicit input_chunk_view( InputRange auto &&r, std::size_t chunk_size )
+		  : m_range( DAW_FWD( r ) )
+		  , m_chunk_size( chunk_size ) {
+			m_buffer.reserve( m_chunk_size );
+		}
+
+		[[nodiscard]] iterator begin( ) const {
+			if( not m_started ) {
+				m_started = true;
+				m_first = std::begin( m_range );
+				m_last = std::end( m_range );
+				fill( );
+			}
+			return iterator( this );
+		}
+
+		[[nodiscard]] iterator end( ) const noexcept {
+			return iterator( );
+		}
+	};
+	template<InputRange R>
+	input_chunk_view( R &&r, std::size_t )
+	  -> input_chunk_view<daw::remove_rvalue_ref_t<R>>;
+
 	struct Chunk_t {
 		std::size_t chunk_size;
 		[[nodiscard]] DAW_ATTRIB_INLINE constexpr auto
 		operator( )( ForwardRange auto &&r ) const {
 			return chunk_view{ DAW_FWD( r ), chunk_size };
 		}
+
+		template<InputRange R>
+		requires( not ForwardRange<R> ) //
+		  [[nodiscard]] DAW_ATTRIB_INLINE auto
+		  operator( )( R &&r ) const {
+			return input_chunk_view{ DAW_FWD( r ), chunk_size };
+		}
 	};
 } // namespace daw::pipelines::pimpl
 
@@ -0,0 +1,221 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/daw_attributes.h"
+#include "daw/daw_iterator_traits.h"
+#include "daw/daw_move.h"
+#include "daw/pipelines/filter.h"
+#include "daw/pipelines/map.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+/// The chunked protocol lets sinks like Sum and CountIf consume a pipeline a
+/// block at a time with tight inner loops instead of going through the
+/// element at a time iterators.  Contiguous sources yield fixed size blocks,
+/// Map transforms a block into a buffer and Filter produces a selection
+/// vector of the live rows.  Anything else uses the iterator path.
+namespace daw::pipelines::pimpl {
+	inline constexpr std::size_t chunk_size = 256;
+
+	template<typename T>
+	struct chunk_t {
+		T const *data;
+		/// The live rows of data, nullptr when all size rows are live
+		std::uint32_t const *sel;
+		/// The number of rows when sel is nullptr, otherwise the size of sel
+		std::size_t size;
+		/// Position of data[0] relative to the start of the source
+		std::size_t offset;
+
+		/// Calls f( value, row ) for each live row
+		template<typename F>
+		DAW_ATTRIB_INLINE constexpr void for_each( F &&f ) const {
+			if( sel ) {
+				for( std::size_t n = 0; n < size; ++n ) {
+					f( data[sel[n]], static_cast<std::size_t>( sel[n] ) );
+				}
+			} else {
+				for( std::size_t n = 0; n < size; ++n ) {
+					f( data[n], n );
+				}
+			}
+		}
+	};
+
+	/// Values a Map stage can buffer a chunk of
+	template<typename T>
+	inline constexpr bool is_chunk_bufferable_v =
+	  std::is_trivially_default_constructible_v<T> and
+	  std::is_trivially_copyable_v<T> and sizeof( T ) <= 64;
+
+	/// Only checks std::contiguous_iterator for iterators that declare an
+	/// iterator_concept, checking it on some pipeline iterators would
+	/// instantiate comparisons that do not compile
+	template<typename I>
+	concept ContiguousSource =
+	  std::is_pointer_v<I> or
+	  ( requires { typename I::iterator_concept; } and
+	    std::contiguous_iterator<I> );
+
+	/// Describes how to read the iterator pair [First, Last) in chunks.  value
+	/// is false when it cannot be.  Otherwise run( first, last, sink ) calls
+	/// sink( chunk_t<value_type> const & ) for each chunk and at( first, last,
+	/// offset ) returns the iterator for a chunk position
+	template<typename First, typename Last>
+	struct chunk_source {
+		static constexpr bool value = false;
+	};
+
+	template<ContiguousSource I>
+	struct chunk_source<I, I> {
+		static constexpr bool value = true;
+		using value_type = std::remove_cv_t<std::iter_value_t<I>>;
+
+		template<typename Sink>
+		DAW_ATTRIB_INLINE static constexpr void run( I const &first,
+		                                             I const &last, Sink &&sink ) {
+			value_type const *ptr = std::to_address( first );
+			auto const count = static_cast<std::size_t>( last - first );
+			for( std::size_t pos = 0; pos < count; pos += chunk_size ) {
+				std::size_t const sz =
+				  count - pos < chunk_size ? count - pos : chunk_size;
+				sink( chunk_t<value_type>{ ptr + pos, nullptr, sz, pos } );
+			}
+		}
+
+		[[nodiscard]] static constexpr I at( I const &first, I const &,
+		                                     std::size_t offset ) {
+			return first + static_cast<std::iter_difference_t<I>>( offset );
+		}
+	};
+
+	template<typename I, typename L, typename Fn>
+	requires( chunk_source<I, L>::value and
+	          is_chunk_bufferable_v<
+	            typename map_iterator<I, Fn, std::identity>::value_type> ) //
+	  struct chunk_source<map_iterator<I, Fn, std::identity>,
+	                      map_iterator<L, Fn, std::identity>> {
+		static constexpr bool value = true;
+		using value_type = typename map_iterator<I, Fn, std::identity>::value_type;
+		using base_source = chunk_source<I, L>;
+
+		template<typename Sink>
+		DAW_ATTRIB_INLINE static constexpr void
+		run( map_iterator<I, Fn, std::identity> const &first,
+		     map_iterator<L, Fn, std::identity> const &last, Sink &&sink ) {
+			Fn const &fn = first.func( );
+			base_source::run( first.base( ), last.base( ), [&]( auto const &c ) {
+				// Rows keep their position so that selection vectors and offsets
+				// from earlier stages stay valid
+				value_type buff[chunk_size];
+				if( c.sel ) {
+					for( std::size_t n = 0; n < c.size; ++n ) {
+						auto const row = c.sel[n];
+						buff[row] = std::invoke( fn, c.data[row] );
+					}
+				} else {
+					for( std::size_t n = 0; n < c.size; ++n ) {
+						buff[n] = std::invoke( fn, c.data[n] );
+					}
+				}
+				sink( chunk_t<value_type>{ buff, c.sel, c.size, c.offset } );
+			} );
+		}
+
+		[[nodiscard]] static constexpr map_iterator<I, Fn, std::identity>
+		at( map_iterator<I, Fn, std::identity> const &first,
+		    map_iterator<L, Fn, std::identity> const &last, std::size_t offset ) {
+			return map_iterator<I, Fn, std::identity>(
+			  base_source::at( first.base( ), last.base( ), offset ),
+			  first.func( ) );
+		}
+	};
+
+	template<typename I, typename Fn, typename Projection>
+	requires( chunk_source<I, I>::value ) //
+	  struct chunk_source<filter_view<I, Fn, Projection>,
+	                      filter_view<I, Fn, Projection>> {
+		static constexpr bool value = true;
+		using value_type = typename chunk_source<I, I>::value_type;
+		using base_source = chunk_source<I, I>;
+		using view_t = filter_view<I, Fn, Projection>;
+
+		template<typename Sink>
+		DAW_ATTRIB_INLINE static constexpr void run( view_t const &first,
+		                                             view_t const &,
+		                                             Sink &&sink ) {
+			Fn &fn = first.func( );
+			Projection const &proj = first.projection( );
+			base_source::run(
+			  first.base( ), first.base_end( ), [&]( auto const &c ) {
+				  // Branchless selection, every row is written and the count only
+				  // advances for rows that pass
+				  std::uint32_t sel[chunk_size];
+				  std::size_t count = 0;
+				  if( c.sel ) {
+					  for( std::size_t n = 0; n < c.size; ++n ) {
+						  auto const row = c.sel[n];
+						  sel[count] = row;
+						  count += static_cast<std::size_t>( static_cast<bool>(
+						    std::invoke( fn, std::invoke( proj, c.data[row] ) ) ) );
+					  }
+				  } else {
+					  for( std::size_t n = 0; n < c.size; ++n ) {
+						  sel[count] = static_cast<std::uint32_t>( n );
+						  count += static_cast<std::size_t>( static_cast<bool>(
+						    std::invoke( fn, std::invoke( proj, c.data[n] ) ) ) );
+					  }
+				  }
+				  if( count > 0 ) {
+					  sink( chunk_t<value_type>{ c.data, sel, count, c.offset } );
+				  }
+			  } );
+		}
+
+		[[nodiscard]] static constexpr view_t at( view_t const &first,
+		                                          view_t const &,
+		                                          std::size_t offset ) {
+			return view_t( base_source::at( first.base( ), first.base_end( ), offset ),
+			               first.base_end( ), first.func( ), first.projection( ) );
+		}
+	};
+
+	/// A range that can be read with the chunked protocol
+	template<typename R>
+	concept ChunkedRange =
+	  Range<R> and chunk_source<iterator_t<R>, iterator_end_t<R>>::value;
+
+	/// A chunked range with Map/Filter stages, as opposed to a plain contiguous
+	/// range that sinks can already handle directly
+	template<typename R>
+	concept ChunkedView =
+	  ChunkedRange<R> and not ContiguousSource<iterator_t<R>>;
+
+	template<ChunkedRange R>
+	using chunk_source_t = chunk_source<iterator_t<R>, iterator_end_t<R>>;
+
+	template<ChunkedRange R, typename Sink>
+	DAW_ATTRIB_INLINE constexpr void for_each_chunk( R &&r, Sink &&sink ) {
+		chunk_source_t<R>::run( std::begin( r ), std::end( r ), sink );
+	}
+
+	/// The iterator to the element offset positions past the start of the
+	/// source of r, as reported by chunk_t::offset plus a row
+	template<ChunkedRange R>
+	[[nodiscard]] constexpr iterator_t<R> chunk_iterator_at( R &&r,
+	                                                         std::size_t offset ) {
+		return chunk_source_t<R>::at( std::begin( r ), std::end( r ), offset );
+	}
+} // namespace daw::pipelines::pimpl
@@ -12,7 +12,6 @@
 #include "daw/daw_is_constant_evaluated.h"
 #include "daw/daw_iterator_traits.h"
 #include "daw/daw_move.h"
-#include "daw/daw_print.h"
 #include "daw/daw_remove_cvref.h"
 #include "daw/daw_typeof.h"
 #include "daw/pipelines/range.h"
@@ -21,7 +20,9 @@
 #include <concepts>
 #include <cstddef>
 #include <iterator>
+#include <functional>
 #include <optional>
+#include <type_traits>
 #include <utility>
 
 namespace daw::pipelines {
@@ -32,7 +33,10 @@ namespace daw::pipelines {
 		using typename daw_range_base_t::iterator_first_t;
 		using typename daw_range_base_t::iterator_last_t;
 
-		using iterator_category = std::forward_iterator_tag;
+		/// Single pass sources, like generators, stay single pass
+		using iterator_category =
+		  std::conditional_t<ForwardIterator<iterator_first_t>,
+		                     std::forward_iterator_tag, std::input_iterator_tag>;
 		using value_type = daw::iter_value_t<iterator_first_t>;
 		using reference = daw::iter_reference_t<iterator_first_t>;
 		using const_reference = daw::iter_const_reference_t<iterator_first_t>;
@@ -73,6 +77,18 @@ namespace daw::pipelines {
 			return m_first;
 		}
 
+		[[nodiscard]] constexpr auto const &base_end( ) const {
+			return m_last;
+		}
+
+		[[nodiscard]] constexpr Filter &func( ) const {
+			return m_func;
+		}
+
+		[[nodiscard]] constexpr Projection const &projection( ) const {
+			return m_projection;
+		}
+
 		[[nodiscard]] DAW_ATTRIB_INLINE constexpr filter_view begin( ) const {
 			return *this;
 		}
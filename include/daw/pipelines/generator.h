@@ -0,0 +1,583 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/daw_attributes.h"
+#include "daw/daw_cpp_feature_check.h"
+
+#if defined( DAW_HAS_CPP20_COROUTINES )
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace daw::pipelines::pimpl {
+	/// Coroutine frames are allocated in units of this so that any allocator
+	/// hands back memory with operator new alignment
+	struct alignas( __STDCPP_DEFAULT_NEW_ALIGNMENT__ ) frame_block {
+		unsigned char data[__STDCPP_DEFAULT_NEW_ALIGNMENT__];
+	};
+
+	/// Stored after each frame, releases a frame of the given size
+	using frame_dealloc_fn = void ( * )( void *, std::size_t ) noexcept;
+
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr std::size_t
+	round_up( std::size_t n, std::size_t align ) noexcept {
+		return ( n + align - 1U ) & ~( align - 1U );
+	}
+
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr std::size_t
+	frame_footer_offset( std::size_t frame_size ) noexcept {
+		return round_up( frame_size, alignof( frame_dealloc_fn ) );
+	}
+
+	template<typename Alloc>
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr std::size_t
+	frame_alloc_offset( std::size_t frame_size ) noexcept {
+		return round_up( frame_footer_offset( frame_size ) +
+		                   sizeof( frame_dealloc_fn ),
+		                 alignof( Alloc ) );
+	}
+
+	[[nodiscard]] DAW_ATTRIB_INLINE frame_dealloc_fn &
+	frame_footer( void *frame, std::size_t frame_size ) noexcept {
+		return *static_cast<frame_dealloc_fn *>( static_cast<void *>(
+		  static_cast<unsigned char *>( frame ) +
+		  frame_footer_offset( frame_size ) ) );
+	}
+
+	/// A per thread cache of recently freed frames, bucketed by size.  Creating
+	/// short lived generators in a loop reuses the same few blocks instead of
+	/// going to the global allocator each time
+	struct frame_cache {
+		static constexpr std::size_t size_class = 64;
+		static constexpr std::size_t bucket_count = 32;
+		static constexpr std::size_t max_cached = 16;
+
+		struct state_t {
+			void *frames[bucket_count][max_cached];
+			unsigned char counts[bucket_count];
+			bool disabled;
+		};
+
+		/// Trivially destructible so that access is not guarded, the cleaner
+		/// below releases the cached frames when the thread exits
+		static inline thread_local constinit state_t state{ };
+
+		struct cleaner_t {
+			cleaner_t( ) = default;
+			cleaner_t( cleaner_t const & ) = delete;
+			cleaner_t &operator=( cleaner_t const & ) = delete;
+
+			~cleaner_t( ) {
+				state.disabled = true;
+				for( std::size_t b = 0; b < bucket_count; ++b ) {
+					while( state.counts[b] > 0 ) {
+						::operator delete( state.frames[b][--state.counts[b]] );
+					}
+				}
+			}
+		};
+
+		static inline thread_local cleaner_t cleaner{ };
+
+		[[nodiscard]] static constexpr std::size_t
+		block_size( std::size_t frame_size ) noexcept {
+			return frame_footer_offset( frame_size ) + sizeof( frame_dealloc_fn );
+		}
+
+		[[nodiscard]] static constexpr std::size_t
+		bucket( std::size_t frame_size ) noexcept {
+			return ( block_size( frame_size ) - 1U ) / size_class;
+		}
+
+		[[nodiscard]] static void *allocate( std::size_t frame_size ) {
+			auto const b = bucket( frame_size );
+			void *result = nullptr;
+			if( b < bucket_count ) {
+				if( state.counts[b] > 0 ) {
+					result = state.frames[b][--state.counts[b]];
+				} else {
+					// All blocks in a bucket are the same size so that any cached
+					// block can hold any frame of its class
+					result = ::operator new( ( b + 1U ) * size_class );
+				}
+			} else {
+				result = ::operator new( block_size( frame_size ) );
+			}
+			frame_footer( result, frame_size ) = &deallocate;
+			return result;
+		}
+
+		static void deallocate( void *frame, std::size_t frame_size ) noexcept {
+			auto const b = bucket( frame_size );
+			if( b < bucket_count and not state.disabled and
+			    state.counts[b] < max_cached ) {
+				// odr-use so that the cleaner is constructed on this thread
+				(void)&cleaner;
+				state.frames[b][state.counts[b]++] = frame;
+				return;
+			}
+			::operator delete( frame );
+		}
+	};
+
+	/// Frame allocation for generator promises.  Frames come from the thread
+	/// local frame_cache unless the coroutine takes an std::allocator_arg_t,
+	/// Alloc pair as its leading parameters(after the object parameter for
+	/// member functions).  In that case the allocator is stored after the
+	/// frame and used to release it, and the frame size is stored in a block
+	/// before the frame for the placement operator delete overloads
+	struct frame_alloc_base {
+		[[nodiscard]] static void *operator new( std::size_t frame_size ) {
+			return frame_cache::allocate( frame_size );
+		}
+
+		template<typename Alloc, typename... Args>
+		[[nodiscard]] static void *operator new( std::size_t frame_size,
+		                                         std::allocator_arg_t,
+		                                         Alloc const &alloc,
+		                                         Args const &... ) {
+			return allocate_with( frame_size, alloc );
+		}
+
+		template<typename This, typename Alloc, typename... Args>
+		[[nodiscard]] static void *operator new( std::size_t frame_size,
+		                                         This const &,
+		                                         std::allocator_arg_t,
+		                                         Alloc const &alloc,
+		                                         Args const &... ) {
+			return allocate_with( frame_size, alloc );
+		}
+
+		static void operator delete( void *frame,
+		                             std::size_t frame_size ) noexcept {
+			frame_footer( frame, frame_size )( frame, frame_size );
+		}
+
+		template<typename Alloc, typename... Args>
+		static void operator delete( void *frame, std::allocator_arg_t,
+		                             Alloc const &, Args const &... ) noexcept {
+			deallocate_sized( frame );
+		}
+
+		template<typename This, typename Alloc, typename... Args>
+		static void operator delete( void *frame, This const &,
+		                             std::allocator_arg_t, Alloc const &,
+		                             Args const &... ) noexcept {
+			deallocate_sized( frame );
+		}
+
+	private:
+		[[nodiscard]] static std::size_t &size_header( void *frame ) noexcept {
+			return *std::launder( static_cast<std::size_t *>(
+			  static_cast<void *>( static_cast<frame_block *>( frame ) - 1 ) ) );
+		}
+
+		static void deallocate_sized( void *frame ) noexcept {
+			auto const frame_size = size_header( frame );
+			frame_footer( frame, frame_size )( frame, frame_size );
+		}
+
+		template<typename Alloc>
+		using block_alloc_t = typename std::allocator_traits<
+		  Alloc>::template rebind_alloc<frame_block>;
+
+		template<typename BlockAlloc>
+		[[nodiscard]] static constexpr std::size_t
+		block_count( std::size_t frame_size ) noexcept {
+			// One leading block holds the frame size
+			return 1U + ( frame_alloc_offset<BlockAlloc>( frame_size ) +
+			              sizeof( BlockAlloc ) + sizeof( frame_block ) - 1U ) /
+			              sizeof( frame_block );
+		}
+
+		template<typename Alloc>
+		[[nodiscard]] static void *allocate_with( std::size_t frame_size,
+		                                          Alloc const &alloc ) {
+			using block_alloc = block_alloc_t<Alloc>;
+			static_assert( alignof( block_alloc ) <= alignof( frame_block ),
+			               "Allocator is over aligned for a coroutine frame" );
+			static_assert( sizeof( std::size_t ) <= sizeof( frame_block ) );
+			auto a = block_alloc( alloc );
+			frame_block *const blocks = std::allocator_traits<block_alloc>::allocate(
+			  a, block_count<block_alloc>( frame_size ) );
+			::new( static_cast<void *>( blocks ) ) std::size_t( frame_size );
+			void *result = static_cast<void *>( blocks + 1 );
+			::new( static_cast<void *>(
+			  static_cast<unsigned char *>( result ) +
+			  frame_alloc_offset<block_alloc>( frame_size ) ) )
+			  block_alloc( std::move( a ) );
+			frame_footer( result, frame_size ) = &deallocate_with<block_alloc>;
+			return result;
+		}
+
+		template<typename BlockAlloc>
+		static void deallocate_with( void *frame,
+		                             std::size_t frame_size ) noexcept {
+			auto *stored = std::launder( static_cast<BlockAlloc *>(
+			  static_cast<void *>( static_cast<unsigned char *>( frame ) +
+			                       frame_alloc_offset<BlockAlloc>( frame_size ) ) ) );
+			auto a = BlockAlloc( std::move( *stored ) );
+			stored->~BlockAlloc( );
+			std::allocator_traits<BlockAlloc>::deallocate(
+			  a, static_cast<frame_block *>( frame ) - 1,
+			  block_count<BlockAlloc>( frame_size ) );
+		}
+	};
+
+	/// Single pass iterator over a generator.  Promise::advance resumes the
+	/// coroutine until the next value or completion
+	template<typename Promise>
+	class generator_iterator {
+		using handle_t = std::coroutine_handle<Promise>;
+		handle_t m_coro = nullptr;
+
+	public:
+		using iterator_concept = std::input_iterator_tag;
+		using iterator_category = std::input_iterator_tag;
+		using value_type = typename Promise::value_type;
+		using reference = value_type const &;
+		using pointer = value_type const *;
+		using difference_type = std::ptrdiff_t;
+
+		generator_iterator( ) = default;
+
+		explicit generator_iterator( handle_t h ) noexcept
+		  : m_coro( h ) {}
+
+		[[nodiscard]] reference operator*( ) const noexcept {
+			return *m_coro.promise( ).m_value;
+		}
+
+		[[nodiscard]] pointer operator->( ) const noexcept {
+			return m_coro.promise( ).m_value;
+		}
+
+		generator_iterator &operator++( ) {
+			Promise::advance( m_coro );
+			return *this;
+		}
+
+		generator_iterator operator++( int ) {
+			auto result = *this;
+			Promise::advance( m_coro );
+			return result;
+		}
+
+		[[nodiscard]] bool at_end( ) const noexcept {
+			return not m_coro or m_coro.done( );
+		}
+
+		/// Iterators only compare on whether they are at the end of the sequence
+		[[nodiscard]] friend bool
+		operator==( generator_iterator const &lhs,
+		            generator_iterator const &rhs ) noexcept {
+			return lhs.at_end( ) == rhs.at_end( );
+		}
+	};
+
+	/// Owning handle shared by generator and async_generator
+	template<typename Promise>
+	class generator_base {
+	protected:
+		using handle_t = std::coroutine_handle<Promise>;
+		handle_t m_coro = nullptr;
+
+		explicit generator_base( handle_t h ) noexcept
+		  : m_coro( h ) {}
+
+	public:
+		using value_type = typename Promise::value_type;
+		using iterator = generator_iterator<Promise>;
+		using const_iterator = iterator;
+		using reference = value_type const &;
+		using const_reference = value_type const &;
+
+		generator_base( ) = default;
+
+		generator_base( generator_base &&other ) noexcept
+		  : m_coro( std::exchange( other.m_coro, nullptr ) ) {}
+
+		generator_base &operator=( generator_base &&rhs ) noexcept {
+			if( this != &rhs ) {
+				reset( );
+				m_coro = std::exchange( rhs.m_coro, nullptr );
+			}
+			return *this;
+		}
+
+		~generator_base( ) {
+			reset( );
+		}
+
+		/// Starts the generator on the first call, later calls continue from the
+		/// current position
+		[[nodiscard]] iterator begin( ) const {
+			if( m_coro and not m_coro.promise( ).m_started ) {
+				m_coro.promise( ).m_started = true;
+				Promise::advance( m_coro );
+			}
+			return iterator( m_coro );
+		}
+
+		[[nodiscard]] iterator end( ) const noexcept {
+			return iterator( );
+		}
+
+		[[nodiscard]] bool done( ) const noexcept {
+			return not m_coro or m_coro.done( );
+		}
+
+	private:
+		void reset( ) noexcept {
+			if( m_coro ) {
+				m_coro.destroy( );
+				m_coro = nullptr;
+			}
+		}
+	};
+} // namespace daw::pipelines::pimpl
+
+namespace daw::pipelines {
+	template<typename T>
+	class generator;
+
+	template<typename T>
+	class async_generator;
+} // namespace daw::pipelines
+
+namespace daw::pipelines::pimpl {
+	template<typename T>
+	struct generator_promise : frame_alloc_base {
+		using value_type = std::remove_cvref_t<T>;
+		using handle_t = std::coroutine_handle<generator_promise>;
+
+		value_type const *m_value = nullptr;
+		std::exception_ptr m_exception = nullptr;
+		bool m_started = false;
+
+		[[nodiscard]] generator<T> get_return_object( ) noexcept {
+			return generator<T>( handle_t::from_promise( *this ) );
+		}
+
+		[[nodiscard]] std::suspend_always initial_suspend( ) const noexcept {
+			return { };
+		}
+
+		[[nodiscard]] std::suspend_always final_suspend( ) const noexcept {
+			return { };
+		}
+
+		std::suspend_always yield_value( value_type const &v ) noexcept {
+			m_value = std::addressof( v );
+			return { };
+		}
+
+		std::suspend_always yield_value( value_type &&v ) noexcept {
+			m_value = std::addressof( v );
+			return { };
+		}
+
+		void return_void( ) noexcept {
+			m_value = nullptr;
+		}
+
+		void unhandled_exception( ) noexcept {
+			m_exception = std::current_exception( );
+		}
+
+		/// Generators only produce values, awaiting inside one is an error
+		template<typename U>
+		std::suspend_never await_transform( U && ) = delete;
+
+		static void advance( handle_t h ) {
+			h.resume( );
+			if( h.done( ) and h.promise( ).m_exception ) {
+				std::rethrow_exception(
+				  std::exchange( h.promise( ).m_exception, nullptr ) );
+			}
+		}
+	};
+
+	template<typename T>
+	struct async_generator_promise : frame_alloc_base {
+		using value_type = std::remove_cvref_t<T>;
+		using handle_t = std::coroutine_handle<async_generator_promise>;
+
+		enum class signal : unsigned char { waiting, ready, released };
+
+		value_type const *m_value = nullptr;
+		std::exception_ptr m_exception = nullptr;
+		/// Set while a coroutine is suspended in co_await next( )
+		std::coroutine_handle<> m_consumer = nullptr;
+		std::atomic<signal> m_signal = signal::waiting;
+		bool m_started = false;
+
+		/// Suspends the producer and resumes whoever is waiting on it
+		struct yield_awaiter {
+			[[nodiscard]] constexpr bool await_ready( ) const noexcept {
+				return false;
+			}
+
+			[[nodiscard]] std::coroutine_handle<>
+			await_suspend( handle_t h ) const noexcept {
+				auto &p = h.promise( );
+				if( p.m_consumer ) {
+					return std::exchange( p.m_consumer, nullptr );
+				}
+				// The frame may be destroyed as soon as the blocked thread sees
+				// released, so that is the last access
+				p.m_signal.store( signal::ready, std::memory_order_release );
+				p.m_signal.notify_one( );
+				p.m_signal.store( signal::released, std::memory_order_release );
+				return std::noop_coroutine( );
+			}
+
+			constexpr void await_resume( ) const noexcept {}
+		};
+
+		[[nodiscard]] async_generator<T> get_return_object( ) noexcept {
+			return async_generator<T>( handle_t::from_promise( *this ) );
+		}
+
+		[[nodiscard]] std::suspend_always initial_suspend( ) const noexcept {
+			return { };
+		}
+
+		[[nodiscard]] yield_awaiter final_suspend( ) const noexcept {
+			return { };
+		}
+
+		yield_awaiter yield_value( value_type const &v ) noexcept {
+			m_value = std::addressof( v );
+			return { };
+		}
+
+		yield_awaiter yield_value( value_type &&v ) noexcept {
+			m_value = std::addressof( v );
+			return { };
+		}
+
+		void return_void( ) noexcept {
+			m_value = nullptr;
+		}
+
+		void unhandled_exception( ) noexcept {
+			m_exception = std::current_exception( );
+		}
+
+		void rethrow_if_exception( ) {
+			if( m_exception ) {
+				std::rethrow_exception( std::exchange( m_exception, nullptr ) );
+			}
+		}
+
+		/// Blocking resume used by Range iteration
+		static void advance( handle_t h ) {
+			auto &p = h.promise( );
+			p.m_signal.store( signal::waiting, std::memory_order_relaxed );
+			h.resume( );
+			p.m_signal.wait( signal::waiting, std::memory_order_acquire );
+			while( p.m_signal.load( std::memory_order_acquire ) !=
+			       signal::released ) {}
+			if( h.done( ) ) {
+				p.rethrow_if_exception( );
+			}
+		}
+	};
+} // namespace daw::pipelines::pimpl
+
+namespace daw::pipelines {
+	/// A lazy, single pass range produced by a coroutine with co_yield.  The
+	/// body starts on the first call to begin( ).  Exceptions thrown in the
+	/// body propagate out of begin( )/operator++.  Frames come from a thread
+	/// local cache, or from an allocator passed as std::allocator_arg, alloc
+	/// leading arguments
+	template<typename T>
+	class generator : public pimpl::generator_base<pimpl::generator_promise<T>> {
+		using base_t = pimpl::generator_base<pimpl::generator_promise<T>>;
+		friend struct pimpl::generator_promise<T>;
+
+		explicit generator(
+		  std::coroutine_handle<pimpl::generator_promise<T>> h ) noexcept
+		  : base_t( h ) {}
+
+	public:
+		using promise_type = pimpl::generator_promise<T>;
+
+		generator( ) = default;
+	};
+
+	/// A generator whose body may co_await.  A consumer coroutine pulls values
+	/// with co_await g.next( ), the producer and consumer then hand control to
+	/// each other with symmetric transfer, on whichever thread the producer
+	/// was resumed on.  Iterating it as a Range blocks the calling thread until
+	/// each value is available.  A single async_generator must be consumed in
+	/// one of those two ways, not both
+	template<typename T>
+	class async_generator
+	  : public pimpl::generator_base<pimpl::async_generator_promise<T>> {
+		using base_t = pimpl::generator_base<pimpl::async_generator_promise<T>>;
+		friend struct pimpl::async_generator_promise<T>;
+
+		explicit async_generator(
+		  std::coroutine_handle<pimpl::async_generator_promise<T>> h ) noexcept
+		  : base_t( h ) {}
+
+	public:
+		using promise_type = pimpl::async_generator_promise<T>;
+		using handle_t = std::coroutine_handle<promise_type>;
+
+		/// The result of co_await next( ) is a pointer to the next value, or
+		/// nullptr when the generator is finished
+		struct next_awaiter {
+			handle_t m_coro;
+
+			[[nodiscard]] bool await_ready( ) const noexcept {
+				return not m_coro or m_coro.done( );
+			}
+
+			[[nodiscard]] std::coroutine_handle<>
+			await_suspend( std::coroutine_handle<> consumer ) const noexcept {
+				m_coro.promise( ).m_consumer = consumer;
+				return m_coro;
+			}
+
+			[[nodiscard]] typename promise_type::value_type const *
+			await_resume( ) const {
+				if( not m_coro ) {
+					return nullptr;
+				}
+				if( m_coro.done( ) ) {
+					m_coro.promise( ).rethrow_if_exception( );
+					return nullptr;
+				}
+				return m_coro.promise( ).m_value;
+			}
+		};
+
+		async_generator( ) = default;
+
+		[[nodiscard]] next_awaiter next( ) const noexcept {
+			if( this->m_coro ) {
+				this->m_coro.promise( ).m_started = true;
+			}
+			return next_awaiter{ this->m_coro };
+		}
+	};
+} // namespace daw::pipelines
+
+#endif
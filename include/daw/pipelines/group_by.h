@@ -0,0 +1,621 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/cpp_17.h"
+#include "daw/daw_attributes.h"
+#include "daw/daw_ensure.h"
+#include "daw/daw_iterator_traits.h"
+#include "daw/daw_move.h"
+#include "daw/daw_remove_cvref.h"
+#include "daw/impl/daw_simd_check.h"
+#include "daw/pipelines/range.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace daw::pipelines::pimpl {
+	/// Group with a hash table, the output is in order of first appearance
+	struct hashed_t {};
+
+	/// Equal keys are adjacent, groups are produced lazily one run at a time
+	/// without any table
+	struct presorted_t {};
+
+	/// Hash aggregation split over threads.  Rows are partitioned by key hash
+	/// and each partition is aggregated by one thread, so the values of a group
+	/// are still combined in input order.  A thread_count of 0 uses
+	/// std::thread::hardware_concurrency( )
+	struct parallel_t {
+		std::size_t thread_count = 0;
+		/// Smaller inputs are aggregated on the calling thread
+		std::size_t min_size = 1U << 16U;
+
+		[[nodiscard]] constexpr parallel_t
+		operator( )( std::size_t count ) const noexcept {
+			return parallel_t{ count, min_size };
+		}
+	};
+
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr std::uint64_t
+	mix_hash( std::uint64_t h ) noexcept {
+		h ^= h >> 33U;
+		h *= 0xff51'afd7'ed55'8ccdULL;
+		h ^= h >> 33U;
+		h *= 0xc4ce'b9fe'1a85'ec53ULL;
+		h ^= h >> 33U;
+		return h;
+	}
+
+	template<typename Key>
+	[[nodiscard]] DAW_ATTRIB_INLINE std::uint64_t hash_key( Key const &key ) {
+		return mix_hash( static_cast<std::uint64_t>( std::hash<Key>{ }( key ) ) );
+	}
+
+	/// Applies combine( acc, v ).  Combiners that return void update acc in
+	/// place, otherwise the result is assigned back to acc
+	template<typename Acc, typename Combine, typename V>
+	DAW_ATTRIB_INLINE constexpr void combine_into( Acc &acc,
+	                                               Combine const &combine,
+	                                               V &&v ) {
+		if constexpr( std::is_void_v<std::invoke_result_t<Combine const &, Acc &,
+		                                                  V>> ) {
+			std::invoke( combine, acc, DAW_FWD( v ) );
+		} else {
+			acc = std::invoke( combine, std::move( acc ), DAW_FWD( v ) );
+		}
+	}
+
+	inline constexpr std::size_t ctrl_group_size = 16;
+	inline constexpr std::uint8_t ctrl_empty = 0x80U;
+
+	/// Bitmask of the control bytes in the group at ctrl that equal b
+	[[nodiscard]] DAW_ATTRIB_INLINE std::uint32_t
+	ctrl_match( std::uint8_t const *ctrl, std::uint8_t b ) noexcept {
+#if defined( DAW_HAS_SSE2 )
+		auto const group =
+		  _mm_loadu_si128( reinterpret_cast<__m128i const *>( ctrl ) );
+		return static_cast<std::uint32_t>( _mm_movemask_epi8(
+		  _mm_cmpeq_epi8( group, _mm_set1_epi8( static_cast<char>( b ) ) ) ) );
+#else
+		std::uint32_t result = 0;
+		for( std::size_t n = 0; n < ctrl_group_size; ++n ) {
+			result |= static_cast<std::uint32_t>( ctrl[n] == b ) << n;
+		}
+		return result;
+#endif
+	}
+
+	/// A flat open addressing table of Key -> Acc.  Slots are probed a group
+	/// of 16 at a time by matching a 7 bit hash fragment in a control byte
+	/// array, so a lookup compares keys only for likely matches and does not
+	/// branch per slot.  Each slot also records its insertion sequence number
+	/// so that release( ) can return the entries in insertion order
+	template<typename Key, typename Acc>
+	class aggregate_table {
+	public:
+		using value_type = std::pair<Key, Acc>;
+
+	private:
+		struct slot_t {
+			/// One past the insertion order
+			std::uint32_t seq = 0;
+			std::optional<value_type> entry{ };
+		};
+
+		std::vector<std::uint8_t> m_ctrl{ };
+		std::vector<slot_t> m_slots{ };
+		std::size_t m_group_mask = 0;
+		std::size_t m_size = 0;
+
+		[[nodiscard]] static std::uint8_t h2_of( std::uint64_t hash ) noexcept {
+			return static_cast<std::uint8_t>( hash & 0x7FU );
+		}
+
+		[[nodiscard]] std::size_t group_of( std::uint64_t hash ) const noexcept {
+			return static_cast<std::size_t>( hash >> 7U ) & m_group_mask;
+		}
+
+		/// The first empty slot in the probe sequence of hash
+		[[nodiscard]] std::size_t find_empty( std::uint64_t hash ) const noexcept {
+			auto g = group_of( hash );
+			while( true ) {
+				auto const *ctrl = m_ctrl.data( ) + g * ctrl_group_size;
+				if( auto const e = ctrl_match( ctrl, ctrl_empty ); e != 0 ) {
+					return g * ctrl_group_size +
+					       static_cast<std::size_t>( std::countr_zero( e ) );
+				}
+				g = ( g + 1U ) & m_group_mask;
+			}
+		}
+
+		void reset( std::size_t group_count ) {
+			m_group_mask = group_count - 1U;
+			m_ctrl.assign( group_count * ctrl_group_size, ctrl_empty );
+			m_slots.clear( );
+			m_slots.resize( group_count * ctrl_group_size );
+		}
+
+		void grow( ) {
+			auto old = std::move( m_slots );
+			reset( ( m_group_mask + 1U ) * 2U );
+			for( auto &s : old ) {
+				if( s.seq == 0 ) {
+					continue;
+				}
+				auto const hash = hash_key( s.entry->first );
+				auto const pos = find_empty( hash );
+				m_ctrl[pos] = h2_of( hash );
+				m_slots[pos] = std::move( s );
+			}
+		}
+
+	public:
+		struct find_result {
+			Acc &acc;
+			bool inserted;
+		};
+
+		explicit aggregate_table( std::size_t expected = 0 ) {
+			std::size_t groups = 1;
+			while( groups * ctrl_group_size * 7U < expected * 8U ) {
+				groups *= 2U;
+			}
+			reset( groups );
+		}
+
+		/// Find the entry for key, creating it with make_acc( ) if it does not
+		/// exist.  hash must be hash_key( key )
+		template<typename K, typename MakeAcc>
+		[[nodiscard]] DAW_ATTRIB_INLINE find_result
+		find_or_insert( K &&key, std::uint64_t hash, MakeAcc &&make_acc ) {
+			auto const h2 = h2_of( hash );
+			auto g = group_of( hash );
+			while( true ) {
+				auto const *ctrl = m_ctrl.data( ) + g * ctrl_group_size;
+				for( auto m = ctrl_match( ctrl, h2 ); m != 0; m &= m - 1U ) {
+					auto &s = m_slots[g * ctrl_group_size +
+					                  static_cast<std::size_t>( std::countr_zero( m ) )];
+					if( s.entry->first == key ) {
+						return find_result{ s.entry->second, false };
+					}
+				}
+				// Nothing is erased, so an empty slot ends the probe sequence
+				if( ctrl_match( ctrl, ctrl_empty ) != 0 ) {
+					break;
+				}
+				g = ( g + 1U ) & m_group_mask;
+			}
+			daw_ensure( m_size < std::numeric_limits<std::uint32_t>::max( ) );
+			if( ( m_size + 1U ) * 8U > m_slots.size( ) * 7U ) {
+				grow( );
+			}
+			auto const pos = find_empty( hash );
+			auto &s = m_slots[pos];
+			s.entry.emplace( DAW_FWD( key ), make_acc( ) );
+			s.seq = static_cast<std::uint32_t>( ++m_size );
+			m_ctrl[pos] = h2;
+			return find_result{ s.entry->second, true };
+		}
+
+		[[nodiscard]] std::size_t size( ) const noexcept {
+			return m_size;
+		}
+
+		/// The entries in insertion order
+		[[nodiscard]] std::vector<value_type> release( ) && {
+			auto order = std::vector<slot_t *>( m_size );
+			for( auto &s : m_slots ) {
+				if( s.seq != 0 ) {
+					order[s.seq - 1U] = &s;
+				}
+			}
+			auto result = std::vector<value_type>( );
+			result.reserve( m_size );
+			for( auto *s : order ) {
+				result.push_back( std::move( *s->entry ) );
+			}
+			return result;
+		}
+	};
+
+	template<typename R, typename KeyFn>
+	using group_key_t =
+	  daw::remove_cvref_t<std::invoke_result_t<KeyFn const &,
+	                                           daw::range_reference_t<R>>>;
+
+	template<typename R, typename MakeAcc>
+	using group_acc_t = daw::remove_cvref_t<
+	  std::invoke_result_t<MakeAcc const &, daw::range_reference_t<R>>>;
+
+	template<typename R, typename KeyFn, typename MakeAcc, typename Combine>
+	[[nodiscard]] auto aggregate_hashed( R &&r, KeyFn const &key_fn,
+	                                     MakeAcc const &make_acc,
+	                                     Combine const &combine ) {
+		using key_t = group_key_t<R, KeyFn>;
+		using acc_t = group_acc_t<R, MakeAcc>;
+		auto table = aggregate_table<key_t, acc_t>( );
+		for( auto &&v : r ) {
+			// Keys are only copied into the table for new groups
+			decltype( auto ) key = std::invoke( key_fn, v );
+			auto const hash = hash_key<key_t>( key );
+			auto const found = table.find_or_insert( DAW_FWD( key ), hash, [&] {
+				return std::invoke( make_acc, v );
+			} );
+			combine_into( found.acc, combine, DAW_FWD( v ) );
+		}
+		return std::move( table ).release( );
+	}
+
+	/// Runs f( n ) for n in [0, count) with a thread per index after the first,
+	/// which runs on the calling thread.  The first exception is rethrown once
+	/// all threads are done
+	template<typename F>
+	void run_on_threads( std::size_t count, F &&f ) {
+		auto error = std::exception_ptr{ };
+		auto has_error = std::atomic<bool>{ false };
+		auto const guarded = [&]( std::size_t n ) {
+			try {
+				f( n );
+			} catch( ... ) {
+				if( not has_error.exchange( true ) ) {
+					error = std::current_exception( );
+				}
+			}
+		};
+		auto threads = std::vector<std::thread>( );
+		threads.reserve( count - 1U );
+		for( std::size_t n = 1; n < count; ++n ) {
+			threads.emplace_back( guarded, n );
+		}
+		guarded( 0 );
+		for( auto &th : threads ) {
+			th.join( );
+		}
+		if( error ) {
+			std::rethrow_exception( error );
+		}
+	}
+
+	template<typename R, typename KeyFn, typename MakeAcc, typename Combine>
+	[[nodiscard]] auto aggregate_parallel( R &&r, KeyFn const &key_fn,
+	                                       MakeAcc const &make_acc,
+	                                       Combine const &combine,
+	                                       parallel_t opts ) {
+		using key_t = group_key_t<R, KeyFn>;
+		using acc_t = group_acc_t<R, MakeAcc>;
+		using table_t = aggregate_table<key_t, acc_t>;
+		struct row_t {
+			std::size_t row;
+			std::uint64_t hash;
+		};
+
+		auto const first = std::begin( r );
+		auto const size =
+		  static_cast<std::size_t>( std::distance( first, std::end( r ) ) );
+		auto thread_count = opts.thread_count == 0
+		                      ? static_cast<std::size_t>(
+		                          std::thread::hardware_concurrency( ) )
+		                      : opts.thread_count;
+		if( thread_count <= 1 or size < opts.min_size ) {
+			return aggregate_hashed( r, key_fn, make_acc, combine );
+		}
+		// Partition on the high bits, the tables index on the low bits
+		std::size_t part_bits = 0;
+		while( ( std::size_t{ 1 } << part_bits ) < thread_count ) {
+			++part_bits;
+		}
+		auto const part_count = std::size_t{ 1 } << part_bits;
+		auto const block = ( size + thread_count - 1U ) / thread_count;
+		auto const partition_of = [&]( std::uint64_t hash ) {
+			return part_bits == 0
+			         ? std::size_t{ 0 }
+			         : static_cast<std::size_t>( hash >> ( 64U - part_bits ) );
+		};
+
+		// Phase 1: each thread scatters the rows of its block by partition
+		auto scattered = std::vector<std::vector<std::vector<row_t>>>(
+		  thread_count, std::vector<std::vector<row_t>>( part_count ) );
+		run_on_threads( thread_count, [&]( std::size_t t ) {
+			auto const lo = std::min( size, t * block );
+			auto const hi = std::min( size, lo + block );
+			auto &parts = scattered[t];
+			for( auto &p : parts ) {
+				p.reserve( ( hi - lo ) / part_count + 16U );
+			}
+			for( std::size_t row = lo; row < hi; ++row ) {
+				auto const hash = hash_key<key_t>(
+				  std::invoke( key_fn, first[static_cast<std::ptrdiff_t>( row )] ) );
+				parts[partition_of( hash )].push_back( row_t{ row, hash } );
+			}
+		} );
+
+		// Phase 2: each partition is aggregated by one thread, visiting the
+		// blocks in order so groups see their values in input order
+		auto tables = std::vector<std::optional<table_t>>( part_count );
+		auto first_rows = std::vector<std::vector<std::size_t>>( part_count );
+		auto const part_threads = std::min( thread_count, part_count );
+		run_on_threads( part_threads, [&]( std::size_t t ) {
+			for( std::size_t p = t; p < part_count; p += part_threads ) {
+				auto &table = tables[p].emplace( );
+				for( auto const &parts : scattered ) {
+					for( auto const &rw : parts[p] ) {
+						auto &&v = first[static_cast<std::ptrdiff_t>( rw.row )];
+						auto const found = table.find_or_insert(
+						  std::invoke( key_fn, v ), rw.hash, [&] {
+							  return std::invoke( make_acc, v );
+						  } );
+						if( found.inserted ) {
+							first_rows[p].push_back( rw.row );
+						}
+						combine_into( found.acc, combine, v );
+					}
+				}
+			}
+		} );
+
+		// Concatenate the partitions and restore first appearance order
+		auto order = std::vector<std::pair<std::size_t, std::pair<std::size_t,
+		                                                          std::size_t>>>( );
+		auto entries = std::vector<std::vector<typename table_t::value_type>>( );
+		entries.reserve( part_count );
+		for( std::size_t p = 0; p < part_count; ++p ) {
+			entries.push_back( std::move( *tables[p] ).release( ) );
+			for( std::size_t n = 0; n < first_rows[p].size( ); ++n ) {
+				order.emplace_back( first_rows[p][n], std::pair{ p, n } );
+			}
+		}
+		std::sort( order.begin( ), order.end( ),
+		           []( auto const &lhs, auto const &rhs ) {
+			           return lhs.first < rhs.first;
+		           } );
+		auto result = std::vector<typename table_t::value_type>( );
+		result.reserve( order.size( ) );
+		for( auto const &o : order ) {
+			result.push_back( std::move( entries[o.second.first][o.second.second] ) );
+		}
+		return result;
+	}
+
+	/// Aggregates each run of equal keys as it is reached.  Only the current
+	/// group is held, so it works on single pass and unbounded sources
+	template<typename R, typename KeyFn, typename MakeAcc, typename Combine>
+	struct group_runs_view {
+		using key_type = group_key_t<R, KeyFn>;
+		using acc_type = group_acc_t<R, MakeAcc>;
+		using value_type = std::pair<key_type, acc_type>;
+		using reference = value_type const &;
+		using const_reference = value_type const &;
+		using difference_type = std::ptrdiff_t;
+
+	private:
+		using m_range_t = daw::remove_cvrvref_t<R>;
+		using m_iter_t = daw::iterator_t<m_range_t const>;
+		using m_last_t = daw::iterator_end_t<m_range_t const>;
+
+		m_range_t m_range;
+		DAW_NO_UNIQUE_ADDRESS KeyFn m_key_fn;
+		DAW_NO_UNIQUE_ADDRESS MakeAcc m_make_acc;
+		DAW_NO_UNIQUE_ADDRESS Combine m_combine;
+		mutable m_iter_t m_first{ };
+		mutable m_last_t m_last{ };
+		mutable std::optional<value_type> m_current{ };
+		mutable bool m_started = false;
+
+		void next_run( ) const {
+			if( m_first == m_last ) {
+				m_current.reset( );
+				return;
+			}
+			decltype( auto ) first_value = *m_first;
+			auto &cur = m_current.emplace( std::invoke( m_key_fn, first_value ),
+			                               std::invoke( m_make_acc, first_value ) );
+			combine_into( cur.second, m_combine, first_value );
+			++m_first;
+			while( m_first != m_last ) {
+				decltype( auto ) v = *m_first;
+				if( not( std::invoke( m_key_fn, v ) == cur.first ) ) {
+					break;
+				}
+				combine_into( cur.second, m_combine, v );
+				++m_first;
+			}
+		}
+
+	public:
+		class iterator {
+			group_runs_view const *m_view = nullptr;
+
+		public:
+			using iterator_concept = std::input_iterator_tag;
+			using iterator_category = std::input_iterator_tag;
+			using value_type = typename group_runs_view::value_type;
+			using reference = value_type const &;
+			using pointer = value_type const *;
+			using difference_type = std::ptrdiff_t;
+
+			iterator( ) = default;
+
+			explicit iterator( group_runs_view const *view ) noexcept
+			  : m_view( view->m_current ? view : nullptr ) {}
+
+			[[nodiscard]] reference operator*( ) const noexcept {
+				return *m_view->m_current;
+			}
+
+			[[nodiscard]] pointer operator->( ) const noexcept {
+				return std::addressof( *m_view->m_current );
+			}
+
+			iterator &operator++( ) {
+				m_view->next_run( );
+				if( not m_view->m_current ) {
+					m_view = nullptr;
+				}
+				return *this;
+			}
+
+			iterator operator++( int ) {
+				auto result = *this;
+				operator++( );
+				return result;
+			}
+
+			[[nodiscard]] friend bool operator==( iterator const &lhs,
+			                                      iterator const &rhs ) noexcept {
+				return lhs.m_view == rhs.m_view;
+			}
+		};
+
+		explicit group_runs_view( Range auto &&r, KeyFn const &key_fn,
+		                          MakeAcc const &make_acc,
+		                          Combine const &combine )
+		  : m_range( DAW_FWD( r ) )
+		  , m_key_fn( key_fn )
+		  , m_make_acc( make_acc )
+		  , m_combine( combine ) {}
+
+		[[nodiscard]] iterator begin( ) const {
+			if( not m_started ) {
+				m_started = true;
+				m_first = std::begin( m_range );
+				m_last = std::end( m_range );
+				next_run( );
+			}
+			return iterator( this );
+		}
+
+		[[nodiscard]] iterator end( ) const noexcept {
+			return iterator( );
+		}
+	};
+
+	template<typename KeyFn, typename MakeAcc, typename Combine, typename Mode>
+	struct AggregateBy_t {
+		DAW_NO_UNIQUE_ADDRESS KeyFn m_key_fn;
+		DAW_NO_UNIQUE_ADDRESS MakeAcc m_make_acc;
+		DAW_NO_UNIQUE_ADDRESS Combine m_combine;
+		DAW_NO_UNIQUE_ADDRESS Mode m_mode;
+
+		template<Range R>
+		[[nodiscard]] auto operator( )( R &&r ) const {
+			static_assert( std::invocable<KeyFn const &, range_reference_t<R>>,
+			               "The key function must be invocable with the range "
+			               "reference type" );
+			if constexpr( std::is_same_v<Mode, presorted_t> ) {
+				return group_runs_view<daw::remove_rvalue_ref_t<R>, KeyFn, MakeAcc,
+				                       Combine>( DAW_FWD( r ), m_key_fn, m_make_acc,
+				                                 m_combine );
+			} else if constexpr( std::is_same_v<Mode, parallel_t> and
+			                     RandomRange<R> ) {
+				return aggregate_parallel( r, m_key_fn, m_make_acc, m_combine,
+				                           m_mode );
+			} else {
+				return aggregate_hashed( r, m_key_fn, m_make_acc, m_combine );
+			}
+		}
+	};
+
+	template<typename T>
+	struct init_value {
+		T value;
+
+		template<typename V>
+		[[nodiscard]] constexpr T operator( )( V const & ) const {
+			return value;
+		}
+	};
+
+	struct group_init {
+		template<typename V>
+		[[nodiscard]] constexpr auto operator( )( V const & ) const {
+			return std::vector<daw::remove_cvref_t<V>>( );
+		}
+	};
+
+	struct group_combine {
+		template<typename Acc, typename V>
+		constexpr void operator( )( Acc &acc, V &&v ) const {
+			acc.push_back( DAW_FWD( v ) );
+		}
+	};
+
+	struct count_combine {
+		template<typename V>
+		constexpr void operator( )( std::size_t &acc, V const & ) const noexcept {
+			++acc;
+		}
+	};
+
+	template<typename Mode>
+	inline constexpr bool is_group_mode_v =
+	  std::is_same_v<Mode, hashed_t> or std::is_same_v<Mode, presorted_t> or
+	  std::is_same_v<Mode, parallel_t>;
+} // namespace daw::pipelines::pimpl
+
+namespace daw::pipelines {
+	/// Grouping mode for inputs where equal keys are adjacent, e.g. sorted by
+	/// key.  The stage returns a lazy single pass range of groups
+	inline constexpr auto PreSorted = pimpl::presorted_t{ };
+
+	/// Grouping mode that aggregates random access inputs on multiple threads.
+	/// Parallel( n ) selects the thread count
+	inline constexpr auto Parallel = pimpl::parallel_t{ };
+
+	/// Aggregate the values of each key.  Each group starts as init and values
+	/// are added with combine( acc, value ), which either returns the new
+	/// accumulator or returns void and updates acc in place.  The result is a
+	/// range of std::pair<Key, Acc> in order of the first appearance of a key
+	template<typename KeyFn, typename Init, typename Combine,
+	         typename Mode = pimpl::hashed_t>
+	requires( pimpl::is_group_mode_v<Mode> ) //
+	  [[nodiscard]] constexpr auto AggregateBy( KeyFn &&key_fn, Init &&init,
+	                                            Combine &&combine,
+	                                            Mode mode = Mode{ } ) {
+		return pimpl::AggregateBy_t<daw::remove_cvref_t<KeyFn>,
+		                            pimpl::init_value<daw::remove_cvref_t<Init>>,
+		                            daw::remove_cvref_t<Combine>, Mode>{
+		  DAW_FWD( key_fn ), { DAW_FWD( init ) }, DAW_FWD( combine ), mode };
+	}
+
+	/// Collect the values of each key into a std::vector.  The result is a
+	/// range of std::pair<Key, std::vector<Value>> in order of the first
+	/// appearance of a key
+	template<typename KeyFn, typename Mode = pimpl::hashed_t>
+	requires( pimpl::is_group_mode_v<Mode> ) //
+	  [[nodiscard]] constexpr auto GroupBy( KeyFn &&key_fn, Mode mode = Mode{ } ) {
+		return pimpl::AggregateBy_t<daw::remove_cvref_t<KeyFn>, pimpl::group_init,
+		                            pimpl::group_combine, Mode>{
+		  DAW_FWD( key_fn ), { }, { }, mode };
+	}
+
+	/// Count the values of each key.  The result is a range of
+	/// std::pair<Key, std::size_t> in order of the first appearance of a key
+	template<typename KeyFn = std::identity, typename Mode = pimpl::hashed_t>
+	requires( pimpl::is_group_mode_v<Mode> ) //
+	  [[nodiscard]] constexpr auto CountBy( KeyFn &&key_fn = KeyFn{ },
+	                                        Mode mode = Mode{ } ) {
+		return pimpl::AggregateBy_t<daw::remove_cvref_t<KeyFn>,
+		                            pimpl::init_value<std::size_t>,
+		                            pimpl::count_combine, Mode>{
+		  DAW_FWD( key_fn ), { 0 }, { }, mode };
+	}
+} // namespace daw::pipelines
@@ -70,6 +70,10 @@ namespace daw::pipelines {
 			return m_iter;
 		}
 
+		[[nodiscard]] constexpr Fn const &func( ) const {
+			return m_func;
+		}
+
 		[[nodiscard]] DAW_ATTRIB_INLINE constexpr value_type
 		operator[]( size_type n ) const requires( RandomIterator<Iterator> ) {
 			return std::invoke( m_func, raw_get( n ) );
@@ -10,23 +10,213 @@
 
 #include "daw/daw_cpp_feature_check.h"
 #include "daw/daw_cxmath.h"
+#include "daw/daw_ensure.h"
 #include "daw/daw_iterator_traits.h"
+#include "daw/daw_is_constant_evaluated.h"
 #include "daw/daw_move.h"
+#include "daw/daw_remove_cvref.h"
+#include "daw/daw_typeof.h"
+#include "daw/pipelines/chunked.h"
 
+#include <array>
 #include <cstddef>
+#include <functional>
 #include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
 
 namespace daw::pipelines {
 	namespace pimpl {
+		/// Independent accumulators for reductions over contiguous blocks.  They
+		/// break the dependency on a single sum so that adds overlap, and
+		/// fill a 256bit vector of doubles when the compiler vectorizes
+		inline constexpr std::size_t reduce_lanes = 8;
+
+		template<typename T>
+		inline constexpr bool is_lane_reducible_v =
+		  std::is_arithmetic_v<T> and not std::is_same_v<T, bool>;
+
+		template<typename T>
+		struct sum_lanes {
+			T lanes[reduce_lanes]{ };
+
+			DAW_ATTRIB_INLINE constexpr void add( T const &v ) {
+				lanes[0] = static_cast<T>( lanes[0] + v );
+			}
+
+			DAW_ATTRIB_INLINE constexpr void add_block( T const *p, std::size_t n ) {
+				auto const whole = n - n % reduce_lanes;
+				std::size_t i = 0;
+				for( ; i < whole; i += reduce_lanes ) {
+					for( std::size_t l = 0; l < reduce_lanes; ++l ) {
+						lanes[l] = static_cast<T>( lanes[l] + p[i + l] );
+					}
+				}
+				for( ; i < n; ++i ) {
+					add( p[i] );
+				}
+			}
+
+			template<typename A, typename B>
+			DAW_ATTRIB_INLINE constexpr void add_products( A const *a, B const *b,
+			                                               std::size_t n ) {
+				auto const whole = n - n % reduce_lanes;
+				std::size_t i = 0;
+				for( ; i < whole; i += reduce_lanes ) {
+					for( std::size_t l = 0; l < reduce_lanes; ++l ) {
+						lanes[l] = static_cast<T>( lanes[l] + a[i + l] * b[i + l] );
+					}
+				}
+				for( ; i < n; ++i ) {
+					add( static_cast<T>( a[i] * b[i] ) );
+				}
+			}
+
+			/// Combines the lanes pairwise
+			[[nodiscard]] constexpr T result( ) const {
+				T tmp[reduce_lanes]{ };
+				for( std::size_t l = 0; l < reduce_lanes; ++l ) {
+					tmp[l] = lanes[l];
+				}
+				for( std::size_t w = reduce_lanes / 2U; w > 0; w /= 2U ) {
+					for( std::size_t l = 0; l < w; ++l ) {
+						tmp[l] = static_cast<T>( tmp[l] + tmp[l + w] );
+					}
+				}
+				return tmp[0];
+			}
+		};
+
+		/// Kahan Babushka Neumaier summation in reduce_lanes independent lanes.
+		/// Each lane is a compensated sum with the error bound of the serial
+		/// algorithm
+		template<typename T>
+		struct neumaier_lanes {
+			T sums[reduce_lanes]{ };
+			T comps[reduce_lanes]{ };
+
+			/// Adds the exact rounding error of sum + x to comp.  This is Knuth's
+			/// TwoSum, it finds the same error as Neumaier's magnitude test without
+			/// a branch so that the lanes vectorize
+			DAW_ATTRIB_INLINE static constexpr void step( T &sum, T &comp, T x ) {
+				auto const t = sum + x;
+				auto const z = t - sum;
+				comp += ( sum - ( t - z ) ) + ( x - z );
+				sum = t;
+			}
+
+			DAW_ATTRIB_INLINE constexpr void add( T x ) {
+				step( sums[0], comps[0], x );
+			}
+
+			DAW_ATTRIB_INLINE constexpr void add_block( T const *p, std::size_t n ) {
+				auto const whole = n - n % reduce_lanes;
+				// Local copies keep the lanes in registers
+				T s[reduce_lanes];
+				T c[reduce_lanes];
+				for( std::size_t l = 0; l < reduce_lanes; ++l ) {
+					s[l] = sums[l];
+					c[l] = comps[l];
+				}
+				std::size_t i = 0;
+				for( ; i < whole; i += reduce_lanes ) {
+					for( std::size_t l = 0; l < reduce_lanes; ++l ) {
+						step( s[l], c[l], p[i + l] );
+					}
+				}
+				for( std::size_t l = 0; l < reduce_lanes; ++l ) {
+					sums[l] = s[l];
+					comps[l] = c[l];
+				}
+				for( ; i < n; ++i ) {
+					add( p[i] );
+				}
+			}
+
+			/// The lane sums and compensations are added exactly as a list of non
+			/// overlapping partial sums, then rounded once.  Lanes can hold large
+			/// compensations that cancel each other, adding them with another
+			/// compensated sum could still lose the small terms
+			[[nodiscard]] constexpr T result( ) const {
+				T partials[2U * reduce_lanes]{ };
+				std::size_t count = 0;
+				auto const add = [&]( T x ) {
+					std::size_t out = 0;
+					for( std::size_t n = 0; n < count; ++n ) {
+						auto y = partials[n];
+						if( daw::cxmath::abs( x ) < daw::cxmath::abs( y ) ) {
+							std::swap( x, y );
+						}
+						auto const hi = x + y;
+						auto const lo = y - ( hi - x );
+						if( lo != T{ 0 } ) {
+							partials[out++] = lo;
+						}
+						x = hi;
+					}
+					partials[out++] = x;
+					count = out;
+				};
+				for( std::size_t l = 0; l < reduce_lanes; ++l ) {
+					add( sums[l] );
+					add( comps[l] );
+				}
+				auto result = T{ 0 };
+				while( count > 0 ) {
+					result += partials[--count];
+				}
+				return result;
+			}
+		};
+
+		/// Feed r to acc, whole blocks at a time where the range allows it
+		template<typename Acc, typename R>
+		DAW_ATTRIB_INLINE constexpr void accumulate_lanes( Acc &acc, R &&r ) {
+			if constexpr( ChunkedRange<R> ) {
+				DAW_IF_NOT_CONSTEVAL {
+					for_each_chunk( r, [&]( auto const &c ) {
+						if( c.sel ) {
+							c.for_each( [&]( auto const &v, std::size_t ) {
+								acc.add( v );
+							} );
+						} else {
+							acc.add_block( c.data, c.size );
+						}
+					} );
+					return;
+				}
+			}
+			for( auto const &v : r ) {
+				acc.add( v );
+			}
+		}
+
 		struct sum_t {
 			[[nodiscard]] DAW_CPP23_STATIC_CALL_OP constexpr auto
 			operator( )( Range auto &&r ) DAW_CPP23_STATIC_CALL_OP_CONST {
 				using value_type = daw::iter_value_t<decltype( std::begin( r ) )>;
-				auto sum = value_type{ };
-				for( auto const &v : r ) {
-					sum = sum + v;
+				if constexpr( is_lane_reducible_v<value_type> ) {
+					auto acc = sum_lanes<value_type>{ };
+					accumulate_lanes( acc, r );
+					return acc.result( );
+				} else {
+					auto sum = value_type{ };
+					if constexpr( ChunkedRange<decltype( r )> ) {
+						DAW_IF_NOT_CONSTEVAL {
+							for_each_chunk( r, [&]( auto const &c ) {
+								c.for_each( [&]( auto const &v, std::size_t ) {
+									sum = sum + v;
+								} );
+							} );
+							return sum;
+						}
+					}
+					for( auto const &v : r ) {
+						sum = sum + v;
+					}
+					return sum;
 				}
-				return sum;
 			}
 		};
 
@@ -38,6 +228,16 @@ namespace daw::pipelines {
 					return 1;
 				} else if constexpr( requires { r.size( ); } ) {
 					return r.size( );
+				} else if constexpr( ChunkedView<R const &> ) {
+					DAW_IF_NOT_CONSTEVAL {
+						std::size_t result = 0;
+						for_each_chunk( r, [&]( auto const &c ) {
+							result += c.size;
+						} );
+						return result;
+					}
+					return static_cast<std::size_t>(
+					  std::distance( std::begin( r ), std::end( r ) ) );
 				} else {
 					return static_cast<std::size_t>(
 					  std::distance( std::begin( r ), std::end( r ) ) );
@@ -52,6 +252,16 @@ namespace daw::pipelines {
 			[[nodiscard]] constexpr std::size_t
 			operator( )( Range auto const &r ) const {
 				std::size_t result = 0;
+				if constexpr( ChunkedRange<decltype( r )> ) {
+					DAW_IF_NOT_CONSTEVAL {
+						for_each_chunk( r, [&]( auto const &c ) {
+							c.for_each( [&]( auto const &v, std::size_t ) {
+								result += static_cast<std::size_t>( fn( v ) );
+							} );
+						} );
+						return result;
+					}
+				}
 				for( auto const &v : r ) {
 					result += static_cast<std::size_t>( fn( v ) );
 				}
@@ -83,29 +293,20 @@ namespace daw::pipelines {
 
 			template<Range R>
 			[[nodiscard]] constexpr auto operator( )( R &&r ) const {
-				using fp_t = range_value_t<R>;
+				using fp_t = daw::remove_cvref_t<
+				  std::invoke_result_t<Projection const &, range_reference_t<R>>>;
 				static_assert( std::is_floating_point_v<fp_t>,
 				               "Use of Kahan Babushka Neumaier summation requires the "
 				               "range value type to be a floating point type" );
-				auto sum = fp_t{ 0.0 };
-				auto c = fp_t{ 0.0 };
-				for( auto &&cur_v : r ) {
-					fp_t input = [&] {
-						if constexpr( std::is_same_v<Projection, IdentityFn_t> ) {
-							return cur_v;
-						} else {
-							return std::invoke( cur_v, m_projection );
-						}
-					}( );
-					auto t = sum + input;
-					if( daw::cxmath::abs( sum ) >= daw::cxmath::abs( input ) ) {
-						c += ( sum - t ) + input;
-					} else {
-						c += ( input - t ) + sum;
+				auto acc = neumaier_lanes<fp_t>{ };
+				if constexpr( std::is_same_v<Projection, IdentityFn_t> ) {
+					accumulate_lanes( acc, r );
+				} else {
+					for( auto &&cur_v : r ) {
+						acc.add( std::invoke( m_projection, cur_v ) );
 					}
-					sum = t;
 				}
-				return sum + c;
+				return acc.result( );
 			}
 		};
 		SumKahanBabushkaNeumaier_t( ) -> SumKahanBabushkaNeumaier_t<>;
@@ -113,6 +314,115 @@ namespace daw::pipelines {
 		template<typename Projection>
 		SumKahanBabushkaNeumaier_t( Projection )
 		  -> SumKahanBabushkaNeumaier_t<Projection>;
+
+		/// The pointer to the elements of a contiguous range, nullptr otherwise
+		template<typename R>
+		[[nodiscard]] constexpr auto contiguous_data( R &&r ) {
+			using iter_t = iterator_t<R>;
+			if constexpr( ContiguousSource<iter_t> and
+			              std::is_same_v<iter_t, iterator_end_t<R>> ) {
+				return std::to_address( std::begin( r ) );
+			} else {
+				return nullptr;
+			}
+		}
+
+		template<typename First, typename Last>
+		struct Dot_t {
+			First m_first;
+			Last m_last;
+
+			template<Range R>
+			[[nodiscard]] constexpr auto operator( )( R &&r ) const {
+				using lhs_t = range_value_t<R>;
+				using rhs_t = daw::iter_value_t<First>;
+				using result_t = DAW_TYPEOF( std::declval<lhs_t const &>( ) *
+				                             std::declval<rhs_t const &>( ) );
+				auto const lhs = contiguous_data( r );
+				if constexpr( not std::is_null_pointer_v<DAW_TYPEOF( lhs )> and
+				              ContiguousSource<First> and
+				              std::is_same_v<First, Last> and
+				              is_lane_reducible_v<result_t> ) {
+					DAW_IF_NOT_CONSTEVAL {
+						auto const size = static_cast<std::size_t>(
+						  std::distance( std::begin( r ), std::end( r ) ) );
+						daw_ensure( size == static_cast<std::size_t>(
+						                      std::distance( m_first, m_last ) ) );
+						auto acc = sum_lanes<result_t>{ };
+						acc.add_products( lhs, std::to_address( m_first ), size );
+						return acc.result( );
+					}
+				}
+				auto sum = result_t{ };
+				auto it = m_first;
+				for( auto const &v : r ) {
+					daw_ensure( it != m_last );
+					sum = static_cast<result_t>( sum + v * *it );
+					++it;
+				}
+				daw_ensure( it == m_last );
+				return sum;
+			}
+		};
+
+		template<typename MapFn, typename ReduceFn, typename T>
+		struct MapReduce_t {
+			DAW_NO_UNIQUE_ADDRESS MapFn m_map;
+			DAW_NO_UNIQUE_ADDRESS ReduceFn m_reduce;
+			T m_init;
+
+			template<Range R>
+			[[nodiscard]] constexpr T operator( )( R &&r ) const {
+				auto result = m_init;
+				auto const p = contiguous_data( r );
+				if constexpr( not std::is_null_pointer_v<DAW_TYPEOF( p )> ) {
+					DAW_IF_NOT_CONSTEVAL {
+						// Independent partial results, each lane starts from a mapped
+						// value so no identity element is needed
+						auto const size = static_cast<std::size_t>(
+						  std::distance( std::begin( r ), std::end( r ) ) );
+						if( size >= reduce_lanes ) {
+							auto lanes = [&]<std::size_t... Is>( std::index_sequence<Is...> ) {
+								return std::array<T, reduce_lanes>{
+								  static_cast<T>( std::invoke( m_map, p[Is] ) )... };
+							}( std::make_index_sequence<reduce_lanes>{ } );
+							std::size_t i = reduce_lanes;
+							for( ; i + reduce_lanes <= size; i += reduce_lanes ) {
+								for( std::size_t l = 0; l < reduce_lanes; ++l ) {
+									lanes[l] = std::invoke( m_reduce, std::move( lanes[l] ),
+									                        std::invoke( m_map, p[i + l] ) );
+								}
+							}
+							for( auto &lane : lanes ) {
+								result = std::invoke( m_reduce, std::move( result ),
+								                      std::move( lane ) );
+							}
+							for( ; i < size; ++i ) {
+								result = std::invoke( m_reduce, std::move( result ),
+								                      std::invoke( m_map, p[i] ) );
+							}
+							return result;
+						}
+					}
+				}
+				if constexpr( ChunkedView<R> ) {
+					DAW_IF_NOT_CONSTEVAL {
+						for_each_chunk( r, [&]( auto const &c ) {
+							c.for_each( [&]( auto const &v, std::size_t ) {
+								result = std::invoke( m_reduce, std::move( result ),
+								                      std::invoke( m_map, v ) );
+							} );
+						} );
+						return result;
+					}
+				}
+				for( auto const &v : r ) {
+					result = std::invoke( m_reduce, std::move( result ),
+					                      std::invoke( m_map, v ) );
+				}
+				return result;
+			}
+		};
 	} // namespace pimpl
 
 	inline constexpr auto Count = pimpl::count_t{ };
@@ -124,4 +434,23 @@ namespace daw::pipelines {
 		return pimpl::CountIf_t{ DAW_FWD( fn ) };
 	};
 
+	/// The sum of the products of the range and other, which must have the
+	/// same size and outlive the pipeline.  Contiguous arithmetic ranges are
+	/// reduced with independent accumulators
+	template<Range R>
+	[[nodiscard]] constexpr auto Dot( R const &other ) {
+		return pimpl::Dot_t<iterator_t<R const &>, iterator_end_t<R const &>>{
+		  std::begin( other ), std::end( other ) };
+	}
+
+	/// Fuses a Map and a reduction, result = reduce( result, map( v ) ) for
+	/// each value starting from init.  reduce must be associative and
+	/// commutative, like addition, min or max, as contiguous ranges are
+	/// reduced in independent lanes that are combined at the end
+	template<typename MapFn, typename ReduceFn, typename T>
+	[[nodiscard]] constexpr auto MapReduce( MapFn map_fn, ReduceFn reduce_fn,
+	                                        T init ) {
+		return pimpl::MapReduce_t<MapFn, ReduceFn, T>{
+		  std::move( map_fn ), std::move( reduce_fn ), std::move( init ) };
+	}
 } // namespace daw::pipelines
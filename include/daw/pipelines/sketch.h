@@ -0,0 +1,101 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/daw_attributes.h"
+#include "daw/daw_hyperloglog.h"
+#include "daw/daw_iterator_traits.h"
+#include "daw/daw_move.h"
+#include "daw/daw_tdigest.h"
+#include "daw/daw_top_k.h"
+#include "daw/pipelines/chunked.h"
+#include "daw/pipelines/range.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace daw::pipelines {
+	namespace pimpl {
+		/// Feed every value of r to sketch, using the chunked protocol when the
+		/// range supports it
+		template<typename R, typename Sketch>
+		constexpr void fill_sketch( R &&r, Sketch &sketch ) {
+			if constexpr( ChunkedView<R> ) {
+				for_each_chunk( r, [&]( auto const &c ) {
+					c.for_each( [&]( auto const &v, std::size_t ) {
+						sketch.insert( v );
+					} );
+				} );
+			} else {
+				for( auto const &v : r ) {
+					sketch.insert( v );
+				}
+			}
+		}
+
+		template<typename Compare>
+		struct TopK_t {
+			std::size_t m_k;
+			DAW_NO_UNIQUE_ADDRESS Compare m_comp;
+
+			template<Range R>
+			[[nodiscard]] constexpr auto operator( )( R &&r ) const {
+				auto result =
+				  daw::top_k<daw::range_value_t<R>, Compare>( m_k, m_comp );
+				fill_sketch( r, result );
+				return result;
+			}
+		};
+
+		struct Quantiles_t {
+			double m_compression;
+
+			template<Range R>
+			[[nodiscard]] daw::tdigest operator( )( R &&r ) const {
+				auto result = daw::tdigest( m_compression );
+				fill_sketch( r, result );
+				return result;
+			}
+		};
+
+		template<typename Hash>
+		struct CountDistinct_t {
+			std::uint32_t m_precision;
+			DAW_NO_UNIQUE_ADDRESS Hash m_hash;
+
+			template<Range R>
+			[[nodiscard]] daw::hyperloglog<Hash> operator( )( R &&r ) const {
+				auto result = daw::hyperloglog<Hash>( m_precision, m_hash );
+				fill_sketch( r, result );
+				return result;
+			}
+		};
+	} // namespace pimpl
+
+	/// @brief Sink that keeps the k greatest values under comp in a daw::top_k
+	template<typename Compare = std::less<>>
+	[[nodiscard]] constexpr auto TopK( std::size_t k, Compare comp = Compare{ } ) {
+		return pimpl::TopK_t<Compare>{ k, std::move( comp ) };
+	}
+
+	/// @brief Sink that summarizes the values in a daw::tdigest for quantile
+	/// queries such as p99
+	[[nodiscard]] constexpr auto Quantiles( double compression = 100.0 ) {
+		return pimpl::Quantiles_t{ compression };
+	}
+
+	/// @brief Sink that estimates the number of distinct values with a
+	/// daw::hyperloglog
+	template<typename Hash = daw::filter_hash>
+	[[nodiscard]] constexpr auto CountDistinct( std::uint32_t precision = 14,
+	                                            Hash hasher = Hash{ } ) {
+		return pimpl::CountDistinct_t<Hash>{ precision, std::move( hasher ) };
+	}
+} // namespace daw::pipelines
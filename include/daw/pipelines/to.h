@@ -8,7 +8,10 @@
 
 #pragma once
 
+#include "daw/daw_is_constant_evaluated.h"
 #include "daw/daw_move.h"
+#include "daw/pipelines/chunked.h"
+#include "daw/pipelines/maybe.h"
 #include "range.h"
 
 #include <iterator>
@@ -23,6 +26,35 @@ namespace daw::pipelines::pimpl {
 	// used for other purposes
 	struct UseTypeDefault {};
 
+	template<typename Container, typename R>
+	concept ChunkedToContainer =
+	  ChunkedView<R> and std::default_initializable<Container> and
+	  requires( Container c, typename chunk_source_t<R>::value_type const &v ) {
+		  c.push_back( v );
+	  };
+
+	/// Build the container a chunk at a time, dense chunks are appended with a
+	/// single range insert when the container supports it
+	template<typename Container, ChunkedView R>
+	[[nodiscard]] constexpr Container to_container_chunked( R &&r ) {
+		using value_type = typename chunk_source_t<R>::value_type;
+		auto result = Container( );
+		for_each_chunk( r, [&]( auto const &c ) {
+			if constexpr( requires {
+				              result.insert( result.end( ), c.data, c.data );
+			              } ) {
+				if( c.sel == nullptr ) {
+					result.insert( result.end( ), c.data, c.data + c.size );
+					return;
+				}
+			}
+			c.for_each( [&]( value_type const &v, std::size_t ) {
+				result.push_back( v );
+			} );
+		} );
+		return result;
+	}
+
 	template<template<typename...> typename Container>
 	struct ToTemplateTemplateContainer {
 		template<Range R>
@@ -32,6 +64,12 @@ namespace daw::pipelines::pimpl {
 			  requires( iterator_t<R> it ) { Container( it, it ); },
 			  "To requires the container to be constructible from an iterator "
 			  "pair" );
+			using container_t = decltype( Container( std::begin( r ), std::end( r ) ) );
+			if constexpr( ChunkedToContainer<container_t, R> ) {
+				DAW_IF_NOT_CONSTEVAL {
+					return to_container_chunked<container_t>( r );
+				}
+			}
 			return Container( std::begin( DAW_FWD( r ) ), std::end( DAW_FWD( r ) ) );
 		}
 
@@ -46,6 +84,11 @@ namespace daw::pipelines::pimpl {
 		template<Range R>
 		[[nodiscard]] DAW_ATTRIB_NOINLINE DAW_CPP23_STATIC_CALL_OP constexpr auto
 		operator( )( R &&r ) DAW_CPP23_STATIC_CALL_OP_CONST {
+			if constexpr( ChunkedToContainer<Container, R> ) {
+				DAW_IF_NOT_CONSTEVAL {
+					return to_container_chunked<Container>( r );
+				}
+			}
 #if defined( __cpp_lib_containers_ranges )
 #if __cpp_lib_containers_ranges >= 202202L
 			if constexpr( requires { Container( std::from_range, DAW_FWD( r ) ); } ) {
@@ -0,0 +1,39 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/daw_string_view.h"
+#include "daw/daw_utf8.h"
+#include "daw/pipelines/filter.h"
+#include "daw/pipelines/range.h"
+
+#include <iterator>
+
+namespace daw::pipelines {
+	namespace pimpl {
+		struct is_valid_utf8_t {
+			template<typename String>
+			[[nodiscard]] constexpr bool operator( )( String const &s ) const {
+				return daw::is_valid_utf8( daw::string_view( s ) );
+			}
+		};
+
+		struct Utf8Validate_t {
+			template<Range R>
+			[[nodiscard]] constexpr auto operator( )( R &&r ) const {
+				return filter_view<iterator_t<R>, is_valid_utf8_t>(
+				  std::begin( r ), std::end( r ), is_valid_utf8_t{ } );
+			}
+		};
+	} // namespace pimpl
+
+	/// @brief Keep the elements of a range of strings that are well formed
+	/// UTF-8, see daw::is_valid_utf8
+	inline constexpr auto Utf8Validate = pimpl::Utf8Validate_t{ };
+} // namespace daw::pipelines
@@ -0,0 +1,33 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include <daw/stdinc/declval.h>
+#include <daw/stdinc/void_t.h>
+
+#include <cstddef>
+#include <type_traits>
+
+namespace daw::traits {
+	/// A span_writer like type whose data( ) points at the writable space
+	/// left, size( ) is its length, and remove_prefix( n ) consumes n elements
+	/// of it.  Arrays and read only views such as std::string_view are not
+	template<typename, typename = void>
+	inline constexpr bool is_span_writer_v = false;
+
+	template<typename T>
+	inline constexpr bool is_span_writer_v<
+	  T,
+	  std::void_t<decltype( *std::declval<T &>( ).data( ) ),
+	              decltype( std::declval<T &>( ).size( ) ),
+	              decltype( std::declval<T &>( ).remove_prefix(
+	                std::declval<std::size_t>( ) ) )>> =
+	  not std::is_const_v<
+	    std::remove_reference_t<decltype( *std::declval<T &>( ).data( ) )>>;
+} // namespace daw::traits
@@ -12,6 +12,7 @@
 #include "daw_likely.h"
 #include "daw_move.h"
 #include "daw_scope_guard.h"
+#include "impl/daw_container_help_impl.h"
 #include "split_buffer.h"
 #include "wrap_iter.h"
 
@@ -303,6 +304,17 @@ namespace daw {
 			x.endcap( ) = nullptr;
 		}
 
+		/// @brief Adopt a buffer released by another container, no elements are
+		/// copied
+		explicit constexpr vector( container_data<T, Allocator> &&buff )
+		  : m_endcap_( nullptr, buff.get_allocator( ) ) {
+			auto const sz = static_cast<difference_type>( buff.size( ) );
+			auto const cap = static_cast<difference_type>( buff.capacity( ) );
+			m_begin = buff.release( );
+			m_end = m_begin + sz;
+			endcap( ) = m_begin + cap;
+		}
+
 		explicit constexpr vector( vector &&x,
 		                           std::type_identity_t<allocator_type> const &a )
 		  : m_endcap_( nullptr, a ) {
@@ -664,10 +676,9 @@ namespace daw {
 				if( p == m_end ) {
 					construct_one_at_end( DAW_FWD( args )... );
 				} else {
-					auto tmp =
-					  temp_value<value_type, Allocator>( alloc( ), DAW_FWD( args )... );
+					auto tmp = value_type( DAW_FWD( args )... );
 					move_range( p, m_end, p + 1 );
-					*p = std::move( tmp.get( ) );
+					*p = std::move( tmp );
 				}
 			} else {
 				allocator_type &a = alloc( );
@@ -797,7 +808,7 @@ namespace daw {
 			return r;
 		}
 
-		iterator erase( const_iterator first, const_iterator last ) {
+		constexpr iterator erase( const_iterator first, const_iterator last ) {
 			pointer p = m_begin + ( first - begin( ) );
 			if( first != last ) {
 				destruct_at_end( std::move( p + ( last - first ), m_end, p ) );
@@ -923,6 +934,15 @@ namespace daw {
 			return result;
 		}
 
+		/// @brief Give up the allocation without copying the elements, leaving
+		/// the vector empty
+		[[nodiscard]] constexpr container_data<T, Allocator> release_buffer( ) {
+			auto result =
+			  container_data<T, Allocator>( m_begin, alloc( ), size( ), capacity( ) );
+			m_begin = m_end = endcap( ) = nullptr;
+			return result;
+		}
+
 		constexpr void swap( vector &other ) noexcept {
 			std::swap( m_begin, other.m_begin );
 			std::swap( m_end, other.m_end );
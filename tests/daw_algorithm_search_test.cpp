@@ -0,0 +1,248 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include <daw/algorithms/daw_algorithm_search.h>
+#include <daw/daw_algorithm.h>
+
+#include <daw/daw_benchmark.h>
+#include <daw/daw_ensure.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined( __unix__ )
+#include <unistd.h>
+#endif
+
+namespace {
+	std::vector<std::uint32_t> random_values( std::size_t count,
+	                                          std::uint32_t hi,
+	                                          std::uint64_t seed ) {
+		auto engine = std::mt19937_64( seed );
+		auto dist = std::uniform_int_distribution<std::uint32_t>( 0, hi );
+		auto result = std::vector<std::uint32_t>( count );
+		for( auto &v : result ) {
+			v = dist( engine );
+		}
+		return result;
+	}
+
+	constexpr bool constexpr_test( ) {
+		int const a[] = { 1, 3, 3, 5, 7, 9 };
+		auto const lb = daw::algorithm::branchless_lower_bound( a, a + 6, 3 );
+		auto const ub = daw::algorithm::branchless_upper_bound( a, a + 6, 3 );
+		int e[6]{ };
+		(void)daw::algorithm::eytzinger_layout( a, a + 6, e );
+		return lb == a + 1 and ub == a + 3 and
+		       daw::algorithm::lower_bound( a, a + 6, 6 ) == a + 4 and
+		       e[0] == 5 and e[1] == 3 and e[2] == 9;
+	}
+	static_assert( constexpr_test( ) );
+
+	void bounds_test( ) {
+		for( std::size_t n = 0; n < 300; ++n ) {
+			// Small values force duplicates
+			auto v = random_values( n, static_cast<std::uint32_t>( n / 2U + 1U ),
+			                        n );
+			std::sort( v.begin( ), v.end( ) );
+			auto const hi = static_cast<std::uint32_t>( n / 2U + 2U );
+			for( std::uint32_t key = 0; key <= hi; ++key ) {
+				daw_ensure( daw::algorithm::branchless_lower_bound(
+				              v.begin( ), v.end( ), key ) ==
+				            std::lower_bound( v.begin( ), v.end( ), key ) );
+				daw_ensure( daw::algorithm::branchless_upper_bound(
+				              v.begin( ), v.end( ), key ) ==
+				            std::upper_bound( v.begin( ), v.end( ), key ) );
+				daw_ensure( daw::algorithm::lower_bound( v.begin( ), v.end( ), key ) ==
+				            std::lower_bound( v.begin( ), v.end( ), key ) );
+				daw_ensure( daw::algorithm::upper_bound( v.begin( ), v.end( ), key ) ==
+				            std::upper_bound( v.begin( ), v.end( ), key ) );
+			}
+		}
+		// Descending order through the comparator, and past the prefetch size
+		auto v = random_values( 100'000, 1'000'000, 7 );
+		std::sort( v.begin( ), v.end( ), std::greater<>{ } );
+		for( auto key : random_values( 10'000, 1'000'001, 8 ) ) {
+			daw_ensure(
+			  daw::algorithm::branchless_lower_bound( v.begin( ), v.end( ), key,
+			                                          std::greater<>{ } ) ==
+			  std::lower_bound( v.begin( ), v.end( ), key, std::greater<>{ } ) );
+		}
+	}
+
+	void lower_bound_many_test( ) {
+		for( std::size_t n : { 0U, 1U, 2U, 17U, 1'000U, 50'000U } ) {
+			auto v = random_values( n, 100'000, n );
+			std::sort( v.begin( ), v.end( ) );
+			// Not a multiple of the group size
+			auto const keys = random_values( 1'003, 100'001, n + 1U );
+			auto result = std::vector<std::vector<std::uint32_t>::const_iterator>(
+			  keys.size( ) );
+			auto const last = daw::algorithm::lower_bound_many(
+			  v.cbegin( ), v.cend( ), keys.begin( ), keys.end( ), result.begin( ) );
+			daw_ensure( last == result.end( ) );
+			for( std::size_t i = 0; i < keys.size( ); ++i ) {
+				daw_ensure( result[i] ==
+				            std::lower_bound( v.cbegin( ), v.cend( ), keys[i] ) );
+			}
+		}
+	}
+
+	void eytzinger_test( ) {
+		for( std::size_t n = 0; n < 300; ++n ) {
+			auto v = random_values( n, static_cast<std::uint32_t>( n * 2U ), n );
+			std::sort( v.begin( ), v.end( ) );
+			auto const idx = daw::eytzinger_index<std::uint32_t>( v.begin( ),
+			                                                      v.end( ) );
+			daw_ensure( idx.size( ) == n );
+			auto const hi = static_cast<std::uint32_t>( n * 2U + 1U );
+			auto keys = std::vector<std::uint32_t>( );
+			for( std::uint32_t key = 0; key <= hi; ++key ) {
+				keys.push_back( key );
+				auto const pos = idx.lower_bound( key );
+				auto const it = std::lower_bound( v.begin( ), v.end( ), key );
+				if( it == v.end( ) ) {
+					daw_ensure( pos == idx.size( ) );
+				} else {
+					daw_ensure( pos < idx.size( ) and idx[pos] == *it );
+				}
+				daw_ensure( idx.contains( key ) ==
+				            std::binary_search( v.begin( ), v.end( ), key ) );
+			}
+			auto many = std::vector<std::size_t>( keys.size( ) );
+			(void)idx.lower_bound_many( keys.begin( ), keys.end( ), many.begin( ) );
+			for( std::size_t i = 0; i < keys.size( ); ++i ) {
+				daw_ensure( many[i] == idx.lower_bound( keys[i] ) );
+			}
+		}
+		// A payload laid out the same way is found at the returned position
+		auto const keys = std::vector<int>{ 2, 4, 6, 8, 10 };
+		auto const names =
+		  std::vector<std::string>{ "two", "four", "six", "eight", "ten" };
+		auto laid_out = std::vector<std::string>( names.size( ) );
+		(void)daw::algorithm::eytzinger_layout( names.begin( ), names.end( ),
+		                                        laid_out.begin( ) );
+		auto const idx = daw::eytzinger_index<int>( keys.begin( ), keys.end( ) );
+		daw_ensure( laid_out[idx.lower_bound( 7 )] == "eight" );
+		daw_ensure( idx.lower_bound( 11 ) == idx.size( ) );
+	}
+
+	std::size_t llc_size( ) {
+#if defined( __unix__ ) and defined( _SC_LEVEL3_CACHE_SIZE )
+		auto const l3 = sysconf( _SC_LEVEL3_CACHE_SIZE );
+		if( l3 > 0 ) {
+			return static_cast<std::size_t>( l3 );
+		}
+#endif
+		return 32U * 1024U * 1024U;
+	}
+
+	void search_bench( ) {
+		constexpr std::size_t lookups = 500'000;
+		// From L1 sized to 4x the last level cache, capped to keep the run and
+		// its memory use bounded on machines with very large caches
+		constexpr std::size_t cap = 256U * 1024U * 1024U;
+		auto const big = std::min( 4U * llc_size( ), cap );
+		for( std::size_t bytes :
+		     { std::size_t{ 16U * 1024U }, std::size_t{ 1024U * 1024U },
+		       std::size_t{ 16U * 1024U * 1024U }, big } ) {
+			auto const n = bytes / sizeof( std::uint32_t );
+			std::cout << "---- " << n << " elements, " << bytes / 1024U
+			          << " KiB ----\n";
+			auto v = std::vector<std::uint32_t>( n );
+			for( std::size_t i = 0; i < n; ++i ) {
+				v[i] = static_cast<std::uint32_t>( i * 3U );
+			}
+			auto const hi = static_cast<std::uint32_t>( n * 3U );
+			auto const keys = random_values( lookups, hi, n );
+			auto positions =
+			  std::vector<std::vector<std::uint32_t>::const_iterator>( lookups );
+
+			auto sum_of = [&]( auto const &find ) {
+				std::uint64_t sum = 0;
+				for( auto key : keys ) {
+					sum += find( key );
+				}
+				daw::do_not_optimize( sum );
+				return sum;
+			};
+			auto const expected = sum_of( [&]( std::uint32_t key ) {
+				return static_cast<std::uint64_t>(
+				  std::lower_bound( v.cbegin( ), v.cend( ), key ) - v.cbegin( ) );
+			} );
+			(void)daw::bench_n_test<3>( "std::lower_bound", [&] {
+				daw_ensure( sum_of( [&]( std::uint32_t key ) {
+					            return static_cast<std::uint64_t>(
+					              std::lower_bound( v.cbegin( ), v.cend( ), key ) -
+					              v.cbegin( ) );
+				            } ) == expected );
+			} );
+			(void)daw::bench_n_test<3>( "branchless_lower_bound", [&] {
+				daw_ensure( sum_of( [&]( std::uint32_t key ) {
+					            return static_cast<std::uint64_t>(
+					              daw::algorithm::branchless_lower_bound(
+					                v.cbegin( ), v.cend( ), key ) -
+					              v.cbegin( ) );
+				            } ) == expected );
+			} );
+			(void)daw::bench_n_test<3>( "lower_bound_many", [&] {
+				(void)daw::algorithm::lower_bound_many( v.cbegin( ), v.cend( ),
+				                                        keys.begin( ), keys.end( ),
+				                                        positions.begin( ) );
+				std::uint64_t sum = 0;
+				for( auto it : positions ) {
+					sum += static_cast<std::uint64_t>( it - v.cbegin( ) );
+				}
+				daw_ensure( sum == expected );
+			} );
+
+			// Each key has a single match, so summing the found values checks
+			// the positions
+			auto const value_sum = sum_of( [&]( std::uint32_t key ) {
+				auto const it = std::lower_bound( v.cbegin( ), v.cend( ), key );
+				return it == v.cend( ) ? std::uint64_t{ 0 }
+				                       : std::uint64_t{ *it };
+			} );
+			auto const idx =
+			  daw::eytzinger_index<std::uint32_t>( v.begin( ), v.end( ) );
+			auto value_at = [&]( std::size_t pos ) {
+				return pos == idx.size( ) ? std::uint64_t{ 0 }
+				                          : std::uint64_t{ idx[pos] };
+			};
+			(void)daw::bench_n_test<3>( "eytzinger_index", [&] {
+				daw_ensure( sum_of( [&]( std::uint32_t key ) {
+					            return value_at( idx.lower_bound( key ) );
+				            } ) == value_sum );
+			} );
+			auto eytzinger_positions = std::vector<std::size_t>( lookups );
+			(void)daw::bench_n_test<3>( "eytzinger_index lower_bound_many", [&] {
+				(void)idx.lower_bound_many( keys.begin( ), keys.end( ),
+				                            eytzinger_positions.begin( ) );
+				std::uint64_t sum = 0;
+				for( auto pos : eytzinger_positions ) {
+					sum += value_at( pos );
+				}
+				daw_ensure( sum == value_sum );
+			} );
+		}
+	}
+} // namespace
+
+int main( ) {
+	bounds_test( );
+	lower_bound_many_test( );
+	eytzinger_test( );
+	search_bench( );
+	std::cout << "done\n";
+}
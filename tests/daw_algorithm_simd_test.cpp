@@ -0,0 +1,257 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include <daw/daw_algorithm.h>
+
+#include <daw/daw_benchmark.h>
+#include <daw/daw_ensure.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+	constexpr bool constexpr_test( ) {
+		int const a[] = { 1, 3, 5, 7, 9, 11 };
+		int const b[] = { 1, 3, 5, 8, 9, 11 };
+		auto const m = daw::algorithm::mismatch( a, a + 6, b );
+		return daw::algorithm::find( a, a + 6, 7 ) == a + 3 and
+		       daw::algorithm::count( a, a + 6, 9 ) == 1 and m.first == a + 3 and
+		       m.second == b + 3 and not daw::algorithm::equal( a, a + 6, b ) and
+		       daw::algorithm::lexicographical_compare( a, a + 6, b, b + 6 ) and
+		       daw::algorithm::compare_range( b, b + 6, a, a + 6 ) > 0 and
+		       *daw::algorithm::min_element( a, a + 6 ) == 1 and
+		       *daw::algorithm::max_element( a, a + 6 ) == 11;
+	}
+	static_assert( constexpr_test( ) );
+
+	template<typename T>
+	std::vector<T> random_values( std::size_t count, std::uint64_t seed ) {
+		auto engine = std::mt19937_64( seed );
+		// A small range makes matches and duplicates likely
+		auto dist = std::uniform_int_distribution<int>( 0, 15 );
+		auto result = std::vector<T>( count );
+		for( auto &v : result ) {
+			v = static_cast<T>( dist( engine ) );
+		}
+		return result;
+	}
+
+	template<typename T>
+	void check( std::vector<T> const &v, std::vector<T> const &w ) {
+		auto const *const first = v.data( );
+		auto const *const last = first + v.size( );
+		auto const *const first2 = w.data( );
+		auto const *const last2 = first2 + w.size( );
+		for( int n = -1; n <= 16; ++n ) {
+			auto const value = static_cast<T>( n );
+			daw_ensure( daw::algorithm::find( first, last, value ) ==
+			            std::find( first, last, value ) );
+			auto const expected = std::count( first, last, value );
+			daw_ensure( daw::algorithm::count( first, last, value ) ==
+			            static_cast<std::size_t>( expected ) );
+		}
+		auto const needles = std::vector<T>{ T( 14 ), T( 3 ), T( 15 ) };
+		daw_ensure( daw::algorithm::find_first_of( first, last, needles.data( ),
+		                                           needles.data( ) + 3 ) ==
+		            std::find_first_of( first, last, needles.begin( ),
+		                                needles.end( ) ) );
+		daw_ensure( daw::algorithm::all_equal<>{ }( first, last ) ==
+		            ( std::adjacent_find( first, last, std::not_equal_to<>{ } ) ==
+		              last ) );
+		daw_ensure( daw::algorithm::min_element( first, last ) ==
+		            std::min_element( first, last ) );
+		daw_ensure( daw::algorithm::max_element( first, last ) ==
+		            std::max_element( first, last ) );
+
+		daw_ensure( daw::algorithm::equal( first, last, first2, last2 ) ==
+		            std::equal( first, last, first2, last2 ) );
+		daw_ensure( daw::algorithm::lexicographical_compare(
+		              first, last, first2, last2, std::less<>{ } ) ==
+		            std::lexicographical_compare( first, last, first2, last2 ) );
+		// A comparison the kernels do not recognize takes the generic loop
+		auto const less = []( T const &a, T const &b ) {
+			return a < b;
+		};
+		daw_ensure( daw::algorithm::compare_range( first, last, first2, last2 ) ==
+		            daw::algorithm::compare_range( first, last, first2, last2,
+		                                           less ) );
+		auto const m = daw::algorithm::mismatch( first, last, first2, last2 );
+		auto const expected = std::mismatch( first, last, first2, last2 );
+		daw_ensure( m.first == expected.first and m.second == expected.second );
+		if( v.size( ) <= w.size( ) ) {
+			daw_ensure( daw::algorithm::equal( first, last, first2 ) ==
+			            std::equal( first, last, first2 ) );
+		}
+	}
+
+	template<typename T>
+	void type_test( ) {
+		for( std::size_t n = 0; n <= 200; ++n ) {
+			auto v = random_values<T>( n, n );
+			check( v, v );
+			check( v, random_values<T>( n, n + 1000U ) );
+			// Each single difference, and a longer second range
+			for( std::size_t i = 0; i < n; ++i ) {
+				auto w = v;
+				w[i] = static_cast<T>( w[i] + 1 );
+				check( v, w );
+				w = v;
+				w.push_back( T( 1 ) );
+				check( w, v );
+				check( v, w );
+			}
+			// The extreme in each position
+			for( std::size_t i = 0; i < n; ++i ) {
+				auto w = v;
+				w[i] = std::numeric_limits<T>::lowest( );
+				check( w, v );
+				w[i] = std::numeric_limits<T>::max( );
+				check( w, v );
+			}
+		}
+		// Through std::vector iterators
+		auto const v = random_values<T>( 1'000, 1 );
+		daw_ensure( daw::algorithm::find( v.begin( ), v.end( ), T( 7 ) ) ==
+		            std::find( v.begin( ), v.end( ), T( 7 ) ) );
+		daw_ensure( daw::algorithm::max_element( v.begin( ), v.end( ) ) ==
+		            std::max_element( v.begin( ), v.end( ) ) );
+		daw_ensure( daw::algorithm::equal( v.begin( ), v.end( ), v.begin( ) ) );
+	}
+
+	template<typename T>
+	void float_test( ) {
+		auto const nan = std::numeric_limits<T>::quiet_NaN( );
+		for( std::size_t n = 1; n <= 70; ++n ) {
+			for( std::size_t i = 0; i < n; ++i ) {
+				auto v = random_values<T>( n, n );
+				v[i] = nan;
+				auto const *const first = v.data( );
+				auto const *const last = first + v.size( );
+				// NaN compares unequal to itself
+				daw_ensure( daw::algorithm::find( first, last, nan ) == last );
+				daw_ensure( daw::algorithm::count( first, last, nan ) == 0 );
+				daw_ensure( not daw::algorithm::equal( first, last, first ) );
+				daw_ensure( daw::algorithm::mismatch( first, last, first ).first ==
+				            first + i );
+				daw_ensure( daw::algorithm::min_element( first, last ) ==
+				            std::min_element( first, last ) );
+				daw_ensure( daw::algorithm::max_element( first, last ) ==
+				            std::max_element( first, last ) );
+				auto w = v;
+				w[i] = T( 20 );
+				check( v, w );
+			}
+		}
+		// -0 and +0 are equal, and the first one is the extreme
+		auto const v = std::vector<T>{ T( 1 ), T( -0.0 ), T( 2 ), T( 0.0 ), T( 5 ),
+		                               T( 1 ),  T( 3 ),    T( 4 ), T( 2 ) };
+		auto const *const first = v.data( );
+		auto const *const last = first + v.size( );
+		daw_ensure( daw::algorithm::find( first, last, T( 0.0 ) ) == first + 1 );
+		daw_ensure( daw::algorithm::count( first, last, T( -0.0 ) ) == 2 );
+		daw_ensure( daw::algorithm::min_element( first, last ) == first + 1 );
+	}
+
+	void generic_test( ) {
+		auto const v = std::vector<std::string>{ "a", "b", "c", "b" };
+		daw_ensure( daw::algorithm::find( v.begin( ), v.end( ), "c" ) ==
+		            v.begin( ) + 2 );
+		daw_ensure( daw::algorithm::count( v.begin( ), v.end( ), "b" ) == 2 );
+		daw_ensure( daw::algorithm::min_element( v.begin( ), v.end( ) ) ==
+		            v.begin( ) );
+		daw_ensure( daw::algorithm::mismatch( v.begin( ), v.end( ), v.begin( ) )
+		              .first == v.end( ) );
+	}
+
+	template<typename T>
+	void simd_bench( char const *name ) {
+		// Fits in L2, the match is the last element
+		constexpr std::size_t size = 64U * 1024U / sizeof( T );
+		auto v = random_values<T>( size, 1 );
+		for( auto &x : v ) {
+			x = static_cast<T>( x + 1 );
+		}
+		v.back( ) = T( 0 );
+		auto const w = v;
+		auto const *const first = v.data( );
+		auto const *const last = first + v.size( );
+		auto const *const first2 = w.data( );
+		auto const *const last2 = first2 + w.size( );
+		std::cout << "---- " << name << ", " << size << " elements ----\n";
+		(void)daw::bench_n_test<100>( "std::find", [&] {
+			daw::do_not_optimize( std::find( first, last, T( 0 ) ) );
+		} );
+		(void)daw::bench_n_test<100>( "daw::algorithm::find", [&] {
+			daw::do_not_optimize( daw::algorithm::find( first, last, T( 0 ) ) );
+		} );
+		(void)daw::bench_n_test<100>( "std::count", [&] {
+			daw::do_not_optimize( std::count( first, last, T( 1 ) ) );
+		} );
+		(void)daw::bench_n_test<100>( "daw::algorithm::count", [&] {
+			daw::do_not_optimize( daw::algorithm::count( first, last, T( 1 ) ) );
+		} );
+		(void)daw::bench_n_test<100>( "std::mismatch", [&] {
+			daw::do_not_optimize( std::mismatch( first, last, first2, last2 ) );
+		} );
+		(void)daw::bench_n_test<100>( "daw::algorithm::mismatch", [&] {
+			daw::do_not_optimize(
+			  daw::algorithm::mismatch( first, last, first2, last2 ) );
+		} );
+		(void)daw::bench_n_test<100>( "std::lexicographical_compare", [&] {
+			daw::do_not_optimize(
+			  std::lexicographical_compare( first, last, first2, last2 ) );
+		} );
+		(void)daw::bench_n_test<100>( "daw::algorithm::lexicographical_compare",
+		                              [&] {
+			                              daw::do_not_optimize(
+			                                daw::algorithm::lexicographical_compare(
+			                                  first, last, first2, last2,
+			                                  std::less<>{ } ) );
+		                              } );
+		(void)daw::bench_n_test<100>( "std::max_element", [&] {
+			daw::do_not_optimize( std::max_element( first, last ) );
+		} );
+		(void)daw::bench_n_test<100>( "daw::algorithm::max_element", [&] {
+			daw::do_not_optimize( daw::algorithm::max_element( first, last ) );
+		} );
+	}
+
+	void bench( ) {
+		simd_bench<std::uint8_t>( "uint8_t" );
+		simd_bench<std::int16_t>( "int16_t" );
+		simd_bench<std::int32_t>( "int32_t" );
+		simd_bench<std::int64_t>( "int64_t" );
+		simd_bench<float>( "float" );
+		simd_bench<double>( "double" );
+	}
+} // namespace
+
+int main( ) {
+	type_test<std::int8_t>( );
+	type_test<std::uint8_t>( );
+	type_test<std::int16_t>( );
+	type_test<std::uint16_t>( );
+	type_test<std::int32_t>( );
+	type_test<std::uint32_t>( );
+	type_test<std::int64_t>( );
+	type_test<std::uint64_t>( );
+	type_test<float>( );
+	type_test<double>( );
+	float_test<float>( );
+	float_test<double>( );
+	generic_test( );
+	bench( );
+	std::cout << "done\n";
+}
@@ -0,0 +1,281 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include <daw/algorithms/daw_algorithm_sorted_set.h>
+#include <daw/vector.h>
+
+#include <daw/daw_benchmark.h>
+#include <daw/daw_ensure.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined( __cpp_explicit_this_parameter )
+#include <daw/daw_span_writer.h>
+#endif
+
+namespace {
+	/// count sorted unique values in [lo, hi]
+	template<typename T>
+	std::vector<T> random_set( std::size_t count, T lo, T hi,
+	                           std::uint64_t seed ) {
+		auto engine = std::mt19937_64( seed );
+		auto dist = std::uniform_int_distribution<T>( lo, hi );
+		auto result = std::vector<T>( );
+		result.reserve( count );
+		while( result.size( ) < count ) {
+			for( auto n = result.size( ); n < count; ++n ) {
+				result.push_back( dist( engine ) );
+			}
+			std::sort( result.begin( ), result.end( ) );
+			result.erase( std::unique( result.begin( ), result.end( ) ),
+			              result.end( ) );
+		}
+		return result;
+	}
+
+	constexpr bool constexpr_test( ) {
+		int const a[] = { 1, 3, 5, 7, 9, 11 };
+		int const b[] = { 3, 4, 5, 11, 12 };
+		int out[11]{ };
+		auto const i_last =
+		  daw::algorithm::sorted_set_intersection( a, a + 6, b, b + 5, out );
+		bool const i_ok =
+		  i_last - out == 3 and out[0] == 3 and out[1] == 5 and out[2] == 11;
+		auto const u_last =
+		  daw::algorithm::sorted_set_union( a, a + 6, b, b + 5, out );
+		bool const u_ok = u_last - out == 8 and out[3] == 5 and out[7] == 12;
+		auto const d_last =
+		  daw::algorithm::sorted_set_difference( a, a + 6, b, b + 5, out );
+		bool const d_ok =
+		  d_last - out == 3 and out[0] == 1 and out[1] == 7 and out[2] == 9;
+		return i_ok and u_ok and d_ok;
+	}
+	static_assert( constexpr_test( ) );
+
+	template<typename T>
+	void check_pair( std::vector<T> const &a, std::vector<T> const &b ) {
+		auto expected = std::vector<T>( );
+		std::set_intersection( a.begin( ), a.end( ), b.begin( ), b.end( ),
+		                       std::back_inserter( expected ) );
+		auto result = std::vector<T>( );
+		daw::algorithm::sorted_set_intersection_append( result, a, b );
+		daw_ensure( result == expected );
+		// In place over the first input
+		auto in_place = a;
+		auto *const i_last = daw::algorithm::sorted_set_intersection(
+		  in_place.data( ), in_place.data( ) + in_place.size( ), b.data( ),
+		  b.data( ) + b.size( ), in_place.data( ) );
+		in_place.resize( static_cast<std::size_t>( i_last - in_place.data( ) ) );
+		daw_ensure( in_place == expected );
+
+		expected.clear( );
+		std::set_difference( a.begin( ), a.end( ), b.begin( ), b.end( ),
+		                     std::back_inserter( expected ) );
+		result.clear( );
+		daw::algorithm::sorted_set_difference_append( result, a, b );
+		daw_ensure( result == expected );
+		in_place = a;
+		auto *const d_last = daw::algorithm::sorted_set_difference(
+		  in_place.data( ), in_place.data( ) + in_place.size( ), b.data( ),
+		  b.data( ) + b.size( ), in_place.data( ) );
+		in_place.resize( static_cast<std::size_t>( d_last - in_place.data( ) ) );
+		daw_ensure( in_place == expected );
+
+		expected.clear( );
+		std::set_union( a.begin( ), a.end( ), b.begin( ), b.end( ),
+		                std::back_inserter( expected ) );
+		result.clear( );
+		daw::algorithm::sorted_set_union_append( result, a, b );
+		daw_ensure( result == expected );
+	}
+
+	template<typename T>
+	void pair_test( T lo ) {
+		std::uint64_t seed = 1;
+		for( std::size_t n1 : { 0U, 1U, 7U, 8U, 9U, 100U, 1'000U, 20'000U } ) {
+			for( std::size_t n2 : { 0U, 1U, 5U, 16U, 33U, 250U, 4'000U, 50'000U } ) {
+				// Dense ranges overlap a lot, sparse ones hardly
+				for( T span : { static_cast<T>( 2U * ( n1 + n2 ) + 1U ),
+				                static_cast<T>( 1'000'000'000U ) } ) {
+					auto const hi = static_cast<T>( lo + span );
+					auto const a = random_set<T>( n1, lo, hi, ++seed );
+					auto const b = random_set<T>( n2, lo, hi, ++seed );
+					check_pair( a, b );
+					check_pair( b, a );
+				}
+			}
+		}
+		// Runs of equal blocks, and blocks that end on the same element
+		auto a = std::vector<T>( );
+		auto b = std::vector<T>( );
+		for( T v = lo; v < static_cast<T>( lo + 1000 ); ++v ) {
+			a.push_back( v );
+			if( v % 3 != 0 ) {
+				b.push_back( v );
+			}
+		}
+		check_pair( a, a );
+		check_pair( a, b );
+	}
+
+	void generic_test( ) {
+		auto const a = std::vector<std::string>{ "a", "c", "e", "g" };
+		auto const b = std::vector<std::string>{ "b", "c", "d", "g", "h" };
+		check_pair( a, b );
+	}
+
+	void many_test( ) {
+		std::uint64_t seed = 100;
+		for( std::size_t k = 1; k <= 5; ++k ) {
+			auto sets = std::vector<std::vector<std::uint32_t>>( );
+			for( std::size_t n = 0; n < k; ++n ) {
+				sets.push_back( random_set<std::uint32_t>( 500U << ( 2U * n ), 0,
+				                                           200'000, ++seed ) );
+			}
+			std::shuffle( sets.begin( ), sets.end( ), std::mt19937_64( seed ) );
+			auto expected = sets[0];
+			for( std::size_t n = 1; n < k; ++n ) {
+				auto next = std::vector<std::uint32_t>( );
+				std::set_intersection( expected.begin( ), expected.end( ),
+				                       sets[n].begin( ), sets[n].end( ),
+				                       std::back_inserter( next ) );
+				expected = std::move( next );
+			}
+			auto result = daw::vector<std::uint32_t>( );
+			daw::algorithm::sorted_set_intersection_many_append(
+			  result, sets.begin( ), sets.end( ) );
+			daw_ensure( std::equal( result.begin( ), result.end( ),
+			                        expected.begin( ), expected.end( ) ) );
+		}
+		auto none = std::vector<std::vector<std::uint32_t>>( );
+		auto result = std::vector<std::uint32_t>( );
+		daw::algorithm::sorted_set_intersection_many_append( result, none.begin( ),
+		                                                     none.end( ) );
+		daw_ensure( result.empty( ) );
+	}
+
+	void output_test( ) {
+		auto const a = random_set<std::uint32_t>( 10'000, 0, 30'000, 1 );
+		auto const b = random_set<std::uint32_t>( 10'000, 0, 30'000, 2 );
+		// Storage reserved for the bound of each output is not reallocated
+		auto v = daw::vector<std::uint32_t>( );
+		v.reserve( ( a.size( ) + b.size( ) ) + std::min( a.size( ), b.size( ) ) );
+		auto const *const data = v.data( );
+		daw::algorithm::sorted_set_union_append( v, a, b );
+		daw::algorithm::sorted_set_intersection_append( v, a, b );
+		daw_ensure( v.data( ) == data );
+		auto expected = std::vector<std::uint32_t>( );
+		std::set_union( a.begin( ), a.end( ), b.begin( ), b.end( ),
+		                std::back_inserter( expected ) );
+		std::set_intersection( a.begin( ), a.end( ), b.begin( ), b.end( ),
+		                       std::back_inserter( expected ) );
+		daw_ensure(
+		  std::equal( v.begin( ), v.end( ), expected.begin( ), expected.end( ) ) );
+#if defined( __cpp_explicit_this_parameter )
+		auto buff = std::vector<std::uint32_t>( a.size( ) );
+		auto writer = daw::span_writer( buff );
+		daw::algorithm::sorted_set_intersection_to( writer, a, b );
+		auto const written = buff.size( ) - writer.size( );
+		daw_ensure( std::equal( buff.begin( ),
+		                        buff.begin( ) + static_cast<std::ptrdiff_t>( written ),
+		                        expected.end( ) - static_cast<std::ptrdiff_t>( written ),
+		                        expected.end( ) ) );
+#endif
+	}
+
+	void sorted_set_bench( ) {
+		// Posting lists of very different lengths: the long list holds 1M of
+		// the ids in [0, 4M) and the short one 1M / ratio
+		constexpr std::size_t large_size = 1'000'000;
+		constexpr std::uint32_t universe = 4'000'000;
+		auto const large = random_set<std::uint32_t>( large_size, 0, universe, 1 );
+		auto out = daw::vector<std::uint32_t>( );
+		out.reserve( 2U * large_size );
+		for( std::size_t ratio : { 1U, 4U, 16U, 32U, 64U, 1'024U } ) {
+			auto const small = random_set<std::uint32_t>( large_size / ratio, 0,
+			                                              universe, ratio + 1U );
+			std::cout << "---- size ratio " << ratio << " ----\n";
+			auto std_out = std::vector<std::uint32_t>( 2U * large_size );
+			(void)daw::bench_n_test<5>( "std::set_intersection", [&] {
+				auto const last =
+				  std::set_intersection( small.begin( ), small.end( ), large.begin( ),
+				                         large.end( ), std_out.begin( ) );
+				daw::do_not_optimize( last );
+			} );
+			(void)daw::bench_n_test<5>( "sorted_set_intersection", [&] {
+				out.clear( );
+				daw::algorithm::sorted_set_intersection_append( out, small, large );
+				daw::do_not_optimize( out );
+			} );
+			(void)daw::bench_n_test<5>( "std::set_difference", [&] {
+				auto const last =
+				  std::set_difference( large.begin( ), large.end( ), small.begin( ),
+				                       small.end( ), std_out.begin( ) );
+				daw::do_not_optimize( last );
+			} );
+			(void)daw::bench_n_test<5>( "sorted_set_difference", [&] {
+				out.clear( );
+				daw::algorithm::sorted_set_difference_append( out, large, small );
+				daw::do_not_optimize( out );
+			} );
+			(void)daw::bench_n_test<5>( "std::set_union", [&] {
+				auto const last =
+				  std::set_union( small.begin( ), small.end( ), large.begin( ),
+				                  large.end( ), std_out.begin( ) );
+				daw::do_not_optimize( last );
+			} );
+			(void)daw::bench_n_test<5>( "sorted_set_union", [&] {
+				out.clear( );
+				daw::algorithm::sorted_set_union_append( out, small, large );
+				daw::do_not_optimize( out );
+			} );
+		}
+		std::cout << "---- 4 way intersection ----\n";
+		auto sets = std::vector<std::vector<std::uint32_t>>( );
+		for( std::size_t n = 0; n < 4; ++n ) {
+			sets.push_back( random_set<std::uint32_t>( large_size >> ( 2U * n ), 0,
+			                                           universe, 10U + n ) );
+		}
+		auto tmp = std::vector<std::uint32_t>( large_size );
+		(void)daw::bench_n_test<5>( "std::set_intersection, pairwise", [&] {
+			auto acc = sets[3];
+			for( std::size_t n = 0; n < 3; ++n ) {
+				auto const last =
+				  std::set_intersection( acc.begin( ), acc.end( ), sets[n].begin( ),
+				                         sets[n].end( ), tmp.begin( ) );
+				acc.assign( tmp.begin( ), last );
+			}
+			daw::do_not_optimize( acc );
+		} );
+		(void)daw::bench_n_test<5>( "sorted_set_intersection_many", [&] {
+			out.clear( );
+			daw::algorithm::sorted_set_intersection_many_append( out, sets.begin( ),
+			                                                     sets.end( ) );
+			daw::do_not_optimize( out );
+		} );
+	}
+} // namespace
+
+int main( ) {
+	pair_test<std::uint32_t>( 0 );
+	pair_test<std::uint64_t>( 1ULL << 40U );
+	pair_test<std::int32_t>( -500'000'000 );
+	pair_test<std::int64_t>( -( 1LL << 40 ) );
+	generic_test( );
+	many_test( );
+	output_test( );
+	sorted_set_bench( );
+	std::cout << "done\n";
+}
@@ -7,7 +7,292 @@
 //
 
 #include <daw/daw_ascii.h>
+#include <daw/daw_benchmark.h>
 #include <daw/daw_ensure.h>
+#include <daw/daw_random.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+	struct test_writer {
+		char *m_first;
+		std::size_t m_size;
+
+		char *data( ) {
+			return m_first;
+		}
+
+		std::size_t size( ) const {
+			return m_size;
+		}
+
+		void remove_prefix( std::size_t n ) {
+			m_first += n;
+			m_size -= n;
+		}
+	};
+
+	std::string make_text( std::size_t size ) {
+		auto const bytes = daw::make_random_data<int>( size, 1, 255 );
+		auto result = std::string( size, ' ' );
+		std::transform( bytes.begin( ), bytes.end( ), result.begin( ), []( int b ) {
+			return static_cast<char>( b );
+		} );
+		return result;
+	}
+
+	std::string make_ascii_text( std::size_t size ) {
+		auto result = make_text( size );
+		for( auto &c : result ) {
+			c = static_cast<char>( 32 + static_cast<unsigned char>( c ) % 95U );
+		}
+		return result;
+	}
+
+	void transform_test( ) {
+		for( std::size_t sz = 0; sz < 200; ++sz ) {
+			auto const text = make_text( sz );
+			auto expected_lower = text;
+			auto expected_upper = text;
+			for( std::size_t n = 0; n < sz; ++n ) {
+				expected_lower[n] = daw::to_lower_ascii( text[n] );
+				expected_upper[n] = daw::to_upper_ascii( text[n] );
+			}
+			auto lower = text;
+			daw::to_lower_ascii_in_place( lower.data( ), lower.size( ) );
+			daw_ensure( lower == expected_lower );
+			auto upper = text;
+			daw::to_upper_ascii_in_place( upper.data( ), upper.size( ) );
+			daw_ensure( upper == expected_upper );
+
+			auto out = std::string( sz + 1U, '#' );
+			auto *const last = daw::to_lower_ascii_copy( text, out.data( ) + 1 );
+			daw_ensure( last == out.data( ) + sz + 1 );
+			daw_ensure( out.substr( 1 ) == expected_lower );
+			daw_ensure( out[0] == '#' );
+
+			auto w = test_writer{ out.data( ), out.size( ) };
+			daw::to_upper_ascii_copy( text, w );
+			daw_ensure( w.size( ) == 1U );
+			daw_ensure( out.substr( 0, sz ) == expected_upper );
+		}
+		// Arrays decay to the char * overloads
+		char arr[4]{ };
+		daw_ensure( daw::to_upper_ascii_copy( "aB1", arr ) == arr + 3 );
+		daw_ensure( daw::to_lower_ascii_copy( "Cd", arr ) == arr + 2 );
+		daw_ensure( arr[0] == 'c' and arr[1] == 'd' and arr[2] == '1' );
+	}
+
+	void classify_test( ) {
+		for( std::size_t sz = 0; sz < 300; sz += 7 ) {
+			auto text = make_text( sz );
+			auto count = [&]( auto pred ) {
+				return static_cast<std::size_t>(
+				  std::count_if( text.begin( ), text.end( ), pred ) );
+			};
+			daw_ensure( daw::count_if_class( text, daw::ascii_class::digit ) ==
+			            count( daw::is_ascii_digit ) );
+			daw_ensure( daw::count_if_class( text, daw::ascii_class::alpha ) ==
+			            count( daw::is_ascii_alpha ) );
+			daw_ensure( daw::count_if_class( text, daw::ascii_class::alphanum ) ==
+			            count( daw::is_ascii_alphanum ) );
+			daw_ensure( daw::count_if_class( text, daw::ascii_class::upper ) ==
+			            count( daw::is_ascii_upper ) );
+			daw_ensure( daw::count_if_class( text, daw::ascii_class::lower ) ==
+			            count( daw::is_ascii_lower ) );
+			daw_ensure( daw::count_if_class( text, daw::ascii_class::whitespace ) ==
+			            count( daw::is_ascii_whitespace ) );
+			daw_ensure( daw::count_if_class( text, daw::ascii_class::printable ) ==
+			            count( daw::is_ascii_printable ) );
+			daw_ensure( daw::count_if_class( text, daw::ascii_class::non_ascii ) ==
+			            count( []( char c ) {
+				            return static_cast<unsigned char>( c ) >= 0x80U;
+			            } ) );
+
+			auto ascii = make_ascii_text( sz );
+			daw_ensure( daw::all_ascii( ascii ) );
+			auto digits = std::string( sz, '7' );
+			daw_ensure( daw::is_all_digits( digits ) == ( sz > 0 ) );
+			if( sz > 0 ) {
+				ascii[sz / 2U] = static_cast<char>( 0xC3 );
+				daw_ensure( not daw::all_ascii( ascii ) );
+				digits[sz - 1U] = ':';
+				daw_ensure( not daw::is_all_digits( digits ) );
+			}
+		}
+		// 300 full vectors so the per byte counters must be flushed
+		auto const big = std::string( 32U * 300U, 'x' );
+		daw_ensure( daw::count_if_class( big, daw::ascii_class::lower ) == big.size( ) );
+	}
+
+	void icase_test( ) {
+		daw_ensure( daw::equal_ascii_icase( "Content-Length", "content-LENGTH" ) );
+		daw_ensure( not daw::equal_ascii_icase( "Content-Length", "Content-Lengt" ) );
+		daw_ensure( not daw::equal_ascii_icase( "[", "{" ) );
+		daw_ensure( daw::compare_ascii_icase( "abc", "ABD" ) < 0 );
+		daw_ensure( daw::compare_ascii_icase( "ABC", "abc" ) == 0 );
+		daw_ensure( daw::compare_ascii_icase( "abcd", "ABC" ) > 0 );
+		daw_ensure( daw::hash_ascii_icase( "Transfer-Encoding" ) ==
+		            daw::hash_ascii_icase( "TRANSFER-encoding" ) );
+		daw_ensure( daw::hash_ascii_icase( "a" ) != daw::hash_ascii_icase( "b" ) );
+
+		for( std::size_t sz = 0; sz < 150; ++sz ) {
+			auto const text = make_text( sz );
+			auto other = text;
+			daw::to_upper_ascii_in_place( other.data( ), other.size( ) );
+			daw_ensure( daw::equal_ascii_icase( text, other ) );
+			daw_ensure( daw::hash_ascii_icase( text ) == daw::hash_ascii_icase( other ) );
+			if( sz > 0 ) {
+				other[sz - 1U] = static_cast<char>( other[sz - 1U] ^ 0x01 );
+				daw_ensure( not daw::equal_ascii_icase( text, other ) );
+				daw_ensure( daw::compare_ascii_icase( text, other ) != 0 );
+			}
+		}
+
+		auto const hay = make_ascii_text( 1000 );
+		for( std::size_t len : { 1U, 2U, 3U, 16U, 40U } ) {
+			for( std::size_t pos : { 0U, 13U, 500U, 1000U - 40U } ) {
+				auto needle = hay.substr( pos, len );
+				daw::to_upper_ascii_in_place( needle.data( ), needle.size( ) );
+				auto lower_hay = hay;
+				daw::to_lower_ascii_in_place( lower_hay.data( ), lower_hay.size( ) );
+				auto lower_needle = needle;
+				daw::to_lower_ascii_in_place( lower_needle.data( ), lower_needle.size( ) );
+				daw_ensure( daw::find_ascii_icase( hay, needle ) ==
+				            lower_hay.find( lower_needle ) );
+			}
+		}
+		daw_ensure( daw::find_ascii_icase( "abc", "" ) == 0U );
+		daw_ensure( daw::find_ascii_icase( "abc", "abcd" ) == daw::string_view::npos );
+		daw_ensure( daw::find_ascii_icase( "Keep-Alive, Upgrade", "UPGRADE" ) == 12U );
+		daw_ensure( daw::find_ascii_icase( "Keep-Alive", "close" ) ==
+		            daw::string_view::npos );
+
+		auto headers = std::unordered_set<std::string, daw::ascii_icase_hash,
+		                                  daw::ascii_icase_equal>{ "Host", "Accept" };
+		daw_ensure( headers.count( "HOST" ) == 1U );
+		daw_ensure( headers.count( "accept" ) == 1U );
+	}
+
+	constexpr bool constexpr_test( ) {
+		char buff[] = "Hello, World 123";
+		daw::to_lower_ascii_in_place( buff, sizeof( buff ) - 1U );
+		if( daw::string_view( buff ) != "hello, world 123" ) {
+			return false;
+		}
+		return daw::all_ascii( buff ) and daw::is_all_digits( "0123456789" ) and
+		       daw::count_if_class( buff, daw::ascii_class::digit ) == 3U and
+		       daw::equal_ascii_icase( "HELLO", "hello" ) and
+		       daw::compare_ascii_icase( "a", "B" ) < 0 and
+		       daw::find_ascii_icase( buff, "WORLD" ) == 7U and
+		       daw::hash_ascii_icase( "Hello, World!" ) ==
+		         daw::hash_ascii_icase( "HELLO, WORLD!" );
+	}
+	static_assert( constexpr_test( ) );
+
+	void ascii_bench( ) {
+		auto const text = make_ascii_text( 64U * 1024U * 1024U );
+		auto const bytes = text.size( );
+		auto buffer = std::string( bytes, ' ' );
+
+		(void)daw::bench_n_test_mbs<10>(
+		  "per character to_lower_ascii", bytes,
+		  [&]( std::string const &s ) {
+			  std::transform( s.begin( ), s.end( ), buffer.begin( ), daw::to_lower_ascii );
+			  daw::do_not_optimize( buffer );
+		  },
+		  text );
+		(void)daw::bench_n_test_mbs<10>(
+		  "to_lower_ascii_copy", bytes,
+		  [&]( std::string const &s ) {
+			  (void)daw::to_lower_ascii_copy( s, buffer.data( ) );
+			  daw::do_not_optimize( buffer );
+		  },
+		  text );
+		(void)daw::bench_n_test_mbs<10>(
+		  "per character all ascii", bytes,
+		  []( std::string const &s ) {
+			  auto result = std::all_of( s.begin( ), s.end( ), []( char c ) {
+				  return static_cast<unsigned char>( c ) < 0x80U;
+			  } );
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  text );
+		(void)daw::bench_n_test_mbs<10>(
+		  "all_ascii", bytes,
+		  []( std::string const &s ) {
+			  auto result = daw::all_ascii( s );
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  text );
+		(void)daw::bench_n_test_mbs<10>(
+		  "per character count alpha", bytes,
+		  []( std::string const &s ) {
+			  auto result = std::count_if( s.begin( ), s.end( ), daw::is_ascii_alpha );
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  text );
+		(void)daw::bench_n_test_mbs<10>(
+		  "count_if_class alpha", bytes,
+		  []( std::string const &s ) {
+			  auto result = daw::count_if_class( s, daw::ascii_class::alpha );
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  text );
+
+		auto const upper = [&] {
+			auto r = text;
+			daw::to_upper_ascii_in_place( r.data( ), r.size( ) );
+			return r;
+		}( );
+		(void)daw::bench_n_test_mbs<10>(
+		  "per character icase equal", bytes,
+		  []( std::string const &l, std::string const &r ) {
+			  auto result = std::equal( l.begin( ), l.end( ), r.begin( ), r.end( ),
+			                            []( char a, char b ) {
+				                            return daw::to_lower_ascii( a ) ==
+				                                   daw::to_lower_ascii( b );
+			                            } );
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  text, upper );
+		(void)daw::bench_n_test_mbs<10>(
+		  "equal_ascii_icase", bytes,
+		  []( std::string const &l, std::string const &r ) {
+			  auto result = daw::equal_ascii_icase( l, r );
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  text, upper );
+		(void)daw::bench_n_test_mbs<10>(
+		  "hash_ascii_icase", bytes,
+		  []( std::string const &s ) {
+			  auto result = daw::hash_ascii_icase( s );
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  text );
+		auto const needle = std::string( "\x01NOT PRESENT IN THE TEXT" );
+		(void)daw::bench_n_test_mbs<10>(
+		  "find_ascii_icase", bytes,
+		  [&]( std::string const &s ) {
+			  auto result = daw::find_ascii_icase( s, needle );
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  text );
+	}
+} // namespace
 
 int main( ) {
 	daw_ensure( daw::is_ascii_alpha( 'a' ) );
@@ -17,4 +302,9 @@ int main( ) {
 	daw_ensure( daw::is_ascii_alphanum( 'a' ) );
 	daw_ensure( not daw::is_ascii_alphanum( ' ' ) );
 	daw_ensure( daw::is_ascii_printable( '!' ) );
-}
\ No newline at end of file
+	transform_test( );
+	classify_test( );
+	icase_test( );
+	ascii_bench( );
+	std::cout << "done\n";
+}
@@ -0,0 +1,195 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include "daw/daw_bloom_filter.h"
+
+#include "daw/daw_benchmark.h"
+#include "daw/daw_memory_mapped_file.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+	constexpr std::size_t item_count = 1'000'000;
+
+	std::vector<std::uint64_t> make_keys( std::uint64_t first,
+	                                      std::size_t count ) {
+		auto result = std::vector<std::uint64_t>( );
+		result.reserve( count );
+		for( std::size_t n = 0; n < count; ++n ) {
+			result.push_back( first + n * 7U );
+		}
+		return result;
+	}
+
+	template<typename Filter>
+	double false_positive_rate( Filter const &filter,
+	                            std::vector<std::uint64_t> const &misses ) {
+		std::size_t fp = 0;
+		for( auto k : misses ) {
+			if( filter.contains( k ) ) {
+				++fp;
+			}
+		}
+		return static_cast<double>( fp ) / static_cast<double>( misses.size( ) );
+	}
+
+	void bloom_filter_test_001( ) {
+		auto filter = daw::blocked_bloom_filter<>( 1000 );
+		filter.insert( std::string( "hello" ) );
+		filter.insert( daw::string_view( "world" ) );
+		filter.insert( 42 );
+		daw::expecting( filter.contains( std::string( "hello" ) ) );
+		daw::expecting( filter.contains( daw::string_view( "world" ) ) );
+		daw::expecting( filter.contains( 42 ) );
+		daw::expecting( not filter.contains( 43 ) );
+		filter.clear( );
+		daw::expecting( not filter.contains( 42 ) );
+	}
+
+	void bloom_filter_default_test( ) {
+		auto filter = daw::blocked_bloom_filter<>( );
+		daw::expecting( 1U, filter.block_count( ) );
+		daw::expecting( not filter.contains( 42 ) );
+		filter.insert( 42 );
+		filter.insert_concurrent( 43 );
+		daw::expecting( filter.contains( 42 ) );
+		daw::expecting( filter.contains( 43 ) );
+	}
+
+	void bloom_filter_fpr_test( ) {
+		auto const hits = make_keys( 0, item_count );
+		auto const misses = make_keys( 1, item_count );
+		for( double target : { 0.1, 0.01, 0.001 } ) {
+			auto filter = daw::blocked_bloom_filter<>( item_count, target );
+			filter.insert_batch( hits.begin( ), hits.end( ) );
+			for( auto k : hits ) {
+				daw::expecting( filter.contains( k ) );
+			}
+			auto const fpr = false_positive_rate( filter, misses );
+			std::cout << "blocked_bloom_filter target fpr: " << target
+			          << " measured: " << fpr << " bytes/key: "
+			          << static_cast<double>( filter.size_in_bytes( ) ) /
+			               static_cast<double>( item_count )
+			          << '\n';
+			daw::expecting( fpr < target * 2.0 );
+		}
+	}
+
+	void bloom_filter_concurrent_test( ) {
+		auto const keys = make_keys( 0, item_count );
+		auto filter = daw::blocked_bloom_filter<>( item_count );
+		auto threads = std::vector<std::thread>( );
+		constexpr std::size_t thread_count = 4;
+		for( std::size_t t = 0; t < thread_count; ++t ) {
+			threads.emplace_back( [&, t] {
+				for( std::size_t n = t; n < keys.size( ); n += thread_count ) {
+					filter.insert_concurrent( keys[n] );
+				}
+			} );
+		}
+		for( auto &th : threads ) {
+			th.join( );
+		}
+		for( auto k : keys ) {
+			daw::expecting( filter.contains( k ) );
+		}
+	}
+
+	void bloom_filter_serialize_test( ) {
+		auto const keys = make_keys( 0, 10'000 );
+		auto filter = daw::blocked_bloom_filter<>( keys.size( ) );
+		filter.insert_batch( keys.begin( ), keys.end( ) );
+
+		auto buffer = std::vector<char>( filter.serialized_size( ) );
+		auto *last = filter.serialize_to( buffer.data( ) );
+		daw::expecting( last == buffer.data( ) + buffer.size( ) );
+
+		auto copy = daw::blocked_bloom_filter<>::from_buffer( buffer.data( ),
+		                                                      buffer.size( ) );
+		daw::expecting( copy.has_value( ) );
+		daw::expecting( filter.block_count( ), copy->block_count( ) );
+		daw::expecting( not daw::blocked_bloom_filter<>::from_buffer(
+		                      buffer.data( ), buffer.size( ) - 1 )
+		                      .has_value( ) );
+
+		auto const path =
+		  std::filesystem::temp_directory_path( ) / "bloom_filter_test.bin";
+		std::string const file_name = path.string( );
+		{
+			auto out = std::ofstream( file_name, std::ios::binary );
+			out.write( buffer.data( ), static_cast<std::streamsize>( buffer.size( ) ) );
+		}
+		{
+			auto mmf = daw::filesystem::memory_mapped_file_t<char>( file_name );
+			daw::expecting( static_cast<bool>( mmf ) );
+			auto view = daw::blocked_bloom_filter_view<>::from_buffer( mmf.data( ),
+			                                                           mmf.size( ) );
+			daw::expecting( view.has_value( ) );
+			auto results = std::vector<bool>( );
+			view->contains_batch( keys.begin( ), keys.end( ),
+			                      std::back_inserter( results ) );
+			daw::expecting( keys.size( ), results.size( ) );
+			for( bool b : results ) {
+				daw::expecting( b );
+			}
+		}
+		std::filesystem::remove( path );
+	}
+
+	void bloom_filter_bench( ) {
+		auto const hits = make_keys( 0, item_count );
+		auto const misses = make_keys( 1, item_count );
+		auto filter = daw::blocked_bloom_filter<>( item_count );
+		daw::bench_n_test<10>(
+		  "blocked_bloom_filter insert 1M",
+		  [&]( auto const &keys ) {
+			  for( auto k : keys ) {
+				  filter.insert( k );
+			  }
+			  return filter.block_count( );
+		  },
+		  hits );
+		daw::bench_n_test<10>(
+		  "blocked_bloom_filter contains 1M misses",
+		  [&]( auto const &keys ) {
+			  std::size_t found = 0;
+			  for( auto k : keys ) {
+				  found += filter.contains( k ) ? 1U : 0U;
+			  }
+			  daw::do_not_optimize( found );
+			  return found;
+		  },
+		  misses );
+		auto results = std::vector<unsigned char>( item_count );
+		daw::bench_n_test<10>(
+		  "blocked_bloom_filter contains_batch 1M misses",
+		  [&]( auto const &keys ) {
+			  filter.contains_batch( keys.begin( ), keys.end( ), results.begin( ) );
+			  daw::do_not_optimize( results );
+			  return results.size( );
+		  },
+		  misses );
+	}
+} // namespace
+
+int main( ) {
+	bloom_filter_test_001( );
+	bloom_filter_default_test( );
+	bloom_filter_fpr_test( );
+	bloom_filter_concurrent_test( );
+	bloom_filter_serialize_test( );
+	bloom_filter_bench( );
+	std::cout << "done\n";
+}
@@ -6,43 +6,189 @@
 // Official repository: https://github.com/beached/header_libraries
 //
 
-#ifndef WIN32
 #include <daw/daw_container_help.h>
+
+#include <daw/daw_benchmark.h>
 #include <daw/daw_ensure.h>
+#include <daw/daw_unique_array.h>
 
+#include <cstddef>
 #include <cstring>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <string>
 #include <vector>
+
+namespace {
+	void extract_insert_test( ) {
+		{
+			auto foo = std::vector{ 1, 2, 3 };
+			auto const foo_cap = foo.capacity( );
+			auto const foo_size = foo.size( );
+			daw_ensure( foo_size == 3 );
+			auto foo_data = daw::extract_from_container( foo );
+			daw_ensure( foo.empty( ) );
+			daw_ensure( foo_data.size( ) == foo_size );
+			daw_ensure( foo_data.data( )[0] == 1 );
+			daw_ensure( foo_data.data( )[1] == 2 );
+			daw_ensure( foo_data.data( )[2] == 3 );
+			(void)foo_cap;
+#if defined( DAW_HAS_STD_VECTOR_BUFFER_TRANSFER )
+			daw_ensure( foo_cap == foo_data.capacity( ) );
+
+			constexpr auto vec_size = sizeof( std::vector<int> );
+			auto const empty_vector = std::vector<int>{ };
+			daw_ensure( memcmp( std::addressof( foo ),
+			                    std::addressof( empty_vector ),
+			                    vec_size ) == 0 );
+#endif
+		}
+		{
+			auto alloc = std::allocator<int>{ };
+			int *buff = alloc.allocate( 1024 );
+			std::iota( buff, buff + 3, 1 );
+			auto vec = std::vector<int, std::allocator<int>>{ };
+			daw::insert_into_container( vec, buff, alloc, 1024, 3 );
+			daw_ensure( vec.size( ) == 3 );
+			daw_ensure( vec == std::vector{ 1, 2, 3 } );
+#if defined( DAW_HAS_STD_VECTOR_BUFFER_TRANSFER )
+			// Taken without a copy
+			daw_ensure( vec.capacity( ) == 1024 );
+			daw_ensure( vec.data( ) == buff );
 #endif
+		}
+	}
 
-int main( ) {
-#ifndef WIN32
-	{
-		auto foo = std::vector{ 1, 2, 3 };
-		auto const foo_cap = foo.capacity( );
-		auto const foo_size = foo.size( );
-		daw_ensure( foo_size == 3 );
-		auto foo_data = daw::extract_from_container( foo );
-		daw_ensure( foo.empty( ) );
-		daw_ensure( foo_data.size( ) == foo_size );
-		daw_ensure( foo_cap == foo_data.capacity( ) );
-		daw_ensure( foo_data.data( )[0] == 1 );
-		daw_ensure( foo_data.data( )[1] == 2 );
-		daw_ensure( foo_data.data( )[2] == 3 );
-
-		constexpr auto vec_size = sizeof( std::vector<int> );
-		auto const empty_vector = std::vector<int>{ };
-		daw_ensure( memcmp( std::addressof( foo ),
-		                    std::addressof( empty_vector ),
-		                    vec_size ) == 0 );
+	void vector_transfer_test( ) {
+		auto v = std::vector<std::string>( 100, std::string( 64, 'x' ) );
+		v.reserve( 150 );
+		auto const *const first = v.data( );
+		auto const *const payload = v[5].data( );
+
+		auto buff = daw::release_buffer( std::move( v ) );
+		daw_ensure( v.empty( ) and v.capacity( ) == 0 );
+		daw_ensure( buff.size( ) == 100 );
+#if defined( DAW_HAS_STD_VECTOR_BUFFER_TRANSFER )
+		daw_ensure( buff.data( ) == first and buff.capacity( ) == 150 );
+		daw_ensure( buff.span( )[5].data( ) == payload );
+#endif
+
+		auto back = daw::to_std_vector( std::move( buff ) );
+		daw_ensure( buff.data( ) == nullptr and buff.empty( ) );
+		daw_ensure( back.size( ) == 100 );
+#if defined( DAW_HAS_STD_VECTOR_BUFFER_TRANSFER )
+		daw_ensure( back.data( ) == first and back.capacity( ) == 150 );
+#endif
+		back.push_back( "grow" );
+		daw_ensure( back.back( ) == "grow" and back[99] == std::string( 64, 'x' ) );
+
+		// The destination's own allocation is released
+		auto target = std::vector<std::string>( 10 );
+		auto buff2 = daw::release_buffer( std::move( back ) );
+		auto const cap2 = buff2.capacity( );
+		auto const size2 = buff2.size( );
+		daw::insert_into_container( target, buff2.release( ),
+		                            std::allocator<std::string>{ }, cap2, size2 );
+		daw_ensure( target.size( ) == 101 );
+#if defined( DAW_HAS_STD_VECTOR_BUFFER_TRANSFER )
+		daw_ensure( target.data( ) == first );
+#endif
+		(void)first;
+		(void)payload;
+
+		// A buffer dropped without adoption destroys only the live elements
+		auto dropped = daw::release_buffer( std::move( target ) );
+		daw_ensure( dropped.size( ) == 101 );
 	}
-	{
-		int *buff = new int[1024]{ 1, 2, 3 };
-		auto vec = std::vector<int, std::allocator<int>>{ };
-		daw::insert_into_container( vec, buff, std::allocator<int>{ }, 1024, 3 );
-		daw_ensure( vec.size( ) == 3 );
-		daw_ensure( vec.capacity( ) == 1024 );
-		daw_ensure( vec.data( ) == buff );
-		daw_ensure( vec == std::vector{ 1, 2, 3 } );
+
+	void unique_array_transfer_test( ) {
+		auto v = std::vector<int>( 1000 );
+		std::iota( v.begin( ), v.end( ), 0 );
+		auto const *const first = v.data( );
+
+		auto arr = daw::unique_array_t<int>( daw::release_buffer( std::move( v ) ) );
+		daw_ensure( arr.size( ) == 1000 and arr[999] == 999 );
+
+		auto back = daw::to_std_vector( arr.release_buffer( ) );
+		daw_ensure( arr.empty( ) and arr.size( ) == 0 );
+		daw_ensure( back.size( ) == 1000 );
+#if defined( DAW_HAS_STD_VECTOR_BUFFER_TRANSFER )
+		daw_ensure( back.data( ) == first );
+#endif
+		(void)first;
+
+		auto own = daw::unique_array_t<int>( 16, 7 );
+		daw_ensure( own.capacity( ) == 16 );
+		auto from_own = daw::to_std_vector( own.release_buffer( ) );
+		daw_ensure( from_own == std::vector<int>( 16, 7 ) );
 	}
+
+	void string_transfer_test( ) {
+		auto str = std::string( 1000, 'a' );
+		auto const *const first = str.data( );
+		auto buff = daw::release_buffer( std::move( str ) );
+		daw_ensure( str.empty( ) );
+		daw_ensure( buff.size( ) == 1000 );
+		daw_ensure( buff.capacity( ) > buff.size( ) );
+#if defined( DAW_HAS_STD_STRING_BUFFER_TRANSFER )
+		daw_ensure( buff.data( ) == first );
+#endif
+		auto back = daw::to_std_string( std::move( buff ) );
+		daw_ensure( back == std::string( 1000, 'a' ) );
+		daw_ensure( back.c_str( )[1000] == '\0' );
+#if defined( DAW_HAS_STD_STRING_BUFFER_TRANSFER )
+		daw_ensure( back.data( ) == first );
 #endif
+		(void)first;
+		back += "more";
+		daw_ensure( back.size( ) == 1004 );
+
+		// Short strings do not own an allocation and are copied
+		auto small = std::string( "short" );
+		auto small_buff = daw::release_buffer( std::move( small ) );
+		daw_ensure( small.empty( ) and small_buff.size( ) == 5 );
+		daw_ensure( daw::to_std_string( std::move( small_buff ) ) == "short" );
+		daw_ensure( daw::to_std_string( daw::release_buffer( std::string( ) ) ).empty( ) );
+
+		// A full buffer has no room for the terminator and is copied
+		auto full = std::vector<char>( 100, 'z' );
+		full.shrink_to_fit( );
+		auto const full_str = daw::to_std_string( daw::release_buffer( std::move( full ) ) );
+		daw_ensure( full_str == std::string( 100, 'z' ) );
+	}
+
+	void transfer_bench( ) {
+		constexpr std::size_t count = 64U * 1024U * 1024U;
+		auto payload = std::vector<char>( count, 'p' );
+		(void)daw::bench_n_test_mbs<10>(
+		  "copy std::vector<char> to std::string", count,
+		  []( std::vector<char> const &v ) {
+			  auto result = std::string( v.data( ), v.size( ) );
+			  daw::do_not_optimize( result );
+			  return result.size( );
+		  },
+		  payload );
+		(void)daw::bench_n_test_mbs<10>(
+		  "release std::vector<char> to std::string and back", count,
+		  [&payload]( std::size_t ) {
+			  auto str =
+			    daw::to_std_string( daw::release_buffer( std::move( payload ) ) );
+			  daw::do_not_optimize( str );
+			  auto const result = str.size( );
+			  payload = daw::to_std_vector( daw::release_buffer( std::move( str ) ) );
+			  return result;
+		  },
+		  count );
+		daw_ensure( payload.size( ) == count and payload.back( ) == 'p' );
+	}
+} // namespace
+
+int main( ) {
+	extract_insert_test( );
+	vector_transfer_test( );
+	unique_array_transfer_test( );
+	string_transfer_test( );
+	transfer_bench( );
+	std::cout << "done\n";
 }
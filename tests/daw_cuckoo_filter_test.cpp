@@ -0,0 +1,179 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include "daw/daw_cuckoo_filter.h"
+
+#include "daw/daw_benchmark.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+	constexpr std::size_t item_count = 1'000'000;
+
+	std::vector<std::uint64_t> make_keys( std::uint64_t first,
+	                                      std::size_t count ) {
+		auto result = std::vector<std::uint64_t>( );
+		result.reserve( count );
+		for( std::size_t n = 0; n < count; ++n ) {
+			result.push_back( first + n * 7U );
+		}
+		return result;
+	}
+
+	void cuckoo_filter_test_001( ) {
+		auto filter = daw::cuckoo_filter<>( 100 );
+		daw::expecting( filter.insert( std::string( "hello" ) ) );
+		daw::expecting( filter.insert( 42 ) );
+		daw::expecting( 2U, filter.size( ) );
+		daw::expecting( filter.contains( std::string( "hello" ) ) );
+		daw::expecting( filter.contains( 42 ) );
+		daw::expecting( filter.erase( 42 ) );
+		daw::expecting( not filter.contains( 42 ) );
+		daw::expecting( 1U, filter.size( ) );
+	}
+
+	void cuckoo_filter_fill_test( ) {
+		auto const hits = make_keys( 0, item_count );
+		auto const misses = make_keys( 1, item_count );
+		auto filter = daw::cuckoo_filter<>( item_count );
+		for( auto k : hits ) {
+			daw::expecting( filter.insert( k ) );
+		}
+		for( auto k : hits ) {
+			daw::expecting( filter.contains( k ) );
+		}
+		std::size_t fp = 0;
+		for( auto k : misses ) {
+			fp += filter.contains( k ) ? 1U : 0U;
+		}
+		auto const fpr =
+		  static_cast<double>( fp ) / static_cast<double>( misses.size( ) );
+		std::cout << "cuckoo_filter load: " << filter.load_factor( )
+		          << " measured fpr: " << fpr << '\n';
+		daw::expecting( fpr < 0.001 );
+
+		for( std::size_t n = 0; n < hits.size( ); n += 2 ) {
+			daw::expecting( filter.erase( hits[n] ) );
+		}
+		for( std::size_t n = 1; n < hits.size( ); n += 2 ) {
+			daw::expecting( filter.contains( hits[n] ) );
+		}
+		daw::expecting( item_count / 2U, filter.size( ) );
+	}
+
+	void cuckoo_filter_overfill_test( ) {
+		auto filter = daw::cuckoo_filter<>( 1000 );
+		std::size_t inserted = 0;
+		for( std::uint64_t n = 0; n < 10'000; ++n ) {
+			if( not filter.insert( n ) ) {
+				break;
+			}
+			++inserted;
+		}
+		daw::expecting( inserted < 10'000U );
+		daw::expecting( inserted, filter.size( ) );
+		for( std::uint64_t n = 0; n < inserted; ++n ) {
+			daw::expecting( filter.contains( n ) );
+		}
+	}
+
+	void cuckoo_filter_serialize_test( ) {
+		auto const keys = make_keys( 0, 10'000 );
+		auto filter = daw::cuckoo_filter<>( keys.size( ) );
+		for( auto k : keys ) {
+			daw::expecting( filter.insert( k ) );
+		}
+		auto buffer = std::vector<std::uint64_t>(
+		  ( filter.serialized_size( ) + sizeof( std::uint64_t ) - 1 ) /
+		  sizeof( std::uint64_t ) );
+		auto *const bytes = reinterpret_cast<char *>( buffer.data( ) );
+		(void)filter.serialize_to( bytes );
+		auto view = daw::cuckoo_filter_view<>::from_buffer(
+		  bytes, filter.serialized_size( ) );
+		daw::expecting( view.has_value( ) );
+		auto copy =
+		  daw::cuckoo_filter<>::from_buffer( bytes, filter.serialized_size( ) );
+		daw::expecting( copy.has_value( ) );
+		daw::expecting( filter.size( ), copy->size( ) );
+		auto results = std::vector<bool>( );
+		view->contains_batch( keys.begin( ), keys.end( ),
+		                      std::back_inserter( results ) );
+		for( bool b : results ) {
+			daw::expecting( b );
+		}
+
+		// A victim outside of the table is rejected
+		using header_t = daw::filter_impl::filter_header;
+		auto const bad_index = std::uint64_t{ filter.bucket_count( ) };
+		auto const used = std::uint32_t{ 1 };
+		std::memcpy( bytes + offsetof( header_t, victim_index ), &bad_index,
+		             sizeof( bad_index ) );
+		std::memcpy( bytes + offsetof( header_t, victim_used ), &used,
+		             sizeof( used ) );
+		daw::expecting(
+		  not daw::cuckoo_filter<>::from_buffer( bytes, filter.serialized_size( ) ) );
+		daw::expecting( not daw::cuckoo_filter_view<>::from_buffer(
+		  bytes, filter.serialized_size( ) ) );
+	}
+
+	void cuckoo_filter_default_test( ) {
+		auto filter = daw::cuckoo_filter<>( );
+		daw::expecting( 1U, filter.bucket_count( ) );
+		daw::expecting( not filter.contains( 42 ) );
+		daw::expecting( filter.insert( 42 ) );
+		daw::expecting( filter.contains( 42 ) );
+		daw::expecting( filter.load_factor( ) > 0.0 );
+		daw::expecting( filter.erase( 42 ) );
+		daw::expecting( filter.empty( ) );
+	}
+
+	void cuckoo_filter_bench( ) {
+		auto const hits = make_keys( 0, item_count );
+		auto const misses = make_keys( 1, item_count );
+		auto filter = daw::cuckoo_filter<>( item_count );
+		for( auto k : hits ) {
+			(void)filter.insert( k );
+		}
+		daw::bench_n_test<10>(
+		  "cuckoo_filter contains 1M misses",
+		  [&]( auto const &keys ) {
+			  std::size_t found = 0;
+			  for( auto k : keys ) {
+				  found += filter.contains( k ) ? 1U : 0U;
+			  }
+			  daw::do_not_optimize( found );
+			  return found;
+		  },
+		  misses );
+		auto results = std::vector<unsigned char>( item_count );
+		daw::bench_n_test<10>(
+		  "cuckoo_filter contains_batch 1M misses",
+		  [&]( auto const &keys ) {
+			  filter.contains_batch( keys.begin( ), keys.end( ), results.begin( ) );
+			  daw::do_not_optimize( results );
+			  return results.size( );
+		  },
+		  misses );
+	}
+} // namespace
+
+int main( ) {
+	cuckoo_filter_test_001( );
+	cuckoo_filter_fill_test( );
+	cuckoo_filter_overfill_test( );
+	cuckoo_filter_serialize_test( );
+	cuckoo_filter_default_test( );
+	cuckoo_filter_bench( );
+	std::cout << "done\n";
+}
@@ -0,0 +1,195 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include "daw/daw_dynamic_bitset.h"
+
+#include "daw/daw_benchmark.h"
+#include "daw/daw_random.h"
+
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+namespace {
+	daw::dynamic_bitset<> make_random_bitset( std::size_t sz, int density ) {
+		auto result = daw::dynamic_bitset<>( sz );
+		for( std::size_t n = 0; n < sz; ++n ) {
+			if( daw::randint( 0, 99 ) < density ) {
+				result.set( n );
+			}
+		}
+		return result;
+	}
+
+	std::size_t naive_count( daw::dynamic_bitset<> const &bs ) {
+		std::size_t result = 0;
+		for( std::size_t n = 0; n < bs.size( ); ++n ) {
+			if( bs[n] ) {
+				++result;
+			}
+		}
+		return result;
+	}
+
+	void dynamic_bitset_test_001( ) {
+		auto bs = daw::dynamic_bitset<>( 130 );
+		daw::expecting( bs.none( ) );
+		bs.set( 0 );
+		bs.set( 64 );
+		bs.set( 129 );
+		daw::expecting( 3U, bs.count( ) );
+		daw::expecting( bs.test( 64 ) );
+		daw::expecting( not bs.test( 65 ) );
+		bs.flip( );
+		daw::expecting( 127U, bs.count( ) );
+		bs.flip( );
+		bs.reset( 64 );
+		daw::expecting( 2U, bs.count( ) );
+		bs.set( );
+		daw::expecting( bs.all( ) );
+		daw::expecting( 130U, bs.count( ) );
+	}
+
+	void dynamic_bitset_test_002( ) {
+		auto bs = daw::dynamic_bitset<>( 70, true );
+		daw::expecting( 70U, bs.count( ) );
+		bs.resize( 200, true );
+		daw::expecting( 200U, bs.count( ) );
+		bs.resize( 65 );
+		daw::expecting( 65U, bs.count( ) );
+		bs.resize( 300 );
+		daw::expecting( 65U, bs.count( ) );
+	}
+
+	void dynamic_bitset_bulk_ops_test( ) {
+		for( std::size_t sz : { 1U, 63U, 64U, 65U, 1000U, 40'000U } ) {
+			auto const a = make_random_bitset( sz, 50 );
+			auto const b = make_random_bitset( sz, 30 );
+			auto const r_and = a & b;
+			auto const r_or = a | b;
+			auto const r_xor = a ^ b;
+			auto r_and_not = a;
+			r_and_not.and_not( b );
+			for( std::size_t n = 0; n < sz; ++n ) {
+				daw::expecting( a[n] and b[n], r_and[n] );
+				daw::expecting( a[n] or b[n], r_or[n] );
+				daw::expecting( a[n] != b[n], r_xor[n] );
+				daw::expecting( a[n] and not b[n], r_and_not[n] );
+			}
+			daw::expecting( naive_count( a ), a.count( ) );
+			daw::expecting( naive_count( r_xor ), r_xor.count( ) );
+		}
+	}
+
+	void dynamic_bitset_iteration_test( ) {
+		auto const bs = make_random_bitset( 10'000, 5 );
+		auto expected = std::vector<std::size_t>( );
+		for( std::size_t n = 0; n < bs.size( ); ++n ) {
+			if( bs[n] ) {
+				expected.push_back( n );
+			}
+		}
+		auto from_range = std::vector<std::size_t>( );
+		for( auto pos : bs.set_bits( ) ) {
+			from_range.push_back( pos );
+		}
+		daw::expecting( expected == from_range );
+
+		auto from_each = std::vector<std::size_t>( );
+		bs.for_each_set_bit( [&]( std::size_t pos ) {
+			from_each.push_back( pos );
+		} );
+		daw::expecting( expected == from_each );
+
+		auto from_find = std::vector<std::size_t>( );
+		for( auto pos = bs.find_first( ); pos != bs.npos;
+		     pos = bs.find_next( pos + 1 ) ) {
+			from_find.push_back( pos );
+		}
+		daw::expecting( expected == from_find );
+	}
+
+	void dynamic_bitset_rank_select_test( ) {
+		for( int density : { 1, 50, 99 } ) {
+			auto const bs = make_random_bitset( 100'003, density );
+			auto const rs = daw::bitset_rank_select( bs );
+			daw::expecting( bs.count( ), rs.count( ) );
+			std::size_t ones = 0;
+			for( std::size_t n = 0; n < bs.size( ); ++n ) {
+				daw::expecting( ones, rs.rank( n ) );
+				if( bs[n] ) {
+					daw::expecting( n, rs.select( ones ) );
+					++ones;
+				}
+			}
+			daw::expecting( ones, rs.rank( bs.size( ) ) );
+		}
+	}
+
+	void dynamic_bitset_bench( ) {
+		constexpr std::size_t bit_count = 1U << 24U;
+		auto const a = make_random_bitset( bit_count, 50 );
+		auto const b = make_random_bitset( bit_count, 50 );
+		daw::bench_n_test<20>(
+		  "dynamic_bitset count 16M bits",
+		  []( auto const &bs ) {
+			  auto result = bs.count( );
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  a );
+		daw::bench_n_test<20>(
+		  "dynamic_bitset naive word count 16M bits",
+		  []( auto const &bs ) {
+			  std::size_t result = 0;
+			  for( std::size_t n = 0; n < bs.word_count( ); ++n ) {
+				  result += daw::dyn_bitset_impl::popcount( bs.data( )[n] );
+			  }
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  a );
+		daw::bench_n_test<20>(
+		  "dynamic_bitset and 16M bits",
+		  []( auto lhs, auto const &rhs ) {
+			  lhs &= rhs;
+			  return lhs.word_count( );
+		  },
+		  a, b );
+		auto const rs = daw::bitset_rank_select( a );
+		auto const ones = rs.count( );
+		daw::bench_n_test<20>(
+		  "bitset_rank_select 1M select", [&]( std::size_t step ) {
+			  std::size_t result = 0;
+			  for( std::size_t n = 0; n < ones; n += step ) {
+				  result += rs.select( n );
+			  }
+			  return result;
+		  },
+		  std::size_t{ 8 } );
+		daw::bench_n_test<20>(
+		  "bitset_rank_select 2M rank", [&]( std::size_t step ) {
+			  std::size_t result = 0;
+			  for( std::size_t n = 0; n < bit_count; n += step ) {
+				  result += rs.rank( n );
+			  }
+			  return result;
+		  },
+		  std::size_t{ 8 } );
+	}
+} // namespace
+
+int main( ) {
+	dynamic_bitset_test_001( );
+	dynamic_bitset_test_002( );
+	dynamic_bitset_bulk_ops_test( );
+	dynamic_bitset_iteration_test( );
+	dynamic_bitset_rank_select_test( );
+	dynamic_bitset_bench( );
+	std::cout << "done\n";
+}
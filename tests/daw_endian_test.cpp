@@ -9,8 +9,13 @@
 #include "daw/daw_endian.h"
 
 #include "daw/daw_benchmark.h"
+#include "daw/daw_random.h"
 
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <vector>
 
 constexpr bool to_host_order_001( ) {
 	if( daw::endian::native == daw::endian::little ) {
@@ -23,4 +28,161 @@ constexpr bool to_host_order_001( ) {
 }
 static_assert( to_host_order_001( ) );
 
-int main( ) {}
+static_assert( daw::byte_swap( std::uint32_t{ 0x1234'5678U } ) == 0x7856'3412U );
+static_assert( daw::byte_swap( std::int16_t{ 0x0102 } ) == 0x0201 );
+
+constexpr bool byte_swap_in_place_001( ) {
+	std::uint64_t values[] = { 0x0102'0304'0506'0708ULL, 0x1122'3344'5566'7788ULL };
+	daw::byte_swap_in_place( daw::span<std::uint64_t>( values ) );
+	return values[0] == 0x0807'0605'0403'0201ULL and
+	       values[1] == 0x8877'6655'4433'2211ULL;
+}
+static_assert( byte_swap_in_place_001( ) );
+
+#if defined( DAW_CX_BIT_CAST )
+constexpr bool byte_swap_float_001( ) {
+	double values[] = { 1.5, -2.25 };
+	daw::byte_swap_in_place( daw::span<double>( values ) );
+	daw::byte_swap_in_place( daw::span<double>( values ) );
+	return values[0] == 1.5 and values[1] == -2.25 and
+	       daw::byte_swap( daw::byte_swap( 3.5f ) ) == 3.5f;
+}
+static_assert( byte_swap_float_001( ) );
+#endif
+
+template<typename T, typename = void>
+inline constexpr bool has_byte_swap_v = false;
+
+template<typename T>
+inline constexpr bool has_byte_swap_v<
+  T, std::void_t<decltype( daw::byte_swap( std::declval<T>( ) ) )>> = true;
+
+static_assert( has_byte_swap_v<double> );
+static_assert( has_byte_swap_v<long double> == ( sizeof( long double ) <= 8 ) );
+
+struct test_writer {
+	unsigned char *m_first;
+	std::size_t m_size;
+
+	unsigned char *data( ) {
+		return m_first;
+	}
+
+	std::size_t size( ) const {
+		return m_size;
+	}
+
+	void remove_prefix( std::size_t n ) {
+		m_first += n;
+		m_size -= n;
+	}
+};
+
+template<typename T>
+void bulk_swap_test( ) {
+	for( std::size_t sz = 0; sz < 100; ++sz ) {
+		auto const values = daw::make_random_data<T>( sz );
+		auto expected = values;
+		for( auto &v : expected ) {
+			v = daw::byte_swap( v );
+		}
+		auto in_place = values;
+		daw::byte_swap_in_place( daw::span<T>( in_place.data( ), in_place.size( ) ) );
+		daw::expecting( expected == in_place );
+
+		auto copied = std::vector<T>( sz );
+		daw::byte_swap_copy( daw::span<T const>( values.data( ), values.size( ) ),
+		                     daw::span<T>( copied.data( ), copied.size( ) ) );
+		daw::expecting( expected == copied );
+
+		// Round trip through unaligned big endian bytes
+		auto bytes = std::vector<unsigned char>( sz * sizeof( T ) + 1U );
+		daw::store_endian<daw::endian::big>(
+		  bytes.data( ) + 1, daw::span<T const>( values.data( ), values.size( ) ) );
+		for( std::size_t n = 0; n < sz; ++n ) {
+			daw::expecting( values[n], daw::load_endian<daw::endian::big, T>(
+			                             bytes.data( ) + 1 + n * sizeof( T ) ) );
+			daw::expecting( bytes[1 + n * sizeof( T )] ==
+			                static_cast<unsigned char>( values[n] >> ( 8U * ( sizeof( T ) - 1U ) ) ) );
+		}
+		auto loaded = std::vector<T>( sz );
+		daw::load_endian<daw::endian::big>( bytes.data( ) + 1,
+		                                    daw::span<T>( loaded.data( ), loaded.size( ) ) );
+		daw::expecting( values == loaded );
+
+		auto native = std::vector<T>( sz );
+		daw::to_native_endian_copy<daw::endian::big>(
+		  daw::span<T const>( expected.data( ), expected.size( ) ),
+		  daw::span<T>( native.data( ), native.size( ) ) );
+		if constexpr( daw::endian::native == daw::endian::little ) {
+			daw::expecting( values == native );
+		}
+	}
+}
+
+void float_test( ) {
+	auto values = std::vector<double>{ 1.5, -2.25, 1e300 };
+	auto bytes = std::vector<unsigned char>( values.size( ) * sizeof( double ) );
+	auto w = test_writer{ bytes.data( ), bytes.size( ) };
+	daw::write_endian<daw::endian::big>( w, values[0] );
+	daw::write_endian<daw::endian::big>(
+	  w, daw::span<double const>( values.data( ) + 1, 2 ) );
+	daw::expecting( 0U, w.size( ) );
+	// IEEE 754 1.5 is 0x3FF8'0000'0000'0000
+	daw::expecting( bytes[0] == 0x3FU and bytes[1] == 0xF8U );
+	for( std::size_t n = 0; n < values.size( ); ++n ) {
+		daw::expecting( values[n], daw::load_endian<daw::endian::big, double>(
+		                             bytes.data( ) + n * sizeof( double ) ) );
+	}
+	auto round = values;
+	daw::from_native_endian_in_place<daw::endian::big>(
+	  daw::span<double>( round.data( ), round.size( ) ) );
+	daw::to_native_endian_in_place<daw::endian::big>(
+	  daw::span<double>( round.data( ), round.size( ) ) );
+	daw::expecting( values == round );
+}
+
+template<typename T>
+void endian_bench( ) {
+	constexpr std::size_t count = 64U * 1024U * 1024U / sizeof( T );
+	std::cout << "uint" << 8U * sizeof( T ) << "_t\n";
+	auto const values = daw::make_random_data<T>( count );
+	auto out = std::vector<T>( count );
+	auto const bytes = count * sizeof( T );
+	(void)daw::bench_n_test_mbs<10>(
+	  "scalar loop", bytes,
+	  [&]( std::vector<T> const &v ) {
+		  for( std::size_t n = 0; n < v.size( ); ++n ) {
+			  out[n] = daw::to_big_endian( v[n] );
+		  }
+		  daw::do_not_optimize( out );
+	  },
+	  values );
+	(void)daw::bench_n_test_mbs<10>(
+	  "byte_swap_copy", bytes,
+	  [&]( std::vector<T> const &v ) {
+		  daw::byte_swap_copy( daw::span<T const>( v.data( ), v.size( ) ),
+		                       daw::span<T>( out.data( ), out.size( ) ) );
+		  daw::do_not_optimize( out );
+	  },
+	  values );
+	(void)daw::bench_n_test_mbs<10>(
+	  "byte_swap_in_place", bytes,
+	  [&]( std::vector<T> const & ) {
+		  daw::byte_swap_in_place( daw::span<T>( out.data( ), out.size( ) ) );
+		  daw::do_not_optimize( out );
+	  },
+	  values );
+}
+
+int main( ) {
+	bulk_swap_test<std::uint16_t>( );
+	bulk_swap_test<std::uint32_t>( );
+	bulk_swap_test<std::uint64_t>( );
+	bulk_swap_test<std::int32_t>( );
+	float_test( );
+	endian_bench<std::uint16_t>( );
+	endian_bench<std::uint32_t>( );
+	endian_bench<std::uint64_t>( );
+	std::cout << "done\n";
+}
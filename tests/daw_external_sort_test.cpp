@@ -0,0 +1,201 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include <daw/daw_external_sort.h>
+
+#include <daw/daw_benchmark.h>
+#include <daw/daw_random.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+	struct record_t {
+		std::uint32_t key;
+		std::uint32_t order;
+	};
+
+	struct by_key {
+		constexpr bool operator( )( record_t const &l,
+		                            record_t const &r ) const noexcept {
+			return l.key < r.key;
+		}
+	};
+
+	daw::external_sort_options small_runs( daw::external_sort_io io ) {
+		auto opts = daw::external_sort_options{ };
+		opts.run_bytes = 4096U * sizeof( std::uint64_t );
+		opts.block_bytes = 512U * sizeof( std::uint64_t );
+		opts.io = io;
+		return opts;
+	}
+
+	template<typename T>
+	void write_file( std::filesystem::path const &p, std::vector<T> const &v ) {
+		auto f = daw::external_sort_details::open_file( p, "wb" );
+		daw::external_sort_details::write_records( f.get( ), v.data( ), v.size( ) );
+	}
+
+	template<typename T>
+	std::vector<T> read_file( std::filesystem::path const &p ) {
+		auto result = std::vector<T>( std::filesystem::file_size( p ) / sizeof( T ) );
+		auto f = daw::external_sort_details::open_file( p, "rb" );
+		auto const count =
+		  std::fread( result.data( ), sizeof( T ), result.size( ), f.get( ) );
+		daw::expecting( result.size( ), count );
+		return result;
+	}
+
+	void external_sorter_test( daw::external_sort_io io ) {
+		auto const data =
+		  daw::make_random_data<std::uint64_t>( 50'000, 0, 1'000'000 );
+		auto sorter = daw::external_sorter<std::uint64_t>( small_runs( io ) );
+		sorter.append( data.begin( ), data.end( ) );
+		daw::expecting( data.size( ) / 4096U, sorter.runs_written( ) );
+
+		auto merged = sorter.finish( );
+		daw::expecting( data.size( ), merged.size( ) );
+		daw::expecting( data.size( ) / 4096U + 1U, merged.run_count( ) );
+		auto const result = std::vector<std::uint64_t>( merged.begin( ), merged.end( ) );
+		auto expected = data;
+		std::sort( expected.begin( ), expected.end( ) );
+		daw::expecting( expected == result );
+		daw::expecting( merged.begin( ) == merged.end( ) );
+	}
+
+	void external_sorter_stable_test( ) {
+		auto sorter = daw::external_sorter<record_t, by_key>(
+		  small_runs( daw::external_sort_io::buffered ) );
+		auto const keys = daw::make_random_data<std::uint32_t>( 20'000, 0, 99 );
+		for( std::size_t n = 0; n < keys.size( ); ++n ) {
+			sorter.push_back( record_t{ keys[n], static_cast<std::uint32_t>( n ) } );
+		}
+		daw::expecting( sorter.runs_written( ) > 0 );
+		auto merged = sorter.finish( );
+		auto last = record_t{ 0, 0 };
+		std::size_t count = 0;
+		for( auto const &r : merged ) {
+			if( count > 0 ) {
+				daw::expecting( last.key <= r.key );
+				// Runs are sorted with an unstable sort, equal keys only keep the
+				// order of the runs they came from
+				if( last.key == r.key and last.order / 4096U != r.order / 4096U ) {
+					daw::expecting( last.order < r.order );
+				}
+			}
+			last = r;
+			++count;
+		}
+		daw::expecting( keys.size( ), count );
+	}
+
+	void external_sorter_edge_test( ) {
+		auto empty = daw::external_sorter<int>( ).finish( );
+		daw::expecting( 0U, empty.size( ) );
+		daw::expecting( empty.begin( ) == empty.end( ) );
+
+		auto single = daw::external_sorter<int>( );
+		for( int x : { 5, 3, 9, 1 } ) {
+			single.push_back( x );
+		}
+		daw::expecting( 0U, single.runs_written( ) );
+		auto merged = single.finish( );
+		daw::expecting( std::vector<int>{ 1, 3, 5, 9 } ==
+		                std::vector<int>( merged.begin( ), merged.end( ) ) );
+
+		auto view = daw::external_merge_view<int>( );
+		daw::expecting( view.begin( ) == view.end( ) );
+	}
+
+	void external_sort_file_test( daw::external_sort_io io ) {
+		auto const dir = std::filesystem::temp_directory_path( );
+		auto const in_path = dir / "daw_external_sort_test_in.bin";
+		auto const out_path = dir / "daw_external_sort_test_out.bin";
+		auto const data =
+		  daw::make_random_data<std::uint64_t>( 30'000, 0, 1'000'000'000 );
+		write_file( in_path, data );
+
+		auto const count =
+		  daw::external_sort_file<std::uint64_t>( in_path, out_path, small_runs( io ) );
+		daw::expecting( data.size( ), count );
+		auto expected = data;
+		std::sort( expected.begin( ), expected.end( ) );
+		daw::expecting( expected == read_file<std::uint64_t>( out_path ) );
+
+		auto const desc = daw::external_sort_file<std::uint64_t>(
+		  in_path, out_path, small_runs( io ), std::greater<>{ } );
+		daw::expecting( data.size( ), desc );
+		std::reverse( expected.begin( ), expected.end( ) );
+		daw::expecting( expected == read_file<std::uint64_t>( out_path ) );
+
+		std::filesystem::remove( in_path );
+		std::filesystem::remove( out_path );
+	}
+
+	void external_sort_bench( ) {
+		constexpr std::size_t count = 4'000'000;
+		auto const dir = std::filesystem::temp_directory_path( );
+		auto const in_path = dir / "daw_external_sort_bench_in.bin";
+		auto const out_path = dir / "daw_external_sort_bench_out.bin";
+		auto const data =
+		  daw::make_random_data<std::uint64_t>( count, 0, 1'000'000'000'000 );
+		write_file( in_path, data );
+		auto const bytes = count * sizeof( std::uint64_t );
+
+		(void)daw::bench_n_test_mbs<5>(
+		  "in memory std::sort", bytes,
+		  []( std::vector<std::uint64_t> d ) {
+			  std::sort( d.begin( ), d.end( ) );
+			  daw::do_not_optimize( d );
+			  return d.size( );
+		  },
+		  data );
+
+		auto opts = daw::external_sort_options{ };
+		opts.run_bytes = std::size_t{ 4U } * 1024U * 1024U;
+		opts.block_bytes = std::size_t{ 256U } * 1024U;
+		(void)daw::bench_n_test_mbs<5>(
+		  "external_sort_file buffered, 4MB runs", bytes,
+		  [&]( daw::external_sort_options const &o ) {
+			  auto result = daw::external_sort_file<std::uint64_t>( in_path, out_path, o );
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  opts );
+
+		opts.io = daw::external_sort_io::memory_mapped;
+		(void)daw::bench_n_test_mbs<5>(
+		  "external_sort_file memory mapped, 4MB runs", bytes,
+		  [&]( daw::external_sort_options const &o ) {
+			  auto result = daw::external_sort_file<std::uint64_t>( in_path, out_path, o );
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  opts );
+
+		std::filesystem::remove( in_path );
+		std::filesystem::remove( out_path );
+	}
+} // namespace
+
+int main( ) {
+	external_sorter_test( daw::external_sort_io::buffered );
+	external_sorter_test( daw::external_sort_io::memory_mapped );
+	external_sorter_stable_test( );
+	external_sorter_edge_test( );
+	external_sort_file_test( daw::external_sort_io::buffered );
+	external_sort_file_test( daw::external_sort_io::memory_mapped );
+	external_sort_bench( );
+	std::cout << "done\n";
+}
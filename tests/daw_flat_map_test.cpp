@@ -0,0 +1,354 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include <daw/daw_flat_map.h>
+#include <daw/daw_flat_set.h>
+
+#include <daw/daw_benchmark.h>
+#include <daw/daw_ensure.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <version>
+
+#if defined( __cpp_lib_flat_map )
+#include <flat_map>
+#endif
+
+namespace {
+	template<typename T>
+	std::vector<T> random_values( std::size_t count, T lo, T hi,
+	                              std::uint64_t seed = 42 ) {
+		auto engine = std::mt19937_64( seed );
+		auto dist = std::uniform_int_distribution<T>( lo, hi );
+		auto result = std::vector<T>( count );
+		for( auto &v : result ) {
+			v = dist( engine );
+		}
+		return result;
+	}
+
+	/// Every size and tail length around the block and k-ary step boundaries,
+	/// with keys below, between, on and above the elements
+	template<typename T>
+	void simd_lower_bound_test( ) {
+		constexpr T lo = std::numeric_limits<T>::min( );
+		constexpr T hi = std::numeric_limits<T>::max( );
+		auto comp = std::less<T>{ };
+		for( std::size_t n : { 0U, 1U, 2U, 7U, 8U, 63U, 64U, 65U, 100U, 577U,
+		                       5'000U, 100'003U } ) {
+			auto values = random_values<T>( n, lo, hi, n );
+			std::sort( values.begin( ), values.end( ) );
+			auto probes = random_values<T>( 200, lo, hi, n + 1U );
+			probes.push_back( lo );
+			probes.push_back( hi );
+			probes.push_back( T{ 0 } );
+			for( std::size_t i = 0; i < values.size( ); i += values.size( ) / 50U + 1U ) {
+				probes.push_back( values[i] );
+			}
+			for( auto key : probes ) {
+				auto const expected = static_cast<std::size_t>(
+				  std::lower_bound( values.begin( ), values.end( ), key ) -
+				  values.begin( ) );
+				daw_ensure( daw::flat_impl::lower_bound_index<daw::flat_search::automatic>(
+				              values.data( ), n, key, comp ) == expected );
+				daw_ensure( daw::flat_impl::branchless_lower_bound( values.data( ), n,
+				                                                     key, comp ) ==
+				            expected );
+			}
+		}
+	}
+
+	void flat_set_test( ) {
+		auto s = daw::flat_set<int>{ 5, 1, 3, 3, 9 };
+		daw_ensure( s.size( ) == 4U );
+		daw_ensure( std::is_sorted( s.begin( ), s.end( ) ) );
+		daw_ensure( s.insert( 4 ).second and not s.insert( 4 ).second );
+		daw_ensure( s.contains( 9 ) and not s.contains( 2 ) );
+		daw_ensure( *s.lower_bound( 6 ) == 9 and *s.upper_bound( 3 ) == 4 );
+		daw_ensure( s.erase( 3 ) == 1U and s.erase( 3 ) == 0U );
+		int const sorted[] = { 0, 2, 4, 100 };
+		s.insert( daw::sorted_unique, std::begin( sorted ), std::end( sorted ) );
+		daw_ensure( s == ( daw::flat_set<int>{ 0, 1, 2, 4, 5, 9, 100 } ) );
+		daw_ensure( s.find( 7 ) == s.end( ) and *s.find( 5 ) == 5 );
+
+		auto reference = std::set<std::uint32_t>( );
+		auto fs = daw::flat_set<std::uint32_t>( );
+		auto branchless =
+		  daw::flat_set<std::uint32_t, std::less<std::uint32_t>,
+		                daw::vector<std::uint32_t>, daw::flat_search::branchless>( );
+		for( std::uint64_t round = 0; round < 20; ++round ) {
+			auto const batch =
+			  random_values<std::uint32_t>( 1'000U * round, 0, 50'000, round );
+			reference.insert( batch.begin( ), batch.end( ) );
+			fs.insert( batch.begin( ), batch.end( ) );
+			branchless.insert( batch.begin( ), batch.end( ) );
+			daw_ensure( std::equal( reference.begin( ), reference.end( ), fs.begin( ),
+			                        fs.end( ) ) );
+			daw_ensure( std::equal( fs.begin( ), fs.end( ), branchless.begin( ),
+			                        branchless.end( ) ) );
+			for( auto key : random_values<std::uint32_t>( 100, 0, 60'000, round ) ) {
+				daw_ensure( fs.contains( key ) == ( reference.count( key ) == 1U ) );
+				daw_ensure( branchless.contains( key ) == fs.contains( key ) );
+				if( key % 3U == 0 ) {
+					daw_ensure( fs.erase( key ) == reference.erase( key ) );
+					(void)branchless.erase( key );
+				}
+			}
+		}
+
+		auto strings = daw::flat_set<std::string, std::less<>,
+		                             std::vector<std::string>>{ "b", "a", "c", "a" };
+		daw_ensure( strings.size( ) == 3U and strings.contains( "b" ) );
+		daw_ensure( strings.keys( ).front( ) == "a" );
+	}
+
+	/// A key whose copies throw while fail_copies is set
+	struct throwing_key {
+		static inline bool fail_copies = false;
+		int k = 0;
+
+		explicit throwing_key( int x )
+		  : k( x ) {}
+
+		throwing_key( throwing_key const &other )
+		  : k( other.k ) {
+			if( fail_copies ) {
+				throw std::runtime_error( "throwing_key" );
+			}
+		}
+
+		throwing_key( throwing_key && ) = default;
+		throwing_key &operator=( throwing_key const & ) = default;
+		throwing_key &operator=( throwing_key && ) = default;
+		~throwing_key( ) = default;
+
+		friend bool operator<( throwing_key const &l, throwing_key const &r ) {
+			return l.k < r.k;
+		}
+	};
+
+	void flat_map_test( ) {
+		auto m = daw::flat_map<int, std::string>{
+		  { 3, "three" }, { 1, "one" }, { 2, "two" }, { 1, "uno" } };
+		daw_ensure( m.size( ) == 3U );
+		daw_ensure( m.begin( )->first == 1 and m.at( 2 ) == "two" );
+		m[4] = "four";
+		daw_ensure( m.size( ) == 4U and m.find( 4 )->second == "four" );
+		daw_ensure( not m.try_emplace( 4, "vier" ).second );
+		daw_ensure( not m.insert_or_assign( 4, "vier" ).second and m[4] == "vier" );
+		bool threw = false;
+		try {
+			(void)m.at( 42 );
+		} catch( std::out_of_range const & ) { threw = true; }
+		daw_ensure( threw );
+
+		// Bulk insertion keeps the values of keys that are present
+		auto more = std::vector<std::pair<int, std::string>>{
+		  { 0, "zero" }, { 3, "drei" }, { 7, "seven" }, { 5, "five" } };
+		m.insert( more.begin( ), more.end( ) );
+		daw_ensure( m.size( ) == 7U and m.at( 3 ) == "three" and m.at( 5 ) == "five" );
+		daw_ensure( std::is_sorted( m.keys( ).begin( ), m.keys( ).end( ) ) );
+		daw_ensure( m.erase( 0 ) == 1U and m.begin( )->first == 1 );
+		auto it = m.erase( m.find( 5 ) );
+		daw_ensure( it->first == 7 and m.size( ) == 5U );
+		for( auto [k, v] : m ) {
+			daw_ensure( m.at( k ) == v );
+		}
+		// A value that fails to construct leaves the keys and values in step
+		struct throwing_value {
+			int v = 0;
+			explicit throwing_value( int x )
+			  : v( x ) {
+				if( x < 0 ) {
+					throw std::runtime_error( "throwing_value" );
+				}
+			}
+		};
+		auto tm = daw::flat_map<int, throwing_value>( );
+		(void)tm.try_emplace( 1, 1 );
+		(void)tm.try_emplace( 3, 3 );
+		threw = false;
+		try {
+			(void)tm.try_emplace( 2, -1 );
+		} catch( std::runtime_error const & ) { threw = true; }
+		daw_ensure( threw and tm.size( ) == 2U and tm.values( ).size( ) == 2U );
+		daw_ensure( not tm.contains( 2 ) and tm.at( 3 ).v == 3 );
+
+		auto km = daw::flat_map<throwing_key, int>( );
+		km[throwing_key( 1 )] = 1;
+		km[throwing_key( 3 )] = 3;
+		throwing_key::fail_copies = true;
+		threw = false;
+		try {
+			km[throwing_key( 2 )] = 2;
+		} catch( std::runtime_error const & ) { threw = true; }
+		throwing_key::fail_copies = false;
+		daw_ensure( threw and km.keys( ).size( ) == 2U and
+		            km.values( ).size( ) == 2U );
+		daw_ensure( km.at( throwing_key( 3 ) ) == 3 );
+
+		// Other key types are converted unless the comparison is transparent
+		static_assert( daw::flat_impl::is_transparent_v<std::less<>> );
+		static_assert( not daw::flat_impl::is_transparent_v<std::less<int>> );
+		auto names = daw::flat_map<std::string, int>{ { "a", 1 }, { "b", 2 } };
+		daw_ensure( names.find( "b" )->second == 2 and names.contains( "a" ) );
+		auto tnames =
+		  daw::flat_map<std::string, int, std::less<>>{ { "a", 1 }, { "b", 2 } };
+		daw_ensure( tnames.find( std::string_view( "b" ) )->second == 2 );
+		daw_ensure( tnames.count( std::string_view( "c" ) ) == 0U );
+
+		auto const &cm = m;
+		daw_ensure( cm.lower_bound( 6 )->first == 7 and cm.upper_bound( 7 ) == cm.end( ) );
+		auto parts = std::move( m ).extract( );
+		daw_ensure( parts.keys.size( ) == 5U and parts.values.size( ) == 5U );
+
+		auto reference = std::map<std::uint64_t, std::uint64_t>( );
+		auto fm = daw::flat_map<std::uint64_t, std::uint64_t>( );
+		for( std::uint64_t round = 0; round < 20; ++round ) {
+			auto const keys =
+			  random_values<std::uint64_t>( 1'000U * round, 0, 40'000, round );
+			auto batch = std::vector<std::pair<std::uint64_t, std::uint64_t>>( );
+			for( auto k : keys ) {
+				batch.emplace_back( k, k * 2U + round );
+			}
+			// The first of equal keys in a batch is not specified, use one value
+			std::sort( batch.begin( ), batch.end( ) );
+			batch.erase( std::unique( batch.begin( ), batch.end( ),
+			                          []( auto const &l, auto const &r ) {
+				                          return l.first == r.first;
+			                          } ),
+			             batch.end( ) );
+			reference.insert( batch.begin( ), batch.end( ) );
+			if( round % 2U == 0 ) {
+				fm.insert( batch.begin( ), batch.end( ) );
+			} else {
+				fm.insert( daw::sorted_unique, batch.begin( ), batch.end( ) );
+			}
+			daw_ensure( fm.size( ) == reference.size( ) );
+			daw_ensure( std::equal( reference.begin( ), reference.end( ), fm.begin( ),
+			                        fm.end( ), []( auto const &l, auto const &r ) {
+				                        return l.first == r.first and
+				                               l.second == r.second;
+			                        } ) );
+			for( auto key : random_values<std::uint64_t>( 100, 0, 50'000, round ) ) {
+				auto const ref = reference.find( key );
+				auto const pos = fm.find( key );
+				daw_ensure( ( ref == reference.end( ) ) == ( pos == fm.end( ) ) );
+				if( key % 4U == 0 ) {
+					daw_ensure( fm.erase( key ) == reference.erase( key ) );
+				}
+			}
+		}
+	}
+
+	constexpr bool constexpr_test( ) {
+		auto s = daw::flat_set<int>{ 3, 1, 2 };
+		auto m = daw::flat_map<int, int>( );
+		m.insert_or_assign( 2, 20 );
+		m.insert_or_assign( 1, 10 );
+		return s.contains( 2 ) and *s.begin( ) == 1 and m.at( 1 ) == 10 and
+		       m.begin( )->first == 1;
+	}
+	static_assert( constexpr_test( ) );
+
+	void flat_map_bench( ) {
+		constexpr std::size_t lookups = 1'000'000;
+		// The read heavy workload: build once, then only look up.  std::map is
+		// only built up to 1M keys to keep the run short.
+		for( std::size_t n : { 1'000U, 100'000U, 1'000'000U, 10'000'000U } ) {
+			std::cout << "---- " << n << " keys ----\n";
+			auto keys = std::vector<std::uint64_t>( n );
+			std::iota( keys.begin( ), keys.end( ), std::uint64_t{ 0 } );
+			for( auto &k : keys ) {
+				k = k * 7U + 3U;
+			}
+			std::shuffle( keys.begin( ), keys.end( ), std::mt19937_64( n ) );
+			auto pairs = std::vector<std::pair<std::uint64_t, std::uint64_t>>( );
+			pairs.reserve( n );
+			for( auto k : keys ) {
+				pairs.emplace_back( k, k );
+			}
+			auto const probes =
+			  random_values<std::uint64_t>( lookups, 0, n * 7U + 3U, n + 1U );
+
+			auto fm = daw::flat_map<std::uint64_t, std::uint64_t>( );
+			(void)daw::bench_n_test<1>( "flat_map bulk insert", [&] {
+				fm.clear( );
+				fm.insert( pairs.begin( ), pairs.end( ) );
+				return fm.size( );
+			} );
+			auto lookup = [&]( auto const &map ) {
+				std::uint64_t sum = 0;
+				for( auto key : probes ) {
+					auto it = map.find( key );
+					if( it != map.end( ) ) {
+						sum += it->second;
+					}
+				}
+				daw::do_not_optimize( sum );
+				return sum;
+			};
+			auto const expected = lookup( fm );
+			(void)daw::bench_n_test<3>( "flat_map find, SIMD search", [&] {
+				daw_ensure( lookup( fm ) == expected );
+			} );
+
+			auto bm = daw::flat_map<std::uint64_t, std::uint64_t,
+			                        std::less<std::uint64_t>,
+			                        daw::vector<std::uint64_t>,
+			                        daw::vector<std::uint64_t>,
+			                        daw::flat_search::branchless>( );
+			bm.insert( pairs.begin( ), pairs.end( ) );
+			(void)daw::bench_n_test<3>( "flat_map find, branchless search", [&] {
+				daw_ensure( lookup( bm ) == expected );
+			} );
+
+			if( n <= 1'000'000U ) {
+				auto sm = std::map<std::uint64_t, std::uint64_t>( );
+				(void)daw::bench_n_test<1>( "std::map insert", [&] {
+					sm.clear( );
+					sm.insert( pairs.begin( ), pairs.end( ) );
+					return sm.size( );
+				} );
+				(void)daw::bench_n_test<3>( "std::map find", [&] {
+					daw_ensure( lookup( sm ) == expected );
+				} );
+			}
+#if defined( __cpp_lib_flat_map )
+			auto stdfm = std::flat_map<std::uint64_t, std::uint64_t>(
+			  pairs.begin( ), pairs.end( ) );
+			(void)daw::bench_n_test<3>( "std::flat_map find", [&] {
+				daw_ensure( lookup( stdfm ) == expected );
+			} );
+#endif
+		}
+	}
+} // namespace
+
+int main( ) {
+	simd_lower_bound_test<std::int32_t>( );
+	simd_lower_bound_test<std::uint32_t>( );
+	simd_lower_bound_test<std::int64_t>( );
+	simd_lower_bound_test<std::uint64_t>( );
+	flat_set_test( );
+	flat_map_test( );
+	flat_map_bench( );
+	std::cout << "done\n";
+}
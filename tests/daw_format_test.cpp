@@ -0,0 +1,125 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include <daw/format.h>
+
+#include <daw/daw_benchmark.h>
+
+#include <array>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+	using fmt_0 = daw::compiled_format<"x = {}, y = {}">;
+	static_assert( fmt_0::arg_count == 2 );
+	static_assert( fmt_0::literal_size == 10 );
+	static_assert( fmt_0::segment_count == 4 );
+	static_assert( fmt_0::max_size<int, char>( ) == 10 + 11 + 1 );
+	static_assert( fmt_0::max_size<int, std::string>( ) ==
+	               daw::dynamic_format_size );
+
+	using fmt_1 = daw::compiled_format<"{{{1}}} {0} {1}">;
+	static_assert( fmt_1::arg_count == 2 );
+
+	void format_test_001( ) {
+		auto buff = std::array<char, 64>{ };
+		char *last = daw::format_to( buff.data( ),
+		                             daw::compiled_fmt<"x = {}, y = {}">, 42, 'c' );
+		daw::expecting( std::string( "x = 42, y = c" ),
+		                std::string( buff.data( ), last ) );
+		daw::expecting( 13U, daw::formatted_size( daw::compiled_fmt<"x = {}, y = {}">,
+		                                          42, 'c' ) );
+	}
+
+	void format_test_indexed( ) {
+		daw::expecting( std::string( "{b} a b" ),
+		                daw::format( daw::compiled_fmt<"{{{1}}} {0} {1}">, "a",
+		                             std::string( "b" ) ) );
+		daw::expecting( std::string( "no args" ),
+		                daw::format( daw::compiled_fmt<"no args"> ) );
+		daw::expecting( std::string( "-1.5true" ),
+		                daw::format( daw::compiled_fmt<"{}{}">, -1.5, true ) );
+	}
+
+	void format_test_append( ) {
+		auto str = std::string( "log: " );
+		daw::format_append( str, daw::compiled_fmt<"{} of {}">, 1U, 10U );
+		daw::expecting( std::string( "log: 1 of 10" ), str );
+		auto vec = std::vector<char>( );
+		daw::format_append( vec, daw::compiled_fmt<"[{}]">, -7 );
+		daw::expecting( std::string( "[-7]" ),
+		                std::string( vec.data( ), vec.size( ) ) );
+	}
+
+	struct test_writer {
+		char *first;
+		std::size_t len;
+
+		char *data( ) const {
+			return first;
+		}
+
+		std::size_t size( ) const {
+			return len;
+		}
+
+		void remove_prefix( std::size_t n ) {
+			first += n;
+			len -= n;
+		}
+	};
+
+	void format_test_writer( ) {
+		auto buff = std::array<char, 32>{ };
+		auto writer = test_writer{ buff.data( ), buff.size( ) };
+		daw::format_to( writer, daw::compiled_fmt<"{}={};">, "a", 1 );
+		daw::format_to( writer, daw::compiled_fmt<"{}={};">, "b", 2 );
+		daw::expecting( std::string( "a=1;b=2;" ), std::string( buff.data( ), 8 ) );
+		daw::expecting( buff.size( ) - 8U, writer.size( ) );
+
+		// Arrays decay to the char * overload
+		char arr[8]{ };
+		char *last = daw::format_to( arr, daw::compiled_fmt<"{}!">, 42 );
+		daw::expecting( std::string( "42!" ), std::string( arr, last ) );
+	}
+
+	void format_bench( ) {
+		auto buff = std::array<char, 128>{ };
+		daw::bench_n_test<100'000>(
+		  "snprintf",
+		  [&]( int x, double y ) {
+			  auto const r = std::snprintf( buff.data( ), buff.size( ),
+			                                "x = %d, y = %g, name = %s", x, y,
+			                                "some name" );
+			  daw::do_not_optimize( buff );
+			  return r;
+		  },
+		  123456, 0.5 );
+		daw::bench_n_test<100'000>(
+		  "daw::format_to( compiled_fmt )",
+		  [&]( int x, double y ) {
+			  auto *last = daw::format_to(
+			    buff.data( ), daw::compiled_fmt<"x = {}, y = {}, name = {}">, x, y,
+			    "some name" );
+			  daw::do_not_optimize( buff );
+			  return last - buff.data( );
+		  },
+		  123456, 0.5 );
+	}
+} // namespace
+
+int main( ) {
+	format_test_001( );
+	format_test_indexed( );
+	format_test_append( );
+	format_test_writer( );
+	format_bench( );
+	std::cout << "done\n";
+}
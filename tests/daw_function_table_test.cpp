@@ -8,9 +8,14 @@
 
 #include "daw/daw_function_table.h"
 
+#include "daw/daw_benchmark.h"
+#include "daw/daw_random.h"
+
+#include <algorithm>
 #include <cstdint>
 #include <iostream>
 #include <type_traits>
+#include <vector>
 
 using parser_func_t = std::add_pointer_t<uintmax_t( uintmax_t, char const * )>;
 
@@ -176,6 +181,213 @@ inline constexpr daw::function_table_t<uintmax_t,
 	          return ftable( static_cast<size_t>( *c ), n, c );
           } };
 
+namespace {
+	using binop_t = std::add_pointer_t<std::uint32_t( std::uint32_t, std::uint32_t )>;
+
+	std::uint32_t op_add( std::uint32_t a, std::uint32_t b ) {
+		return a + b;
+	}
+	std::uint32_t op_sub( std::uint32_t a, std::uint32_t b ) {
+		return a - b;
+	}
+	std::uint32_t op_mul( std::uint32_t a, std::uint32_t b ) {
+		return a * b;
+	}
+	std::uint32_t op_xor( std::uint32_t a, std::uint32_t b ) {
+		return a ^ b;
+	}
+	std::uint32_t op_and( std::uint32_t a, std::uint32_t b ) {
+		return a & b;
+	}
+	std::uint32_t op_or( std::uint32_t a, std::uint32_t b ) {
+		return a | b;
+	}
+	std::uint32_t op_min( std::uint32_t a, std::uint32_t b ) {
+		return std::min( a, b );
+	}
+	std::uint32_t op_max( std::uint32_t a, std::uint32_t b ) {
+		return std::max( a, b );
+	}
+
+	constexpr std::size_t op_count = 8;
+
+	std::uint32_t switch_op( std::uint8_t idx, std::uint32_t a, std::uint32_t b ) {
+		switch( idx ) {
+		case 0:
+			return a + b;
+		case 1:
+			return a - b;
+		case 2:
+			return a * b;
+		case 3:
+			return a ^ b;
+		case 4:
+			return a & b;
+		case 5:
+			return a | b;
+		case 6:
+			return std::min( a, b );
+		default:
+			return std::max( a, b );
+		}
+	}
+
+	auto const binop_table =
+	  daw::make_function_table<std::uint32_t>( op_add, op_sub, op_mul, op_xor,
+	                                           op_and, op_or, op_min, op_max );
+
+	auto const lambda_table = daw::make_function_table<std::uint32_t>(
+	  []( std::uint32_t a, std::uint32_t b ) {
+		  return a + b;
+	  },
+	  []( std::uint32_t a, std::uint32_t b ) {
+		  return a - b;
+	  },
+	  []( std::uint32_t a, std::uint32_t b ) {
+		  return a * b;
+	  },
+	  []( std::uint32_t a, std::uint32_t b ) {
+		  return a ^ b;
+	  },
+	  []( std::uint32_t a, std::uint32_t b ) {
+		  return a & b;
+	  },
+	  []( std::uint32_t a, std::uint32_t b ) {
+		  return a | b;
+	  },
+	  []( std::uint32_t a, std::uint32_t b ) {
+		  return std::min( a, b );
+	  },
+	  []( std::uint32_t a, std::uint32_t b ) {
+		  return std::max( a, b );
+	  } );
+
+	/// Interpreter state for the threaded table, each op consumes one element
+	struct cursor {
+		std::uint32_t const *a;
+		std::uint32_t const *b;
+		std::uint32_t *out;
+		std::size_t n = 0;
+	};
+
+	template<binop_t Op>
+	void threaded_op( cursor &c ) {
+		c.out[c.n] = Op( c.a[c.n], c.b[c.n] );
+		++c.n;
+	}
+
+	using threaded_binops_t =
+	  daw::threaded_function_table<&threaded_op<op_add>, &threaded_op<op_sub>,
+	                               &threaded_op<op_mul>, &threaded_op<op_xor>,
+	                               &threaded_op<op_and>, &threaded_op<op_or>,
+	                               &threaded_op<op_min>, &threaded_op<op_max>>;
+
+	std::vector<std::uint8_t> make_program( std::size_t count,
+	                                        std::size_t max_run ) {
+		auto result = std::vector<std::uint8_t>( );
+		result.reserve( count );
+		while( result.size( ) < count ) {
+			auto const op = daw::randint<std::uint8_t>( 0, op_count - 1 );
+			auto run = daw::randint<std::size_t>( 1, max_run );
+			run = std::min( run, count - result.size( ) );
+			result.insert( result.end( ), run, op );
+		}
+		return result;
+	}
+
+	void function_table_batch_test_001( ) {
+		auto const program = make_program( 1'000, 16 );
+		auto const a = daw::make_random_data<std::uint32_t>( program.size( ) );
+		auto const b = daw::make_random_data<std::uint32_t>( program.size( ) );
+		auto expected = std::vector<std::uint32_t>( program.size( ) );
+		for( std::size_t n = 0; n < program.size( ); ++n ) {
+			expected[n] = switch_op( program[n], a[n], b[n] );
+		}
+
+		auto out = std::vector<std::uint32_t>( program.size( ) );
+		auto last = binop_table.transform_batch( program, out.begin( ), a, b );
+		daw::expecting( last == out.end( ) );
+		daw::expecting( expected == out );
+
+		std::fill( out.begin( ), out.end( ), 0U );
+		lambda_table.transform_batch( program, out.begin( ), a, b );
+		daw::expecting( expected == out );
+
+		std::fill( out.begin( ), out.end( ), 0U );
+		auto c = cursor{ a.data( ), b.data( ), out.data( ) };
+		threaded_binops_t::run( program, c );
+		daw::expecting( program.size( ), c.n );
+		daw::expecting( expected == out );
+	}
+
+	void function_table_batch_test_002( ) {
+		int total = 0;
+		auto const tbl = daw::make_function_table(
+		  [&]( int x ) {
+			  total += x;
+		  },
+		  [&]( ) {
+			  total *= 2;
+		  } );
+		auto const indices = std::vector<std::size_t>{ 0, 0, 1, 0, 1 };
+		auto const args = std::vector<int>{ 1, 2, 3, 4, 5 };
+		tbl.call_batch<true>( indices, args );
+		daw::expecting( 20, total );
+	}
+
+	template<std::size_t MaxRun>
+	void function_table_batch_bench( ) {
+		constexpr std::size_t count = 1'000'000;
+		auto const program = make_program( count, MaxRun );
+		auto const a = daw::make_random_data<std::uint32_t>( count );
+		auto const b = daw::make_random_data<std::uint32_t>( count );
+		auto out = std::vector<std::uint32_t>( count );
+		std::string const suffix =
+		  " 1M ops, run length 1-" + std::to_string( MaxRun );
+
+		daw::bench_n_test<20>(
+		  "switch" + suffix,
+		  [&]( std::vector<std::uint8_t> const &prog ) {
+			  for( std::size_t n = 0; n < prog.size( ); ++n ) {
+				  out[n] = switch_op( prog[n], a[n], b[n] );
+			  }
+			  daw::do_not_optimize( out );
+		  },
+		  program );
+		daw::bench_n_test<20>(
+		  "function_table_t::call" + suffix,
+		  [&]( std::vector<std::uint8_t> const &prog ) {
+			  for( std::size_t n = 0; n < prog.size( ); ++n ) {
+				  out[n] = binop_table( prog[n], a[n], b[n] );
+			  }
+			  daw::do_not_optimize( out );
+		  },
+		  program );
+		daw::bench_n_test<20>(
+		  "function_table_t::transform_batch" + suffix,
+		  [&]( std::vector<std::uint8_t> const &prog ) {
+			  binop_table.transform_batch( prog, out.begin( ), a, b );
+			  daw::do_not_optimize( out );
+		  },
+		  program );
+		daw::bench_n_test<20>(
+		  "function_table_t::transform_batch(lambdas)" + suffix,
+		  [&]( std::vector<std::uint8_t> const &prog ) {
+			  lambda_table.transform_batch( prog, out.begin( ), a, b );
+			  daw::do_not_optimize( out );
+		  },
+		  program );
+		daw::bench_n_test<20>(
+		  "threaded_function_table" + suffix,
+		  [&]( std::vector<std::uint8_t> const &prog ) {
+			  auto c = cursor{ a.data( ), b.data( ), out.data( ) };
+			  threaded_binops_t::run( prog, c );
+			  daw::do_not_optimize( out );
+		  },
+		  program );
+	}
+} // namespace
+
 int main( int argc, char **argv ) {
 	char const *ptr = "12345678";
 	if( argc > 1 ) {
@@ -183,4 +395,10 @@ int main( int argc, char **argv ) {
 	}
 	uintmax_t result = ftable( static_cast<size_t>( *ptr ), 0U, ptr );
 	std::cout << result << '\n';
+
+	function_table_batch_test_001( );
+	function_table_batch_test_002( );
+	function_table_batch_bench<1>( );
+	function_table_batch_bench<8>( );
+	function_table_batch_bench<64>( );
 }
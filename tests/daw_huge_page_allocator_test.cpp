@@ -0,0 +1,173 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include <daw/daw_huge_page_allocator.h>
+
+#include <daw/daw_benchmark.h>
+#include <daw/daw_ensure.h>
+#include <daw/daw_unique_array.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+	using daw::memory::huge_page_allocator;
+	using daw::memory::numa_placement;
+	using daw::memory::numa_policy;
+
+	/// The AnonHugePages of the mapping that holds p, in kB.  Zero when it
+	/// cannot be found
+	std::size_t anon_huge_kb( void const *p ) {
+#if defined( __linux__ )
+		auto file = std::ifstream( "/proc/self/smaps" );
+		auto const addr = reinterpret_cast<std::uintptr_t>( p );
+		auto line = std::string( );
+		bool in_range = false;
+		while( std::getline( file, line ) ) {
+			auto const dash = line.find( '-' );
+			auto const space = line.find( ' ' );
+			if( dash != std::string::npos and space != std::string::npos and
+			    dash < space and
+			    line.find_first_not_of( "0123456789abcdef" ) == dash ) {
+				auto const lo = std::stoull( line.substr( 0, dash ), nullptr, 16 );
+				auto const hi =
+				  std::stoull( line.substr( dash + 1, space - dash - 1 ), nullptr, 16 );
+				in_range = lo <= addr and addr < hi;
+			} else if( in_range and line.rfind( "AnonHugePages:", 0 ) == 0 ) {
+				auto ss = std::istringstream( line.substr( 14 ) );
+				std::size_t kb = 0;
+				ss >> kb;
+				return kb;
+			}
+		}
+#endif
+		(void)p;
+		return 0;
+	}
+
+	void allocator_test( ) {
+		auto alloc = huge_page_allocator<std::uint64_t>( );
+		auto *small = alloc.allocate( 100 );
+		std::fill_n( small, 100, 1U );
+		alloc.deallocate( small, 100 );
+
+		constexpr std::size_t count = 3U * 1024U * 1024U;
+		auto *large = alloc.allocate( count );
+		daw_ensure( reinterpret_cast<std::uintptr_t>( large ) %
+		              daw::memory::huge_page_impl::huge_page_size ==
+		            0 );
+		std::iota( large, large + count, std::uint64_t{ 0 } );
+		daw_ensure( large[count - 1U] == count - 1U );
+		std::cout << "transparent huge pages backing 24MiB: "
+		          << anon_huge_kb( large ) << "kB\n";
+		alloc.deallocate( large, count );
+
+		auto rebound = huge_page_allocator<char>( alloc );
+		daw_ensure( rebound == alloc );
+
+		auto const nodes = daw::memory::numa_nodes_allowed( );
+		std::cout << "numa nodes allowed mask: " << nodes << '\n';
+		for( auto policy : { numa_policy::interleave, numa_policy::bind,
+		                     numa_policy::preferred } ) {
+			auto placed =
+			  huge_page_allocator<int>( numa_placement{ policy, nodes } );
+			auto *p = placed.allocate( count );
+			std::fill_n( p, count, 7 );
+			daw_ensure( p[count / 2U] == 7 );
+			placed.deallocate( p, count );
+		}
+	}
+
+	void container_test( ) {
+		auto v = std::vector<int, huge_page_allocator<int>>( );
+		for( int n = 0; n < 1'000'000; ++n ) {
+			v.push_back( n );
+		}
+		daw_ensure( v.size( ) == 1'000'000U and v.back( ) == 999'999 );
+
+		using array_t =
+		  daw::unique_array_t<std::uint32_t,
+		                      daw::memory::hugetlb_allocator<std::uint32_t>>;
+		auto arr = array_t( std::allocator_arg,
+		                    daw::memory::hugetlb_allocator<std::uint32_t>(
+		                      numa_placement{ numa_policy::interleave, 0 } ),
+		                    4U * 1024U * 1024U );
+		std::fill( arr.begin( ), arr.end( ), 3U );
+		daw_ensure( arr.size( ) == 4U * 1024U * 1024U and arr[12345] == 3U );
+		auto moved = std::move( arr );
+		daw_ensure( arr.empty( ) and moved.back( ) == 3U );
+	}
+
+	/// A single random cycle through every index, each load depends on the last
+	std::vector<std::uint32_t> make_cycle( std::size_t count ) {
+		auto order = std::vector<std::uint32_t>( count );
+		std::iota( order.begin( ), order.end( ), 0U );
+		auto engine = std::mt19937_64( 1234 );
+		for( std::size_t n = count - 1U; n > 0; --n ) {
+			auto const j = std::uniform_int_distribution<std::size_t>( 0, n - 1U )( engine );
+			std::swap( order[n], order[j] );
+		}
+		auto next = std::vector<std::uint32_t>( count );
+		for( std::size_t n = 0; n < count; ++n ) {
+			next[order[n]] = order[( n + 1U ) % count];
+		}
+		return next;
+	}
+
+	template<typename Allocator>
+	void latency_bench( char const *title, std::vector<std::uint32_t> const &cycle ) {
+		constexpr std::size_t steps = 4U * 1024U * 1024U;
+		auto table = std::vector<std::uint32_t, Allocator>( cycle.begin( ), cycle.end( ) );
+		auto chase = [&] {
+			std::uint32_t pos = 0;
+			for( std::size_t n = 0; n < steps; ++n ) {
+				pos = table[pos];
+			}
+			daw::do_not_optimize( pos );
+			return pos;
+		};
+		(void)daw::bench_n_test<3>( title, chase );
+		auto const start = std::chrono::steady_clock::now( );
+		(void)chase( );
+		auto const elapsed = std::chrono::duration<double, std::nano>(
+		                       std::chrono::steady_clock::now( ) - start )
+		                       .count( );
+		std::cout << "\thuge pages: " << anon_huge_kb( table.data( ) ) / 1024U
+		          << "MiB, " << elapsed / static_cast<double>( steps )
+		          << "ns per dependent load\n";
+	}
+
+	void huge_page_bench( ) {
+		// 256MiB of indices, far beyond the reach of the TLB with 4KiB pages
+		auto const cycle = make_cycle( 64U * 1024U * 1024U );
+		latency_bench<daw::memory::small_page_allocator<std::uint32_t>>(
+		  "random access 4KiB pages", cycle );
+		latency_bench<huge_page_allocator<std::uint32_t>>(
+		  "random access 2MiB transparent huge pages", cycle );
+		latency_bench<daw::memory::hugetlb_allocator<std::uint32_t>>(
+		  "random access MAP_HUGETLB pages", cycle );
+	}
+} // namespace
+
+int main( ) {
+	allocator_test( );
+	container_test( );
+	huge_page_bench( );
+	std::cout << "done\n";
+}
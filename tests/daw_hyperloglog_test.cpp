@@ -0,0 +1,126 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include "daw/daw_hyperloglog.h"
+
+#include "daw/daw_benchmark.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+	double relative_error( double estimate, double exact ) {
+		return std::abs( estimate - exact ) / exact;
+	}
+
+	void hyperloglog_test_001( ) {
+		auto hll = daw::hyperloglog<>( );
+		daw::expecting( 0U, hll.count( ) );
+		for( int n = 0; n < 3; ++n ) {
+			hll.insert( std::string( "a" ) );
+			hll.insert( std::string( "b" ) );
+		}
+		daw::expecting( 2U, hll.count( ) );
+		hll.clear( );
+		daw::expecting( 0U, hll.count( ) );
+	}
+
+	void hyperloglog_accuracy_test( ) {
+		for( std::uint64_t count : { 100ULL, 10'000ULL, 1'000'000ULL } ) {
+			auto hll = daw::hyperloglog<>( 14 );
+			for( std::uint64_t n = 0; n < count; ++n ) {
+				// Each key twice, duplicates must not be counted
+				hll.insert( n );
+				hll.insert( n );
+			}
+			auto const err =
+			  relative_error( hll.estimate( ), static_cast<double>( count ) );
+			std::cout << count << " distinct: estimate " << hll.count( )
+			          << " relative error " << err << '\n';
+			// Four standard errors
+			daw::expecting( err < 4.0 * 1.04 / std::sqrt( 16384.0 ) );
+		}
+	}
+
+	void hyperloglog_merge_test( ) {
+		constexpr std::size_t parts = 4;
+		constexpr std::uint64_t per_part = 500'000;
+		auto sketches = std::vector<daw::hyperloglog<>>( parts, daw::hyperloglog<>( 12 ) );
+		auto threads = std::vector<std::thread>( );
+		for( std::size_t p = 0; p < parts; ++p ) {
+			threads.emplace_back( [&, p] {
+				// Parts overlap by half
+				auto const first = p * per_part / 2U;
+				for( std::uint64_t n = first; n < first + per_part; ++n ) {
+					sketches[p].insert( n );
+				}
+			} );
+		}
+		for( auto &t : threads ) {
+			t.join( );
+		}
+		auto merged = sketches[0];
+		for( std::size_t p = 1; p < parts; ++p ) {
+			merged.merge( sketches[p] );
+		}
+		auto const exact = static_cast<double>( per_part / 2U * ( parts + 1U ) );
+		daw::expecting( relative_error( merged.estimate( ), exact ) <
+		                4.0 * 1.04 / std::sqrt( 4096.0 ) );
+
+		auto buffer = std::vector<char>( merged.serialized_size( ) );
+		auto *const last = merged.serialize_to( buffer.data( ) );
+		daw::expecting( buffer.data( ) + buffer.size( ) == last );
+		auto const copy =
+		  daw::hyperloglog<>::from_buffer( buffer.data( ), buffer.size( ) );
+		daw::expecting( copy.has_value( ) );
+		daw::expecting( 12U, copy->precision( ) );
+		daw::expecting( merged.count( ), copy->count( ) );
+		daw::expecting( not daw::hyperloglog<>::from_buffer( buffer.data( ),
+		                                                     buffer.size( ) / 2U ) );
+	}
+
+	void hyperloglog_bench( ) {
+		auto keys = std::vector<std::uint64_t>( 4'000'000 );
+		for( std::size_t n = 0; n < keys.size( ); ++n ) {
+			keys[n] = ( n % 1'000'000U ) * 0x9e37'79b9'7f4a'7c15ULL;
+		}
+		daw::bench_n_test<10>(
+		  "std::unordered_set distinct count",
+		  []( std::vector<std::uint64_t> const &k ) {
+			  auto set = std::unordered_set<std::uint64_t>( );
+			  set.insert( k.begin( ), k.end( ) );
+			  daw::do_not_optimize( set );
+			  return set.size( );
+		  },
+		  keys );
+		daw::bench_n_test<10>(
+		  "hyperloglog distinct count",
+		  []( std::vector<std::uint64_t> const &k ) {
+			  auto hll = daw::hyperloglog<>( );
+			  hll.insert( k.begin( ), k.end( ) );
+			  auto result = hll.count( );
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  keys );
+	}
+} // namespace
+
+int main( ) {
+	hyperloglog_test_001( );
+	hyperloglog_accuracy_test( );
+	hyperloglog_merge_test( );
+	hyperloglog_bench( );
+	std::cout << "done\n";
+}
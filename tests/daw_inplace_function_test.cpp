@@ -0,0 +1,186 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include "daw/daw_inplace_function.h"
+
+#include "daw/daw_benchmark.h"
+#include "daw/daw_stack_function.h"
+
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+	int square( int x ) {
+		return x * x;
+	}
+
+	struct counted {
+		static inline int live = 0;
+		int value;
+
+		explicit counted( int v ) noexcept
+		  : value( v ) {
+			++live;
+		}
+		counted( counted const &other ) noexcept
+		  : value( other.value ) {
+			++live;
+		}
+		counted( counted &&other ) noexcept
+		  : value( other.value ) {
+			++live;
+		}
+		counted &operator=( counted const & ) = delete;
+		counted &operator=( counted && ) = delete;
+		~counted( ) {
+			--live;
+		}
+
+		int operator( )( int x ) const noexcept {
+			return value + x;
+		}
+	};
+
+	void inplace_function_test_001( ) {
+		daw::inplace_function<int( int )> f = []( int x ) {
+			return x + 1;
+		};
+		daw::expecting( 2, f( 1 ) );
+		daw::expecting( f.is_trivially_relocatable( ) );
+		f = square;
+		daw::expecting( 9, f( 3 ) );
+		f = &square;
+		daw::expecting( 16, f( 4 ) );
+	}
+
+	void inplace_function_test_002( ) {
+		daw::inplace_function<int( int ) const noexcept> const f =
+		  []( int x ) noexcept {
+			  return x * 2;
+		  };
+		daw::expecting( 8, f( 4 ) );
+
+		auto p = std::make_unique<int>( 5 );
+		daw::inplace_function<int( ) &&> g = [p = std::move( p )] {
+			return *p;
+		};
+		daw::expecting( 5, std::move( g )( ) );
+		daw::expecting( not g.is_trivially_relocatable( ) );
+	}
+
+	void inplace_function_test_003( ) {
+		daw::inplace_function<int( int )> f;
+		daw::expecting( f == nullptr );
+		bool has_thrown = false;
+		try {
+			(void)f( 1 );
+		} catch( std::bad_function_call const & ) { has_thrown = true; }
+		daw::expecting( has_thrown );
+
+		int ( *fp )( int ) = nullptr;
+		daw::inplace_function<int( int )> g = fp;
+		daw::expecting( not g );
+	}
+
+	void inplace_function_test_004( ) {
+		{
+			daw::inplace_function<int( int )> f{ std::in_place_type<counted>, 40 };
+			daw::expecting( 1, counted::live );
+			daw::expecting( 42, f( 2 ) );
+			auto g = std::move( f );
+			daw::expecting( 1, counted::live );
+			daw::expecting( f.empty( ) );
+			daw::expecting( 43, g( 3 ) );
+			daw::inplace_function<int( int )> h = counted( 1 );
+			swap( g, h );
+			daw::expecting( 2, g( 1 ) );
+			daw::expecting( 41, h( 1 ) );
+			daw::expecting( 2, counted::live );
+			g = nullptr;
+			daw::expecting( 1, counted::live );
+		}
+		daw::expecting( 0, counted::live );
+	}
+
+	void move_only_function_test_001( ) {
+		std::string big( 100, 'x' );
+		daw::move_only_function<std::size_t( ) const> f =
+		  [a = big, b = big, c = big] {
+			  return a.size( ) + b.size( ) + c.size( );
+		  };
+		auto g = std::move( f );
+		daw::expecting( 300U, g( ) );
+		daw::expecting( f == nullptr );
+		daw::expecting( not g.is_trivially_relocatable( ) );
+
+		daw::move_only_function<int( int )> h = square;
+		daw::expecting( h.is_trivially_relocatable( ) );
+		daw::expecting( 25, h( 5 ) );
+	}
+
+	template<typename Function>
+	void bench_calls( std::string const &title ) {
+		std::vector<Function> funcs{ };
+		funcs.reserve( 1'000 );
+		for( int n = 0; n < 1'000; ++n ) {
+			int const m = n % 7;
+			funcs.emplace_back( [m]( int x ) {
+				return x * m + 1;
+			} );
+		}
+		daw::bench_n_test<100>(
+		  title + " call 1k",
+		  []( std::vector<Function> const &fs ) {
+			  int total = 0;
+			  for( auto const &f : fs ) {
+				  total += f( total & 0xFF );
+			  }
+			  daw::do_not_optimize( total );
+			  return total;
+		  },
+		  funcs );
+		daw::bench_n_test<100>( title + " construct and move 1k", [] {
+			std::vector<Function> fs{ };
+			fs.reserve( 1'000 );
+			for( int n = 0; n < 1'000; ++n ) {
+				fs.emplace_back( [n]( int x ) {
+					return x + n;
+				} );
+			}
+			auto fs2 = std::move( fs );
+			fs2.reserve( 2'000 );
+			daw::do_not_optimize( fs2 );
+		} );
+	}
+
+	void inplace_function_bench( ) {
+		bench_calls<daw::inplace_function<int( int ) const>>(
+		  "daw::inplace_function" );
+		bench_calls<daw::move_only_function<int( int ) const>>(
+		  "daw::move_only_function" );
+		bench_calls<daw::function<24, int( int )>>( "daw::function" );
+		bench_calls<std::function<int( int )>>( "std::function" );
+#if defined( __cpp_lib_move_only_function )
+		bench_calls<std::move_only_function<int( int ) const>>(
+		  "std::move_only_function" );
+#endif
+	}
+} // namespace
+
+int main( ) {
+	inplace_function_test_001( );
+	inplace_function_test_002( );
+	inplace_function_test_003( );
+	inplace_function_test_004( );
+	move_only_function_test_001( );
+	inplace_function_bench( );
+	std::cout << "done\n";
+}
@@ -0,0 +1,289 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include <daw/daw_mapped_hash_map.h>
+#include <daw/daw_mapped_vector.h>
+
+#include <daw/daw_benchmark.h>
+#include <daw/daw_ensure.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if not defined( _WIN32 )
+#include <csignal>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+	using daw::filesystem::mapped_hash_map;
+	using daw::filesystem::mapped_vector;
+	using daw::filesystem::open_mode;
+
+	struct entry_t {
+		std::uint64_t a;
+		std::uint64_t b;
+	};
+
+	constexpr entry_t entry_for( std::uint64_t n ) noexcept {
+		return entry_t{ n * 3U, ~n };
+	}
+
+	bool operator==( entry_t const &lhs, entry_t const &rhs ) noexcept {
+		return lhs.a == rhs.a and lhs.b == rhs.b;
+	}
+
+	std::string temp_path( char const *name ) {
+		auto const path = std::filesystem::temp_directory_path( ) / name;
+		std::filesystem::remove( path );
+		return path.string( );
+	}
+
+	void mapped_vector_test( ) {
+		auto const path = temp_path( "daw_mapped_vector_test.bin" );
+		{
+			auto v = mapped_vector<entry_t>( path );
+			daw_ensure( v and v.empty( ) );
+			for( std::uint64_t n = 0; n < 100'000; ++n ) {
+				v.push_back( entry_for( n ) );
+			}
+			v.push_back( v[5] );
+			daw_ensure( v.size( ) == 100'001U and v.back( ) == entry_for( 5 ) );
+			v.pop_back( );
+			v.resize( 100'010U, entry_t{ 1, 2 } );
+			daw_ensure( v.back( ) == ( entry_t{ 1, 2 } ) );
+			v.resize( 100'000U );
+			daw_ensure( v.checkpoint( ) and v.checkpoints( ) == 1U );
+		}
+		{
+			auto v = mapped_vector<entry_t>( path, open_mode::read );
+			daw_ensure( v and v.size( ) == 100'000U );
+			std::uint64_t n = 0;
+			for( auto const &e : v ) {
+				daw_ensure( e == entry_for( n++ ) );
+			}
+		}
+		// The file holds entry_t, not std::uint32_t
+		daw_ensure( not mapped_vector<std::uint32_t>( path ) );
+		daw_ensure( not mapped_vector<entry_t>(
+		  temp_path( "daw_mapped_vector_missing.bin" ), open_mode::read ) );
+		std::filesystem::remove( path );
+	}
+
+	void mapped_hash_map_test( ) {
+		auto const path = temp_path( "daw_mapped_hash_map_test.bin" );
+		{
+			auto m = mapped_hash_map<std::uint64_t, entry_t>( path );
+			daw_ensure( m and m.empty( ) );
+			for( std::uint64_t n = 0; n < 100'000; ++n ) {
+				daw_ensure( m.insert( n, entry_for( n ) ) );
+			}
+			daw_ensure( not m.insert( 7, entry_t{ } ) );
+			daw_ensure( *m.find( 7 ) == entry_for( 7 ) );
+			daw_ensure( not m.insert_or_assign( 7, entry_t{ 1, 1 } ) );
+			daw_ensure( *m.find( 7 ) == ( entry_t{ 1, 1 } ) );
+			for( std::uint64_t n = 0; n < 100'000; n += 2U ) {
+				daw_ensure( m.erase( n ) );
+			}
+			daw_ensure( not m.erase( 0 ) );
+			daw_ensure( m.size( ) == 50'000U and not m.contains( 10 ) );
+			m.reserve( 200'000 );
+			daw_ensure( m.bucket_count( ) >= 200'000U and m.size( ) == 50'000U );
+			m.checkpoint( );
+		}
+		{
+			auto m = mapped_hash_map<std::uint64_t, entry_t>( path, open_mode::read );
+			daw_ensure( m and m.size( ) == 50'000U );
+			daw_ensure( m.find( 7 ) and *m.find( 7 ) == ( entry_t{ 1, 1 } ) );
+			daw_ensure( m.find( 99'999 ) and *m.find( 99'999 ) == entry_for( 99'999 ) );
+			daw_ensure( not m.contains( 99'998 ) );
+			std::size_t count = 0;
+			m.for_each( [&]( std::uint64_t key, entry_t const &value ) {
+				daw_ensure( key % 2U == 1U );
+				daw_ensure( key == 7U or value == entry_for( key ) );
+				++count;
+			} );
+			daw_ensure( count == 50'000U );
+		}
+		daw_ensure( not mapped_hash_map<std::uint32_t, entry_t>( path ) );
+		daw_ensure( not mapped_vector<entry_t>( path ) );
+		std::filesystem::remove( path );
+	}
+
+	/// A file that was grown but never given its magic is created again
+	void unformatted_file_test( ) {
+		auto const path = temp_path( "daw_mapped_unformatted_test.bin" );
+		auto const zero_fill = [&] {
+			std::filesystem::resize_file( path, 0 );
+			std::filesystem::resize_file( path, 8192 );
+		};
+		{ auto out = std::ofstream( path ); }
+		zero_fill( );
+		daw_ensure( not mapped_vector<entry_t>( path, open_mode::read ) );
+		{
+			auto v = mapped_vector<entry_t>( path );
+			daw_ensure( v and v.empty( ) );
+			v.push_back( entry_for( 1 ) );
+		}
+		daw_ensure( mapped_vector<entry_t>( path, open_mode::read ).size( ) == 1U );
+		zero_fill( );
+		daw_ensure(
+		  not mapped_hash_map<std::uint64_t, entry_t>( path, open_mode::read ) );
+		{
+			auto m = mapped_hash_map<std::uint64_t, entry_t>( path );
+			daw_ensure( m and m.empty( ) );
+			daw_ensure( m.insert( 1, entry_for( 1 ) ) );
+		}
+		daw_ensure( mapped_hash_map<std::uint64_t, entry_t>( path, open_mode::read )
+		              .contains( 1 ) );
+		std::filesystem::remove( path );
+	}
+
+	/// Run f in a child process that is killed after delay_us
+	template<typename Function>
+	void run_and_kill( unsigned delay_us, Function f ) {
+		pid_t const pid = fork( );
+		daw_ensure( pid >= 0 );
+		if( pid == 0 ) {
+			f( );
+			_exit( 0 );
+		}
+		usleep( delay_us );
+		kill( pid, SIGKILL );
+		int status = 0;
+		waitpid( pid, &status, 0 );
+	}
+
+	constexpr std::uint64_t child_limit = 2'000'000;
+
+	void crash_consistency_test( ) {
+		auto const vec_path = temp_path( "daw_mapped_vector_crash.bin" );
+		auto const map_path = temp_path( "daw_mapped_hash_map_crash.bin" );
+		std::size_t kills = 0;
+		for( unsigned delay_us : { 0U, 500U, 2'000U, 10'000U, 40'000U, 100'000U,
+		                           250'000U } ) {
+			for( int round = 0; round < 2; ++round ) {
+				run_and_kill( delay_us, [&] {
+					auto v = mapped_vector<std::uint64_t>( vec_path );
+					for( auto n = v.size( ); n < child_limit; ++n ) {
+						v.push_back( n * 7U );
+					}
+				} );
+				run_and_kill( delay_us, [&] {
+					auto m = mapped_hash_map<std::uint64_t, entry_t>( map_path );
+					for( auto n = m.size( ); n < child_limit; ++n ) {
+						m.insert( n, entry_for( n ) );
+					}
+				} );
+				kills += 2U;
+
+				// A killed writer must leave a file that opens, holds every completed
+				// operation, and can still be written to
+				auto v = mapped_vector<std::uint64_t>( vec_path );
+				daw_ensure( v );
+				for( std::size_t n = 0; n < v.size( ); ++n ) {
+					daw_ensure( v[n] == n * 7U );
+				}
+				v.push_back( v.size( ) * 7U );
+
+				auto m = mapped_hash_map<std::uint64_t, entry_t>( map_path );
+				daw_ensure( m );
+				auto const size = m.size( );
+				std::size_t count = 0;
+				m.for_each( [&]( std::uint64_t key, entry_t const &value ) {
+					daw_ensure( key < size and value == entry_for( key ) );
+					++count;
+				} );
+				daw_ensure( count == size );
+				daw_ensure( m.insert( size, entry_for( size ) ) );
+				std::cout << "killed after " << delay_us << "us: " << v.size( )
+				          << " vector elements, " << m.size( ) << " map entries in "
+				          << m.bucket_count( ) << " buckets\n";
+			}
+		}
+		daw_ensure( kills > 0 );
+		std::filesystem::remove( vec_path );
+		std::filesystem::remove( map_path );
+	}
+
+	void cold_open_bench( ) {
+		constexpr std::uint64_t count = 2'000'000;
+		auto const map_path = temp_path( "daw_mapped_hash_map_bench.bin" );
+		auto const flat_path = temp_path( "daw_mapped_hash_map_bench_flat.bin" );
+		{
+			auto m = mapped_hash_map<std::uint64_t, entry_t>( map_path );
+			m.reserve( count );
+			auto flat = mapped_vector<entry_t>( flat_path );
+			flat.reserve( count );
+			for( std::uint64_t n = 0; n < count; ++n ) {
+				m.insert( n, entry_for( n ) );
+				flat.push_back( entry_for( n ) );
+			}
+		}
+		auto const bytes = count * sizeof( entry_t );
+
+		(void)daw::bench_n_test_mbs<5>(
+		  "cold open mapped_hash_map", bytes,
+		  [&]( std::uint64_t key ) {
+			  auto m =
+			    mapped_hash_map<std::uint64_t, entry_t>( map_path, open_mode::read );
+			  auto const *value = m.find( key );
+			  daw_ensure( value and value->a == key * 3U );
+			  daw::do_not_optimize( m );
+			  return m.size( );
+		  },
+		  count / 2U );
+
+		(void)daw::bench_n_test_mbs<5>(
+		  "cold open mapped_vector", bytes,
+		  [&]( std::size_t idx ) {
+			  auto v = mapped_vector<entry_t>( flat_path, open_mode::read );
+			  daw_ensure( v[idx].a == idx * 3U );
+			  daw::do_not_optimize( v );
+			  return v.size( );
+		  },
+		  count / 2U );
+
+		(void)daw::bench_n_test_mbs<5>(
+		  "rebuild std::unordered_map from the same file", bytes,
+		  [&]( std::uint64_t key ) {
+			  auto v = mapped_vector<entry_t>( flat_path, open_mode::read );
+			  auto m = std::unordered_map<std::uint64_t, entry_t>( );
+			  m.reserve( v.size( ) );
+			  for( std::size_t n = 0; n < v.size( ); ++n ) {
+				  m.emplace( n, v[n] );
+			  }
+			  daw_ensure( m.find( key )->second.a == key * 3U );
+			  daw::do_not_optimize( m );
+			  return m.size( );
+		  },
+		  count / 2U );
+
+		std::filesystem::remove( map_path );
+		std::filesystem::remove( flat_path );
+	}
+} // namespace
+
+int main( ) {
+	mapped_vector_test( );
+	mapped_hash_map_test( );
+	unformatted_file_test( );
+	crash_consistency_test( );
+	cold_open_bench( );
+	std::cout << "done\n";
+}
+#else
+int main( ) {}
+#endif
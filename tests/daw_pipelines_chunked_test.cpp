@@ -0,0 +1,260 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include <daw/pipelines/algorithm.h>
+#include <daw/pipelines/filter.h>
+#include <daw/pipelines/map.h>
+#include <daw/pipelines/numeric.h>
+#include <daw/pipelines/pipeline.h>
+#include <daw/pipelines/to.h>
+
+#include <daw/daw_benchmark.h>
+#include <daw/daw_random.h>
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <list>
+#include <ranges>
+#include <vector>
+
+namespace {
+	using namespace daw::pipelines;
+
+	constexpr auto is_even = []( int x ) {
+		return x % 2 == 0;
+	};
+	constexpr auto times3 = []( int x ) {
+		return x * 3;
+	};
+
+	static_assert( pimpl::ChunkedRange<std::vector<int> &> );
+	static_assert(
+	  pimpl::ChunkedView<decltype( pipeline( std::declval<std::vector<int> &>( ),
+	                                         Filter( is_even ) ) )> );
+	static_assert( not pimpl::ChunkedRange<std::list<int> &> );
+
+	constexpr int constexpr_sum( ) {
+		auto a = std::array{ 1, 2, 3, 4, 5, 6 };
+		return pipeline( a, Map( times3 ), Sum );
+	}
+	static_assert( constexpr_sum( ) == 63 );
+
+	std::vector<int> make_data( std::size_t count ) {
+		return daw::make_random_data<int>( count, -1000, 1000 );
+	}
+
+	void chunked_sum_test( ) {
+		for( std::size_t sz : { 0U, 1U, 255U, 256U, 257U, 10'000U } ) {
+			auto const v = make_data( sz );
+			long long expected_filter = 0;
+			long long expected_map = 0;
+			for( int x : v ) {
+				if( is_even( x ) ) {
+					expected_filter += x;
+					expected_map += times3( x );
+				}
+			}
+			daw::expecting( expected_filter, pipeline( v, Filter( is_even ), Sum ) );
+			daw::expecting( expected_map,
+			                pipeline( v, Filter( is_even ), Map( times3 ), Sum ) );
+			daw::expecting( expected_map,
+			                pipeline( v, Map( times3 ), Filter( is_even ), Sum ) );
+		}
+	}
+
+	void chunked_count_test( ) {
+		auto const v = make_data( 1'000 );
+		auto const expected =
+		  static_cast<std::size_t>( std::count_if( v.begin( ), v.end( ), is_even ) );
+		daw::expecting( expected, pipeline( v, Filter( is_even ), Count ) );
+		daw::expecting( expected, pipeline( v, CountIf( is_even ) ) );
+		daw::expecting( expected, pipeline( v, Map( times3 ), CountIf( is_even ) ) );
+		auto const lst = std::list<int>( v.begin( ), v.end( ) );
+		daw::expecting( expected, pipeline( lst, Filter( is_even ), Count ) );
+	}
+
+	void chunked_minmax_test( ) {
+		auto const v = std::vector<int>{ 5, 1, 9, 1, 8, 9, 2, 9, 7 };
+		auto [mn, mx] = pipeline( v, Map( []( int x ) {
+			                          return x * 3;
+		                          } ),
+		                          MinMax );
+		daw::expecting( 3, *mn );
+		daw::expecting( 27, *mx );
+		daw::expecting( 1, std::distance( v.begin( ), mn.base( ) ) );
+		daw::expecting( 7, std::distance( v.begin( ), mx.base( ) ) );
+
+		auto const big = make_data( 5'000 );
+		auto [emn, emx] = std::minmax_element( big.begin( ), big.end( ) );
+		auto [fmn, fmx] = pipeline( big, Filter( []( int ) {
+			                            return true;
+		                            } ),
+		                            MinMax );
+		daw::expecting( emn == fmn.base( ) );
+		daw::expecting( emx == fmx.base( ) );
+	}
+
+	void chunked_to_test( ) {
+		auto const v = make_data( 1'000 );
+		auto expected = std::vector<int>( );
+		for( int x : v ) {
+			if( is_even( x ) and x > 0 ) {
+				expected.push_back( times3( x ) );
+			}
+		}
+		auto const r0 = pipeline( v, Filter( is_even ),
+		                          Filter( []( int x ) {
+			                          return x > 0;
+		                          } ),
+		                          Map( times3 ), To<std::vector> );
+		daw::expecting( expected == r0 );
+		auto const r1 = pipeline( v, Filter( is_even ),
+		                          Filter( []( int x ) {
+			                          return x > 0;
+		                          } ),
+		                          Map( times3 ), To<std::vector<long>> );
+		daw::expecting( std::equal( expected.begin( ), expected.end( ),
+		                            r1.begin( ), r1.end( ) ) );
+		auto const r2 = pipeline( v, Map( times3 ), To<std::vector> );
+		daw::expecting( v.size( ), r2.size( ) );
+	}
+
+	void chunked_bench( ) {
+		constexpr std::size_t count = 1'000'000;
+		auto const v = make_data( count );
+
+		daw::bench_n_test<50>(
+		  "hand loop filter/map/sum",
+		  []( std::vector<int> const &d ) {
+			  int sum = 0;
+			  for( int x : d ) {
+				  if( is_even( x ) ) {
+					  sum += times3( x );
+				  }
+			  }
+			  daw::do_not_optimize( sum );
+			  return sum;
+		  },
+		  v );
+		daw::bench_n_test<50>(
+		  "pipeline filter/map/sum",
+		  []( std::vector<int> const &d ) {
+			  int sum = pipeline( d, Filter( is_even ), Map( times3 ), Sum );
+			  daw::do_not_optimize( sum );
+			  return sum;
+		  },
+		  v );
+		daw::bench_n_test<50>(
+		  "pipeline iterators filter/map/sum",
+		  []( std::vector<int> const &d ) {
+			  int sum = 0;
+			  for( int x : pipeline( d, Filter( is_even ), Map( times3 ) ) ) {
+				  sum += x;
+			  }
+			  daw::do_not_optimize( sum );
+			  return sum;
+		  },
+		  v );
+		daw::bench_n_test<50>(
+		  "std::ranges filter/map/sum",
+		  []( std::vector<int> const &d ) {
+			  int sum = 0;
+			  for( int x : d | std::views::filter( is_even ) |
+			                 std::views::transform( times3 ) ) {
+				  sum += x;
+			  }
+			  daw::do_not_optimize( sum );
+			  return sum;
+		  },
+		  v );
+
+		daw::bench_n_test<50>(
+		  "hand loop map/count_if",
+		  []( std::vector<int> const &d ) {
+			  std::size_t result = 0;
+			  for( int x : d ) {
+				  result += static_cast<std::size_t>( times3( x ) > 100 );
+			  }
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  v );
+		daw::bench_n_test<50>(
+		  "pipeline map/count_if",
+		  []( std::vector<int> const &d ) {
+			  auto result = pipeline( d, Map( times3 ), CountIf( []( int x ) {
+				                          return x > 100;
+			                          } ) );
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  v );
+		daw::bench_n_test<50>(
+		  "std::ranges map/count_if",
+		  []( std::vector<int> const &d ) {
+			  auto result = std::ranges::count_if(
+			    d | std::views::transform( times3 ), []( int x ) {
+				    return x > 100;
+			    } );
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  v );
+
+		daw::bench_n_test<50>(
+		  "pipeline filter/to vector",
+		  []( std::vector<int> const &d ) {
+			  auto result = pipeline( d, Filter( is_even ), To<std::vector> );
+			  daw::do_not_optimize( result );
+			  return result.size( );
+		  },
+		  v );
+		daw::bench_n_test<50>(
+		  "std::ranges filter/to vector",
+		  []( std::vector<int> const &d ) {
+			  auto f = d | std::views::filter( is_even );
+			  auto result = std::vector<int>( f.begin( ), f.end( ) );
+			  daw::do_not_optimize( result );
+			  return result.size( );
+		  },
+		  v );
+
+		daw::bench_n_test<50>(
+		  "pipeline map/minmax",
+		  []( std::vector<int> const &d ) {
+			  auto [mn, mx] = pipeline( d, Map( []( int x ) {
+				                          return x * 3;
+			                          } ),
+			                          MinMax );
+			  auto result = *mx - *mn;
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  v );
+		daw::bench_n_test<50>(
+		  "std::ranges map/minmax",
+		  []( std::vector<int> const &d ) {
+			  auto [mn, mx] = std::ranges::minmax( d | std::views::transform( times3 ) );
+			  auto result = mx - mn;
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  v );
+	}
+} // namespace
+
+int main( ) {
+	chunked_sum_test( );
+	chunked_count_test( );
+	chunked_minmax_test( );
+	chunked_to_test( );
+	chunked_bench( );
+	std::cout << "done\n";
+}
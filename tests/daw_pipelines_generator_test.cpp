@@ -0,0 +1,369 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include <daw/pipelines/generator.h>
+
+#if defined( DAW_HAS_CPP20_COROUTINES )
+#include <daw/pipelines/chunk.h>
+#include <daw/pipelines/filter.h>
+#include <daw/pipelines/iota.h>
+#include <daw/pipelines/map.h>
+#include <daw/pipelines/numeric.h>
+#include <daw/pipelines/pipeline.h>
+#include <daw/pipelines/to.h>
+
+#include <daw/daw_benchmark.h>
+
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined( DAW_HAS_GCC )
+// GCC 12 warns on the null checks it generates for every coroutine body
+#pragma GCC diagnostic ignored "-Wzero-as-null-pointer-constant"
+#endif
+
+namespace {
+	using namespace daw::pipelines;
+
+	static_assert( daw::InputRange<generator<int>> );
+	static_assert( not daw::ForwardRange<generator<int>> );
+	static_assert( daw::InputRange<async_generator<int>> );
+
+	generator<std::size_t> iota_gen( std::size_t count ) {
+		for( std::size_t n = 0; n < count; ++n ) {
+			co_yield n;
+		}
+	}
+
+	generator<std::string> throwing_gen( ) {
+		co_yield "a";
+		throw std::runtime_error( "generator failed" );
+	}
+
+	void generator_test_001( ) {
+		auto g = iota_gen( 5 );
+		auto result = std::vector<std::size_t>( );
+		for( auto v : g ) {
+			result.push_back( v );
+		}
+		daw::expecting( std::vector<std::size_t>{ 0, 1, 2, 3, 4 } == result );
+		daw::expecting( g.done( ) );
+
+		auto empty = generator<int>( );
+		daw::expecting( empty.begin( ) == empty.end( ) );
+	}
+
+	void generator_test_002( ) {
+		auto g = throwing_gen( );
+		auto it = g.begin( );
+		daw::expecting( std::string( "a" ), *it );
+		bool has_thrown = false;
+		try {
+			++it;
+		} catch( std::runtime_error const & ) { has_thrown = true; }
+		daw::expecting( has_thrown );
+		daw::expecting( it == g.end( ) );
+	}
+
+	void generator_pipeline_test( ) {
+		auto const sum = pipeline( iota_gen( 10 ),
+		                           Map( []( std::size_t x ) {
+			                           return x * 2;
+		                           } ),
+		                           Sum );
+		daw::expecting( 90U, sum );
+
+		auto const evens = pipeline( iota_gen( 10 ),
+		                             Filter( []( std::size_t x ) {
+			                             return x % 2 == 0;
+		                             } ),
+		                             To<std::vector> );
+		daw::expecting( std::vector<std::size_t>{ 0, 2, 4, 6, 8 } == evens );
+
+		auto chunks = std::vector<std::vector<std::size_t>>( );
+		for( auto const &c : pipeline( iota_gen( 7 ), Chunk( 3 ) ) ) {
+			chunks.push_back( c );
+		}
+		daw::expecting( 3U, chunks.size( ) );
+		daw::expecting( std::vector<std::size_t>{ 3, 4, 5 } == chunks[1] );
+		daw::expecting( std::vector<std::size_t>{ 6 } == chunks[2] );
+	}
+
+	struct thread_list {
+		std::mutex m{ };
+		std::vector<std::thread> threads{ };
+
+		void join( ) {
+			auto ts = [&] {
+				auto const lck = std::lock_guard( m );
+				return std::move( threads );
+			}( );
+			for( auto &t : ts ) {
+				t.join( );
+			}
+		}
+	};
+
+	/// Resumes the awaiting coroutine on a new thread
+	struct resume_on_new_thread {
+		thread_list *tl;
+
+		bool await_ready( ) const noexcept {
+			return false;
+		}
+
+		void await_suspend( std::coroutine_handle<> h ) const {
+			auto const lck = std::lock_guard( tl->m );
+			tl->threads.emplace_back( [h] {
+				h.resume( );
+			} );
+		}
+
+		void await_resume( ) const noexcept {}
+	};
+
+	async_generator<int> async_gen( thread_list &tl, int count ) {
+		for( int n = 0; n < count; ++n ) {
+			co_await resume_on_new_thread{ &tl };
+			co_yield n * n;
+		}
+	}
+
+	void async_generator_test_001( ) {
+		auto tl = thread_list( );
+		{
+			auto g = async_gen( tl, 5 );
+			auto result = std::vector<int>( );
+			for( int v : g ) {
+				result.push_back( v );
+			}
+			daw::expecting( std::vector<int>{ 0, 1, 4, 9, 16 } == result );
+		}
+		tl.join( );
+	}
+
+	/// A fire and forget coroutine that signals when it is finished
+	struct task {
+		struct promise_type {
+			task get_return_object( ) noexcept {
+				return { };
+			}
+			std::suspend_never initial_suspend( ) const noexcept {
+				return { };
+			}
+			std::suspend_never final_suspend( ) const noexcept {
+				return { };
+			}
+			void return_void( ) noexcept {}
+			void unhandled_exception( ) noexcept {
+				std::terminate( );
+			}
+		};
+	};
+
+	struct done_flag {
+		std::mutex m{ };
+		std::condition_variable cv{ };
+		bool done = false;
+
+		void set( ) {
+			auto const lck = std::lock_guard( m );
+			done = true;
+			cv.notify_all( );
+		}
+
+		void wait( ) {
+			auto lck = std::unique_lock( m );
+			cv.wait( lck, [&] {
+				return done;
+			} );
+		}
+	};
+
+	task consume( async_generator<int> &g, std::vector<int> &out,
+	              done_flag &flag ) {
+		while( auto const *v = co_await g.next( ) ) {
+			out.push_back( *v );
+		}
+		flag.set( );
+	}
+
+	void async_generator_test_002( ) {
+		auto tl = thread_list( );
+		auto result = std::vector<int>( );
+		auto flag = done_flag( );
+		{
+			auto g = async_gen( tl, 4 );
+			consume( g, result, flag );
+			flag.wait( );
+		}
+		tl.join( );
+		daw::expecting( std::vector<int>{ 0, 1, 4, 9 } == result );
+	}
+
+	template<typename T>
+	struct counting_allocator {
+		using value_type = T;
+		std::size_t *count;
+
+		explicit counting_allocator( std::size_t *c ) noexcept
+		  : count( c ) {}
+
+		template<typename U>
+		counting_allocator( counting_allocator<U> const &other ) noexcept
+		  : count( other.count ) {}
+
+		T *allocate( std::size_t n ) {
+			++*count;
+			return std::allocator<T>{ }.allocate( n );
+		}
+
+		void deallocate( T *p, std::size_t n ) noexcept {
+			--*count;
+			std::allocator<T>{ }.deallocate( p, n );
+		}
+
+		template<typename U>
+		bool operator==( counting_allocator<U> const &rhs ) const noexcept {
+			return count == rhs.count;
+		}
+	};
+
+	template<typename Alloc>
+	generator<int> alloc_gen( std::allocator_arg_t, Alloc const &, int count ) {
+		for( int n = 0; n < count; ++n ) {
+			co_yield n;
+		}
+	}
+
+	struct member_gen {
+		int step = 3;
+
+		template<typename Alloc>
+		generator<int> values( std::allocator_arg_t, Alloc const &,
+		                       int count ) const {
+			for( int n = 0; n < count; ++n ) {
+				co_yield n * step;
+			}
+		}
+	};
+
+	void generator_allocator_test( ) {
+		std::size_t live = 0;
+		{
+			auto g = alloc_gen( std::allocator_arg, counting_allocator<int>( &live ),
+			                    4 );
+			daw::expecting( 1U, live );
+			daw::expecting( 6, pipeline( g, Sum ) );
+			auto const mg = member_gen{ };
+			auto m = mg.values(
+			  std::allocator_arg, counting_allocator<char>( &live ), 3 );
+			daw::expecting( 2U, live );
+			daw::expecting( 9, pipeline( m, Sum ) );
+		}
+		daw::expecting( 0U, live );
+		// The placement delete that pairs with each allocator operator new, as
+		// used when construction of the promise throws
+		using promise_t = generator<int>::promise_type;
+		auto const alloc = counting_allocator<int>( &live );
+		void *frame = promise_t::operator new( 100, std::allocator_arg, alloc, 1 );
+		daw::expecting( 1U, live );
+		promise_t::operator delete( frame, std::allocator_arg, alloc, 1 );
+		daw::expecting( 0U, live );
+		auto const mg = member_gen{ };
+		frame = promise_t::operator new( 200, mg, std::allocator_arg, alloc, 1 );
+		daw::expecting( 1U, live );
+		promise_t::operator delete( frame, mg, std::allocator_arg, alloc, 1 );
+		daw::expecting( 0U, live );
+	}
+
+	void generator_bench( ) {
+		constexpr std::size_t count = 1'000'000;
+		daw::bench_n_test<50>( "iota_view map/sum", [] {
+			auto result = pipeline( iota_view<std::size_t>( 0, count ),
+			                        Map( []( std::size_t x ) {
+				                        return x * 3;
+			                        } ),
+			                        Sum );
+			daw::do_not_optimize( result );
+			return result;
+		} );
+		daw::bench_n_test<50>( "generator map/sum", [] {
+			auto result = pipeline( iota_gen( count ),
+			                        Map( []( std::size_t x ) {
+				                        return x * 3;
+			                        } ),
+			                        Sum );
+			daw::do_not_optimize( result );
+			return result;
+		} );
+		daw::bench_n_test<50>( "async_generator map/sum", [] {
+			auto g = []( std::size_t c ) -> async_generator<std::size_t> {
+				for( std::size_t n = 0; n < c; ++n ) {
+					co_yield n;
+				}
+			}( count );
+			auto result = pipeline( g,
+			                        Map( []( std::size_t x ) {
+				                        return x * 3;
+			                        } ),
+			                        Sum );
+			daw::do_not_optimize( result );
+			return result;
+		} );
+
+		constexpr int small_count = 100'000;
+		daw::bench_n_test<50>( "create small generators, frame cache", [] {
+			int total = 0;
+			for( int n = 0; n < small_count; ++n ) {
+				for( auto v : iota_gen( 2 ) ) {
+					total += static_cast<int>( v );
+				}
+			}
+			daw::do_not_optimize( total );
+			return total;
+		} );
+		daw::bench_n_test<50>( "create small generators, std::allocator", [] {
+			int total = 0;
+			for( int n = 0; n < small_count; ++n ) {
+				for( auto v :
+				     alloc_gen( std::allocator_arg, std::allocator<int>( ), 2 ) ) {
+					total += v;
+				}
+			}
+			daw::do_not_optimize( total );
+			return total;
+		} );
+	}
+} // namespace
+
+int main( ) {
+	generator_test_001( );
+	generator_test_002( );
+	generator_pipeline_test( );
+	async_generator_test_001( );
+	async_generator_test_002( );
+	generator_allocator_test( );
+	generator_bench( );
+	std::cout << "done\n";
+}
+#else
+#include <iostream>
+
+int main( ) {
+	std::cout << "coroutines are not supported\n";
+}
+#endif
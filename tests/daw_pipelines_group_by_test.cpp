@@ -0,0 +1,236 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include <daw/pipelines/group_by.h>
+
+#include <daw/pipelines/algorithm.h>
+#include <daw/pipelines/map.h>
+#include <daw/pipelines/pipeline.h>
+
+#include <daw/daw_benchmark.h>
+#include <daw/daw_random.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+	using namespace daw::pipelines;
+
+	constexpr auto mod10 = []( int x ) {
+		return x % 10;
+	};
+
+	void count_by_test( ) {
+		auto const v = std::vector<int>{ 3, 1, 3, 2, 1, 3 };
+		auto const result = pipeline( v, CountBy( ) );
+		auto const expected =
+		  std::vector<std::pair<int, std::size_t>>{ { 3, 3 }, { 1, 2 }, { 2, 1 } };
+		daw::expecting( expected == result );
+
+		auto const words =
+		  std::list<std::string>{ "apple", "avocado", "banana", "blueberry", "fig" };
+		auto const by_letter = pipeline( words, CountBy( []( std::string const &s ) {
+			                                 return s.front( );
+		                                 } ) );
+		auto const expected_letters = std::vector<std::pair<char, std::size_t>>{
+		  { 'a', 2 }, { 'b', 2 }, { 'f', 1 } };
+		daw::expecting( expected_letters == by_letter );
+	}
+
+	void group_by_test( ) {
+		auto const v = std::vector<int>{ 11, 2, 21, 12, 31, 5 };
+		auto const result = pipeline( v, GroupBy( mod10 ) );
+		daw::expecting( 3U, result.size( ) );
+		daw::expecting( 1, result[0].first );
+		daw::expecting( std::vector<int>{ 11, 21, 31 } == result[0].second );
+		daw::expecting( std::vector<int>{ 2, 12 } == result[1].second );
+		daw::expecting( std::vector<int>{ 5 } == result[2].second );
+	}
+
+	void aggregate_by_test( ) {
+		auto const v = std::vector<int>{ 11, 2, 21, 12, 31, 5 };
+		auto const sums = pipeline( v, AggregateBy( mod10, 0, []( int acc, int x ) {
+			                            return acc + x;
+		                            } ) );
+		auto const expected =
+		  std::vector<std::pair<int, int>>{ { 1, 63 }, { 2, 14 }, { 5, 5 } };
+		daw::expecting( expected == sums );
+
+		auto const maxes =
+		  pipeline( v, Map( []( int x ) {
+			            return x * 2;
+		            } ),
+		            AggregateBy( mod10, 0, []( int &acc, int x ) {
+			            acc = std::max( acc, x );
+		            } ) );
+		auto const expected_max =
+		  std::vector<std::pair<int, int>>{ { 2, 62 }, { 4, 24 }, { 0, 10 } };
+		daw::expecting( expected_max == maxes );
+	}
+
+	void presorted_test( ) {
+		auto const v = std::vector<int>{ 1, 1, 2, 3, 3, 3, 1 };
+		auto result = std::vector<std::pair<int, std::size_t>>( );
+		for( auto const &g : pipeline( v, CountBy( std::identity{ }, PreSorted ) ) ) {
+			result.push_back( g );
+		}
+		auto const expected = std::vector<std::pair<int, std::size_t>>{
+		  { 1, 2 }, { 2, 1 }, { 3, 3 }, { 1, 1 } };
+		daw::expecting( expected == result );
+
+		auto const empty = std::vector<int>( );
+		auto const groups = pipeline( empty, GroupBy( mod10, PreSorted ) );
+		daw::expecting( groups.begin( ) == groups.end( ) );
+	}
+
+	void parallel_test( ) {
+		auto const v = daw::make_random_data<int>( 200'000, 0, 999 );
+		auto const expected = pipeline( v, GroupBy( mod10 ) );
+		auto const result = pipeline( v, GroupBy( mod10, Parallel( 4 ) ) );
+		daw::expecting( expected == result );
+
+		auto const counts = pipeline( v, CountBy( std::identity{ }, Parallel ) );
+		daw::expecting( pipeline( v, CountBy( ) ) == counts );
+
+		auto const small = std::vector<int>{ 4, 4, 5 };
+		auto const small_counts = pipeline( small, CountBy( std::identity{ },
+		                                                    Parallel( 4 ) ) );
+		daw::expecting( 2U, small_counts.size( ) );
+	}
+
+	void group_by_bench( ) {
+		constexpr std::size_t count = 2'000'000;
+		auto const v = daw::make_random_data<int>( count, 0, 9'999 );
+
+		daw::bench_n_test<20>(
+		  "sort then count runs",
+		  []( std::vector<int> d ) {
+			  std::sort( d.begin( ), d.end( ) );
+			  auto result = std::vector<std::pair<int, std::size_t>>( );
+			  for( auto first = d.begin( ); first != d.end( ); ) {
+				  auto last = std::find_if( first, d.end( ), [&]( int x ) {
+					  return x != *first;
+				  } );
+				  result.emplace_back(
+				    *first, static_cast<std::size_t>( std::distance( first, last ) ) );
+				  first = last;
+			  }
+			  daw::do_not_optimize( result );
+			  return result.size( );
+		  },
+		  v );
+		daw::bench_n_test<20>(
+		  "std::unordered_map count",
+		  []( std::vector<int> const &d ) {
+			  auto result = std::unordered_map<int, std::size_t>( );
+			  for( int x : d ) {
+				  ++result[x];
+			  }
+			  daw::do_not_optimize( result );
+			  return result.size( );
+		  },
+		  v );
+		daw::bench_n_test<20>(
+		  "CountBy",
+		  []( std::vector<int> const &d ) {
+			  auto result = pipeline( d, CountBy( ) );
+			  daw::do_not_optimize( result );
+			  return result.size( );
+		  },
+		  v );
+		daw::bench_n_test<20>(
+		  "CountBy Parallel",
+		  []( std::vector<int> const &d ) {
+			  auto result = pipeline( d, CountBy( std::identity{ }, Parallel ) );
+			  daw::do_not_optimize( result );
+			  return result.size( );
+		  },
+		  v );
+
+		auto words = std::vector<std::string>( );
+		words.reserve( count / 4U );
+		for( int x : daw::make_random_data<int>( count / 4U, 0, 4'999 ) ) {
+			words.push_back( "key_" + std::to_string( x * 7919 ) );
+		}
+		daw::bench_n_test<20>(
+		  "std::unordered_map count strings",
+		  []( std::vector<std::string> const &d ) {
+			  auto result = std::unordered_map<std::string, std::size_t>( );
+			  for( auto const &w : d ) {
+				  ++result[w];
+			  }
+			  daw::do_not_optimize( result );
+			  return result.size( );
+		  },
+		  words );
+		daw::bench_n_test<20>(
+		  "CountBy strings",
+		  []( std::vector<std::string> const &d ) {
+			  auto result = pipeline( d, CountBy( ) );
+			  daw::do_not_optimize( result );
+			  return result.size( );
+		  },
+		  words );
+
+		auto sorted = v;
+		std::sort( sorted.begin( ), sorted.end( ) );
+		daw::bench_n_test<20>(
+		  "CountBy PreSorted",
+		  []( std::vector<int> const &d ) {
+			  std::size_t groups = 0;
+			  for( auto const &g : pipeline( d, CountBy( std::identity{ }, PreSorted ) ) ) {
+				  groups += static_cast<std::size_t>( g.second > 0 );
+			  }
+			  daw::do_not_optimize( groups );
+			  return groups;
+		  },
+		  sorted );
+
+		daw::bench_n_test<20>(
+		  "sort then group",
+		  []( std::vector<int> d ) {
+			  std::stable_sort( d.begin( ), d.end( ), []( int l, int r ) {
+				  return mod10( l ) < mod10( r );
+			  } );
+			  auto result = std::vector<std::pair<int, std::vector<int>>>( );
+			  for( int x : d ) {
+				  if( result.empty( ) or result.back( ).first != mod10( x ) ) {
+					  result.emplace_back( mod10( x ), std::vector<int>( ) );
+				  }
+				  result.back( ).second.push_back( x );
+			  }
+			  daw::do_not_optimize( result );
+			  return result.size( );
+		  },
+		  v );
+		daw::bench_n_test<20>(
+		  "GroupBy",
+		  []( std::vector<int> const &d ) {
+			  auto result = pipeline( d, GroupBy( mod10 ) );
+			  daw::do_not_optimize( result );
+			  return result.size( );
+		  },
+		  v );
+	}
+} // namespace
+
+int main( ) {
+	count_by_test( );
+	group_by_test( );
+	aggregate_by_test( );
+	presorted_test( );
+	parallel_test( );
+	group_by_bench( );
+	std::cout << "done\n";
+}
@@ -0,0 +1,256 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include <daw/pipelines/numeric.h>
+
+#include <daw/pipelines/filter.h>
+#include <daw/pipelines/iota.h>
+#include <daw/pipelines/map.h>
+#include <daw/pipelines/pipeline.h>
+
+#include <daw/daw_benchmark.h>
+#include <daw/daw_random.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <list>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace {
+	using namespace daw::pipelines;
+
+	/// Exact for the test data, accumulated in long double with the values
+	/// sorted by magnitude
+	double reference_sum( std::vector<double> v ) {
+		std::sort( v.begin( ), v.end( ), []( double l, double r ) {
+			return std::abs( l ) < std::abs( r );
+		} );
+		auto sum = 0.0L;
+		auto c = 0.0L;
+		for( double x : v ) {
+			auto const t = sum + x;
+			if( std::abs( sum ) >= std::abs( static_cast<long double>( x ) ) ) {
+				c += ( sum - t ) + x;
+			} else {
+				c += ( x - t ) + sum;
+			}
+			sum = t;
+		}
+		return static_cast<double>( sum + c );
+	}
+
+	/// Values that cancel badly, the naive sum loses most of its digits
+	std::vector<double> make_ill_conditioned( std::size_t count ) {
+		auto engine = std::mt19937_64( 1234 );
+		auto exp = std::uniform_int_distribution<int>( -20, 20 );
+		auto mant = std::uniform_real_distribution<double>( -1.0, 1.0 );
+		auto result = std::vector<double>( );
+		result.reserve( count );
+		for( std::size_t n = 0; n < count / 2U; ++n ) {
+			auto const x = std::ldexp( mant( engine ), exp( engine ) );
+			result.push_back( x );
+			result.push_back( -x * ( 1.0 - 1e-9 ) );
+		}
+		std::shuffle( result.begin( ), result.end( ), engine );
+		return result;
+	}
+
+	void sum_test( ) {
+		auto const ints = daw::make_random_data<std::int64_t>( 10'007, -1000, 1000 );
+		auto const expected =
+		  std::accumulate( ints.begin( ), ints.end( ), std::int64_t{ 0 } );
+		daw::expecting( expected, pipeline( ints, Sum ) );
+		daw::expecting( expected * 2, pipeline( ints,
+		                                        Map( []( std::int64_t x ) {
+			                                        return x * 2;
+		                                        } ),
+		                                        Sum ) );
+		auto const l = std::list<int>{ 1, 2, 3 };
+		daw::expecting( 6, pipeline( l, Sum ) );
+		daw::expecting( 0, pipeline( std::vector<int>( ), Sum ) );
+		static_assert( pipeline( iota_view<int>( 0, 10 ), Sum ) == 45 );
+	}
+
+	void neumaier_test( ) {
+		auto const v = make_ill_conditioned( 1'000'000 );
+		auto const exact = reference_sum( v );
+		auto const compensated = pipeline( v, SumKahanBabushkaNeumaier );
+		auto const naive = std::accumulate( v.begin( ), v.end( ), 0.0 );
+		auto const rel = []( double x, double e ) {
+			return std::abs( x - e ) / std::abs( e );
+		};
+		std::cout << "exact " << exact << " neumaier error " << rel( compensated, exact )
+		          << " naive error " << rel( naive, exact ) << '\n';
+		daw::expecting( rel( compensated, exact ) < 1e-12 );
+
+		// The classic case that breaks Kahan summation
+		auto const tricky = std::vector<double>{ 1.0, 1e100, 1.0, -1e100 };
+		daw::expecting( 2.0, pipeline( tricky, SumKahanBabushkaNeumaier ) );
+		auto const long_tricky = [] {
+			auto r = std::vector<double>( );
+			for( int n = 0; n < 100; ++n ) {
+				r.insert( r.end( ), { 1.0, 1e100, 1.0, -1e100 } );
+			}
+			return r;
+		}( );
+		daw::expecting( 200.0, pipeline( long_tricky, SumKahanBabushkaNeumaier ) );
+
+		struct item {
+			double price;
+		};
+		auto const items = std::vector<item>{ { 1.5 }, { 2.25 } };
+		daw::expecting( 3.75, pipeline( items, SumKahanBabushkaNeumaier( &item::price ) ) );
+	}
+
+	void dot_test( ) {
+		auto const a = std::vector<int>{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+		auto const b = std::vector<int>{ 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 };
+		daw::expecting( 220, pipeline( a, Dot( b ) ) );
+		auto const l = std::list<int>( b.begin( ), b.end( ) );
+		daw::expecting( 220, pipeline( a, Dot( l ) ) );
+		daw::expecting( 440, pipeline( a,
+		                               Map( []( int x ) {
+			                               return x * 2;
+		                               } ),
+		                               Dot( b ) ) );
+	}
+
+	void map_reduce_test( ) {
+		auto const v = daw::make_random_data<int>( 1'003, -100, 100 );
+		auto const square = []( int x ) {
+			return static_cast<std::int64_t>( x ) * x;
+		};
+		auto expected = std::int64_t{ 0 };
+		for( int x : v ) {
+			expected += square( x );
+		}
+		daw::expecting( expected,
+		                pipeline( v, MapReduce( square, std::plus<>{ }, std::int64_t{ 0 } ) ) );
+		auto const max_abs = pipeline( v, MapReduce(
+		                                    []( int x ) {
+			                                    return std::abs( x );
+		                                    },
+		                                    []( int l, int r ) {
+			                                    return std::max( l, r );
+		                                    },
+		                                    0 ) );
+		daw::expecting( std::abs( *std::max_element( v.begin( ), v.end( ),
+		                                             []( int l, int r ) {
+			                                             return std::abs( l ) < std::abs( r );
+		                                             } ) ),
+		                max_abs );
+		daw::expecting( 30, pipeline( std::list<int>{ 1, 2, 3, 4 },
+		                              MapReduce(
+		                                []( int x ) {
+			                                return x * x;
+		                                },
+		                                std::plus<>{ }, 0 ) ) );
+		daw::expecting( 4, pipeline( v, Filter( []( int ) {
+			                              return false;
+		                              } ),
+		                              MapReduce( square, std::plus<>{ }, std::int64_t{ 4 } ) ) );
+	}
+
+	void numeric_bench( ) {
+		constexpr std::size_t count = 4'000'000;
+		auto const v = make_ill_conditioned( count );
+		auto const bytes = count * sizeof( double );
+
+		(void)daw::bench_n_test_mbs<20>(
+		  "std::accumulate", bytes,
+		  []( std::vector<double> const &d ) {
+			  auto result = std::accumulate( d.begin( ), d.end( ), 0.0 );
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  v );
+		(void)daw::bench_n_test_mbs<20>(
+		  "Sum", bytes,
+		  []( std::vector<double> const &d ) {
+			  auto result = pipeline( d, Sum );
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  v );
+		(void)daw::bench_n_test_mbs<20>(
+		  "serial Neumaier", bytes,
+		  []( std::vector<double> const &d ) {
+			  auto acc = pimpl::neumaier_lanes<double>( );
+			  for( double x : d ) {
+				  acc.add( x );
+			  }
+			  auto result = acc.result( );
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  v );
+		(void)daw::bench_n_test_mbs<20>(
+		  "SumKahanBabushkaNeumaier", bytes,
+		  []( std::vector<double> const &d ) {
+			  auto result = pipeline( d, SumKahanBabushkaNeumaier );
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  v );
+
+		auto const w = make_ill_conditioned( count );
+		(void)daw::bench_n_test_mbs<20>(
+		  "std::inner_product", bytes * 2U,
+		  []( std::vector<double> const &a, std::vector<double> const &b ) {
+			  auto result = std::inner_product( a.begin( ), a.end( ), b.begin( ), 0.0 );
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  v, w );
+		(void)daw::bench_n_test_mbs<20>(
+		  "Dot", bytes * 2U,
+		  []( std::vector<double> const &a, std::vector<double> const &b ) {
+			  auto result = pipeline( a, Dot( b ) );
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  v, w );
+
+		auto const ints = daw::make_random_data<std::int32_t>( count, -1000, 1000 );
+		auto const square = []( std::int32_t x ) {
+			return static_cast<std::int64_t>( x ) * x;
+		};
+		(void)daw::bench_n_test_mbs<20>(
+		  "Map then Sum", count * sizeof( std::int32_t ),
+		  [&]( std::vector<std::int32_t> const &d ) {
+			  auto result = pipeline( d, Map( square ), Sum );
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  ints );
+		(void)daw::bench_n_test_mbs<20>(
+		  "MapReduce", count * sizeof( std::int32_t ),
+		  [&]( std::vector<std::int32_t> const &d ) {
+			  auto result =
+			    pipeline( d, MapReduce( square, std::plus<>{ }, std::int64_t{ 0 } ) );
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  ints );
+	}
+} // namespace
+
+int main( ) {
+	sum_test( );
+	neumaier_test( );
+	dot_test( );
+	map_reduce_test( );
+	numeric_bench( );
+	std::cout << "done\n";
+}
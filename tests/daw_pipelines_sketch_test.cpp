@@ -0,0 +1,78 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include <daw/pipelines/sketch.h>
+
+#include <daw/pipelines/filter.h>
+#include <daw/pipelines/iota.h>
+#include <daw/pipelines/map.h>
+#include <daw/pipelines/pipeline.h>
+
+#include <daw/daw_benchmark.h>
+
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <list>
+#include <string>
+#include <vector>
+
+namespace {
+	using namespace daw::pipelines;
+
+	void top_k_sink_test( ) {
+		auto const v = std::vector<int>{ 5, 1, 9, 3, 7, 2, 8 };
+		auto const largest = pipeline( v, TopK( 3 ) );
+		daw::expecting( std::vector<int>{ 9, 8, 7 } == largest.values( ) );
+
+		auto const smallest_doubled = pipeline( v,
+		                                        Map( []( int x ) {
+			                                        return x * 2;
+		                                        } ),
+		                                        TopK( 2, std::greater<>{ } ) );
+		daw::expecting( std::vector<int>{ 2, 4 } == smallest_doubled.values( ) );
+
+		auto const words = std::list<std::string>{ "b", "d", "a", "c" };
+		daw::expecting( std::string( "d" ),
+		                pipeline( words, TopK( 1 ) ).values( ).front( ) );
+	}
+
+	void quantiles_sink_test( ) {
+		auto const digest = pipeline( iota_view<int>( 0, 100'001 ), Quantiles( ) );
+		daw::expecting( 100'001U, digest.count( ) );
+		daw::expecting( 0.0, digest.quantile( 0.0 ) );
+		daw::expecting( 100'000.0, digest.quantile( 1.0 ) );
+		auto const p99 = digest.quantile( 0.99 );
+		daw::expecting( p99 > 98'900.0 and p99 < 99'100.0 );
+	}
+
+	void count_distinct_sink_test( ) {
+		auto const hll = pipeline( iota_view<int>( 0, 50'000 ),
+		                           Map( []( int x ) {
+			                           return x % 1'000;
+		                           } ),
+		                           CountDistinct( ) );
+		auto const estimate = hll.estimate( );
+		daw::expecting( estimate > 980.0 and estimate < 1'020.0 );
+
+		auto const odd = pipeline( iota_view<int>( 0, 2'000 ),
+		                           Filter( []( int x ) {
+			                           return x % 2 == 1;
+		                           } ),
+		                           CountDistinct( 12 ) );
+		daw::expecting( 12U, odd.precision( ) );
+		daw::expecting( odd.count( ) > 980U and odd.count( ) < 1'020U );
+	}
+} // namespace
+
+int main( ) {
+	top_k_sink_test( );
+	quantiles_sink_test( );
+	count_distinct_sink_test( );
+	std::cout << "done\n";
+}
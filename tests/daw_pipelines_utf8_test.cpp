@@ -0,0 +1,49 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include <daw/pipelines/utf8.h>
+
+#include <daw/pipelines/map.h>
+#include <daw/pipelines/pipeline.h>
+#include <daw/pipelines/to.h>
+
+#include <daw/daw_benchmark.h>
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+	using namespace daw::pipelines;
+
+	void utf8_validate_test( ) {
+		auto const records = std::vector<std::string>{
+		  "plain", "caf\xC3\xA9", "bad \xC3", "\xE6\x97\xA5\xE6\x9C\xAC", "\xED\xA0\x80" };
+		auto const valid = pipeline( records, Utf8Validate, To<std::vector> );
+		daw::expecting(
+		  std::vector<std::string>{ "plain", "caf\xC3\xA9", "\xE6\x97\xA5\xE6\x9C\xAC" } ==
+		  valid );
+
+		auto const sizes = pipeline( records,
+		                             Map( []( std::string const &s ) {
+			                             return std::string_view( s );
+		                             } ),
+		                             Utf8Validate,
+		                             Map( []( std::string_view sv ) {
+			                             return daw::count_utf8_code_points( sv );
+		                             } ),
+		                             To<std::vector> );
+		daw::expecting( std::vector<std::size_t>{ 5, 4, 2 } == sizes );
+	}
+} // namespace
+
+int main( ) {
+	utf8_validate_test( );
+	std::cout << "done\n";
+}
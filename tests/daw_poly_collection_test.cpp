@@ -0,0 +1,230 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include "daw/daw_poly_collection.h"
+
+#include "daw/daw_benchmark.h"
+#include "daw/daw_poly_var.h"
+#if defined( __cpp_concepts )
+#include "daw/daw_poly_value.h"
+#endif
+
+#include <atomic>
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+	struct Shape {
+		Shape( ) = default;
+		virtual ~Shape( ) = default;
+		Shape( Shape const & ) = default;
+		Shape( Shape && ) = default;
+		Shape &operator=( Shape const & ) = default;
+		Shape &operator=( Shape && ) = default;
+
+		virtual double area( ) const = 0;
+	};
+
+	struct Square final : Shape {
+		double side = 1.0;
+
+		Square( ) = default;
+		explicit Square( double s )
+		  : side( s ) {}
+
+		double area( ) const override {
+			return side * side;
+		}
+	};
+
+	struct Rect final : Shape {
+		double width = 1.0;
+		double height = 1.0;
+
+		Rect( ) = default;
+		Rect( double w, double h )
+		  : width( w )
+		  , height( h ) {}
+
+		double area( ) const override {
+			return width * height;
+		}
+	};
+
+	struct Circle final : Shape {
+		double radius = 1.0;
+
+		Circle( ) = default;
+		explicit Circle( double r )
+		  : radius( r ) {}
+
+		double area( ) const override {
+			return 3.0 * radius * radius;
+		}
+	};
+
+	using collection_t = daw::poly_collection<Shape, Square, Rect, Circle>;
+
+	void poly_collection_test_001( ) {
+		auto c = collection_t( );
+		daw::expecting( c.empty( ) );
+		auto const h0 = c.emplace<Square>( 2.0 );
+		auto const h1 = c.emplace<Rect>( 2.0, 3.0 );
+		auto const h2 = c.insert( Circle( 1.0 ) );
+		auto const h3 = c.emplace<Square>( 3.0 );
+		daw::expecting( 4U, c.size( ) );
+		daw::expecting( 2U, c.size<Square>( ) );
+		daw::expecting( 4.0, c[h0].area( ) );
+		daw::expecting( 6.0, c[h1].area( ) );
+		daw::expecting( 3.0, c[h2].area( ) );
+		daw::expecting( c.get_if<Rect>( h0 ) == nullptr );
+		daw::expecting( 9.0, c.get_if<Square>( h3 )->area( ) );
+
+		// erasing moves h3 into h0's position, but h3 stays valid
+		daw::expecting( c.erase( h0 ) );
+		daw::expecting( not c.contains( h0 ) );
+		daw::expecting( not c.erase( h0 ) );
+		daw::expecting( 9.0, c[h3].area( ) );
+		daw::expecting( 1U, c.size<Square>( ) );
+
+		// reused slots do not revive old handles
+		auto const h4 = c.emplace<Square>( 4.0 );
+		daw::expecting( h4.slot == h0.slot );
+		daw::expecting( not c.contains( h0 ) );
+		daw::expecting( 16.0, c[h4].area( ) );
+
+		double total = 0.0;
+		c.for_each( [&]( auto const &shape ) {
+			total += shape.area( );
+		} );
+		daw::expecting( 9.0 + 16.0 + 6.0 + 3.0, total );
+
+		c.clear( );
+		daw::expecting( c.empty( ) );
+		daw::expecting( not c.contains( h4 ) );
+	}
+
+	void poly_collection_parallel_test( ) {
+		auto c = collection_t( );
+		for( std::size_t n = 0; n < 100'000; ++n ) {
+			switch( n % 3 ) {
+			case 0:
+				(void)c.emplace<Square>( 1.0 );
+				break;
+			case 1:
+				(void)c.emplace<Rect>( 1.0, 2.0 );
+				break;
+			default:
+				(void)c.emplace<Circle>( 1.0 );
+				break;
+			}
+		}
+		auto total = std::atomic<std::size_t>{ 0 };
+		c.parallel_for_each(
+		  [&]( auto const &shape ) {
+			  total.fetch_add( static_cast<std::size_t>( shape.area( ) ),
+			                   std::memory_order_relaxed );
+		  },
+		  4, 1000 );
+		daw::expecting( 33'334U * 1U + 33'333U * 2U + 33'333U * 3U, total.load( ) );
+
+		bool has_thrown = false;
+		try {
+			c.parallel_for_each(
+			  []( auto const & ) {
+				  throw std::runtime_error( "expected" );
+			  },
+			  4, 1000 );
+		} catch( std::runtime_error const & ) { has_thrown = true; }
+		daw::expecting( has_thrown );
+	}
+
+	constexpr std::size_t bench_size = 1'000'000;
+
+	template<typename F>
+	void fill( F &&add ) {
+		for( std::size_t n = 0; n < bench_size; ++n ) {
+			auto const d = static_cast<double>( n % 7 );
+			switch( ( n * 7919U ) % 3 ) {
+			case 0:
+				add( Square( d ) );
+				break;
+			case 1:
+				add( Rect( d, 2.0 ) );
+				break;
+			default:
+				add( Circle( d ) );
+				break;
+			}
+		}
+	}
+
+	void poly_collection_bench( ) {
+		auto c = collection_t( );
+		fill( [&]( auto &&s ) {
+			(void)c.insert( s );
+		} );
+		daw::bench_n_test<20>(
+		  "poly_collection for_each 1M",
+		  [&]( collection_t const &col ) {
+			  double total = 0.0;
+			  col.for_each( [&]( auto const &shape ) {
+				  total += shape.area( );
+			  } );
+			  daw::do_not_optimize( total );
+			  return total;
+		  },
+		  c );
+
+		using var_t = daw::poly_var<Shape, Square, Rect, Circle>;
+		auto vars = std::vector<var_t>( );
+		vars.reserve( bench_size );
+		fill( [&]( auto &&s ) {
+			vars.emplace_back( s );
+		} );
+		daw::bench_n_test<20>(
+		  "std::vector<poly_var> 1M",
+		  [&]( std::vector<var_t> const &v ) {
+			  double total = 0.0;
+			  for( auto const &shape : v ) {
+				  total += shape->area( );
+			  }
+			  daw::do_not_optimize( total );
+			  return total;
+		  },
+		  vars );
+
+#if defined( __cpp_concepts )
+		auto values = std::vector<daw::poly_value<Shape>>( );
+		values.reserve( bench_size );
+		fill( [&]( auto &&s ) {
+			values.emplace_back( s );
+		} );
+		daw::bench_n_test<20>(
+		  "std::vector<poly_value> 1M",
+		  [&]( std::vector<daw::poly_value<Shape>> const &v ) {
+			  double total = 0.0;
+			  for( auto const &shape : v ) {
+				  total += shape->area( );
+			  }
+			  daw::do_not_optimize( total );
+			  return total;
+		  },
+		  values );
+#endif
+	}
+} // namespace
+
+int main( ) {
+	poly_collection_test_001( );
+	poly_collection_parallel_test( );
+	poly_collection_bench( );
+	std::cout << "done\n";
+}
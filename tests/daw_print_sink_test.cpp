@@ -0,0 +1,204 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include "daw/daw_print_sink.h"
+
+#include "daw/daw_benchmark.h"
+#include "daw/daw_string_concat.h"
+
+#if __has_include( <format> )
+#include <format>
+#endif
+#if defined( __cpp_lib_format )
+#include "daw/daw_print.h"
+#include "daw/daw_print_buffered.h"
+#endif
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+	constexpr std::size_t line_count = 100'000;
+
+	std::string read_all( std::FILE *f ) {
+		(void)std::fflush( f );
+		std::rewind( f );
+		auto result = std::string( );
+		auto buff = std::array<char, 4096>{ };
+		std::size_t n = 0;
+		while( ( n = std::fread( buff.data( ), 1, buff.size( ), f ) ) > 0 ) {
+			result.append( buff.data( ), n );
+		}
+		return result;
+	}
+
+	std::vector<std::string> split_lines( std::string const &str ) {
+		auto result = std::vector<std::string>( );
+		std::size_t first = 0;
+		while( first < str.size( ) ) {
+			auto const pos = str.find( '\n', first );
+			result.push_back( str.substr( first, pos - first ) );
+			first = pos + 1;
+		}
+		return result;
+	}
+
+	void check_lines( std::string const &output, std::size_t thread_count ) {
+		auto lines = split_lines( output );
+		daw::expecting( thread_count * line_count, lines.size( ) );
+		auto expected = std::vector<std::string>( );
+		for( std::size_t t = 0; t < thread_count; ++t ) {
+			for( std::size_t n = 0; n < line_count; ++n ) {
+				expected.push_back( daw::concat( "thread ", t, " line ", n ) );
+			}
+		}
+		std::sort( lines.begin( ), lines.end( ) );
+		std::sort( expected.begin( ), expected.end( ) );
+		daw::expecting( lines == expected );
+	}
+
+	void run_threads( daw::buffered_print_sink &sink, std::size_t thread_count ) {
+		auto threads = std::vector<std::thread>( );
+		for( std::size_t t = 0; t < thread_count; ++t ) {
+			threads.emplace_back( [&, t] {
+				for( std::size_t n = 0; n < line_count; ++n ) {
+					sink.append_with( [&]( std::string &buf ) {
+						daw::concat_append( buf, "thread ", t, " line ", n, '\n' );
+					} );
+				}
+			} );
+		}
+		for( auto &th : threads ) {
+			th.join( );
+		}
+	}
+
+	void print_sink_test_001( ) {
+		std::FILE *f = std::tmpfile( );
+		daw::expecting( f != nullptr );
+		{
+			auto sink = daw::buffered_print_sink( f );
+			sink.write( "hello " );
+			sink.write_line( "world" );
+			sink.flush( );
+			daw::expecting( std::string( "hello world\n" ), read_all( f ) );
+			sink.write_line( "again" );
+		}
+		daw::expecting( std::string( "hello world\nagain\n" ), read_all( f ) );
+		std::fclose( f );
+	}
+
+	void print_sink_threads_test( ) {
+		for( bool writev : { false, true } ) {
+			std::FILE *f = std::tmpfile( );
+			{
+				auto opts = daw::print_sink_options{ };
+				opts.flush_threshold = 4096;
+				opts.use_writev = writev;
+				auto sink = daw::buffered_print_sink( f, opts );
+				run_threads( sink, 4 );
+			}
+			check_lines( read_all( f ), 4 );
+			std::fclose( f );
+		}
+	}
+
+	void print_sink_async_test( ) {
+		std::FILE *f = std::tmpfile( );
+		{
+			auto opts = daw::print_sink_options{ };
+			opts.async = true;
+			opts.flush_threshold = 4096;
+			opts.flush_interval = std::chrono::milliseconds( 1 );
+			auto sink = daw::buffered_print_sink( f, opts );
+			run_threads( sink, 4 );
+			// The writer thread picks up a short line on its timer
+			sink.write_line( "thread 0 line 0" );
+			std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+			auto const out = read_all( f );
+			daw::expecting( out.size( ) >= 4U * line_count * 15U );
+		}
+		auto out = read_all( f );
+		auto const pos = out.rfind( "thread 0 line 0\n" );
+		daw::expecting( pos != std::string::npos );
+		out.erase( pos, 16 );
+		check_lines( out, 4 );
+		std::fclose( f );
+	}
+
+	template<typename Writer>
+	void lines_per_sec( char const *title, Writer &&writer ) {
+		auto const t = daw::bench_n_test<5>(
+		  title,
+		  [&]( std::size_t count ) {
+			  for( std::size_t n = 0; n < count; ++n ) {
+				  writer( n );
+			  }
+			  return count;
+		  },
+		  line_count );
+		(void)t;
+	}
+
+	void print_sink_bench( ) {
+		std::FILE *f = std::fopen( "/dev/null", "wb" );
+		if( f == nullptr ) {
+			return;
+		}
+		lines_per_sec( "fwrite per line", [&]( std::size_t n ) {
+			auto const line = daw::concat( "line number ", n, " of output\n" );
+			(void)std::fwrite( line.data( ), 1, line.size( ), f );
+		} );
+		{
+			auto sink = daw::buffered_print_sink( f );
+			lines_per_sec( "buffered_print_sink", [&]( std::size_t n ) {
+				sink.append_with( [&]( std::string &buf ) {
+					daw::concat_append( buf, "line number ", n, " of output\n" );
+				} );
+			} );
+		}
+#if defined( __cpp_lib_format )
+		lines_per_sec( "daw::println( FILE * )", [&]( std::size_t n ) {
+			daw::println( f, "line number {} of output", n );
+		} );
+		{
+			auto sink = daw::buffered_print_sink( f );
+			lines_per_sec( "daw::println( buffered_print_sink )",
+			               [&]( std::size_t n ) {
+				               daw::println( sink, "line number {} of output", n );
+			               } );
+		}
+		{
+			auto opts = daw::print_sink_options{ };
+			opts.async = true;
+			auto sink = daw::buffered_print_sink( f, opts );
+			lines_per_sec( "daw::println( buffered_print_sink async )",
+			               [&]( std::size_t n ) {
+				               daw::println( sink, "line number {} of output", n );
+			               } );
+		}
+#endif
+		std::cout << "lines per run: " << line_count << '\n';
+		std::fclose( f );
+	}
+} // namespace
+
+int main( ) {
+	print_sink_test_001( );
+	print_sink_threads_test( );
+	print_sink_async_test( );
+	print_sink_bench( );
+	std::cout << "done\n";
+}
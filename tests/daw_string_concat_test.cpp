@@ -8,13 +8,140 @@
 
 #include <daw/daw_string_concat.h>
 
+#include <daw/daw_benchmark.h>
+#include <daw/daw_string_view.h>
+
+#include <array>
+#include <cstdint>
 #include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
 
 std::string
 concat2( std::string const &s0, std::string const &s1, std::string const &s2 ) {
 	return daw::string_concat( s0, s1, s2 );
 }
 
+namespace {
+	void concat_test_001( ) {
+		auto const result = daw::concat( "a=", 1, ", b=", -42, ", c=", 'x',
+		                                 std::string( ", d=" ), true );
+		daw::expecting( std::string( "a=1, b=-42, c=x, d=true" ), result );
+		daw::expecting( result.size( ), daw::concat_size( "a=", 1, ", b=", -42,
+		                                                  ", c=", 'x',
+		                                                  std::string( ", d=" ),
+		                                                  true ) );
+	}
+
+	void concat_test_integers( ) {
+		daw::expecting( std::string( "0" ), daw::concat( 0 ) );
+		daw::expecting( std::string( "9" ), daw::concat( 9U ) );
+		daw::expecting( std::string( "10" ), daw::concat( 10 ) );
+		daw::expecting( std::string( "-9223372036854775808" ),
+		                daw::concat( std::numeric_limits<std::int64_t>::min( ) ) );
+		daw::expecting( std::string( "18446744073709551615" ),
+		                daw::concat( std::numeric_limits<std::uint64_t>::max( ) ) );
+		for( std::uint64_t n = 1; n < 10'000'000'000'000'000'000ULL / 7U;
+		     n = n * 7U + 3U ) {
+			daw::expecting( std::to_string( n ), daw::concat( n ) );
+		}
+	}
+
+	void concat_test_floats( ) {
+		daw::expecting( std::string( "1.5" ), daw::concat( 1.5 ) );
+		daw::expecting( std::string( "x=0.1;" ), daw::concat( "x=", 0.1, ';' ) );
+		daw::expecting( std::string( "-2.5e+300" ), daw::concat( -2.5e300 ) );
+		daw::expecting( std::string( "0.25" ), daw::concat( 0.25F ) );
+	}
+
+	void concat_test_append( ) {
+		auto str = std::string( "prefix:" );
+		daw::concat_append( str, daw::string_view( "sv" ), 12 );
+		daw::expecting( std::string( "prefix:sv12" ), str );
+
+		auto const vec = daw::concat<std::vector<char>>( "abc", 123 );
+		daw::expecting( std::string( "abc123" ),
+		                std::string( vec.data( ), vec.size( ) ) );
+	}
+
+	struct test_writer {
+		char *first;
+		std::size_t len;
+
+		char *data( ) const {
+			return first;
+		}
+
+		std::size_t size( ) const {
+			return len;
+		}
+
+		void remove_prefix( std::size_t n ) {
+			first += n;
+			len -= n;
+		}
+	};
+
+	void concat_test_to( ) {
+		auto buff = std::array<char, 32>{ };
+		auto *last = daw::concat_to( buff.data( ), "id:", 77 );
+		daw::expecting( std::string( "id:77" ),
+		                std::string( buff.data( ), last ) );
+
+		auto writer = test_writer{ buff.data( ), buff.size( ) };
+		daw::concat_to( writer, "a", 1 );
+		daw::concat_to( writer, ",b", 2 );
+		daw::expecting( buff.size( ) - 5U, writer.size( ) );
+		daw::expecting( std::string( "a1,b2" ), std::string( buff.data( ), 5 ) );
+
+		// Arrays decay to the char * overload
+		char arr[8]{ };
+		last = daw::concat_to( arr, "x", 9 );
+		daw::expecting( std::string( "x9" ), std::string( arr, last ) );
+		static_assert( not daw::traits::is_span_writer_v<std::string_view> );
+		static_assert( daw::traits::is_span_writer_v<test_writer> );
+	}
+
+	void join_test( ) {
+		auto const words = std::vector<std::string>{ "a", "bc", "def" };
+		daw::expecting( std::string( "a, bc, def" ), daw::join( words, ", " ) );
+		daw::expecting( std::string( "abcdef" ), daw::join( words ) );
+		auto const nums = std::vector<int>{ 1, -2, 30 };
+		daw::expecting( std::string( "1|-2|30" ), daw::join( nums, '|' ) );
+		daw::expecting( std::string( ),
+		                daw::join( std::vector<std::string>{ }, ", " ) );
+	}
+
+	void concat_bench( ) {
+		auto const name = std::string( "some_name_that_is_long" );
+		daw::bench_n_test<100'000>(
+		  "std::string operator+",
+		  [&]( std::string const &n, int v ) {
+			  auto result = n + ":" + std::to_string( v ) + "/" + n;
+			  daw::do_not_optimize( result );
+			  return result.size( );
+		  },
+		  name, 123456 );
+		daw::bench_n_test<100'000>(
+		  "daw::concat",
+		  [&]( std::string const &n, int v ) {
+			  auto result = daw::concat( n, ':', v, '/', n );
+			  daw::do_not_optimize( result );
+			  return result.size( );
+		  },
+		  name, 123456 );
+	}
+} // namespace
+
 int main( ) {
 	std::cout << concat2( "A", "b", "c\n" );
+	concat_test_001( );
+	concat_test_integers( );
+	concat_test_floats( );
+	concat_test_append( );
+	concat_test_to( );
+	join_test( );
+	concat_bench( );
+	std::cout << "done\n";
 }
@@ -0,0 +1,168 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include "daw/daw_tdigest.h"
+
+#include "daw/daw_benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+	std::vector<double> make_latencies( std::size_t count, unsigned seed ) {
+		auto engine = std::mt19937_64( seed );
+		auto dist = std::lognormal_distribution<double>( 3.0, 0.75 );
+		auto result = std::vector<double>( count );
+		for( auto &v : result ) {
+			v = dist( engine );
+		}
+		return result;
+	}
+
+	double exact_quantile( std::vector<double> sorted, double q ) {
+		auto const index = static_cast<std::size_t>(
+		  q * static_cast<double>( sorted.size( ) - 1U ) );
+		return sorted[index];
+	}
+
+	/// The rank error of an estimate, the measure t-digest bounds
+	double rank_error( std::vector<double> const &sorted, double estimate,
+	                   double q ) {
+		auto const rank = std::lower_bound( sorted.begin( ), sorted.end( ), estimate ) -
+		                  sorted.begin( );
+		return std::abs( static_cast<double>( rank ) /
+		                   static_cast<double>( sorted.size( ) ) -
+		                 q );
+	}
+
+	void tdigest_test_001( ) {
+		auto d = daw::tdigest( );
+		daw::expecting( std::isnan( d.quantile( 0.5 ) ) );
+		for( int n = 1; n <= 5; ++n ) {
+			d.insert( static_cast<double>( n ) );
+		}
+		daw::expecting( 5U, d.count( ) );
+		daw::expecting( 1.0, d.quantile( 0.0 ) );
+		daw::expecting( 3.0, d.quantile( 0.5 ) );
+		daw::expecting( 5.0, d.quantile( 1.0 ) );
+		daw::expecting( 0.0, d.cdf( 0.5 ) );
+		daw::expecting( 1.0, d.cdf( 5.0 ) );
+	}
+
+	void tdigest_accuracy_test( ) {
+		auto const data = make_latencies( 1'000'000, 42 );
+		auto d = daw::tdigest( 100.0 );
+		d.insert( data.begin( ), data.end( ) );
+		auto sorted = data;
+		std::sort( sorted.begin( ), sorted.end( ) );
+		daw::expecting( sorted.front( ), d.min( ) );
+		daw::expecting( sorted.back( ), d.max( ) );
+		for( double q : { 0.5, 0.9, 0.99, 0.999 } ) {
+			auto const est = d.quantile( q );
+			auto const err = rank_error( sorted, est, q );
+			std::cout << "p" << q * 100.0 << ": exact " << exact_quantile( sorted, q )
+			          << " estimate " << est << " rank error " << err << '\n';
+			daw::expecting( err < 0.005 * std::max( 4.0 * q * ( 1.0 - q ), 0.02 ) +
+			                        0.0005 );
+		}
+		auto const p99 = exact_quantile( sorted, 0.99 );
+		daw::expecting( std::abs( d.cdf( p99 ) - 0.99 ) < 0.001 );
+		d.compress( );
+		daw::expecting( d.centroid_count( ) < 200U );
+	}
+
+	void tdigest_merge_test( ) {
+		constexpr std::size_t parts = 4;
+		auto digests = std::vector<daw::tdigest>( parts, daw::tdigest( 200.0 ) );
+		auto all = std::vector<double>( );
+		auto data = std::vector<std::vector<double>>( );
+		for( std::size_t n = 0; n < parts; ++n ) {
+			data.push_back( make_latencies( 250'000, static_cast<unsigned>( n ) ) );
+			all.insert( all.end( ), data.back( ).begin( ), data.back( ).end( ) );
+		}
+		auto threads = std::vector<std::thread>( );
+		for( std::size_t n = 0; n < parts; ++n ) {
+			threads.emplace_back( [&, n] {
+				digests[n].insert( data[n].begin( ), data[n].end( ) );
+			} );
+		}
+		for( auto &t : threads ) {
+			t.join( );
+		}
+		auto merged = digests[0];
+		for( std::size_t n = 1; n < parts; ++n ) {
+			merged.merge( digests[n] );
+		}
+		daw::expecting( all.size( ), merged.count( ) );
+		std::sort( all.begin( ), all.end( ) );
+		daw::expecting( rank_error( all, merged.quantile( 0.99 ), 0.99 ) < 0.001 );
+
+		auto buffer = std::vector<char>( merged.serialized_size( ) );
+		auto *const last = merged.serialize_to( buffer.data( ) );
+		daw::expecting( buffer.data( ) + buffer.size( ) == last );
+		auto const copy = daw::tdigest::from_buffer( buffer.data( ), buffer.size( ) );
+		daw::expecting( copy.has_value( ) );
+		daw::expecting( merged.count( ) == copy->count( ) );
+		daw::expecting( merged.max( ), copy->max( ) );
+		for( double q : { 0.01, 0.5, 0.99 } ) {
+			daw::expecting( merged.quantile( q ), copy->quantile( q ) );
+		}
+		daw::expecting( not daw::tdigest::from_buffer( buffer.data( ), 10 ) );
+
+		auto self = digests[1];
+		self.merge( self );
+		daw::expecting( 2U * digests[1].count( ), self.count( ) );
+		for( double q : { 0.5, 0.99 } ) {
+			auto const expected = digests[1].quantile( q );
+			daw::expecting( std::abs( self.quantile( q ) - expected ) <
+			                0.01 * expected );
+		}
+	}
+
+	void tdigest_bench( ) {
+		auto const data = make_latencies( 4'000'000, 7 );
+		daw::bench_n_test<10>(
+		  "std::sort for all quantiles", []( std::vector<double> d ) {
+			  std::sort( d.begin( ), d.end( ) );
+			  daw::do_not_optimize( d );
+			  return d[d.size( ) / 2U];
+		  },
+		  data );
+		daw::bench_n_test<10>(
+		  "std::nth_element for p99", []( std::vector<double> d ) {
+			  auto const mid = d.begin( ) + static_cast<std::ptrdiff_t>(
+			                                  static_cast<double>( d.size( ) ) * 0.99 );
+			  std::nth_element( d.begin( ), mid, d.end( ) );
+			  daw::do_not_optimize( *mid );
+			  return *mid;
+		  },
+		  data );
+		daw::bench_n_test<10>(
+		  "tdigest p99", []( std::vector<double> const &d ) {
+			  auto digest = daw::tdigest( );
+			  digest.insert( d.begin( ), d.end( ) );
+			  auto result = digest.quantile( 0.99 );
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  data );
+	}
+} // namespace
+
+int main( ) {
+	tdigest_test_001( );
+	tdigest_accuracy_test( );
+	tdigest_merge_test( );
+	tdigest_bench( );
+	std::cout << "done\n";
+}
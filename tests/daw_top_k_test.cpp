@@ -0,0 +1,160 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include "daw/daw_top_k.h"
+
+#include "daw/daw_benchmark.h"
+#include "daw/daw_keep_n.h"
+#include "daw/daw_random.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+	template<typename T, typename Compare = std::less<>>
+	std::vector<T> expected_top( std::vector<T> v, std::size_t k,
+	                             Compare comp = Compare{ } ) {
+		std::sort( v.begin( ), v.end( ), [&]( T const &l, T const &r ) {
+			return comp( r, l );
+		} );
+		v.resize( std::min( v.size( ), k ) );
+		return v;
+	}
+
+	template<template<typename, typename> class TopK>
+	void top_k_test( ) {
+		auto const data = daw::make_random_data<int>( 100'000, -1'000'000, 1'000'000 );
+		auto largest = TopK<int, std::less<>>( 100 );
+		largest.insert( data.begin( ), data.end( ) );
+		daw::expecting( 100U, largest.size( ) );
+		daw::expecting( data.size( ), largest.total( ) );
+		daw::expecting( expected_top( data, 100 ) == largest.values( ) );
+
+		auto smallest = TopK<int, std::greater<>>( 1000 );
+		smallest.insert( data.begin( ), data.end( ) );
+		daw::expecting( expected_top( data, 1000, std::greater<>{ } ) ==
+		                smallest.values( ) );
+
+		auto few = TopK<std::string, std::less<>>( 10 );
+		for( auto s : { "pear", "apple", "fig" } ) {
+			few.insert( s );
+		}
+		daw::expecting( 3U, few.size( ) );
+		daw::expecting( std::string( "pear" ), few.values( ).front( ) );
+	}
+
+	template<template<typename, typename> class TopK>
+	void top_k_merge_test( ) {
+		auto const data = daw::make_random_data<std::uint32_t>( 400'000 );
+		constexpr std::size_t k = 500;
+		auto parts = std::vector<TopK<std::uint32_t, std::less<>>>(
+		  4, TopK<std::uint32_t, std::less<>>( k ) );
+		auto threads = std::vector<std::thread>( );
+		auto const part_size = data.size( ) / parts.size( );
+		for( std::size_t n = 0; n < parts.size( ); ++n ) {
+			threads.emplace_back( [&, n] {
+				auto const first = data.begin( ) + static_cast<std::ptrdiff_t>( n * part_size );
+				parts[n].insert( first, first + static_cast<std::ptrdiff_t>( part_size ) );
+			} );
+		}
+		for( auto &t : threads ) {
+			t.join( );
+		}
+		auto result = parts[0];
+		for( std::size_t n = 1; n < parts.size( ); ++n ) {
+			result.merge( parts[n] );
+		}
+		daw::expecting( data.size( ), result.total( ) );
+		daw::expecting( expected_top( data, k ) == result.values( ) );
+
+		// Merging with itself doubles every kept value
+		auto self = TopK<std::uint32_t, std::less<>>( 4 );
+		self.insert( 1U );
+		self.insert( 2U );
+		self.merge( self );
+		daw::expecting( 4U, self.total( ) );
+		daw::expecting( std::vector<std::uint32_t>{ 2U, 2U, 1U, 1U } ==
+		                self.values( ) );
+
+		auto buffer = std::vector<char>( result.serialized_size( ) );
+		auto *const last = result.serialize_to( buffer.data( ) );
+		daw::expecting( buffer.data( ) + buffer.size( ) == last );
+		auto const copy = TopK<std::uint32_t, std::less<>>::from_buffer(
+		  buffer.data( ), buffer.size( ) );
+		daw::expecting( copy.has_value( ) );
+		daw::expecting( k, copy->k( ) );
+		daw::expecting( result.total( ), copy->total( ) );
+		daw::expecting( result.values( ) == copy->values( ) );
+		daw::expecting( not TopK<std::uint32_t, std::less<>>::from_buffer(
+		  buffer.data( ), buffer.size( ) - 1U ) );
+		daw::expecting( not TopK<std::uint64_t, std::less<>>::from_buffer(
+		  buffer.data( ), buffer.size( ) ) );
+	}
+
+	template<std::size_t K>
+	void top_k_bench( std::vector<std::uint32_t> const &data ) {
+		std::cout << "k = " << K << '\n';
+		if constexpr( K <= 100 ) {
+			daw::bench_n_test<10>(
+			  "keep_n", []( std::vector<std::uint32_t> const &d ) {
+				  auto result = daw::keep_n<std::uint32_t, K, daw::keep_n_order::descending>(
+				    std::numeric_limits<std::uint32_t>::min( ) );
+				  for( auto v : d ) {
+					  result.insert( v );
+				  }
+				  daw::do_not_optimize( result );
+				  return result.front( );
+			  },
+			  data );
+		}
+		daw::bench_n_test<10>(
+		  "top_k_heap", []( std::vector<std::uint32_t> const &d ) {
+			  auto result = daw::top_k_heap<std::uint32_t>( K );
+			  result.insert( d.begin( ), d.end( ) );
+			  daw::do_not_optimize( result );
+			  return result.size( );
+		  },
+		  data );
+		daw::bench_n_test<10>(
+		  "top_k", []( std::vector<std::uint32_t> const &d ) {
+			  auto result = daw::top_k<std::uint32_t>( K );
+			  result.insert( d.begin( ), d.end( ) );
+			  daw::do_not_optimize( result );
+			  return result.size( );
+		  },
+		  data );
+		daw::bench_n_test<10>(
+		  "std::partial_sort_copy", []( std::vector<std::uint32_t> const &d ) {
+			  auto result = std::vector<std::uint32_t>( K );
+			  std::partial_sort_copy( d.begin( ), d.end( ), result.begin( ),
+			                          result.end( ), std::greater<>{ } );
+			  daw::do_not_optimize( result );
+			  return result.size( );
+		  },
+		  data );
+	}
+} // namespace
+
+int main( ) {
+	top_k_test<daw::top_k>( );
+	top_k_test<daw::top_k_heap>( );
+	top_k_merge_test<daw::top_k>( );
+	top_k_merge_test<daw::top_k_heap>( );
+
+	auto const data = daw::make_random_data<std::uint32_t>( 4'000'000 );
+	top_k_bench<100>( data );
+	top_k_bench<100'000>( data );
+	std::cout << "done\n";
+}
@@ -0,0 +1,236 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include <daw/daw_utf8.h>
+
+#include <daw/daw_benchmark.h>
+#include <daw/daw_ensure.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+	std::string encode( std::vector<char32_t> const &cps ) {
+		auto result = std::string( cps.size( ) * 4U, '\0' );
+		auto const r = daw::utf32_to_utf8(
+		  daw::u32string_view( cps.data( ), cps.size( ) ), result.data( ) );
+		daw_ensure( r.is_valid );
+		result.resize( static_cast<std::size_t>( r.last - result.data( ) ) );
+		return result;
+	}
+
+	/// Code points in the given ranges, weighted by how many are wanted of each
+	std::vector<char32_t> make_code_points( std::size_t count, double ascii,
+	                                        double cjk, unsigned seed ) {
+		auto engine = std::mt19937_64( seed );
+		auto kind = std::uniform_real_distribution<double>( 0.0, 1.0 );
+		auto result = std::vector<char32_t>( );
+		result.reserve( count );
+		auto pick = [&]( std::uint32_t lo, std::uint32_t hi ) {
+			return static_cast<char32_t>(
+			  std::uniform_int_distribution<std::uint32_t>( lo, hi )( engine ) );
+		};
+		for( std::size_t n = 0; n < count; ++n ) {
+			auto const k = kind( engine );
+			if( k < ascii ) {
+				result.push_back( pick( 0x20, 0x7E ) );
+			} else if( k < ascii + cjk ) {
+				result.push_back( pick( 0x4E00, 0x9FFF ) );
+			} else if( k < ascii + cjk + ( 1.0 - ascii - cjk ) / 2.0 ) {
+				result.push_back( pick( 0x80, 0x7FF ) );
+			} else {
+				result.push_back( pick( 0x1'0000, 0x10'FFFF ) );
+			}
+		}
+		return result;
+	}
+
+	void validation_test( ) {
+		daw_ensure( daw::is_valid_utf8( "" ) );
+		daw_ensure( daw::is_valid_utf8( "plain ascii" ) );
+		daw_ensure( daw::is_valid_utf8( "\xC3\xA9t\xC3\xA9 \xE6\x97\xA5\xE6\x9C\xAC "
+		                                "\xF0\x9F\x98\x80" ) );
+		daw_ensure( daw::is_valid_utf8( "\xED\x9F\xBF\xEE\x80\x80\xF4\x8F\xBF\xBF" ) );
+		char const *const invalid[] = {
+		  "\x80",             // lone continuation
+		  "\xC3",             // truncated
+		  "\xC0\xAF",         // overlong 2 byte
+		  "\xC1\xBF",         // overlong 2 byte
+		  "\xE0\x80\xAF",     // overlong 3 byte
+		  "\xED\xA0\x80",     // surrogate
+		  "\xF0\x80\x80\xAF", // overlong 4 byte
+		  "\xF4\x90\x80\x80", // past U+10FFFF
+		  "\xF5\x80\x80\x80", // bad lead
+		  "\xFF",             // bad lead
+		  "\xE6\x97",         // truncated 3 byte
+		  "\xC3\xA9\xA9",     // extra continuation
+		  "\xE6\x41\xA5",     // ascii inside a sequence
+		};
+		for( auto const *s : invalid ) {
+			daw_ensure( not daw::is_valid_utf8( s ) );
+			daw_ensure( daw::find_invalid_utf8( s ) != daw::string_view::npos );
+			// The same error after a long ASCII prefix and at every vector offset
+			for( std::size_t pad = 0; pad < 70; ++pad ) {
+				auto str = std::string( pad, 'a' ) + s + std::string( 70 - pad, 'b' );
+				daw_ensure( not daw::is_valid_utf8( str ) );
+				auto const pos = daw::find_invalid_utf8( str );
+				daw_ensure( pad <= pos and pos < pad + 4U );
+			}
+		}
+
+		// Compare the vector validator with the scalar one on mutated text
+		auto engine = std::mt19937_64( 42 );
+		auto const text = encode( make_code_points( 4000, 0.5, 0.3, 1 ) );
+		daw_ensure( daw::is_valid_utf8( text ) );
+		for( int n = 0; n < 3000; ++n ) {
+			auto copy = text;
+			auto const edits = 1 + static_cast<int>( engine( ) % 3U );
+			for( int e = 0; e < edits; ++e ) {
+				copy[engine( ) % copy.size( )] = static_cast<char>( engine( ) );
+			}
+			auto const len = engine( ) % copy.size( );
+			copy.resize( len );
+			auto const scalar =
+			  daw::utf8_impl::scalar_find_invalid( copy.data( ), copy.size( ) );
+			daw_ensure( daw::is_valid_utf8( copy ) == ( scalar == daw::string_view::npos ) );
+			daw_ensure( daw::find_invalid_utf8( copy ) == scalar );
+		}
+	}
+
+	void transcode_test( ) {
+		for( unsigned seed = 0; seed < 20; ++seed ) {
+			auto const cps = make_code_points( seed * 37U, 0.4, 0.3, seed );
+			auto const utf8 = encode( cps );
+			daw_ensure( daw::count_utf8_code_points( utf8 ) == cps.size( ) );
+			daw_ensure( daw::utf8_length_from_utf32(
+			              daw::u32string_view( cps.data( ), cps.size( ) ) ) == utf8.size( ) );
+
+			auto utf32 = std::vector<char32_t>( utf8.size( ) );
+			auto const r32 = daw::utf8_to_utf32( utf8, utf32.data( ) );
+			daw_ensure( r32.is_valid );
+			utf32.resize( static_cast<std::size_t>( r32.last - utf32.data( ) ) );
+			daw_ensure( utf32 == cps );
+
+			auto utf16 = std::vector<char16_t>( utf8.size( ) );
+			auto const r16 = daw::utf8_to_utf16( utf8, utf16.data( ) );
+			daw_ensure( r16.is_valid );
+			utf16.resize( static_cast<std::size_t>( r16.last - utf16.data( ) ) );
+			daw_ensure( utf16.size( ) == daw::utf16_length_from_utf8( utf8 ) );
+
+			auto const u16 = daw::u16string_view( utf16.data( ), utf16.size( ) );
+			daw_ensure( daw::utf8_length_from_utf16( u16 ) == utf8.size( ) );
+			auto back = std::string( utf16.size( ) * 3U, '\0' );
+			auto const r8 = daw::utf16_to_utf8( u16, back.data( ) );
+			daw_ensure( r8.is_valid );
+			back.resize( static_cast<std::size_t>( r8.last - back.data( ) ) );
+			daw_ensure( back == utf8 );
+		}
+
+		auto buffer = std::string( 64, '\0' );
+		char16_t const lone_high[] = { u'a', 0xD800, u'b' };
+		auto const r1 =
+		  daw::utf16_to_utf8( daw::u16string_view( lone_high, 3 ), buffer.data( ) );
+		daw_ensure( not r1 and r1.last == buffer.data( ) + 1 );
+		char16_t const lone_low[] = { 0xDC00 };
+		daw_ensure( not daw::utf16_to_utf8( daw::u16string_view( lone_low, 1 ),
+		                                    buffer.data( ) ) );
+		char32_t const too_big[] = { 0x11'0000 };
+		daw_ensure( not daw::utf32_to_utf8( daw::u32string_view( too_big, 1 ),
+		                                    buffer.data( ) ) );
+		auto utf16 = std::vector<char16_t>( 4 );
+		daw_ensure( not daw::utf8_to_utf16( "\xC0\xAF", utf16.data( ) ) );
+	}
+
+	constexpr bool constexpr_test( ) {
+		auto const s = daw::string_view( "a\xC3\xA9\xE6\x97\xA5\xF0\x9F\x98\x80" );
+		char32_t out[8]{ };
+		auto const r = daw::utf8_to_utf32( s, out );
+		char back[16]{ };
+		auto const r8 = daw::utf32_to_utf8(
+		  daw::u32string_view( out, static_cast<std::size_t>( r.last - out ) ), back );
+		return daw::is_valid_utf8( s ) and not daw::is_valid_utf8( "\xED\xA0\x80" ) and
+		       daw::count_utf8_code_points( s ) == 4U and
+		       daw::utf16_length_from_utf8( s ) == 5U and r.is_valid and
+		       out[0] == U'a' and out[1] == 0xE9 and out[2] == 0x65E5 and
+		       out[3] == 0x1F600 and r8.is_valid and
+		       daw::string_view( back, static_cast<std::size_t>( r8.last - back ) ) == s;
+	}
+	static_assert( constexpr_test( ) );
+
+	void utf8_bench( char const *title, std::string const &text ) {
+		std::cout << title << '\n';
+		auto const bytes = text.size( );
+		(void)daw::bench_n_test_mbs<10>(
+		  "scalar validate", bytes,
+		  []( std::string const &s ) {
+			  auto result = daw::utf8_impl::scalar_find_invalid( s.data( ), s.size( ) );
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  text );
+		(void)daw::bench_n_test_mbs<10>(
+		  "is_valid_utf8", bytes,
+		  []( std::string const &s ) {
+			  auto result = daw::is_valid_utf8( s );
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  text );
+		(void)daw::bench_n_test_mbs<10>(
+		  "count_utf8_code_points", bytes,
+		  []( std::string const &s ) {
+			  auto result = daw::count_utf8_code_points( s );
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  text );
+		auto utf16 = std::vector<char16_t>( bytes );
+		(void)daw::bench_n_test_mbs<10>(
+		  "utf8_to_utf16", bytes,
+		  [&]( std::string const &s ) {
+			  auto result = daw::utf8_to_utf16( s, utf16.data( ) );
+			  daw::do_not_optimize( utf16 );
+			  return result.is_valid;
+		  },
+		  text );
+		auto const u16_size = static_cast<std::size_t>(
+		  daw::utf8_to_utf16( text, utf16.data( ) ).last - utf16.data( ) );
+		auto back = std::string( u16_size * 3U, '\0' );
+		(void)daw::bench_n_test_mbs<10>(
+		  "utf16_to_utf8", bytes,
+		  [&]( std::vector<char16_t> const &u ) {
+			  auto result =
+			    daw::utf16_to_utf8( daw::u16string_view( u.data( ), u16_size ), back.data( ) );
+			  daw::do_not_optimize( back );
+			  return result.is_valid;
+		  },
+		  utf16 );
+		auto utf32 = std::vector<char32_t>( bytes );
+		(void)daw::bench_n_test_mbs<10>(
+		  "utf8_to_utf32", bytes,
+		  [&]( std::string const &s ) {
+			  auto result = daw::utf8_to_utf32( s, utf32.data( ) );
+			  daw::do_not_optimize( utf32 );
+			  return result.is_valid;
+		  },
+		  text );
+	}
+} // namespace
+
+int main( ) {
+	validation_test( );
+	transcode_test( );
+	constexpr std::size_t count = 16U * 1024U * 1024U;
+	utf8_bench( "ASCII heavy", encode( make_code_points( count, 0.97, 0.0, 7 ) ) );
+	utf8_bench( "CJK heavy", encode( make_code_points( count / 3U, 0.1, 0.88, 8 ) ) );
+	std::cout << "done\n";
+}
@@ -11,9 +11,15 @@
 #include "daw/daw_benchmark.h"
 #include "daw/daw_ensure.h"
 
+#include <array>
+#include <cstddef>
 #include <exception>
+#include <iostream>
 #include <optional>
+#include <string>
+#include <utility>
 #include <variant>
+#include <vector>
 
 constexpr bool visit_nt_001( ) {
 	std::variant<int, double> a = 5.5;
@@ -251,6 +257,196 @@ bool visit_test_001( ) {
 	return r == 5;
 }
 
+constexpr bool visit_multi_001( ) {
+	std::variant<int, double> a = 5;
+	std::variant<char, bool, long> b = true;
+	auto result = ::daw::visit_multi(
+	  []( auto x, auto y ) {
+		  return sizeof( x ) * 10 + sizeof( y );
+	  },
+	  a, b );
+	daw::expecting( sizeof( int ) * 10 + sizeof( bool ), result );
+	return true;
+}
+static_assert( visit_multi_001( ) );
+
+constexpr bool visit_unchecked_001( ) {
+	std::variant<int, double> a = 2.5;
+	std::variant<int, double> b = 3;
+	std::variant<int, double> c = 4;
+	auto result = ::daw::visit_unchecked<double>(
+	  []( auto x, auto y, auto z ) {
+		  return x + y + z;
+	  },
+	  a, b, c );
+	daw::expecting( 9.5, result );
+	return true;
+}
+static_assert( visit_unchecked_001( ) );
+
+struct throws_on_move {
+	throws_on_move( ) = default;
+	throws_on_move( throws_on_move const & ) = default;
+	throws_on_move( throws_on_move && ) {
+		throw 1;
+	}
+	throws_on_move &operator=( throws_on_move const & ) = default;
+	throws_on_move &operator=( throws_on_move && ) {
+		throw 1;
+	}
+};
+
+void visit_multi_valueless( ) {
+#if defined( DAW_USE_EXCEPTIONS )
+	auto a = std::variant<int, throws_on_move>{ 1 };
+	try {
+		a.emplace<throws_on_move>( throws_on_move{ } );
+	} catch( int ) {}
+	daw::expecting( a.valueless_by_exception( ) );
+	auto b = std::variant<int, double>{ 1 };
+	bool has_thrown = false;
+	try {
+		(void)daw::visit_multi(
+		  []( auto const &, auto const & ) {
+			  return 0;
+		  },
+		  b, a );
+	} catch( daw::bad_variant_access const & ) { has_thrown = true; }
+	daw::expecting( has_thrown );
+#endif
+}
+
+template<std::size_t I>
+struct alt {
+	std::size_t value = I;
+};
+
+template<std::size_t... Is>
+auto make_alt_variant( std::index_sequence<Is...> ) -> std::variant<alt<Is>...>;
+
+template<std::size_t N>
+using alt_variant_t =
+  decltype( make_alt_variant( std::make_index_sequence<N>{ } ) );
+
+template<std::size_t N, std::size_t... Is>
+alt_variant_t<N> make_alt( std::size_t n, std::index_sequence<Is...> ) {
+	using fn_t = alt_variant_t<N> ( * )( );
+	static constexpr fn_t makers[] = { +[]( ) -> alt_variant_t<N> {
+		return alt<Is>{ };
+	}... };
+	return makers[n % N]( );
+}
+
+template<std::size_t N>
+std::vector<alt_variant_t<N>> make_alts( std::size_t count ) {
+	auto result = std::vector<alt_variant_t<N>>( );
+	result.reserve( count );
+	std::size_t state = 1;
+	for( std::size_t n = 0; n < count; ++n ) {
+		state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+		result.push_back( make_alt<N>( state >> 33U, std::make_index_sequence<N>{ } ) );
+	}
+	return result;
+}
+
+template<std::size_t N>
+void visit_multi_check( ) {
+	auto const lhs = make_alts<N>( 1000 );
+	auto const rhs = make_alts<N>( 1001 );
+	for( std::size_t n = 0; n < lhs.size( ); ++n ) {
+		auto const expected = lhs[n].index( ) * 100U + rhs[n].index( );
+		auto const result = daw::visit_multi(
+		  []( auto const &x, auto const &y ) {
+			  return x.value * 100U + y.value;
+		  },
+		  lhs[n], rhs[n] );
+		daw::expecting( expected, result );
+	}
+}
+
+template<std::size_t N>
+void visit_bench( ) {
+	constexpr std::size_t count = 1'000'000;
+	auto const lhs = make_alts<N>( count );
+	auto const rhs = make_alts<N>( count + 1 );
+	auto const vis = []( auto const &x, auto const &y ) {
+		return x.value ^ y.value;
+	};
+	auto const title = [&]( char const *name ) {
+		return std::string( name ) + " " + std::to_string( N ) + "x" +
+		       std::to_string( N ) + " alternatives";
+	};
+	daw::bench_n_test<10>(
+	  title( "std::visit" ),
+	  [&]( auto const &l, auto const &r ) {
+		  std::size_t sum = 0;
+		  for( std::size_t n = 0; n < l.size( ); ++n ) {
+			  sum += std::visit( vis, l[n], r[n] );
+		  }
+		  daw::do_not_optimize( sum );
+		  return sum;
+	  },
+	  lhs, rhs );
+	daw::bench_n_test<10>(
+	  title( "daw::visit_multi" ),
+	  [&]( auto const &l, auto const &r ) {
+		  std::size_t sum = 0;
+		  for( std::size_t n = 0; n < l.size( ); ++n ) {
+			  sum += daw::visit_multi( vis, l[n], r[n] );
+		  }
+		  daw::do_not_optimize( sum );
+		  return sum;
+	  },
+	  lhs, rhs );
+	daw::bench_n_test<10>(
+	  title( "daw::visit_unchecked" ),
+	  [&]( auto const &l, auto const &r ) {
+		  std::size_t sum = 0;
+		  for( std::size_t n = 0; n < l.size( ); ++n ) {
+			  sum += daw::visit_unchecked( vis, l[n], r[n] );
+		  }
+		  daw::do_not_optimize( sum );
+		  return sum;
+	  },
+	  lhs, rhs );
+}
+
+// Pairs of 64 alternatives take about 20s to compile with either std::visit
+// or visit_multi, so only single variant visitation is benchmarked there
+template<std::size_t N>
+void visit_bench_single( ) {
+	constexpr std::size_t count = 1'000'000;
+	auto const vars = make_alts<N>( count );
+	auto const vis = []( auto const &x ) {
+		return x.value;
+	};
+	auto const title = [&]( char const *name ) {
+		return std::string( name ) + " " + std::to_string( N ) + " alternatives";
+	};
+	daw::bench_n_test<10>(
+	  title( "std::visit" ),
+	  [&]( auto const &v ) {
+		  std::size_t sum = 0;
+		  for( auto const &x : v ) {
+			  sum += std::visit( vis, x );
+		  }
+		  daw::do_not_optimize( sum );
+		  return sum;
+	  },
+	  vars );
+	daw::bench_n_test<10>(
+	  title( "daw::visit_unchecked" ),
+	  [&]( auto const &v ) {
+		  std::size_t sum = 0;
+		  for( auto const &x : v ) {
+			  sum += daw::visit_unchecked( vis, x );
+		  }
+		  daw::do_not_optimize( sum );
+		  return sum;
+	  },
+	  vars );
+}
+
 int main( ) {
 	visit_nt_004( );
 	visit_nt_005( );
@@ -272,4 +468,14 @@ int main( ) {
 	daw_ensure( foofoo( foobar( 14 ) ) == 14 );
 	daw_ensure( foofoo( foobar( 15 ) ) == 15 );
 	daw_ensure( foofoo( foobar( 16 ) ) == 16 );
+	visit_multi_valueless( );
+	visit_multi_check<2>( );
+	visit_multi_check<17>( );
+	visit_multi_check<33>( );
+	visit_bench<2>( );
+	visit_bench<8>( );
+	visit_bench<16>( );
+	visit_bench<32>( );
+	visit_bench_single<64>( );
+	std::cout << "done\n";
 }
@@ -10,11 +10,15 @@
 
 #include <daw/daw_algorithm.h>
 #include <daw/daw_consteval.h>
+#include <daw/daw_container_help.h>
 #include <daw/daw_ensure.h>
+#include <daw/daw_huge_page_allocator.h>
 #include <daw/vector_algorithm.h>
 
 #include <cstddef>
 #include <iostream>
+#include <string>
+#include <vector>
 
 DAW_CONSTEVAL int sum( std::size_t n ) {
 	auto v = daw::vector<int>(
@@ -51,6 +55,51 @@ DAW_CONSTEVAL bool test( ) {
 	return y.size( ) == 50;
 }
 
+void buffer_transfer_test( ) {
+	auto sv = std::vector<std::string>( 50, std::string( 40, 's' ) );
+	auto const *const first = sv.data( );
+	auto dv = daw::vector<std::string>( daw::release_buffer( std::move( sv ) ) );
+	daw_ensure( sv.empty( ) );
+	daw_ensure( dv.size( ) == 50 );
+#if defined( DAW_HAS_STD_VECTOR_BUFFER_TRANSFER )
+	daw_ensure( dv.data( ) == first );
+#endif
+	(void)first;
+	dv.push_back( "daw" );
+	auto const *const grown = dv.data( );
+	auto back = daw::to_std_vector( dv.release_buffer( ) );
+	daw_ensure( dv.empty( ) and dv.capacity( ) == 0 );
+	daw_ensure( back.size( ) == 51 );
+#if defined( DAW_HAS_STD_VECTOR_BUFFER_TRANSFER )
+	daw_ensure( back.data( ) == grown );
+#endif
+	(void)grown;
+	daw_ensure( back.back( ) == "daw" );
+
+	auto str = std::string( 4096, 'c' );
+	auto bytes = daw::vector<char>( daw::release_buffer( std::move( str ) ) );
+	daw_ensure( bytes.size( ) == 4096 and bytes.back( ) == 'c' );
+	auto const *const payload = bytes.data( );
+	auto str_back = daw::to_std_string( bytes.release_buffer( ) );
+	daw_ensure( str_back == std::string( 4096, 'c' ) );
+#if defined( DAW_HAS_STD_STRING_BUFFER_TRANSFER )
+	daw_ensure( str_back.data( ) == payload );
+#endif
+	(void)payload;
+}
+
+void huge_page_allocator_test( ) {
+	auto v = daw::vector<long, daw::memory::huge_page_allocator<long>>(
+	  daw::memory::huge_page_allocator<long>( daw::memory::numa_placement{
+	    daw::memory::numa_policy::interleave, 0 } ) );
+	for( long n = 0; n < 1'000'000; ++n ) {
+		v.push_back( n );
+	}
+	daw_ensure( v.size( ) == 1'000'000 and v[999'999] == 999'999 );
+	v.erase( v.begin( ), v.begin( ) + 10 );
+	daw_ensure( v.front( ) == 10 );
+}
+
 int main( ) {
 	auto x = daw::vector<int>( );
 	x.reserve( 3 );
@@ -78,4 +127,6 @@ int main( ) {
 	daw_ensure( v.front( ) == 0 );
 	daw_ensure( v.pop_back_value( ) == 99 );
 	daw_ensure( v.size( ) == 99 );
+	buffer_transfer_test( );
+	huge_page_allocator_test( );
 }